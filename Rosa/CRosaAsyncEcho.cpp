@@ -0,0 +1,258 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaAsyncEcho.cpp
+* @brief	This File is RosaAsyncEcho Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaAsyncEcho.h"
+#include "CThreadSafe.h"
+
+//CRosaAsyncEcho Э̻Է(CRosaAsyncSocketʾ, ѭ̳߳ش)
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncEcho()
+// @Purpose: CRosaAsyncEcho캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaAsyncEcho::CRosaAsyncEcho()
+{
+	m_pLoop = NULL;
+	m_dwIdleTimeOut = INFINITE;
+
+	m_nCoroutines = 0;
+	m_llEchoBytes = 0;
+	m_bRunning = false;
+
+	InitializeCriticalSection(&m_csSession);
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaAsyncEcho()
+// @Purpose: CRosaAsyncEcho
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaAsyncEcho::~CRosaAsyncEcho()
+{
+	CRosaAsyncEchoStop();
+
+	DeleteCriticalSection(&m_csSession);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncEchoStart()
+// @Purpose: CRosaAsyncEchoԷ
+// @Since: v1.00a
+// @Para: CRosaEventLoop* pLoop(¼ѭ)
+// @Para: USHORT sPort(˿)
+// @Para: DWORD dwIdleTimeOut(Ựгʱ, )
+// @Para: int nBacklog(г)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSAASYNCECHO_CALLMODE CRosaAsyncEcho::CRosaAsyncEchoStart(CRosaEventLoop * pLoop, USHORT sPort, DWORD dwIdleTimeOut, int nBacklog)
+{
+	if (pLoop == NULL || m_bRunning)
+	{
+		return false;
+	}
+
+	if (!m_Listen.CRosaAsyncSocketCreate(pLoop) || !m_Listen.CRosaAsyncSocketListen(sPort, nBacklog))
+	{
+		return false;
+	}
+
+	m_pLoop = pLoop;
+	m_dwIdleTimeOut = dwIdleTimeOut;
+	m_llEchoBytes = 0;
+	m_bRunning = true;
+
+	// Ԥȵȴ, ٶܵAcceptEx
+	for (int i = 0; i < ROSA_ECHO_ACCEPT_DEPTH; ++i)
+	{
+		InterlockedIncrement(&m_nCoroutines);
+		AcceptLoop(this);
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncEchoStop()
+// @Purpose: CRosaAsyncEchoֹͣ񲢵ȴȫЭ̽(ѭ߳е)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSAASYNCECHO_CALLMODE CRosaAsyncEcho::CRosaAsyncEchoStop()
+{
+	EnterCriticalSection(&m_csSession);
+
+	m_bRunning = false;
+
+	LeaveCriticalSection(&m_csSession);
+
+	// Э̿ڼб־Ͷһ, ظȡֱȫ
+	while (m_nCoroutines > 0)
+	{
+		m_Listen.CRosaAsyncSocketCancel();
+		CancelSessions();
+		Sleep(1);
+	}
+
+	m_Listen.CRosaAsyncSocketClose();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncEchoGetSessionCount()
+// @Purpose: CRosaAsyncEchoȡỰ
+// @Since: v1.00a
+// @Para: None
+// @Return: int nCount
+//------------------------------------------------------------------
+int ROSAASYNCECHO_CALLMODE CRosaAsyncEcho::CRosaAsyncEchoGetSessionCount()
+{
+	CThreadSafe ThreadSafe(&m_csSession);
+
+	return (int)m_setSession.size();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncEchoGetEchoBytes()
+// @Purpose: CRosaAsyncEchoȡֽ
+// @Since: v1.00a
+// @Para: None
+// @Return: ULONGLONG ullBytes
+//------------------------------------------------------------------
+ULONGLONG ROSAASYNCECHO_CALLMODE CRosaAsyncEcho::CRosaAsyncEchoGetEchoBytes() const
+{
+	return (ULONGLONG)m_llEchoBytes;
+}
+
+//------------------------------------------------------------------
+// @Function:	 AcceptLoop()
+// @Purpose: CRosaAsyncEchoЭ(ÿһỰЭ)
+// @Since: v1.00a
+// @Para: CRosaAsyncEcho* pThis(Է)
+// @Return: CRosaTask
+//------------------------------------------------------------------
+CRosaTask CRosaAsyncEcho::AcceptLoop(CRosaAsyncEcho * pThis)
+{
+	while (pThis->m_bRunning)
+	{
+		CRosaAsyncSocket* pClient = new CRosaAsyncSocket;
+		pClient->CRosaAsyncSocketCreate(pThis->m_pLoop);
+
+		int nRet = co_await pThis->m_Listen.CRosaAsyncSocketAccept(*pClient);
+		if (nRet != SOB_RET_OK)
+		{
+			delete pClient;
+
+			// ǰϿӰ
+			if (nRet == SOB_RET_CLOSE)
+			{
+				continue;
+			}
+
+			break;
+		}
+
+		EnterCriticalSection(&pThis->m_csSession);
+
+		if (!pThis->m_bRunning)
+		{
+			LeaveCriticalSection(&pThis->m_csSession);
+			delete pClient;
+			break;
+		}
+
+		pThis->m_setSession.insert(pClient);
+		InterlockedIncrement(&pThis->m_nCoroutines);
+
+		LeaveCriticalSection(&pThis->m_csSession);
+
+		EchoSession(pThis, pClient);
+	}
+
+	InterlockedDecrement(&pThis->m_nCoroutines);
+}
+
+//------------------------------------------------------------------
+// @Function:	 EchoSession()
+// @Purpose: CRosaAsyncEchoԻỰЭ(պԭ, Ͽʱ)
+// @Since: v1.00a
+// @Para: CRosaAsyncEcho* pThis(Է)
+// @Para: CRosaAsyncSocket* pClient(ͻ, Ựʱͷ)
+// @Return: CRosaTask
+//------------------------------------------------------------------
+CRosaTask CRosaAsyncEcho::EchoSession(CRosaAsyncEcho * pThis, CRosaAsyncSocket * pClient)
+{
+	char chBuffer[ROSA_ECHO_BUFFER_SIZE];
+
+	while (pThis->m_bRunning)
+	{
+		DWORD dwRecvBytes = 0;
+
+		int nRet = co_await pClient->CRosaAsyncSocketRecv(chBuffer, sizeof(chBuffer), dwRecvBytes, pThis->m_dwIdleTimeOut);
+		if (nRet != SOB_RET_OK)
+		{
+			break;
+		}
+
+		DWORD dwOffset = 0;
+
+		while (dwOffset < dwRecvBytes)
+		{
+			DWORD dwSendBytes = 0;
+
+			nRet = co_await pClient->CRosaAsyncSocketSend(chBuffer + dwOffset, dwRecvBytes - dwOffset, dwSendBytes);
+			if (nRet != SOB_RET_OK || dwSendBytes == 0)
+			{
+				break;
+			}
+
+			dwOffset += dwSendBytes;
+		}
+
+		if (dwOffset < dwRecvBytes)
+		{
+			break;
+		}
+
+		InterlockedExchangeAdd64(&pThis->m_llEchoBytes, dwRecvBytes);
+	}
+
+	EnterCriticalSection(&pThis->m_csSession);
+
+	pThis->m_setSession.erase(pClient);
+
+	LeaveCriticalSection(&pThis->m_csSession);
+
+	delete pClient;
+
+	InterlockedDecrement(&pThis->m_nCoroutines);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CancelSessions()
+// @Purpose: CRosaAsyncEchoȡȫỰĵȴ
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaAsyncEcho::CancelSessions()
+{
+	CThreadSafe ThreadSafe(&m_csSession);
+
+	for (set<CRosaAsyncSocket*>::iterator iter = m_setSession.begin(); iter != m_setSession.end(); ++iter)
+	{
+		(*iter)->CRosaAsyncSocketCancel();
+	}
+}
@@ -0,0 +1,69 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaAsyncEcho.h
+* @brief	This File is RosaAsyncEcho Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSAASYNCECHO_H__
+#define __CROSAASYNCECHO_H__
+
+//Include Rosa Header File
+#include "CRosaAsyncSocket.h"
+
+//Include C/C++ Header File
+#include <set>
+
+using namespace std;
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSAASYNCECHO_API	__declspec(dllexport)
+#else
+#define ROSAASYNCECHO_API	__declspec(dllimport)
+#endif
+
+#define ROSAASYNCECHO_CALLMODE	__stdcall
+
+#define ROSA_ECHO_BUFFER_SIZE		4096			//ÿỰջ峤
+#define ROSA_ECHO_ACCEPT_DEPTH		8				//ͬʱȴAcceptEx
+
+//Class Definition
+class ROSAASYNCECHO_API CRosaAsyncEcho
+{
+public:
+	CRosaAsyncEcho();			// CRosaAsyncEcho 캯
+	~CRosaAsyncEcho();			// CRosaAsyncEcho 
+
+public:
+	bool ROSAASYNCECHO_CALLMODE CRosaAsyncEchoStart(CRosaEventLoop* pLoop, USHORT sPort, DWORD dwIdleTimeOut = INFINITE, int nBacklog = SOMAXCONN);	// CRosaAsyncEcho Է(ÿһЭ)
+	void ROSAASYNCECHO_CALLMODE CRosaAsyncEchoStop();										// CRosaAsyncEcho ֹͣ񲢵ȴȫЭ̽
+
+	int ROSAASYNCECHO_CALLMODE CRosaAsyncEchoGetSessionCount();								// CRosaAsyncEcho ȡỰ
+	ULONGLONG ROSAASYNCECHO_CALLMODE CRosaAsyncEchoGetEchoBytes() const;					// CRosaAsyncEcho ȡֽ
+
+private:
+	static CRosaTask AcceptLoop(CRosaAsyncEcho* pThis);										// CRosaAsyncEcho Э
+	static CRosaTask EchoSession(CRosaAsyncEcho* pThis, CRosaAsyncSocket* pClient);		// CRosaAsyncEcho ԻỰЭ
+	void CancelSessions();																	// CRosaAsyncEcho ȡȫỰĵȴ
+
+private:
+	CRosaEventLoop* m_pLoop;							// CRosaAsyncEcho ¼ѭ
+	CRosaAsyncSocket m_Listen;							// CRosaAsyncEcho ׽
+	DWORD m_dwIdleTimeOut;								// CRosaAsyncEcho Ựгʱ
+
+	CRITICAL_SECTION m_csSession;						// CRosaAsyncEcho Ựٽ
+	set<CRosaAsyncSocket*> m_setSession;				// CRosaAsyncEcho Ự
+	volatile LONG m_nCoroutines;						// CRosaAsyncEcho еЭ
+	volatile LONGLONG m_llEchoBytes;					// CRosaAsyncEcho ֽ
+	volatile bool m_bRunning;							// CRosaAsyncEcho б־
+
+};
+
+#endif // !__CROSAASYNCECHO_H__
@@ -0,0 +1,264 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaAsyncSerial.cpp
+* @brief	This File is RosaAsyncSerial Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaAsyncSerial.h"
+
+//CRosaAsyncSerial Э̴(ɶ˿)
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncSerial()
+// @Purpose: CRosaAsyncSerial캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaAsyncSerial::CRosaAsyncSerial()
+{
+	m_pLoop = NULL;
+	m_hCOM = INVALID_HANDLE_VALUE;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaAsyncSerial()
+// @Purpose: CRosaAsyncSerial
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaAsyncSerial::~CRosaAsyncSerial()
+{
+	CRosaAsyncSerialClose();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncSerialOpen()
+// @Purpose: CRosaAsyncSerial򿪴ڲ¼ѭ
+// @Since: v1.00a
+// @Para: CRosaEventLoop* pLoop(¼ѭ)
+// @Para: S_SERIALPORT_PROPERTY sCommProperty(Ϣṹ)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSAASYNCSERIAL_CALLMODE CRosaAsyncSerial::CRosaAsyncSerialOpen(CRosaEventLoop * pLoop, S_SERIALPORT_PROPERTY sCommProperty)
+{
+	if (pLoop == NULL || m_hCOM != INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	HANDLE hCOM = CreateFileA(sCommProperty.chPort, GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED, NULL);
+	if (INVALID_HANDLE_VALUE == hCOM)
+	{
+		return false;
+	}
+
+	// 
+	if (!SetupComm(hCOM, SERIALPORT_COMM_INPUT_BUFFER_SIZE, SERIALPORT_COMM_OUTPUT_BUFFER_SIZE))
+	{
+		CloseHandle(hCOM);
+		return false;
+	}
+
+	// DCBṹ
+	DCB dcb = { 0 };
+
+	if (!GetCommState(hCOM, &dcb))
+	{
+		CloseHandle(hCOM);
+		return false;
+	}
+
+	dcb.DCBlength = sizeof(dcb);
+	dcb.BaudRate = sCommProperty.dwBaudRate;
+	dcb.ByteSize = sCommProperty.byDataBits;
+	dcb.StopBits = sCommProperty.byStopBits;
+	dcb.Parity = sCommProperty.byCheckBits;
+
+	if (!SetCommState(hCOM, &dcb))
+	{
+		CloseHandle(hCOM);
+		return false;
+	}
+
+	// ôڳʱʱ(ȡݼ, ʱȴЭ̳ʱȡ)
+	COMMTIMEOUTS ct = { 0 };
+	ct.ReadIntervalTimeout = MAXDWORD;
+	ct.ReadTotalTimeoutMultiplier = MAXDWORD;
+	ct.ReadTotalTimeoutConstant = MAXDWORD - 1;
+	ct.WriteTotalTimeoutMultiplier = 500;
+	ct.WriteTotalTimeoutConstant = 5000;
+
+	if (!SetCommTimeouts(hCOM, &ct))
+	{
+		CloseHandle(hCOM);
+		return false;
+	}
+
+	// մڻ
+	PurgeComm(hCOM, PURGE_TXABORT | PURGE_RXABORT | PURGE_TXCLEAR | PURGE_RXCLEAR);
+
+	if (!pLoop->CRosaEventLoopAttach(hCOM))
+	{
+		CloseHandle(hCOM);
+		return false;
+	}
+
+	m_pLoop = pLoop;
+	m_hCOM = hCOM;
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncSerialClose()
+// @Purpose: CRosaAsyncSerialرմ(ȴеĲSOB_RET_FAIL)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSAASYNCSERIAL_CALLMODE CRosaAsyncSerial::CRosaAsyncSerialClose()
+{
+	if (m_hCOM != INVALID_HANDLE_VALUE)
+	{
+		CancelIoEx(m_hCOM, NULL);
+		CloseHandle(m_hCOM);
+		m_hCOM = INVALID_HANDLE_VALUE;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncSerialCancel()
+// @Purpose: CRosaAsyncSerialȡȫȴеĲ(ЭSOB_RET_FAILִ)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSAASYNCSERIAL_CALLMODE CRosaAsyncSerial::CRosaAsyncSerialCancel()
+{
+	if (m_hCOM != INVALID_HANDLE_VALUE)
+	{
+		CancelIoEx(m_hCOM, NULL);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncSerialGetStatus()
+// @Purpose: CRosaAsyncSerialȡ״̬
+// @Since: v1.00a
+// @Para: None
+// @Return: bool bRet (true:Ѵ, false:δ)
+//------------------------------------------------------------------
+bool ROSAASYNCSERIAL_CALLMODE CRosaAsyncSerial::CRosaAsyncSerialGetStatus() const
+{
+	return (m_hCOM != INVALID_HANDLE_VALUE);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncSerialGetHandle()
+// @Purpose: CRosaAsyncSerialȡھ
+// @Since: v1.00a
+// @Para: None
+// @Return: HANDLE hCOM
+//------------------------------------------------------------------
+HANDLE ROSAASYNCSERIAL_CALLMODE CRosaAsyncSerial::CRosaAsyncSerialGetHandle() const
+{
+	return m_hCOM;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncSerialRead()
+// @Purpose: CRosaAsyncSerialȡ(co_await, ݼ)
+// @Since: v1.00a
+// @Para: unsigned char* pBuff(ջ, ǰ뱣Ч)
+// @Para: int nSize(ջ峤)
+// @Para: DWORD& dwRecvCount(ʱдѽֽ)
+// @Para: DWORD dwTimeOutMSec(ʱ, )
+// @Return: CRosaAsyncOp Op(co_awaitSOB_RET_*)
+//------------------------------------------------------------------
+CRosaAsyncOp ROSAASYNCSERIAL_CALLMODE CRosaAsyncSerial::CRosaAsyncSerialRead(unsigned char * pBuff, int nSize, DWORD & dwRecvCount, DWORD dwTimeOutMSec)
+{
+	CRosaAsyncOp Op(m_pLoop, m_hCOM, dwTimeOutMSec, OnReadStart, NULL, this);
+
+	Op.CRosaAsyncOpSetBuffer((char*)pBuff, (nSize > 0) ? nSize : 0, &dwRecvCount);
+
+	return Op;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncSerialWrite()
+// @Purpose: CRosaAsyncSerialд(co_await)
+// @Since: v1.00a
+// @Para: const unsigned char* pBuff(ͻ, ǰ뱣Ч)
+// @Para: int nSize(ͳ)
+// @Para: DWORD& dwSendCount(ʱдѷֽ)
+// @Para: DWORD dwTimeOutMSec(ʱ, )
+// @Return: CRosaAsyncOp Op(co_awaitSOB_RET_*)
+//------------------------------------------------------------------
+CRosaAsyncOp ROSAASYNCSERIAL_CALLMODE CRosaAsyncSerial::CRosaAsyncSerialWrite(const unsigned char * pBuff, int nSize, DWORD & dwSendCount, DWORD dwTimeOutMSec)
+{
+	CRosaAsyncOp Op(m_pLoop, m_hCOM, dwTimeOutMSec, OnWriteStart, NULL, this);
+
+	Op.CRosaAsyncOpSetBuffer((char*)pBuff, (nSize > 0) ? nSize : 0, &dwSendCount);
+
+	return Op;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnReadStart()
+// @Purpose: CRosaAsyncSerialͶReadFile
+// @Since: v1.00a
+// @Para: LPS_ROSAASYNCOP pOp(״̬)
+// @Return: DWORD dwError
+//------------------------------------------------------------------
+DWORD __stdcall CRosaAsyncSerial::OnReadStart(LPS_ROSAASYNCOP pOp)
+{
+	if (pOp->hHandle == INVALID_HANDLE_VALUE)
+	{
+		return ERROR_INVALID_HANDLE;
+	}
+
+	// ʹͬҲɰ
+	if (!ReadFile(pOp->hHandle, pOp->pBuffer, pOp->uiSize, NULL, &pOp->Overlapped.Overlapped))
+	{
+		DWORD dwError = GetLastError();
+		if (dwError != ERROR_IO_PENDING)
+		{
+			return dwError;
+		}
+	}
+
+	return ERROR_IO_PENDING;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnWriteStart()
+// @Purpose: CRosaAsyncSerialͶWriteFile
+// @Since: v1.00a
+// @Para: LPS_ROSAASYNCOP pOp(״̬)
+// @Return: DWORD dwError
+//------------------------------------------------------------------
+DWORD __stdcall CRosaAsyncSerial::OnWriteStart(LPS_ROSAASYNCOP pOp)
+{
+	if (pOp->hHandle == INVALID_HANDLE_VALUE)
+	{
+		return ERROR_INVALID_HANDLE;
+	}
+
+	if (!WriteFile(pOp->hHandle, pOp->pBuffer, pOp->uiSize, NULL, &pOp->Overlapped.Overlapped))
+	{
+		DWORD dwError = GetLastError();
+		if (dwError != ERROR_IO_PENDING)
+		{
+			return dwError;
+		}
+	}
+
+	return ERROR_IO_PENDING;
+}
@@ -0,0 +1,62 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaAsyncSerial.h
+* @brief	This File is RosaAsyncSerial Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSAASYNCSERIAL_H__
+#define __CROSAASYNCSERIAL_H__
+
+//Include Rosa Header File
+#include "CRosaCoroutine.h"
+#include "CRosaEventLoop.h"
+#include "CRosaSerial.h"
+
+using namespace std;
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSAASYNCSERIAL_API	__declspec(dllexport)
+#else
+#define ROSAASYNCSERIAL_API	__declspec(dllimport)
+#endif
+
+#define ROSAASYNCSERIAL_CALLMODE	__stdcall
+
+//Class Definition
+class ROSAASYNCSERIAL_API CRosaAsyncSerial
+{
+public:
+	CRosaAsyncSerial();			// CRosaAsyncSerial 캯
+	~CRosaAsyncSerial();		// CRosaAsyncSerial 
+
+public:
+	bool ROSAASYNCSERIAL_CALLMODE CRosaAsyncSerialOpen(CRosaEventLoop* pLoop, S_SERIALPORT_PROPERTY sCommProperty);	// CRosaAsyncSerial 򿪴ڲ¼ѭ
+	void ROSAASYNCSERIAL_CALLMODE CRosaAsyncSerialClose();								// CRosaAsyncSerial رմ(ȴеĲSOB_RET_FAIL)
+	void ROSAASYNCSERIAL_CALLMODE CRosaAsyncSerialCancel();							// CRosaAsyncSerial ȡȫȴеĲ(SOB_RET_FAIL)
+
+	bool ROSAASYNCSERIAL_CALLMODE CRosaAsyncSerialGetStatus() const;					// CRosaAsyncSerial ȡ״̬
+	HANDLE ROSAASYNCSERIAL_CALLMODE CRosaAsyncSerialGetHandle() const;					// CRosaAsyncSerial ȡھ
+
+	// co_await (SOB_RET_*, ɺ¼ѭ߳мִ)
+	CRosaAsyncOp ROSAASYNCSERIAL_CALLMODE CRosaAsyncSerialRead(unsigned char* pBuff, int nSize, DWORD& dwRecvCount, DWORD dwTimeOutMSec = ROSA_ASYNC_TIMEOUT_MSEC);			// CRosaAsyncSerial ȡ(ݼ)
+	CRosaAsyncOp ROSAASYNCSERIAL_CALLMODE CRosaAsyncSerialWrite(const unsigned char* pBuff, int nSize, DWORD& dwSendCount, DWORD dwTimeOutMSec = ROSA_ASYNC_TIMEOUT_MSEC);	// CRosaAsyncSerial д
+
+private:
+	static DWORD __stdcall OnReadStart(LPS_ROSAASYNCOP pOp);			// CRosaAsyncSerial ͶReadFile
+	static DWORD __stdcall OnWriteStart(LPS_ROSAASYNCOP pOp);			// CRosaAsyncSerial ͶWriteFile
+
+private:
+	CRosaEventLoop* m_pLoop;			// CRosaAsyncSerial ¼ѭ
+	HANDLE m_hCOM;						// CRosaAsyncSerial ھ
+
+};
+
+#endif // !__CROSAASYNCSERIAL_H__
@@ -0,0 +1,579 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaAsyncSocket.cpp
+* @brief	This File is RosaAsyncSocket Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaAsyncSocket.h"
+#include "CThreadSafe.h"
+
+//CRosaAsyncSocket Э׽(ɶ˿)
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncSocket()
+// @Purpose: CRosaAsyncSocket캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaAsyncSocket::CRosaAsyncSocket()
+{
+	m_pLoop = NULL;
+	m_Socket = INVALID_SOCKET;
+	m_nFamily = AF_INET;
+
+	m_pConnector = NULL;
+	m_ullConnectID = 0;
+
+	m_pfnAcceptEx = NULL;
+
+	InitializeCriticalSection(&m_csAsync);
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaAsyncSocket()
+// @Purpose: CRosaAsyncSocket
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaAsyncSocket::~CRosaAsyncSocket()
+{
+	CRosaAsyncSocketClose();
+
+	DeleteCriticalSection(&m_csAsync);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncSocketCreate()
+// @Purpose: CRosaAsyncSocket¼ѭ
+// @Since: v1.00a
+// @Para: CRosaEventLoop* pLoop(¼ѭ)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocket::CRosaAsyncSocketCreate(CRosaEventLoop * pLoop)
+{
+	if (pLoop == NULL || m_Socket != INVALID_SOCKET)
+	{
+		return false;
+	}
+
+	m_pLoop = pLoop;
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncSocketAttach()
+// @Purpose: CRosaAsyncSocketӹص׽
+// @Since: v1.00a
+// @Para: SOCKET s(WSA_FLAG_OVERLAPPED׽)
+// @Para: bool bAttached(Ƿѹͬһ¼ѭ, CRosaConnectorӵõ׽)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocket::CRosaAsyncSocketAttach(SOCKET s, bool bAttached)
+{
+	if (m_pLoop == NULL || m_Socket != INVALID_SOCKET || s == INVALID_SOCKET)
+	{
+		return false;
+	}
+
+	if (!bAttached && !m_pLoop->CRosaEventLoopAttach((HANDLE)s))
+	{
+		return false;
+	}
+
+	m_Socket = s;
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncSocketDetach()
+// @Purpose: CRosaAsyncSocket׽(ر, ¼ѭ)
+// @Since: v1.00a
+// @Para: None
+// @Return: SOCKET s
+//------------------------------------------------------------------
+SOCKET ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocket::CRosaAsyncSocketDetach()
+{
+	SOCKET s = m_Socket;
+
+	m_Socket = INVALID_SOCKET;
+	m_pfnAcceptEx = NULL;
+
+	return s;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncSocketListen()
+// @Purpose: CRosaAsyncSocket׽(CRosaAsyncSocketAccept)
+// @Since: v1.00a
+// @Para: USHORT sPort(˿)
+// @Para: int nBacklog(г)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocket::CRosaAsyncSocketListen(USHORT sPort, int nBacklog)
+{
+	if (m_pLoop == NULL || m_Socket != INVALID_SOCKET)
+	{
+		return false;
+	}
+
+	SOCKET s = WSASocket(AF_INET, SOCK_STREAM, IPPROTO_TCP, NULL, 0, WSA_FLAG_OVERLAPPED);
+	if (s == INVALID_SOCKET)
+	{
+		return false;
+	}
+
+	SOCKADDR_IN addrLocal;
+	memset(&addrLocal, 0, sizeof(addrLocal));
+
+	addrLocal.sin_family = AF_INET;
+	addrLocal.sin_addr.s_addr = htonl(INADDR_ANY);
+	addrLocal.sin_port = htons(sPort);
+
+	if (bind(s, (PSOCKADDR)&addrLocal, sizeof(addrLocal)) == SOCKET_ERROR || listen(s, nBacklog) == SOCKET_ERROR)
+	{
+		closesocket(s);
+		return false;
+	}
+
+	// ȡAcceptExչ
+	GUID guidAcceptEx = WSAID_ACCEPTEX;
+	DWORD dwBytes = 0;
+
+	if (WSAIoctl(s, SIO_GET_EXTENSION_FUNCTION_POINTER, &guidAcceptEx, sizeof(guidAcceptEx), &m_pfnAcceptEx, sizeof(m_pfnAcceptEx), &dwBytes, NULL, NULL) == SOCKET_ERROR)
+	{
+		m_pfnAcceptEx = NULL;
+		closesocket(s);
+		return false;
+	}
+
+	if (!CRosaAsyncSocketAttach(s))
+	{
+		m_pfnAcceptEx = NULL;
+		closesocket(s);
+		return false;
+	}
+
+	m_nFamily = AF_INET;
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncSocketClose()
+// @Purpose: CRosaAsyncSocketر׽(ȴеĲSOB_RET_FAIL)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocket::CRosaAsyncSocketClose()
+{
+	CRosaAsyncSocketCancel();
+
+	if (m_Socket != INVALID_SOCKET)
+	{
+		closesocket(m_Socket);
+		m_Socket = INVALID_SOCKET;
+	}
+
+	m_pfnAcceptEx = NULL;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncSocketCancel()
+// @Purpose: CRosaAsyncSocketȡȫȴеĲ(ЭSOB_RET_FAILִ)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocket::CRosaAsyncSocketCancel()
+{
+	CRosaConnector* pConnector = NULL;
+	ULONGLONG ullConnectID = 0;
+
+	EnterCriticalSection(&m_csAsync);
+
+	pConnector = m_pConnector;
+	ullConnectID = m_ullConnectID;
+
+	LeaveCriticalSection(&m_csAsync);
+
+	// ڵ߳лص, Эɰѭ߳лָ
+	if (pConnector != NULL && ullConnectID != 0)
+	{
+		pConnector->CRosaConnectorCancel(ullConnectID);
+	}
+
+	if (m_Socket != INVALID_SOCKET)
+	{
+		CancelIoEx((HANDLE)m_Socket, NULL);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncSocketGetSocket()
+// @Purpose: CRosaAsyncSocketȡ׽
+// @Since: v1.00a
+// @Para: None
+// @Return: SOCKET s
+//------------------------------------------------------------------
+SOCKET ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocket::CRosaAsyncSocketGetSocket() const
+{
+	return m_Socket;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncSocketGetLoop()
+// @Purpose: CRosaAsyncSocketȡ¼ѭ
+// @Since: v1.00a
+// @Para: None
+// @Return: CRosaEventLoop* pLoop
+//------------------------------------------------------------------
+CRosaEventLoop* ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocket::CRosaAsyncSocketGetLoop() const
+{
+	return m_pLoop;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncSocketConnect()
+// @Purpose: CRosaAsyncSocket(co_await, )
+// @Since: v1.00a
+// @Para: CRosaConnector* pConnector(, ͬһ¼ѭ)
+// @Para: const char* pcHost(IP)
+// @Para: USHORT sPort(Զ˶˿ں)
+// @Para: DWORD dwAttemptTimeOut(ַӳʱ, )
+// @Return: CRosaAsyncOp Op(co_awaitSOB_RET_OK/SOB_RET_TIMEOUT/SOB_RET_FAIL)
+//------------------------------------------------------------------
+CRosaAsyncOp ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocket::CRosaAsyncSocketConnect(CRosaConnector * pConnector, const char * pcHost, USHORT sPort, DWORD dwAttemptTimeOut)
+{
+	// ʱ, ɰصͶ
+	CRosaAsyncOp Op(m_pLoop, NULL, INFINITE, OnConnectStart, OnConnectFinish, this);
+
+	Op.CRosaAsyncOpSetBuffer((char*)pcHost, sPort, NULL);
+	Op.CRosaAsyncOpSetTarget(pConnector, dwAttemptTimeOut);
+
+	return Op;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncSocketAccept()
+// @Purpose: CRosaAsyncSocket(co_await, ׽ֵ)
+// @Since: v1.00a
+// @Para: CRosaAsyncSocket& Client(, δ¼ѭʱ󶨱¼ѭ)
+// @Para: DWORD dwTimeOutMSec(ʱ, )
+// @Return: CRosaAsyncOp Op(co_awaitSOB_RET_OK/SOB_RET_TIMEOUT/SOB_RET_FAIL)
+//------------------------------------------------------------------
+CRosaAsyncOp ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocket::CRosaAsyncSocketAccept(CRosaAsyncSocket & Client, DWORD dwTimeOutMSec)
+{
+	CRosaAsyncOp Op(m_pLoop, (HANDLE)m_Socket, dwTimeOutMSec, OnAcceptStart, OnAcceptFinish, this);
+
+	Op.CRosaAsyncOpSetTarget(&Client);
+
+	return Op;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncSocketSend()
+// @Purpose: CRosaAsyncSocket(co_await)
+// @Since: v1.00a
+// @Para: const char* pSendBuffer(ͻ, ǰ뱣Ч)
+// @Para: UINT uiBufferSize(ͳ)
+// @Para: DWORD& dwSendBytes(ʱдѷֽ)
+// @Para: DWORD dwTimeOutMSec(ʱ, )
+// @Return: CRosaAsyncOp Op(co_awaitSOB_RET_*)
+//------------------------------------------------------------------
+CRosaAsyncOp ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocket::CRosaAsyncSocketSend(const char * pSendBuffer, UINT uiBufferSize, DWORD & dwSendBytes, DWORD dwTimeOutMSec)
+{
+	CRosaAsyncOp Op(m_pLoop, (HANDLE)m_Socket, dwTimeOutMSec, OnSendStart, NULL, this);
+
+	Op.CRosaAsyncOpSetBuffer((char*)pSendBuffer, uiBufferSize, &dwSendBytes);
+
+	return Op;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncSocketRecv()
+// @Purpose: CRosaAsyncSocket(co_await, ݼ)
+// @Since: v1.00a
+// @Para: char* pRecvBuffer(ջ, ǰ뱣Ч)
+// @Para: UINT uiBufferSize(ջ峤)
+// @Para: DWORD& dwRecvBytes(ʱдѽֽ)
+// @Para: DWORD dwTimeOutMSec(ʱ, )
+// @Return: CRosaAsyncOp Op(co_awaitSOB_RET_*, Զ˶ϿSOB_RET_CLOSE)
+//------------------------------------------------------------------
+CRosaAsyncOp ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocket::CRosaAsyncSocketRecv(char * pRecvBuffer, UINT uiBufferSize, DWORD & dwRecvBytes, DWORD dwTimeOutMSec)
+{
+	CRosaAsyncOp Op(m_pLoop, (HANDLE)m_Socket, dwTimeOutMSec, OnRecvStart, OnRecvFinish, this);
+
+	Op.CRosaAsyncOpSetBuffer(pRecvBuffer, uiBufferSize, &dwRecvBytes);
+
+	return Op;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnConnectStart()
+// @Purpose: CRosaAsyncSocket(IDm_csAsyncڵǼ, صȴǼ)
+// @Since: v1.00a
+// @Para: LPS_ROSAASYNCOP pOp(״̬)
+// @Return: DWORD dwError
+//------------------------------------------------------------------
+DWORD __stdcall CRosaAsyncSocket::OnConnectStart(LPS_ROSAASYNCOP pOp)
+{
+	CRosaAsyncSocket* pThis = (CRosaAsyncSocket*)pOp->pOwner;
+	CRosaConnector* pConnector = (CRosaConnector*)pOp->pTarget;
+
+	if (pConnector == NULL || pOp->pBuffer == NULL)
+	{
+		return WSAEINVAL;
+	}
+
+	CThreadSafe ThreadSafe(&pThis->m_csAsync);
+
+	if (pThis->m_Socket != INVALID_SOCKET)
+	{
+		return WSAEISCONN;
+	}
+
+	if (pThis->m_ullConnectID != 0)
+	{
+		return WSAEALREADY;
+	}
+
+	ULONGLONG ullConnectID = pConnector->CRosaConnectorConnect(pOp->pBuffer, (USHORT)pOp->uiSize, OnConnectDone, (DWORD_PTR)pOp, pOp->dwParam);
+	if (ullConnectID == 0)
+	{
+		return WSAEHOSTUNREACH;
+	}
+
+	pThis->m_pConnector = pConnector;
+	pThis->m_ullConnectID = ullConnectID;
+
+	return ERROR_IO_PENDING;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAcceptStart()
+// @Purpose: CRosaAsyncSocketͶAcceptEx
+// @Since: v1.00a
+// @Para: LPS_ROSAASYNCOP pOp(״̬)
+// @Return: DWORD dwError
+//------------------------------------------------------------------
+DWORD __stdcall CRosaAsyncSocket::OnAcceptStart(LPS_ROSAASYNCOP pOp)
+{
+	CRosaAsyncSocket* pThis = (CRosaAsyncSocket*)pOp->pOwner;
+
+	if (pThis->m_Socket == INVALID_SOCKET || pThis->m_pfnAcceptEx == NULL || pOp->pTarget == NULL)
+	{
+		return WSAENOTSOCK;
+	}
+
+	pOp->Socket = WSASocket(pThis->m_nFamily, SOCK_STREAM, IPPROTO_TCP, NULL, 0, WSA_FLAG_OVERLAPPED);
+	if (pOp->Socket == INVALID_SOCKET)
+	{
+		return WSAGetLastError();
+	}
+
+	DWORD dwBytes = 0;
+	if (!pThis->m_pfnAcceptEx(pThis->m_Socket, pOp->Socket, pOp->chAddrBuf, 0, sizeof(SOCKADDR_STORAGE) + 16, sizeof(SOCKADDR_STORAGE) + 16, &dwBytes, &pOp->Overlapped.Overlapped))
+	{
+		DWORD dwError = WSAGetLastError();
+		if (dwError != ERROR_IO_PENDING)
+		{
+			closesocket(pOp->Socket);
+			pOp->Socket = INVALID_SOCKET;
+			return dwError;
+		}
+	}
+
+	return ERROR_IO_PENDING;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnSendStart()
+// @Purpose: CRosaAsyncSocketͶWSASend
+// @Since: v1.00a
+// @Para: LPS_ROSAASYNCOP pOp(״̬)
+// @Return: DWORD dwError
+//------------------------------------------------------------------
+DWORD __stdcall CRosaAsyncSocket::OnSendStart(LPS_ROSAASYNCOP pOp)
+{
+	if (pOp->hHandle == (HANDLE)INVALID_SOCKET)
+	{
+		return WSAENOTSOCK;
+	}
+
+	WSABUF wsaBuf;
+	wsaBuf.buf = pOp->pBuffer;
+	wsaBuf.len = pOp->uiSize;
+
+	// ʹͬҲɰ
+	if (WSASend((SOCKET)pOp->hHandle, &wsaBuf, 1, NULL, 0, &pOp->Overlapped.Overlapped, NULL) == SOCKET_ERROR)
+	{
+		DWORD dwError = WSAGetLastError();
+		if (dwError != WSA_IO_PENDING)
+		{
+			return dwError;
+		}
+	}
+
+	return ERROR_IO_PENDING;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnRecvStart()
+// @Purpose: CRosaAsyncSocketͶWSARecv
+// @Since: v1.00a
+// @Para: LPS_ROSAASYNCOP pOp(״̬)
+// @Return: DWORD dwError
+//------------------------------------------------------------------
+DWORD __stdcall CRosaAsyncSocket::OnRecvStart(LPS_ROSAASYNCOP pOp)
+{
+	if (pOp->hHandle == (HANDLE)INVALID_SOCKET)
+	{
+		return WSAENOTSOCK;
+	}
+
+	WSABUF wsaBuf;
+	wsaBuf.buf = pOp->pBuffer;
+	wsaBuf.len = pOp->uiSize;
+
+	DWORD dwFlags = 0;
+	if (WSARecv((SOCKET)pOp->hHandle, &wsaBuf, 1, NULL, &dwFlags, &pOp->Overlapped.Overlapped, NULL) == SOCKET_ERROR)
+	{
+		DWORD dwError = WSAGetLastError();
+		if (dwError != WSA_IO_PENDING)
+		{
+			return dwError;
+		}
+	}
+
+	return ERROR_IO_PENDING;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnConnectFinish()
+// @Purpose: CRosaAsyncSocketɴ(ӹõ׽)
+// @Since: v1.00a
+// @Para: LPS_ROSAASYNCOP pOp(״̬)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaAsyncSocket::OnConnectFinish(LPS_ROSAASYNCOP pOp)
+{
+	CRosaAsyncSocket* pThis = (CRosaAsyncSocket*)pOp->pOwner;
+
+	if (pOp->nResult != SOB_RET_OK)
+	{
+		return;
+	}
+
+	// ׽ѹ¼ѭ
+	if (!pThis->CRosaAsyncSocketAttach(pOp->Socket, true))
+	{
+		closesocket(pOp->Socket);
+		pOp->nResult = SOB_RET_FAIL;
+	}
+
+	pOp->Socket = INVALID_SOCKET;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAcceptFinish()
+// @Purpose: CRosaAsyncSocketɴ(׽ԲClient)
+// @Since: v1.00a
+// @Para: LPS_ROSAASYNCOP pOp(״̬)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaAsyncSocket::OnAcceptFinish(LPS_ROSAASYNCOP pOp)
+{
+	CRosaAsyncSocket* pThis = (CRosaAsyncSocket*)pOp->pOwner;
+	CRosaAsyncSocket* pClient = (CRosaAsyncSocket*)pOp->pTarget;
+
+	if (pOp->dwError != 0)
+	{
+		closesocket(pOp->Socket);
+		pOp->Socket = INVALID_SOCKET;
+		return;
+	}
+
+	// ׽ʹgetpeername/shutdown
+	setsockopt(pOp->Socket, SOL_SOCKET, SO_UPDATE_ACCEPT_CONTEXT, (char*)&pThis->m_Socket, sizeof(pThis->m_Socket));
+
+	// CreateTCPSocketһ
+	const char chOpt = 1;
+	setsockopt(pOp->Socket, IPPROTO_TCP, TCP_NODELAY, &chOpt, sizeof(char));
+
+	if (pClient->m_pLoop == NULL)
+	{
+		pClient->m_pLoop = pThis->m_pLoop;
+	}
+
+	if (!pClient->CRosaAsyncSocketAttach(pOp->Socket))
+	{
+		closesocket(pOp->Socket);
+		pOp->nResult = SOB_RET_FAIL;
+	}
+
+	pOp->Socket = INVALID_SOCKET;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnRecvFinish()
+// @Purpose: CRosaAsyncSocketɴ(0ֽڱʾԶ˶Ͽ)
+// @Since: v1.00a
+// @Para: LPS_ROSAASYNCOP pOp(״̬)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaAsyncSocket::OnRecvFinish(LPS_ROSAASYNCOP pOp)
+{
+	if (pOp->dwError == 0 && pOp->dwBytes == 0 && pOp->uiSize > 0)
+	{
+		pOp->nResult = SOB_RET_CLOSE;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnConnectDone()
+// @Purpose: CRosaAsyncSocketص(Ͷɰ, Эѭ߳лָ)
+// @Since: v1.00a
+// @Para: ULONGLONG ullConnectID(ID)
+// @Para: SOCKET s(ӳɹ׽)
+// @Para: int nResult(ӽ)
+// @Para: DWORD_PTR dwUser(״̬)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaAsyncSocket::OnConnectDone(ULONGLONG ullConnectID, SOCKET s, int nResult, DWORD_PTR dwUser)
+{
+	LPS_ROSAASYNCOP pOp = (LPS_ROSAASYNCOP)dwUser;
+	CRosaAsyncSocket* pThis = (CRosaAsyncSocket*)pOp->pOwner;
+
+	EnterCriticalSection(&pThis->m_csAsync);
+
+	if (pThis->m_ullConnectID == ullConnectID)
+	{
+		pThis->m_pConnector = NULL;
+		pThis->m_ullConnectID = 0;
+	}
+
+	LeaveCriticalSection(&pThis->m_csAsync);
+
+	pOp->Socket = (nResult == SOB_RET_OK) ? s : INVALID_SOCKET;
+	pOp->nResult = nResult;
+
+	if (!pOp->pLoop->CRosaEventLoopPost(&pOp->Overlapped))
+	{
+		// ¼ѭѾֹͣ, Э̲ٻָ
+		if (pOp->Socket != INVALID_SOCKET)
+		{
+			closesocket(pOp->Socket);
+			pOp->Socket = INVALID_SOCKET;
+		}
+	}
+}
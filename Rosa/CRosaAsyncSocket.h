@@ -0,0 +1,83 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaAsyncSocket.h
+* @brief	This File is RosaAsyncSocket Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSAASYNCSOCKET_H__
+#define __CROSAASYNCSOCKET_H__
+
+//Include Rosa Header File
+#include "CRosaSocket.h"
+#include "CRosaEventLoop.h"
+#include "CRosaConnector.h"
+#include "CRosaCoroutine.h"
+
+using namespace std;
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSAASYNCSOCKET_API	__declspec(dllexport)
+#else
+#define ROSAASYNCSOCKET_API	__declspec(dllimport)
+#endif
+
+#define ROSAASYNCSOCKET_CALLMODE	__stdcall
+
+//Class Definition
+class ROSAASYNCSOCKET_API CRosaAsyncSocket
+{
+public:
+	CRosaAsyncSocket();			// CRosaAsyncSocket 캯
+	~CRosaAsyncSocket();		// CRosaAsyncSocket 
+
+public:
+	bool ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocketCreate(CRosaEventLoop* pLoop);				// CRosaAsyncSocket ¼ѭ
+	bool ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocketAttach(SOCKET s, bool bAttached = false);	// CRosaAsyncSocket ӹص׽(bAttached:ѹͬһ¼ѭ)
+	SOCKET ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocketDetach();									// CRosaAsyncSocket ׽(ر)
+	bool ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocketListen(USHORT sPort, int nBacklog = SOB_DEFAULT_BACKLOG);	// CRosaAsyncSocket ׽
+	void ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocketClose();									// CRosaAsyncSocket ر׽(ȴеĲSOB_RET_FAIL)
+	void ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocketCancel();									// CRosaAsyncSocket ȡȫȴеĲ(SOB_RET_FAIL)
+
+	SOCKET ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocketGetSocket() const;						// CRosaAsyncSocket ȡ׽
+	CRosaEventLoop* ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocketGetLoop() const;				// CRosaAsyncSocket ȡ¼ѭ
+
+	// co_await (SOB_RET_*, ɺ¼ѭ߳мִ)
+	CRosaAsyncOp ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocketConnect(CRosaConnector* pConnector, const char* pcHost, USHORT sPort, DWORD dwAttemptTimeOut = ROSA_CONNECT_ATTEMPT_TIMEOUT);	// CRosaAsyncSocket (ͬһ¼ѭ)
+	CRosaAsyncOp ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocketAccept(CRosaAsyncSocket& Client, DWORD dwTimeOutMSec = INFINITE);							// CRosaAsyncSocket (Client󶨱¼ѭ)
+	CRosaAsyncOp ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocketSend(const char* pSendBuffer, UINT uiBufferSize, DWORD& dwSendBytes, DWORD dwTimeOutMSec = ROSA_ASYNC_TIMEOUT_MSEC);	// CRosaAsyncSocket 
+	CRosaAsyncOp ROSAASYNCSOCKET_CALLMODE CRosaAsyncSocketRecv(char* pRecvBuffer, UINT uiBufferSize, DWORD& dwRecvBytes, DWORD dwTimeOutMSec = ROSA_ASYNC_TIMEOUT_MSEC);		// CRosaAsyncSocket (Զ˶ϿSOB_RET_CLOSE)
+
+private:
+	static DWORD __stdcall OnConnectStart(LPS_ROSAASYNCOP pOp);			// CRosaAsyncSocket 
+	static DWORD __stdcall OnAcceptStart(LPS_ROSAASYNCOP pOp);			// CRosaAsyncSocket ͶAcceptEx
+	static DWORD __stdcall OnSendStart(LPS_ROSAASYNCOP pOp);			// CRosaAsyncSocket ͶWSASend
+	static DWORD __stdcall OnRecvStart(LPS_ROSAASYNCOP pOp);			// CRosaAsyncSocket ͶWSARecv
+
+	static void __stdcall OnConnectFinish(LPS_ROSAASYNCOP pOp);			// CRosaAsyncSocket ɴ
+	static void __stdcall OnAcceptFinish(LPS_ROSAASYNCOP pOp);			// CRosaAsyncSocket ɴ
+	static void __stdcall OnRecvFinish(LPS_ROSAASYNCOP pOp);			// CRosaAsyncSocket ɴ
+
+	static void __stdcall OnConnectDone(ULONGLONG ullConnectID, SOCKET s, int nResult, DWORD_PTR dwUser);	// CRosaAsyncSocket ص(Ͷɰ)
+
+private:
+	CRosaEventLoop* m_pLoop;					// CRosaAsyncSocket ¼ѭ
+	SOCKET m_Socket;							// CRosaAsyncSocket ׽
+	int m_nFamily;								// CRosaAsyncSocket ַ(׽)
+
+	CRITICAL_SECTION m_csAsync;					// CRosaAsyncSocket ٽ
+	CRosaConnector* m_pConnector;				// CRosaAsyncSocket ӵ
+	ULONGLONG m_ullConnectID;					// CRosaAsyncSocket еID
+
+	LPFN_ACCEPTEX m_pfnAcceptEx;				// CRosaAsyncSocket AcceptExչ
+
+};
+
+#endif // !__CROSAASYNCSOCKET_H__
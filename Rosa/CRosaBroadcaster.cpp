@@ -0,0 +1,336 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBroadcaster.cpp
+* @brief	This File is RosaBroadcaster Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBroadcaster.h"
+#include "CThreadSafe.h"
+
+//CRosaBroadcaster 㲥(һüдȫͶ, Ӹ)
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBroadcaster()
+// @Purpose: CRosaBroadcaster캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBroadcaster::CRosaBroadcaster()
+{
+	m_pSlowCallback = NULL;
+	m_dwUser = 0;
+
+	m_ullSkipCount = 0;
+
+	InitializeCriticalSection(&m_csBroadcast);
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBroadcaster()
+// @Purpose: CRosaBroadcaster(ٷͶ)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBroadcaster::~CRosaBroadcaster()
+{
+	m_mapGroup.clear();
+
+	DeleteCriticalSection(&m_csBroadcast);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBroadcasterSetSlowCallback()
+// @Purpose: CRosaBroadcasterӻص(ROSA_BROADCAST_POLICY_NOTIFYʱʹ)
+// @Since: v1.00a
+// @Para: HANDLE_BROADCAST_SLOW_CALLBACK pSlowCallback(ӻص)
+// @Para: DWORD_PTR dwUser(û)
+// @Return: None
+//------------------------------------------------------------------
+void ROSABROADCASTER_CALLMODE CRosaBroadcaster::CRosaBroadcasterSetSlowCallback(HANDLE_BROADCAST_SLOW_CALLBACK pSlowCallback, DWORD_PTR dwUser)
+{
+	CThreadSafe ThreadSafe(&m_csBroadcast);
+
+	m_pSlowCallback = pSlowCallback;
+	m_dwUser = dwUser;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBroadcasterAdd()
+// @Purpose: CRosaBroadcaster(ROSA_BROADCAST_GROUP_ALL)
+// @Since: v1.00a
+// @Para: CRosaSendQueue* pQueue(ѾķͶ)
+// @Return: bool bRet (true:ɹ, false:Ѿ)
+//------------------------------------------------------------------
+bool ROSABROADCASTER_CALLMODE CRosaBroadcaster::CRosaBroadcasterAdd(CRosaSendQueue * pQueue)
+{
+	return CRosaBroadcasterSubscribe(pQueue, ROSA_BROADCAST_GROUP_ALL);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBroadcasterRemove()
+// @Purpose: CRosaBroadcasterƳ(˳ȫ, غ㲥ٷʸ÷Ͷ)
+// @Since: v1.00a
+// @Para: CRosaSendQueue* pQueue(Ͷ)
+// @Return: bool bRet (true:ɹ, false:)
+//------------------------------------------------------------------
+bool ROSABROADCASTER_CALLMODE CRosaBroadcaster::CRosaBroadcasterRemove(CRosaSendQueue * pQueue)
+{
+	CThreadSafe ThreadSafe(&m_csBroadcast);
+
+	bool bRet = false;
+
+	for (map<DWORD, S_BROADCASTGROUP>::iterator iter = m_mapGroup.begin(); iter != m_mapGroup.end();)
+	{
+		if (RemoveFrom(iter->second, pQueue))
+		{
+			bRet = true;
+		}
+
+		if (iter->second.vecQueue.empty())
+		{
+			iter = m_mapGroup.erase(iter);
+		}
+		else
+		{
+			++iter;
+		}
+	}
+
+	return bRet;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBroadcasterSubscribe()
+// @Purpose: CRosaBroadcasterӼ
+// @Since: v1.00a
+// @Para: CRosaSendQueue* pQueue(Ͷ)
+// @Para: DWORD dwGroup(ID)
+// @Return: bool bRet (true:ɹ, false:Ѿڷ)
+//------------------------------------------------------------------
+bool ROSABROADCASTER_CALLMODE CRosaBroadcaster::CRosaBroadcasterSubscribe(CRosaSendQueue * pQueue, DWORD dwGroup)
+{
+	if (pQueue == NULL)
+	{
+		return false;
+	}
+
+	CThreadSafe ThreadSafe(&m_csBroadcast);
+
+	S_BROADCASTGROUP& sGroup = m_mapGroup[dwGroup];
+
+	// , һʱÿα
+	if (!sGroup.mapIndex.insert(make_pair(pQueue, sGroup.vecQueue.size())).second)
+	{
+		return false;
+	}
+
+	sGroup.vecQueue.push_back(pQueue);
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBroadcasterUnsubscribe()
+// @Purpose: CRosaBroadcaster˳
+// @Since: v1.00a
+// @Para: CRosaSendQueue* pQueue(Ͷ)
+// @Para: DWORD dwGroup(ID)
+// @Return: bool bRet (true:ɹ, false:ڷ)
+//------------------------------------------------------------------
+bool ROSABROADCASTER_CALLMODE CRosaBroadcaster::CRosaBroadcasterUnsubscribe(CRosaSendQueue * pQueue, DWORD dwGroup)
+{
+	CThreadSafe ThreadSafe(&m_csBroadcast);
+
+	map<DWORD, S_BROADCASTGROUP>::iterator iter = m_mapGroup.find(dwGroup);
+	if (iter == m_mapGroup.end())
+	{
+		return false;
+	}
+
+	bool bRet = RemoveFrom(iter->second, pQueue);
+
+	if (iter->second.vecQueue.empty())
+	{
+		m_mapGroup.erase(iter);
+	}
+
+	return bRet;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBroadcasterSend()
+// @Purpose: CRosaBroadcaster㲥Ϣ(ֻһ)
+// @Since: v1.00a
+// @Para: const char* pSendBuffer(, غͷ)
+// @Para: UINT uiBufferSize(ͳ)
+// @Para: DWORD dwGroup(ID)
+// @Para: int nPolicy(Ӳ)
+// @Return: UINT uiCount (д)
+//------------------------------------------------------------------
+UINT ROSABROADCASTER_CALLMODE CRosaBroadcaster::CRosaBroadcasterSend(const char * pSendBuffer, UINT uiBufferSize, DWORD dwGroup, int nPolicy)
+{
+	if (uiBufferSize == 0)
+	{
+		return 0;
+	}
+
+	LPS_SHAREDPAYLOAD pPayload = CRosaSendQueue::CRosaSendQueueCreatePayload(pSendBuffer, uiBufferSize);
+	if (pPayload == NULL)
+	{
+		return 0;
+	}
+
+	UINT uiCount = CRosaBroadcasterSendPayload(pPayload, dwGroup, nPolicy);
+
+	// ͶгԼ, ɺͷ
+	CRosaSendQueue::CRosaSendQueueReleasePayload(pPayload);
+
+	return uiCount;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBroadcasterSendPayload()
+// @Purpose: CRosaBroadcaster㲥(ÿֻһýڵ)
+// @Since: v1.00a
+// @Para: LPS_SHAREDPAYLOAD pPayload(, ߳еò)
+// @Para: DWORD dwGroup(ID)
+// @Para: int nPolicy(Ӳ)
+// @Return: UINT uiCount (д)
+//------------------------------------------------------------------
+UINT ROSABROADCASTER_CALLMODE CRosaBroadcaster::CRosaBroadcasterSendPayload(LPS_SHAREDPAYLOAD pPayload, DWORD dwGroup, int nPolicy)
+{
+	if (pPayload == NULL)
+	{
+		return 0;
+	}
+
+	UINT uiCount = 0;
+	vector<CRosaSendQueue*> vecSlow;
+
+	CThreadSafe ThreadSafe(&m_csBroadcast);
+
+	map<DWORD, S_BROADCASTGROUP>::iterator iter = m_mapGroup.find(dwGroup);
+	if (iter == m_mapGroup.end())
+	{
+		return 0;
+	}
+
+	vector<CRosaSendQueue*>& vecQueue = iter->second.vecQueue;
+
+	for (size_t i = 0; i < vecQueue.size(); ++i)
+	{
+		CRosaSendQueue* pQueue = vecQueue[i];
+
+		if (nPolicy != ROSA_BROADCAST_POLICY_QUEUE && pQueue->CRosaSendQueueIsAboveHigh())
+		{
+			m_ullSkipCount++;
+
+			if (nPolicy == ROSA_BROADCAST_POLICY_NOTIFY)
+			{
+				vecSlow.push_back(pQueue);
+			}
+			continue;
+		}
+
+		// д, ¼ѭöٽ
+		if (pQueue->CRosaSendQueuePostShared(pPayload) != SOB_RET_OK)
+		{
+			m_ullSkipCount++;
+			continue;
+		}
+
+		uiCount++;
+	}
+
+	// ٽڻص: ̱߳ȻصƳ, Ͷڻصڼ䲻ᱻ
+	// ٽ, صпƳ; ֮ǰĻصƳӲٻص
+	if (m_pSlowCallback)
+	{
+		for (size_t i = 0; i < vecSlow.size(); ++i)
+		{
+			iter = m_mapGroup.find(dwGroup);
+			if (iter == m_mapGroup.end())
+			{
+				break;
+			}
+
+			if (iter->second.mapIndex.find(vecSlow[i]) != iter->second.mapIndex.end())
+			{
+				m_pSlowCallback(vecSlow[i], m_dwUser);
+			}
+		}
+	}
+
+	return uiCount;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBroadcasterGetCount()
+// @Purpose: CRosaBroadcasterȡе
+// @Since: v1.00a
+// @Para: DWORD dwGroup(ID)
+// @Return: UINT uiCount
+//------------------------------------------------------------------
+UINT ROSABROADCASTER_CALLMODE CRosaBroadcaster::CRosaBroadcasterGetCount(DWORD dwGroup)
+{
+	CThreadSafe ThreadSafe(&m_csBroadcast);
+
+	map<DWORD, S_BROADCASTGROUP>::iterator iter = m_mapGroup.find(dwGroup);
+	if (iter == m_mapGroup.end())
+	{
+		return 0;
+	}
+
+	return (UINT)iter->second.vecQueue.size();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBroadcasterGetSkipCount()
+// @Purpose: CRosaBroadcasterȡۼ(ٻдʧ)
+// @Since: v1.00a
+// @Para: None
+// @Return: ULONGLONG ullCount
+//------------------------------------------------------------------
+ULONGLONG ROSABROADCASTER_CALLMODE CRosaBroadcaster::CRosaBroadcasterGetSkipCount()
+{
+	CThreadSafe ThreadSafe(&m_csBroadcast);
+
+	return m_ullSkipCount;
+}
+
+//------------------------------------------------------------------
+// @Function:	 RemoveFrom()
+// @Purpose: CRosaBroadcasterӷɾ(ĩβ, ˳򲻱֤)
+// @Since: v1.00a
+// @Para: S_BROADCASTGROUP& sGroup()
+// @Para: CRosaSendQueue* pQueue(Ͷ)
+// @Return: bool bRet (true:ɾ, false:ڷ)
+//------------------------------------------------------------------
+bool CRosaBroadcaster::RemoveFrom(S_BROADCASTGROUP & sGroup, CRosaSendQueue * pQueue)
+{
+	map<CRosaSendQueue*, size_t>::iterator iter = sGroup.mapIndex.find(pQueue);
+	if (iter == sGroup.mapIndex.end())
+	{
+		return false;
+	}
+
+	size_t nIndex = iter->second;
+	sGroup.mapIndex.erase(iter);
+
+	if (nIndex + 1 < sGroup.vecQueue.size())
+	{
+		sGroup.vecQueue[nIndex] = sGroup.vecQueue.back();
+		sGroup.mapIndex[sGroup.vecQueue[nIndex]] = nIndex;
+	}
+
+	sGroup.vecQueue.pop_back();
+
+	return true;
+}
@@ -0,0 +1,86 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBroadcaster.h
+* @brief	This File is RosaBroadcaster Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABROADCASTER_H__
+#define __CROSABROADCASTER_H__
+
+//Include Rosa Header File
+#include "CRosaSendQueue.h"
+
+//Include C/C++ Header File
+#include <map>
+#include <vector>
+
+using namespace std;
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSABROADCASTER_API	__declspec(dllexport)
+#else
+#define ROSABROADCASTER_API	__declspec(dllimport)
+#endif
+
+#define ROSABROADCASTER_CALLMODE	__stdcall
+
+#define ROSA_BROADCAST_GROUP_ALL		0				//ȫ(ʱԶ)
+
+#define ROSA_BROADCAST_POLICY_QUEUE		0				//Ӳ:ճд(ֻܷͶڴ)
+#define ROSA_BROADCAST_POLICY_SKIP		1				//Ӳ:ڸˮλ
+#define ROSA_BROADCAST_POLICY_NOTIFY	2				//Ӳ:ص(ӦöϿ)
+
+//Callback Definition
+typedef void(__stdcall *HANDLE_BROADCAST_SLOW_CALLBACK)(CRosaSendQueue* pQueue, DWORD_PTR dwUser);	//ӻص(㲥ǰڷٽڵ, ڻصƳ, ܵȴʹñ㲥߳)
+
+//Struct Definition
+typedef struct
+{
+	vector<CRosaSendQueue*> vecQueue;						// ڵ(㲥ʱ˳)
+	map<CRosaSendQueue*, size_t> mapIndex;					// ->vecQueueеλ(/˳ʱ)
+}S_BROADCASTGROUP, *LPS_BROADCASTGROUP;
+
+//Class Definition
+class ROSABROADCASTER_API CRosaBroadcaster
+{
+public:
+	CRosaBroadcaster();			// CRosaBroadcaster 캯
+	~CRosaBroadcaster();		// CRosaBroadcaster 
+
+public:
+	void ROSABROADCASTER_CALLMODE CRosaBroadcasterSetSlowCallback(HANDLE_BROADCAST_SLOW_CALLBACK pSlowCallback, DWORD_PTR dwUser);	// CRosaBroadcaster ӻص
+
+	bool ROSABROADCASTER_CALLMODE CRosaBroadcasterAdd(CRosaSendQueue* pQueue);							// CRosaBroadcaster (ROSA_BROADCAST_GROUP_ALL)
+	bool ROSABROADCASTER_CALLMODE CRosaBroadcasterRemove(CRosaSendQueue* pQueue);						// CRosaBroadcaster Ƴ(˳ȫ, ٷͶ֮ǰ)
+	bool ROSABROADCASTER_CALLMODE CRosaBroadcasterSubscribe(CRosaSendQueue* pQueue, DWORD dwGroup);		// CRosaBroadcaster Ӽ
+	bool ROSABROADCASTER_CALLMODE CRosaBroadcasterUnsubscribe(CRosaSendQueue* pQueue, DWORD dwGroup);	// CRosaBroadcaster ˳
+
+	UINT ROSABROADCASTER_CALLMODE CRosaBroadcasterSend(const char* pSendBuffer, UINT uiBufferSize, DWORD dwGroup = ROSA_BROADCAST_GROUP_ALL, int nPolicy = ROSA_BROADCAST_POLICY_SKIP);	// CRosaBroadcaster 㲥Ϣ(һ, д)
+	UINT ROSABROADCASTER_CALLMODE CRosaBroadcasterSendPayload(LPS_SHAREDPAYLOAD pPayload, DWORD dwGroup = ROSA_BROADCAST_GROUP_ALL, int nPolicy = ROSA_BROADCAST_POLICY_SKIP);		// CRosaBroadcaster 㲥(, д)
+
+	UINT ROSABROADCASTER_CALLMODE CRosaBroadcasterGetCount(DWORD dwGroup = ROSA_BROADCAST_GROUP_ALL);	// CRosaBroadcaster ȡе
+	ULONGLONG ROSABROADCASTER_CALLMODE CRosaBroadcasterGetSkipCount();									// CRosaBroadcaster ȡۼ(ٻдʧ)
+
+private:
+	static bool RemoveFrom(S_BROADCASTGROUP& sGroup, CRosaSendQueue* pQueue);						// CRosaBroadcaster ӷɾ(ĩβ)
+
+private:
+	CRITICAL_SECTION m_csBroadcast;							// CRosaBroadcaster ٽ
+	map<DWORD, S_BROADCASTGROUP> m_mapGroup;				// CRosaBroadcaster ->(ROSA_BROADCAST_GROUP_ALLΪȫ)
+
+	HANDLE_BROADCAST_SLOW_CALLBACK m_pSlowCallback;			// CRosaBroadcaster ӻص
+	DWORD_PTR m_dwUser;										// CRosaBroadcaster û
+
+	ULONGLONG m_ullSkipCount;								// CRosaBroadcaster ۼ
+
+};
+
+#endif // !__CROSABROADCASTER_H__
@@ -0,0 +1,672 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaCoalescer.cpp
+* @brief	This File is RosaCoalescer Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaCoalescer.h"
+#include "CThreadSafe.h"
+
+//CRosaCoalescer дϲ(ͬһ¼ѭڵСдϲΪһWSASend, ׽ֱTCP_NODELAY)
+
+// ʹתΪֵ(ѶϿSOB_RET_CLOSE)
+static int TranslateSendError(DWORD dwError)
+{
+	switch (dwError)
+	{
+	case WSAECONNRESET:
+	case WSAECONNABORTED:
+	case WSAENETRESET:
+	case WSAESHUTDOWN:
+	case ERROR_NETNAME_DELETED:
+		return SOB_RET_CLOSE;
+	default:
+		return SOB_RET_FAIL;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCoalescer()
+// @Purpose: CRosaCoalescer캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaCoalescer::CRosaCoalescer()
+{
+	m_Socket = INVALID_SOCKET;
+	m_pLoop = NULL;
+	m_hEvent = WSA_INVALID_EVENT;
+
+	m_uiMaxBytes = ROSA_COALESCE_MAX_BYTES;
+	m_llDelayCount = 0;
+	m_llFrequency = 1;
+	m_nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC;
+
+	m_llPendingSince = 0;
+	m_bCorked = false;
+	m_bBroken = false;
+	m_bFlushPosted = false;
+	memset(&m_FlushOverlapped, 0, sizeof(m_FlushOverlapped));
+
+	m_bSending = false;
+	m_bSendAfter = false;
+	m_bClosing = false;
+	memset(&m_SendOverlapped, 0, sizeof(m_SendOverlapped));
+	m_ullDelayTimerID = 0;
+
+	m_ullWriteCount = 0;
+	m_ullSendCount = 0;
+
+	InitializeCriticalSection(&m_csCoalesce);
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaCoalescer()
+// @Purpose: CRosaCoalescer
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaCoalescer::~CRosaCoalescer()
+{
+	CRosaCoalescerDestroy();
+
+	DeleteCriticalSection(&m_csCoalesce);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCoalescerCreate()
+// @Purpose: CRosaCoalescerӵ׽
+// @Since: v1.00a
+// @Para: SOCKET s(ӵTCP׽, Ѿɶ˿)
+// @Para: CRosaEventLoop* pLoop(¼ѭ, δסʱдڱɰ֮ϲ; NULLʱֱӷ)
+// @Para: UINT uiMaxBytes(ϲ)
+// @Para: DWORD dwDelayUSec(ϲԤ, 0ʾֻϲ޼¼ѭ)
+// @Para: USHORT nTimeOutSec(߳ÿη͵ĳʱ)
+// @Para: bool bAttach(Ƿ¼ѭ, Ѿͬһ¼ѭʱfalse; ¼ѭصWSASend)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSACOALESCER_CALLMODE CRosaCoalescer::CRosaCoalescerCreate(SOCKET s, CRosaEventLoop * pLoop, UINT uiMaxBytes, DWORD dwDelayUSec, USHORT nTimeOutSec, bool bAttach)
+{
+	if (m_Socket != INVALID_SOCKET || s == INVALID_SOCKET || uiMaxBytes == 0)
+	{
+		return false;
+	}
+
+	if (pLoop != NULL && bAttach && !pLoop->CRosaEventLoopAttach((HANDLE)s))
+	{
+		return false;
+	}
+
+	m_hEvent = WSACreateEvent();
+	if (m_hEvent == WSA_INVALID_EVENT)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER liFrequency;
+	QueryPerformanceFrequency(&liFrequency);
+
+	m_Socket = s;
+	m_pLoop = pLoop;
+
+	m_uiMaxBytes = uiMaxBytes;
+	m_llDelayCount = dwDelayUSec ? liFrequency.QuadPart * dwDelayUSec / 1000000 : 0;
+	m_llFrequency = liFrequency.QuadPart;
+	m_nTimeOutSec = nTimeOutSec;
+
+	m_vecPending.clear();
+	m_vecPending.reserve(uiMaxBytes);
+	m_bCorked = false;
+	m_bBroken = false;
+	m_bFlushPosted = false;
+
+	m_vecSending.clear();
+	m_bSending = false;
+	m_bSendAfter = false;
+	m_bClosing = false;
+	m_ullDelayTimerID = 0;
+
+	m_ullWriteCount = 0;
+	m_ullSendCount = 0;
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCoalescerDestroy()
+// @Purpose: CRosaCoalescerʣݲ(ر׽)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSACOALESCER_CALLMODE CRosaCoalescer::CRosaCoalescerDestroy()
+{
+	if (m_Socket == INVALID_SOCKET)
+	{
+		return;
+	}
+
+	ULONGLONG ullTimerID = 0;
+
+	{
+		CThreadSafe ThreadSafe(&m_csCoalesce);
+
+		// ֮ɰʱٷ, ʣɱ̷߳
+		m_bClosing = true;
+		ullTimerID = m_ullDelayTimerID;
+		m_ullDelayTimerID = 0;
+	}
+
+	// ٽɾ(ɾʱܵȴִеĶʱص)
+	if (ullTimerID != 0)
+	{
+		m_pLoop->CRosaEventLoopKillTimer(ullTimerID);
+	}
+
+	// ȴͶݵɰصʹ(¼ѭֹͣٴ)
+	while ((m_bFlushPosted || m_bSending) && m_pLoop != NULL && m_pLoop->CRosaEventLoopIsRunning())
+	{
+		Sleep(0);
+	}
+
+	{
+		CThreadSafe ThreadSafe(&m_csCoalesce);
+
+		// ¼ѭѾֹͣصδʱ, ֽ, ʣݶ
+		if (m_bSending)
+		{
+			DWORD dwSent = 0;
+			DWORD dwFlags = 0;
+
+			// ȡȴ, ͻſͷ
+			CancelIoEx((HANDLE)m_Socket, &m_SendOverlapped.Overlapped);
+			WSAGetOverlappedResult(m_Socket, &m_SendOverlapped.Overlapped, &dwSent, TRUE, &dwFlags);
+			m_bBroken = true;
+		}
+
+		if (!m_bBroken)
+		{
+			SendPending(NULL, 0);
+		}
+	}
+
+	WSACloseEvent(m_hEvent);
+	m_hEvent = WSA_INVALID_EVENT;
+
+	m_Socket = INVALID_SOCKET;
+	m_pLoop = NULL;
+	m_vecPending.clear();
+	m_vecSending.clear();
+	m_bFlushPosted = false;
+	m_bSending = false;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCoalescerWrite()
+// @Purpose: CRosaCoalescerд
+// @Since: v1.00a
+// @Para: const char* pSendBuffer(, غͷ)
+// @Para: UINT uiBufferSize(ͳ)
+// @Para: bool bUrgent(ӳ, ͬѺϲ)
+// @Return: int nRet (SOB_RET_OK:ɹ(ѷͻѺϲ), SOB_RET_FAIL:ʧ, SOB_RET_TIMEOUT:ʱ, SOB_RET_CLOSE:Ͽ)
+//------------------------------------------------------------------
+int ROSACOALESCER_CALLMODE CRosaCoalescer::CRosaCoalescerWrite(const char * pSendBuffer, UINT uiBufferSize, bool bUrgent)
+{
+	CThreadSafe ThreadSafe(&m_csCoalesce);
+
+	if (m_Socket == INVALID_SOCKET)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	if (m_bBroken)
+	{
+		return SOB_RET_CLOSE;
+	}
+
+	m_ullWriteCount++;
+
+	// ӳлд벻, Ѻϲһη
+	if (bUrgent || uiBufferSize >= m_uiMaxBytes || (m_pLoop == NULL && !m_bCorked))
+	{
+		return SendPending(pSendBuffer, uiBufferSize);
+	}
+
+	int nRet = SOB_RET_OK;
+
+	if (m_vecPending.size() + uiBufferSize > m_uiMaxBytes)
+	{
+		nRet = SendPending(NULL, 0);
+		if (nRet != SOB_RET_OK)
+		{
+			return nRet;
+		}
+	}
+
+	LARGE_INTEGER liNow;
+	QueryPerformanceCounter(&liNow);
+
+	if (m_vecPending.empty())
+	{
+		m_llPendingSince = liNow.QuadPart;
+	}
+
+	m_vecPending.insert(m_vecPending.end(), pSendBuffer, pSendBuffer + uiBufferSize);
+
+	// ﵽϲ޻򳬹ϲԤ
+	if (m_vecPending.size() >= m_uiMaxBytes || (m_llDelayCount != 0 && liNow.QuadPart - m_llPendingSince >= m_llDelayCount))
+	{
+		return SendPending(NULL, 0);
+	}
+
+	// סʱ֮ûд, ϲԤɶʱ֤
+	if (m_bCorked)
+	{
+		ArmDelayTimer();
+	}
+
+	// ¼ѭڵĺдϲ, Ͷݵɰѵɰ֮
+	if (m_pLoop != NULL && !m_bCorked && !m_bFlushPosted)
+	{
+		memset(&m_FlushOverlapped, 0, sizeof(m_FlushOverlapped));
+		m_FlushOverlapped.pCallback = OnFlushPosted;
+		m_FlushOverlapped.pUser = this;
+
+		m_bFlushPosted = true;
+
+		if (!m_pLoop->CRosaEventLoopPost(&m_FlushOverlapped))
+		{
+			m_bFlushPosted = false;
+			return SendPending(NULL, 0);
+		}
+	}
+
+	return SOB_RET_OK;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCoalescerFlush()
+// @Purpose: CRosaCoalescerѺϲ
+// @Since: v1.00a
+// @Para: None
+// @Return: int nRet (SOB_RET_OK:ɹ, SOB_RET_FAIL:ʧ, SOB_RET_TIMEOUT:ʱ, SOB_RET_CLOSE:Ͽ)
+//------------------------------------------------------------------
+int ROSACOALESCER_CALLMODE CRosaCoalescer::CRosaCoalescerFlush()
+{
+	CThreadSafe ThreadSafe(&m_csCoalesce);
+
+	if (m_Socket == INVALID_SOCKET)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	if (m_bBroken)
+	{
+		return SOB_RET_CLOSE;
+	}
+
+	return SendPending(NULL, 0);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCoalescerCork()
+// @Purpose: CRosaCoalescerס(дڼֻϲ/ϲԤ㷢)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSACOALESCER_CALLMODE CRosaCoalescer::CRosaCoalescerCork()
+{
+	CThreadSafe ThreadSafe(&m_csCoalesce);
+
+	m_bCorked = true;
+
+	ArmDelayTimer();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCoalescerUncork()
+// @Purpose: CRosaCoalescerסѺϲ
+// @Since: v1.00a
+// @Para: None
+// @Return: int nRet (SOB_RET_OK:ɹ, SOB_RET_FAIL:ʧ, SOB_RET_TIMEOUT:ʱ, SOB_RET_CLOSE:Ͽ)
+//------------------------------------------------------------------
+int ROSACOALESCER_CALLMODE CRosaCoalescer::CRosaCoalescerUncork()
+{
+	CThreadSafe ThreadSafe(&m_csCoalesce);
+
+	m_bCorked = false;
+
+	if (m_Socket == INVALID_SOCKET)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	if (m_bBroken)
+	{
+		return SOB_RET_CLOSE;
+	}
+
+	return SendPending(NULL, 0);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCoalescerGetPendingBytes()
+// @Purpose: CRosaCoalescerȡȴ͵ֽ
+// @Since: v1.00a
+// @Para: None
+// @Return: UINT uiBytes
+//------------------------------------------------------------------
+UINT ROSACOALESCER_CALLMODE CRosaCoalescer::CRosaCoalescerGetPendingBytes()
+{
+	CThreadSafe ThreadSafe(&m_csCoalesce);
+
+	return (UINT)m_vecPending.size();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCoalescerGetWriteCount()
+// @Purpose: CRosaCoalescerȡд
+// @Since: v1.00a
+// @Para: None
+// @Return: ULONGLONG ullCount
+//------------------------------------------------------------------
+ULONGLONG ROSACOALESCER_CALLMODE CRosaCoalescer::CRosaCoalescerGetWriteCount()
+{
+	CThreadSafe ThreadSafe(&m_csCoalesce);
+
+	return m_ullWriteCount;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCoalescerGetSendCount()
+// @Purpose: CRosaCoalescerȡʵʷʹ
+// @Since: v1.00a
+// @Para: None
+// @Return: ULONGLONG ullCount
+//------------------------------------------------------------------
+ULONGLONG ROSACOALESCER_CALLMODE CRosaCoalescer::CRosaCoalescerGetSendCount()
+{
+	CThreadSafe ThreadSafe(&m_csCoalesce);
+
+	return m_ullSendCount;
+}
+
+//------------------------------------------------------------------
+// @Function:	 SendPending()
+// @Purpose: CRosaCoalescerһWSASendѺϲݼ(߳m_csCoalesce)
+// @Since: v1.00a
+// @Para: const char* pExtra(, Ѻϲ֮, )
+// @Para: UINT uiExtra(ݳ)
+// @Return: int nRet (SOB_RET_OK:ɹ, SOB_RET_FAIL:ʧ, SOB_RET_TIMEOUT:ʱ, SOB_RET_CLOSE:Ͽ)
+//------------------------------------------------------------------
+int CRosaCoalescer::SendPending(const char * pExtra, UINT uiExtra)
+{
+	// صͽ, Ѻϲɺ, ֽ֤˳
+	if (m_bSending)
+	{
+		if (uiExtra != 0)
+		{
+			m_vecPending.insert(m_vecPending.end(), pExtra, pExtra + uiExtra);
+		}
+
+		m_bSendAfter = true;
+		return SOB_RET_OK;
+	}
+
+	WSABUF wsaBuf[2];
+	DWORD dwCount = 0;
+	DWORD dwTotal = 0;
+
+	if (!m_vecPending.empty())
+	{
+		wsaBuf[dwCount].buf = m_vecPending.data();
+		wsaBuf[dwCount].len = (ULONG)m_vecPending.size();
+		dwTotal += wsaBuf[dwCount].len;
+		dwCount++;
+	}
+
+	if (uiExtra != 0)
+	{
+		wsaBuf[dwCount].buf = (char*)pExtra;
+		wsaBuf[dwCount].len = uiExtra;
+		dwTotal += wsaBuf[dwCount].len;
+		dwCount++;
+	}
+
+	if (dwCount == 0)
+	{
+		return SOB_RET_OK;
+	}
+
+	// ¼λ1׽ֹɶ˿ʱͶɰ
+	WSAOVERLAPPED Overlapped;
+	memset(&Overlapped, 0, sizeof(Overlapped));
+	Overlapped.hEvent = (WSAEVENT)((DWORD_PTR)m_hEvent | 1);
+	WSAResetEvent(m_hEvent);
+
+	int nRet = SOB_RET_OK;
+	DWORD dwSent = 0;
+	DWORD dwFlags = 0;
+
+	if (WSASend(m_Socket, wsaBuf, dwCount, NULL, 0, &Overlapped, NULL) == SOCKET_ERROR && WSAGetLastError() != WSA_IO_PENDING)
+	{
+		nRet = TranslateSendError(WSAGetLastError());
+	}
+	else
+	{
+		bool bIsTimeOut = false;
+
+		if (WSAWaitForMultipleEvents(1, &m_hEvent, FALSE, m_nTimeOutSec * 1000, FALSE) != WSA_WAIT_EVENT_0)
+		{
+			bIsTimeOut = true;
+			CancelIoEx((HANDLE)m_Socket, &Overlapped);
+		}
+
+		// ȡȴ, صṹſͷ
+		if (!WSAGetOverlappedResult(m_Socket, &Overlapped, &dwSent, TRUE, &dwFlags))
+		{
+			DWORD dwError = WSAGetLastError();
+			nRet = (bIsTimeOut && dwError == WSA_OPERATION_ABORTED) ? SOB_RET_TIMEOUT : TranslateSendError(dwError);
+		}
+		else if (dwSent != dwTotal)
+		{
+			nRet = SOB_RET_FAIL;
+		}
+	}
+
+	m_vecPending.clear();
+
+	// ַͺֽѲ, ֮дȫܾ
+	if (nRet != SOB_RET_OK)
+	{
+		m_bBroken = true;
+		return nRet;
+	}
+
+	m_ullSendCount++;
+
+	return SOB_RET_OK;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnFlushPosted()
+// @Purpose: CRosaCoalescer¼ѭɰ֮
+// @Since: v1.00a
+// @Para: LPS_ROSAOVERLAPPED pOverlapped(m_FlushOverlapped)
+// @Para: DWORD dwBytes(δʹ)
+// @Para: DWORD dwError(δʹ)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaCoalescer::OnFlushPosted(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError)
+{
+	CRosaCoalescer* pThis = (CRosaCoalescer*)pOverlapped->pUser;
+
+	{
+		CThreadSafe ThreadSafe(&pThis->m_csCoalesce);
+
+		// ڼ䱻סʱɽס; ¼ѭ߳вȴ
+		if (!pThis->m_bCorked && !pThis->m_bBroken && !pThis->m_bClosing && pThis->m_Socket != INVALID_SOCKET)
+		{
+			pThis->StartAsyncSend();
+		}
+	}
+
+	// 뿪ٽ֮, CRosaCoalescerDestroyغٷʶ
+	pThis->m_bFlushPosted = false;
+}
+
+//------------------------------------------------------------------
+// @Function:	 StartAsyncSend()
+// @Purpose: CRosaCoalescerѺϲصWSASend(¼ѭʹ, ȴ; ߳m_csCoalesce)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaCoalescer::StartAsyncSend()
+{
+	// һηɺ
+	if (m_bSending)
+	{
+		m_bSendAfter = true;
+		return;
+	}
+
+	m_bSendAfter = false;
+
+	if (m_vecPending.empty())
+	{
+		return;
+	}
+
+	m_vecSending.swap(m_vecPending);
+	m_vecPending.clear();
+
+	WSABUF wsaBuf;
+	wsaBuf.buf = m_vecSending.data();
+	wsaBuf.len = (ULONG)m_vecSending.size();
+
+	memset(&m_SendOverlapped, 0, sizeof(m_SendOverlapped));
+	m_SendOverlapped.pCallback = OnSendComplete;
+	m_SendOverlapped.pUser = this;
+
+	m_bSending = true;
+
+	if (WSASend(m_Socket, &wsaBuf, 1, NULL, 0, &m_SendOverlapped.Overlapped, NULL) == SOCKET_ERROR && WSAGetLastError() != WSA_IO_PENDING)
+	{
+		m_bSending = false;
+		m_bBroken = true;
+		m_vecSending.clear();
+		m_vecPending.clear();
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 ArmDelayTimer()
+// @Purpose: CRosaCoalescerסѺϲʱϲԤʣʱöʱ(߳m_csCoalesce)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaCoalescer::ArmDelayTimer()
+{
+	if (m_pLoop == NULL || m_llDelayCount == 0 || m_ullDelayTimerID != 0 || m_bClosing || m_vecPending.empty())
+	{
+		return;
+	}
+
+	LARGE_INTEGER liNow;
+	QueryPerformanceCounter(&liNow);
+
+	// ʣԤȡ
+	LONGLONG llLeft = m_llDelayCount - (liNow.QuadPart - m_llPendingSince);
+	DWORD dwDelayMSec = (llLeft > 0) ? (DWORD)((llLeft * 1000 + m_llFrequency - 1) / m_llFrequency) : 0;
+
+	m_ullDelayTimerID = m_pLoop->CRosaEventLoopSetTimer(dwDelayMSec, 0, OnDelayTimer, this);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnSendComplete()
+// @Purpose: CRosaCoalescerص(¼ѭ߳, ڼ۵ݼ)
+// @Since: v1.00a
+// @Para: LPS_ROSAOVERLAPPED pOverlapped(m_SendOverlapped)
+// @Para: DWORD dwBytes(ֽ)
+// @Para: DWORD dwError()
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaCoalescer::OnSendComplete(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError)
+{
+	CRosaCoalescer* pThis = (CRosaCoalescer*)pOverlapped->pUser;
+
+	CThreadSafe ThreadSafe(&pThis->m_csCoalesce);
+
+	// ַͺֽѲ, ֮дȫܾ
+	if (dwError != 0 || dwBytes != (DWORD)pThis->m_vecSending.size())
+	{
+		pThis->m_bBroken = true;
+		pThis->m_vecPending.clear();
+	}
+	else
+	{
+		pThis->m_ullSendCount++;
+	}
+
+	pThis->m_vecSending.clear();
+
+	// , CRosaCoalescerDestroyԴжصͽ
+	if (!pThis->m_bBroken && !pThis->m_bClosing && (pThis->m_bSendAfter || !pThis->m_bCorked))
+	{
+		pThis->m_bSending = false;
+		pThis->StartAsyncSend();
+		return;
+	}
+
+	pThis->m_bSending = false;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnDelayTimer()
+// @Purpose: CRosaCoalescerϲԤ㵽(סûкдʱѺϲ)
+// @Since: v1.00a
+// @Para: ULONGLONG ullTimerID(ʱID)
+// @Para: void* pUser(CRosaCoalescer)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaCoalescer::OnDelayTimer(ULONGLONG ullTimerID, void * pUser)
+{
+	CRosaCoalescer* pThis = (CRosaCoalescer*)pUser;
+
+	CThreadSafe ThreadSafe(&pThis->m_csCoalesce);
+
+	if (ullTimerID != pThis->m_ullDelayTimerID)
+	{
+		return;
+	}
+
+	pThis->m_ullDelayTimerID = 0;
+
+	// Ѿͻס(ɽס¼ѭ)
+	if (!pThis->m_bCorked || pThis->m_bBroken || pThis->m_bClosing || pThis->m_vecPending.empty())
+	{
+		return;
+	}
+
+	LARGE_INTEGER liNow;
+	QueryPerformanceCounter(&liNow);
+
+	// ԤڵǶʱú»۵, ʣԤ
+	if (liNow.QuadPart - pThis->m_llPendingSince < pThis->m_llDelayCount)
+	{
+		pThis->ArmDelayTimer();
+		return;
+	}
+
+	pThis->StartAsyncSend();
+}
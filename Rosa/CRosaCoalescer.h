@@ -0,0 +1,98 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaCoalescer.h
+* @brief	This File is RosaCoalescer Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSACOALESCER_H__
+#define __CROSACOALESCER_H__
+
+//Include Rosa Header File
+#include "CRosaSocket.h"
+#include "CRosaEventLoop.h"
+
+//Include C/C++ Header File
+#include <vector>
+
+using namespace std;
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSACOALESCER_API	__declspec(dllexport)
+#else
+#define ROSACOALESCER_API	__declspec(dllimport)
+#endif
+
+#define ROSACOALESCER_CALLMODE	__stdcall
+
+#define ROSA_COALESCE_MAX_BYTES		(16 * 1024)		//ϲ(ֽ, ﵽ, Сڸֵд벻)
+#define ROSA_COALESCE_DELAY_USEC	200				//ϲԤ(΢, һд֮󳬹ʱд봥; סûкдʱ¼ѭʱ, Ϊʱ)
+
+//Class Definition
+class ROSACOALESCER_API CRosaCoalescer
+{
+public:
+	CRosaCoalescer();			// CRosaCoalescer 캯
+	~CRosaCoalescer();			// CRosaCoalescer 
+
+public:
+	bool ROSACOALESCER_CALLMODE CRosaCoalescerCreate(SOCKET s, CRosaEventLoop* pLoop = NULL, UINT uiMaxBytes = ROSA_COALESCE_MAX_BYTES, DWORD dwDelayUSec = ROSA_COALESCE_DELAY_USEC, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC, bool bAttach = true);	// CRosaCoalescer ӵ׽
+	void ROSACOALESCER_CALLMODE CRosaCoalescerDestroy();								// CRosaCoalescer ʣݲ(ر׽)
+
+	int ROSACOALESCER_CALLMODE CRosaCoalescerWrite(const char* pSendBuffer, UINT uiBufferSize, bool bUrgent = false);	// CRosaCoalescer д(bUrgentΪtrueʱͬѺϲ)
+	int ROSACOALESCER_CALLMODE CRosaCoalescerFlush();									// CRosaCoalescer Ѻϲ
+
+	void ROSACOALESCER_CALLMODE CRosaCoalescerCork();									// CRosaCoalescer ס(ֻϲ/ϲԤ㷢)
+	int ROSACOALESCER_CALLMODE CRosaCoalescerUncork();									// CRosaCoalescer סѺϲ
+
+	UINT ROSACOALESCER_CALLMODE CRosaCoalescerGetPendingBytes();						// CRosaCoalescer ȡȴ͵ֽ
+	ULONGLONG ROSACOALESCER_CALLMODE CRosaCoalescerGetWriteCount();						// CRosaCoalescer ȡд
+	ULONGLONG ROSACOALESCER_CALLMODE CRosaCoalescerGetSendCount();						// CRosaCoalescer ȡʵʷʹ(д֮ȼϲЧ)
+
+private:
+	int SendPending(const char* pExtra, UINT uiExtra);									// CRosaCoalescer һWSASendѺϲݼ(߳m_csCoalesce)
+	void StartAsyncSend();																// CRosaCoalescer ѺϲصWSASend, ȴ(߳m_csCoalesce)
+	void ArmDelayTimer();																// CRosaCoalescer סʱϲԤöʱ(߳m_csCoalesce)
+
+	static void __stdcall OnFlushPosted(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError);	// CRosaCoalescer ¼ѭɰ֮
+	static void __stdcall OnSendComplete(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError);	// CRosaCoalescer ص(¼ѭ߳)
+	static void __stdcall OnDelayTimer(ULONGLONG ullTimerID, void* pUser);								// CRosaCoalescer ϲԤ㵽(¼ѭʱ߳)
+
+private:
+	SOCKET m_Socket;										// CRosaCoalescer ׽
+	CRosaEventLoop* m_pLoop;								// CRosaCoalescer ¼ѭ(NULLʱδסдֱӷ)
+	WSAEVENT m_hEvent;										// CRosaCoalescer ¼
+
+	UINT m_uiMaxBytes;										// CRosaCoalescer ϲ
+	LONGLONG m_llDelayCount;								// CRosaCoalescer ϲԤ(ܼ)
+	LONGLONG m_llFrequency;									// CRosaCoalescer ܼƵ
+	USHORT m_nTimeOutSec;									// CRosaCoalescer ͳʱ
+
+	CRITICAL_SECTION m_csCoalesce;							// CRosaCoalescer ٽ(֤д˳)
+	vector<char> m_vecPending;								// CRosaCoalescer Ѻϲ
+	LONGLONG m_llPendingSince;								// CRosaCoalescer һκϲдʱ(ܼ)
+	bool m_bCorked;											// CRosaCoalescer Ƿס
+	bool m_bBroken;											// CRosaCoalescer ʧ(֮д뷵SOB_RET_CLOSE)
+	volatile bool m_bFlushPosted;							// CRosaCoalescer ǷͶݷɰ
+	S_ROSAOVERLAPPED m_FlushOverlapped;						// CRosaCoalescer ɰ
+
+	vector<char> m_vecSending;								// CRosaCoalescer صе
+	volatile bool m_bSending;								// CRosaCoalescer Ƿصͽ(ķѺϲ)
+	bool m_bSendAfter;										// CRosaCoalescer صɺѺϲ
+	bool m_bClosing;										// CRosaCoalescer ڽ(ٷصͼʱ)
+	S_ROSAOVERLAPPED m_SendOverlapped;						// CRosaCoalescer ص
+	ULONGLONG m_ullDelayTimerID;							// CRosaCoalescer ϲԤ㶨ʱ(0:δ)
+
+	ULONGLONG m_ullWriteCount;								// CRosaCoalescer д
+	ULONGLONG m_ullSendCount;								// CRosaCoalescer ʵʷʹ
+
+};
+
+#endif // !__CROSACOALESCER_H__
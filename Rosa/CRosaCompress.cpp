@@ -0,0 +1,938 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaCompress.cpp
+* @brief	This File is RosaCompress Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaCompress.h"
+
+//CRosaCompress Ϣѹ(LZ4ʽ, ģʽʹԤֵ, ģʽ64KϢΪֵ, ״̬Զ)
+
+#define COMPRESS_HASH_SIZE			(1 << ROSA_COMPRESS_HASH_LOG)
+#define COMPRESS_HISTORY_SIZE		(2 * ROSA_COMPRESS_WINDOW)
+#define COMPRESS_MIN_MATCH			4				// ƥ
+#define COMPRESS_LAST_LITERALS		5				// ĩβٱ(LZ4ʽҪ)
+#define COMPRESS_MF_LIMIT			12				// һƥĩβС(LZ4ʽҪ)
+#define COMPRESS_SKIP_TRIGGER		6				// δ2^6κӴҲ
+
+// ȡ4ֽ(Ҫ)
+static inline UINT Read32(const BYTE* p)
+{
+	UINT uiValue;
+	memcpy(&uiValue, p, sizeof(uiValue));
+	return uiValue;
+}
+
+// 4ֽڵĹϣλ
+static inline UINT Hash32(UINT uiValue)
+{
+	return (uiValue * 2654435761U) >> (32 - ROSA_COMPRESS_HASH_LOG);
+}
+
+// д볤ȵչֽ(ÿֽ255, һֽС255)
+static inline BYTE* WriteLength(BYTE* pOut, UINT uiLength)
+{
+	while (uiLength >= 255)
+	{
+		*pOut++ = 255;
+		uiLength -= 255;
+	}
+	*pOut++ = (BYTE)uiLength;
+
+	return pOut;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCompress()
+// @Purpose: CRosaCompress캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaCompress::CRosaCompress()
+{
+	m_nMode = ROSA_COMPRESS_MODE_NONE;
+	m_dwDictID = 0;
+	m_uiDictSize = 0;
+
+	m_pEncHistory = NULL;
+	m_uiEncLength = 0;
+	m_puiEncHash = NULL;
+	m_puiDictHash = NULL;
+	m_pUndo = NULL;
+
+	m_pDecHistory = NULL;
+	m_uiDecLength = 0;
+
+	memset(&m_sStats, 0, sizeof(m_sStats));
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaCompress()
+// @Purpose: CRosaCompress
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaCompress::~CRosaCompress()
+{
+	CRosaCompressDestroy();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCompressCreate()
+// @Purpose: CRosaCompress״̬(δʱΪֻ֡Ĳѹģʽ)
+// @Since: v1.00a
+// @Para: int nMode(ROSA_COMPRESS_MODE_*)
+// @Para: const char* pDict(Ԥֵ, ͬ, Ϣƴ)
+// @Para: UINT uiDictSize(ֵ䳤)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSACOMPRESS_CALLMODE CRosaCompress::CRosaCompressCreate(int nMode, const char * pDict, UINT uiDictSize)
+{
+	CRosaCompressDestroy();
+
+	if (nMode < ROSA_COMPRESS_MODE_NONE || nMode > ROSA_COMPRESS_MODE_STREAM)
+	{
+		return false;
+	}
+
+	m_nMode = nMode;
+
+	if (m_nMode == ROSA_COMPRESS_MODE_NONE)
+	{
+		return true;
+	}
+
+	// ֵIDֵ, ֻĩβһ(ƥ벻)
+	m_dwDictID = CRosaCompressDictID(pDict, uiDictSize);
+
+	if (pDict != NULL && uiDictSize > ROSA_COMPRESS_WINDOW)
+	{
+		pDict += uiDictSize - ROSA_COMPRESS_WINDOW;
+		uiDictSize = ROSA_COMPRESS_WINDOW;
+	}
+
+	m_uiDictSize = (pDict != NULL) ? uiDictSize : 0;
+
+	m_pEncHistory = new BYTE[COMPRESS_HISTORY_SIZE];
+	m_pDecHistory = new BYTE[COMPRESS_HISTORY_SIZE];
+	m_puiEncHash = new UINT[COMPRESS_HASH_SIZE];
+	m_puiDictHash = new UINT[COMPRESS_HASH_SIZE];
+	m_pUndo = new S_COMPRESSUNDO[ROSA_COMPRESS_UNDO_MAX];
+
+	if (m_uiDictSize > 0)
+	{
+		memcpy(m_pEncHistory, pDict, m_uiDictSize);
+		memcpy(m_pDecHistory, pDict, m_uiDictSize);
+	}
+
+	LoadDict();
+	CRosaCompressReset();
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCompressDestroy()
+// @Purpose: CRosaCompressͷű״̬(صѹģʽ)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSACOMPRESS_CALLMODE CRosaCompress::CRosaCompressDestroy()
+{
+	if (m_pEncHistory)
+	{
+		delete[] m_pEncHistory;
+		m_pEncHistory = NULL;
+	}
+
+	if (m_pDecHistory)
+	{
+		delete[] m_pDecHistory;
+		m_pDecHistory = NULL;
+	}
+
+	if (m_puiEncHash)
+	{
+		delete[] m_puiEncHash;
+		m_puiEncHash = NULL;
+	}
+
+	if (m_puiDictHash)
+	{
+		delete[] m_puiDictHash;
+		m_puiDictHash = NULL;
+	}
+
+	if (m_pUndo)
+	{
+		delete[] m_pUndo;
+		m_pUndo = NULL;
+	}
+
+	m_nMode = ROSA_COMPRESS_MODE_NONE;
+	m_dwDictID = 0;
+	m_uiDictSize = 0;
+	m_uiEncLength = 0;
+	m_uiDecLength = 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCompressReset()
+// @Purpose: CRosaCompressصʼ״̬(ģʽʷ, ͬʱ)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSACOMPRESS_CALLMODE CRosaCompress::CRosaCompressReset()
+{
+	if (m_nMode == ROSA_COMPRESS_MODE_NONE)
+	{
+		return;
+	}
+
+	m_uiEncLength = m_uiDictSize;
+	m_uiDecLength = m_uiDictSize;
+	memcpy(m_puiEncHash, m_puiDictHash, COMPRESS_HASH_SIZE * sizeof(UINT));
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCompressGetMode()
+// @Purpose: CRosaCompressȡѹģʽ
+// @Since: v1.00a
+// @Para: None
+// @Return: int nMode (ROSA_COMPRESS_MODE_*)
+//------------------------------------------------------------------
+int ROSACOMPRESS_CALLMODE CRosaCompress::CRosaCompressGetMode() const
+{
+	return m_nMode;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCompressGetDictID()
+// @Purpose: CRosaCompressȡֵID
+// @Since: v1.00a
+// @Para: None
+// @Return: DWORD dwDictID (0:ֵ)
+//------------------------------------------------------------------
+DWORD ROSACOMPRESS_CALLMODE CRosaCompress::CRosaCompressGetDictID() const
+{
+	return m_dwDictID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCompressEncodeFrame()
+// @Purpose: CRosaCompressһ֡(ѹСԭʼʱԭ, ģʽͬʷ)
+// @Since: v1.00a
+// @Para: const char* pSrc(Ϣ)
+// @Para: UINT uiSrcSize(Ϣ)
+// @Para: UINT& uiFrameSize(֡, ֡ͷ)
+// @Para: bool bCompress(false:ֻ֡, Զδȷ)
+// @Return: const char* pFrame (ڲ, ´αǰЧ, NULL:Ϣ)
+//------------------------------------------------------------------
+const char * ROSACOMPRESS_CALLMODE CRosaCompress::CRosaCompressEncodeFrame(const char * pSrc, UINT uiSrcSize, UINT & uiFrameSize, bool bCompress)
+{
+	uiFrameSize = 0;
+
+	if (uiSrcSize > ROSA_COMPRESS_MAX_MESSAGE)
+	{
+		return NULL;
+	}
+
+	UINT uiBound = CRosaCompressBound(uiSrcSize);
+	if (m_vecFrame.size() < uiBound)
+	{
+		m_vecFrame.resize(uiBound);
+	}
+
+	const BYTE* pMessage = reinterpret_cast<const BYTE*>(pSrc);
+	BYTE* pData = reinterpret_cast<BYTE*>(&m_vecFrame[0]) + sizeof(S_COMPRESSHEADER);
+	UINT uiData = 0;
+
+	// ѹСԭʼ, ԭ
+	bool bTry = bCompress && m_nMode != ROSA_COMPRESS_MODE_NONE && uiSrcSize >= ROSA_COMPRESS_MIN_SIZE;
+
+	if (m_nMode == ROSA_COMPRESS_MODE_STREAM)
+	{
+		if (uiSrcSize > ROSA_COMPRESS_WINDOW)
+		{
+			// ڵϢѹ, ֮˵ʷ
+			memset(m_puiEncHash, 0, COMPRESS_HASH_SIZE * sizeof(UINT));
+
+			if (bTry)
+			{
+				uiData = CRosaCompressEncodeBlock(pMessage, 0, uiSrcSize, pData, uiSrcSize - 1, m_puiEncHash);
+			}
+
+			memset(m_puiEncHash, 0, COMPRESS_HASH_SIZE * sizeof(UINT));
+			m_uiEncLength = 0;
+		}
+		else
+		{
+			SlideEncoder(uiSrcSize);
+			memcpy(m_pEncHistory + m_uiEncLength, pMessage, uiSrcSize);
+
+			if (bTry)
+			{
+				uiData = CRosaCompressEncodeBlock(m_pEncHistory, m_uiEncLength, uiSrcSize, pData, uiSrcSize - 1, m_puiEncHash);
+			}
+
+			m_uiEncLength += uiSrcSize;
+		}
+	}
+	else if (bTry)
+	{
+		if (uiSrcSize <= COMPRESS_HISTORY_SIZE - m_uiDictSize)
+		{
+			// Ϣֵ֮ѹ, Թϣ޸, һϢֵֻ
+			UINT uiUndo = 0;
+
+			memcpy(m_pEncHistory + m_uiDictSize, pMessage, uiSrcSize);
+			uiData = CRosaCompressEncodeBlock(m_pEncHistory, m_uiDictSize, uiSrcSize, pData, uiSrcSize - 1, m_puiEncHash, m_pUndo, &uiUndo);
+
+			if (uiUndo > ROSA_COMPRESS_UNDO_MAX)
+			{
+				memcpy(m_puiEncHash, m_puiDictHash, COMPRESS_HASH_SIZE * sizeof(UINT));
+			}
+			else
+			{
+				while (uiUndo > 0)
+				{
+					--uiUndo;
+					m_puiEncHash[m_pUndo[uiUndo].sHash] = m_pUndo[uiUndo].uiOld;
+				}
+			}
+		}
+		else
+		{
+			memset(m_puiEncHash, 0, COMPRESS_HASH_SIZE * sizeof(UINT));
+			uiData = CRosaCompressEncodeBlock(pMessage, 0, uiSrcSize, pData, uiSrcSize - 1, m_puiEncHash);
+			memcpy(m_puiEncHash, m_puiDictHash, COMPRESS_HASH_SIZE * sizeof(UINT));
+		}
+	}
+
+	BYTE byFlags = ROSA_COMPRESS_FLAG_COMPRESSED;
+
+	if (uiData == 0)
+	{
+		if (uiSrcSize > 0)
+		{
+			memcpy(pData, pMessage, uiSrcSize);
+		}
+
+		uiData = uiSrcSize;
+		byFlags = 0;
+	}
+
+	CRosaCompressMakeHeader(*reinterpret_cast<LPS_COMPRESSHEADER>(&m_vecFrame[0]), byFlags, uiSrcSize, uiData);
+
+	uiFrameSize = sizeof(S_COMPRESSHEADER) + uiData;
+
+	m_sStats.ullEncodeFrames++;
+	m_sStats.ullEncodeCompressed += (byFlags & ROSA_COMPRESS_FLAG_COMPRESSED) ? 1 : 0;
+	m_sStats.ullEncodeRawBytes += uiSrcSize;
+	m_sStats.ullEncodeWireBytes += uiFrameSize;
+
+	return &m_vecFrame[0];
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCompressDecodeFrame()
+// @Purpose: CRosaCompressһ֡(ģʽ֡밴˳)
+// @Since: v1.00a
+// @Para: const S_COMPRESSHEADER& sHeader(֡ͷ)
+// @Para: const char* pData(, δѹʱpDstͬ)
+// @Para: char* pDst()
+// @Para: UINT uiDstSize(峤)
+// @Return: int nRet (ԭʼ, -1:֡ͷݴ, 岻)
+//------------------------------------------------------------------
+int ROSACOMPRESS_CALLMODE CRosaCompress::CRosaCompressDecodeFrame(const S_COMPRESSHEADER & sHeader, const char * pData, char * pDst, UINT uiDstSize)
+{
+	if (!CRosaCompressCheckHeader(sHeader) || (sHeader.byFlags & ROSA_COMPRESS_FLAG_HELLO) || sHeader.dwRawSize > uiDstSize)
+	{
+		return -1;
+	}
+
+	if (sHeader.byFlags & ROSA_COMPRESS_FLAG_COMPRESSED)
+	{
+		if (m_nMode == ROSA_COMPRESS_MODE_NONE)
+		{
+			return -1;
+		}
+
+		// ƥ벻, ֻҪʷһ
+		const BYTE* pDict = m_pDecHistory;
+		UINT uiDict = m_uiDecLength;
+
+		if (uiDict > ROSA_COMPRESS_WINDOW)
+		{
+			pDict += uiDict - ROSA_COMPRESS_WINDOW;
+			uiDict = ROSA_COMPRESS_WINDOW;
+		}
+
+		int nRaw = CRosaCompressDecodeBlock(reinterpret_cast<const BYTE*>(pData), sHeader.dwDataSize, reinterpret_cast<BYTE*>(pDst), sHeader.dwRawSize, pDict, uiDict);
+		if (nRaw != (int)sHeader.dwRawSize)
+		{
+			return -1;
+		}
+	}
+	else if (pData != pDst && sHeader.dwRawSize > 0)
+	{
+		memcpy(pDst, pData, sHeader.dwRawSize);
+	}
+
+	if (m_nMode == ROSA_COMPRESS_MODE_STREAM)
+	{
+		AppendHistory(m_pDecHistory, m_uiDecLength, reinterpret_cast<const BYTE*>(pDst), sHeader.dwRawSize);
+	}
+
+	m_sStats.ullDecodeFrames++;
+	m_sStats.ullDecodeRawBytes += sHeader.dwRawSize;
+	m_sStats.ullDecodeWireBytes += sizeof(S_COMPRESSHEADER) + sHeader.dwDataSize;
+
+	return (int)sHeader.dwRawSize;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCompressGetDecodeBuffer()
+// @Purpose: CRosaCompressȡѹصʱ(߳ʹ)
+// @Since: v1.00a
+// @Para: UINT uiSize(Ҫĳ)
+// @Return: char* pBuffer (´λȡǰЧ)
+//------------------------------------------------------------------
+char * ROSACOMPRESS_CALLMODE CRosaCompress::CRosaCompressGetDecodeBuffer(UINT uiSize)
+{
+	if (m_vecDecode.size() < uiSize || m_vecDecode.empty())
+	{
+		m_vecDecode.resize(uiSize > 0 ? uiSize : 1);
+	}
+
+	return &m_vecDecode[0];
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCompressGetStats()
+// @Purpose: CRosaCompressȡͳ
+// @Since: v1.00a
+// @Para: S_COMPRESSSTATS& sStats(ͳ)
+// @Para: bool bReset(Ƿ)
+// @Return: None
+//------------------------------------------------------------------
+void ROSACOMPRESS_CALLMODE CRosaCompress::CRosaCompressGetStats(S_COMPRESSSTATS & sStats, bool bReset)
+{
+	sStats = m_sStats;
+
+	if (bReset)
+	{
+		memset(&m_sStats, 0, sizeof(m_sStats));
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCompressDictID()
+// @Purpose: CRosaCompressֵID(ʱȽ, ͬʹֵ)
+// @Since: v1.00a
+// @Para: const char* pDict(ֵ)
+// @Para: UINT uiDictSize(ֵ䳤)
+// @Return: DWORD dwDictID (0:ֵ)
+//------------------------------------------------------------------
+DWORD ROSACOMPRESS_CALLMODE CRosaCompress::CRosaCompressDictID(const char * pDict, UINT uiDictSize)
+{
+	if (pDict == NULL || uiDictSize == 0)
+	{
+		return 0;
+	}
+
+	DWORD dwHash = 2166136261U;
+
+	for (UINT i = 0; i < uiDictSize; ++i)
+	{
+		dwHash ^= (BYTE)pDict[i];
+		dwHash *= 16777619U;
+	}
+
+	return (dwHash == 0) ? 1 : dwHash;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCompressBound()
+// @Purpose: CRosaCompressһ֡󳤶
+// @Since: v1.00a
+// @Para: UINT uiSize(Ϣ)
+// @Return: UINT uiBound (֡ͷ)
+//------------------------------------------------------------------
+UINT ROSACOMPRESS_CALLMODE CRosaCompress::CRosaCompressBound(UINT uiSize)
+{
+	return sizeof(S_COMPRESSHEADER) + uiSize + uiSize / 255 + 16;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCompressMakeHeader()
+// @Purpose: CRosaCompressд֡ͷ
+// @Since: v1.00a
+// @Para: S_COMPRESSHEADER& sHeader(֡ͷ)
+// @Para: BYTE byFlags(ROSA_COMPRESS_FLAG_*)
+// @Para: DWORD dwRawSize(ԭʼ, ֡Ϊѹģʽ)
+// @Para: DWORD dwDataSize(س, ֡ΪֵID)
+// @Return: None
+//------------------------------------------------------------------
+void ROSACOMPRESS_CALLMODE CRosaCompress::CRosaCompressMakeHeader(S_COMPRESSHEADER & sHeader, BYTE byFlags, DWORD dwRawSize, DWORD dwDataSize)
+{
+	sHeader.sMagic = ROSA_COMPRESS_MAGIC;
+	sHeader.byFlags = byFlags;
+	sHeader.byCheck = 0;
+	sHeader.dwRawSize = dwRawSize;
+	sHeader.dwDataSize = dwDataSize;
+
+	const BYTE* pHeader = reinterpret_cast<const BYTE*>(&sHeader);
+	BYTE byCheck = 0;
+
+	for (UINT i = 0; i < sizeof(S_COMPRESSHEADER); ++i)
+	{
+		byCheck ^= pHeader[i];
+	}
+
+	sHeader.byCheck = byCheck;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCompressCheckHeader()
+// @Purpose: CRosaCompress֡ͷ(ʶ, У鼰ȷΧ)
+// @Since: v1.00a
+// @Para: const S_COMPRESSHEADER& sHeader(֡ͷ)
+// @Return: bool bRet (true:Ч, false:Ч)
+//------------------------------------------------------------------
+bool ROSACOMPRESS_CALLMODE CRosaCompress::CRosaCompressCheckHeader(const S_COMPRESSHEADER & sHeader)
+{
+	if (sHeader.sMagic != ROSA_COMPRESS_MAGIC)
+	{
+		return false;
+	}
+
+	// УֽΪ0
+	const BYTE* pHeader = reinterpret_cast<const BYTE*>(&sHeader);
+	BYTE byCheck = 0;
+
+	for (UINT i = 0; i < sizeof(S_COMPRESSHEADER); ++i)
+	{
+		byCheck ^= pHeader[i];
+	}
+
+	if (byCheck != 0)
+	{
+		return false;
+	}
+
+	if (sHeader.byFlags & ROSA_COMPRESS_FLAG_HELLO)
+	{
+		return true;
+	}
+
+	if (sHeader.dwRawSize > ROSA_COMPRESS_MAX_MESSAGE)
+	{
+		return false;
+	}
+
+	if (sHeader.byFlags & ROSA_COMPRESS_FLAG_COMPRESSED)
+	{
+		return sHeader.dwDataSize < sHeader.dwRawSize;
+	}
+
+	return sHeader.dwDataSize == sHeader.dwRawSize;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCompressAgree()
+// @Purpose: CRosaCompressԶ֡ȷģʽ(ȡģʽĽС, ֵIDͬʹֵ)
+// @Since: v1.00a
+// @Para: int nMode(ģʽ)
+// @Para: DWORD dwDictID(ֵID)
+// @Para: const S_COMPRESSHEADER& sPeerHello(Զ֡)
+// @Para: bool& bUseDict(Ƿʹֵ)
+// @Return: int nMode (ROSA_COMPRESS_MODE_*)
+//------------------------------------------------------------------
+int ROSACOMPRESS_CALLMODE CRosaCompress::CRosaCompressAgree(int nMode, DWORD dwDictID, const S_COMPRESSHEADER & sPeerHello, bool & bUseDict)
+{
+	bUseDict = false;
+
+	if (!CRosaCompressCheckHeader(sPeerHello) || !(sPeerHello.byFlags & ROSA_COMPRESS_FLAG_HELLO))
+	{
+		return ROSA_COMPRESS_MODE_NONE;
+	}
+
+	// Զģʽ(°汾)ʱ
+	int nAgree = ((int)sPeerHello.dwRawSize < nMode) ? (int)sPeerHello.dwRawSize : nMode;
+	if (nAgree <= ROSA_COMPRESS_MODE_NONE)
+	{
+		return ROSA_COMPRESS_MODE_NONE;
+	}
+
+	bUseDict = (dwDictID != 0 && dwDictID == sPeerHello.dwDataSize);
+
+	return nAgree;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCompressEncodeBlock()
+// @Purpose: CRosaCompressѹΪLZ4ʽ(ϣҵѡ, δʱӴ󲽳)
+// @Since: v1.00a
+// @Para: const BYTE* pBase(ǰ׺ʼ, ϣеλԴΪ׼)
+// @Para: UINT uiPrefix(ǰ׺, ѹݽ)
+// @Para: UINT uiSize(ѹ)
+// @Para: BYTE* pDst()
+// @Para: UINT uiDstSize()
+// @Para: UINT* puiHash(ϣ, 2^ROSA_COMPRESS_HASH_LOG, λ+1)
+// @Para: LPS_COMPRESSUNDO pUndo(ϣ޸ļ¼, NULL:¼)
+// @Para: UINT* puiUndo(޸ļ¼, ROSA_COMPRESS_UNDO_MAXʱΪROSA_COMPRESS_UNDO_MAX+1)
+// @Return: UINT uiRet (ѹ󳤶, 0:)
+//------------------------------------------------------------------
+UINT ROSACOMPRESS_CALLMODE CRosaCompress::CRosaCompressEncodeBlock(const BYTE * pBase, UINT uiPrefix, UINT uiSize, BYTE * pDst, UINT uiDstSize, UINT * puiHash, LPS_COMPRESSUNDO pUndo, UINT * puiUndo)
+{
+	const BYTE* pSrc = pBase + uiPrefix;
+	const BYTE* pEnd = pSrc + uiSize;
+	const BYTE* pAnchor = pSrc;
+	BYTE* pOut = pDst;
+	BYTE* pOutEnd = pDst + uiDstSize;
+
+	if (uiSize > COMPRESS_MF_LIMIT)
+	{
+		const BYTE* pSearchLimit = pEnd - COMPRESS_MF_LIMIT;
+		const BYTE* pMatchLimit = pEnd - COMPRESS_LAST_LITERALS;
+		const BYTE* p = pSrc;
+		UINT uiAttempt = 1 << COMPRESS_SKIP_TRIGGER;
+
+		while (p < pSearchLimit)
+		{
+			UINT uiHash = Hash32(Read32(p));
+			UINT uiCandidate = puiHash[uiHash];
+
+			if (pUndo != NULL)
+			{
+				if (*puiUndo < ROSA_COMPRESS_UNDO_MAX)
+				{
+					pUndo[*puiUndo].sHash = (USHORT)uiHash;
+					pUndo[*puiUndo].uiOld = uiCandidate;
+				}
+				*puiUndo = (*puiUndo <= ROSA_COMPRESS_UNDO_MAX) ? *puiUndo + 1 : *puiUndo;
+			}
+			puiHash[uiHash] = (UINT)(p - pBase) + 1;
+
+			const BYTE* pMatch = (uiCandidate != 0) ? pBase + uiCandidate - 1 : p;
+			if (pMatch >= p || (UINT)(p - pMatch) > ROSA_COMPRESS_MAX_OFFSET || Read32(pMatch) != Read32(p))
+			{
+				p += uiAttempt++ >> COMPRESS_SKIP_TRIGGER;
+				continue;
+			}
+
+			// ǰչƥ
+			while (p > pAnchor && pMatch > pBase && p[-1] == pMatch[-1])
+			{
+				--p;
+				--pMatch;
+			}
+
+			// 
+			UINT uiLiteral = (UINT)(p - pAnchor);
+			if (pOut + 1 + uiLiteral + uiLiteral / 255 + 1 + 2 > pOutEnd)
+			{
+				return 0;
+			}
+
+			BYTE* pToken = pOut++;
+			if (uiLiteral >= 15)
+			{
+				*pToken = 15 << 4;
+				pOut = WriteLength(pOut, uiLiteral - 15);
+			}
+			else
+			{
+				*pToken = (BYTE)(uiLiteral << 4);
+			}
+
+			memcpy(pOut, pAnchor, uiLiteral);
+			pOut += uiLiteral;
+
+			// (С)
+			UINT uiOffset = (UINT)(p - pMatch);
+			*pOut++ = (BYTE)(uiOffset & 0xFF);
+			*pOut++ = (BYTE)(uiOffset >> 8);
+
+			// չƥ(ÿαȽ4ֽ)
+			const BYTE* pStart = p;
+			p += COMPRESS_MIN_MATCH;
+			pMatch += COMPRESS_MIN_MATCH;
+
+			while (p + 4 <= pMatchLimit && Read32(p) == Read32(pMatch))
+			{
+				p += 4;
+				pMatch += 4;
+			}
+
+			while (p < pMatchLimit && *p == *pMatch)
+			{
+				++p;
+				++pMatch;
+			}
+
+			UINT uiMatch = (UINT)(p - pStart) - COMPRESS_MIN_MATCH;
+			if (pOut + 1 + uiMatch / 255 > pOutEnd)
+			{
+				return 0;
+			}
+
+			if (uiMatch >= 15)
+			{
+				*pToken += 15;
+				pOut = WriteLength(pOut, uiMatch - 15);
+			}
+			else
+			{
+				*pToken += (BYTE)uiMatch;
+			}
+
+			pAnchor = p;
+			uiAttempt = 1 << COMPRESS_SKIP_TRIGGER;
+
+			// ƥĩβλ÷ϣ(ظݵһƥ￪ʼ)
+			if (p < pSearchLimit)
+			{
+				UINT uiTail = Hash32(Read32(p - 2));
+
+				if (pUndo != NULL)
+				{
+					if (*puiUndo < ROSA_COMPRESS_UNDO_MAX)
+					{
+						pUndo[*puiUndo].sHash = (USHORT)uiTail;
+						pUndo[*puiUndo].uiOld = puiHash[uiTail];
+					}
+					*puiUndo = (*puiUndo <= ROSA_COMPRESS_UNDO_MAX) ? *puiUndo + 1 : *puiUndo;
+				}
+				puiHash[uiTail] = (UINT)(p - 2 - pBase) + 1;
+			}
+		}
+	}
+
+	// 
+	UINT uiLast = (UINT)(pEnd - pAnchor);
+	if (pOut + 1 + uiLast + uiLast / 255 + 1 > pOutEnd)
+	{
+		return 0;
+	}
+
+	if (uiLast >= 15)
+	{
+		*pOut++ = 15 << 4;
+		pOut = WriteLength(pOut, uiLast - 15);
+	}
+	else
+	{
+		*pOut++ = (BYTE)(uiLast << 4);
+	}
+
+	memcpy(pOut, pAnchor, uiLast);
+	pOut += uiLast;
+
+	return (UINT)(pOut - pDst);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaCompressDecodeBlock()
+// @Purpose: CRosaCompressѹLZ4ʽ(ȫ߽, Դ)
+// @Since: v1.00a
+// @Para: const BYTE* pSrc(ѹ)
+// @Para: UINT uiSrcSize(ѹݳ)
+// @Para: BYTE* pDst()
+// @Para: UINT uiDstSize()
+// @Para: const BYTE* pDict(ֵ, Ϊ֮ǰ)
+// @Para: UINT uiDictSize(ֵ䳤)
+// @Return: int nRet (ѹ󳤶, -1:ݴ)
+//------------------------------------------------------------------
+int ROSACOMPRESS_CALLMODE CRosaCompress::CRosaCompressDecodeBlock(const BYTE * pSrc, UINT uiSrcSize, BYTE * pDst, UINT uiDstSize, const BYTE * pDict, UINT uiDictSize)
+{
+	const BYTE* p = pSrc;
+	const BYTE* pEnd = pSrc + uiSrcSize;
+	BYTE* pOut = pDst;
+	BYTE* pOutEnd = pDst + uiDstSize;
+
+	while (true)
+	{
+		if (p >= pEnd)
+		{
+			return -1;
+		}
+
+		UINT uiToken = *p++;
+
+		// 
+		size_t uiLiteral = uiToken >> 4;
+		if (uiLiteral == 15)
+		{
+			BYTE byLength = 0;
+			do
+			{
+				if (p >= pEnd)
+				{
+					return -1;
+				}
+				byLength = *p++;
+				uiLiteral += byLength;
+			} while (byLength == 255);
+		}
+
+		if (uiLiteral > (size_t)(pEnd - p) || uiLiteral > (size_t)(pOutEnd - pOut))
+		{
+			return -1;
+		}
+
+		memcpy(pOut, p, uiLiteral);
+		pOut += uiLiteral;
+		p += uiLiteral;
+
+		// һֻ
+		if (p == pEnd)
+		{
+			break;
+		}
+
+		if (pEnd - p < 2)
+		{
+			return -1;
+		}
+
+		size_t uiOffset = p[0] | ((size_t)p[1] << 8);
+		p += 2;
+
+		size_t uiMatch = uiToken & 15;
+		if (uiMatch == 15)
+		{
+			BYTE byLength = 0;
+			do
+			{
+				if (p >= pEnd)
+				{
+					return -1;
+				}
+				byLength = *p++;
+				uiMatch += byLength;
+			} while (byLength == 255);
+		}
+		uiMatch += COMPRESS_MIN_MATCH;
+
+		if (uiOffset == 0 || uiMatch > (size_t)(pOutEnd - pOut))
+		{
+			return -1;
+		}
+
+		// 볬ȵĲֵ
+		size_t uiProduced = (size_t)(pOut - pDst);
+		if (uiOffset > uiProduced)
+		{
+			size_t uiBack = uiOffset - uiProduced;
+			if (uiBack > uiDictSize)
+			{
+				return -1;
+			}
+
+			size_t uiCopy = (uiMatch < uiBack) ? uiMatch : uiBack;
+			memcpy(pOut, pDict + uiDictSize - uiBack, uiCopy);
+			pOut += uiCopy;
+			uiMatch -= uiCopy;
+		}
+
+		// СڳʱԴĿص, ֽڸظģʽ
+		const BYTE* pRef = pOut - uiOffset;
+		if (uiOffset >= uiMatch)
+		{
+			memcpy(pOut, pRef, uiMatch);
+			pOut += uiMatch;
+		}
+		else
+		{
+			while (uiMatch-- > 0)
+			{
+				*pOut++ = *pRef++;
+			}
+		}
+	}
+
+	return (int)(pOut - pDst);
+}
+
+//------------------------------------------------------------------
+// @Function:	 LoadDict()
+// @Purpose: CRosaCompressֵĹϣ(ÿλö, ֵֻһ)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaCompress::LoadDict()
+{
+	memset(m_puiDictHash, 0, COMPRESS_HASH_SIZE * sizeof(UINT));
+
+	for (UINT i = 0; i + COMPRESS_MIN_MATCH <= m_uiDictSize; ++i)
+	{
+		m_puiDictHash[Hash32(Read32(m_pEncHistory + i))] = i + 1;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 AppendHistory()
+// @Purpose: CRosaCompress׷ӽʷ(ͬ: ڵϢʷ, ռ䲻ʱһ)
+// @Since: v1.00a
+// @Para: BYTE* pHistory(ʷ)
+// @Para: UINT& uiLength(ʷ)
+// @Para: const BYTE* pData(Ϣ)
+// @Para: UINT uiSize(Ϣ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaCompress::AppendHistory(BYTE * pHistory, UINT & uiLength, const BYTE * pData, UINT uiSize)
+{
+	if (uiSize > ROSA_COMPRESS_WINDOW)
+	{
+		uiLength = 0;
+		return;
+	}
+
+	if (uiLength + uiSize > COMPRESS_HISTORY_SIZE)
+	{
+		UINT uiKeep = (uiLength < ROSA_COMPRESS_WINDOW) ? uiLength : ROSA_COMPRESS_WINDOW;
+		memmove(pHistory, pHistory + uiLength - uiKeep, uiKeep);
+		uiLength = uiKeep;
+	}
+
+	memcpy(pHistory + uiLength, pData, uiSize);
+	uiLength += uiSize;
+}
+
+//------------------------------------------------------------------
+// @Function:	 SlideEncoder()
+// @Purpose: CRosaCompressʷŲһϢʱһ(ϣеλͬƽ)
+// @Since: v1.00a
+// @Para: UINT uiSize(һϢ, )
+// @Return: None
+//------------------------------------------------------------------
+void CRosaCompress::SlideEncoder(UINT uiSize)
+{
+	if (m_uiEncLength + uiSize <= COMPRESS_HISTORY_SIZE)
+	{
+		return;
+	}
+
+	UINT uiKeep = (m_uiEncLength < ROSA_COMPRESS_WINDOW) ? m_uiEncLength : ROSA_COMPRESS_WINDOW;
+	UINT uiShift = m_uiEncLength - uiKeep;
+
+	memmove(m_pEncHistory, m_pEncHistory + uiShift, uiKeep);
+	m_uiEncLength = uiKeep;
+
+	for (UINT i = 0; i < COMPRESS_HASH_SIZE; ++i)
+	{
+		m_puiEncHash[i] = (m_puiEncHash[i] > uiShift) ? m_puiEncHash[i] - uiShift : 0;
+	}
+}
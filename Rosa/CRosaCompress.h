@@ -0,0 +1,133 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaCompress.h
+* @brief	This File is RosaCompress Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSACOMPRESS_H__
+#define __CROSACOMPRESS_H__
+
+//Include Windows Header File
+#include <Windows.h>
+
+//Include C/C++ Header File
+#include <vector>
+
+using namespace std;
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSACOMPRESS_API	__declspec(dllexport)
+#else
+#define ROSACOMPRESS_API	__declspec(dllimport)
+#endif
+
+#define ROSACOMPRESS_CALLMODE	__stdcall
+
+#define ROSA_COMPRESS_MODE_NONE			0				//ѹ(ֻ֡)
+#define ROSA_COMPRESS_MODE_BLOCK		1				//ÿϢѹ(ʹԤֵ, ڿܶ֡·)
+#define ROSA_COMPRESS_MODE_STREAM		2				//֮ǰϢΪֵѹ(ɿ·)
+
+#define ROSA_COMPRESS_FLAG_COMPRESSED	0x01			//֡־:ѹ(LZ4ʽ)
+#define ROSA_COMPRESS_FLAG_HELLO		0x02			//֡־:֡(ԭʼ:ѹģʽ, س:ֵID, ޸)
+#define ROSA_COMPRESS_FLAG_ACK			0x04			//֡־:֡յԶ˵
+
+#define ROSA_COMPRESS_MAGIC				0x5A52			//֡ͷʶ("RZ")
+#define ROSA_COMPRESS_WINDOW			65536			//ʷ(ֽ, Ҳֵ󳤶)
+#define ROSA_COMPRESS_MAX_OFFSET		65535			//ƥ
+#define ROSA_COMPRESS_HASH_LOG			12				//ƥϣλ
+#define ROSA_COMPRESS_MIN_SIZE			16				//СڸóȵϢѹ
+#define ROSA_COMPRESS_MAX_MESSAGE		64*1024*1024	//Ϣ󳤶(շݴ˾ܾ쳣֡ͷ)
+#define ROSA_COMPRESS_UNDO_MAX			1024			//ģʽ¼Ĺϣ޸Ĵ(ʱָ)
+
+//Struct Definition
+typedef struct
+{
+	USHORT sMagic;							// ֡ͷʶ(ROSA_COMPRESS_MAGIC)
+	BYTE byFlags;							// ֡־(ROSA_COMPRESS_FLAG_*)
+	BYTE byCheck;							// ֡ͷУ(ֽ, ھݴͬ)
+	DWORD dwRawSize;						// ԭʼ
+	DWORD dwDataSize;						// س(֡ͷ֮)
+}S_COMPRESSHEADER, *LPS_COMPRESSHEADER;
+
+typedef struct
+{
+	USHORT sHash;							// ϣλ
+	UINT uiOld;								// ޸ǰֵ
+}S_COMPRESSUNDO, *LPS_COMPRESSUNDO;
+
+typedef struct
+{
+	ULONGLONG ullEncodeFrames;				// ֡
+	ULONGLONG ullEncodeCompressed;			// ѹ֡
+	ULONGLONG ullEncodeRawBytes;			// ǰֽ
+	ULONGLONG ullEncodeWireBytes;			// ֽ(֡ͷ)
+	ULONGLONG ullDecodeFrames;				// ֡
+	ULONGLONG ullDecodeRawBytes;			// ֽ
+	ULONGLONG ullDecodeWireBytes;			// ǰֽ(֡ͷ)
+}S_COMPRESSSTATS, *LPS_COMPRESSSTATS;
+
+//Class Definition
+class ROSACOMPRESS_API CRosaCompress
+{
+public:
+	CRosaCompress();			// CRosaCompress 캯
+	~CRosaCompress();			// CRosaCompress 
+
+public:
+	bool ROSACOMPRESS_CALLMODE CRosaCompressCreate(int nMode, const char* pDict = NULL, UINT uiDictSize = 0);		// CRosaCompress ״̬(ֵ䳬ʱʹĩβ)
+	void ROSACOMPRESS_CALLMODE CRosaCompressDestroy();																// CRosaCompress ͷű״̬
+	void ROSACOMPRESS_CALLMODE CRosaCompressReset();																// CRosaCompress صʼ״̬(Ӻͬʱ)
+
+	int ROSACOMPRESS_CALLMODE CRosaCompressGetMode() const;															// CRosaCompress ȡѹģʽ
+	DWORD ROSACOMPRESS_CALLMODE CRosaCompressGetDictID() const;														// CRosaCompress ȡֵID(0:ֵ)
+
+	const char* ROSACOMPRESS_CALLMODE CRosaCompressEncodeFrame(const char* pSrc, UINT uiSrcSize, UINT& uiFrameSize, bool bCompress = true);	// CRosaCompress һ֡(ڲ, ´αǰЧ)
+	int ROSACOMPRESS_CALLMODE CRosaCompressDecodeFrame(const S_COMPRESSHEADER& sHeader, const char* pData, char* pDst, UINT uiDstSize);		// CRosaCompress һ֡(ԭʼ, -1:)
+	char* ROSACOMPRESS_CALLMODE CRosaCompressGetDecodeBuffer(UINT uiSize);											// CRosaCompress ȡոصʱ
+
+	void ROSACOMPRESS_CALLMODE CRosaCompressGetStats(S_COMPRESSSTATS& sStats, bool bReset = false);				// CRosaCompress ȡͳ
+
+	static DWORD ROSACOMPRESS_CALLMODE CRosaCompressDictID(const char* pDict, UINT uiDictSize);						// CRosaCompress ֵID(FNV-1a)
+	static UINT ROSACOMPRESS_CALLMODE CRosaCompressBound(UINT uiSize);												// CRosaCompress һ֡󳤶(֡ͷ)
+	static void ROSACOMPRESS_CALLMODE CRosaCompressMakeHeader(S_COMPRESSHEADER& sHeader, BYTE byFlags, DWORD dwRawSize, DWORD dwDataSize);	// CRosaCompress д֡ͷ
+	static bool ROSACOMPRESS_CALLMODE CRosaCompressCheckHeader(const S_COMPRESSHEADER& sHeader);					// CRosaCompress ֡ͷ
+	static int ROSACOMPRESS_CALLMODE CRosaCompressAgree(int nMode, DWORD dwDictID, const S_COMPRESSHEADER& sPeerHello, bool& bUseDict);	// CRosaCompress Զ֡ȷģʽ(˽ͬ)
+
+	static UINT ROSACOMPRESS_CALLMODE CRosaCompressEncodeBlock(const BYTE* pBase, UINT uiPrefix, UINT uiSize, BYTE* pDst, UINT uiDstSize, UINT* puiHash, LPS_COMPRESSUNDO pUndo = NULL, UINT* puiUndo = NULL);	// CRosaCompress ѹpBase+uiPrefix(ƥǰ׺, 0:uiDstSize)
+	static int ROSACOMPRESS_CALLMODE CRosaCompressDecodeBlock(const BYTE* pSrc, UINT uiSrcSize, BYTE* pDst, UINT uiDstSize, const BYTE* pDict = NULL, UINT uiDictSize = 0);	// CRosaCompress ѹ(pDictΪ֮ǰ, -1:ݴ)
+
+private:
+	void LoadDict();																// CRosaCompress ֵʷϣ
+	void AppendHistory(BYTE* pHistory, UINT& uiLength, const BYTE* pData, UINT uiSize);	// CRosaCompress ׷ӽʷ(ģʽ, ˵Ĵڻͬ)
+	void SlideEncoder(UINT uiSize);													// CRosaCompress ʷʱһ(ģʽ)
+
+private:
+	int m_nMode;								// CRosaCompress ѹģʽ
+	DWORD m_dwDictID;							// CRosaCompress ֵID
+	UINT m_uiDictSize;							// CRosaCompress ֵ䳤
+
+	BYTE* m_pEncHistory;						// CRosaCompress ʷ(: ֵ֮ǰϢ, ֮ǵǰϢ)
+	UINT m_uiEncLength;							// CRosaCompress ʷ
+	UINT* m_puiEncHash;							// CRosaCompress ϣ(λ+1, 0Ϊ)
+	UINT* m_puiDictHash;						// CRosaCompress ֵĹϣ(ģʽÿϢָ)
+	LPS_COMPRESSUNDO m_pUndo;					// CRosaCompress ģʽϣ޸ļ¼
+
+	BYTE* m_pDecHistory;						// CRosaCompress ʷ(ֵ֮ǰϢ)
+	UINT m_uiDecLength;							// CRosaCompress ʷ
+
+	vector<char> m_vecFrame;					// CRosaCompress 
+	vector<char> m_vecDecode;					// CRosaCompress ոʱ
+
+	S_COMPRESSSTATS m_sStats;					// CRosaCompress ͳ
+
+};
+
+#endif // !__CROSACOMPRESS_H__
@@ -0,0 +1,780 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaConnector.cpp
+* @brief	This File is RosaConnector Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaConnector.h"
+#include "CThreadSafe.h"
+
+#include <Ws2tcpip.h>
+
+#pragma warning(disable:4996)
+
+//CRosaConnector 첽(ConnectEx + ַ)
+
+//------------------------------------------------------------------
+// @Function:	 CRosaConnector()
+// @Purpose: CRosaConnector캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaConnector::CRosaConnector()
+{
+	m_pLoop = NULL;
+	m_ullScanTimerID = 0;
+	m_ullNextConnectID = 1;
+
+	m_pfnConnectEx4 = NULL;
+	m_pfnConnectEx6 = NULL;
+
+	m_pResolver = NULL;
+	m_nResolving = 0;
+
+	InitializeCriticalSection(&m_csConnect);
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaConnector()
+// @Purpose: CRosaConnector
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaConnector::~CRosaConnector()
+{
+	CRosaConnectorDestroy();
+
+	DeleteCriticalSection(&m_csConnect);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaConnectorCreate()
+// @Purpose: CRosaConnector¼ѭʱ
+// @Since: v1.00a
+// @Para: CRosaEventLoop* pLoop(Ѿ¼ѭ)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSACONNECTOR_CALLMODE CRosaConnector::CRosaConnectorCreate(CRosaEventLoop * pLoop)
+{
+	if (m_pLoop != NULL || pLoop == NULL || !pLoop->CRosaEventLoopIsRunning())
+	{
+		return false;
+	}
+
+	m_pLoop = pLoop;
+	m_ullScanTimerID = m_pLoop->CRosaEventLoopSetTimer(ROSA_CONNECT_SCAN_MSEC, ROSA_CONNECT_SCAN_MSEC, OnScanTimer, this);
+
+	return (m_ullScanTimerID != 0);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaConnectorDestroy()
+// @Purpose: CRosaConnectorȡȫӲ(ٻص)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSACONNECTOR_CALLMODE CRosaConnector::CRosaConnectorDestroy()
+{
+	if (m_pLoop == NULL)
+	{
+		return;
+	}
+
+	m_pLoop->CRosaEventLoopKillTimer(m_ullScanTimerID);
+	m_ullScanTimerID = 0;
+
+	// ȡȫԣɰͷ
+	EnterCriticalSection(&m_csConnect);
+
+	for (map<ULONGLONG, LPS_CONNECTREQUEST>::iterator iter = m_mapRequest.begin(); iter != m_mapRequest.end(); ++iter)
+	{
+		LPS_CONNECTREQUEST pRequest = iter->second;
+
+		pRequest->bDone = true;
+		pRequest->pCallback = NULL;
+
+		for (vector<LPS_CONNECTATTEMPT>::iterator it = pRequest->vecAttempt.begin(); it != pRequest->vecAttempt.end(); ++it)
+		{
+			(*it)->bCanceled = true;
+			CancelIoEx((HANDLE)(*it)->Socket, &(*it)->Overlapped.Overlapped);
+		}
+	}
+
+	LeaveCriticalSection(&m_csConnect);
+
+	// ȴ¼ѭȡɰ
+	while (m_pLoop->CRosaEventLoopIsRunning())
+	{
+		EnterCriticalSection(&m_csConnect);
+		bool bEmpty = m_mapRequest.empty();
+		LeaveCriticalSection(&m_csConnect);
+
+		if (bEmpty)
+		{
+			break;
+		}
+
+		Sleep(1);
+	}
+
+	// ȴص(ӦResolveDoneͷ)
+	while (m_nResolving > 0)
+	{
+		Sleep(1);
+	}
+
+	// ¼ѭѾֹͣɰ
+	EnterCriticalSection(&m_csConnect);
+
+	for (map<ULONGLONG, LPS_CONNECTREQUEST>::iterator iter = m_mapRequest.begin(); iter != m_mapRequest.end(); ++iter)
+	{
+		for (vector<LPS_CONNECTATTEMPT>::iterator it = iter->second->vecAttempt.begin(); it != iter->second->vecAttempt.end(); ++it)
+		{
+			closesocket((*it)->Socket);
+			delete (*it);
+		}
+
+		delete iter->second;
+	}
+
+	m_mapRequest.clear();
+
+	LeaveCriticalSection(&m_csConnect);
+
+	m_pLoop = NULL;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaConnectorSetResolver()
+// @Purpose: CRosaConnectorû(ʧܵĻصڽִ߳)
+// @Since: v1.00a
+// @Para: CRosaResolver* pResolver(Ѿ̵߳Ľ, NULLʾʹĬϽ)
+// @Return: None
+//------------------------------------------------------------------
+void ROSACONNECTOR_CALLMODE CRosaConnector::CRosaConnectorSetResolver(CRosaResolver * pResolver)
+{
+	m_pResolver = pResolver;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaConnectorConnect()
+// @Purpose: CRosaConnector첽(ȫַ)
+// @Since: v1.00a
+// @Para: const char* pcHost(IPַ)
+// @Para: USHORT sPort(˿ں)
+// @Para: HANDLE_CONNECT_CALLBACK pCallback(ɻص, ѭִ߳)
+// @Para: DWORD_PTR dwUser(û)
+// @Para: DWORD dwAttemptTimeOut(ַӳʱ)
+// @Para: DWORD dwRaceDelay(һַӳ)
+// @Return: ULONGLONG ullConnectID (0:򴴽ʧ, ص)
+//------------------------------------------------------------------
+ULONGLONG ROSACONNECTOR_CALLMODE CRosaConnector::CRosaConnectorConnect(const char * pcHost, USHORT sPort, HANDLE_CONNECT_CALLBACK pCallback, DWORD_PTR dwUser, DWORD dwAttemptTimeOut, DWORD dwRaceDelay)
+{
+	vector<SOCKADDR_STORAGE> vecAddress;
+
+	// δýʱʹĬϽ(̨ͬ)
+	CRosaResolver* pResolver = (m_pResolver != NULL) ? m_pResolver : &CRosaResolver::CRosaResolverGetDefault();
+
+	// ûн߳(ʧ)ʱͬ
+	if (pResolver->CRosaResolverGetThreadCount() == 0)
+	{
+		if (pResolver->CRosaResolverResolve(pcHost, vecAddress) != SOB_RET_OK)
+		{
+			return 0;
+		}
+
+		CRosaResolver::CRosaResolverSetPort(vecAddress, sPort);
+
+		return CRosaConnectorConnectAddr(&vecAddress[0], (int)vecAddress.size(), pCallback, dwUser, dwAttemptTimeOut, dwRaceDelay);
+	}
+
+	if (m_pLoop == NULL || pCallback == NULL)
+	{
+		return 0;
+	}
+
+	// ȵǼ󣬽ɺٿʼ
+	LPS_CONNECTREQUEST pRequest = new S_CONNECTREQUEST;
+
+	pRequest->nNextAddress = 0;
+	pRequest->ullNextStart = 0;
+	pRequest->dwAttemptTimeOut = dwAttemptTimeOut;
+	pRequest->dwRaceDelay = dwRaceDelay;
+	pRequest->bDone = false;
+	pRequest->bTimeOut = false;
+	pRequest->bResolving = true;
+	pRequest->pCallback = pCallback;
+	pRequest->dwUser = dwUser;
+
+	EnterCriticalSection(&m_csConnect);
+
+	ULONGLONG ullConnectID = m_ullNextConnectID++;
+	pRequest->ullConnectID = ullConnectID;
+	m_mapRequest.insert(pair<ULONGLONG, LPS_CONNECTREQUEST>(ullConnectID, pRequest));
+
+	LeaveCriticalSection(&m_csConnect);
+
+	LPS_CONNECTRESOLVE pResolve = new S_CONNECTRESOLVE;
+	pResolve->pConnector = this;
+	pResolve->ullConnectID = ullConnectID;
+	pResolve->sPort = sPort;
+
+	InterlockedIncrement(&m_nResolving);
+
+	if (pResolver->CRosaResolverLookup(pcHost, vecAddress, OnResolved, (DWORD_PTR)pResolve) == ROSA_RESOLVE_PENDING)
+	{
+		return ullConnectID;
+	}
+
+	// лʧѻ
+	delete pResolve;
+	InterlockedDecrement(&m_nResolving);
+
+	if (!ResolveDone(ullConnectID, sPort, vecAddress.empty() ? NULL : &vecAddress[0], (int)vecAddress.size(), false))
+	{
+		return 0;
+	}
+
+	return ullConnectID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaConnectorConnectAddr()
+// @Purpose: CRosaConnector첽(ѽַ, ַ彻澺)
+// @Since: v1.00a
+// @Para: const SOCKADDR_STORAGE* pAddress(ַ, ˿д)
+// @Para: int nCount(ַ)
+// @Para: HANDLE_CONNECT_CALLBACK pCallback(ɻص, ѭִ߳)
+// @Para: DWORD_PTR dwUser(û)
+// @Para: DWORD dwAttemptTimeOut(ַӳʱ)
+// @Para: DWORD dwRaceDelay(һַӳ)
+// @Return: ULONGLONG ullConnectID (0:ʧ, ص)
+//------------------------------------------------------------------
+ULONGLONG ROSACONNECTOR_CALLMODE CRosaConnector::CRosaConnectorConnectAddr(const SOCKADDR_STORAGE * pAddress, int nCount, HANDLE_CONNECT_CALLBACK pCallback, DWORD_PTR dwUser, DWORD dwAttemptTimeOut, DWORD dwRaceDelay)
+{
+	if (m_pLoop == NULL || pAddress == NULL || nCount <= 0 || pCallback == NULL)
+	{
+		return 0;
+	}
+
+	LPS_CONNECTREQUEST pRequest = new S_CONNECTREQUEST;
+
+	pRequest->vecAddress.assign(pAddress, pAddress + nCount);
+	pRequest->nNextAddress = 0;
+	pRequest->ullNextStart = 0;
+	pRequest->dwAttemptTimeOut = dwAttemptTimeOut;
+	pRequest->dwRaceDelay = dwRaceDelay;
+	pRequest->bDone = false;
+	pRequest->bTimeOut = false;
+	pRequest->bResolving = false;
+	pRequest->pCallback = pCallback;
+	pRequest->dwUser = dwUser;
+
+	SortAddressForRace(pRequest->vecAddress);
+
+	ULONGLONG ullNow = CRosaEventLoop::CRosaEventLoopGetTickMSec();
+
+	CThreadSafe ThreadSafe(&m_csConnect);
+
+	pRequest->ullConnectID = m_ullNextConnectID++;
+
+	// һַʼַɳʱ鰴ӳٿʼ
+	bool bStarted = false;
+	while (!bStarted && pRequest->nNextAddress < pRequest->vecAddress.size())
+	{
+		bStarted = StartAttempt(pRequest, ullNow);
+	}
+
+	if (!bStarted)
+	{
+		delete pRequest;
+		return 0;
+	}
+
+	m_mapRequest.insert(pair<ULONGLONG, LPS_CONNECTREQUEST>(pRequest->ullConnectID, pRequest));
+
+	return pRequest->ullConnectID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaConnectorCancel()
+// @Purpose: CRosaConnectorȡ(صSOB_RET_FAIL)
+// @Since: v1.00a
+// @Para: ULONGLONG ullConnectID(ID)
+// @Return: bool bRet (true:ȡ, false:ڻѾ)
+//------------------------------------------------------------------
+bool ROSACONNECTOR_CALLMODE CRosaConnector::CRosaConnectorCancel(ULONGLONG ullConnectID)
+{
+	HANDLE_CONNECT_CALLBACK pCallback = NULL;
+	DWORD_PTR dwUser = 0;
+
+	EnterCriticalSection(&m_csConnect);
+
+	map<ULONGLONG, LPS_CONNECTREQUEST>::iterator iter = m_mapRequest.find(ullConnectID);
+	if (iter == m_mapRequest.end() || iter->second->bDone)
+	{
+		LeaveCriticalSection(&m_csConnect);
+		return false;
+	}
+
+	LPS_CONNECTREQUEST pRequest = iter->second;
+
+	pRequest->bDone = true;
+	pCallback = pRequest->pCallback;
+	dwUser = pRequest->dwUser;
+
+	// еĳɰͷ
+	for (vector<LPS_CONNECTATTEMPT>::iterator it = pRequest->vecAttempt.begin(); it != pRequest->vecAttempt.end(); ++it)
+	{
+		(*it)->bCanceled = true;
+		CancelIoEx((HANDLE)(*it)->Socket, &(*it)->Overlapped.Overlapped);
+	}
+
+	LeaveCriticalSection(&m_csConnect);
+
+	pCallback(ullConnectID, INVALID_SOCKET, SOB_RET_FAIL, dwUser);
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaConnectorGetPendingCount()
+// @Purpose: CRosaConnectorȡе
+// @Since: v1.00a
+// @Para: None
+// @Return: int nCount
+//------------------------------------------------------------------
+int ROSACONNECTOR_CALLMODE CRosaConnector::CRosaConnectorGetPendingCount()
+{
+	CThreadSafe ThreadSafe(&m_csConnect);
+	return (int)m_mapRequest.size();
+}
+
+//------------------------------------------------------------------
+// @Function:	 SortAddressForRace()
+// @Purpose: CRosaConnectorѡַַ彻(Եһַĵַ忪ʼ)
+// @Since: v1.00a
+// @Para: vector<SOCKADDR_STORAGE>& vecAddress(ѡַ)
+// @Return: int nCount(ַ)
+//------------------------------------------------------------------
+int ROSACONNECTOR_CALLMODE CRosaConnector::SortAddressForRace(vector<SOCKADDR_STORAGE>& vecAddress)
+{
+	if (vecAddress.size() < 2)
+	{
+		return (int)vecAddress.size();
+	}
+
+	ADDRESS_FAMILY nFirstFamily = vecAddress[0].ss_family;
+	vector<SOCKADDR_STORAGE> vecFirst;
+	vector<SOCKADDR_STORAGE> vecSecond;
+
+	for (vector<SOCKADDR_STORAGE>::iterator iter = vecAddress.begin(); iter != vecAddress.end(); ++iter)
+	{
+		if (iter->ss_family == nFirstFamily)
+		{
+			vecFirst.push_back(*iter);
+		}
+		else
+		{
+			vecSecond.push_back(*iter);
+		}
+	}
+
+	vecAddress.clear();
+
+	for (size_t i = 0; i < vecFirst.size() || i < vecSecond.size(); ++i)
+	{
+		if (i < vecFirst.size())
+		{
+			vecAddress.push_back(vecFirst[i]);
+		}
+
+		if (i < vecSecond.size())
+		{
+			vecAddress.push_back(vecSecond[i]);
+		}
+	}
+
+	return (int)vecAddress.size();
+}
+
+//------------------------------------------------------------------
+// @Function:	 StartAttempt()
+// @Purpose: CRosaConnectorʼһѡַ(߳m_csConnect)
+// @Since: v1.00a
+// @Para: LPS_CONNECTREQUEST pRequest()
+// @Para: ULONGLONG ullNow(ǰʱ)
+// @Return: bool bRet (true:ͶConnectEx, false:õַʧ)
+//------------------------------------------------------------------
+bool CRosaConnector::StartAttempt(LPS_CONNECTREQUEST pRequest, ULONGLONG ullNow)
+{
+	const SOCKADDR_STORAGE& addrRemote = pRequest->vecAddress[pRequest->nNextAddress++];
+	int nFamily = addrRemote.ss_family;
+	int nAddrLen = (nFamily == AF_INET6) ? sizeof(SOCKADDR_IN6) : sizeof(SOCKADDR_IN);
+
+	// һַʱ
+	pRequest->ullNextStart = ullNow + pRequest->dwRaceDelay;
+
+	SOCKET s = WSASocket(nFamily, SOCK_STREAM, IPPROTO_TCP, NULL, 0, WSA_FLAG_OVERLAPPED);
+	if (s == INVALID_SOCKET)
+	{
+		return false;
+	}
+
+	// ConnectExҪ׽Ѿ
+	SOCKADDR_STORAGE addrLocal;
+	memset(&addrLocal, 0, sizeof(addrLocal));
+	addrLocal.ss_family = (ADDRESS_FAMILY)nFamily;
+
+	if (bind(s, (PSOCKADDR)&addrLocal, nAddrLen) == SOCKET_ERROR || !m_pLoop->CRosaEventLoopAttach((HANDLE)s))
+	{
+		closesocket(s);
+		return false;
+	}
+
+	LPFN_CONNECTEX pfnConnectEx = GetConnectEx(s, nFamily);
+	if (pfnConnectEx == NULL)
+	{
+		closesocket(s);
+		return false;
+	}
+
+	// CreateTCPSocketһ
+	const char chOpt = 1;
+	setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &chOpt, sizeof(char));
+
+	LPS_CONNECTATTEMPT pAttempt = new S_CONNECTATTEMPT;
+	memset(&pAttempt->Overlapped, 0, sizeof(pAttempt->Overlapped));
+	pAttempt->Overlapped.pCallback = OnConnectComplete;
+	pAttempt->Overlapped.pUser = this;
+	pAttempt->Socket = s;
+	pAttempt->ullDeadline = ullNow + pRequest->dwAttemptTimeOut;
+	pAttempt->bCanceled = false;
+	pAttempt->pRequest = pRequest;
+
+	pRequest->vecAttempt.push_back(pAttempt);
+
+	DWORD dwBytes = 0;
+	if (!pfnConnectEx(s, (PSOCKADDR)&addrRemote, nAddrLen, NULL, 0, &dwBytes, &pAttempt->Overlapped.Overlapped))
+	{
+		if (WSAGetLastError() != ERROR_IO_PENDING)
+		{
+			// ͬʧܲɰ
+			pRequest->vecAttempt.pop_back();
+			closesocket(s);
+			delete pAttempt;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 FinishAttempt()
+// @Purpose: CRosaConnectorӳԽ(һɹʤ, ȡ)
+// @Since: v1.00a
+// @Para: LPS_CONNECTATTEMPT pAttempt(ӳ)
+// @Para: DWORD dwError()
+// @Return: None
+//------------------------------------------------------------------
+void CRosaConnector::FinishAttempt(LPS_CONNECTATTEMPT pAttempt, DWORD dwError)
+{
+	HANDLE_CONNECT_CALLBACK pCallback = NULL;
+	SOCKET sConnected = INVALID_SOCKET;
+	int nResult = SOB_RET_FAIL;
+	DWORD_PTR dwUser = 0;
+	ULONGLONG ullConnectID = 0;
+	bool bFree = false;
+
+	EnterCriticalSection(&m_csConnect);
+
+	LPS_CONNECTREQUEST pRequest = pAttempt->pRequest;
+
+	for (vector<LPS_CONNECTATTEMPT>::iterator iter = pRequest->vecAttempt.begin(); iter != pRequest->vecAttempt.end(); ++iter)
+	{
+		if (*iter == pAttempt)
+		{
+			pRequest->vecAttempt.erase(iter);
+			break;
+		}
+	}
+
+	if (dwError == 0 && !pRequest->bDone)
+	{
+		// ӳɹ׽ʹgetpeername/shutdown
+		setsockopt(pAttempt->Socket, SOL_SOCKET, SO_UPDATE_CONNECT_CONTEXT, NULL, 0);
+
+		pRequest->bDone = true;
+		sConnected = pAttempt->Socket;
+		nResult = SOB_RET_OK;
+		pCallback = pRequest->pCallback;
+
+		// ȡڽеĳ
+		for (vector<LPS_CONNECTATTEMPT>::iterator iter = pRequest->vecAttempt.begin(); iter != pRequest->vecAttempt.end(); ++iter)
+		{
+			(*iter)->bCanceled = true;
+			CancelIoEx((HANDLE)(*iter)->Socket, &(*iter)->Overlapped.Overlapped);
+		}
+	}
+	else
+	{
+		closesocket(pAttempt->Socket);
+
+		if (!pRequest->bDone)
+		{
+			// ʧܵĵַλһַ
+			bool bStarted = false;
+			ULONGLONG ullNow = CRosaEventLoop::CRosaEventLoopGetTickMSec();
+
+			while (!bStarted && pRequest->nNextAddress < pRequest->vecAddress.size())
+			{
+				bStarted = StartAttempt(pRequest, ullNow);
+			}
+
+			// ȫַʧ
+			if (pRequest->vecAttempt.empty())
+			{
+				pRequest->bDone = true;
+				nResult = pRequest->bTimeOut ? SOB_RET_TIMEOUT : SOB_RET_FAIL;
+				pCallback = pRequest->pCallback;
+			}
+		}
+	}
+
+	dwUser = pRequest->dwUser;
+	ullConnectID = pRequest->ullConnectID;
+
+	// ȫԽͷ
+	if (pRequest->bDone && pRequest->vecAttempt.empty())
+	{
+		m_mapRequest.erase(ullConnectID);
+		bFree = true;
+	}
+
+	LeaveCriticalSection(&m_csConnect);
+
+	delete pAttempt;
+
+	if (bFree)
+	{
+		delete pRequest;
+	}
+
+	if (pCallback)
+	{
+		pCallback(ullConnectID, sConnected, nResult, dwUser);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 GetConnectEx()
+// @Purpose: CRosaConnectorȡConnectExչ(ַ建, ߳m_csConnect)
+// @Since: v1.00a
+// @Para: SOCKET s(ַͬ׽)
+// @Para: int nFamily(ַ)
+// @Return: LPFN_CONNECTEX pfnConnectEx
+//------------------------------------------------------------------
+LPFN_CONNECTEX CRosaConnector::GetConnectEx(SOCKET s, int nFamily)
+{
+	LPFN_CONNECTEX& pfnConnectEx = (nFamily == AF_INET6) ? m_pfnConnectEx6 : m_pfnConnectEx4;
+
+	if (pfnConnectEx == NULL)
+	{
+		GUID guidConnectEx = WSAID_CONNECTEX;
+		DWORD dwBytes = 0;
+
+		if (WSAIoctl(s, SIO_GET_EXTENSION_FUNCTION_POINTER, &guidConnectEx, sizeof(guidConnectEx), &pfnConnectEx, sizeof(pfnConnectEx), &dwBytes, NULL, NULL) == SOCKET_ERROR)
+		{
+			pfnConnectEx = NULL;
+		}
+	}
+
+	return pfnConnectEx;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ResolveDone()
+// @Purpose: CRosaConnectorɺʼ(ȡ޷ʼʱͷ)
+// @Since: v1.00a
+// @Para: ULONGLONG ullConnectID(ID)
+// @Para: USHORT sPort(Զ˶˿ں)
+// @Para: const SOCKADDR_STORAGE* pAddress(, ʧʱΪNULL)
+// @Para: int nCount(ַ)
+// @Para: bool bCallback(ʧʱǷص)
+// @Return: bool bRet (true:ѿʼ, false:ͷ)
+//------------------------------------------------------------------
+bool CRosaConnector::ResolveDone(ULONGLONG ullConnectID, USHORT sPort, const SOCKADDR_STORAGE * pAddress, int nCount, bool bCallback)
+{
+	EnterCriticalSection(&m_csConnect);
+
+	map<ULONGLONG, LPS_CONNECTREQUEST>::iterator iter = m_mapRequest.find(ullConnectID);
+	if (iter == m_mapRequest.end())
+	{
+		LeaveCriticalSection(&m_csConnect);
+		return false;
+	}
+
+	LPS_CONNECTREQUEST pRequest = iter->second;
+	pRequest->bResolving = false;
+
+	if (!pRequest->bDone && pAddress != NULL && nCount > 0)
+	{
+		pRequest->vecAddress.assign(pAddress, pAddress + nCount);
+		CRosaResolver::CRosaResolverSetPort(pRequest->vecAddress, sPort);
+		SortAddressForRace(pRequest->vecAddress);
+
+		ULONGLONG ullNow = CRosaEventLoop::CRosaEventLoopGetTickMSec();
+		bool bStarted = false;
+
+		while (!bStarted && pRequest->nNextAddress < pRequest->vecAddress.size())
+		{
+			bStarted = StartAttempt(pRequest, ullNow);
+		}
+
+		if (bStarted)
+		{
+			LeaveCriticalSection(&m_csConnect);
+			return true;
+		}
+	}
+
+	// ʧܡȫַʧܻѾȡ
+	bool bNotify = (!pRequest->bDone && bCallback);
+	HANDLE_CONNECT_CALLBACK pCallback = pRequest->pCallback;
+	DWORD_PTR dwUser = pRequest->dwUser;
+
+	pRequest->bDone = true;
+	m_mapRequest.erase(iter);
+
+	LeaveCriticalSection(&m_csConnect);
+
+	delete pRequest;
+
+	if (bNotify && pCallback)
+	{
+		pCallback(ullConnectID, INVALID_SOCKET, SOB_RET_FAIL, dwUser);
+	}
+
+	return false;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnConnectComplete()
+// @Purpose: CRosaConnectorɻص(¼ѭ߳)
+// @Since: v1.00a
+// @Para: LPS_ROSAOVERLAPPED pOverlapped(ӳ)
+// @Para: DWORD dwBytes(δʹ)
+// @Para: DWORD dwError()
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaConnector::OnConnectComplete(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError)
+{
+	CRosaConnector* pConnector = reinterpret_cast<CRosaConnector*>(pOverlapped->pUser);
+	LPS_CONNECTATTEMPT pAttempt = reinterpret_cast<LPS_CONNECTATTEMPT>(pOverlapped);
+
+	pConnector->FinishAttempt(pAttempt, dwError);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnScanTimer()
+// @Purpose: CRosaConnectorʱ(ȡʱ, ӳٿʼһַ)
+// @Since: v1.00a
+// @Para: ULONGLONG ullTimerID(ʱID)
+// @Para: void* pUser(CRosaConnector)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaConnector::OnScanTimer(ULONGLONG ullTimerID, void * pUser)
+{
+	CRosaConnector* pConnector = reinterpret_cast<CRosaConnector*>(pUser);
+	ULONGLONG ullNow = CRosaEventLoop::CRosaEventLoopGetTickMSec();
+	vector<S_CONNECTREQUEST> vecFailed;
+
+	EnterCriticalSection(&pConnector->m_csConnect);
+
+	map<ULONGLONG, LPS_CONNECTREQUEST>::iterator iter = pConnector->m_mapRequest.begin();
+	while (iter != pConnector->m_mapRequest.end())
+	{
+		LPS_CONNECTREQUEST pRequest = iter->second;
+
+		if (pRequest->bDone || pRequest->bResolving)
+		{
+			++iter;
+			continue;
+		}
+
+		// ʱĳȡɻصһַ
+		for (vector<LPS_CONNECTATTEMPT>::iterator it = pRequest->vecAttempt.begin(); it != pRequest->vecAttempt.end(); ++it)
+		{
+			if (!(*it)->bCanceled && (*it)->ullDeadline <= ullNow)
+			{
+				(*it)->bCanceled = true;
+				pRequest->bTimeOut = true;
+				CancelIoEx((HANDLE)(*it)->Socket, &(*it)->Overlapped.Overlapped);
+			}
+		}
+
+		// ӳѹδӣʼһַ(еĳԲ)
+		if (pRequest->nNextAddress < pRequest->vecAddress.size() && pRequest->ullNextStart <= ullNow)
+		{
+			bool bStarted = false;
+
+			while (!bStarted && pRequest->nNextAddress < pRequest->vecAddress.size())
+			{
+				bStarted = pConnector->StartAttempt(pRequest, ullNow);
+			}
+		}
+
+		// ʣַȫͬʧ
+		if (pRequest->vecAttempt.empty())
+		{
+			pRequest->bDone = true;
+			vecFailed.push_back(*pRequest);
+			delete pRequest;
+			iter = pConnector->m_mapRequest.erase(iter);
+			continue;
+		}
+
+		++iter;
+	}
+
+	LeaveCriticalSection(&pConnector->m_csConnect);
+
+	for (vector<S_CONNECTREQUEST>::iterator it = vecFailed.begin(); it != vecFailed.end(); ++it)
+	{
+		it->pCallback(it->ullConnectID, INVALID_SOCKET, it->bTimeOut ? SOB_RET_TIMEOUT : SOB_RET_FAIL, it->dwUser);
+	}
+
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnResolved()
+// @Purpose: CRosaConnectorɻص(߳)
+// @Since: v1.00a
+// @Para: const char* pcHost()
+// @Para: const SOCKADDR_STORAGE* pAddress()
+// @Para: int nCount(ַ)
+// @Para: int nError()
+// @Para: DWORD_PTR dwUser(S_CONNECTRESOLVE)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaConnector::OnResolved(const char * pcHost, const SOCKADDR_STORAGE * pAddress, int nCount, int nError, DWORD_PTR dwUser)
+{
+	LPS_CONNECTRESOLVE pResolve = reinterpret_cast<LPS_CONNECTRESOLVE>(dwUser);
+	CRosaConnector* pConnector = pResolve->pConnector;
+
+	pConnector->ResolveDone(pResolve->ullConnectID, pResolve->sPort, (nError == 0) ? pAddress : NULL, (nError == 0) ? nCount : 0, true);
+
+	delete pResolve;
+
+	// ݼ֮ѱ
+	InterlockedDecrement(&pConnector->m_nResolving);
+}
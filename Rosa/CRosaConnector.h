@@ -0,0 +1,126 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaConnector.h
+* @brief	This File is RosaConnector Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSACONNECTOR_H__
+#define __CROSACONNECTOR_H__
+
+//Include Rosa Header File
+#include "CRosaSocket.h"
+#include "CRosaEventLoop.h"
+#include "CRosaResolver.h"
+
+//Include C/C++ Header File
+#include <map>
+#include <vector>
+
+using namespace std;
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSACONNECTOR_API	__declspec(dllexport)
+#else
+#define ROSACONNECTOR_API	__declspec(dllimport)
+#endif
+
+#define ROSACONNECTOR_CALLMODE	__stdcall
+
+#define ROSA_CONNECT_ATTEMPT_TIMEOUT	3000		//ַӳʱ()
+#define ROSA_CONNECT_RACE_DELAY			250			//һַӳ(, RFC 8305)
+#define ROSA_CONNECT_SCAN_MSEC			10			//ʱ()
+
+//Callback Definition
+typedef void(__stdcall *HANDLE_CONNECT_CALLBACK)(ULONGLONG ullConnectID, SOCKET s, int nResult, DWORD_PTR dwUser);		//ɻص(nResultΪSOB_RET_*)
+
+//Struct Definition
+typedef struct _S_CONNECTREQUEST S_CONNECTREQUEST, *LPS_CONNECTREQUEST;
+
+typedef struct
+{
+	S_ROSAOVERLAPPED Overlapped;			// صṹ(λλ)
+	SOCKET Socket;							// ӵ׽
+	ULONGLONG ullDeadline;					// γԵĳʱʱ
+	bool bCanceled;							// ǷѾȡ
+	LPS_CONNECTREQUEST pRequest;			// 
+}S_CONNECTATTEMPT, *LPS_CONNECTATTEMPT;
+
+struct _S_CONNECTREQUEST
+{
+	ULONGLONG ullConnectID;					// ID
+	vector<SOCKADDR_STORAGE> vecAddress;	// ѡַ(Ѱַ彻)
+	size_t nNextAddress;					// һԵĵַ
+	vector<LPS_CONNECTATTEMPT> vecAttempt;	// еĳ
+	ULONGLONG ullNextStart;					// һַʱ
+	DWORD dwAttemptTimeOut;					// ַӳʱ
+	DWORD dwRaceDelay;						// ӳ
+	bool bDone;								// ǷѾص
+	bool bTimeOut;							// Ƿгʱʧ
+	bool bResolving;						// Ƿڵȴ
+	HANDLE_CONNECT_CALLBACK pCallback;		// ɻص
+	DWORD_PTR dwUser;							// û
+};
+
+class CRosaConnector;
+
+typedef struct
+{
+	CRosaConnector* pConnector;				// 
+	ULONGLONG ullConnectID;					// ID
+	USHORT sPort;							// Զ˶˿ں
+}S_CONNECTRESOLVE, *LPS_CONNECTRESOLVE;
+
+//Class Definition
+class ROSACONNECTOR_API CRosaConnector
+{
+public:
+	CRosaConnector();			// CRosaConnector 캯
+	~CRosaConnector();			// CRosaConnector 
+
+public:
+	bool ROSACONNECTOR_CALLMODE CRosaConnectorCreate(CRosaEventLoop* pLoop);		// CRosaConnector ¼ѭ
+	void ROSACONNECTOR_CALLMODE CRosaConnectorDestroy();							// CRosaConnector ȡȫӲ
+	void ROSACONNECTOR_CALLMODE CRosaConnectorSetResolver(CRosaResolver* pResolver);	// CRosaConnector û(NULLʾĬϽ, ں̨)
+
+	ULONGLONG ROSACONNECTOR_CALLMODE CRosaConnectorConnect(const char* pcHost, USHORT sPort, HANDLE_CONNECT_CALLBACK pCallback, DWORD_PTR dwUser, DWORD dwAttemptTimeOut = ROSA_CONNECT_ATTEMPT_TIMEOUT, DWORD dwRaceDelay = ROSA_CONNECT_RACE_DELAY);											// CRosaConnector 첽(IP)
+	ULONGLONG ROSACONNECTOR_CALLMODE CRosaConnectorConnectAddr(const SOCKADDR_STORAGE* pAddress, int nCount, HANDLE_CONNECT_CALLBACK pCallback, DWORD_PTR dwUser, DWORD dwAttemptTimeOut = ROSA_CONNECT_ATTEMPT_TIMEOUT, DWORD dwRaceDelay = ROSA_CONNECT_RACE_DELAY);		// CRosaConnector 첽(ѽַб)
+	bool ROSACONNECTOR_CALLMODE CRosaConnectorCancel(ULONGLONG ullConnectID);		// CRosaConnector ȡ(صSOB_RET_FAIL)
+
+	int ROSACONNECTOR_CALLMODE CRosaConnectorGetPendingCount();						// CRosaConnector ȡе
+
+	static int ROSACONNECTOR_CALLMODE SortAddressForRace(vector<SOCKADDR_STORAGE>& vecAddress);	// CRosaConnector ѡַַ彻
+
+private:
+	bool StartAttempt(LPS_CONNECTREQUEST pRequest, ULONGLONG ullNow);				// CRosaConnector ʼһַ
+	void FinishAttempt(LPS_CONNECTATTEMPT pAttempt, DWORD dwError);					// CRosaConnector ӳԽ
+	LPFN_CONNECTEX GetConnectEx(SOCKET s, int nFamily);								// CRosaConnector ȡConnectExչ
+	bool ResolveDone(ULONGLONG ullConnectID, USHORT sPort, const SOCKADDR_STORAGE* pAddress, int nCount, bool bCallback);	// CRosaConnector ɺʼ
+
+	static void __stdcall OnConnectComplete(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError);		// CRosaConnector ɻص
+	static void __stdcall OnScanTimer(ULONGLONG ullTimerID, void* pUser);										// CRosaConnector ʱ鶨ʱ
+	static void __stdcall OnResolved(const char* pcHost, const SOCKADDR_STORAGE* pAddress, int nCount, int nError, DWORD_PTR dwUser);	// CRosaConnector ɻص
+
+private:
+	CRosaEventLoop* m_pLoop;								// CRosaConnector ¼ѭ
+	ULONGLONG m_ullScanTimerID;								// CRosaConnector ʱ鶨ʱ
+	CRITICAL_SECTION m_csConnect;							// CRosaConnector ٽ
+	map<ULONGLONG, LPS_CONNECTREQUEST> m_mapRequest;		// CRosaConnector е
+	ULONGLONG m_ullNextConnectID;							// CRosaConnector һID
+
+	LPFN_CONNECTEX m_pfnConnectEx4;							// CRosaConnector ConnectEx(IPv4)
+	LPFN_CONNECTEX m_pfnConnectEx6;							// CRosaConnector ConnectEx(IPv6)
+
+	CRosaResolver* m_pResolver;								// CRosaConnector 
+	volatile LONG m_nResolving;								// CRosaConnector ȴеĽص
+
+};
+
+#endif // !__CROSACONNECTOR_H__
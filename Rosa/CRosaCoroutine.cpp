@@ -0,0 +1,250 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaCoroutine.cpp
+* @brief	This File is RosaCoroutine Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaCoroutine.h"
+
+//CRosaAsyncOp Э̵ȴ(ɶ˿)
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncOp()
+// @Purpose: CRosaAsyncOp캯
+// @Since: v1.00a
+// @Para: CRosaEventLoop* pLoop(¼ѭ)
+// @Para: HANDLE hHandle(, ʱʱȡϵıβ)
+// @Para: DWORD dwTimeOutMSec(ʱ, INFINITEʾʱ)
+// @Para: HANDLE_ASYNC_START pStart()
+// @Para: HANDLE_ASYNC_FINISH pFinish(ɴ, ΪNULL)
+// @Para: void* pOwner()
+// @Return: None
+//------------------------------------------------------------------
+CRosaAsyncOp::CRosaAsyncOp(CRosaEventLoop * pLoop, HANDLE hHandle, DWORD dwTimeOutMSec, HANDLE_ASYNC_START pStart, HANDLE_ASYNC_FINISH pFinish, void * pOwner)
+{
+	memset(&m_Op.Overlapped, 0, sizeof(m_Op.Overlapped));
+	m_Op.hCoroutine = NULL;
+	m_Op.pLoop = pLoop;
+	m_Op.hHandle = hHandle;
+	m_Op.dwTimeOutMSec = dwTimeOutMSec;
+	m_Op.ullTimerID = 0;
+	m_Op.nTimedOut = 0;
+	m_Op.pStart = pStart;
+	m_Op.pFinish = pFinish;
+	m_Op.pOwner = pOwner;
+	m_Op.pTarget = NULL;
+	m_Op.pBuffer = NULL;
+	m_Op.uiSize = 0;
+	m_Op.pdwBytes = NULL;
+	m_Op.dwParam = 0;
+	m_Op.Socket = INVALID_SOCKET;
+	m_Op.dwBytes = 0;
+	m_Op.dwError = 0;
+	m_Op.nResult = SOB_RET_OK;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaAsyncOp()
+// @Purpose: CRosaAsyncOp
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaAsyncOp::~CRosaAsyncOp()
+{
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncOpSetBuffer()
+// @Purpose: CRosaAsyncOpݻ
+// @Since: v1.00a
+// @Para: char* pBuffer(ݻ)
+// @Para: UINT uiSize(ݳ)
+// @Para: DWORD* pdwBytes(ʱд봫ֽ, ΪNULL)
+// @Return: None
+//------------------------------------------------------------------
+void ROSACOROUTINE_CALLMODE CRosaAsyncOp::CRosaAsyncOpSetBuffer(char * pBuffer, UINT uiSize, DWORD * pdwBytes)
+{
+	m_Op.pBuffer = pBuffer;
+	m_Op.uiSize = uiSize;
+	m_Op.pdwBytes = pdwBytes;
+
+	if (pdwBytes != NULL)
+	{
+		*pdwBytes = 0;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncOpSetTarget()
+// @Purpose: CRosaAsyncOpøӶ󼰲
+// @Since: v1.00a
+// @Para: void* pTarget(Ӷ)
+// @Para: DWORD dwParam(Ӳ)
+// @Return: None
+//------------------------------------------------------------------
+void ROSACOROUTINE_CALLMODE CRosaAsyncOp::CRosaAsyncOpSetTarget(void * pTarget, DWORD dwParam)
+{
+	m_Op.pTarget = pTarget;
+	m_Op.dwParam = dwParam;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncOpStart()
+// @Purpose: CRosaAsyncOp(trueɰָ̻߳Э, ٷʱ)
+// @Since: v1.00a
+// @Para: None
+// @Return: bool bRet (true:Э̹ȴ, false:ͬʧ, Эִ̼)
+//------------------------------------------------------------------
+bool ROSACOROUTINE_CALLMODE CRosaAsyncOp::CRosaAsyncOpStart()
+{
+	if (m_Op.pLoop == NULL || m_Op.pStart == NULL || !m_Op.pLoop->CRosaEventLoopIsRunning())
+	{
+		m_Op.dwError = ERROR_INVALID_HANDLE;
+		return false;
+	}
+
+	memset(&m_Op.Overlapped.Overlapped, 0, sizeof(m_Op.Overlapped.Overlapped));
+	m_Op.Overlapped.pCallback = OnAsyncComplete;
+	m_Op.Overlapped.pUser = &m_Op;
+	m_Op.nTimedOut = 0;
+	m_Op.ullTimerID = 0;
+
+	// ʱʱڲ, 󱾶ʱܱͷ
+	if (m_Op.dwTimeOutMSec != INFINITE)
+	{
+		m_Op.ullTimerID = m_Op.pLoop->CRosaEventLoopSetTimer(m_Op.dwTimeOutMSec, 0, OnAsyncTimeOut, &m_Op);
+	}
+
+	DWORD dwError = m_Op.pStart(&m_Op);
+	if (dwError == ERROR_IO_PENDING)
+	{
+		return true;
+	}
+
+	// ͬʧܲɰ
+	if (m_Op.ullTimerID != 0)
+	{
+		m_Op.pLoop->CRosaEventLoopKillTimer(m_Op.ullTimerID);
+		m_Op.ullTimerID = 0;
+	}
+
+	m_Op.dwError = dwError;
+	return false;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncOpGetResult()
+// @Purpose: CRosaAsyncOpȡ
+// @Since: v1.00a
+// @Para: None
+// @Return: int nRet (SOB_RET_OK:ɹ, SOB_RET_TIMEOUT:ʱ, SOB_RET_CLOSE:Զ˶Ͽ, SOB_RET_FAIL:ʧܻȡ)
+//------------------------------------------------------------------
+int ROSACOROUTINE_CALLMODE CRosaAsyncOp::CRosaAsyncOpGetResult() const
+{
+	if (m_Op.dwError == 0)
+	{
+		return m_Op.nResult;
+	}
+
+	if (m_Op.dwError == ERROR_OPERATION_ABORTED && m_Op.nTimedOut)
+	{
+		return SOB_RET_TIMEOUT;
+	}
+
+	if (m_Op.dwError == ERROR_NETNAME_DELETED || m_Op.dwError == WSAECONNRESET || m_Op.dwError == WSAECONNABORTED)
+	{
+		return SOB_RET_CLOSE;
+	}
+
+	return SOB_RET_FAIL;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaAsyncOpSleep()
+// @Purpose: CRosaAsyncOpЭ̵ȴ(ռ߳)
+// @Since: v1.00a
+// @Para: CRosaEventLoop* pLoop(¼ѭ)
+// @Para: DWORD dwMSec(ȴʱ, )
+// @Return: CRosaAsyncOp Op(co_awaitSOB_RET_OK)
+//------------------------------------------------------------------
+CRosaAsyncOp ROSACOROUTINE_CALLMODE CRosaAsyncOp::CRosaAsyncOpSleep(CRosaEventLoop * pLoop, DWORD dwMSec)
+{
+	return CRosaAsyncOp(pLoop, NULL, (dwMSec == INFINITE) ? INFINITE - 1 : dwMSec, OnSleepStart, NULL, NULL);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnSleepStart()
+// @Purpose: CRosaAsyncOpȴ(ʱʱͶɰ)
+// @Since: v1.00a
+// @Para: LPS_ROSAASYNCOP pOp(״̬)
+// @Return: DWORD dwError
+//------------------------------------------------------------------
+DWORD __stdcall CRosaAsyncOp::OnSleepStart(LPS_ROSAASYNCOP pOp)
+{
+	return (pOp->ullTimerID != 0) ? ERROR_IO_PENDING : ERROR_NOT_ENOUGH_MEMORY;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAsyncComplete()
+// @Purpose: CRosaAsyncOpɻص(ѭ߳лָЭ)
+// @Since: v1.00a
+// @Para: LPS_ROSAOVERLAPPED pOverlapped(صṹ)
+// @Para: DWORD dwBytes(ֽ)
+// @Para: DWORD dwError()
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaAsyncOp::OnAsyncComplete(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError)
+{
+	LPS_ROSAASYNCOP pOp = (LPS_ROSAASYNCOP)pOverlapped->pUser;
+
+	// ɾʱȴִеĳʱص
+	if (pOp->ullTimerID != 0)
+	{
+		pOp->pLoop->CRosaEventLoopKillTimer(pOp->ullTimerID);
+		pOp->ullTimerID = 0;
+	}
+
+	pOp->dwBytes = dwBytes;
+	pOp->dwError = dwError;
+
+	if (pOp->pdwBytes != NULL)
+	{
+		*pOp->pdwBytes = dwBytes;
+	}
+
+	if (pOp->pFinish != NULL)
+	{
+		pOp->pFinish(pOp);
+	}
+
+	pOp->hCoroutine.resume();
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAsyncTimeOut()
+// @Purpose: CRosaAsyncOpʱʱ(ȡ, ɰERROR_OPERATION_ABORTED)
+// @Since: v1.00a
+// @Para: ULONGLONG ullTimerID(ʱID)
+// @Para: void* pUser(״̬)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaAsyncOp::OnAsyncTimeOut(ULONGLONG ullTimerID, void * pUser)
+{
+	LPS_ROSAASYNCOP pOp = (LPS_ROSAASYNCOP)pUser;
+
+	InterlockedExchange(&pOp->nTimedOut, 1);
+
+	if (pOp->hHandle == NULL)
+	{
+		pOp->pLoop->CRosaEventLoopPost(&pOp->Overlapped);
+		return;
+	}
+
+	CancelIoEx(pOp->hHandle, &pOp->Overlapped.Overlapped);
+}
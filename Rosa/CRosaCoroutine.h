@@ -0,0 +1,125 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaCoroutine.h
+* @brief	This File is RosaCoroutine Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSACOROUTINE_H__
+#define __CROSACOROUTINE_H__
+
+//Include Rosa Header File
+#include "CRosaSocket.h"
+#include "CRosaEventLoop.h"
+
+//Include C/C++ Header File
+#include <exception>
+
+//Include Coroutine Header File (VS2017Ҫ/await, C++20ʹñ׼ͷļ)
+#if defined(__cpp_impl_coroutine)
+#include <coroutine>
+#define ROSA_COROUTINE_NAMESPACE	std
+#else
+#include <experimental/coroutine>
+#define ROSA_COROUTINE_NAMESPACE	std::experimental
+#endif
+
+using namespace std;
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSACOROUTINE_API	__declspec(dllexport)
+#else
+#define ROSACOROUTINE_API	__declspec(dllimport)
+#endif
+
+#define ROSACOROUTINE_CALLMODE	__stdcall
+
+#define ROSA_ASYNC_ADDR_BUFFER		(2 * (sizeof(SOCKADDR_STORAGE) + 16))	//AcceptExַ峤
+#define ROSA_ASYNC_TIMEOUT_MSEC		(SOB_DEFAULT_TIMEOUT_SEC * 1000)		//첽Ĭϳʱ()
+
+typedef ROSA_COROUTINE_NAMESPACE::coroutine_handle<> ROSA_COROUTINE_HANDLE;
+
+//Struct Definition
+typedef struct _S_ROSAASYNCOP S_ROSAASYNCOP, *LPS_ROSAASYNCOP;
+
+//Callback Definition
+typedef DWORD(__stdcall *HANDLE_ASYNC_START)(LPS_ROSAASYNCOP pOp);		//巢(ERROR_IO_PENDINGʾȴɰ, Ϊͬ)
+typedef void(__stdcall *HANDLE_ASYNC_FINISH)(LPS_ROSAASYNCOP pOp);		//ɴ(ָЭǰѭִ߳)
+
+struct _S_ROSAASYNCOP
+{
+	S_ROSAOVERLAPPED Overlapped;			// صṹ(λλ)
+	ROSA_COROUTINE_HANDLE hCoroutine;		// ȴЭ
+	CRosaEventLoop* pLoop;					// ¼ѭ
+	HANDLE hHandle;							// (ʱʱCancelIoEx, NULLʾʱ)
+	DWORD dwTimeOutMSec;					// ʱ(, INFINITEʾʱ)
+	ULONGLONG ullTimerID;					// ʱʱ
+	volatile LONG nTimedOut;				// ǷѾʱ
+	HANDLE_ASYNC_START pStart;				// 
+	HANDLE_ASYNC_FINISH pFinish;			// ɴ
+	void* pOwner;							// (CRosaAsyncSocket/CRosaAsyncSerial)
+	void* pTarget;							// Ӷ(ӵCRosaAsyncSocket)
+	char* pBuffer;							// ݻ
+	UINT uiSize;							// ݳ
+	DWORD* pdwBytes;						// ֽ(߱)
+	DWORD dwParam;							// Ӳ(:ַʱ)
+	SOCKET Socket;							// ջӵõ׽
+	char chAddrBuf[ROSA_ASYNC_ADDR_BUFFER];	// AcceptExַ
+	DWORD dwBytes;							// ֽ
+	DWORD dwError;							// ɴ
+	int nResult;							// (SOB_RET_*)
+};
+
+//Class Definition
+class CRosaTask
+{
+public:
+	// ִеЭ(, ʱԶͷ, ÿһỰ)
+	struct promise_type
+	{
+		CRosaTask get_return_object() { return CRosaTask(); }
+		ROSA_COROUTINE_NAMESPACE::suspend_never initial_suspend() { return ROSA_COROUTINE_NAMESPACE::suspend_never(); }
+		ROSA_COROUTINE_NAMESPACE::suspend_never final_suspend() noexcept { return ROSA_COROUTINE_NAMESPACE::suspend_never(); }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+	};
+};
+
+class ROSACOROUTINE_API CRosaAsyncOp
+{
+public:
+	CRosaAsyncOp(CRosaEventLoop* pLoop, HANDLE hHandle, DWORD dwTimeOutMSec, HANDLE_ASYNC_START pStart, HANDLE_ASYNC_FINISH pFinish, void* pOwner);	// CRosaAsyncOp 캯
+	~CRosaAsyncOp();			// CRosaAsyncOp 
+
+public:
+	// co_await ӿ(ɺ¼ѭ߳лָЭ)
+	bool await_ready() const { return false; }
+	bool await_suspend(ROSA_COROUTINE_HANDLE hCoroutine) { m_Op.hCoroutine = hCoroutine; return CRosaAsyncOpStart(); }
+	int await_resume() const { return CRosaAsyncOpGetResult(); }
+
+	void ROSACOROUTINE_CALLMODE CRosaAsyncOpSetBuffer(char* pBuffer, UINT uiSize, DWORD* pdwBytes);		// CRosaAsyncOp ݻ
+	void ROSACOROUTINE_CALLMODE CRosaAsyncOpSetTarget(void* pTarget, DWORD dwParam = 0);					// CRosaAsyncOp øӶ󼰲
+
+	bool ROSACOROUTINE_CALLMODE CRosaAsyncOpStart();						// CRosaAsyncOp (falseʾͬʧ, Э̲)
+	int ROSACOROUTINE_CALLMODE CRosaAsyncOpGetResult() const;				// CRosaAsyncOp ȡ(SOB_RET_*)
+
+	static CRosaAsyncOp ROSACOROUTINE_CALLMODE CRosaAsyncOpSleep(CRosaEventLoop* pLoop, DWORD dwMSec);		// CRosaAsyncOp Э̵ȴ(co_awaitSOB_RET_OK)
+
+private:
+	static DWORD __stdcall OnSleepStart(LPS_ROSAASYNCOP pOp);												// CRosaAsyncOp ȴ(ֻöʱ)
+	static void __stdcall OnAsyncComplete(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError);	// CRosaAsyncOp ɻص(ָЭ)
+	static void __stdcall OnAsyncTimeOut(ULONGLONG ullTimerID, void* pUser);								// CRosaAsyncOp ʱʱ
+
+private:
+	S_ROSAASYNCOP m_Op;			// CRosaAsyncOp ״̬(ڼλЭ֡)
+
+};
+
+#endif // !__CROSACOROUTINE_H__
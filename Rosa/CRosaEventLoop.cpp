@@ -0,0 +1,734 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaEventLoop.cpp
+* @brief	This File is RosaEventLoop Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaEventLoop.h"
+#include "CThreadSafe.h"
+
+#include <process.h>
+
+//CRosaEventLoop ¼ѭ(ɶ˿)
+
+//------------------------------------------------------------------
+// @Function:	 CRosaEventLoop()
+// @Purpose: CRosaEventLoop캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaEventLoop::CRosaEventLoop()
+{
+	m_hIOCP = NULL;
+	m_nThreads = 0;
+	m_bRunning = false;
+
+	memset(m_hThreads, 0, sizeof(m_hThreads));
+	memset(m_dwThreadIDs, 0, sizeof(m_dwThreadIDs));
+
+	m_uiTimerFree = ROSA_LOOP_TIMER_NIL;
+	m_uiTimerCount = 0;
+	m_ullWheelTick = CRosaEventLoopGetTickMSec() / ROSA_LOOP_TICK_MSEC;
+	m_ullFiringTimerID = 0;
+
+	for (UINT i = 0; i <= ROSA_LOOP_WHEEL_SLOTS; ++i)
+	{
+		m_uiWheel[i] = ROSA_LOOP_TIMER_NIL;
+	}
+
+	InitializeCriticalSection(&m_csTimer);
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaEventLoop()
+// @Purpose: CRosaEventLoop
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaEventLoop::~CRosaEventLoop()
+{
+	CRosaEventLoopDestroy();
+
+	DeleteCriticalSection(&m_csTimer);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaEventLoopCreate()
+// @Purpose: CRosaEventLoopɶ˿ڼѭ߳
+// @Since: v1.00a
+// @Para: USHORT nThreads(ѭ߳, 0ʾ)
+// @Para: bool bAffinity(Ƿÿ̰߳󶨵һ)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSAEVENTLOOP_CALLMODE CRosaEventLoop::CRosaEventLoopCreate(USHORT nThreads, bool bAffinity)
+{
+	if (m_hIOCP != NULL)
+	{
+		return false;
+	}
+
+	// (ֻʹõһ)
+	SYSTEM_INFO si;
+	GetSystemInfo(&si);
+
+	DWORD dwProcessors = si.dwNumberOfProcessors;
+	if (dwProcessors == 0)
+	{
+		dwProcessors = 1;
+	}
+	if (dwProcessors > sizeof(DWORD_PTR) * 8)
+	{
+		dwProcessors = sizeof(DWORD_PTR) * 8;
+	}
+
+	if (nThreads == 0)
+	{
+		nThreads = (USHORT)dwProcessors;
+	}
+	if (nThreads > ROSA_LOOP_MAX_THREADS)
+	{
+		nThreads = ROSA_LOOP_MAX_THREADS;
+	}
+
+	m_hIOCP = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, nThreads);
+	if (m_hIOCP == NULL)
+	{
+		return false;
+	}
+
+	m_bRunning = true;
+
+	// ߳ȹ𣬼¼߳ID(0̸߳ʱ)
+	for (USHORT i = 0; i < nThreads; ++i)
+	{
+		unsigned unThreadID = 0;
+		HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, OnLoopThread, (void*)this, CREATE_SUSPENDED, &unThreadID);
+
+		if (!hThread)
+		{
+			break;
+		}
+
+		if (bAffinity)
+		{
+			SetThreadAffinityMask(hThread, (DWORD_PTR)1 << (i % dwProcessors));
+		}
+
+		m_hThreads[m_nThreads] = hThread;
+		m_dwThreadIDs[m_nThreads] = unThreadID;
+		m_nThreads++;
+	}
+
+	if (m_nThreads == 0)
+	{
+		CloseHandle(m_hIOCP);
+		m_hIOCP = NULL;
+		m_bRunning = false;
+		return false;
+	}
+
+	for (USHORT i = 0; i < m_nThreads; ++i)
+	{
+		ResumeThread(m_hThreads[i]);
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaEventLoopDestroy()
+// @Purpose: CRosaEventLoopֹͣѭ̲߳رɶ˿
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSAEVENTLOOP_CALLMODE CRosaEventLoop::CRosaEventLoopDestroy()
+{
+	if (m_hIOCP == NULL)
+	{
+		return;
+	}
+
+	m_bRunning = false;
+
+	// ÿ߳һ˳
+	for (USHORT i = 0; i < m_nThreads; ++i)
+	{
+		PostQueuedCompletionStatus(m_hIOCP, 0, ROSA_LOOP_KEY_EXIT, NULL);
+	}
+
+	WaitForMultipleObjects(m_nThreads, m_hThreads, TRUE, INFINITE);
+
+	for (USHORT i = 0; i < m_nThreads; ++i)
+	{
+		CloseHandle(m_hThreads[i]);
+		m_hThreads[i] = NULL;
+		m_dwThreadIDs[i] = 0;
+	}
+
+	m_nThreads = 0;
+
+	CloseHandle(m_hIOCP);
+	m_hIOCP = NULL;
+
+	// ͷȫʱ(, ID֮ʧЧ)
+	EnterCriticalSection(&m_csTimer);
+
+	for (UINT i = 0; i < (UINT)m_vecTimer.size(); ++i)
+	{
+		if (m_vecTimer[i].uiSlot != ROSA_LOOP_TIMER_NIL)
+		{
+			FreeTimer(i);
+		}
+	}
+
+	for (UINT i = 0; i <= ROSA_LOOP_WHEEL_SLOTS; ++i)
+	{
+		m_uiWheel[i] = ROSA_LOOP_TIMER_NIL;
+	}
+
+	LeaveCriticalSection(&m_csTimer);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaEventLoopAttach()
+// @Purpose: CRosaEventLoopɶ˿(ɼΪ)
+// @Since: v1.00a
+// @Para: HANDLE hHandle(SOCKETFILE_FLAG_OVERLAPPED򿪵ľ)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSAEVENTLOOP_CALLMODE CRosaEventLoop::CRosaEventLoopAttach(HANDLE hHandle)
+{
+	if (m_hIOCP == NULL)
+	{
+		return false;
+	}
+
+	return (CreateIoCompletionPort(hHandle, m_hIOCP, (ULONG_PTR)hHandle, 0) != NULL);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaEventLoopPost()
+// @Purpose: CRosaEventLoopͶɰ(صѭִ߳)
+// @Since: v1.00a
+// @Para: LPS_ROSAOVERLAPPED pOverlapped(صṹ)
+// @Para: DWORD dwBytes(صеֽ)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSAEVENTLOOP_CALLMODE CRosaEventLoop::CRosaEventLoopPost(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes)
+{
+	if (m_hIOCP == NULL || pOverlapped == NULL)
+	{
+		return false;
+	}
+
+	return (PostQueuedCompletionStatus(m_hIOCP, dwBytes, ROSA_LOOP_KEY_POST, &pOverlapped->Overlapped) == TRUE);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaEventLoopSetTimer()
+// @Purpose: CRosaEventLoopöʱ(ص0ѭִ߳)
+// @Since: v1.00a
+// @Para: DWORD dwDelayMSec(״εʱ)
+// @Para: DWORD dwPeriodMSec(ظ, 0ʾ)
+// @Para: HANDLE_TIMER_CALLBACK pCallback(ʱص)
+// @Para: void* pUser(û)
+// @Return: ULONGLONG ullTimerID (0:ʧ)
+//------------------------------------------------------------------
+ULONGLONG ROSAEVENTLOOP_CALLMODE CRosaEventLoop::CRosaEventLoopSetTimer(DWORD dwDelayMSec, DWORD dwPeriodMSec, HANDLE_TIMER_CALLBACK pCallback, void * pUser)
+{
+	if (pCallback == NULL)
+	{
+		return 0;
+	}
+
+	ULONGLONG ullExpire = (CRosaEventLoopGetTickMSec() + dwDelayMSec + ROSA_LOOP_TICK_MSEC - 1) / ROSA_LOOP_TICK_MSEC;
+
+	CThreadSafe ThreadSafe(&m_csTimer);
+
+	// ȸÿжʱ
+	UINT uiIndex = m_uiTimerFree;
+	if (uiIndex != ROSA_LOOP_TIMER_NIL)
+	{
+		m_uiTimerFree = m_vecTimer[uiIndex].uiNext;
+	}
+	else
+	{
+		S_LOOPTIMER sTimer = { 0 };
+		sTimer.dwGeneration = 1;
+		sTimer.uiSlot = ROSA_LOOP_TIMER_NIL;
+
+		uiIndex = (UINT)m_vecTimer.size();
+		m_vecTimer.push_back(sTimer);
+	}
+
+	S_LOOPTIMER& sTimer = m_vecTimer[uiIndex];
+	sTimer.ullExpire = ullExpire;
+	sTimer.dwPeriod = dwPeriodMSec;
+	sTimer.pCallback = pCallback;
+	sTimer.pUser = pUser;
+
+	ScheduleTimer(uiIndex);
+	m_uiTimerCount++;
+
+	return ((ULONGLONG)sTimer.dwGeneration << 32) | (uiIndex + 1);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaEventLoopKillTimer()
+// @Purpose: CRosaEventLoopɾʱ(صִ߳ȴ)
+// @Since: v1.00a
+// @Para: ULONGLONG ullTimerID(ʱID)
+// @Return: bool bRet (true:ɾɹ, false:ʱڻѾ)
+//------------------------------------------------------------------
+bool ROSAEVENTLOOP_CALLMODE CRosaEventLoop::CRosaEventLoopKillTimer(ULONGLONG ullTimerID)
+{
+	bool bFound = false;
+
+	EnterCriticalSection(&m_csTimer);
+
+	UINT uiIndex = FindTimer(ullTimerID);
+	if (uiIndex != ROSA_LOOP_TIMER_NIL)
+	{
+		UnlinkTimer(uiIndex);
+		FreeTimer(uiIndex);
+		bFound = true;
+	}
+
+	// ڶʱ߳ɾʱȴִеĻص
+	bool bWait = (m_nThreads > 0 && GetCurrentThreadId() != m_dwThreadIDs[0]);
+
+	while (bWait && m_ullFiringTimerID == ullTimerID)
+	{
+		LeaveCriticalSection(&m_csTimer);
+		Sleep(0);
+		EnterCriticalSection(&m_csTimer);
+	}
+
+	LeaveCriticalSection(&m_csTimer);
+
+	return bFound;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaEventLoopResetTimer()
+// @Purpose: CRosaEventLoopöʱʱ(ظڲ)
+// @Since: v1.00a
+// @Para: ULONGLONG ullTimerID(ʱID)
+// @Para: DWORD dwDelayMSec(ĵʱ)
+// @Return: bool bRet (true:ɹ, false:ʱڻѾ)
+//------------------------------------------------------------------
+bool ROSAEVENTLOOP_CALLMODE CRosaEventLoop::CRosaEventLoopResetTimer(ULONGLONG ullTimerID, DWORD dwDelayMSec)
+{
+	ULONGLONG ullExpire = (CRosaEventLoopGetTickMSec() + dwDelayMSec + ROSA_LOOP_TICK_MSEC - 1) / ROSA_LOOP_TICK_MSEC;
+
+	CThreadSafe ThreadSafe(&m_csTimer);
+
+	UINT uiIndex = FindTimer(ullTimerID);
+	if (uiIndex == ROSA_LOOP_TIMER_NIL)
+	{
+		return false;
+	}
+
+	UnlinkTimer(uiIndex);
+	m_vecTimer[uiIndex].ullExpire = ullExpire;
+	ScheduleTimer(uiIndex);
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaEventLoopGetTimerCount()
+// @Purpose: CRosaEventLoopȡʱ
+// @Since: v1.00a
+// @Para: None
+// @Return: UINT uiCount
+//------------------------------------------------------------------
+UINT ROSAEVENTLOOP_CALLMODE CRosaEventLoop::CRosaEventLoopGetTimerCount()
+{
+	CThreadSafe ThreadSafe(&m_csTimer);
+
+	return m_uiTimerCount;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaEventLoopGetHandle()
+// @Purpose: CRosaEventLoopȡɶ˿ھ
+// @Since: v1.00a
+// @Para: None
+// @Return: HANDLE hIOCP
+//------------------------------------------------------------------
+HANDLE ROSAEVENTLOOP_CALLMODE CRosaEventLoop::CRosaEventLoopGetHandle() const
+{
+	return m_hIOCP;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaEventLoopGetThreadCount()
+// @Purpose: CRosaEventLoopȡѭ߳
+// @Since: v1.00a
+// @Para: None
+// @Return: USHORT nThreads
+//------------------------------------------------------------------
+USHORT ROSAEVENTLOOP_CALLMODE CRosaEventLoop::CRosaEventLoopGetThreadCount() const
+{
+	return m_nThreads;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaEventLoopIsRunning()
+// @Purpose: CRosaEventLoopȡ״̬
+// @Since: v1.00a
+// @Para: None
+// @Return: bool bRet (true:, false:ֹͣ)
+//------------------------------------------------------------------
+bool ROSAEVENTLOOP_CALLMODE CRosaEventLoop::CRosaEventLoopIsRunning() const
+{
+	return m_bRunning;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaEventLoopGetTickMSec()
+// @Purpose: CRosaEventLoopȡǰʱ()
+// @Since: v1.00a
+// @Para: None
+// @Return: ULONGLONG ullTick
+//------------------------------------------------------------------
+ULONGLONG ROSAEVENTLOOP_CALLMODE CRosaEventLoop::CRosaEventLoopGetTickMSec()
+{
+	return GetTickCount64();
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnLoopThread()
+// @Purpose: CRosaEventLoopѭ߳(ȡɰص)
+// @Since: v1.00a
+// @Para: void* pParam(CRosaEventLoop)
+// @Return: unsigned int
+//------------------------------------------------------------------
+unsigned __stdcall CRosaEventLoop::OnLoopThread(void * pParam)
+{
+	CRosaEventLoop* pLoop = reinterpret_cast<CRosaEventLoop*>(pParam);
+	bool bTimerThread = (GetCurrentThreadId() == pLoop->m_dwThreadIDs[0]);
+	OVERLAPPED_ENTRY Entries[ROSA_LOOP_BATCH_ENTRIES];
+
+	while (true)
+	{
+		ULONG ulCount = 0;
+		BOOL bRet = GetQueuedCompletionStatusEx(pLoop->m_hIOCP, Entries, ROSA_LOOP_BATCH_ENTRIES, &ulCount, bTimerThread ? ROSA_LOOP_TICK_MSEC : INFINITE, FALSE);
+
+		if (!bRet)
+		{
+			// ȴʱ鶨ʱ
+			if (GetLastError() == WAIT_TIMEOUT)
+			{
+				pLoop->ProcessTimers();
+				continue;
+			}
+
+			// ɶ˿Ѿر
+			break;
+		}
+
+		ULONG ulExit = 0;
+
+		for (ULONG i = 0; i < ulCount; ++i)
+		{
+			if (Entries[i].lpOverlapped == NULL)
+			{
+				if (Entries[i].lpCompletionKey == ROSA_LOOP_KEY_EXIT)
+				{
+					ulExit++;
+				}
+				continue;
+			}
+
+			LPS_ROSAOVERLAPPED pOverlapped = CONTAINING_RECORD(Entries[i].lpOverlapped, S_ROSAOVERLAPPED, Overlapped);
+			DWORD dwBytes = Entries[i].dwNumberOfBytesTransferred;
+			DWORD dwError = 0;
+
+			// ʧܵI/Oͨ(ɼ)ȡش
+			if (Entries[i].lpCompletionKey != ROSA_LOOP_KEY_POST && Entries[i].lpOverlapped->Internal != 0)
+			{
+				DWORD dwTransferred = 0;
+				if (!GetOverlappedResult((HANDLE)Entries[i].lpCompletionKey, Entries[i].lpOverlapped, &dwTransferred, FALSE))
+				{
+					dwError = GetLastError();
+				}
+			}
+
+			if (pOverlapped->pCallback)
+			{
+				pOverlapped->pCallback(pOverlapped, dwBytes, dwError);
+			}
+		}
+
+		if (bTimerThread)
+		{
+			pLoop->ProcessTimers();
+		}
+
+		if (ulExit > 0)
+		{
+			// һȡ˶˳ʱ˻߳(ÿ߳һ)
+			for (ULONG i = 1; i < ulExit; ++i)
+			{
+				PostQueuedCompletionStatus(pLoop->m_hIOCP, 0, ROSA_LOOP_KEY_EXIT, NULL);
+			}
+
+			break;
+		}
+	}
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ProcessTimers()
+// @Purpose: CRosaEventLoopڶʱ(ص)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaEventLoop::ProcessTimers()
+{
+	ULONGLONG ullNowTick = CRosaEventLoopGetTickMSec() / ROSA_LOOP_TICK_MSEC;
+
+	EnterCriticalSection(&m_csTimer);
+
+	// ƽʱ֣ڲλѵ
+	while (m_ullWheelTick <= ullNowTick)
+	{
+		UINT uiIndex = (UINT)(m_ullWheelTick & (ROSA_LOOP_WHEEL_SIZE0 - 1));
+
+		// 0תһȦʱһĵǰλ(òҲתһȦʱ)
+		if (uiIndex == 0)
+		{
+			for (UINT uiLevel = 1; uiLevel < ROSA_LOOP_WHEEL_LEVELS; ++uiLevel)
+			{
+				UINT uiShift = ROSA_LOOP_WHEEL_BITS0 + (uiLevel - 1) * ROSA_LOOP_WHEEL_BITSN;
+				UINT uiLevelIndex = (UINT)((m_ullWheelTick >> uiShift) & (ROSA_LOOP_WHEEL_SIZEN - 1));
+
+				CascadeTimers(ROSA_LOOP_WHEEL_SIZE0 + (uiLevel - 1) * ROSA_LOOP_WHEEL_SIZEN + uiLevelIndex);
+
+				if (uiLevelIndex != 0)
+				{
+					break;
+				}
+			}
+		}
+
+		UINT uiTimer = m_uiWheel[uiIndex];
+		m_uiWheel[uiIndex] = ROSA_LOOP_TIMER_NIL;
+
+		while (uiTimer != ROSA_LOOP_TIMER_NIL)
+		{
+			UINT uiNext = m_vecTimer[uiTimer].uiNext;
+			InsertTimer(uiTimer, ROSA_LOOP_WHEEL_EXPIRED);
+			uiTimer = uiNext;
+		}
+
+		m_ullWheelTick++;
+	}
+
+	// ص(, صпûɾʱ)
+	while (m_uiWheel[ROSA_LOOP_WHEEL_EXPIRED] != ROSA_LOOP_TIMER_NIL)
+	{
+		UINT uiIndex = m_uiWheel[ROSA_LOOP_WHEEL_EXPIRED];
+		UnlinkTimer(uiIndex);
+
+		S_LOOPTIMER sTimer = m_vecTimer[uiIndex];
+		ULONGLONG ullTimerID = ((ULONGLONG)sTimer.dwGeneration << 32) | (uiIndex + 1);
+
+		// ظʱŶӣζʱͷ
+		if (sTimer.dwPeriod > 0)
+		{
+			m_vecTimer[uiIndex].ullExpire = ullNowTick + max((sTimer.dwPeriod + ROSA_LOOP_TICK_MSEC - 1) / ROSA_LOOP_TICK_MSEC, (DWORD)1);
+			ScheduleTimer(uiIndex);
+		}
+		else
+		{
+			FreeTimer(uiIndex);
+		}
+
+		m_ullFiringTimerID = ullTimerID;
+
+		LeaveCriticalSection(&m_csTimer);
+
+		sTimer.pCallback(ullTimerID, sTimer.pUser);
+
+		EnterCriticalSection(&m_csTimer);
+		m_ullFiringTimerID = 0;
+	}
+
+	LeaveCriticalSection(&m_csTimer);
+}
+
+//------------------------------------------------------------------
+// @Function:	 FindTimer()
+// @Purpose: CRosaEventLoopʱIDתΪ(ID32λΪ+1, 32λΪ)
+// @Since: v1.00a
+// @Para: ULONGLONG ullTimerID(ʱID)
+// @Return: UINT uiIndex (ROSA_LOOP_TIMER_NIL:ڻѾͷ)
+//------------------------------------------------------------------
+UINT CRosaEventLoop::FindTimer(ULONGLONG ullTimerID) const
+{
+	UINT uiIndex = (UINT)(ullTimerID & 0xFFFFFFFF) - 1;
+
+	if (uiIndex >= (UINT)m_vecTimer.size())
+	{
+		return ROSA_LOOP_TIMER_NIL;
+	}
+
+	const S_LOOPTIMER& sTimer = m_vecTimer[uiIndex];
+	if (sTimer.uiSlot == ROSA_LOOP_TIMER_NIL || sTimer.dwGeneration != (DWORD)(ullTimerID >> 32))
+	{
+		return ROSA_LOOP_TIMER_NIL;
+	}
+
+	return uiIndex;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ScheduleTimer()
+// @Purpose: CRosaEventLoopڽķʱ(ԽԶԽ)
+// @Since: v1.00a
+// @Para: UINT uiIndex(ʱ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaEventLoop::ScheduleTimer(UINT uiIndex)
+{
+	// ѾڵĶʱһ
+	ULONGLONG ullExpire = max(m_vecTimer[uiIndex].ullExpire, m_ullWheelTick);
+	ULONGLONG ullDelta = ullExpire - m_ullWheelTick;
+
+	if (ullDelta < ROSA_LOOP_WHEEL_SIZE0)
+	{
+		InsertTimer(uiIndex, (UINT)(ullExpire & (ROSA_LOOP_WHEEL_SIZE0 - 1)));
+		return;
+	}
+
+	for (UINT uiLevel = 1; uiLevel < ROSA_LOOP_WHEEL_LEVELS; ++uiLevel)
+	{
+		UINT uiShift = ROSA_LOOP_WHEEL_BITS0 + (uiLevel - 1) * ROSA_LOOP_WHEEL_BITSN;
+		ULONGLONG ullRange = 1ULL << (uiShift + ROSA_LOOP_WHEEL_BITSN);
+
+		if (ullDelta < ullRange || uiLevel == ROSA_LOOP_WHEEL_LEVELS - 1)
+		{
+			// ߲㷶ΧʱԶĲλʱʵʵڽŶ
+			if (ullDelta >= ullRange)
+			{
+				ullExpire = m_ullWheelTick + ullRange - 1;
+			}
+
+			InsertTimer(uiIndex, ROSA_LOOP_WHEEL_SIZE0 + (uiLevel - 1) * ROSA_LOOP_WHEEL_SIZEN + (UINT)((ullExpire >> uiShift) & (ROSA_LOOP_WHEEL_SIZEN - 1)));
+			return;
+		}
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 InsertTimer()
+// @Purpose: CRosaEventLoopλͷ
+// @Since: v1.00a
+// @Para: UINT uiIndex(ʱ)
+// @Para: UINT uiSlot(λ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaEventLoop::InsertTimer(UINT uiIndex, UINT uiSlot)
+{
+	S_LOOPTIMER& sTimer = m_vecTimer[uiIndex];
+
+	sTimer.uiSlot = uiSlot;
+	sTimer.uiPrev = ROSA_LOOP_TIMER_NIL;
+	sTimer.uiNext = m_uiWheel[uiSlot];
+
+	if (sTimer.uiNext != ROSA_LOOP_TIMER_NIL)
+	{
+		m_vecTimer[sTimer.uiNext].uiPrev = uiIndex;
+	}
+
+	m_uiWheel[uiSlot] = uiIndex;
+}
+
+//------------------------------------------------------------------
+// @Function:	 UnlinkTimer()
+// @Purpose: CRosaEventLoopƳλ
+// @Since: v1.00a
+// @Para: UINT uiIndex(ʱ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaEventLoop::UnlinkTimer(UINT uiIndex)
+{
+	S_LOOPTIMER& sTimer = m_vecTimer[uiIndex];
+
+	if (sTimer.uiPrev != ROSA_LOOP_TIMER_NIL)
+	{
+		m_vecTimer[sTimer.uiPrev].uiNext = sTimer.uiNext;
+	}
+	else
+	{
+		m_uiWheel[sTimer.uiSlot] = sTimer.uiNext;
+	}
+
+	if (sTimer.uiNext != ROSA_LOOP_TIMER_NIL)
+	{
+		m_vecTimer[sTimer.uiNext].uiPrev = sTimer.uiPrev;
+	}
+
+	sTimer.uiPrev = ROSA_LOOP_TIMER_NIL;
+	sTimer.uiNext = ROSA_LOOP_TIMER_NIL;
+}
+
+//------------------------------------------------------------------
+// @Function:	 FreeTimer()
+// @Purpose: CRosaEventLoopͷŶʱ(Ƴλ, ʹIDʧЧ)
+// @Since: v1.00a
+// @Para: UINT uiIndex(ʱ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaEventLoop::FreeTimer(UINT uiIndex)
+{
+	S_LOOPTIMER& sTimer = m_vecTimer[uiIndex];
+
+	sTimer.uiSlot = ROSA_LOOP_TIMER_NIL;
+	sTimer.pCallback = NULL;
+	sTimer.pUser = NULL;
+
+	if (++sTimer.dwGeneration == 0)
+	{
+		sTimer.dwGeneration = 1;
+	}
+
+	sTimer.uiNext = m_uiTimerFree;
+	m_uiTimerFree = uiIndex;
+
+	m_uiTimerCount--;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CascadeTimers()
+// @Purpose: CRosaEventLoop߲λеĶʱʣŶ
+// @Since: v1.00a
+// @Para: UINT uiSlot(λ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaEventLoop::CascadeTimers(UINT uiSlot)
+{
+	UINT uiTimer = m_uiWheel[uiSlot];
+	m_uiWheel[uiSlot] = ROSA_LOOP_TIMER_NIL;
+
+	while (uiTimer != ROSA_LOOP_TIMER_NIL)
+	{
+		UINT uiNext = m_vecTimer[uiTimer].uiNext;
+		ScheduleTimer(uiTimer);
+		uiTimer = uiNext;
+	}
+}
@@ -0,0 +1,130 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaEventLoop.h
+* @brief	This File is RosaEventLoop Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSAEVENTLOOP_H__
+#define __CROSAEVENTLOOP_H__
+
+//Include Windows Header File
+#include <Windows.h>
+
+//Include C/C++ Header File
+#include <vector>
+
+using namespace std;
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSAEVENTLOOP_API	__declspec(dllexport)
+#else
+#define ROSAEVENTLOOP_API	__declspec(dllimport)
+#endif
+
+#define ROSAEVENTLOOP_CALLMODE	__stdcall
+
+#define ROSA_LOOP_MAX_THREADS		64				//¼ѭ߳
+#define ROSA_LOOP_BATCH_ENTRIES		64				//ÿȡصɰ
+#define ROSA_LOOP_TICK_MSEC			10				//ʱ(, ʱһ)
+
+#define ROSA_LOOP_WHEEL_BITS0		8				//ʱֵ0λλ(256)
+#define ROSA_LOOP_WHEEL_BITSN		6				//ʱֵ1~3λλ(ÿ64)
+#define ROSA_LOOP_WHEEL_LEVELS		4				//ʱֲ(2^26, ԶĶʱ߲Ŷ)
+#define ROSA_LOOP_WHEEL_SIZE0		(1 << ROSA_LOOP_WHEEL_BITS0)
+#define ROSA_LOOP_WHEEL_SIZEN		(1 << ROSA_LOOP_WHEEL_BITSN)
+#define ROSA_LOOP_WHEEL_SLOTS		(ROSA_LOOP_WHEEL_SIZE0 + (ROSA_LOOP_WHEEL_LEVELS - 1) * ROSA_LOOP_WHEEL_SIZEN)
+#define ROSA_LOOP_WHEEL_EXPIRED		ROSA_LOOP_WHEEL_SLOTS	//ѵڴص
+#define ROSA_LOOP_TIMER_NIL			((UINT)-1)		//նʱ
+
+#define ROSA_LOOP_KEY_EXIT			((ULONG_PTR)-1)	//˳ɰ
+#define ROSA_LOOP_KEY_POST			((ULONG_PTR)0)	//Ͷɰ
+
+//Struct Definition
+typedef struct _S_ROSAOVERLAPPED S_ROSAOVERLAPPED, *LPS_ROSAOVERLAPPED;
+
+//Callback Definition
+typedef void(__stdcall *HANDLE_COMPLETION_CALLBACK)(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError);	//ɻص
+typedef void(__stdcall *HANDLE_TIMER_CALLBACK)(ULONGLONG ullTimerID, void* pUser);								//嶨ʱص
+
+struct _S_ROSAOVERLAPPED
+{
+	OVERLAPPED Overlapped;					// صṹ(λλ)
+	HANDLE_COMPLETION_CALLBACK pCallback;	// ɻص
+	void* pUser;							// û
+};
+
+typedef struct
+{
+	ULONGLONG ullExpire;					// ڽ
+	DWORD dwPeriod;							// ظ(, 0ʾ)
+	HANDLE_TIMER_CALLBACK pCallback;		// ʱص
+	void* pUser;							// û
+	DWORD dwGeneration;						// (ɶʱID, ͷź)
+	UINT uiSlot;							// ڲλ(ROSA_LOOP_TIMER_NILʾ)
+	UINT uiPrev;							// ǰһʱ
+	UINT uiNext;							// ںһʱ(ʱָһжʱ)
+}S_LOOPTIMER, *LPS_LOOPTIMER;
+
+//Class Definition
+class ROSAEVENTLOOP_API CRosaEventLoop
+{
+public:
+	CRosaEventLoop();			// CRosaEventLoop 캯
+	~CRosaEventLoop();			// CRosaEventLoop 
+
+public:
+	bool ROSAEVENTLOOP_CALLMODE CRosaEventLoopCreate(USHORT nThreads = 1, bool bAffinity = false);		// CRosaEventLoop ɶ˿ڼ߳
+	void ROSAEVENTLOOP_CALLMODE CRosaEventLoopDestroy();												// CRosaEventLoop ֹ̲ͣ߳رɶ˿
+
+	bool ROSAEVENTLOOP_CALLMODE CRosaEventLoopAttach(HANDLE hHandle);									// CRosaEventLoop (SOCKET/)
+	bool ROSAEVENTLOOP_CALLMODE CRosaEventLoopPost(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes = 0);	// CRosaEventLoop Ͷɰ(ѭ߳лص)
+
+	ULONGLONG ROSAEVENTLOOP_CALLMODE CRosaEventLoopSetTimer(DWORD dwDelayMSec, DWORD dwPeriodMSec, HANDLE_TIMER_CALLBACK pCallback, void* pUser);	// CRosaEventLoop öʱ
+	bool ROSAEVENTLOOP_CALLMODE CRosaEventLoopKillTimer(ULONGLONG ullTimerID);							// CRosaEventLoop ɾʱ(غصִ)
+	bool ROSAEVENTLOOP_CALLMODE CRosaEventLoopResetTimer(ULONGLONG ullTimerID, DWORD dwDelayMSec);		// CRosaEventLoop õʱ(гʱÿշ)
+	UINT ROSAEVENTLOOP_CALLMODE CRosaEventLoopGetTimerCount();											// CRosaEventLoop ȡʱ
+
+	HANDLE ROSAEVENTLOOP_CALLMODE CRosaEventLoopGetHandle() const;										// CRosaEventLoop ȡɶ˿ھ
+	USHORT ROSAEVENTLOOP_CALLMODE CRosaEventLoopGetThreadCount() const;									// CRosaEventLoop ȡ߳
+	bool ROSAEVENTLOOP_CALLMODE CRosaEventLoopIsRunning() const;										// CRosaEventLoop ȡ״̬
+
+	static ULONGLONG ROSAEVENTLOOP_CALLMODE CRosaEventLoopGetTickMSec();								// CRosaEventLoop ȡǰʱ()
+
+private:
+	static unsigned __stdcall OnLoopThread(void* pParam);		// CRosaEventLoop ѭ߳
+	void ProcessTimers();										// CRosaEventLoop ڶʱ
+	UINT FindTimer(ULONGLONG ullTimerID) const;					// CRosaEventLoop ʱIDתΪ(߳m_csTimer)
+	void ScheduleTimer(UINT uiIndex);							// CRosaEventLoop ڽķʱ(߳m_csTimer)
+	void InsertTimer(UINT uiIndex, UINT uiSlot);				// CRosaEventLoop λ(߳m_csTimer)
+	void UnlinkTimer(UINT uiIndex);								// CRosaEventLoop Ƴλ(߳m_csTimer)
+	void FreeTimer(UINT uiIndex);								// CRosaEventLoop ͷŶʱ(߳m_csTimer)
+	void CascadeTimers(UINT uiSlot);							// CRosaEventLoop ߲λͲ(߳m_csTimer)
+
+private:
+	HANDLE m_hIOCP;								// CRosaEventLoop ɶ˿
+	HANDLE m_hThreads[ROSA_LOOP_MAX_THREADS];	// CRosaEventLoop ѭ߳̾
+	DWORD m_dwThreadIDs[ROSA_LOOP_MAX_THREADS];	// CRosaEventLoop ѭ߳ID
+	USHORT m_nThreads;							// CRosaEventLoop ѭ߳
+	volatile bool m_bRunning;					// CRosaEventLoop б־
+
+// ʱԱ
+private:
+	CRITICAL_SECTION m_csTimer;							// CRosaEventLoop ʱٽ
+	vector<S_LOOPTIMER> m_vecTimer;						// CRosaEventLoop ʱ(->ʱ)
+	UINT m_uiTimerFree;									// CRosaEventLoop жʱ
+	UINT m_uiTimerCount;								// CRosaEventLoop ʹеĶʱ
+	UINT m_uiWheel[ROSA_LOOP_WHEEL_SLOTS + 1];			// CRosaEventLoop ʱֲλ(һΪѵ)
+	ULONGLONG m_ullWheelTick;							// CRosaEventLoop һĽ
+	volatile ULONGLONG m_ullFiringTimerID;				// CRosaEventLoop ڻصĶʱID
+
+};
+
+#endif // !__CROSAEVENTLOOP_H__
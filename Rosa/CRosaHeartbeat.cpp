@@ -0,0 +1,433 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaHeartbeat.cpp
+* @brief	This File is RosaHeartbeat Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaHeartbeat.h"
+#include "CThreadSafe.h"
+
+//CRosaHeartbeat (ʱ, ڷֲ)
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHeartbeat()
+// @Purpose: CRosaHeartbeat캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaHeartbeat::CRosaHeartbeat()
+{
+	m_pLoop = NULL;
+	m_ullTickTimerID = 0;
+
+	m_pDeadCallback = NULL;
+	m_pPingCallback = NULL;
+	m_dwUser = 0;
+
+	m_dwIntervalMSec = ROSA_HEARTBEAT_INTERVAL_MSEC;
+	m_dwTimeOutMSec = ROSA_HEARTBEAT_TIMEOUT_MSEC;
+	m_dwTickMSec = ROSA_HEARTBEAT_TICK_MSEC;
+
+	memset(m_chPing, 0, sizeof(m_chPing));
+	m_uiPingSize = 0;
+
+	m_ullTick = 0;
+	m_ullPingCount = 0;
+
+	InitializeCriticalSection(&m_csHeartbeat);
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaHeartbeat()
+// @Purpose: CRosaHeartbeat
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaHeartbeat::~CRosaHeartbeat()
+{
+	CRosaHeartbeatDestroy();
+
+	DeleteCriticalSection(&m_csHeartbeat);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHeartbeatCreate()
+// @Purpose: CRosaHeartbeat¼ѭʼ
+// @Since: v1.00a
+// @Para: CRosaEventLoop* pLoop(Ѿ¼ѭ, ص䶨ʱִ߳)
+// @Para: HANDLE_HEARTBEAT_DEAD_CALLBACK pDeadCallback(ԶʧЧص)
+// @Para: DWORD_PTR dwUser(û)
+// @Para: DWORD dwIntervalMSec()
+// @Para: DWORD dwTimeOutMSec(Ӧʱ, һյݺ󾭹+ӦʱжʧЧ)
+// @Para: DWORD dwTickMSec(, ж)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSAHEARTBEAT_CALLMODE CRosaHeartbeat::CRosaHeartbeatCreate(CRosaEventLoop * pLoop, HANDLE_HEARTBEAT_DEAD_CALLBACK pDeadCallback, DWORD_PTR dwUser, DWORD dwIntervalMSec, DWORD dwTimeOutMSec, DWORD dwTickMSec)
+{
+	if (m_pLoop != NULL || pLoop == NULL || pDeadCallback == NULL || dwIntervalMSec == 0 || dwTickMSec == 0)
+	{
+		return false;
+	}
+
+	m_pDeadCallback = pDeadCallback;
+	m_dwUser = dwUser;
+
+	m_dwIntervalMSec = dwIntervalMSec;
+	m_dwTimeOutMSec = dwTimeOutMSec;
+	m_dwTickMSec = dwTickMSec;
+
+	// һμʱ+Ӧʱ֮󣬲λǸ÷ΧɲȦ
+	m_vecSlot.clear();
+	m_vecSlot.resize((dwIntervalMSec + dwTimeOutMSec) / dwTickMSec + 2);
+
+	m_ullTick = CRosaEventLoop::CRosaEventLoopGetTickMSec() / m_dwTickMSec;
+	m_ullPingCount = 0;
+
+	m_pLoop = pLoop;
+
+	m_ullTickTimerID = m_pLoop->CRosaEventLoopSetTimer(m_dwTickMSec, m_dwTickMSec, OnTickTimer, this);
+	if (m_ullTickTimerID == 0)
+	{
+		m_pLoop = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHeartbeatDestroy()
+// @Purpose: CRosaHeartbeatֹͣ鲢Ƴȫ(ر׽)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSAHEARTBEAT_CALLMODE CRosaHeartbeat::CRosaHeartbeatDestroy()
+{
+	if (m_pLoop == NULL)
+	{
+		return;
+	}
+
+	// ȴִеļ
+	m_pLoop->CRosaEventLoopKillTimer(m_ullTickTimerID);
+	m_ullTickTimerID = 0;
+
+	CThreadSafe ThreadSafe(&m_csHeartbeat);
+
+	// ÿ(Ƴδͷŵ)λĳλ
+	for (vector<vector<LPS_HEARTBEAT>>::iterator iter = m_vecSlot.begin(); iter != m_vecSlot.end(); ++iter)
+	{
+		for (vector<LPS_HEARTBEAT>::iterator it = iter->begin(); it != iter->end(); ++it)
+		{
+			delete *it;
+		}
+	}
+
+	m_vecSlot.clear();
+	m_vecDue.clear();
+	m_mapConn.clear();
+
+	m_pLoop = NULL;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHeartbeatSetPingFrame()
+// @Purpose: CRosaHeartbeatping֡(дӵķͶ, ҵ֡֡; ûзͶеʹpingص)
+// @Since: v1.00a
+// @Para: const char* pPing(ping֡)
+// @Para: UINT uiSize(ping֡, ROSA_HEARTBEAT_FRAME_SIZE)
+// @Return: bool bRet (true:ɹ, false:֡)
+//------------------------------------------------------------------
+bool ROSAHEARTBEAT_CALLMODE CRosaHeartbeat::CRosaHeartbeatSetPingFrame(const char * pPing, UINT uiSize)
+{
+	if (uiSize > ROSA_HEARTBEAT_FRAME_SIZE || (pPing == NULL && uiSize > 0))
+	{
+		return false;
+	}
+
+	CThreadSafe ThreadSafe(&m_csHeartbeat);
+
+	if (uiSize > 0)
+	{
+		memcpy(m_chPing, pPing, uiSize);
+	}
+
+	m_uiPingSize = uiSize;
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHeartbeatSetPingCallback()
+// @Purpose: CRosaHeartbeat÷pingص(úֱӷping֡)
+// @Since: v1.00a
+// @Para: HANDLE_HEARTBEAT_PING_CALLBACK pPingCallback(pingص, NULLʾping֡ӵķͶз)
+// @Return: None
+//------------------------------------------------------------------
+void ROSAHEARTBEAT_CALLMODE CRosaHeartbeat::CRosaHeartbeatSetPingCallback(HANDLE_HEARTBEAT_PING_CALLBACK pPingCallback)
+{
+	CThreadSafe ThreadSafe(&m_csHeartbeat);
+
+	m_pPingCallback = pPingCallback;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHeartbeatAdd()
+// @Purpose: CRosaHeartbeatʼ(ڼʱ¼ʱ)
+// @Since: v1.00a
+// @Para: SOCKET s(ӵ׽)
+// @Para: CRosaSendQueue* pSendQueue(ӵķͶ, δpingصʱping֡дö; NULLʱping֡, Ƴ֮)
+// @Return: bool bRet (true:ɹ, false:δ)
+//------------------------------------------------------------------
+bool ROSAHEARTBEAT_CALLMODE CRosaHeartbeat::CRosaHeartbeatAdd(SOCKET s, CRosaSendQueue* pSendQueue)
+{
+	ULONGLONG ullNow = CRosaEventLoop::CRosaEventLoopGetTickMSec();
+
+	CThreadSafe ThreadSafe(&m_csHeartbeat);
+
+	if (m_pLoop == NULL)
+	{
+		return false;
+	}
+
+	map<SOCKET, LPS_HEARTBEAT>::iterator iter = m_mapConn.find(s);
+	if (iter != m_mapConn.end())
+	{
+		iter->second->ullLastRecv = ullNow;
+		iter->second->ullLastSend = ullNow;
+		iter->second->pSendQueue = pSendQueue;
+		return true;
+	}
+
+	LPS_HEARTBEAT pConn = new S_HEARTBEAT;
+	pConn->Socket = s;
+	pConn->ullLastRecv = ullNow;
+	pConn->ullLastSend = ullNow;
+	pConn->pSendQueue = pSendQueue;
+	pConn->bRemoved = false;
+
+	m_mapConn.insert(pair<SOCKET, LPS_HEARTBEAT>(s, pConn));
+	ScheduleConn(pConn);
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHeartbeatRemove()
+// @Purpose: CRosaHeartbeatֹͣ(غٶԸ׽ַpingص)
+// @Since: v1.00a
+// @Para: SOCKET s(׽)
+// @Return: bool bRet (true:ɹ, false:ڼ)
+//------------------------------------------------------------------
+bool ROSAHEARTBEAT_CALLMODE CRosaHeartbeat::CRosaHeartbeatRemove(SOCKET s)
+{
+	CThreadSafe ThreadSafe(&m_csHeartbeat);
+
+	map<SOCKET, LPS_HEARTBEAT>::iterator iter = m_mapConn.find(s);
+	if (iter == m_mapConn.end())
+	{
+		return false;
+	}
+
+	// λеĽڵڴʱͷ
+	iter->second->bRemoved = true;
+	m_mapConn.erase(iter);
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHeartbeatNotifyRecv()
+// @Purpose: CRosaHeartbeatյ(ֻʱ, ʱŶ)
+// @Since: v1.00a
+// @Para: SOCKET s(׽)
+// @Return: None
+//------------------------------------------------------------------
+void ROSAHEARTBEAT_CALLMODE CRosaHeartbeat::CRosaHeartbeatNotifyRecv(SOCKET s)
+{
+	ULONGLONG ullNow = CRosaEventLoop::CRosaEventLoopGetTickMSec();
+
+	CThreadSafe ThreadSafe(&m_csHeartbeat);
+
+	map<SOCKET, LPS_HEARTBEAT>::iterator iter = m_mapConn.find(s);
+	if (iter != m_mapConn.end())
+	{
+		iter->second->ullLastRecv = ullNow;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHeartbeatNotifySend()
+// @Purpose: CRosaHeartbeatҵ(Զ˾ݴȷϱ˴, ڲٷping)
+// @Since: v1.00a
+// @Para: SOCKET s(׽)
+// @Return: None
+//------------------------------------------------------------------
+void ROSAHEARTBEAT_CALLMODE CRosaHeartbeat::CRosaHeartbeatNotifySend(SOCKET s)
+{
+	ULONGLONG ullNow = CRosaEventLoop::CRosaEventLoopGetTickMSec();
+
+	CThreadSafe ThreadSafe(&m_csHeartbeat);
+
+	map<SOCKET, LPS_HEARTBEAT>::iterator iter = m_mapConn.find(s);
+	if (iter != m_mapConn.end())
+	{
+		iter->second->ullLastSend = ullNow;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHeartbeatGetCount()
+// @Purpose: CRosaHeartbeatȡе
+// @Since: v1.00a
+// @Para: None
+// @Return: UINT uiCount
+//------------------------------------------------------------------
+UINT ROSAHEARTBEAT_CALLMODE CRosaHeartbeat::CRosaHeartbeatGetCount()
+{
+	CThreadSafe ThreadSafe(&m_csHeartbeat);
+
+	return (UINT)m_mapConn.size();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHeartbeatGetPingCount()
+// @Purpose: CRosaHeartbeatȡѷ͵ping(ӴĲ)
+// @Since: v1.00a
+// @Para: None
+// @Return: ULONGLONG ullCount
+//------------------------------------------------------------------
+ULONGLONG ROSAHEARTBEAT_CALLMODE CRosaHeartbeat::CRosaHeartbeatGetPingCount()
+{
+	CThreadSafe ThreadSafe(&m_csHeartbeat);
+
+	return m_ullPingCount;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ScheduleConn()
+// @Purpose: CRosaHeartbeatһҪpingжʧЧʱλ
+// @Since: v1.00a
+// @Para: LPS_HEARTBEAT pConn()
+// @Return: None
+//------------------------------------------------------------------
+void CRosaHeartbeat::ScheduleConn(LPS_HEARTBEAT pConn)
+{
+	ULONGLONG ullDue = min(pConn->ullLastSend + m_dwIntervalMSec, pConn->ullLastRecv + m_dwIntervalMSec + m_dwTimeOutMSec);
+	ULONGLONG ullDueTick = (ullDue + m_dwTickMSec - 1) / m_dwTickMSec;
+	ULONGLONG ullSlots = (ULONGLONG)m_vecSlot.size();
+
+	// Ѿڵķһڣ׷ϻѹʱΧǰ
+	ullDueTick = max(ullDueTick, m_ullTick);
+	ullDueTick = min(ullDueTick, m_ullTick + ullSlots - 1);
+
+	m_vecSlot[(size_t)(ullDueTick % ullSlots)].push_back(pConn);
+}
+
+//------------------------------------------------------------------
+// @Function:	 ProcessTick()
+// @Purpose: CRosaHeartbeatڲλ(ping֡д뷢Ͷ, ص)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaHeartbeat::ProcessTick()
+{
+	ULONGLONG ullNow = CRosaEventLoop::CRosaEventLoopGetTickMSec();
+	ULONGLONG ullNowTick = ullNow / m_dwTickMSec;
+
+	vector<SOCKET> vecPing;
+	vector<SOCKET> vecDead;
+
+	HANDLE_HEARTBEAT_PING_CALLBACK pPingCallback = NULL;
+
+	EnterCriticalSection(&m_csHeartbeat);
+
+	pPingCallback = m_pPingCallback;
+
+	while (m_ullTick <= ullNowTick && !m_vecSlot.empty())
+	{
+		// ȡǰλ(ߵ)
+		m_vecDue.clear();
+		m_vecDue.swap(m_vecSlot[(size_t)(m_ullTick % m_vecSlot.size())]);
+		m_ullTick++;
+
+		for (vector<LPS_HEARTBEAT>::iterator iter = m_vecDue.begin(); iter != m_vecDue.end(); ++iter)
+		{
+			LPS_HEARTBEAT pConn = *iter;
+
+			if (pConn->bRemoved)
+			{
+				delete pConn;
+				continue;
+			}
+
+			// +Ӧʱûյκ
+			if (ullNow - pConn->ullLastRecv >= (ULONGLONG)m_dwIntervalMSec + m_dwTimeOutMSec)
+			{
+				vecDead.push_back(pConn->Socket);
+				m_mapConn.erase(pConn->Socket);
+				delete pConn;
+				continue;
+			}
+
+			// ûз͹ʱping(ҵʱӴ)
+			if (ullNow - pConn->ullLastSend >= m_dwIntervalMSec)
+			{
+				if (pPingCallback != NULL)
+				{
+					vecPing.push_back(pConn->Socket);
+					m_ullPingCount++;
+				}
+				else if (m_uiPingSize > 0 && pConn->pSendQueue != NULL)
+				{
+					// Ͷ֡, ҵ֡м; д벻ص, дƳؼʹøö
+					if (pConn->pSendQueue->CRosaSendQueuePost(m_chPing, m_uiPingSize) == SOB_RET_OK)
+					{
+						m_ullPingCount++;
+					}
+				}
+
+				pConn->ullLastSend = ullNow;
+			}
+
+			ScheduleConn(pConn);
+		}
+	}
+
+	LeaveCriticalSection(&m_csHeartbeat);
+
+	// ͬһڵpingʧЧص
+	for (vector<SOCKET>::iterator iter = vecPing.begin(); iter != vecPing.end(); ++iter)
+	{
+		pPingCallback(*iter, m_dwUser);
+	}
+
+	for (vector<SOCKET>::iterator iter = vecDead.begin(); iter != vecDead.end(); ++iter)
+	{
+		m_pDeadCallback(*iter, m_dwUser);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnTickTimer()
+// @Purpose: CRosaHeartbeat鶨ʱ(¼ѭʱִ߳)
+// @Since: v1.00a
+// @Para: ULONGLONG ullTimerID(ʱID)
+// @Para: void* pUser(CRosaHeartbeat)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaHeartbeat::OnTickTimer(ULONGLONG ullTimerID, void * pUser)
+{
+	CRosaHeartbeat* pHeartbeat = reinterpret_cast<CRosaHeartbeat*>(pUser);
+
+	pHeartbeat->ProcessTick();
+}
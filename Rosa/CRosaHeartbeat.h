@@ -0,0 +1,108 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaHeartbeat.h
+* @brief	This File is RosaHeartbeat Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSAHEARTBEAT_H__
+#define __CROSAHEARTBEAT_H__
+
+//Include Rosa Header File
+#include "CRosaSocket.h"
+#include "CRosaEventLoop.h"
+#include "CRosaSendQueue.h"
+
+//Include C/C++ Header File
+#include <map>
+#include <vector>
+
+using namespace std;
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSAHEARTBEAT_API	__declspec(dllexport)
+#else
+#define ROSAHEARTBEAT_API	__declspec(dllimport)
+#endif
+
+#define ROSAHEARTBEAT_CALLMODE	__stdcall
+
+#define ROSA_HEARTBEAT_INTERVAL_MSEC	5000			//(, ʱûзʱping)
+#define ROSA_HEARTBEAT_TIMEOUT_MSEC		5000			//Ӧʱ(, ֮ûյκݼжʧЧ)
+#define ROSA_HEARTBEAT_TICK_MSEC		100				//(, ͬһڵڵ)
+#define ROSA_HEARTBEAT_FRAME_SIZE		64				//ping֡󳤶
+
+//Callback Definition
+typedef void(__stdcall *HANDLE_HEARTBEAT_PING_CALLBACK)(SOCKET s, DWORD_PTR dwUser);		//巢pingص(Ӧð֡ʽ, δʱping֡ӵķͶз)
+typedef void(__stdcall *HANDLE_HEARTBEAT_DEAD_CALLBACK)(SOCKET s, DWORD_PTR dwUser);		//ԶʧЧص(ֹͣ, Ӧùر)
+
+//Struct Definition
+typedef struct
+{
+	SOCKET Socket;							// ׽
+	ULONGLONG ullLastRecv;					// յݵʱ()
+	ULONGLONG ullLastSend;					// ݵʱ(, ping)
+	CRosaSendQueue* pSendQueue;				// ӵķͶ(ping֡֡, ҵ֡; NULLʱֻʹpingص)
+	bool bRemoved;							// ǷѾƳ(ڲλʱͷ)
+}S_HEARTBEAT, *LPS_HEARTBEAT;
+
+//Class Definition
+class ROSAHEARTBEAT_API CRosaHeartbeat
+{
+public:
+	CRosaHeartbeat();			// CRosaHeartbeat 캯
+	~CRosaHeartbeat();			// CRosaHeartbeat 
+
+public:
+	bool ROSAHEARTBEAT_CALLMODE CRosaHeartbeatCreate(CRosaEventLoop* pLoop, HANDLE_HEARTBEAT_DEAD_CALLBACK pDeadCallback, DWORD_PTR dwUser, DWORD dwIntervalMSec = ROSA_HEARTBEAT_INTERVAL_MSEC, DWORD dwTimeOutMSec = ROSA_HEARTBEAT_TIMEOUT_MSEC, DWORD dwTickMSec = ROSA_HEARTBEAT_TICK_MSEC);	// CRosaHeartbeat ¼ѭʼ
+	void ROSAHEARTBEAT_CALLMODE CRosaHeartbeatDestroy();								// CRosaHeartbeat ֹͣ鲢Ƴȫ
+
+	bool ROSAHEARTBEAT_CALLMODE CRosaHeartbeatSetPingFrame(const char* pPing, UINT uiSize);	// CRosaHeartbeat ping֡(ӵķͶз)
+	void ROSAHEARTBEAT_CALLMODE CRosaHeartbeatSetPingCallback(HANDLE_HEARTBEAT_PING_CALLBACK pPingCallback);	// CRosaHeartbeat ÷pingص(ҵݹ÷ʱʹ)
+
+	bool ROSAHEARTBEAT_CALLMODE CRosaHeartbeatAdd(SOCKET s, CRosaSendQueue* pSendQueue = NULL);	// CRosaHeartbeat ʼ(pSendQueueΪӵķͶ, ڷping֡)
+	bool ROSAHEARTBEAT_CALLMODE CRosaHeartbeatRemove(SOCKET s);							// CRosaHeartbeat ֹͣ(ر׽֮ǰ)
+	void ROSAHEARTBEAT_CALLMODE CRosaHeartbeatNotifyRecv(SOCKET s);						// CRosaHeartbeat յ(pong, ƳʧЧж)
+	void ROSAHEARTBEAT_CALLMODE CRosaHeartbeatNotifySend(SOCKET s);						// CRosaHeartbeat ҵ(Ӵ, Ƴһping)
+
+	UINT ROSAHEARTBEAT_CALLMODE CRosaHeartbeatGetCount();								// CRosaHeartbeat ȡе
+	ULONGLONG ROSAHEARTBEAT_CALLMODE CRosaHeartbeatGetPingCount();						// CRosaHeartbeat ȡѷ͵ping
+
+private:
+	void ScheduleConn(LPS_HEARTBEAT pConn);												// CRosaHeartbeat һμʱλ(߳m_csHeartbeat)
+	void ProcessTick();																	// CRosaHeartbeat ڲλ(ping, صʧЧ)
+
+	static void __stdcall OnTickTimer(ULONGLONG ullTimerID, void* pUser);				// CRosaHeartbeat 鶨ʱ
+
+private:
+	CRosaEventLoop* m_pLoop;								// CRosaHeartbeat ¼ѭ
+	ULONGLONG m_ullTickTimerID;								// CRosaHeartbeat 鶨ʱ
+
+	HANDLE_HEARTBEAT_DEAD_CALLBACK m_pDeadCallback;			// CRosaHeartbeat ԶʧЧص
+	HANDLE_HEARTBEAT_PING_CALLBACK m_pPingCallback;			// CRosaHeartbeat pingص
+	DWORD_PTR m_dwUser;										// CRosaHeartbeat û
+
+	DWORD m_dwIntervalMSec;									// CRosaHeartbeat 
+	DWORD m_dwTimeOutMSec;									// CRosaHeartbeat Ӧʱ
+	DWORD m_dwTickMSec;										// CRosaHeartbeat 
+
+	char m_chPing[ROSA_HEARTBEAT_FRAME_SIZE];				// CRosaHeartbeat ping֡
+	UINT m_uiPingSize;										// CRosaHeartbeat ping֡
+
+	CRITICAL_SECTION m_csHeartbeat;							// CRosaHeartbeat ٽ
+	map<SOCKET, LPS_HEARTBEAT> m_mapConn;					// CRosaHeartbeat е
+	vector<vector<LPS_HEARTBEAT>> m_vecSlot;				// CRosaHeartbeat λ(ÿһ)
+	vector<LPS_HEARTBEAT> m_vecDue;							// CRosaHeartbeat ڴĲλ
+	ULONGLONG m_ullTick;									// CRosaHeartbeat һļ
+	ULONGLONG m_ullPingCount;								// CRosaHeartbeat ѷ͵ping
+
+};
+
+#endif // !__CROSAHEARTBEAT_H__
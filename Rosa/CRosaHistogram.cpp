@@ -0,0 +1,561 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaHistogram.cpp
+* @brief	This File is RosaHistogram Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaHistogram.h"
+
+//Include C/C++ Header File
+#include <vector>
+
+using namespace std;
+
+//CRosaHistogram ӳֱͼ(ֶϸ, ֲ¼, ȡʱϲ)
+
+// ÿܼӦ
+static double GetNanoPerCount()
+{
+	LARGE_INTEGER liFrequency;
+	QueryPerformanceFrequency(&liFrequency);
+
+	return 1000000000.0 / (double)liFrequency.QuadPart;
+}
+
+double CRosaHistogram::s_dNanoPerCount = GetNanoPerCount();
+volatile bool CRosaHistogram::s_bGlobalEnabled = false;
+
+// ȫͳ(״οʱ)
+static CRosaHistogram g_GlobalHistogram[ROSA_HISTOGRAM_OP_COUNT];
+static volatile LONG g_lGlobalState = 0;		// 0:δ, 1:ڷ, 2:ѷ
+
+// ͳ
+static const char* g_pcOpName[ROSA_HISTOGRAM_OP_COUNT] = { "connect", "send", "recv", "accept_first_byte", "serial_write" };
+
+// ׷һе(ռ䲻ʱд)
+static bool AppendLine(char* pBuffer, UINT uiBufferSize, UINT& uiLength, const char* pcLine)
+{
+	UINT uiLine = (UINT)strlen(pcLine);
+
+	if (uiLength + uiLine + 1 > uiBufferSize)
+	{
+		return false;
+	}
+
+	memcpy(pBuffer + uiLength, pcLine, uiLine);
+	uiLength += uiLine;
+	pBuffer[uiLength] = '\0';
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHistogram()
+// @Purpose: CRosaHistogram캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaHistogram::CRosaHistogram()
+{
+	m_pCounts = NULL;
+	m_uiSlotMask = 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaHistogram()
+// @Purpose: CRosaHistogram
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaHistogram::~CRosaHistogram()
+{
+	CRosaHistogramDestroy();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHistogramCreate()
+// @Purpose: CRosaHistogramͰ
+// @Since: v1.00a
+// @Para: UINT uiSlots(ֲ, ȡΪ2, ÿROSA_HISTOGRAM_BUCKETS64λ)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSAHISTOGRAM_CALLMODE CRosaHistogram::CRosaHistogramCreate(UINT uiSlots)
+{
+	if (m_pCounts != NULL || uiSlots == 0 || uiSlots > 64)
+	{
+		return false;
+	}
+
+	UINT uiPower = 1;
+	while (uiPower < uiSlots)
+	{
+		uiPower <<= 1;
+	}
+
+	m_pCounts = new (std::nothrow) ULONGLONG[uiPower * ROSA_HISTOGRAM_BUCKETS];
+	if (m_pCounts == NULL)
+	{
+		return false;
+	}
+
+	memset(m_pCounts, 0, sizeof(ULONGLONG) * uiPower * ROSA_HISTOGRAM_BUCKETS);
+	m_uiSlotMask = uiPower - 1;
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHistogramDestroy()
+// @Purpose: CRosaHistogramͷżͰ(û߳ڼ¼)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSAHISTOGRAM_CALLMODE CRosaHistogram::CRosaHistogramDestroy()
+{
+	if (m_pCounts != NULL)
+	{
+		delete[] m_pCounts;
+		m_pCounts = NULL;
+	}
+
+	m_uiSlotMask = 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHistogramRecord()
+// @Purpose: CRosaHistogram¼һֵ(, һλɨһԭӼ)
+// @Since: v1.00a
+// @Para: ULONGLONG ullNanoSec(ʱ, )
+// @Return: None
+//------------------------------------------------------------------
+void ROSAHISTOGRAM_CALLMODE CRosaHistogram::CRosaHistogramRecord(ULONGLONG ullNanoSec)
+{
+	if (m_pCounts == NULL)
+	{
+		return;
+	}
+
+	// ͬһϵֲ̹߳, ռʱԭӼ
+	UINT uiSlot = GetCurrentProcessorNumber() & m_uiSlotMask;
+	InterlockedIncrement64((LONG64 volatile*)&m_pCounts[uiSlot * ROSA_HISTOGRAM_BUCKETS + CRosaHistogramBucketIndex(ullNanoSec)]);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHistogramRecordSince()
+// @Purpose: CRosaHistogram¼llStartڵĺʱ
+// @Since: v1.00a
+// @Para: LONGLONG llStart(CRosaHistogramNowصܼ)
+// @Return: None
+//------------------------------------------------------------------
+void ROSAHISTOGRAM_CALLMODE CRosaHistogram::CRosaHistogramRecordSince(LONGLONG llStart)
+{
+	CRosaHistogramRecord(CRosaHistogramToNanoSec(CRosaHistogramNow() - llStart));
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHistogramSnapshot()
+// @Purpose: CRosaHistogramϲֲۼ
+// @Since: v1.00a
+// @Para: ULONGLONG* pCounts(ϲ, ROSA_HISTOGRAM_BUCKETS)
+// @Para: UINT uiBuckets(pCounts)
+// @Para: bool bReset(ǷͰԭ, ڼļ¼һ)
+// @Return: UINT uiBuckets (дͰ, 0:δ򻺳岻)
+//------------------------------------------------------------------
+UINT ROSAHISTOGRAM_CALLMODE CRosaHistogram::CRosaHistogramSnapshot(ULONGLONG * pCounts, UINT uiBuckets, bool bReset)
+{
+	if (m_pCounts == NULL || pCounts == NULL || uiBuckets < ROSA_HISTOGRAM_BUCKETS)
+	{
+		return 0;
+	}
+
+	memset(pCounts, 0, sizeof(ULONGLONG) * ROSA_HISTOGRAM_BUCKETS);
+
+	for (UINT uiSlot = 0; uiSlot <= m_uiSlotMask; ++uiSlot)
+	{
+		ULONGLONG* pSlot = m_pCounts + uiSlot * ROSA_HISTOGRAM_BUCKETS;
+
+		for (UINT i = 0; i < ROSA_HISTOGRAM_BUCKETS; ++i)
+		{
+			if (pSlot[i] == 0)
+			{
+				continue;
+			}
+
+			pCounts[i] += bReset ? (ULONGLONG)InterlockedExchange64((LONG64 volatile*)&pSlot[i], 0) : pSlot[i];
+		}
+	}
+
+	return ROSA_HISTOGRAM_BUCKETS;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHistogramReset()
+// @Purpose: CRosaHistogram
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSAHISTOGRAM_CALLMODE CRosaHistogram::CRosaHistogramReset()
+{
+	vector<ULONGLONG> vecCounts(ROSA_HISTOGRAM_BUCKETS);
+
+	CRosaHistogramSnapshot(vecCounts.data(), ROSA_HISTOGRAM_BUCKETS, true);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHistogramGetSummary()
+// @Purpose: CRosaHistogramȡ/ֵ/ƽֵ/λ(ΪͰ)
+// @Since: v1.00a
+// @Para: S_HISTOGRAMSUMMARY& sSummary()
+// @Para: bool bReset(Ƿͬʱ)
+// @Return: None
+//------------------------------------------------------------------
+void ROSAHISTOGRAM_CALLMODE CRosaHistogram::CRosaHistogramGetSummary(S_HISTOGRAMSUMMARY & sSummary, bool bReset)
+{
+	vector<ULONGLONG> vecCounts(ROSA_HISTOGRAM_BUCKETS);
+
+	memset(&sSummary, 0, sizeof(sSummary));
+
+	if (CRosaHistogramSnapshot(vecCounts.data(), ROSA_HISTOGRAM_BUCKETS, bReset) == 0)
+	{
+		return;
+	}
+
+	Summarize(vecCounts.data(), sSummary);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHistogramExport()
+// @Purpose: CRosaHistogramΪıJSON(ժҪǿͰ)
+// @Since: v1.00a
+// @Para: char* pBuffer()
+// @Para: UINT uiBufferSize(峤)
+// @Para: int nFormat(ROSA_HISTOGRAM_FORMAT_TEXT/ROSA_HISTOGRAM_FORMAT_JSON)
+// @Para: bool bReset(Ƿͬʱ)
+// @Return: UINT uiLength (д볤, 岻ʱضϵһͰ)
+//------------------------------------------------------------------
+UINT ROSAHISTOGRAM_CALLMODE CRosaHistogram::CRosaHistogramExport(char * pBuffer, UINT uiBufferSize, int nFormat, bool bReset)
+{
+	if (pBuffer == NULL || uiBufferSize == 0)
+	{
+		return 0;
+	}
+
+	pBuffer[0] = '\0';
+
+	vector<ULONGLONG> vecCounts(ROSA_HISTOGRAM_BUCKETS);
+	if (CRosaHistogramSnapshot(vecCounts.data(), ROSA_HISTOGRAM_BUCKETS, bReset) == 0)
+	{
+		return 0;
+	}
+
+	// ͬһݺϲժҪ, 뵼Ͱһ
+	S_HISTOGRAMSUMMARY sSummary;
+	Summarize(vecCounts.data(), sSummary);
+
+	char chLine[256] = { 0 };
+	UINT uiLength = 0;
+	bool bJson = (nFormat == ROSA_HISTOGRAM_FORMAT_JSON);
+
+	sprintf_s(chLine, sizeof(chLine), bJson ? "{\"unit\":\"ns\",\"count\":%llu,\"min\":%llu,\"mean\":%llu,\"p50\":%llu,\"p90\":%llu,\"p99\":%llu,\"p999\":%llu,\"p9999\":%llu,\"max\":%llu,\"buckets\":[" : "count=%llu min=%llu mean=%llu p50=%llu p90=%llu p99=%llu p999=%llu p9999=%llu max=%llu (ns)\n",
+		sSummary.ullCount, sSummary.ullMin, sSummary.ullMean, sSummary.ullP50, sSummary.ullP90, sSummary.ullP99, sSummary.ullP999, sSummary.ullP9999, sSummary.ullMax);
+
+	if (!AppendLine(pBuffer, uiBufferSize, uiLength, chLine))
+	{
+		return uiLength;
+	}
+
+	bool bFirst = true;
+
+	for (UINT i = 0; i < ROSA_HISTOGRAM_BUCKETS; ++i)
+	{
+		if (vecCounts[i] == 0)
+		{
+			continue;
+		}
+
+		if (bJson)
+		{
+			sprintf_s(chLine, sizeof(chLine), "%s[%llu,%llu]", bFirst ? "" : ",", CRosaHistogramBucketUpper(i), vecCounts[i]);
+		}
+		else
+		{
+			sprintf_s(chLine, sizeof(chLine), "%llu\t%llu\n", CRosaHistogramBucketUpper(i), vecCounts[i]);
+		}
+
+		if (!AppendLine(pBuffer, uiBufferSize, uiLength, chLine))
+		{
+			return uiLength;
+		}
+
+		bFirst = false;
+	}
+
+	if (bJson)
+	{
+		AppendLine(pBuffer, uiBufferSize, uiLength, "]}");
+	}
+
+	return uiLength;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHistogramNow()
+// @Purpose: CRosaHistogramȡǰܼ
+// @Since: v1.00a
+// @Para: None
+// @Return: LONGLONG llCount
+//------------------------------------------------------------------
+LONGLONG ROSAHISTOGRAM_CALLMODE CRosaHistogram::CRosaHistogramNow()
+{
+	LARGE_INTEGER liNow;
+	QueryPerformanceCounter(&liNow);
+
+	return liNow.QuadPart;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHistogramToNanoSec()
+// @Purpose: CRosaHistogramܼתΪ
+// @Since: v1.00a
+// @Para: LONGLONG llCount(ܼ)
+// @Return: ULONGLONG ullNanoSec
+//------------------------------------------------------------------
+ULONGLONG ROSAHISTOGRAM_CALLMODE CRosaHistogram::CRosaHistogramToNanoSec(LONGLONG llCount)
+{
+	return (llCount > 0) ? (ULONGLONG)((double)llCount * s_dNanoPerCount) : 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHistogramBucketIndex()
+// @Purpose: CRosaHistogramֵڵͰ(СROSA_HISTOGRAM_LINEARһ¼, ֮ÿ2ϸROSA_HISTOGRAM_SUB_COUNT)
+// @Since: v1.00a
+// @Para: ULONGLONG ullValue(ֵ)
+// @Return: UINT uiIndex
+//------------------------------------------------------------------
+UINT ROSAHISTOGRAM_CALLMODE CRosaHistogram::CRosaHistogramBucketIndex(ULONGLONG ullValue)
+{
+	if (ullValue < ROSA_HISTOGRAM_LINEAR)
+	{
+		return (UINT)ullValue;
+	}
+
+	if (ullValue >> ROSA_HISTOGRAM_MAX_BITS)
+	{
+		return ROSA_HISTOGRAM_BUCKETS - 1;
+	}
+
+	// 32λƽ̨û64λλɨ, ָߵ
+	DWORD dwBit = 0;
+	if (ullValue >> 32)
+	{
+		BitScanReverse(&dwBit, (DWORD)(ullValue >> 32));
+		dwBit += 32;
+	}
+	else
+	{
+		BitScanReverse(&dwBit, (DWORD)ullValue);
+	}
+
+	UINT uiShift = dwBit - ROSA_HISTOGRAM_SUB_BITS;
+	UINT uiSub = (UINT)(ullValue >> uiShift) & (ROSA_HISTOGRAM_SUB_COUNT - 1);
+
+	return ROSA_HISTOGRAM_LINEAR + (dwBit - ROSA_HISTOGRAM_SUB_BITS - 1) * ROSA_HISTOGRAM_SUB_COUNT + uiSub;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHistogramBucketUpper()
+// @Purpose: CRosaHistogramͰϽ(, һͰͬʱиֵ)
+// @Since: v1.00a
+// @Para: UINT uiIndex(Ͱ)
+// @Return: ULONGLONG ullUpper
+//------------------------------------------------------------------
+ULONGLONG ROSAHISTOGRAM_CALLMODE CRosaHistogram::CRosaHistogramBucketUpper(UINT uiIndex)
+{
+	if (uiIndex < ROSA_HISTOGRAM_LINEAR)
+	{
+		return uiIndex;
+	}
+
+	UINT uiGroup = (uiIndex - ROSA_HISTOGRAM_LINEAR) / ROSA_HISTOGRAM_SUB_COUNT;
+	UINT uiSub = (uiIndex - ROSA_HISTOGRAM_LINEAR) % ROSA_HISTOGRAM_SUB_COUNT;
+	UINT uiShift = uiGroup + 1;
+
+	return (((ULONGLONG)(ROSA_HISTOGRAM_SUB_COUNT + uiSub + 1)) << uiShift) - 1;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHistogramEnableGlobal()
+// @Purpose: CRosaHistogram/رȫͳ(״οʱ, ֮ͷ)
+// @Since: v1.00a
+// @Para: bool bEnable(Ƿ)
+// @Return: None
+//------------------------------------------------------------------
+void ROSAHISTOGRAM_CALLMODE CRosaHistogram::CRosaHistogramEnableGlobal(bool bEnable)
+{
+	if (bEnable)
+	{
+		if (InterlockedCompareExchange(&g_lGlobalState, 1, 0) == 0)
+		{
+			for (int i = 0; i < ROSA_HISTOGRAM_OP_COUNT; ++i)
+			{
+				g_GlobalHistogram[i].CRosaHistogramCreate();
+			}
+
+			InterlockedExchange(&g_lGlobalState, 2);
+		}
+
+		// ߳ڷ
+		while (g_lGlobalState != 2)
+		{
+			Sleep(0);
+		}
+	}
+
+	s_bGlobalEnabled = bEnable;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHistogramIsGlobalEnabled()
+// @Purpose: CRosaHistogramȫͳǷ
+// @Since: v1.00a
+// @Para: None
+// @Return: bool bRet
+//------------------------------------------------------------------
+bool ROSAHISTOGRAM_CALLMODE CRosaHistogram::CRosaHistogramIsGlobalEnabled()
+{
+	return s_bGlobalEnabled;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHistogramGetGlobal()
+// @Purpose: CRosaHistogramȡȫͳ
+// @Since: v1.00a
+// @Para: int nOp(ROSA_HISTOGRAM_OP_*)
+// @Return: CRosaHistogram* pHistogram (NULL:ͳЧ; δʱûз, ȡΪ)
+//------------------------------------------------------------------
+CRosaHistogram * ROSAHISTOGRAM_CALLMODE CRosaHistogram::CRosaHistogramGetGlobal(int nOp)
+{
+	if (nOp < 0 || nOp >= ROSA_HISTOGRAM_OP_COUNT)
+	{
+		return NULL;
+	}
+
+	return &g_GlobalHistogram[nOp];
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHistogramRecordGlobal()
+// @Purpose: CRosaHistogram¼ȫͳ(ʱ)ͳ(ʱ)
+// @Since: v1.00a
+// @Para: int nOp(ROSA_HISTOGRAM_OP_*)
+// @Para: LONGLONG llStart(ʼʱܼ, 0ʾʼʱûпͳ)
+// @Para: CRosaHistogram* pLocal(ͳ, ΪNULL)
+// @Return: None
+//------------------------------------------------------------------
+void ROSAHISTOGRAM_CALLMODE CRosaHistogram::CRosaHistogramRecordGlobal(int nOp, LONGLONG llStart, CRosaHistogram * pLocal)
+{
+	if (llStart == 0)
+	{
+		return;
+	}
+
+	ULONGLONG ullNanoSec = CRosaHistogramToNanoSec(CRosaHistogramNow() - llStart);
+
+	if (pLocal != NULL)
+	{
+		pLocal->CRosaHistogramRecord(ullNanoSec);
+	}
+
+	if (s_bGlobalEnabled)
+	{
+		g_GlobalHistogram[nOp].CRosaHistogramRecord(ullNanoSec);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaHistogramGetOpName()
+// @Purpose: CRosaHistogramȡͳ(ʱΪ)
+// @Since: v1.00a
+// @Para: int nOp(ROSA_HISTOGRAM_OP_*)
+// @Return: const char* pcName
+//------------------------------------------------------------------
+const char * ROSAHISTOGRAM_CALLMODE CRosaHistogram::CRosaHistogramGetOpName(int nOp)
+{
+	if (nOp < 0 || nOp >= ROSA_HISTOGRAM_OP_COUNT)
+	{
+		return "";
+	}
+
+	return g_pcOpName[nOp];
+}
+
+//------------------------------------------------------------------
+// @Function:	 Summarize()
+// @Purpose: CRosaHistogramɺϲļժҪ(ΪͰ)
+// @Since: v1.00a
+// @Para: const ULONGLONG* pCounts(ϲļ, ROSA_HISTOGRAM_BUCKETS)
+// @Para: S_HISTOGRAMSUMMARY& sSummary()
+// @Return: None
+//------------------------------------------------------------------
+void CRosaHistogram::Summarize(const ULONGLONG * pCounts, S_HISTOGRAMSUMMARY & sSummary)
+{
+	memset(&sSummary, 0, sizeof(sSummary));
+
+	double dSum = 0.0;
+	bool bFirst = true;
+
+	for (UINT i = 0; i < ROSA_HISTOGRAM_BUCKETS; ++i)
+	{
+		if (pCounts[i] == 0)
+		{
+			continue;
+		}
+
+		ULONGLONG ullLower = (i == 0) ? 0 : CRosaHistogramBucketUpper(i - 1) + 1;
+		ULONGLONG ullUpper = CRosaHistogramBucketUpper(i);
+
+		if (bFirst)
+		{
+			sSummary.ullMin = ullUpper;
+			bFirst = false;
+		}
+
+		sSummary.ullMax = ullUpper;
+		sSummary.ullCount += pCounts[i];
+		dSum += (double)pCounts[i] * (double)(ullLower + ullUpper) / 2.0;
+	}
+
+	if (sSummary.ullCount == 0)
+	{
+		return;
+	}
+
+	sSummary.ullMean = (ULONGLONG)(dSum / (double)sSummary.ullCount);
+
+	// λȡۼ״δﵽĿͰϽ
+	const double dPercent[5] = { 0.5, 0.9, 0.99, 0.999, 0.9999 };
+	ULONGLONG* pResult[5] = { &sSummary.ullP50, &sSummary.ullP90, &sSummary.ullP99, &sSummary.ullP999, &sSummary.ullP9999 };
+
+	ULONGLONG ullCumulative = 0;
+	UINT uiNext = 0;
+
+	for (UINT i = 0; i < ROSA_HISTOGRAM_BUCKETS && uiNext < 5; ++i)
+	{
+		ullCumulative += pCounts[i];
+
+		while (uiNext < 5 && (double)ullCumulative >= dPercent[uiNext] * (double)sSummary.ullCount)
+		{
+			*pResult[uiNext] = CRosaHistogramBucketUpper(i);
+			uiNext++;
+		}
+	}
+}
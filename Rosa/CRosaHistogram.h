@@ -0,0 +1,104 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaHistogram.h
+* @brief	This File is RosaHistogram Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSAHISTOGRAM_H__
+#define __CROSAHISTOGRAM_H__
+
+//Include Windows Header File
+#include <Windows.h>
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSAHISTOGRAM_API	__declspec(dllexport)
+#else
+#define ROSAHISTOGRAM_API	__declspec(dllimport)
+#endif
+
+#define ROSAHISTOGRAM_CALLMODE	__stdcall
+
+#define ROSA_HISTOGRAM_SUB_BITS		5				//ÿ2ϸλ(32, Լ3%)
+#define ROSA_HISTOGRAM_SUB_COUNT	(1 << ROSA_HISTOGRAM_SUB_BITS)
+#define ROSA_HISTOGRAM_LINEAR		(2 << ROSA_HISTOGRAM_SUB_BITS)	//Сڸֵ()һ¼
+#define ROSA_HISTOGRAM_MAX_BITS		36				//¼ֵλ(Լ68, ֵһͰ)
+#define ROSA_HISTOGRAM_BUCKETS		(ROSA_HISTOGRAM_LINEAR + (ROSA_HISTOGRAM_MAX_BITS - ROSA_HISTOGRAM_SUB_BITS - 1) * ROSA_HISTOGRAM_SUB_COUNT)
+#define ROSA_HISTOGRAM_SLOTS		8				//ĬϷֲ(ŷɢд, ȡʱϲ, Ϊ2)
+
+#define ROSA_HISTOGRAM_OP_CONNECT		0			//ͳ:Ӻʱ
+#define ROSA_HISTOGRAM_OP_SEND			1			//ͳ:ͺʱ
+#define ROSA_HISTOGRAM_OP_RECV			2			//ͳ:պʱ(ȴ)
+#define ROSA_HISTOGRAM_OP_FIRSTBYTE		3			//ͳ:ӵյһֽ
+#define ROSA_HISTOGRAM_OP_SERIALWRITE	4			//ͳ:д뵽
+#define ROSA_HISTOGRAM_OP_COUNT			5
+
+#define ROSA_HISTOGRAM_FORMAT_TEXT		0			//ʽ:ı
+#define ROSA_HISTOGRAM_FORMAT_JSON		1			//ʽ:JSON
+
+//Struct Definition
+typedef struct
+{
+	ULONGLONG ullCount;						// ¼
+	ULONGLONG ullMin;						// Сֵ(, ͰϽ)
+	ULONGLONG ullMax;						// ֵ(, ͰϽ)
+	ULONGLONG ullMean;						// ƽֵ(, Ͱֵ)
+	ULONGLONG ullP50;						// 50%λ()
+	ULONGLONG ullP90;						// 90%λ()
+	ULONGLONG ullP99;						// 99%λ()
+	ULONGLONG ullP999;						// 99.9%λ()
+	ULONGLONG ullP9999;						// 99.99%λ()
+}S_HISTOGRAMSUMMARY, *LPS_HISTOGRAMSUMMARY;
+
+//Class Definition
+class ROSAHISTOGRAM_API CRosaHistogram
+{
+public:
+	CRosaHistogram();			// CRosaHistogram 캯
+	~CRosaHistogram();			// CRosaHistogram 
+
+public:
+	bool ROSAHISTOGRAM_CALLMODE CRosaHistogramCreate(UINT uiSlots = ROSA_HISTOGRAM_SLOTS);	// CRosaHistogram Ͱ
+	void ROSAHISTOGRAM_CALLMODE CRosaHistogramDestroy();									// CRosaHistogram ͷżͰ(û߳ڼ¼)
+
+	void ROSAHISTOGRAM_CALLMODE CRosaHistogramRecord(ULONGLONG ullNanoSec);					// CRosaHistogram ¼һֵ(, )
+	void ROSAHISTOGRAM_CALLMODE CRosaHistogramRecordSince(LONGLONG llStart);				// CRosaHistogram ¼llStart(CRosaHistogramNow)ڵĺʱ
+
+	UINT ROSAHISTOGRAM_CALLMODE CRosaHistogramSnapshot(ULONGLONG* pCounts, UINT uiBuckets, bool bReset = false);	// CRosaHistogram ϲֲۼ(bResetΪtrueʱͰԭ)
+	void ROSAHISTOGRAM_CALLMODE CRosaHistogramReset();										// CRosaHistogram 
+	void ROSAHISTOGRAM_CALLMODE CRosaHistogramGetSummary(S_HISTOGRAMSUMMARY& sSummary, bool bReset = false);	// CRosaHistogram ȡ/ֵ/λ
+	UINT ROSAHISTOGRAM_CALLMODE CRosaHistogramExport(char* pBuffer, UINT uiBufferSize, int nFormat = ROSA_HISTOGRAM_FORMAT_TEXT, bool bReset = false);	// CRosaHistogram ΪıJSON(д볤, β0)
+
+	static LONGLONG ROSAHISTOGRAM_CALLMODE CRosaHistogramNow();								// CRosaHistogram ȡǰܼ
+	static ULONGLONG ROSAHISTOGRAM_CALLMODE CRosaHistogramToNanoSec(LONGLONG llCount);		// CRosaHistogram ܼתΪ
+
+	static UINT ROSAHISTOGRAM_CALLMODE CRosaHistogramBucketIndex(ULONGLONG ullValue);		// CRosaHistogram ֵڵͰ
+	static ULONGLONG ROSAHISTOGRAM_CALLMODE CRosaHistogramBucketUpper(UINT uiIndex);		// CRosaHistogram ͰϽ()
+
+	static void ROSAHISTOGRAM_CALLMODE CRosaHistogramEnableGlobal(bool bEnable);			// CRosaHistogram /رȫͳ(״οʱ)
+	static bool ROSAHISTOGRAM_CALLMODE CRosaHistogramIsGlobalEnabled();						// CRosaHistogram ȫͳǷ
+	static CRosaHistogram* ROSAHISTOGRAM_CALLMODE CRosaHistogramGetGlobal(int nOp);			// CRosaHistogram ȡȫͳ(ROSA_HISTOGRAM_OP_*)
+	static void ROSAHISTOGRAM_CALLMODE CRosaHistogramRecordGlobal(int nOp, LONGLONG llStart, CRosaHistogram* pLocal = NULL);	// CRosaHistogram ¼ȫͳƼͳ
+
+	static const char* ROSAHISTOGRAM_CALLMODE CRosaHistogramGetOpName(int nOp);			// CRosaHistogram ȡͳ
+
+private:
+	static void Summarize(const ULONGLONG* pCounts, S_HISTOGRAMSUMMARY& sSummary);		// CRosaHistogram ɺϲļժҪ
+
+private:
+	ULONGLONG* m_pCounts;				// CRosaHistogram Ͱ(ֲ)
+	UINT m_uiSlotMask;					// CRosaHistogram ֲ
+
+	static double s_dNanoPerCount;					// CRosaHistogram ÿܼӦ
+	static volatile bool s_bGlobalEnabled;			// CRosaHistogram ȫͳƿ־
+
+};
+
+#endif // !__CROSAHISTOGRAM_H__
@@ -0,0 +1,1000 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaIOEngine.cpp
+* @brief	This File is RosaIOEngine Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaIOEngine.h"
+#include "CThreadSafe.h"
+
+//CRosaIOEngine շ(Registered I/O, ֧ʱ˵ɶ˿)
+
+//------------------------------------------------------------------
+// @Function:	 CRosaIOEngine()
+// @Purpose: CRosaIOEngine캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaIOEngine::CRosaIOEngine()
+{
+	m_pLoop = NULL;
+	m_nEngine = ROSA_IO_ENGINE_IOCP;
+	m_pRecvCallback = NULL;
+	m_pAcceptCallback = NULL;
+	m_dwUser = 0;
+
+	m_ullNextConnID = 1;
+	m_nRequests = 0;
+	m_nNotifying = 0;
+
+	m_pSliceBuffer = NULL;
+	m_uiSliceCount = 0;
+
+	memset(&m_Rio, 0, sizeof(m_Rio));
+	m_RioBufferID = RIO_INVALID_BUFFERID;
+	m_RioCQ = RIO_INVALID_CQ;
+	memset(&m_RioNotify, 0, sizeof(m_RioNotify));
+	m_uiMaxConnections = ROSA_IO_MAX_CONNECTIONS;
+
+	m_ListenSocket = INVALID_SOCKET;
+	m_pfnAcceptEx = NULL;
+	memset(m_Accept, 0, sizeof(m_Accept));
+
+	InitializeCriticalSection(&m_csIO);
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaIOEngine()
+// @Purpose: CRosaIOEngine
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaIOEngine::~CRosaIOEngine()
+{
+	CRosaIOEngineDestroy();
+
+	DeleteCriticalSection(&m_csIO);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaIOEngineCreate()
+// @Purpose: CRosaIOEngine(仺Ƭ, ѡRIOɶ˿)
+// @Since: v1.00a
+// @Para: CRosaEventLoop* pLoop(¼ѭ)
+// @Para: HANDLE_IO_RECV_CALLBACK pRecvCallback(ݻص, ѭִ߳)
+// @Para: DWORD_PTR dwUser(û)
+// @Para: int nEngine(ROSA_IO_ENGINE_AUTO/RIO/IOCP, ָRIOʱʧ)
+// @Para: UINT uiMaxConnections()
+// @Para: UINT uiSliceCount(Ƭ)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSAIOENGINE_CALLMODE CRosaIOEngine::CRosaIOEngineCreate(CRosaEventLoop * pLoop, HANDLE_IO_RECV_CALLBACK pRecvCallback, DWORD_PTR dwUser, int nEngine, UINT uiMaxConnections, UINT uiSliceCount)
+{
+	if (pLoop == NULL || pRecvCallback == NULL || m_pLoop != NULL || uiMaxConnections == 0 || uiSliceCount == 0)
+	{
+		return false;
+	}
+
+	m_pSliceBuffer = (char*)VirtualAlloc(NULL, (SIZE_T)uiSliceCount * ROSA_IO_SLICE_SIZE, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+	if (m_pSliceBuffer == NULL)
+	{
+		return false;
+	}
+
+	m_uiSliceCount = uiSliceCount;
+	m_vecFreeSlice.reserve(uiSliceCount);
+
+	for (UINT i = uiSliceCount; i > 0; --i)
+	{
+		m_vecFreeSlice.push_back(i - 1);
+	}
+
+	m_pLoop = pLoop;
+	m_pRecvCallback = pRecvCallback;
+	m_dwUser = dwUser;
+	m_uiMaxConnections = uiMaxConnections;
+	m_nEngine = ROSA_IO_ENGINE_IOCP;
+
+	if (nEngine != ROSA_IO_ENGINE_IOCP)
+	{
+		if (InitRio(uiMaxConnections))
+		{
+			m_nEngine = ROSA_IO_ENGINE_RIO;
+		}
+		else if (nEngine == ROSA_IO_ENGINE_RIO)
+		{
+			CRosaIOEngineDestroy();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaIOEngineDestroy()
+// @Purpose: CRosaIOEngineرռȫ, ȴͷעỺ(¼ѭ)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSAIOENGINE_CALLMODE CRosaIOEngine::CRosaIOEngineDestroy()
+{
+	if (m_pLoop == NULL)
+	{
+		return;
+	}
+
+	// ֹͣ, ȴеAcceptExԴ
+	SOCKET sListen = m_ListenSocket;
+	m_ListenSocket = INVALID_SOCKET;
+
+	if (sListen != INVALID_SOCKET)
+	{
+		closesocket(sListen);
+	}
+
+	EnterCriticalSection(&m_csIO);
+
+	while (!m_mapConnection.empty())
+	{
+		LPS_IOCONNECTION pConnection = m_mapConnection.begin()->second;
+		pConnection->bNotified = true;
+		CloseConnection(pConnection);
+	}
+
+	LeaveCriticalSection(&m_csIO);
+
+	// ׽ֹرպԴ, ֮ͷŻ
+	while (m_nRequests > 0 && m_pLoop->CRosaEventLoopIsRunning())
+	{
+		Sleep(1);
+	}
+
+	// ȫɶΪ, ʣһװ֪ͨٴ(1), 1ʾ֪ͨصִ
+	while (m_nNotifying > 1)
+	{
+		Sleep(1);
+	}
+
+	m_nNotifying = 0;
+
+	if (m_RioCQ != RIO_INVALID_CQ)
+	{
+		m_Rio.RIOCloseCompletionQueue(m_RioCQ);
+		m_RioCQ = RIO_INVALID_CQ;
+	}
+
+	if (m_RioBufferID != RIO_INVALID_BUFFERID)
+	{
+		m_Rio.RIODeregisterBuffer(m_RioBufferID);
+		m_RioBufferID = RIO_INVALID_BUFFERID;
+	}
+
+	if (m_pSliceBuffer != NULL)
+	{
+		VirtualFree(m_pSliceBuffer, 0, MEM_RELEASE);
+		m_pSliceBuffer = NULL;
+	}
+
+	m_vecFreeSlice.clear();
+	m_uiSliceCount = 0;
+
+	m_pfnAcceptEx = NULL;
+	m_pAcceptCallback = NULL;
+	m_pRecvCallback = NULL;
+	m_pLoop = NULL;
+	m_nEngine = ROSA_IO_ENGINE_IOCP;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaIOEngineListen()
+// @Purpose: CRosaIOEngine˿(ԤͶݶAcceptEx, յ׽ֿʹRIO)
+// @Since: v1.00a
+// @Para: USHORT sPort(˿)
+// @Para: HANDLE_IO_ACCEPT_CALLBACK pAcceptCallback(ӻص, ΪNULL)
+// @Para: int nBacklog(г)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSAIOENGINE_CALLMODE CRosaIOEngine::CRosaIOEngineListen(USHORT sPort, HANDLE_IO_ACCEPT_CALLBACK pAcceptCallback, int nBacklog)
+{
+	if (m_pLoop == NULL || m_ListenSocket != INVALID_SOCKET)
+	{
+		return false;
+	}
+
+	SOCKET s = WSASocket(AF_INET, SOCK_STREAM, IPPROTO_TCP, NULL, 0, WSA_FLAG_OVERLAPPED);
+	if (s == INVALID_SOCKET)
+	{
+		return false;
+	}
+
+	SOCKADDR_IN addrLocal;
+	memset(&addrLocal, 0, sizeof(addrLocal));
+
+	addrLocal.sin_family = AF_INET;
+	addrLocal.sin_addr.s_addr = htonl(INADDR_ANY);
+	addrLocal.sin_port = htons(sPort);
+
+	if (bind(s, (PSOCKADDR)&addrLocal, sizeof(addrLocal)) == SOCKET_ERROR || listen(s, nBacklog) == SOCKET_ERROR)
+	{
+		closesocket(s);
+		return false;
+	}
+
+	// ȡAcceptExչ
+	GUID guidAcceptEx = WSAID_ACCEPTEX;
+	DWORD dwBytes = 0;
+
+	if (WSAIoctl(s, SIO_GET_EXTENSION_FUNCTION_POINTER, &guidAcceptEx, sizeof(guidAcceptEx), &m_pfnAcceptEx, sizeof(m_pfnAcceptEx), &dwBytes, NULL, NULL) == SOCKET_ERROR ||
+		!m_pLoop->CRosaEventLoopAttach((HANDLE)s))
+	{
+		m_pfnAcceptEx = NULL;
+		closesocket(s);
+		return false;
+	}
+
+	m_pAcceptCallback = pAcceptCallback;
+	m_ListenSocket = s;
+
+	int nPosted = 0;
+
+	for (int i = 0; i < ROSA_IO_ACCEPT_DEPTH; ++i)
+	{
+		memset(&m_Accept[i], 0, sizeof(m_Accept[i]));
+		m_Accept[i].Overlapped.pCallback = OnAcceptComplete;
+		m_Accept[i].Overlapped.pUser = this;
+		m_Accept[i].Socket = INVALID_SOCKET;
+
+		if (PostAccept(&m_Accept[i]))
+		{
+			nPosted++;
+		}
+	}
+
+	if (nPosted == 0)
+	{
+		m_ListenSocket = INVALID_SOCKET;
+		closesocket(s);
+		return false;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaIOEngineAttach()
+// @Purpose: CRosaIOEngineӹӵص׽ֲʼ
+// @Since: v1.00a
+// @Para: SOCKET s(ӵ׽, δɶ˿)
+// @Return: ULONGLONG ullConnID (0:ʧ, ʱ׽ѹر)
+//------------------------------------------------------------------
+ULONGLONG ROSAIOENGINE_CALLMODE CRosaIOEngine::CRosaIOEngineAttach(SOCKET s)
+{
+	if (m_pLoop == NULL || s == INVALID_SOCKET)
+	{
+		return 0;
+	}
+
+	ULONGLONG ullConnID = AddConnection(s);
+	if (ullConnID == 0)
+	{
+		closesocket(s);
+		return 0;
+	}
+
+	if (!StartRecv(ullConnID))
+	{
+		return 0;
+	}
+
+	return ullConnID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaIOEngineClose()
+// @Purpose: CRosaIOEngineر(رղصSOB_RET_CLOSE)
+// @Since: v1.00a
+// @Para: ULONGLONG ullConnID(ID)
+// @Return: bool bRet (true:ѹر, false:Ӳ)
+//------------------------------------------------------------------
+bool ROSAIOENGINE_CALLMODE CRosaIOEngine::CRosaIOEngineClose(ULONGLONG ullConnID)
+{
+	CThreadSafe ThreadSafe(&m_csIO);
+
+	map<ULONGLONG, LPS_IOCONNECTION>::iterator iter = m_mapConnection.find(ullConnID);
+	if (iter == m_mapConnection.end())
+	{
+		return false;
+	}
+
+	LPS_IOCONNECTION pConnection = iter->second;
+	pConnection->bNotified = true;
+	CloseConnection(pConnection);
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaIOEngineSend()
+// @Purpose: CRosaIOEngine(ƵƬ, ˳Ͷ, RIOʱͬһϲύ)
+// @Since: v1.00a
+// @Para: ULONGLONG ullConnID(ID)
+// @Para: const char* pSendBuffer(ͻ)
+// @Para: UINT uiBufferSize(ͳ)
+// @Return: int nRet (SOB_RET_OK:Ŷ, SOB_RET_CLOSE:Ӳ, SOB_RET_FAIL:Ƭ)
+//------------------------------------------------------------------
+int ROSAIOENGINE_CALLMODE CRosaIOEngine::CRosaIOEngineSend(ULONGLONG ullConnID, const char * pSendBuffer, UINT uiBufferSize)
+{
+	if (pSendBuffer == NULL || uiBufferSize == 0)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	CThreadSafe ThreadSafe(&m_csIO);
+
+	map<ULONGLONG, LPS_IOCONNECTION>::iterator iter = m_mapConnection.find(ullConnID);
+	if (iter == m_mapConnection.end() || iter->second->bClosed)
+	{
+		return SOB_RET_CLOSE;
+	}
+
+	LPS_IOCONNECTION pConnection = iter->second;
+
+	// ϢҪôȫŶҪôŶ
+	UINT uiSlices = (uiBufferSize + ROSA_IO_SLICE_SIZE - 1) / ROSA_IO_SLICE_SIZE;
+	if (m_vecFreeSlice.size() < uiSlices)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	UINT uiOffset = 0;
+
+	while (uiOffset < uiBufferSize)
+	{
+		UINT uiLength = uiBufferSize - uiOffset;
+		if (uiLength > ROSA_IO_SLICE_SIZE)
+		{
+			uiLength = ROSA_IO_SLICE_SIZE;
+		}
+
+		LPS_IOREQUEST pRequest = AllocRequest(pConnection, true);
+		memcpy(m_pSliceBuffer + (SIZE_T)pRequest->uiSlice * ROSA_IO_SLICE_SIZE, pSendBuffer + uiOffset, uiLength);
+		pRequest->uiLength = uiLength;
+
+		pConnection->dqSend.push_back(pRequest);
+		uiOffset += uiLength;
+	}
+
+	FlushSend(pConnection);
+
+	return SOB_RET_OK;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaIOEngineGetEngine()
+// @Purpose: CRosaIOEngineȡʵʹõ
+// @Since: v1.00a
+// @Para: None
+// @Return: int nEngine (ROSA_IO_ENGINE_RIO/ROSA_IO_ENGINE_IOCP)
+//------------------------------------------------------------------
+int ROSAIOENGINE_CALLMODE CRosaIOEngine::CRosaIOEngineGetEngine() const
+{
+	return m_nEngine;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaIOEngineGetConnectionCount()
+// @Purpose: CRosaIOEngineȡ
+// @Since: v1.00a
+// @Para: None
+// @Return: int nCount
+//------------------------------------------------------------------
+int ROSAIOENGINE_CALLMODE CRosaIOEngine::CRosaIOEngineGetConnectionCount()
+{
+	CThreadSafe ThreadSafe(&m_csIO);
+
+	return (int)m_mapConnection.size();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaIOEngineGetFreeSliceCount()
+// @Purpose: CRosaIOEngineȡлƬ
+// @Since: v1.00a
+// @Para: None
+// @Return: int nCount
+//------------------------------------------------------------------
+int ROSAIOENGINE_CALLMODE CRosaIOEngine::CRosaIOEngineGetFreeSliceCount()
+{
+	CThreadSafe ThreadSafe(&m_csIO);
+
+	return (int)m_vecFreeSlice.size();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaIOEngineCreateSocket()
+// @Purpose: CRosaIOEngineRIOTCP׽(ϵͳ֧ʱͨص׽)
+// @Since: v1.00a
+// @Para: int nFamily(ַ)
+// @Return: SOCKET s
+//------------------------------------------------------------------
+SOCKET ROSAIOENGINE_CALLMODE CRosaIOEngine::CRosaIOEngineCreateSocket(int nFamily)
+{
+	SOCKET s = WSASocket(nFamily, SOCK_STREAM, IPPROTO_TCP, NULL, 0, WSA_FLAG_OVERLAPPED | WSA_FLAG_REGISTERED_IO);
+	if (s == INVALID_SOCKET)
+	{
+		s = WSASocket(nFamily, SOCK_STREAM, IPPROTO_TCP, NULL, 0, WSA_FLAG_OVERLAPPED);
+	}
+
+	if (s != INVALID_SOCKET)
+	{
+		// CreateTCPSocketһ
+		const char chOpt = 1;
+		setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &chOpt, sizeof(char));
+	}
+
+	return s;
+}
+
+//------------------------------------------------------------------
+// @Function:	 InitRio()
+// @Purpose: CRosaIOEngineʼRIO(ȡ, עỺƬڴ, ɶ˿֪ͨɶ)
+// @Since: v1.00a
+// @Para: UINT uiMaxConnections()
+// @Return: bool bRet (true:ɹ, false:ϵͳ֧)
+//------------------------------------------------------------------
+bool CRosaIOEngine::InitRio(UINT uiMaxConnections)
+{
+	SOCKET s = WSASocket(AF_INET, SOCK_STREAM, IPPROTO_TCP, NULL, 0, WSA_FLAG_OVERLAPPED | WSA_FLAG_REGISTERED_IO);
+	if (s == INVALID_SOCKET)
+	{
+		return false;
+	}
+
+	GUID guidRio = WSAID_MULTIPLE_RIO;
+	DWORD dwBytes = 0;
+
+	memset(&m_Rio, 0, sizeof(m_Rio));
+	m_Rio.cbSize = sizeof(m_Rio);
+
+	int nRet = WSAIoctl(s, SIO_GET_MULTIPLE_EXTENSION_FUNCTION_POINTER, &guidRio, sizeof(guidRio), &m_Rio, sizeof(m_Rio), &dwBytes, NULL, NULL);
+
+	closesocket(s);
+
+	if (nRet == SOCKET_ERROR)
+	{
+		memset(&m_Rio, 0, sizeof(m_Rio));
+		return false;
+	}
+
+	// 黺ֻעһ, շʱƫ, ʡȥÿI/Oҳ
+	m_RioBufferID = m_Rio.RIORegisterBuffer(m_pSliceBuffer, (DWORD)((SIZE_T)m_uiSliceCount * ROSA_IO_SLICE_SIZE));
+	if (m_RioBufferID == RIO_INVALID_BUFFERID)
+	{
+		return false;
+	}
+
+	memset(&m_RioNotify, 0, sizeof(m_RioNotify));
+	m_RioNotify.pCallback = OnRioNotify;
+	m_RioNotify.pUser = this;
+
+	RIO_NOTIFICATION_COMPLETION Notification;
+	memset(&Notification, 0, sizeof(Notification));
+
+	Notification.Type = RIO_IOCP_COMPLETION;
+	Notification.Iocp.IocpHandle = m_pLoop->CRosaEventLoopGetHandle();
+	Notification.Iocp.CompletionKey = (PVOID)ROSA_LOOP_KEY_POST;
+	Notification.Iocp.Overlapped = &m_RioNotify.Overlapped;
+
+	m_RioCQ = m_Rio.RIOCreateCompletionQueue(uiMaxConnections * (ROSA_IO_RECV_DEPTH + ROSA_IO_SEND_DEPTH), &Notification);
+	if (m_RioCQ == RIO_INVALID_CQ)
+	{
+		m_Rio.RIODeregisterBuffer(m_RioBufferID);
+		m_RioBufferID = RIO_INVALID_BUFFERID;
+		return false;
+	}
+
+	// ɶнʱͶһɰ(װǰ, ɰǰDestroyɿ)
+	InterlockedIncrement(&m_nNotifying);
+
+	if (m_Rio.RIONotify(m_RioCQ) != ERROR_SUCCESS)
+	{
+		InterlockedDecrement(&m_nNotifying);
+		m_Rio.RIOCloseCompletionQueue(m_RioCQ);
+		m_RioCQ = RIO_INVALID_CQ;
+		m_Rio.RIODeregisterBuffer(m_RioBufferID);
+		m_RioBufferID = RIO_INVALID_BUFFERID;
+		return false;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 AddConnection()
+// @Purpose: CRosaIOEngine(RIOдʧʱӹɶ˿)
+// @Since: v1.00a
+// @Para: SOCKET s(ӵ׽)
+// @Return: ULONGLONG ullConnID (0:ʧ)
+//------------------------------------------------------------------
+ULONGLONG CRosaIOEngine::AddConnection(SOCKET s)
+{
+	CThreadSafe ThreadSafe(&m_csIO);
+
+	if (m_mapConnection.size() >= m_uiMaxConnections)
+	{
+		return 0;
+	}
+
+	LPS_IOCONNECTION pConnection = new S_IOCONNECTION;
+
+	pConnection->Socket = s;
+	pConnection->RequestQueue = RIO_INVALID_RQ;
+	pConnection->nPending = 0;
+	pConnection->uiSendPending = 0;
+	pConnection->bClosed = false;
+	pConnection->bNotified = false;
+
+	if (m_nEngine == ROSA_IO_ENGINE_RIO)
+	{
+		pConnection->RequestQueue = m_Rio.RIOCreateRequestQueue(s, ROSA_IO_RECV_DEPTH, 1, ROSA_IO_SEND_DEPTH, 1, m_RioCQ, m_RioCQ, pConnection);
+	}
+
+	// ׽δWSA_FLAG_REGISTERED_IOʱ˵ɶ˿
+	if (pConnection->RequestQueue == RIO_INVALID_RQ && !m_pLoop->CRosaEventLoopAttach((HANDLE)s))
+	{
+		delete pConnection;
+		return 0;
+	}
+
+	pConnection->ullConnID = m_ullNextConnID++;
+	m_mapConnection.insert(pair<ULONGLONG, LPS_IOCONNECTION>(pConnection->ullConnID, pConnection));
+
+	return pConnection->ullConnID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 StartRecv()
+// @Purpose: CRosaIOEngineͶӵ(ɶ˿·ֻͶһ, ֤߳)
+// @Since: v1.00a
+// @Para: ULONGLONG ullConnID(ID)
+// @Return: bool bRet (true:ɹ, false:ʧ, ѹر)
+//------------------------------------------------------------------
+bool CRosaIOEngine::StartRecv(ULONGLONG ullConnID)
+{
+	CThreadSafe ThreadSafe(&m_csIO);
+
+	map<ULONGLONG, LPS_IOCONNECTION>::iterator iter = m_mapConnection.find(ullConnID);
+	if (iter == m_mapConnection.end())
+	{
+		return false;
+	}
+
+	LPS_IOCONNECTION pConnection = iter->second;
+	int nDepth = (pConnection->RequestQueue != RIO_INVALID_RQ) ? ROSA_IO_RECV_DEPTH : 1;
+	int nPosted = 0;
+
+	for (int i = 0; i < nDepth; ++i)
+	{
+		LPS_IOREQUEST pRequest = AllocRequest(pConnection, false);
+		if (pRequest == NULL)
+		{
+			break;
+		}
+
+		if (!PostRecv(pRequest))
+		{
+			FreeRequest(pRequest);
+			break;
+		}
+
+		nPosted++;
+	}
+
+	if (nPosted == 0)
+	{
+		pConnection->bNotified = true;
+		CloseConnection(pConnection);
+		return false;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 AllocRequest()
+// @Purpose: CRosaIOEngine󼰻Ƭ(߳m_csIO)
+// @Since: v1.00a
+// @Para: LPS_IOCONNECTION pConnection()
+// @Para: bool bSend(ǷΪ)
+// @Return: LPS_IOREQUEST pRequest (NULL:Ƭ)
+//------------------------------------------------------------------
+LPS_IOREQUEST CRosaIOEngine::AllocRequest(LPS_IOCONNECTION pConnection, bool bSend)
+{
+	if (m_vecFreeSlice.empty())
+	{
+		return NULL;
+	}
+
+	LPS_IOREQUEST pRequest = new S_IOREQUEST;
+
+	memset(&pRequest->Overlapped, 0, sizeof(pRequest->Overlapped));
+	pRequest->Overlapped.pCallback = OnIocpComplete;
+	pRequest->Overlapped.pUser = this;
+	pRequest->pConnection = pConnection;
+	pRequest->uiSlice = m_vecFreeSlice.back();
+	pRequest->uiLength = 0;
+	pRequest->bSend = bSend;
+
+	m_vecFreeSlice.pop_back();
+
+	return pRequest;
+}
+
+//------------------------------------------------------------------
+// @Function:	 PostRecv()
+// @Purpose: CRosaIOEngineͶݽ(߳m_csIO)
+// @Since: v1.00a
+// @Para: LPS_IOREQUEST pRequest()
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool CRosaIOEngine::PostRecv(LPS_IOREQUEST pRequest)
+{
+	LPS_IOCONNECTION pConnection = pRequest->pConnection;
+
+	if (pConnection->RequestQueue != RIO_INVALID_RQ)
+	{
+		RIO_BUF Buf;
+		Buf.BufferId = m_RioBufferID;
+		Buf.Offset = pRequest->uiSlice * ROSA_IO_SLICE_SIZE;
+		Buf.Length = ROSA_IO_SLICE_SIZE;
+
+		if (!m_Rio.RIOReceive(pConnection->RequestQueue, &Buf, 1, 0, pRequest))
+		{
+			return false;
+		}
+	}
+	else
+	{
+		memset(&pRequest->Overlapped.Overlapped, 0, sizeof(pRequest->Overlapped.Overlapped));
+
+		WSABUF wsaBuf;
+		wsaBuf.buf = m_pSliceBuffer + (SIZE_T)pRequest->uiSlice * ROSA_IO_SLICE_SIZE;
+		wsaBuf.len = ROSA_IO_SLICE_SIZE;
+
+		DWORD dwFlags = 0;
+		if (WSARecv(pConnection->Socket, &wsaBuf, 1, NULL, &dwFlags, &pRequest->Overlapped.Overlapped, NULL) == SOCKET_ERROR && WSAGetLastError() != WSA_IO_PENDING)
+		{
+			return false;
+		}
+	}
+
+	// ɻصҪm_csIO, ʱ
+	pConnection->nPending++;
+	InterlockedIncrement(&m_nRequests);
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 FlushSend()
+// @Purpose: CRosaIOEngineͶݵȴ͵ĻƬ(RIOʱһRIO_MSG_DEFERͶ, һύ)
+// @Since: v1.00a
+// @Para: LPS_IOCONNECTION pConnection()
+// @Return: None
+//------------------------------------------------------------------
+void CRosaIOEngine::FlushSend(LPS_IOCONNECTION pConnection)
+{
+	bool bDeferred = false;
+
+	while (!pConnection->bClosed && pConnection->uiSendPending < ROSA_IO_SEND_DEPTH && !pConnection->dqSend.empty())
+	{
+		LPS_IOREQUEST pRequest = pConnection->dqSend.front();
+
+		if (pConnection->RequestQueue != RIO_INVALID_RQ)
+		{
+			bool bMore = (pConnection->dqSend.size() > 1 && pConnection->uiSendPending + 1 < ROSA_IO_SEND_DEPTH);
+
+			RIO_BUF Buf;
+			Buf.BufferId = m_RioBufferID;
+			Buf.Offset = pRequest->uiSlice * ROSA_IO_SLICE_SIZE;
+			Buf.Length = pRequest->uiLength;
+
+			if (!m_Rio.RIOSend(pConnection->RequestQueue, &Buf, 1, bMore ? RIO_MSG_DEFER : 0, pRequest))
+			{
+				break;
+			}
+
+			bDeferred = bMore;
+		}
+		else
+		{
+			memset(&pRequest->Overlapped.Overlapped, 0, sizeof(pRequest->Overlapped.Overlapped));
+
+			WSABUF wsaBuf;
+			wsaBuf.buf = m_pSliceBuffer + (SIZE_T)pRequest->uiSlice * ROSA_IO_SLICE_SIZE;
+			wsaBuf.len = pRequest->uiLength;
+
+			if (WSASend(pConnection->Socket, &wsaBuf, 1, NULL, 0, &pRequest->Overlapped.Overlapped, NULL) == SOCKET_ERROR && WSAGetLastError() != WSA_IO_PENDING)
+			{
+				break;
+			}
+		}
+
+		pConnection->dqSend.pop_front();
+		pConnection->uiSendPending++;
+		pConnection->nPending++;
+		InterlockedIncrement(&m_nRequests);
+	}
+
+	// ύδύӳٷ
+	if (bDeferred)
+	{
+		m_Rio.RIOSend(pConnection->RequestQueue, NULL, 0, RIO_MSG_COMMIT_ONLY, NULL);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CloseConnection()
+// @Purpose: CRosaIOEngineر, ȫͷ(߳m_csIO, غٷpConnection)
+// @Since: v1.00a
+// @Para: LPS_IOCONNECTION pConnection()
+// @Return: None
+//------------------------------------------------------------------
+void CRosaIOEngine::CloseConnection(LPS_IOCONNECTION pConnection)
+{
+	if (!pConnection->bClosed)
+	{
+		pConnection->bClosed = true;
+		m_mapConnection.erase(pConnection->ullConnID);
+
+		while (!pConnection->dqSend.empty())
+		{
+			FreeRequest(pConnection->dqSend.front());
+			pConnection->dqSend.pop_front();
+		}
+
+		// ر׽ʹеԴ(RIO׽ͷ)
+		closesocket(pConnection->Socket);
+		pConnection->Socket = INVALID_SOCKET;
+	}
+
+	if (pConnection->nPending == 0)
+	{
+		delete pConnection;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 FreeRequest()
+// @Purpose: CRosaIOEngineͷ󲢹黹Ƭ(߳m_csIO)
+// @Since: v1.00a
+// @Para: LPS_IOREQUEST pRequest()
+// @Return: None
+//------------------------------------------------------------------
+void CRosaIOEngine::FreeRequest(LPS_IOREQUEST pRequest)
+{
+	m_vecFreeSlice.push_back(pRequest->uiSlice);
+	delete pRequest;
+}
+
+//------------------------------------------------------------------
+// @Function:	 PostAccept()
+// @Purpose: CRosaIOEngineͶAcceptEx
+// @Since: v1.00a
+// @Para: LPS_IOACCEPT pAccept(AcceptExλ)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool CRosaIOEngine::PostAccept(LPS_IOACCEPT pAccept)
+{
+	SOCKET sListen = m_ListenSocket;
+	if (sListen == INVALID_SOCKET)
+	{
+		return false;
+	}
+
+	pAccept->Socket = CRosaIOEngineCreateSocket(AF_INET);
+	if (pAccept->Socket == INVALID_SOCKET)
+	{
+		return false;
+	}
+
+	memset(&pAccept->Overlapped.Overlapped, 0, sizeof(pAccept->Overlapped.Overlapped));
+
+	InterlockedIncrement(&m_nRequests);
+
+	DWORD dwBytes = 0;
+	if (!m_pfnAcceptEx(sListen, pAccept->Socket, pAccept->chAddrBuf, 0, sizeof(SOCKADDR_STORAGE) + 16, sizeof(SOCKADDR_STORAGE) + 16, &dwBytes, &pAccept->Overlapped.Overlapped))
+	{
+		if (WSAGetLastError() != ERROR_IO_PENDING)
+		{
+			closesocket(pAccept->Socket);
+			pAccept->Socket = INVALID_SOCKET;
+			InterlockedDecrement(&m_nRequests);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 HandleCompletion()
+// @Purpose: CRosaIOEngine(ݲص, ֮ͬһƬ)
+// @Since: v1.00a
+// @Para: LPS_IOREQUEST pRequest()
+// @Para: DWORD dwBytes(ֽ)
+// @Para: DWORD dwError()
+// @Return: None
+//------------------------------------------------------------------
+void CRosaIOEngine::HandleCompletion(LPS_IOREQUEST pRequest, DWORD dwBytes, DWORD dwError)
+{
+	LPS_IOCONNECTION pConnection = pRequest->pConnection;
+	ULONGLONG ullConnID = pConnection->ullConnID;
+	bool bNotify = false;
+
+	// ʱͷ, ƬͶǰᱻ
+	if (!pRequest->bSend && dwError == 0 && dwBytes > 0 && !pConnection->bClosed)
+	{
+		m_pRecvCallback(ullConnID, m_pSliceBuffer + (SIZE_T)pRequest->uiSlice * ROSA_IO_SLICE_SIZE, dwBytes, SOB_RET_OK, m_dwUser);
+	}
+
+	EnterCriticalSection(&m_csIO);
+
+	pConnection->nPending--;
+
+	bool bBroken = false;
+
+	if (pRequest->bSend)
+	{
+		pConnection->uiSendPending--;
+		FreeRequest(pRequest);
+
+		if (dwError != 0)
+		{
+			bBroken = true;
+		}
+		else
+		{
+			FlushSend(pConnection);
+		}
+	}
+	else if (dwError != 0 || dwBytes == 0 || pConnection->bClosed || !PostRecv(pRequest))
+	{
+		FreeRequest(pRequest);
+		bBroken = true;
+	}
+
+	if (bBroken && !pConnection->bNotified)
+	{
+		pConnection->bNotified = true;
+		bNotify = true;
+	}
+
+	// ѹرյһʱͷ
+	if (bBroken || pConnection->bClosed)
+	{
+		CloseConnection(pConnection);
+	}
+
+	LeaveCriticalSection(&m_csIO);
+
+	if (bNotify)
+	{
+		m_pRecvCallback(ullConnID, NULL, 0, SOB_RET_CLOSE, m_dwUser);
+	}
+
+	InterlockedDecrement(&m_nRequests);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnRioNotify()
+// @Purpose: CRosaIOEngine RIOɶ֪ͨ(һȡһ, ֪ͨ)
+// @Since: v1.00a
+// @Para: LPS_ROSAOVERLAPPED pOverlapped(֪ͨصṹ)
+// @Para: DWORD dwBytes(δʹ)
+// @Para: DWORD dwError(δʹ)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaIOEngine::OnRioNotify(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError)
+{
+	CRosaIOEngine* pThis = (CRosaIOEngine*)pOverlapped->pUser;
+
+	// װʱѼ1, ִڼټ1, װװļ
+	InterlockedIncrement(&pThis->m_nNotifying);
+
+	// ͬһʱֻһ֪ͨ, ɶɵǰ̶߳ռȡ
+	RIORESULT Results[ROSA_IO_DEQUEUE_BATCH];
+	ULONG ulCount = 0;
+
+	while ((ulCount = pThis->m_Rio.RIODequeueCompletion(pThis->m_RioCQ, Results, ROSA_IO_DEQUEUE_BATCH)) != 0 && ulCount != RIO_CORRUPT_CQ)
+	{
+		for (ULONG i = 0; i < ulCount; ++i)
+		{
+			LPS_IOREQUEST pRequest = (LPS_IOREQUEST)Results[i].RequestContext;
+			pThis->HandleCompletion(pRequest, Results[i].BytesTransferred, (DWORD)Results[i].Status);
+		}
+	}
+
+	if (pThis->m_Rio.RIONotify(pThis->m_RioCQ) != ERROR_SUCCESS)
+	{
+		InterlockedDecrement(&pThis->m_nNotifying);
+	}
+
+	InterlockedDecrement(&pThis->m_nNotifying);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnIocpComplete()
+// @Purpose: CRosaIOEngineɶ˿
+// @Since: v1.00a
+// @Para: LPS_ROSAOVERLAPPED pOverlapped(صṹ)
+// @Para: DWORD dwBytes(ֽ)
+// @Para: DWORD dwError()
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaIOEngine::OnIocpComplete(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError)
+{
+	CRosaIOEngine* pThis = (CRosaIOEngine*)pOverlapped->pUser;
+
+	pThis->HandleCompletion((LPS_IOREQUEST)pOverlapped, dwBytes, dwError);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAcceptComplete()
+// @Purpose: CRosaIOEngine AcceptEx(صʼ, ͶAcceptEx)
+// @Since: v1.00a
+// @Para: LPS_ROSAOVERLAPPED pOverlapped(AcceptExλ)
+// @Para: DWORD dwBytes(δʹ)
+// @Para: DWORD dwError()
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaIOEngine::OnAcceptComplete(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError)
+{
+	CRosaIOEngine* pThis = (CRosaIOEngine*)pOverlapped->pUser;
+	LPS_IOACCEPT pAccept = (LPS_IOACCEPT)pOverlapped;
+	SOCKET sListen = pThis->m_ListenSocket;
+
+	SOCKET s = pAccept->Socket;
+	pAccept->Socket = INVALID_SOCKET;
+
+	if (dwError == 0 && sListen != INVALID_SOCKET)
+	{
+		// ׽ʹgetpeername/shutdown
+		setsockopt(s, SOL_SOCKET, SO_UPDATE_ACCEPT_CONTEXT, (char*)&sListen, sizeof(sListen));
+
+		ULONGLONG ullConnID = pThis->AddConnection(s);
+		if (ullConnID == 0)
+		{
+			closesocket(s);
+		}
+		else
+		{
+			if (pThis->m_pAcceptCallback)
+			{
+				pThis->m_pAcceptCallback(ullConnID, s, pThis->m_dwUser);
+			}
+
+			pThis->StartRecv(ullConnID);
+		}
+	}
+	else
+	{
+		closesocket(s);
+	}
+
+	// رպͶ
+	if (pThis->m_ListenSocket != INVALID_SOCKET)
+	{
+		pThis->PostAccept(pAccept);
+	}
+
+	InterlockedDecrement(&pThis->m_nRequests);
+}
@@ -0,0 +1,158 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaIOEngine.h
+* @brief	This File is RosaIOEngine Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSAIOENGINE_H__
+#define __CROSAIOENGINE_H__
+
+//Include Rosa Header File
+#include "CRosaSocket.h"
+#include "CRosaEventLoop.h"
+
+//Include C/C++ Header File
+#include <map>
+#include <deque>
+#include <vector>
+
+using namespace std;
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSAIOENGINE_API	__declspec(dllexport)
+#else
+#define ROSAIOENGINE_API	__declspec(dllimport)
+#endif
+
+#define ROSAIOENGINE_CALLMODE	__stdcall
+
+#define ROSA_IO_ENGINE_AUTO			0				//Զѡ(RIO, ֧ʱʹɶ˿)
+#define ROSA_IO_ENGINE_RIO			1				//Registered I/O(עỺ, ȡ)
+#define ROSA_IO_ENGINE_IOCP			2				//ɶ˿(WSARecv/WSASend)
+
+#define ROSA_IO_SLICE_SIZE			4096			//Ƭ
+#define ROSA_IO_SLICE_COUNT			8192			//Ƭ(һע)
+#define ROSA_IO_MAX_CONNECTIONS		8192			//(RIOɶг)
+#define ROSA_IO_RECV_DEPTH			2				//ÿԤͶݵĽ
+#define ROSA_IO_SEND_DEPTH			16				//ÿͬʱеķ
+#define ROSA_IO_ACCEPT_DEPTH		8				//ͬʱȴAcceptEx
+#define ROSA_IO_DEQUEUE_BATCH		256				//ÿȡصRIO
+
+//Callback Definition
+typedef void(__stdcall *HANDLE_IO_ACCEPT_CALLBACK)(ULONGLONG ullConnID, SOCKET s, DWORD_PTR dwUser);										//ӻص(Ͷݽ֮ǰִ)
+typedef void(__stdcall *HANDLE_IO_RECV_CALLBACK)(ULONGLONG ullConnID, const char* pData, UINT uiSize, int nResult, DWORD_PTR dwUser);		//ݻص(nResultΪSOB_RET_CLOSEʱӽ, ֻصһ)
+
+//Struct Definition
+typedef struct _S_IOCONNECTION S_IOCONNECTION, *LPS_IOCONNECTION;
+
+typedef struct
+{
+	S_ROSAOVERLAPPED Overlapped;			// صṹ(λλ, ɶ˿·ʹ)
+	LPS_IOCONNECTION pConnection;			// 
+	UINT uiSlice;							// Ƭ
+	UINT uiLength;							// ͳ
+	bool bSend;								// ǷΪ
+}S_IOREQUEST, *LPS_IOREQUEST;
+
+struct _S_IOCONNECTION
+{
+	ULONGLONG ullConnID;					// ID
+	SOCKET Socket;							// ׽
+	RIO_RQ RequestQueue;					// RIO(ɶ˿·ΪRIO_INVALID_RQ)
+	LONG nPending;							// е
+	UINT uiSendPending;						// еķ
+	deque<LPS_IOREQUEST> dqSend;			// ȴ͵ĻƬ
+	bool bClosed;							// ǷѾر
+	bool bNotified;							// ǷѾص
+};
+
+typedef struct
+{
+	S_ROSAOVERLAPPED Overlapped;			// صṹ(λλ)
+	SOCKET Socket;							// ӵ׽
+	char chAddrBuf[2 * (sizeof(SOCKADDR_STORAGE) + 16)];	// AcceptExַ
+}S_IOACCEPT, *LPS_IOACCEPT;
+
+//Class Definition
+class ROSAIOENGINE_API CRosaIOEngine
+{
+public:
+	CRosaIOEngine();			// CRosaIOEngine 캯
+	~CRosaIOEngine();			// CRosaIOEngine 
+
+public:
+	bool ROSAIOENGINE_CALLMODE CRosaIOEngineCreate(CRosaEventLoop* pLoop, HANDLE_IO_RECV_CALLBACK pRecvCallback, DWORD_PTR dwUser, int nEngine = ROSA_IO_ENGINE_AUTO, UINT uiMaxConnections = ROSA_IO_MAX_CONNECTIONS, UINT uiSliceCount = ROSA_IO_SLICE_COUNT);	// CRosaIOEngine (RIOʱ˵ɶ˿)
+	void ROSAIOENGINE_CALLMODE CRosaIOEngineDestroy();										// CRosaIOEngine رȫӲͷעỺ
+
+	bool ROSAIOENGINE_CALLMODE CRosaIOEngineListen(USHORT sPort, HANDLE_IO_ACCEPT_CALLBACK pAcceptCallback, int nBacklog = SOMAXCONN);	// CRosaIOEngine ˿(ԤͶݶAcceptEx)
+	ULONGLONG ROSAIOENGINE_CALLMODE CRosaIOEngineAttach(SOCKET s);							// CRosaIOEngine ӹӵص׽(δWSA_FLAG_REGISTERED_IOʱʹɶ˿)
+	bool ROSAIOENGINE_CALLMODE CRosaIOEngineClose(ULONGLONG ullConnID);					// CRosaIOEngine ر(رղص)
+
+	int ROSAIOENGINE_CALLMODE CRosaIOEngineSend(ULONGLONG ullConnID, const char* pSendBuffer, UINT uiBufferSize);	// CRosaIOEngine (ƵעỺ, 岻㷵SOB_RET_FAIL)
+
+	int ROSAIOENGINE_CALLMODE CRosaIOEngineGetEngine() const;								// CRosaIOEngine ȡʵʹõ
+	int ROSAIOENGINE_CALLMODE CRosaIOEngineGetConnectionCount();							// CRosaIOEngine ȡ
+	int ROSAIOENGINE_CALLMODE CRosaIOEngineGetFreeSliceCount();							// CRosaIOEngine ȡлƬ
+
+	static SOCKET ROSAIOENGINE_CALLMODE CRosaIOEngineCreateSocket(int nFamily = AF_INET);	// CRosaIOEngine RIOTCP׽
+
+private:
+	bool InitRio(UINT uiMaxConnections);													// CRosaIOEngine ʼRIO(, עỺ, ɶ)
+	ULONGLONG AddConnection(SOCKET s);														// CRosaIOEngine (RIOлɶ˿)
+	bool StartRecv(ULONGLONG ullConnID);													// CRosaIOEngine Ͷӵ
+	LPS_IOREQUEST AllocRequest(LPS_IOCONNECTION pConnection, bool bSend);					// CRosaIOEngine 󼰻Ƭ(߳m_csIO)
+	bool PostRecv(LPS_IOREQUEST pRequest);													// CRosaIOEngine Ͷݽ(߳m_csIO)
+	void FlushSend(LPS_IOCONNECTION pConnection);											// CRosaIOEngine Ͷݵȴ͵ĻƬ(߳m_csIO)
+	void CloseConnection(LPS_IOCONNECTION pConnection);										// CRosaIOEngine رӲͷ(߳m_csIO)
+	void FreeRequest(LPS_IOREQUEST pRequest);												// CRosaIOEngine ͷ󼰻Ƭ(߳m_csIO)
+	bool PostAccept(LPS_IOACCEPT pAccept);													// CRosaIOEngine ͶAcceptEx
+	void HandleCompletion(LPS_IOREQUEST pRequest, DWORD dwBytes, DWORD dwError);			// CRosaIOEngine 
+
+	static void __stdcall OnRioNotify(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError);		// CRosaIOEngine RIOɶ֪ͨ(ȡ)
+	static void __stdcall OnIocpComplete(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError);		// CRosaIOEngine ɶ˿
+	static void __stdcall OnAcceptComplete(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError);	// CRosaIOEngine AcceptEx
+
+private:
+	CRosaEventLoop* m_pLoop;								// CRosaIOEngine ¼ѭ
+	int m_nEngine;											// CRosaIOEngine ʵʹõ
+	HANDLE_IO_RECV_CALLBACK m_pRecvCallback;				// CRosaIOEngine ݻص
+	HANDLE_IO_ACCEPT_CALLBACK m_pAcceptCallback;			// CRosaIOEngine ӻص
+	DWORD_PTR m_dwUser;										// CRosaIOEngine û
+
+	CRITICAL_SECTION m_csIO;								// CRosaIOEngine Ӽٽ
+	map<ULONGLONG, LPS_IOCONNECTION> m_mapConnection;		// CRosaIOEngine 
+	ULONGLONG m_ullNextConnID;								// CRosaIOEngine һID
+	volatile LONG m_nRequests;								// CRosaIOEngine е(AcceptEx)
+	volatile LONG m_nNotifying;								// CRosaIOEngine RIO֪ͨ(װ֪ͨ1, صִټ1)
+
+// Ա
+private:
+	char* m_pSliceBuffer;									// CRosaIOEngine Ƭڴ(RIOʱע)
+	UINT m_uiSliceCount;									// CRosaIOEngine Ƭ
+	vector<UINT> m_vecFreeSlice;							// CRosaIOEngine лƬ
+
+// RIOԱ
+private:
+	RIO_EXTENSION_FUNCTION_TABLE m_Rio;						// CRosaIOEngine RIO
+	RIO_BUFFERID m_RioBufferID;								// CRosaIOEngine עỺID
+	RIO_CQ m_RioCQ;											// CRosaIOEngine RIOɶ
+	S_ROSAOVERLAPPED m_RioNotify;							// CRosaIOEngine RIO֪ͨ
+	UINT m_uiMaxConnections;								// CRosaIOEngine 
+
+// Ա
+private:
+	SOCKET m_ListenSocket;									// CRosaIOEngine ׽
+	LPFN_ACCEPTEX m_pfnAcceptEx;							// CRosaIOEngine AcceptExչ
+	S_IOACCEPT m_Accept[ROSA_IO_ACCEPT_DEPTH];				// CRosaIOEngine ԤͶݵAcceptEx
+
+};
+
+#endif // !__CROSAIOENGINE_H__
@@ -0,0 +1,117 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaMPSCQueue.cpp
+* @brief	This File is RosaMPSCQueue Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaMPSCQueue.h"
+
+//CRosaMPSCQueue ߵ(ʽڵ, ֻһԭӽ)
+
+//------------------------------------------------------------------
+// @Function:	 CRosaMPSCQueue()
+// @Purpose: CRosaMPSCQueue캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaMPSCQueue::CRosaMPSCQueue()
+{
+	m_Stub.pNext = NULL;
+	m_pHead = &m_Stub;
+	m_pTail = &m_Stub;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaMPSCQueue()
+// @Purpose: CRosaMPSCQueue(ڵʹͷ)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaMPSCQueue::~CRosaMPSCQueue()
+{
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaMPSCQueuePush()
+// @Purpose: CRosaMPSCQueue(߳, , ȴ)
+// @Since: v1.00a
+// @Para: LPS_MPSCNODE pNode(ڵ, ֮ǰͷ)
+// @Return: None
+//------------------------------------------------------------------
+void ROSAMPSCQUEUE_CALLMODE CRosaMPSCQueue::CRosaMPSCQueuePush(LPS_MPSCNODE pNode)
+{
+	pNode->pNext = NULL;
+
+	// ֮֮ǰ, ߿ʱϿ
+	LPS_MPSCNODE pPrev = (LPS_MPSCNODE)InterlockedExchangePointer((PVOID volatile*)&m_pHead, pNode);
+	pPrev->pNext = pNode;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaMPSCQueuePop()
+// @Purpose: CRosaMPSCQueue(ֻһߵ)
+// @Since: v1.00a
+// @Para: None
+// @Return: LPS_MPSCNODE pNode (NULL:Ϊջӽеһ, CRosaMPSCQueueIsEmptyfalse)
+//------------------------------------------------------------------
+LPS_MPSCNODE ROSAMPSCQUEUE_CALLMODE CRosaMPSCQueue::CRosaMPSCQueuePop()
+{
+	LPS_MPSCNODE pTail = m_pTail;
+	LPS_MPSCNODE pNext = pTail->pNext;
+
+	// ڱڵ
+	if (pTail == &m_Stub)
+	{
+		if (pNext == NULL)
+		{
+			return NULL;
+		}
+
+		m_pTail = pNext;
+		pTail = pNext;
+		pNext = pNext->pNext;
+	}
+
+	if (pNext != NULL)
+	{
+		m_pTail = pNext;
+		return pTail;
+	}
+
+	// β֮
+	if (pTail != m_pHead)
+	{
+		return NULL;
+	}
+
+	// ֻʣһڵ, ·ڱſȡ
+	CRosaMPSCQueuePush(&m_Stub);
+
+	pNext = pTail->pNext;
+	if (pNext != NULL)
+	{
+		m_pTail = pNext;
+		return pTail;
+	}
+
+	return NULL;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaMPSCQueueIsEmpty()
+// @Purpose: CRosaMPSCQueueǷΪ(ֻߵ)
+// @Since: v1.00a
+// @Para: None
+// @Return: bool bRet (true:Ϊ, false:Ϊ)
+//------------------------------------------------------------------
+bool ROSAMPSCQUEUE_CALLMODE CRosaMPSCQueue::CRosaMPSCQueueIsEmpty() const
+{
+	return (m_pTail == &m_Stub && m_pHead == &m_Stub);
+}
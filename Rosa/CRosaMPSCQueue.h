@@ -0,0 +1,55 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaMPSCQueue.h
+* @brief	This File is RosaMPSCQueue Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSAMPSCQUEUE_H__
+#define __CROSAMPSCQUEUE_H__
+
+//Include Windows Header File
+#include <Windows.h>
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSAMPSCQUEUE_API	__declspec(dllexport)
+#else
+#define ROSAMPSCQUEUE_API	__declspec(dllimport)
+#endif
+
+#define ROSAMPSCQUEUE_CALLMODE	__stdcall
+
+//Struct Definition
+typedef struct _S_MPSCNODE
+{
+	struct _S_MPSCNODE* volatile pNext;		// һڵ(Ƕ뵽ûṹλ)
+}S_MPSCNODE, *LPS_MPSCNODE;
+
+//Class Definition
+class ROSAMPSCQUEUE_API CRosaMPSCQueue
+{
+public:
+	CRosaMPSCQueue();			// CRosaMPSCQueue 캯
+	~CRosaMPSCQueue();			// CRosaMPSCQueue 
+
+public:
+	void ROSAMPSCQUEUE_CALLMODE CRosaMPSCQueuePush(LPS_MPSCNODE pNode);		// CRosaMPSCQueue (߳, )
+	LPS_MPSCNODE ROSAMPSCQUEUE_CALLMODE CRosaMPSCQueuePop();					// CRosaMPSCQueue (һ, ӽеһʱNULL)
+	bool ROSAMPSCQUEUE_CALLMODE CRosaMPSCQueueIsEmpty() const;					// CRosaMPSCQueue ǷΪ(һ)
+
+private:
+	LPS_MPSCNODE volatile m_pHead;		// CRosaMPSCQueue β(߽)
+	char m_chPad[64];					// CRosaMPSCQueue ָߵĻ
+	LPS_MPSCNODE m_pTail;				// CRosaMPSCQueue (߶ռ)
+	S_MPSCNODE m_Stub;					// CRosaMPSCQueue ڱڵ
+
+};
+
+#endif // !__CROSAMPSCQUEUE_H__
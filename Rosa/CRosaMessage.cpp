@@ -0,0 +1,87 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaMessage.cpp
+* @brief	This File is RosaMessage Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaMessage.h"
+
+//CRosaMessage Ϣֹ(ֶζдCRosaMessageSchema/Writer/Readerģڱ)
+
+//------------------------------------------------------------------
+// @Function:	 CRosaMessageCheck()
+// @Purpose: CRosaMessageϢͷ(ǷǢ; ԰Ϣ)
+// @Since: v1.00a
+// @Para: const char* pBuffer(Ϣ)
+// @Para: UINT uiSize(峤)
+// @Para: S_MESSAGEHEADER& sHeader(Ϣͷ)
+// @Return: bool bRet(true:Ч, false:Ч)
+//------------------------------------------------------------------
+bool ROSAMESSAGE_CALLMODE CRosaMessage::CRosaMessageCheck(const char * pBuffer, UINT uiSize, S_MESSAGEHEADER & sHeader)
+{
+	if (pBuffer == NULL || uiSize < sizeof(S_MESSAGEHEADER))
+	{
+		return false;
+	}
+
+	memcpy(&sHeader, pBuffer, sizeof(sHeader));
+
+	if (sHeader.sSchemaID == ROSA_MESSAGE_SCHEMA_INVALID)
+	{
+		return false;
+	}
+
+	return (sHeader.dwSize >= sizeof(S_MESSAGEHEADER) + sHeader.sFixedSize) && (sHeader.dwSize <= uiSize);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaMessageGetSchemaID()
+// @Purpose: CRosaMessageȡṹID(IDѡCRosaMessageReader)
+// @Since: v1.00a
+// @Para: const char* pBuffer(Ϣ)
+// @Para: UINT uiSize(峤)
+// @Return: USHORT sSchemaID (ROSA_MESSAGE_SCHEMA_INVALID:ϢЧ)
+//------------------------------------------------------------------
+USHORT ROSAMESSAGE_CALLMODE CRosaMessage::CRosaMessageGetSchemaID(const char * pBuffer, UINT uiSize)
+{
+	S_MESSAGEHEADER sHeader;
+
+	if (!CRosaMessageCheck(pBuffer, uiSize, sHeader))
+	{
+		return ROSA_MESSAGE_SCHEMA_INVALID;
+	}
+
+	return sHeader.sSchemaID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaMessageGetSize()
+// @Purpose: CRosaMessageϢͷȡϢܳ(ʽʱϢͷ, ٰóϢ)
+// @Since: v1.00a
+// @Para: const char* pBuffer(ѽյ)
+// @Para: UINT uiSize(ѽճ)
+// @Return: UINT uiMessageSize (0:һϢͷϢͷЧ)
+//------------------------------------------------------------------
+UINT ROSAMESSAGE_CALLMODE CRosaMessage::CRosaMessageGetSize(const char * pBuffer, UINT uiSize)
+{
+	S_MESSAGEHEADER sHeader;
+
+	if (pBuffer == NULL || uiSize < sizeof(S_MESSAGEHEADER))
+	{
+		return 0;
+	}
+
+	memcpy(&sHeader, pBuffer, sizeof(sHeader));
+
+	if (sHeader.sSchemaID == ROSA_MESSAGE_SCHEMA_INVALID || sHeader.dwSize < sizeof(S_MESSAGEHEADER) + sHeader.sFixedSize)
+	{
+		return 0;
+	}
+
+	return sHeader.dwSize;
+}
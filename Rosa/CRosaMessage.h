@@ -0,0 +1,356 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaMessage.h
+* @brief	This File is RosaMessage Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSAMESSAGE_H__
+#define __CROSAMESSAGE_H__
+
+//Include Windows Header File
+#include <Windows.h>
+
+//Include C/C++ Header File
+#include <string.h>
+#include <type_traits>
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSAMESSAGE_API	__declspec(dllexport)
+#else
+#define ROSAMESSAGE_API	__declspec(dllimport)
+#endif
+
+#define ROSAMESSAGE_CALLMODE	__stdcall
+
+#define ROSA_MESSAGE_ALIGN			8				//䳤㼰䳤ݵĶ
+#define ROSA_MESSAGE_MAX_FIXED		65528			//̶󳤶(֡ͷΪ16λ)
+#define ROSA_MESSAGE_SCHEMA_INVALID	0				//ЧĽṹID(ID1ʼ)
+
+//Struct Definition
+typedef struct
+{
+	USHORT sSchemaID;						// ṹID
+	USHORT sFixedSize;						// д뷽Ĺ̶(һֶεĽλ, ; °汾ֻĩβ׷ֶ, ȡݴжֶǷ)
+	DWORD dwSize;							// Ϣܳ(ͷ䳤)
+}S_MESSAGEHEADER, *LPS_MESSAGEHEADER;
+
+typedef struct
+{
+	DWORD dwOffset;							// 䳤λ(Ϣͷʼ)
+	DWORD dwSize;							// 䳤ݳ(0:δ)
+}S_MESSAGEREF, *LPS_MESSAGEREF;
+
+//Class Definition
+class ROSAMESSAGE_API CRosaMessage
+{
+public:
+	static bool ROSAMESSAGE_CALLMODE CRosaMessageCheck(const char* pBuffer, UINT uiSize, S_MESSAGEHEADER& sHeader);	// CRosaMessage Ϣͷ(ֶ)
+	static USHORT ROSAMESSAGE_CALLMODE CRosaMessageGetSchemaID(const char* pBuffer, UINT uiSize);					// CRosaMessage ȡṹID(ַ, 0:ϢЧ)
+	static UINT ROSAMESSAGE_CALLMODE CRosaMessageGetSize(const char* pBuffer, UINT uiSize);						// CRosaMessage ϢͷȡϢܳ(ʽ, 0:һϢͷ)
+
+};
+
+//Template Definition
+/*
+* Ϣ(С, ڽջԭضȡ, ):
+*   S_MESSAGEHEADER | ̶(ֶΰ˳Ȼ, ƫڱȷ) | 䳤(S_MESSAGEREFָ)
+*
+* ṹ:
+*   enum { TELEMETRY_TIME, TELEMETRY_DEVICE, TELEMETRY_NAME };
+*   typedef CRosaMessageSchema<1, ULONGLONG, UINT, CRosaMessageBytes> TelemetrySchema;
+*
+* 汾ݽ: ֻĩβ׷ֶ, ɾıֶε(ֶαλ).
+* ɰ汾ĶȡԶֶ, °汾ĶȡȡϢʱȱٵֶηĬֵ.
+*/
+
+// 䳤ֶ(ֽڴ, ̶ΪS_MESSAGEREF)
+struct CRosaMessageBytes
+{
+};
+
+// ֶ(ֶ԰ֽڸ)
+template<class T>
+struct CRosaMessageField
+{
+	static_assert(std::is_trivially_copyable<T>::value, "CRosaMessage field must be trivially copyable");
+
+	typedef T Type;
+	static const bool VARIABLE = false;
+	static const UINT SIZE = sizeof(T);
+	static const UINT ALIGN = alignof(T);
+};
+
+template<>
+struct CRosaMessageField<CRosaMessageBytes>
+{
+	typedef S_MESSAGEREF Type;
+	static const bool VARIABLE = true;
+	static const UINT SIZE = sizeof(S_MESSAGEREF);
+	static const UINT ALIGN = alignof(S_MESSAGEREF);
+};
+
+// ϶(uiAlignΪ2)
+constexpr UINT CRosaMessageAlignUp(UINT uiOffset, UINT uiAlign)
+{
+	return (uiOffset + uiAlign - 1) & ~(uiAlign - 1);
+}
+
+// Nֶελ(uiOffsetΪǰһֶεĽλ)
+template<UINT uiOffset, UINT N, class... Fields>
+struct CRosaMessageLayout;
+
+template<UINT uiOffset, UINT N, class First, class... Rest>
+struct CRosaMessageLayout<uiOffset, N, First, Rest...>
+	: CRosaMessageLayout<CRosaMessageAlignUp(uiOffset, CRosaMessageField<First>::ALIGN) + CRosaMessageField<First>::SIZE, N - 1, Rest...>
+{
+};
+
+template<UINT uiOffset, class First, class... Rest>
+struct CRosaMessageLayout<uiOffset, 0, First, Rest...>
+{
+	typedef CRosaMessageField<First> Field;
+	static const UINT OFFSET = CRosaMessageAlignUp(uiOffset, Field::ALIGN);
+};
+
+// ȫֶεĽλ
+template<UINT uiOffset, class... Fields>
+struct CRosaMessageEnd
+{
+	static const UINT OFFSET = uiOffset;
+};
+
+template<UINT uiOffset, class First, class... Rest>
+struct CRosaMessageEnd<uiOffset, First, Rest...>
+	: CRosaMessageEnd<CRosaMessageAlignUp(uiOffset, CRosaMessageField<First>::ALIGN) + CRosaMessageField<First>::SIZE, Rest...>
+{
+};
+
+// Ϣṹ(ṹIDֶб)
+template<USHORT sID, class... Fields>
+class CRosaMessageSchema
+{
+public:
+	static_assert(sID != ROSA_MESSAGE_SCHEMA_INVALID, "CRosaMessage schema ID must not be 0");
+
+	static const USHORT SCHEMA_ID = sID;
+	static const UINT FIELD_COUNT = sizeof...(Fields);
+	static const UINT FIXED_SIZE = CRosaMessageEnd<sizeof(S_MESSAGEHEADER), Fields...>::OFFSET - sizeof(S_MESSAGEHEADER);	// д֡ͷĹ̶(, °汾׷ھɰ汾ڵֶԿжΪ)
+	static const UINT FIXED_END = CRosaMessageAlignUp(sizeof(S_MESSAGEHEADER) + FIXED_SIZE, ROSA_MESSAGE_ALIGN);			// 䳤
+
+	static_assert(FIXED_END - sizeof(S_MESSAGEHEADER) <= ROSA_MESSAGE_MAX_FIXED, "CRosaMessage fixed section too large");
+
+	template<UINT N>
+	struct Field
+	{
+		static_assert(N < sizeof...(Fields), "CRosaMessage field index out of range");
+
+		typedef typename CRosaMessageLayout<sizeof(S_MESSAGEHEADER), N, Fields...>::Field Traits;
+		typedef typename Traits::Type Type;
+		static const bool VARIABLE = Traits::VARIABLE;
+		static const UINT OFFSET = CRosaMessageLayout<sizeof(S_MESSAGEHEADER), N, Fields...>::OFFSET;
+		static const UINT END = OFFSET + Traits::SIZE;
+	};
+};
+
+// Ϣд(ֱдߵĻ, CRosaSendQueueAllocPayloadĹ)
+template<class Schema>
+class CRosaMessageWriter
+{
+public:
+	CRosaMessageWriter() : m_pBuffer(NULL), m_uiCapacity(0), m_uiSize(0)
+	{
+	}
+
+	// CRosaMessageWriter ʼд(̶, δõֶΪ0)
+	bool CRosaMessageWriterAttach(char* pBuffer, UINT uiCapacity)
+	{
+		if (pBuffer == NULL || uiCapacity < Schema::FIXED_END)
+		{
+			m_pBuffer = NULL;
+			return false;
+		}
+
+		S_MESSAGEHEADER sHeader = { Schema::SCHEMA_ID, (USHORT)Schema::FIXED_SIZE, Schema::FIXED_END };
+
+		memcpy(pBuffer, &sHeader, sizeof(sHeader));
+		memset(pBuffer + sizeof(sHeader), 0, Schema::FIXED_END - sizeof(sHeader));
+
+		m_pBuffer = pBuffer;
+		m_uiCapacity = uiCapacity;
+		m_uiSize = Schema::FIXED_END;
+
+		return true;
+	}
+
+	// CRosaMessageWriter öֶ
+	template<UINT N>
+	void CRosaMessageWriterSet(const typename Schema::template Field<N>::Type& Value)
+	{
+		static_assert(!Schema::template Field<N>::VARIABLE, "use CRosaMessageWriterSetBytes for variable fields");
+
+		memcpy(m_pBuffer + Schema::template Field<N>::OFFSET, &Value, sizeof(Value));
+	}
+
+	// CRosaMessageWriter Ϊ䳤ֶԤռ(дλ, ֱӹ; NULL:)
+	template<UINT N>
+	char* CRosaMessageWriterReserve(UINT uiSize)
+	{
+		static_assert(Schema::template Field<N>::VARIABLE, "use CRosaMessageWriterSet for fixed fields");
+
+		UINT uiOffset = CRosaMessageAlignUp(m_uiSize, ROSA_MESSAGE_ALIGN);
+		if (m_pBuffer == NULL || uiOffset > m_uiCapacity || uiSize > m_uiCapacity - uiOffset)
+		{
+			return NULL;
+		}
+
+		S_MESSAGEREF sRef = { uiOffset, uiSize };
+		memcpy(m_pBuffer + Schema::template Field<N>::OFFSET, &sRef, sizeof(sRef));
+
+		memset(m_pBuffer + m_uiSize, 0, uiOffset - m_uiSize);
+		m_uiSize = uiOffset + uiSize;
+
+		return m_pBuffer + uiOffset;
+	}
+
+	// CRosaMessageWriter ñ䳤ֶ()
+	template<UINT N>
+	bool CRosaMessageWriterSetBytes(const void* pData, UINT uiSize)
+	{
+		char* pDst = CRosaMessageWriterReserve<N>(uiSize);
+		if (pDst == NULL)
+		{
+			return false;
+		}
+
+		memcpy(pDst, pData, uiSize);
+
+		return true;
+	}
+
+	// CRosaMessageWriter д(Ϣܳ, 0:δʼд)
+	UINT CRosaMessageWriterFinish()
+	{
+		if (m_pBuffer == NULL)
+		{
+			return 0;
+		}
+
+		DWORD dwSize = m_uiSize;
+		memcpy(m_pBuffer + FIELD_OFFSET(S_MESSAGEHEADER, dwSize), &dwSize, sizeof(dwSize));
+
+		return m_uiSize;
+	}
+
+	// CRosaMessageWriter ǰ
+	UINT CRosaMessageWriterGetSize() const
+	{
+		return m_uiSize;
+	}
+
+private:
+	char* m_pBuffer;						// CRosaMessageWriter д뻺
+	UINT m_uiCapacity;						// CRosaMessageWriter 
+	UINT m_uiSize;							// CRosaMessageWriter д볤
+
+};
+
+// Ϣȡ(ýջ, ֶΰƫֱӶȡ, ڶȡڼЧ)
+template<class Schema>
+class CRosaMessageReader
+{
+public:
+	CRosaMessageReader() : m_pBuffer(NULL), m_uiFixedEnd(0), m_uiSize(0)
+	{
+	}
+
+	// CRosaMessageReader Ϣ(ϢͷṹID, ֶν)
+	bool CRosaMessageReaderAttach(const char* pBuffer, UINT uiSize)
+	{
+		S_MESSAGEHEADER sHeader;
+
+		m_pBuffer = NULL;
+
+		if (!CRosaMessage::CRosaMessageCheck(pBuffer, uiSize, sHeader) || sHeader.sSchemaID != Schema::SCHEMA_ID)
+		{
+			return false;
+		}
+
+		m_pBuffer = pBuffer;
+		m_uiFixedEnd = sizeof(S_MESSAGEHEADER) + sHeader.sFixedSize;
+		m_uiSize = sHeader.dwSize;
+
+		return true;
+	}
+
+	// CRosaMessageReader ֶǷ(д뷽İ汾ֶ)
+	template<UINT N>
+	bool CRosaMessageReaderHas() const
+	{
+		return Schema::template Field<N>::END <= m_uiFixedEnd;
+	}
+
+	// CRosaMessageReader ȡֶ(ʱĬֵ)
+	template<UINT N>
+	typename Schema::template Field<N>::Type CRosaMessageReaderGet(const typename Schema::template Field<N>::Type& Default = typename Schema::template Field<N>::Type()) const
+	{
+		static_assert(!Schema::template Field<N>::VARIABLE, "use CRosaMessageReaderGetBytes for variable fields");
+
+		if (!CRosaMessageReaderHas<N>())
+		{
+			return Default;
+		}
+
+		typename Schema::template Field<N>::Type Value;
+		memcpy(&Value, m_pBuffer + Schema::template Field<N>::OFFSET, sizeof(Value));
+
+		return Value;
+	}
+
+	// CRosaMessageReader ȡ䳤ֶ(ؽջеλ, NULL:/δ/Խ)
+	template<UINT N>
+	const char* CRosaMessageReaderGetBytes(UINT& uiSize) const
+	{
+		static_assert(Schema::template Field<N>::VARIABLE, "use CRosaMessageReaderGet for fixed fields");
+
+		uiSize = 0;
+
+		if (!CRosaMessageReaderHas<N>())
+		{
+			return NULL;
+		}
+
+		S_MESSAGEREF sRef;
+		memcpy(&sRef, m_pBuffer + Schema::template Field<N>::OFFSET, sizeof(sRef));
+
+		if (sRef.dwSize == 0 || sRef.dwOffset < m_uiFixedEnd || sRef.dwOffset > m_uiSize || sRef.dwSize > m_uiSize - sRef.dwOffset)
+		{
+			return NULL;
+		}
+
+		uiSize = sRef.dwSize;
+
+		return m_pBuffer + sRef.dwOffset;
+	}
+
+	// CRosaMessageReader Ϣܳ(ջһϢλ)
+	UINT CRosaMessageReaderGetSize() const
+	{
+		return m_uiSize;
+	}
+
+private:
+	const char* m_pBuffer;					// CRosaMessageReader Ϣ
+	UINT m_uiFixedEnd;						// CRosaMessageReader д뷽̶λ
+	UINT m_uiSize;							// CRosaMessageReader Ϣܳ
+
+};
+
+#endif // !__CROSAMESSAGE_H__
@@ -0,0 +1,696 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaRateLimiter.cpp
+* @brief	This File is RosaRateLimiter Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaRateLimiter.h"
+#include "CRosaHistogram.h"
+#include "CThreadSafe.h"
+
+//CRosaRateLimiter (Ӽֽ/ϢͰ, ڰת(DRR)ƽ, ¼ѭʱ, ߳)
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRateLimiter()
+// @Purpose: CRosaRateLimiter캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaRateLimiter::CRosaRateLimiter()
+{
+	m_pLoop = NULL;
+	m_ullTickTimerID = 0;
+	m_uiQuantum = ROSA_RATELIMIT_QUANTUM;
+
+	m_uiFlowFree = ROSA_RATELIMIT_NIL;
+	m_uiFlowCount = 0;
+	memset(&m_sStats, 0, sizeof(m_sStats));
+
+	InitializeCriticalSection(&m_csLimiter);
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaRateLimiter()
+// @Purpose: CRosaRateLimiter
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaRateLimiter::~CRosaRateLimiter()
+{
+	CRosaRateLimiterDestroy();
+
+	DeleteCriticalSection(&m_csLimiter);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRateLimiterCreate()
+// @Purpose: CRosaRateLimiter¼ѭʼ(ͬʱٵĬ)
+// @Since: v1.00a
+// @Para: CRosaEventLoop* pLoop(Ѿ¼ѭ, ָص䶨ʱִ߳)
+// @Para: UINT uiQuantum(ÿÿλȨصĶ, СڳϢʱÿֶܷϢ)
+// @Para: DWORD dwTickMSec(Ƽת)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSARATELIMITER_CALLMODE CRosaRateLimiter::CRosaRateLimiterCreate(CRosaEventLoop * pLoop, UINT uiQuantum, DWORD dwTickMSec)
+{
+	if (m_pLoop != NULL || pLoop == NULL || uiQuantum == 0 || dwTickMSec == 0)
+	{
+		return false;
+	}
+
+	{
+		CThreadSafe ThreadSafe(&m_csLimiter);
+
+		m_uiQuantum = uiQuantum;
+
+		S_RATEGROUP sGroup = { 0 };
+		sGroup.ullRefill = CRosaEventLoop::CRosaEventLoopGetTickMSec();
+		sGroup.uiHead = ROSA_RATELIMIT_NIL;
+		sGroup.bUsed = true;
+
+		m_vecGroup.clear();
+		m_vecGroup.push_back(sGroup);
+
+		m_vecFlow.clear();
+		m_uiFlowFree = ROSA_RATELIMIT_NIL;
+		m_uiFlowCount = 0;
+		memset(&m_sStats, 0, sizeof(m_sStats));
+	}
+
+	m_pLoop = pLoop;
+
+	m_ullTickTimerID = m_pLoop->CRosaEventLoopSetTimer(dwTickMSec, dwTickMSec, OnTickTimer, this);
+	if (m_ullTickTimerID == 0)
+	{
+		m_pLoop = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRateLimiterDestroy()
+// @Purpose: CRosaRateLimiterֹͣʱƳȫ鼰(ͶȽ)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSARATELIMITER_CALLMODE CRosaRateLimiter::CRosaRateLimiterDestroy()
+{
+	if (m_pLoop == NULL)
+	{
+		return;
+	}
+
+	// ȴִеڴ
+	m_pLoop->CRosaEventLoopKillTimer(m_ullTickTimerID);
+	m_ullTickTimerID = 0;
+
+	CThreadSafe ThreadSafe(&m_csLimiter);
+
+	m_vecGroup.clear();
+	m_vecFlow.clear();
+	m_uiFlowFree = ROSA_RATELIMIT_NIL;
+	m_uiFlowCount = 0;
+
+	m_pLoop = NULL;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRateLimiterCreateGroup()
+// @Purpose: CRosaRateLimiter(ӹͰ, ѹʱȨת)
+// @Since: v1.00a
+// @Para: const S_RATELIMIT& sLimit()
+// @Return: UINT uiGroup (ROSA_RATELIMIT_NIL:δ¼ѭ)
+//------------------------------------------------------------------
+UINT ROSARATELIMITER_CALLMODE CRosaRateLimiter::CRosaRateLimiterCreateGroup(const S_RATELIMIT & sLimit)
+{
+	CThreadSafe ThreadSafe(&m_csLimiter);
+
+	if (m_vecGroup.empty())
+	{
+		return ROSA_RATELIMIT_NIL;
+	}
+
+	S_RATEGROUP sGroup = { 0 };
+	SetBucket(sGroup.Bytes, sLimit.uiBytesPerSec, sLimit.uiBytesBurst);
+	SetBucket(sGroup.Msgs, sLimit.uiMsgsPerSec, sLimit.uiMsgsBurst);
+	sGroup.ullRefill = CRosaEventLoop::CRosaEventLoopGetTickMSec();
+	sGroup.uiHead = ROSA_RATELIMIT_NIL;
+	sGroup.bUsed = true;
+
+	m_vecGroup.push_back(sGroup);
+
+	return (UINT)m_vecGroup.size() - 1;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRateLimiterSetGroupLimit()
+// @Purpose: CRosaRateLimiter޸(Ͱװ)
+// @Since: v1.00a
+// @Para: UINT uiGroup()
+// @Para: const S_RATELIMIT& sLimit()
+// @Return: bool bRet (true:ɹ, false:鲻)
+//------------------------------------------------------------------
+bool ROSARATELIMITER_CALLMODE CRosaRateLimiter::CRosaRateLimiterSetGroupLimit(UINT uiGroup, const S_RATELIMIT & sLimit)
+{
+	CThreadSafe ThreadSafe(&m_csLimiter);
+
+	if (uiGroup >= m_vecGroup.size())
+	{
+		return false;
+	}
+
+	S_RATEGROUP& sGroup = m_vecGroup[uiGroup];
+	SetBucket(sGroup.Bytes, sLimit.uiBytesPerSec, sLimit.uiBytesBurst);
+	SetBucket(sGroup.Msgs, sLimit.uiMsgsPerSec, sLimit.uiMsgsBurst);
+	sGroup.ullRefill = CRosaEventLoop::CRosaEventLoopGetTickMSec();
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRateLimiterAddFlow()
+// @Purpose: CRosaRateLimiter
+// @Since: v1.00a
+// @Para: UINT uiGroup()
+// @Para: const S_RATELIMIT& sLimit()
+// @Para: UINT uiWeight(Ȩ, 01)
+// @Para: HANDLE_RATELIMIT_RESUME_CALLBACK pCallback(ָͻص)
+// @Para: DWORD_PTR dwUser(û)
+// @Return: UINT uiFlow (ROSA_RATELIMIT_NIL:鲻)
+//------------------------------------------------------------------
+UINT ROSARATELIMITER_CALLMODE CRosaRateLimiter::CRosaRateLimiterAddFlow(UINT uiGroup, const S_RATELIMIT & sLimit, UINT uiWeight, HANDLE_RATELIMIT_RESUME_CALLBACK pCallback, DWORD_PTR dwUser)
+{
+	if (pCallback == NULL)
+	{
+		return ROSA_RATELIMIT_NIL;
+	}
+
+	CThreadSafe ThreadSafe(&m_csLimiter);
+
+	if (uiGroup >= m_vecGroup.size())
+	{
+		return ROSA_RATELIMIT_NIL;
+	}
+
+	// ȸÿ
+	UINT uiFlow = m_uiFlowFree;
+	if (uiFlow != ROSA_RATELIMIT_NIL)
+	{
+		m_uiFlowFree = m_vecFlow[uiFlow].uiNext;
+	}
+	else
+	{
+		uiFlow = (UINT)m_vecFlow.size();
+		m_vecFlow.push_back(S_RATEFLOW());
+	}
+
+	S_RATEFLOW& sFlow = m_vecFlow[uiFlow];
+	memset(&sFlow, 0, sizeof(sFlow));
+	SetBucket(sFlow.Bytes, sLimit.uiBytesPerSec, sLimit.uiBytesBurst);
+	SetBucket(sFlow.Msgs, sLimit.uiMsgsPerSec, sLimit.uiMsgsBurst);
+	sFlow.ullRefill = CRosaEventLoop::CRosaEventLoopGetTickMSec();
+	sFlow.uiGroup = uiGroup;
+	sFlow.uiWeight = (uiWeight == 0) ? 1 : uiWeight;
+	sFlow.pCallback = pCallback;
+	sFlow.dwUser = dwUser;
+	sFlow.bUsed = true;
+	sFlow.uiPrev = ROSA_RATELIMIT_NIL;
+	sFlow.uiNext = ROSA_RATELIMIT_NIL;
+
+	m_uiFlowCount++;
+
+	return uiFlow;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRateLimiterSetFlowLimit()
+// @Purpose: CRosaRateLimiter޸ټȨ(Ͱװ, ѹ״̬)
+// @Since: v1.00a
+// @Para: UINT uiFlow()
+// @Para: const S_RATELIMIT& sLimit()
+// @Para: UINT uiWeight(Ȩ, 01)
+// @Return: bool bRet (true:ɹ, false:Ӳ)
+//------------------------------------------------------------------
+bool ROSARATELIMITER_CALLMODE CRosaRateLimiter::CRosaRateLimiterSetFlowLimit(UINT uiFlow, const S_RATELIMIT & sLimit, UINT uiWeight)
+{
+	CThreadSafe ThreadSafe(&m_csLimiter);
+
+	if (uiFlow >= m_vecFlow.size() || !m_vecFlow[uiFlow].bUsed)
+	{
+		return false;
+	}
+
+	S_RATEFLOW& sFlow = m_vecFlow[uiFlow];
+	SetBucket(sFlow.Bytes, sLimit.uiBytesPerSec, sLimit.uiBytesBurst);
+	SetBucket(sFlow.Msgs, sLimit.uiMsgsPerSec, sLimit.uiMsgsBurst);
+	sFlow.ullRefill = CRosaEventLoop::CRosaEventLoopGetTickMSec();
+	sFlow.uiWeight = (uiWeight == 0) ? 1 : uiWeight;
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRateLimiterRemoveFlow()
+// @Purpose: CRosaRateLimiterƳ(ڴٽص, غٻص)
+// @Since: v1.00a
+// @Para: UINT uiFlow()
+// @Return: None
+//------------------------------------------------------------------
+void ROSARATELIMITER_CALLMODE CRosaRateLimiter::CRosaRateLimiterRemoveFlow(UINT uiFlow)
+{
+	CThreadSafe ThreadSafe(&m_csLimiter);
+
+	if (uiFlow >= m_vecFlow.size() || !m_vecFlow[uiFlow].bUsed)
+	{
+		return;
+	}
+
+	if (m_vecFlow[uiFlow].bActive)
+	{
+		UnlinkFlow(uiFlow);
+	}
+
+	S_RATEFLOW& sFlow = m_vecFlow[uiFlow];
+	sFlow.bUsed = false;
+	sFlow.pCallback = NULL;
+	sFlow.uiNext = m_uiFlowFree;
+	m_uiFlowFree = uiFlow;
+
+	m_uiFlowCount--;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRateLimiterAcquire()
+// @Purpose: CRosaRateLimiter뷢ͶϢ(۳Ӽ; ӻѹʱʣת)
+// @Since: v1.00a
+// @Para: UINT uiFlow()
+// @Para: const UINT* puiSizes(׸Ϣ)
+// @Para: UINT uiCount(Ϣ)
+// @Para: bool bAll(ǷΪȫϢ, ȫк뿪ת)
+// @Return: UINT uiGranted (͵, 0ʱͣ, ֮ɻָص֪ͨ)
+//------------------------------------------------------------------
+UINT ROSARATELIMITER_CALLMODE CRosaRateLimiter::CRosaRateLimiterAcquire(UINT uiFlow, const UINT * puiSizes, UINT uiCount, bool bAll)
+{
+	CThreadSafe ThreadSafe(&m_csLimiter);
+
+	// ƳӲ
+	if (uiFlow >= m_vecFlow.size() || !m_vecFlow[uiFlow].bUsed)
+	{
+		return uiCount;
+	}
+
+	S_RATEFLOW& sFlow = m_vecFlow[uiFlow];
+	S_RATEGROUP& sGroup = m_vecGroup[sFlow.uiGroup];
+
+	m_sStats.ullAcquire++;
+
+	if (sFlow.bStalled)
+	{
+		return 0;
+	}
+
+	ULONGLONG ullNow = CRosaEventLoop::CRosaEventLoopGetTickMSec();
+	RefillFlow(sFlow, ullNow);
+	RefillGroup(sGroup, ullNow);
+
+	// ûоʱֻͰ, ʱ
+	bool bShared = (sGroup.Bytes.uiRate != 0 || sGroup.Msgs.uiRate != 0) && sGroup.uiActive > (sFlow.bActive ? 1U : 0U);
+
+	UINT uiGranted = 0;
+
+	while (uiGranted < uiCount)
+	{
+		UINT uiSize = puiSizes[uiGranted];
+
+		if (!HasTokens(sFlow.Bytes) || !HasTokens(sFlow.Msgs) || !HasTokens(sGroup.Bytes) || !HasTokens(sGroup.Msgs))
+		{
+			break;
+		}
+
+		// һ͸֧, ÿֶȵϢҲܷ
+		if (bShared && sFlow.llDeficit <= 0)
+		{
+			break;
+		}
+
+		TakeTokens(sFlow.Bytes, uiSize);
+		TakeTokens(sFlow.Msgs, 1);
+		TakeTokens(sGroup.Bytes, uiSize);
+		TakeTokens(sGroup.Msgs, 1);
+
+		if (bShared)
+		{
+			sFlow.llDeficit -= uiSize;
+		}
+
+		uiGranted++;
+	}
+
+	m_sStats.ullGranted += uiGranted;
+
+	if (uiGranted < uiCount)
+	{
+		// »ѹβ, ȴ0ʼ
+		if (!sFlow.bActive)
+		{
+			LinkFlow(uiFlow);
+		}
+
+		if (uiGranted == 0)
+		{
+			sFlow.bStalled = true;
+			m_sStats.ullStalled++;
+		}
+	}
+	else if (bAll && sFlow.bActive)
+	{
+		// зպ󲻱
+		UnlinkFlow(uiFlow);
+	}
+
+	return uiGranted;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRateLimiterGetFlowCount()
+// @Purpose: CRosaRateLimiterȡ
+// @Since: v1.00a
+// @Para: None
+// @Return: UINT uiCount
+//------------------------------------------------------------------
+UINT ROSARATELIMITER_CALLMODE CRosaRateLimiter::CRosaRateLimiterGetFlowCount()
+{
+	CThreadSafe ThreadSafe(&m_csLimiter);
+
+	return m_uiFlowCount;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRateLimiterGetStats()
+// @Purpose: CRosaRateLimiterȡͳ
+// @Since: v1.00a
+// @Para: S_RATELIMITSTATS& sStats(ͳ)
+// @Para: bool bReset(Ƿ)
+// @Return: None
+//------------------------------------------------------------------
+void ROSARATELIMITER_CALLMODE CRosaRateLimiter::CRosaRateLimiterGetStats(S_RATELIMITSTATS & sStats, bool bReset)
+{
+	CThreadSafe ThreadSafe(&m_csLimiter);
+
+	sStats = m_sStats;
+
+	if (bReset)
+	{
+		memset(&m_sStats, 0, sizeof(m_sStats));
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 SetBucket()
+// @Purpose: CRosaRateLimiterͰ(װ)
+// @Since: v1.00a
+// @Para: S_TOKENBUCKET& sBucket(Ͱ)
+// @Para: UINT uiRate(, 0:)
+// @Para: UINT uiBurst(ͻ, 0:*ROSA_RATELIMIT_BURST_MSEC)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaRateLimiter::SetBucket(S_TOKENBUCKET & sBucket, UINT uiRate, UINT uiBurst)
+{
+	ULONGLONG ullBurst = uiBurst;
+	if (ullBurst == 0)
+	{
+		ullBurst = (ULONGLONG)uiRate * ROSA_RATELIMIT_BURST_MSEC / 1000;
+		ullBurst = (ullBurst == 0) ? 1 : ullBurst;
+	}
+
+	sBucket.uiRate = uiRate;
+	sBucket.llBurst = (LONGLONG)ullBurst * 1000;
+	sBucket.llTokens = sBucket.llBurst;
+}
+
+//------------------------------------------------------------------
+// @Function:	 RefillBucket()
+// @Purpose: CRosaRateLimiterʱ䲹(ǧ֮һλ, *û)
+// @Since: v1.00a
+// @Para: S_TOKENBUCKET& sBucket(Ͱ)
+// @Para: ULONGLONG ullElapsed()
+// @Return: None
+//------------------------------------------------------------------
+void CRosaRateLimiter::RefillBucket(S_TOKENBUCKET & sBucket, ULONGLONG ullElapsed)
+{
+	if (sBucket.uiRate == 0 || sBucket.llTokens >= sBucket.llBurst)
+	{
+		return;
+	}
+
+	// 㹻װʱ˷, кܾõ
+	if (ullElapsed > (ULONGLONG)((sBucket.llBurst - sBucket.llTokens) / sBucket.uiRate))
+	{
+		sBucket.llTokens = sBucket.llBurst;
+		return;
+	}
+
+	sBucket.llTokens += (LONGLONG)sBucket.uiRate * (LONGLONG)ullElapsed;
+}
+
+//------------------------------------------------------------------
+// @Function:	 HasTokens()
+// @Purpose: CRosaRateLimiterͰǷԷ(ʣ༴, ͰϢ͸֧ȴ)
+// @Since: v1.00a
+// @Para: const S_TOKENBUCKET& sBucket(Ͱ)
+// @Return: bool bRet
+//------------------------------------------------------------------
+bool CRosaRateLimiter::HasTokens(const S_TOKENBUCKET & sBucket)
+{
+	return (sBucket.uiRate == 0 || sBucket.llTokens > 0);
+}
+
+//------------------------------------------------------------------
+// @Function:	 TakeTokens()
+// @Purpose: CRosaRateLimiter۳
+// @Since: v1.00a
+// @Para: S_TOKENBUCKET& sBucket(Ͱ)
+// @Para: UINT uiCount()
+// @Return: None
+//------------------------------------------------------------------
+void CRosaRateLimiter::TakeTokens(S_TOKENBUCKET & sBucket, UINT uiCount)
+{
+	if (sBucket.uiRate != 0)
+	{
+		sBucket.llTokens -= (LONGLONG)uiCount * 1000;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 RefillGroup()
+// @Purpose: CRosaRateLimiter(߳m_csLimiter)
+// @Since: v1.00a
+// @Para: S_RATEGROUP& sGroup()
+// @Para: ULONGLONG ullNow(ǰʱ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaRateLimiter::RefillGroup(S_RATEGROUP & sGroup, ULONGLONG ullNow)
+{
+	if (ullNow > sGroup.ullRefill)
+	{
+		RefillBucket(sGroup.Bytes, ullNow - sGroup.ullRefill);
+		RefillBucket(sGroup.Msgs, ullNow - sGroup.ullRefill);
+		sGroup.ullRefill = ullNow;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 RefillFlow()
+// @Purpose: CRosaRateLimiter(߳m_csLimiter)
+// @Since: v1.00a
+// @Para: S_RATEFLOW& sFlow()
+// @Para: ULONGLONG ullNow(ǰʱ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaRateLimiter::RefillFlow(S_RATEFLOW & sFlow, ULONGLONG ullNow)
+{
+	if (ullNow > sFlow.ullRefill)
+	{
+		RefillBucket(sFlow.Bytes, ullNow - sFlow.ullRefill);
+		RefillBucket(sFlow.Msgs, ullNow - sFlow.ullRefill);
+		sFlow.ullRefill = ullNow;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 LinkFlow()
+// @Purpose: CRosaRateLimiterӼתβ(һöȵ֮ǰ, ߳m_csLimiter)
+// @Since: v1.00a
+// @Para: UINT uiFlow()
+// @Return: None
+//------------------------------------------------------------------
+void CRosaRateLimiter::LinkFlow(UINT uiFlow)
+{
+	S_RATEFLOW& sFlow = m_vecFlow[uiFlow];
+	S_RATEGROUP& sGroup = m_vecGroup[sFlow.uiGroup];
+
+	if (sGroup.uiHead == ROSA_RATELIMIT_NIL)
+	{
+		sFlow.uiPrev = uiFlow;
+		sFlow.uiNext = uiFlow;
+		sGroup.uiHead = uiFlow;
+	}
+	else
+	{
+		UINT uiTail = m_vecFlow[sGroup.uiHead].uiPrev;
+
+		sFlow.uiPrev = uiTail;
+		sFlow.uiNext = sGroup.uiHead;
+		m_vecFlow[uiTail].uiNext = uiFlow;
+		m_vecFlow[sGroup.uiHead].uiPrev = uiFlow;
+	}
+
+	sFlow.bActive = true;
+	sFlow.llDeficit = 0;
+	sGroup.uiActive++;
+}
+
+//------------------------------------------------------------------
+// @Function:	 UnlinkFlow()
+// @Purpose: CRosaRateLimiterƳת(߳m_csLimiter)
+// @Since: v1.00a
+// @Para: UINT uiFlow()
+// @Return: None
+//------------------------------------------------------------------
+void CRosaRateLimiter::UnlinkFlow(UINT uiFlow)
+{
+	S_RATEFLOW& sFlow = m_vecFlow[uiFlow];
+	S_RATEGROUP& sGroup = m_vecGroup[sFlow.uiGroup];
+
+	if (sFlow.uiNext == uiFlow)
+	{
+		sGroup.uiHead = ROSA_RATELIMIT_NIL;
+	}
+	else
+	{
+		m_vecFlow[sFlow.uiPrev].uiNext = sFlow.uiNext;
+		m_vecFlow[sFlow.uiNext].uiPrev = sFlow.uiPrev;
+
+		if (sGroup.uiHead == uiFlow)
+		{
+			sGroup.uiHead = sFlow.uiNext;
+		}
+	}
+
+	sFlow.uiPrev = ROSA_RATELIMIT_NIL;
+	sFlow.uiNext = ROSA_RATELIMIT_NIL;
+	sFlow.bActive = false;
+	sFlow.bStalled = false;
+	sFlow.llDeficit = 0;
+	sGroup.uiActive--;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ProcessTick()
+// @Purpose: CRosaRateLimiterƲת(ʱ, һڴͣµӼ)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaRateLimiter::ProcessTick()
+{
+	LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+
+	CThreadSafe ThreadSafe(&m_csLimiter);
+
+	ULONGLONG ullNow = CRosaEventLoop::CRosaEventLoopGetTickMSec();
+
+	for (vector<S_RATEGROUP>::iterator iter = m_vecGroup.begin(); iter != m_vecGroup.end(); ++iter)
+	{
+		S_RATEGROUP& sGroup = *iter;
+
+		if (sGroup.uiActive == 0)
+		{
+			continue;
+		}
+
+		RefillGroup(sGroup, ullNow);
+
+		if (!HasTokens(sGroup.Bytes) || !HasTokens(sGroup.Msgs))
+		{
+			continue;
+		}
+
+		// 鲻ʱÿֻͰ, ָһ鼴
+		bool bShared = (sGroup.Bytes.uiRate != 0 || sGroup.Msgs.uiRate != 0);
+		LONGLONG llBudget = (sGroup.Bytes.uiRate != 0) ? sGroup.Bytes.llTokens / 1000 : 0;
+		UINT uiVisit = sGroup.uiActive * (bShared && sGroup.Bytes.uiRate != 0 ? ROSA_RATELIMIT_MAX_ROUNDS : 1);
+		UINT uiFlow = sGroup.uiHead;
+
+		for (UINT i = 0; i < uiVisit; ++i)
+		{
+			S_RATEFLOW& sFlow = m_vecFlow[uiFlow];
+			UINT uiNext = sFlow.uiNext;
+
+			RefillFlow(sFlow, ullNow);
+
+			if (HasTokens(sFlow.Bytes) && HasTokens(sFlow.Msgs))
+			{
+				if (bShared)
+				{
+					LONGLONG llQuantum = (LONGLONG)m_uiQuantum * sFlow.uiWeight;
+
+					if (sFlow.llDeficit < llQuantum * ROSA_RATELIMIT_MAX_ROUNDS)
+					{
+						sFlow.llDeficit += llQuantum;
+						llBudget -= llQuantum;
+					}
+				}
+
+				if (sFlow.bStalled)
+				{
+					sFlow.bStalled = false;
+					sFlow.pCallback(sFlow.dwUser);
+					m_sStats.ullResumed++;
+				}
+			}
+
+			uiFlow = uiNext;
+
+			// Ʒ, һڴ
+			if (sGroup.Bytes.uiRate != 0 && llBudget <= 0)
+			{
+				break;
+			}
+		}
+
+		// Ϣٻٵÿǰһ, ͬһȷ
+		sGroup.uiHead = (sGroup.Bytes.uiRate != 0) ? uiFlow : m_vecFlow[sGroup.uiHead].uiNext;
+	}
+
+	ULONGLONG ullNanoSec = CRosaHistogram::CRosaHistogramToNanoSec(CRosaHistogram::CRosaHistogramNow() - llStart);
+
+	m_sStats.ullTicks++;
+	m_sStats.ullTickNanoSec += ullNanoSec;
+	m_sStats.ullTickMaxNanoSec = max(m_sStats.ullTickMaxNanoSec, ullNanoSec);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnTickTimer()
+// @Purpose: CRosaRateLimiterڶʱ
+// @Since: v1.00a
+// @Para: ULONGLONG ullTimerID(ʱID)
+// @Para: void* pUser()
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaRateLimiter::OnTickTimer(ULONGLONG ullTimerID, void * pUser)
+{
+	CRosaRateLimiter* pLimiter = reinterpret_cast<CRosaRateLimiter*>(pUser);
+
+	pLimiter->ProcessTick();
+}
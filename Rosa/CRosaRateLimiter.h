@@ -0,0 +1,149 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaRateLimiter.h
+* @brief	This File is RosaRateLimiter Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSARATELIMITER_H__
+#define __CROSARATELIMITER_H__
+
+//Include Rosa Header File
+#include "CRosaEventLoop.h"
+
+//Include C/C++ Header File
+#include <vector>
+
+using namespace std;
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSARATELIMITER_API	__declspec(dllexport)
+#else
+#define ROSARATELIMITER_API	__declspec(dllimport)
+#endif
+
+#define ROSARATELIMITER_CALLMODE	__stdcall
+
+#define ROSA_RATELIMIT_QUANTUM			4096			//ÿÿλȨӵķͶ(ֽ, жӻѹʱЧ)
+#define ROSA_RATELIMIT_TICK_MSEC		ROSA_LOOP_TICK_MSEC	//Ƽת()
+#define ROSA_RATELIMIT_BURST_MSEC		100				//δָͻʱʱʼ
+#define ROSA_RATELIMIT_MAX_ROUNDS		16				//ÿÿת(ҲǶ޵ı)
+#define ROSA_RATELIMIT_GROUP_DEFAULT	0				//Ĭ(ʱ)
+#define ROSA_RATELIMIT_NIL				((UINT)-1)		//
+
+//Struct Definition
+typedef struct
+{
+	UINT uiBytesPerSec;						// ֽ(0:)
+	UINT uiBytesBurst;						// ֽͻ(0:*ROSA_RATELIMIT_BURST_MSEC)
+	UINT uiMsgsPerSec;						// Ϣ(0:)
+	UINT uiMsgsBurst;						// Ϣͻ(0:*ROSA_RATELIMIT_BURST_MSEC)
+}S_RATELIMIT, *LPS_RATELIMIT;
+
+typedef struct
+{
+	UINT uiRate;							// (ÿ, 0:)
+	LONGLONG llBurst;						// Ͱ(ǧ֮һλ)
+	LONGLONG llTokens;						// ǰ(ǧ֮һλ, Ϣ͸֧Ϊ)
+}S_TOKENBUCKET, *LPS_TOKENBUCKET;
+
+typedef struct
+{
+	S_TOKENBUCKET Bytes;					// ֽͰ
+	S_TOKENBUCKET Msgs;						// ϢͰ
+	ULONGLONG ullRefill;					// ϴβʱ()
+	UINT uiHead;							// תһöȵ
+	UINT uiActive;							// ѹе
+	bool bUsed;								// ǷѴ
+}S_RATEGROUP, *LPS_RATEGROUP;
+
+//Callback Definition
+typedef void(__stdcall *HANDLE_RATELIMIT_RESUME_CALLBACK)(DWORD_PTR dwUser);	//ָͻص(ڶʱ߳гٽ, ֻͶɰ, Ե)
+
+typedef struct
+{
+	S_TOKENBUCKET Bytes;					// ֽͰ
+	S_TOKENBUCKET Msgs;						// ϢͰ
+	ULONGLONG ullRefill;					// ϴβʱ()
+	UINT uiGroup;							// 
+	UINT uiWeight;							// Ȩ(ÿֶΪȨ*ROSA_RATELIMIT_QUANTUM)
+	LONGLONG llDeficit;						// ʣ(ֽ)
+	HANDLE_RATELIMIT_RESUME_CALLBACK pCallback;	// ָͻص
+	DWORD_PTR dwUser;						// û
+	bool bUsed;								// Ƿʹ
+	bool bActive;							// Ƿת(лѹ)
+	bool bStalled;							// Ƿͣ(ȴָص)
+	UINT uiPrev;							// תǰһ
+	UINT uiNext;							// תһ(ʱָһ)
+}S_RATEFLOW, *LPS_RATEFLOW;
+
+typedef struct
+{
+	ULONGLONG ullAcquire;					// 
+	ULONGLONG ullGranted;					// еϢ
+	ULONGLONG ullStalled;					// ͣ
+	ULONGLONG ullResumed;					// ָ
+	ULONGLONG ullTicks;						// ڴ
+	ULONGLONG ullTickNanoSec;				// ڴܺʱ()
+	ULONGLONG ullTickMaxNanoSec;			// ڴʱ()
+}S_RATELIMITSTATS, *LPS_RATELIMITSTATS;
+
+//Class Definition
+class ROSARATELIMITER_API CRosaRateLimiter
+{
+public:
+	CRosaRateLimiter();			// CRosaRateLimiter 캯
+	~CRosaRateLimiter();		// CRosaRateLimiter 
+
+public:
+	bool ROSARATELIMITER_CALLMODE CRosaRateLimiterCreate(CRosaEventLoop* pLoop, UINT uiQuantum = ROSA_RATELIMIT_QUANTUM, DWORD dwTickMSec = ROSA_RATELIMIT_TICK_MSEC);	// CRosaRateLimiter ¼ѭʼ
+	void ROSARATELIMITER_CALLMODE CRosaRateLimiterDestroy();											// CRosaRateLimiter ֹͣʱƳȫ鼰(ƳͶ)
+
+	UINT ROSARATELIMITER_CALLMODE CRosaRateLimiterCreateGroup(const S_RATELIMIT& sLimit);				// CRosaRateLimiter (, ROSA_RATELIMIT_NIL:ʧ)
+	bool ROSARATELIMITER_CALLMODE CRosaRateLimiterSetGroupLimit(UINT uiGroup, const S_RATELIMIT& sLimit);	// CRosaRateLimiter ޸(Ĭ)
+
+	UINT ROSARATELIMITER_CALLMODE CRosaRateLimiterAddFlow(UINT uiGroup, const S_RATELIMIT& sLimit, UINT uiWeight, HANDLE_RATELIMIT_RESUME_CALLBACK pCallback, DWORD_PTR dwUser);	// CRosaRateLimiter (, ROSA_RATELIMIT_NIL:ʧ)
+	bool ROSARATELIMITER_CALLMODE CRosaRateLimiterSetFlowLimit(UINT uiFlow, const S_RATELIMIT& sLimit, UINT uiWeight);		// CRosaRateLimiter ޸ټȨ
+	void ROSARATELIMITER_CALLMODE CRosaRateLimiterRemoveFlow(UINT uiFlow);								// CRosaRateLimiter Ƴ(غٻص)
+
+	UINT ROSARATELIMITER_CALLMODE CRosaRateLimiterAcquire(UINT uiFlow, const UINT* puiSizes, UINT uiCount, bool bAll);	// CRosaRateLimiter 뷢ͶϢ(ؿ͵, 0ʱָͣص)
+
+	UINT ROSARATELIMITER_CALLMODE CRosaRateLimiterGetFlowCount();										// CRosaRateLimiter ȡ
+	void ROSARATELIMITER_CALLMODE CRosaRateLimiterGetStats(S_RATELIMITSTATS& sStats, bool bReset = false);	// CRosaRateLimiter ȡͳ
+
+private:
+	static void SetBucket(S_TOKENBUCKET& sBucket, UINT uiRate, UINT uiBurst);				// CRosaRateLimiter Ͱ(װ)
+	static void RefillBucket(S_TOKENBUCKET& sBucket, ULONGLONG ullElapsed);				// CRosaRateLimiter ʱ䲹
+	static bool HasTokens(const S_TOKENBUCKET& sBucket);									// CRosaRateLimiter ͰǷԷ
+	static void TakeTokens(S_TOKENBUCKET& sBucket, UINT uiCount);							// CRosaRateLimiter ۳
+
+	void RefillGroup(S_RATEGROUP& sGroup, ULONGLONG ullNow);								// CRosaRateLimiter (߳m_csLimiter)
+	void RefillFlow(S_RATEFLOW& sFlow, ULONGLONG ullNow);									// CRosaRateLimiter (߳m_csLimiter)
+	void LinkFlow(UINT uiFlow);																// CRosaRateLimiter Ӽתβ(߳m_csLimiter)
+	void UnlinkFlow(UINT uiFlow);															// CRosaRateLimiter Ƴת(߳m_csLimiter)
+	void ProcessTick();																		// CRosaRateLimiter Ʋת, ָͣ
+
+	static void __stdcall OnTickTimer(ULONGLONG ullTimerID, void* pUser);					// CRosaRateLimiter ڶʱ
+
+private:
+	CRosaEventLoop* m_pLoop;								// CRosaRateLimiter ¼ѭ
+	ULONGLONG m_ullTickTimerID;								// CRosaRateLimiter ڶʱ
+	UINT m_uiQuantum;										// CRosaRateLimiter ÿֶ(ֽ)
+
+	CRITICAL_SECTION m_csLimiter;							// CRosaRateLimiter ٽ
+	vector<S_RATEGROUP> m_vecGroup;							// CRosaRateLimiter (->)
+	vector<S_RATEFLOW> m_vecFlow;							// CRosaRateLimiter ӳ(->)
+	UINT m_uiFlowFree;										// CRosaRateLimiter 
+	UINT m_uiFlowCount;										// CRosaRateLimiter ʹе
+	S_RATELIMITSTATS m_sStats;								// CRosaRateLimiter ͳ
+
+};
+
+#endif // !__CROSARATELIMITER_H__
@@ -0,0 +1,723 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaReConnector.cpp
+* @brief	This File is RosaReConnector Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaReConnector.h"
+#include "CThreadSafe.h"
+
+#pragma warning(disable:4996)
+
+//CRosaReConnector (ʱ, ָ˱+)
+
+//------------------------------------------------------------------
+// @Function:	 CRosaReConnector()
+// @Purpose: CRosaReConnector캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaReConnector::CRosaReConnector()
+{
+	m_pLoop = NULL;
+	m_ullScanTimerID = 0;
+
+	m_pCallback = NULL;
+	m_dwUser = 0;
+
+	m_dwBaseMSec = ROSA_RECONNECT_BASE_MSEC;
+	m_dwMaxMSec = ROSA_RECONNECT_MAX_MSEC;
+	m_uiQueueMax = ROSA_RECONNECT_QUEUE_MAX;
+
+	m_ullNextLinkID = 1;
+	m_ullRandom = 0;
+
+	InitializeCriticalSection(&m_csLink);
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaReConnector()
+// @Purpose: CRosaReConnector
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaReConnector::~CRosaReConnector()
+{
+	CRosaReConnectorDestroy();
+
+	DeleteCriticalSection(&m_csLink);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaReConnectorCreate()
+// @Purpose: CRosaReConnector¼ѭ
+// @Since: v1.00a
+// @Para: CRosaEventLoop* pLoop(Ѿ¼ѭ)
+// @Para: HANDLE_LINK_STATE_CALLBACK pCallback(״̬仯ص, ΪNULL)
+// @Para: DWORD_PTR dwUser(û)
+// @Para: DWORD dwBaseMSec(˱ܻ׼ʱ)
+// @Para: DWORD dwMaxMSec(˱)
+// @Para: UINT uiQueueMax(ڼÿ󻺴ֽ)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSARECONNECTOR_CALLMODE CRosaReConnector::CRosaReConnectorCreate(CRosaEventLoop * pLoop, HANDLE_LINK_STATE_CALLBACK pCallback, DWORD_PTR dwUser, DWORD dwBaseMSec, DWORD dwMaxMSec, UINT uiQueueMax)
+{
+	if (m_pLoop != NULL || pLoop == NULL || dwBaseMSec == 0 || dwMaxMSec < dwBaseMSec)
+	{
+		return false;
+	}
+
+	if (!m_Connector.CRosaConnectorCreate(pLoop))
+	{
+		return false;
+	}
+
+	m_pLoop = pLoop;
+	m_pCallback = pCallback;
+	m_dwUser = dwUser;
+
+	m_dwBaseMSec = dwBaseMSec;
+	m_dwMaxMSec = dwMaxMSec;
+	m_uiQueueMax = uiQueueMax;
+
+	// (̡ͬͬʵĶвͬ)
+	m_ullRandom = CRosaEventLoop::CRosaEventLoopGetTickMSec() ^ ((ULONGLONG)GetCurrentProcessId() << 32) ^ (ULONGLONG)(ULONG_PTR)this;
+	if (m_ullRandom == 0)
+	{
+		m_ullRandom = 0x9E3779B97F4A7C15ULL;
+	}
+
+	m_ullScanTimerID = m_pLoop->CRosaEventLoopSetTimer(ROSA_RECONNECT_SCAN_MSEC, ROSA_RECONNECT_SCAN_MSEC, OnScanTimer, this);
+	if (m_ullScanTimerID == 0)
+	{
+		m_Connector.CRosaConnectorDestroy();
+		m_pLoop = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaReConnectorDestroy()
+// @Purpose: CRosaReConnectorϿƳȫ(ͷCRosaSocket, ѭ߳е)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSARECONNECTOR_CALLMODE CRosaReConnector::CRosaReConnectorDestroy()
+{
+	if (m_pLoop == NULL)
+	{
+		return;
+	}
+
+	m_pLoop->CRosaEventLoopKillTimer(m_ullScanTimerID);
+	m_ullScanTimerID = 0;
+
+	// еӱȡҲٻص
+	m_Connector.CRosaConnectorDestroy();
+
+	EnterCriticalSection(&m_csLink);
+
+	// ȡͶе첽
+	for (map<ULONGLONG, LPS_RECONNECTLINK>::iterator iter = m_mapLink.begin(); iter != m_mapLink.end(); ++iter)
+	{
+		iter->second->bRemoved = true;
+
+		if (iter->second->bDraining)
+		{
+			CancelIoEx((HANDLE)iter->second->pSocket->CRosaSocketGetRawSocket(), &iter->second->DrainOverlapped.Overlapped);
+		}
+	}
+
+	// ȴڷ͵̷߳ؼ¼ѭȡɰ(ѭ߳е)
+	for (;;)
+	{
+		bool bSending = false;
+		bool bRunning = m_pLoop->CRosaEventLoopIsRunning();
+
+		for (map<ULONGLONG, LPS_RECONNECTLINK>::iterator iter = m_mapLink.begin(); iter != m_mapLink.end(); ++iter)
+		{
+			bSending = bSending || (iter->second->bSending && (bRunning || !iter->second->bDraining));
+		}
+
+		if (!bSending)
+		{
+			break;
+		}
+
+		LeaveCriticalSection(&m_csLink);
+		Sleep(1);
+		EnterCriticalSection(&m_csLink);
+	}
+
+	for (map<ULONGLONG, LPS_RECONNECTLINK>::iterator iter = m_mapLink.begin(); iter != m_mapLink.end(); ++iter)
+	{
+		iter->second->pSocket->CRosaSocketDisConnect();
+		delete iter->second;
+	}
+
+	m_mapLink.clear();
+	m_mapConnect.clear();
+
+	LeaveCriticalSection(&m_csLink);
+
+	m_pLoop = NULL;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaReConnectorAdd()
+// @Purpose: CRosaReConnectorӿͻ(һڿʼ)
+// @Since: v1.00a
+// @Para: CRosaSocket* pSocket(ͻ׽, Ƴǰͷ)
+// @Para: const char* pcHost(IPַ)
+// @Para: USHORT sPort(˿ں)
+// @Return: ULONGLONG ullLinkID (0:ʧ)
+//------------------------------------------------------------------
+ULONGLONG ROSARECONNECTOR_CALLMODE CRosaReConnector::CRosaReConnectorAdd(CRosaSocket * pSocket, const char * pcHost, USHORT sPort)
+{
+	if (m_pLoop == NULL || pSocket == NULL)
+	{
+		return 0;
+	}
+
+	LPS_RECONNECTLINK pLink = new S_RECONNECTLINK;
+
+	// ʱһΣʱDNS
+	if (CRosaResolver::CRosaResolverGetDefault().CRosaResolverResolve(pcHost, pLink->vecAddress) != SOB_RET_OK)
+	{
+		delete pLink;
+		return 0;
+	}
+
+	CRosaResolver::CRosaResolverSetPort(pLink->vecAddress, sPort);
+
+	pLink->pSocket = pSocket;
+	pLink->nState = ROSA_LINK_STATE_DISCONNECTED;
+	pLink->uiAttempts = 0;
+	pLink->ullRetryAt = 0;
+	pLink->ullConnectID = 0;
+	pLink->uiQueueBytes = 0;
+	pLink->bSending = false;
+	pLink->bDraining = false;
+	pLink->bRemoved = false;
+	pLink->pOwner = this;
+
+	memset(&pLink->DrainOverlapped, 0, sizeof(pLink->DrainOverlapped));
+	pLink->DrainOverlapped.pCallback = OnDrainComplete;
+	pLink->DrainOverlapped.pUser = pLink;
+
+	CThreadSafe ThreadSafe(&m_csLink);
+
+	pLink->ullLinkID = m_ullNextLinkID++;
+	m_mapLink.insert(pair<ULONGLONG, LPS_RECONNECTLINK>(pLink->ullLinkID, pLink));
+
+	return pLink->ullLinkID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaReConnectorRemove()
+// @Purpose: CRosaReConnectorƳͻ(ϿͷCRosaSocket, )
+// @Since: v1.00a
+// @Para: ULONGLONG ullLinkID(ID)
+// @Return: bool bRet (true:ɹ, false:)
+//------------------------------------------------------------------
+bool ROSARECONNECTOR_CALLMODE CRosaReConnector::CRosaReConnectorRemove(ULONGLONG ullLinkID)
+{
+	ULONGLONG ullConnectID = 0;
+
+	EnterCriticalSection(&m_csLink);
+
+	map<ULONGLONG, LPS_RECONNECTLINK>::iterator iter = m_mapLink.find(ullLinkID);
+	if (iter == m_mapLink.end() || iter->second->bRemoved)
+	{
+		LeaveCriticalSection(&m_csLink);
+		return false;
+	}
+
+	iter->second->bRemoved = true;
+
+	if (iter->second->nState == ROSA_LINK_STATE_CONNECTING)
+	{
+		ullConnectID = iter->second->ullConnectID;
+	}
+
+	// Ͷе첽ȡɻصͱ־
+	if (iter->second->bDraining)
+	{
+		CancelIoEx((HANDLE)iter->second->pSocket->CRosaSocketGetRawSocket(), &iter->second->DrainOverlapped.Overlapped);
+	}
+
+	LeaveCriticalSection(&m_csLink);
+
+	// ȡصڵǰִ߳(ɳm_csLink)
+	if (ullConnectID != 0)
+	{
+		m_Connector.CRosaConnectorCancel(ullConnectID);
+	}
+
+	EnterCriticalSection(&m_csLink);
+
+	// ڷͻӵͷ
+	iter = m_mapLink.find(ullLinkID);
+	if (iter != m_mapLink.end() && !iter->second->bSending && iter->second->nState != ROSA_LINK_STATE_CONNECTING)
+	{
+		iter->second->pSocket->CRosaSocketDisConnect();
+		delete iter->second;
+		m_mapLink.erase(iter);
+	}
+
+	LeaveCriticalSection(&m_csLink);
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaReConnectorSend()
+// @Purpose: CRosaReConnector(ڵֱ߳ӷ, 򻺴¼ѭ첽)
+// @Since: v1.00a
+// @Para: ULONGLONG ullLinkID(ID)
+// @Para: const char* pSendBuffer()
+// @Para: UINT uiBufferSize(ݳ)
+// @Return: int nRet (SOB_RET_OK:ѷͻѻ, SOB_RET_FAIL:Ӳڻ򻺴, :ʧܲѶϿ)
+//------------------------------------------------------------------
+int ROSARECONNECTOR_CALLMODE CRosaReConnector::CRosaReConnectorSend(ULONGLONG ullLinkID, const char * pSendBuffer, UINT uiBufferSize)
+{
+	vector<S_LINKSTATEEVENT> vecEvent;
+
+	if (pSendBuffer == NULL || uiBufferSize == 0)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	EnterCriticalSection(&m_csLink);
+
+	map<ULONGLONG, LPS_RECONNECTLINK>::iterator iter = m_mapLink.find(ullLinkID);
+	if (iter == m_mapLink.end() || iter->second->bRemoved)
+	{
+		LeaveCriticalSection(&m_csLink);
+		return SOB_RET_FAIL;
+	}
+
+	LPS_RECONNECTLINK pLink = iter->second;
+
+	// δӡ߳ڷͻлʱŶӣ֤˳
+	if (pLink->nState != ROSA_LINK_STATE_CONNECTED || pLink->bSending || !pLink->dqQueue.empty())
+	{
+		if (pLink->uiQueueBytes + uiBufferSize > m_uiQueueMax)
+		{
+			LeaveCriticalSection(&m_csLink);
+			return SOB_RET_FAIL;
+		}
+
+		pLink->dqQueue.push_back(vector<char>(pSendBuffer, pSendBuffer + uiBufferSize));
+		pLink->uiQueueBytes += uiBufferSize;
+
+		DrainQueue(pLink, vecEvent);
+
+		LeaveCriticalSection(&m_csLink);
+
+		Notify(vecEvent);
+		return SOB_RET_OK;
+	}
+
+	pLink->bSending = true;
+
+	LeaveCriticalSection(&m_csLink);
+
+	int nRet = pLink->pSocket->CRosaSocketSendBuffer(const_cast<char*>(pSendBuffer), uiBufferSize, ROSA_RECONNECT_SEND_TIMEOUT);
+
+	EnterCriticalSection(&m_csLink);
+
+	pLink->bSending = false;
+
+	if (nRet != SOB_RET_OK)
+	{
+		MarkBroken(pLink, vecEvent);
+	}
+	else
+	{
+		// ڼ߳Ŷӵ
+		DrainQueue(pLink, vecEvent);
+	}
+
+	LeaveCriticalSection(&m_csLink);
+
+	Notify(vecEvent);
+
+	return nRet;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaReConnectorReportBroken()
+// @Purpose: CRosaReConnectorӶϿ(շSOB_RET_CLOSESOB_RET_FAILʱ)
+// @Since: v1.00a
+// @Para: ULONGLONG ullLinkID(ID)
+// @Return: None
+//------------------------------------------------------------------
+void ROSARECONNECTOR_CALLMODE CRosaReConnector::CRosaReConnectorReportBroken(ULONGLONG ullLinkID)
+{
+	vector<S_LINKSTATEEVENT> vecEvent;
+
+	EnterCriticalSection(&m_csLink);
+
+	// ڷ͵̻߳ڷʧܺжϿ
+	map<ULONGLONG, LPS_RECONNECTLINK>::iterator iter = m_mapLink.find(ullLinkID);
+	if (iter != m_mapLink.end() && !iter->second->bRemoved && !iter->second->bSending)
+	{
+		MarkBroken(iter->second, vecEvent);
+	}
+
+	LeaveCriticalSection(&m_csLink);
+
+	Notify(vecEvent);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaReConnectorGetState()
+// @Purpose: CRosaReConnectorȡ״̬
+// @Since: v1.00a
+// @Para: ULONGLONG ullLinkID(ID)
+// @Return: int nState (ROSA_LINK_STATE_*, ڷ-1)
+//------------------------------------------------------------------
+int ROSARECONNECTOR_CALLMODE CRosaReConnector::CRosaReConnectorGetState(ULONGLONG ullLinkID)
+{
+	CThreadSafe ThreadSafe(&m_csLink);
+
+	map<ULONGLONG, LPS_RECONNECTLINK>::iterator iter = m_mapLink.find(ullLinkID);
+	if (iter == m_mapLink.end() || iter->second->bRemoved)
+	{
+		return -1;
+	}
+
+	return iter->second->nState;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaReConnectorGetLinkCount()
+// @Purpose: CRosaReConnectorȡ
+// @Since: v1.00a
+// @Para: None
+// @Return: int nCount
+//------------------------------------------------------------------
+int ROSARECONNECTOR_CALLMODE CRosaReConnector::CRosaReConnectorGetLinkCount()
+{
+	CThreadSafe ThreadSafe(&m_csLink);
+	return (int)m_mapLink.size();
+}
+
+//------------------------------------------------------------------
+// @Function:	 GetBackOff()
+// @Purpose: CRosaReConnector˱ʱ(: ޵һ̶, һ, ߳m_csLink)
+// @Since: v1.00a
+// @Para: UINT uiAttempts(ʧܴ)
+// @Return: DWORD dwMSec
+//------------------------------------------------------------------
+DWORD CRosaReConnector::GetBackOff(UINT uiAttempts)
+{
+	ULONGLONG ullCap = (ULONGLONG)m_dwBaseMSec << (uiAttempts < 16 ? uiAttempts : 16);
+	if (ullCap > m_dwMaxMSec)
+	{
+		ullCap = m_dwMaxMSec;
+	}
+
+	// xorshift64
+	m_ullRandom ^= m_ullRandom << 13;
+	m_ullRandom ^= m_ullRandom >> 7;
+	m_ullRandom ^= m_ullRandom << 17;
+
+	DWORD dwHalf = (DWORD)(ullCap / 2);
+
+	return dwHalf + (DWORD)(m_ullRandom % ((ULONGLONG)(ullCap - dwHalf) + 1));
+}
+
+//------------------------------------------------------------------
+// @Function:	 SetState()
+// @Purpose: CRosaReConnectorл״̬¼״̬仯(߳m_csLink)
+// @Since: v1.00a
+// @Para: LPS_RECONNECTLINK pLink()
+// @Para: int nState(״̬)
+// @Para: vector<S_LINKSTATEEVENT>& vecEvent(ص״̬仯)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaReConnector::SetState(LPS_RECONNECTLINK pLink, int nState, vector<S_LINKSTATEEVENT>& vecEvent)
+{
+	if (pLink->nState == nState)
+	{
+		return;
+	}
+
+	if (!pLink->bRemoved)
+	{
+		S_LINKSTATEEVENT sEvent;
+
+		sEvent.ullLinkID = pLink->ullLinkID;
+		sEvent.pSocket = pLink->pSocket;
+		sEvent.nOldState = pLink->nState;
+		sEvent.nNewState = nState;
+
+		vecEvent.push_back(sEvent);
+	}
+
+	pLink->nState = nState;
+}
+
+//------------------------------------------------------------------
+// @Function:	 MarkBroken()
+// @Purpose: CRosaReConnectorϿӲ˱ʱ(߳m_csLink)
+// @Since: v1.00a
+// @Para: LPS_RECONNECTLINK pLink()
+// @Para: vector<S_LINKSTATEEVENT>& vecEvent(ص״̬仯)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaReConnector::MarkBroken(LPS_RECONNECTLINK pLink, vector<S_LINKSTATEEVENT>& vecEvent)
+{
+	if (pLink->nState != ROSA_LINK_STATE_CONNECTED)
+	{
+		return;
+	}
+
+	pLink->pSocket->CRosaSocketDisConnect();
+
+	pLink->ullRetryAt = CRosaEventLoop::CRosaEventLoopGetTickMSec() + GetBackOff(pLink->uiAttempts++);
+
+	SetState(pLink, ROSA_LINK_STATE_DISCONNECTED, vecEvent);
+}
+
+//------------------------------------------------------------------
+// @Function:	 DrainQueue()
+// @Purpose: CRosaReConnectorͶݶ׻ݵ첽(߳m_csLink, , ɺ¼ѭмһ)
+// @Since: v1.00a
+// @Para: LPS_RECONNECTLINK pLink()
+// @Para: vector<S_LINKSTATEEVENT>& vecEvent(ص״̬仯)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaReConnector::DrainQueue(LPS_RECONNECTLINK pLink, vector<S_LINKSTATEEVENT>& vecEvent)
+{
+	if (pLink->bRemoved || pLink->bSending || pLink->nState != ROSA_LINK_STATE_CONNECTED || pLink->dqQueue.empty())
+	{
+		return;
+	}
+
+	pLink->vecDrain.swap(pLink->dqQueue.front());
+	pLink->dqQueue.pop_front();
+	pLink->uiQueueBytes -= (UINT)pLink->vecDrain.size();
+
+	// CRosaConnector¼ѭ, ɰѭ߳лص
+	WSABUF wsaBuf;
+	wsaBuf.buf = &pLink->vecDrain[0];
+	wsaBuf.len = (ULONG)pLink->vecDrain.size();
+
+	memset(&pLink->DrainOverlapped.Overlapped, 0, sizeof(pLink->DrainOverlapped.Overlapped));
+
+	pLink->bSending = true;
+	pLink->bDraining = true;
+
+	if (WSASend(pLink->pSocket->CRosaSocketGetRawSocket(), &wsaBuf, 1, NULL, 0, &pLink->DrainOverlapped.Overlapped, NULL) == SOCKET_ERROR && WSAGetLastError() != WSA_IO_PENDING)
+	{
+		pLink->bSending = false;
+		pLink->bDraining = false;
+		pLink->vecDrain.clear();
+
+		MarkBroken(pLink, vecEvent);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 Notify()
+// @Purpose: CRosaReConnectorص״̬仯(ɳm_csLink)
+// @Since: v1.00a
+// @Para: vector<S_LINKSTATEEVENT>& vecEvent(ص״̬仯)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaReConnector::Notify(vector<S_LINKSTATEEVENT>& vecEvent)
+{
+	if (m_pCallback == NULL)
+	{
+		return;
+	}
+
+	for (vector<S_LINKSTATEEVENT>::iterator iter = vecEvent.begin(); iter != vecEvent.end(); ++iter)
+	{
+		m_pCallback(iter->ullLinkID, iter->pSocket, iter->nOldState, iter->nNewState, m_dwUser);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnLinkConnect()
+// @Purpose: CRosaReConnectorɻص(¼ѭ߳)
+// @Since: v1.00a
+// @Para: ULONGLONG ullConnectID(ID)
+// @Para: SOCKET s(ӵ׽)
+// @Para: int nResult(SOB_RET_*)
+// @Para: DWORD_PTR dwUser(CRosaReConnector)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaReConnector::OnLinkConnect(ULONGLONG ullConnectID, SOCKET s, int nResult, DWORD_PTR dwUser)
+{
+	CRosaReConnector* pThis = reinterpret_cast<CRosaReConnector*>(dwUser);
+	vector<S_LINKSTATEEVENT> vecEvent;
+
+	EnterCriticalSection(&pThis->m_csLink);
+
+	map<ULONGLONG, ULONGLONG>::iterator iterConnect = pThis->m_mapConnect.find(ullConnectID);
+	map<ULONGLONG, LPS_RECONNECTLINK>::iterator iter = pThis->m_mapLink.end();
+
+	if (iterConnect != pThis->m_mapConnect.end())
+	{
+		iter = pThis->m_mapLink.find(iterConnect->second);
+		pThis->m_mapConnect.erase(iterConnect);
+	}
+
+	if (iter == pThis->m_mapLink.end())
+	{
+		LeaveCriticalSection(&pThis->m_csLink);
+
+		if (s != INVALID_SOCKET)
+		{
+			closesocket(s);
+		}
+		return;
+	}
+
+	LPS_RECONNECTLINK pLink = iter->second;
+	pLink->ullConnectID = 0;
+
+	if (pLink->bRemoved)
+	{
+		if (s != INVALID_SOCKET)
+		{
+			closesocket(s);
+		}
+
+		pLink->nState = ROSA_LINK_STATE_DISCONNECTED;
+	}
+	else if (nResult == SOB_RET_OK && pLink->pSocket->CRosaSocketAttachRawSocket(s, true))
+	{
+		pLink->uiAttempts = 0;
+
+		pThis->SetState(pLink, ROSA_LINK_STATE_CONNECTED, vecEvent);
+
+		// Ͷڼ仺
+		pThis->DrainQueue(pLink, vecEvent);
+	}
+	else
+	{
+		// ʧʱCRosaSocketѾи׽
+		if (nResult == SOB_RET_OK)
+		{
+			pLink->pSocket->CRosaSocketDisConnect();
+		}
+
+		pLink->ullRetryAt = CRosaEventLoop::CRosaEventLoopGetTickMSec() + pThis->GetBackOff(pLink->uiAttempts++);
+
+		pThis->SetState(pLink, ROSA_LINK_STATE_DISCONNECTED, vecEvent);
+	}
+
+	LeaveCriticalSection(&pThis->m_csLink);
+
+	pThis->Notify(vecEvent);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnScanTimer()
+// @Purpose: CRosaReConnector(ڵӿʼ, ͷƳ)
+// @Since: v1.00a
+// @Para: ULONGLONG ullTimerID(ʱID)
+// @Para: void* pUser(CRosaReConnector)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaReConnector::OnScanTimer(ULONGLONG ullTimerID, void * pUser)
+{
+	CRosaReConnector* pThis = reinterpret_cast<CRosaReConnector*>(pUser);
+	ULONGLONG ullNow = CRosaEventLoop::CRosaEventLoopGetTickMSec();
+	vector<S_LINKSTATEEVENT> vecEvent;
+
+	EnterCriticalSection(&pThis->m_csLink);
+
+	map<ULONGLONG, LPS_RECONNECTLINK>::iterator iter = pThis->m_mapLink.begin();
+	while (iter != pThis->m_mapLink.end())
+	{
+		LPS_RECONNECTLINK pLink = iter->second;
+
+		if (pLink->bRemoved)
+		{
+			if (!pLink->bSending && pLink->nState != ROSA_LINK_STATE_CONNECTING)
+			{
+				pLink->pSocket->CRosaSocketDisConnect();
+				delete pLink;
+				iter = pThis->m_mapLink.erase(iter);
+				continue;
+			}
+		}
+		else if (pLink->nState == ROSA_LINK_STATE_DISCONNECTED && pLink->ullRetryAt <= ullNow)
+		{
+			// ɻصConnectAddrִ
+			ULONGLONG ullConnectID = pThis->m_Connector.CRosaConnectorConnectAddr(&pLink->vecAddress[0], (int)pLink->vecAddress.size(), OnLinkConnect, (DWORD_PTR)pThis);
+
+			if (ullConnectID != 0)
+			{
+				pLink->ullConnectID = ullConnectID;
+				pThis->m_mapConnect.insert(pair<ULONGLONG, ULONGLONG>(ullConnectID, pLink->ullLinkID));
+				pThis->SetState(pLink, ROSA_LINK_STATE_CONNECTING, vecEvent);
+			}
+			else
+			{
+				pLink->ullRetryAt = ullNow + pThis->GetBackOff(pLink->uiAttempts++);
+			}
+		}
+
+		++iter;
+	}
+
+	LeaveCriticalSection(&pThis->m_csLink);
+
+	pThis->Notify(vecEvent);
+
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnDrainComplete()
+// @Purpose: CRosaReConnector첽(¼ѭ߳, ɹһ)
+// @Since: v1.00a
+// @Para: LPS_ROSAOVERLAPPED pOverlapped(ӵصṹ)
+// @Para: DWORD dwBytes(͵ֽ)
+// @Para: DWORD dwError()
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaReConnector::OnDrainComplete(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError)
+{
+	LPS_RECONNECTLINK pLink = reinterpret_cast<LPS_RECONNECTLINK>(pOverlapped->pUser);
+	CRosaReConnector* pThis = pLink->pOwner;
+	vector<S_LINKSTATEEVENT> vecEvent;
+
+	EnterCriticalSection(&pThis->m_csLink);
+
+	bool bComplete = (dwError == 0 && dwBytes == (DWORD)pLink->vecDrain.size());
+
+	pLink->bSending = false;
+	pLink->bDraining = false;
+	pLink->vecDrain.clear();
+
+	// ʧܵݿѲַط
+	if (!bComplete)
+	{
+		pThis->MarkBroken(pLink, vecEvent);
+	}
+	else
+	{
+		pThis->DrainQueue(pLink, vecEvent);
+	}
+
+	LeaveCriticalSection(&pThis->m_csLink);
+
+	pThis->Notify(vecEvent);
+}
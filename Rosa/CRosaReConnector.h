@@ -0,0 +1,133 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaReConnector.h
+* @brief	This File is RosaReConnector Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSARECONNECTOR_H__
+#define __CROSARECONNECTOR_H__
+
+//Include Rosa Header File
+#include "CRosaSocket.h"
+#include "CRosaEventLoop.h"
+#include "CRosaConnector.h"
+
+//Include C/C++ Header File
+#include <map>
+#include <deque>
+#include <vector>
+
+using namespace std;
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSARECONNECTOR_API	__declspec(dllexport)
+#else
+#define ROSARECONNECTOR_API	__declspec(dllimport)
+#endif
+
+#define ROSARECONNECTOR_CALLMODE	__stdcall
+
+#define ROSA_RECONNECT_BASE_MSEC		100				//˱ܻ׼ʱ()
+#define ROSA_RECONNECT_MAX_MSEC			30000			//˱()
+#define ROSA_RECONNECT_QUEUE_MAX		(256 * 1024)	//ڼÿ󻺴ֽ
+#define ROSA_RECONNECT_SCAN_MSEC		10				//()
+#define ROSA_RECONNECT_SEND_TIMEOUT		1				//ֱ߳ӷ͵ĳʱ(, ¼ѭ첽)
+
+#define ROSA_LINK_STATE_DISCONNECTED	0				//״̬:ѶϿ(ȴ)
+#define ROSA_LINK_STATE_CONNECTING		1				//״̬:
+#define ROSA_LINK_STATE_CONNECTED		2				//״̬:
+
+//Class Declaration
+class CRosaReConnector;
+
+//Callback Definition
+typedef void(__stdcall *HANDLE_LINK_STATE_CALLBACK)(ULONGLONG ullLinkID, CRosaSocket* pSocket, int nOldState, int nNewState, DWORD_PTR dwUser);	//״̬仯ص
+
+//Struct Definition
+typedef struct
+{
+	ULONGLONG ullLinkID;					// ID
+	CRosaSocket* pSocket;					// ͻ׽(ߴ)
+	vector<SOCKADDR_STORAGE> vecAddress;	// Զ˵ַ(ʱ)
+	int nState;								// ״̬
+	UINT uiAttempts;						// ʧܴ(˱ָ)
+	ULONGLONG ullRetryAt;					// һʱ
+	ULONGLONG ullConnectID;					// еID
+	deque<vector<char>> dqQueue;			// ڼ仺ķ
+	UINT uiQueueBytes;						// ֽ
+	bool bSending;							// Ƿ߳ڷͻͶе첽
+	bool bDraining;							// ǷͶе첽(¼ѭ)
+	bool bRemoved;							// ǷѾƳ
+	vector<char> vecDrain;					// Ͷе첽
+	S_ROSAOVERLAPPED DrainOverlapped;		// 첽صṹ(pUserΪ)
+	CRosaReConnector* pOwner;				// 
+}S_RECONNECTLINK, *LPS_RECONNECTLINK;
+
+typedef struct
+{
+	ULONGLONG ullLinkID;					// ID
+	CRosaSocket* pSocket;					// ͻ׽
+	int nOldState;							// ԭ״̬
+	int nNewState;							// ״̬
+}S_LINKSTATEEVENT, *LPS_LINKSTATEEVENT;
+
+//Class Definition
+class ROSARECONNECTOR_API CRosaReConnector
+{
+public:
+	CRosaReConnector();			// CRosaReConnector 캯
+	~CRosaReConnector();		// CRosaReConnector 
+
+public:
+	bool ROSARECONNECTOR_CALLMODE CRosaReConnectorCreate(CRosaEventLoop* pLoop, HANDLE_LINK_STATE_CALLBACK pCallback, DWORD_PTR dwUser, DWORD dwBaseMSec = ROSA_RECONNECT_BASE_MSEC, DWORD dwMaxMSec = ROSA_RECONNECT_MAX_MSEC, UINT uiQueueMax = ROSA_RECONNECT_QUEUE_MAX);	// CRosaReConnector ¼ѭ
+	void ROSARECONNECTOR_CALLMODE CRosaReConnectorDestroy();							// CRosaReConnector ϿƳȫ
+
+	ULONGLONG ROSARECONNECTOR_CALLMODE CRosaReConnectorAdd(CRosaSocket* pSocket, const char* pcHost, USHORT sPort);	// CRosaReConnector ӿͻ(ʼ)
+	bool ROSARECONNECTOR_CALLMODE CRosaReConnectorRemove(ULONGLONG ullLinkID);			// CRosaReConnector Ƴͻ(ϿͷCRosaSocket)
+
+	int ROSARECONNECTOR_CALLMODE CRosaReConnectorSend(ULONGLONG ullLinkID, const char* pSendBuffer, UINT uiBufferSize);	// CRosaReConnector (ڼ仺)
+	void ROSARECONNECTOR_CALLMODE CRosaReConnectorReportBroken(ULONGLONG ullLinkID);	// CRosaReConnector ӶϿ(շSOB_RET_CLOSEʱ)
+
+	int ROSARECONNECTOR_CALLMODE CRosaReConnectorGetState(ULONGLONG ullLinkID);		// CRosaReConnector ȡ״̬
+	int ROSARECONNECTOR_CALLMODE CRosaReConnectorGetLinkCount();						// CRosaReConnector ȡ
+
+private:
+	DWORD GetBackOff(UINT uiAttempts);													// CRosaReConnector ˱ʱ()
+	void SetState(LPS_RECONNECTLINK pLink, int nState, vector<S_LINKSTATEEVENT>& vecEvent);		// CRosaReConnector л״̬
+	void MarkBroken(LPS_RECONNECTLINK pLink, vector<S_LINKSTATEEVENT>& vecEvent);					// CRosaReConnector ϿӲ
+	void DrainQueue(LPS_RECONNECTLINK pLink, vector<S_LINKSTATEEVENT>& vecEvent);					// CRosaReConnector Ͷݻݵ첽
+	void Notify(vector<S_LINKSTATEEVENT>& vecEvent);									// CRosaReConnector ص״̬仯
+
+	static void __stdcall OnLinkConnect(ULONGLONG ullConnectID, SOCKET s, int nResult, DWORD_PTR dwUser);	// CRosaReConnector ɻص
+	static void __stdcall OnScanTimer(ULONGLONG ullTimerID, void* pUser);									// CRosaReConnector 鶨ʱ
+	static void __stdcall OnDrainComplete(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError);	// CRosaReConnector 첽
+
+private:
+	CRosaEventLoop* m_pLoop;								// CRosaReConnector ¼ѭ
+	CRosaConnector m_Connector;								// CRosaReConnector 첽
+	ULONGLONG m_ullScanTimerID;								// CRosaReConnector 鶨ʱ
+
+	HANDLE_LINK_STATE_CALLBACK m_pCallback;					// CRosaReConnector ״̬仯ص
+	DWORD_PTR m_dwUser;										// CRosaReConnector û
+
+	DWORD m_dwBaseMSec;										// CRosaReConnector ˱ܻ׼ʱ
+	DWORD m_dwMaxMSec;										// CRosaReConnector ˱
+	UINT m_uiQueueMax;										// CRosaReConnector ÿ󻺴ֽ
+
+	CRITICAL_SECTION m_csLink;								// CRosaReConnector ٽ
+	map<ULONGLONG, LPS_RECONNECTLINK> m_mapLink;			// CRosaReConnector 
+	map<ULONGLONG, ULONGLONG> m_mapConnect;					// CRosaReConnector ID->ID
+	ULONGLONG m_ullNextLinkID;								// CRosaReConnector һID
+	ULONGLONG m_ullRandom;									// CRosaReConnector ״̬(xorshift)
+
+};
+
+#endif // !__CROSARECONNECTOR_H__
@@ -0,0 +1,707 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaResolver.cpp
+* @brief	This File is RosaResolver Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaResolver.h"
+#include "CThreadSafe.h"
+
+#include <process.h>
+#include <ctype.h>
+
+#pragma warning(disable:4996)
+
+//CRosaResolver (TTLʧܻ桢ͬϲ̨)
+
+//------------------------------------------------------------------
+// @Function:	 CRosaResolver()
+// @Purpose: CRosaResolver캯(δʱΪ޽̵߳ͬʹ)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaResolver::CRosaResolver()
+{
+	memset(m_hThreads, 0, sizeof(m_hThreads));
+	m_nThreads = 0;
+	m_bRunning = false;
+
+	m_dwTTL = ROSA_RESOLVE_TTL;
+	m_dwNegativeTTL = ROSA_RESOLVE_NEGATIVE_TTL;
+	m_uiMaxEntries = ROSA_RESOLVE_MAX_ENTRIES;
+
+	InitializeCriticalSection(&m_csResolve);
+	InitializeConditionVariable(&m_cvQueue);
+	InitializeConditionVariable(&m_cvDone);
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaResolver()
+// @Purpose: CRosaResolver
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaResolver::~CRosaResolver()
+{
+	CRosaResolverDestroy();
+
+	DeleteCriticalSection(&m_csResolve);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaResolverCreate()
+// @Purpose: CRosaResolverû߳
+// @Since: v1.00a
+// @Para: USHORT nThreads(߳, 0ʾͬ)
+// @Para: DWORD dwTTL(ɹʱ, )
+// @Para: DWORD dwNegativeTTL(ʧܻʱ, )
+// @Para: UINT uiMaxEntries(󻺴Ŀ)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSARESOLVER_CALLMODE CRosaResolver::CRosaResolverCreate(USHORT nThreads, DWORD dwTTL, DWORD dwNegativeTTL, UINT uiMaxEntries)
+{
+	if (m_bRunning || nThreads > ROSA_RESOLVE_MAX_THREADS || uiMaxEntries == 0)
+	{
+		return false;
+	}
+
+	EnterCriticalSection(&m_csResolve);
+
+	m_dwTTL = dwTTL;
+	m_dwNegativeTTL = dwNegativeTTL;
+	m_uiMaxEntries = uiMaxEntries;
+	m_bRunning = true;
+
+	LeaveCriticalSection(&m_csResolve);
+
+	for (m_nThreads = 0; m_nThreads < nThreads; ++m_nThreads)
+	{
+		m_hThreads[m_nThreads] = (HANDLE)_beginthreadex(NULL, 0, OnResolveThread, this, 0, NULL);
+		if (m_hThreads[m_nThreads] == NULL)
+		{
+			CRosaResolverDestroy();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaResolverDestroy()
+// @Purpose: CRosaResolverֹͣ߳(ȴеĻصWSAECANCELLED, 汣)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSARESOLVER_CALLMODE CRosaResolver::CRosaResolverDestroy()
+{
+	vector<pair<string, S_RESOLVEWAITER>> vecCancel;
+
+	EnterCriticalSection(&m_csResolve);
+
+	if (!m_bRunning)
+	{
+		LeaveCriticalSection(&m_csResolve);
+		return;
+	}
+
+	m_bRunning = false;
+	m_dqQueue.clear();
+
+	// ȡδɵĽ
+	for (map<string, S_RESOLVEENTRY>::iterator iter = m_mapEntry.begin(); iter != m_mapEntry.end(); ++iter)
+	{
+		if (iter->second.bPending)
+		{
+			for (vector<S_RESOLVEWAITER>::iterator it = iter->second.vecWaiter.begin(); it != iter->second.vecWaiter.end(); ++it)
+			{
+				vecCancel.push_back(pair<string, S_RESOLVEWAITER>(iter->first, *it));
+			}
+
+			iter->second.vecWaiter.clear();
+			iter->second.bPending = false;
+		}
+	}
+
+	WakeAllConditionVariable(&m_cvQueue);
+	WakeAllConditionVariable(&m_cvDone);
+
+	LeaveCriticalSection(&m_csResolve);
+
+	for (USHORT i = 0; i < m_nThreads; ++i)
+	{
+		WaitForSingleObject(m_hThreads[i], INFINITE);
+		CloseHandle(m_hThreads[i]);
+		m_hThreads[i] = NULL;
+	}
+
+	m_nThreads = 0;
+
+	for (vector<pair<string, S_RESOLVEWAITER>>::iterator iter = vecCancel.begin(); iter != vecCancel.end(); ++iter)
+	{
+		iter->second.pCallback(iter->first.c_str(), NULL, 0, WSAECANCELLED, iter->second.dwUser);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaResolverLookup()
+// @Purpose: CRosaResolverѯ(ֱӷ, ڵĳɹȷٺ̨ˢ, δ̨)
+// @Since: v1.00a
+// @Para: const char* pcHost(IPַ)
+// @Para: vector<SOCKADDR_STORAGE>& vecAddress(ʱĵַб, ˿Ϊ0)
+// @Para: HANDLE_RESOLVE_CALLBACK pCallback(δʱɻص, ڽִ߳, ΪNULL)
+// @Para: DWORD_PTR dwUser(û)
+// @Return: int nRet (SOB_RET_OK:, SOB_RET_FAIL:ʧѻ޽߳, ROSA_RESOLVE_PENDING:)
+//------------------------------------------------------------------
+int ROSARESOLVER_CALLMODE CRosaResolver::CRosaResolverLookup(const char * pcHost, vector<SOCKADDR_STORAGE>& vecAddress, HANDLE_RESOLVE_CALLBACK pCallback, DWORD_PTR dwUser)
+{
+	SOCKADDR_STORAGE addrLiteral;
+
+	vecAddress.clear();
+
+	if (pcHost == NULL || *pcHost == '\0')
+	{
+		return SOB_RET_FAIL;
+	}
+
+	// IPַѯ
+	if (CRosaResolverParseLiteral(pcHost, addrLiteral))
+	{
+		vecAddress.push_back(addrLiteral);
+		return SOB_RET_OK;
+	}
+
+	string strKey = MakeKey(pcHost);
+	ULONGLONG ullNow = GetTickCount64();
+	bool bAsync = (m_nThreads > 0);
+
+	CThreadSafe ThreadSafe(&m_csResolve);
+
+	map<string, S_RESOLVEENTRY>::iterator iter = m_mapEntry.find(strKey);
+
+	if (iter != m_mapEntry.end() && iter->second.bResolved)
+	{
+		S_RESOLVEENTRY& sEntry = iter->second;
+
+		// δ, ڵɹ(ȷؾɽ)
+		if (ullNow < sEntry.ullExpire || (sEntry.nError == 0 && bAsync && m_bRunning))
+		{
+			if (ullNow >= sEntry.ullExpire && !sEntry.bPending)
+			{
+				sEntry.bPending = true;
+				m_dqQueue.push_back(strKey);
+				WakeConditionVariable(&m_cvQueue);
+			}
+
+			if (sEntry.nError == 0)
+			{
+				vecAddress = sEntry.vecAddress;
+				return SOB_RET_OK;
+			}
+
+			WSASetLastError(sEntry.nError);
+			return SOB_RET_FAIL;
+		}
+	}
+
+	// ޽߳ʱѯ
+	if (!bAsync || !m_bRunning)
+	{
+		WSASetLastError(WSAHOST_NOT_FOUND);
+		return SOB_RET_FAIL;
+	}
+
+	S_RESOLVEENTRY& sEntry = m_mapEntry[strKey];
+
+	if (pCallback != NULL)
+	{
+		S_RESOLVEWAITER sWaiter;
+		sWaiter.pCallback = pCallback;
+		sWaiter.dwUser = dwUser;
+		sEntry.vecWaiter.push_back(sWaiter);
+	}
+
+	// ֻͬһ
+	if (!sEntry.bPending)
+	{
+		sEntry.bPending = true;
+		m_dqQueue.push_back(strKey);
+		WakeConditionVariable(&m_cvQueue);
+
+		TrimEntries(ullNow);
+	}
+
+	return ROSA_RESOLVE_PENDING;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaResolverResolve()
+// @Purpose: CRosaResolverͬ(ͬȴͬһν, ޽߳ʱ׸߽)
+// @Since: v1.00a
+// @Para: const char* pcHost(IPַ)
+// @Para: vector<SOCKADDR_STORAGE>& vecAddress(ַб, ˿Ϊ0)
+// @Para: DWORD dwTimeOutMSec(ȴʱ)
+// @Return: int nRet (SOB_RET_OK:ɹ, SOB_RET_FAIL:ʧ, SOB_RET_TIMEOUT:ȴʱ)
+//------------------------------------------------------------------
+int ROSARESOLVER_CALLMODE CRosaResolver::CRosaResolverResolve(const char * pcHost, vector<SOCKADDR_STORAGE>& vecAddress, DWORD dwTimeOutMSec)
+{
+	SOCKADDR_STORAGE addrLiteral;
+
+	vecAddress.clear();
+
+	if (pcHost == NULL || *pcHost == '\0')
+	{
+		return SOB_RET_FAIL;
+	}
+
+	if (CRosaResolverParseLiteral(pcHost, addrLiteral))
+	{
+		vecAddress.push_back(addrLiteral);
+		return SOB_RET_OK;
+	}
+
+	string strKey = MakeKey(pcHost);
+	ULONGLONG ullDeadline = GetTickCount64() + dwTimeOutMSec;
+	bool bWaited = false;
+
+	EnterCriticalSection(&m_csResolve);
+
+	for (;;)
+	{
+		ULONGLONG ullNow = GetTickCount64();
+		bool bAsync = (m_nThreads > 0 && m_bRunning);
+
+		map<string, S_RESOLVEENTRY>::iterator iter = m_mapEntry.find(strKey);
+
+		if (iter != m_mapEntry.end())
+		{
+			S_RESOLVEENTRY& sEntry = iter->second;
+
+			// δڡյȵĽڵɹ(ȷؾɽ)
+			if (sEntry.bResolved && !(sEntry.bPending && bWaited) && (ullNow < sEntry.ullExpire || bWaited || (sEntry.nError == 0 && bAsync)))
+			{
+				if (ullNow >= sEntry.ullExpire && !sEntry.bPending && bAsync)
+				{
+					sEntry.bPending = true;
+					m_dqQueue.push_back(strKey);
+					WakeConditionVariable(&m_cvQueue);
+				}
+
+				int nError = sEntry.nError;
+
+				if (nError == 0)
+				{
+					vecAddress = sEntry.vecAddress;
+				}
+
+				LeaveCriticalSection(&m_csResolve);
+
+				if (nError != 0)
+				{
+					WSASetLastError(nError);
+					return SOB_RET_FAIL;
+				}
+
+				return SOB_RET_OK;
+			}
+
+			// ȴͬĽ
+			if (sEntry.bPending)
+			{
+				if (ullNow >= ullDeadline)
+				{
+					LeaveCriticalSection(&m_csResolve);
+					return SOB_RET_TIMEOUT;
+				}
+
+				SleepConditionVariableCS(&m_cvDone, &m_csResolve, (DWORD)(ullDeadline - ullNow));
+				bWaited = true;
+				continue;
+			}
+		}
+
+		S_RESOLVEENTRY& sEntry = m_mapEntry[strKey];
+		sEntry.bPending = true;
+
+		if (bAsync)
+		{
+			m_dqQueue.push_back(strKey);
+			WakeConditionVariable(&m_cvQueue);
+			TrimEntries(ullNow);
+			continue;
+		}
+
+		// ޽߳: ɵǰ߳̽
+		LeaveCriticalSection(&m_csResolve);
+
+		vector<SOCKADDR_STORAGE> vecResult;
+		vector<S_RESOLVEWAITER> vecWaiter;
+		int nError = QueryAddress(strKey, vecResult);
+
+		EnterCriticalSection(&m_csResolve);
+
+		CompleteEntry(strKey, nError, vecResult, vecWaiter);
+		TrimEntries(GetTickCount64());
+
+		LeaveCriticalSection(&m_csResolve);
+
+		for (vector<S_RESOLVEWAITER>::iterator it = vecWaiter.begin(); it != vecWaiter.end(); ++it)
+		{
+			it->pCallback(strKey.c_str(), vecResult.empty() ? NULL : &vecResult[0], (int)vecResult.size(), nError, it->dwUser);
+		}
+
+		if (nError != 0)
+		{
+			WSASetLastError(nError);
+			return SOB_RET_FAIL;
+		}
+
+		vecAddress.swap(vecResult);
+		return SOB_RET_OK;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaResolverFlush()
+// @Purpose: CRosaResolverջ(ڽĿ)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSARESOLVER_CALLMODE CRosaResolver::CRosaResolverFlush()
+{
+	CThreadSafe ThreadSafe(&m_csResolve);
+
+	map<string, S_RESOLVEENTRY>::iterator iter = m_mapEntry.begin();
+	while (iter != m_mapEntry.end())
+	{
+		if (iter->second.bPending)
+		{
+			++iter;
+		}
+		else
+		{
+			iter = m_mapEntry.erase(iter);
+		}
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaResolverGetEntryCount()
+// @Purpose: CRosaResolverȡĿ
+// @Since: v1.00a
+// @Para: None
+// @Return: int nCount
+//------------------------------------------------------------------
+int ROSARESOLVER_CALLMODE CRosaResolver::CRosaResolverGetEntryCount()
+{
+	CThreadSafe ThreadSafe(&m_csResolve);
+	return (int)m_mapEntry.size();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaResolverGetThreadCount()
+// @Purpose: CRosaResolverȡ߳
+// @Since: v1.00a
+// @Para: None
+// @Return: USHORT nThreads (0:ͬ)
+//------------------------------------------------------------------
+USHORT ROSARESOLVER_CALLMODE CRosaResolver::CRosaResolverGetThreadCount() const
+{
+	return m_bRunning ? m_nThreads : 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaResolverGetDefault()
+// @Purpose: CRosaResolverȡĬϽ(״ʹʱ߳, ֻͬȴڵ̲߳ѯDNS)
+// @Since: v1.00a
+// @Para: None
+// @Return: CRosaResolver& Resolver
+//------------------------------------------------------------------
+CRosaResolver & ROSARESOLVER_CALLMODE CRosaResolver::CRosaResolverGetDefault()
+{
+	static CRosaResolver* s_pResolver = CreateDefault();
+	return *s_pResolver;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaResolverSetPort()
+// @Purpose: CRosaResolverõַб˿ں
+// @Since: v1.00a
+// @Para: vector<SOCKADDR_STORAGE>& vecAddress(ַб)
+// @Para: USHORT sPort(˿ں)
+// @Return: None
+//------------------------------------------------------------------
+void ROSARESOLVER_CALLMODE CRosaResolver::CRosaResolverSetPort(vector<SOCKADDR_STORAGE>& vecAddress, USHORT sPort)
+{
+	for (vector<SOCKADDR_STORAGE>::iterator iter = vecAddress.begin(); iter != vecAddress.end(); ++iter)
+	{
+		if (iter->ss_family == AF_INET6)
+		{
+			((SOCKADDR_IN6*)&(*iter))->sin6_port = htons(sPort);
+		}
+		else
+		{
+			((SOCKADDR_IN*)&(*iter))->sin_port = htons(sPort);
+		}
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaResolverParseLiteral()
+// @Purpose: CRosaResolverIPַ(IPv4IPv6, ѯDNS)
+// @Since: v1.00a
+// @Para: const char* pcHost(IPַ)
+// @Para: SOCKADDR_STORAGE& addr(ַ, ˿Ϊ0)
+// @Return: bool bRet (true:IPַ, false:)
+//------------------------------------------------------------------
+bool ROSARESOLVER_CALLMODE CRosaResolver::CRosaResolverParseLiteral(const char * pcHost, SOCKADDR_STORAGE & addr)
+{
+	memset(&addr, 0, sizeof(addr));
+
+	SOCKADDR_IN* pAddr4 = (SOCKADDR_IN*)&addr;
+	if (InetPtonA(AF_INET, pcHost, &pAddr4->sin_addr) == 1)
+	{
+		pAddr4->sin_family = AF_INET;
+		return true;
+	}
+
+	SOCKADDR_IN6* pAddr6 = (SOCKADDR_IN6*)&addr;
+	if (InetPtonA(AF_INET6, pcHost, &pAddr6->sin6_addr) == 1)
+	{
+		pAddr6->sin6_family = AF_INET6;
+		return true;
+	}
+
+	return false;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnResolveThread()
+// @Purpose: CRosaResolver߳
+// @Since: v1.00a
+// @Para: void* pParam(CRosaResolver)
+// @Return: unsigned
+//------------------------------------------------------------------
+unsigned __stdcall CRosaResolver::OnResolveThread(void * pParam)
+{
+	CRosaResolver* pThis = reinterpret_cast<CRosaResolver*>(pParam);
+
+	EnterCriticalSection(&pThis->m_csResolve);
+
+	for (;;)
+	{
+		while (pThis->m_bRunning && pThis->m_dqQueue.empty())
+		{
+			SleepConditionVariableCS(&pThis->m_cvQueue, &pThis->m_csResolve, INFINITE);
+		}
+
+		if (!pThis->m_bRunning)
+		{
+			break;
+		}
+
+		string strKey = pThis->m_dqQueue.front();
+		pThis->m_dqQueue.pop_front();
+
+		LeaveCriticalSection(&pThis->m_csResolve);
+
+		vector<SOCKADDR_STORAGE> vecResult;
+		vector<S_RESOLVEWAITER> vecWaiter;
+		int nError = QueryAddress(strKey, vecResult);
+
+		EnterCriticalSection(&pThis->m_csResolve);
+
+		// ڼѱȡ
+		if (!pThis->m_bRunning)
+		{
+			break;
+		}
+
+		pThis->CompleteEntry(strKey, nError, vecResult, vecWaiter);
+
+		LeaveCriticalSection(&pThis->m_csResolve);
+
+		for (vector<S_RESOLVEWAITER>::iterator iter = vecWaiter.begin(); iter != vecWaiter.end(); ++iter)
+		{
+			iter->pCallback(strKey.c_str(), vecResult.empty() ? NULL : &vecResult[0], (int)vecResult.size(), nError, iter->dwUser);
+		}
+
+		EnterCriticalSection(&pThis->m_csResolve);
+	}
+
+	LeaveCriticalSection(&pThis->m_csResolve);
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CreateDefault()
+// @Purpose: CRosaResolverĬϽ(ģ鱻̶, DLLжʱ̲߳ʧȥ)
+// @Since: v1.00a
+// @Para: None
+// @Return: CRosaResolver* pResolver
+//------------------------------------------------------------------
+CRosaResolver * CRosaResolver::CreateDefault()
+{
+	CRosaResolver* pResolver = new CRosaResolver;
+	HMODULE hModule = NULL;
+
+	// ̶ʧʱ߳, ˻ͬ
+	if (GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_PIN, (LPCSTR)OnResolveThread, &hModule))
+	{
+		pResolver->CRosaResolverCreate(ROSA_RESOLVE_DEFAULT_THREADS);
+	}
+
+	return pResolver;
+}
+
+//------------------------------------------------------------------
+// @Function:	 QueryAddress()
+// @Purpose: CRosaResolvergetaddrinfoȫַ(IPv4IPv6)
+// @Since: v1.00a
+// @Para: const string& strHost()
+// @Para: vector<SOCKADDR_STORAGE>& vecAddress(ַб, ˿Ϊ0)
+// @Return: int nError (0:ɹ)
+//------------------------------------------------------------------
+int CRosaResolver::QueryAddress(const string & strHost, vector<SOCKADDR_STORAGE>& vecAddress)
+{
+	addrinfo adiHints, *padiResult = NULL;
+
+	memset(&adiHints, 0, sizeof(addrinfo));
+
+	adiHints.ai_family = AF_UNSPEC;
+	adiHints.ai_socktype = SOCK_STREAM;
+	adiHints.ai_protocol = IPPROTO_TCP;
+
+	int nRet = ::getaddrinfo(strHost.c_str(), NULL, &adiHints, &padiResult);
+	if (nRet != 0)
+	{
+		return nRet;
+	}
+
+	for (addrinfo* padi = padiResult; padi != NULL; padi = padi->ai_next)
+	{
+		if ((padi->ai_family == AF_INET || padi->ai_family == AF_INET6) && padi->ai_addrlen <= sizeof(SOCKADDR_STORAGE))
+		{
+			SOCKADDR_STORAGE addr;
+			memset(&addr, 0, sizeof(addr));
+			memcpy(&addr, padi->ai_addr, padi->ai_addrlen);
+			vecAddress.push_back(addr);
+		}
+	}
+
+	freeaddrinfo(padiResult);
+
+	return vecAddress.empty() ? WSAHOST_NOT_FOUND : 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CompleteEntry()
+// @Purpose: CRosaResolverдѵȴ(ˢʧʱʹþɵĳɹ)
+// @Since: v1.00a
+// @Para: const string& strHost()
+// @Para: int& nError(, ս)
+// @Para: vector<SOCKADDR_STORAGE>& vecAddress(, ս)
+// @Para: vector<S_RESOLVEWAITER>& vecWaiter(ȡĻص)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaResolver::CompleteEntry(const string & strHost, int & nError, vector<SOCKADDR_STORAGE>& vecAddress, vector<S_RESOLVEWAITER>& vecWaiter)
+{
+	S_RESOLVEENTRY& sEntry = m_mapEntry[strHost];
+	ULONGLONG ullNow = GetTickCount64();
+
+	if (nError == 0)
+	{
+		sEntry.vecAddress = vecAddress;
+		sEntry.nError = 0;
+		sEntry.ullExpire = ullNow + m_dwTTL;
+	}
+	else if (sEntry.bResolved && sEntry.nError == 0)
+	{
+		// ˢʧ, ɽʹһʧܻ
+		vecAddress = sEntry.vecAddress;
+		nError = 0;
+		sEntry.ullExpire = ullNow + m_dwNegativeTTL;
+	}
+	else
+	{
+		sEntry.vecAddress.clear();
+		sEntry.nError = nError;
+		sEntry.ullExpire = ullNow + m_dwNegativeTTL;
+	}
+
+	sEntry.bResolved = true;
+	sEntry.bPending = false;
+	vecWaiter.swap(sEntry.vecWaiter);
+
+	WakeAllConditionVariable(&m_cvDone);
+}
+
+//------------------------------------------------------------------
+// @Function:	 TrimEntries()
+// @Purpose: CRosaResolver泬ʱ̭Ŀ, Գ̭Ŀ
+// @Since: v1.00a
+// @Para: ULONGLONG ullNow(ǰʱ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaResolver::TrimEntries(ULONGLONG ullNow)
+{
+	if (m_mapEntry.size() <= m_uiMaxEntries)
+	{
+		return;
+	}
+
+	map<string, S_RESOLVEENTRY>::iterator iter = m_mapEntry.begin();
+	while (iter != m_mapEntry.end() && m_mapEntry.size() > m_uiMaxEntries)
+	{
+		if (!iter->second.bPending && iter->second.ullExpire <= ullNow)
+		{
+			iter = m_mapEntry.erase(iter);
+		}
+		else
+		{
+			++iter;
+		}
+	}
+
+	iter = m_mapEntry.begin();
+	while (iter != m_mapEntry.end() && m_mapEntry.size() > m_uiMaxEntries)
+	{
+		if (!iter->second.bPending)
+		{
+			iter = m_mapEntry.erase(iter);
+		}
+		else
+		{
+			++iter;
+		}
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 MakeKey()
+// @Purpose: CRosaResolverɻ(ִСд)
+// @Since: v1.00a
+// @Para: const char* pcHost()
+// @Return: string strKey
+//------------------------------------------------------------------
+string CRosaResolver::MakeKey(const char * pcHost)
+{
+	string strKey(pcHost);
+
+	for (string::iterator iter = strKey.begin(); iter != strKey.end(); ++iter)
+	{
+		*iter = (char)tolower((unsigned char)*iter);
+	}
+
+	return strKey;
+}
@@ -0,0 +1,117 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaResolver.h
+* @brief	This File is RosaResolver Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSARESOLVER_H__
+#define __CROSARESOLVER_H__
+
+//Include Rosa Header File
+#include "CRosaSocket.h"
+
+//Include Windows Header File
+#include <Ws2tcpip.h>
+
+//Include C/C++ Header File
+#include <map>
+#include <deque>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSARESOLVER_API	__declspec(dllexport)
+#else
+#define ROSARESOLVER_API	__declspec(dllimport)
+#endif
+
+#define ROSARESOLVER_CALLMODE	__stdcall
+
+#define ROSA_RESOLVE_MAX_THREADS		16				//߳
+#define ROSA_RESOLVE_TTL				60000			//ɹʱ()
+#define ROSA_RESOLVE_NEGATIVE_TTL		5000			//ʧܻʱ()
+#define ROSA_RESOLVE_MAX_ENTRIES		4096			//󻺴Ŀ
+#define ROSA_RESOLVE_TIMEOUT			5000			//ͬĬϵȴʱ()
+#define ROSA_RESOLVE_DEFAULT_THREADS	1				//ĬϽĽ߳
+
+#define ROSA_RESOLVE_PENDING			2				//(ɺص)
+
+//Callback Definition
+typedef void(__stdcall *HANDLE_RESOLVE_CALLBACK)(const char* pcHost, const SOCKADDR_STORAGE* pAddress, int nCount, int nError, DWORD_PTR dwUser);	//ɻص(ַ˿Ϊ0, nErrorΪ0ʾɹ)
+
+//Struct Definition
+typedef struct
+{
+	HANDLE_RESOLVE_CALLBACK pCallback;		// ɻص
+	DWORD_PTR dwUser;						// û
+}S_RESOLVEWAITER, *LPS_RESOLVEWAITER;
+
+typedef struct
+{
+	vector<SOCKADDR_STORAGE> vecAddress;	// (IPv4IPv6, ˿Ϊ0)
+	int nError;								// (0:ɹ)
+	ULONGLONG ullExpire;					// ʱ
+	bool bResolved;							// Ƿн
+	bool bPending;							// Ƿڽ(ͬϲ)
+	vector<S_RESOLVEWAITER> vecWaiter;		// ȴĻص
+}S_RESOLVEENTRY, *LPS_RESOLVEENTRY;
+
+//Class Definition
+class ROSARESOLVER_API CRosaResolver
+{
+public:
+	CRosaResolver();			// CRosaResolver 캯
+	~CRosaResolver();			// CRosaResolver 
+
+public:
+	bool ROSARESOLVER_CALLMODE CRosaResolverCreate(USHORT nThreads = 1, DWORD dwTTL = ROSA_RESOLVE_TTL, DWORD dwNegativeTTL = ROSA_RESOLVE_NEGATIVE_TTL, UINT uiMaxEntries = ROSA_RESOLVE_MAX_ENTRIES);		// CRosaResolver ߳
+	void ROSARESOLVER_CALLMODE CRosaResolverDestroy();											// CRosaResolver ֹͣ߳(ȴеĻصWSAECANCELLED)
+
+	int ROSARESOLVER_CALLMODE CRosaResolverLookup(const char* pcHost, vector<SOCKADDR_STORAGE>& vecAddress, HANDLE_RESOLVE_CALLBACK pCallback = NULL, DWORD_PTR dwUser = 0);	// CRosaResolver ѯ(δʱ̨)
+	int ROSARESOLVER_CALLMODE CRosaResolverResolve(const char* pcHost, vector<SOCKADDR_STORAGE>& vecAddress, DWORD dwTimeOutMSec = ROSA_RESOLVE_TIMEOUT);							// CRosaResolver ͬ(ȴͬĽ)
+
+	void ROSARESOLVER_CALLMODE CRosaResolverFlush();											// CRosaResolver ջ
+	int ROSARESOLVER_CALLMODE CRosaResolverGetEntryCount();										// CRosaResolver ȡĿ
+	USHORT ROSARESOLVER_CALLMODE CRosaResolverGetThreadCount() const;							// CRosaResolver ȡ߳(0ʾͬ)
+
+	static CRosaResolver& ROSARESOLVER_CALLMODE CRosaResolverGetDefault();						// CRosaResolver ȡĬϽ(״ʹʱ߳)
+	static void ROSARESOLVER_CALLMODE CRosaResolverSetPort(vector<SOCKADDR_STORAGE>& vecAddress, USHORT sPort);	// CRosaResolver õַб˿ں
+	static bool ROSARESOLVER_CALLMODE CRosaResolverParseLiteral(const char* pcHost, SOCKADDR_STORAGE& addr);		// CRosaResolver IPַ(ѯDNS)
+
+private:
+	static unsigned __stdcall OnResolveThread(void* pParam);					// CRosaResolver ߳
+	static CRosaResolver* CreateDefault();										// CRosaResolver ĬϽ
+	static int QueryAddress(const string& strHost, vector<SOCKADDR_STORAGE>& vecAddress);	// CRosaResolver getaddrinfo
+
+	void CompleteEntry(const string& strHost, int& nError, vector<SOCKADDR_STORAGE>& vecAddress, vector<S_RESOLVEWAITER>& vecWaiter);	// CRosaResolver дȡս(߳m_csResolve)
+	void TrimEntries(ULONGLONG ullNow);											// CRosaResolver ̭ڻ(߳m_csResolve)
+	static string MakeKey(const char* pcHost);									// CRosaResolver ɻ(Сд)
+
+private:
+	HANDLE m_hThreads[ROSA_RESOLVE_MAX_THREADS];	// CRosaResolver ߳
+	USHORT m_nThreads;								// CRosaResolver ߳
+	volatile bool m_bRunning;						// CRosaResolver б־
+
+	DWORD m_dwTTL;									// CRosaResolver ɹʱ
+	DWORD m_dwNegativeTTL;							// CRosaResolver ʧܻʱ
+	UINT m_uiMaxEntries;							// CRosaResolver 󻺴Ŀ
+
+	CRITICAL_SECTION m_csResolve;					// CRosaResolver ٽ
+	CONDITION_VARIABLE m_cvQueue;					// CRosaResolver 
+	CONDITION_VARIABLE m_cvDone;					// CRosaResolver 
+	map<string, S_RESOLVEENTRY> m_mapEntry;			// CRosaResolver (->)
+	deque<string> m_dqQueue;						// CRosaResolver 
+
+};
+
+#endif // !__CROSARESOLVER_H__
@@ -0,0 +1,827 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaRpc.cpp
+* @brief	This File is RosaRpc Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaRpc.h"
+#include "CThreadSafe.h"
+
+//CRosaRpc ˮRPC˵(һԵIDδɵ, Ӧ, ˫Է)
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRpc()
+// @Purpose: CRosaRpc캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaRpc::CRosaRpc()
+{
+	m_Socket = INVALID_SOCKET;
+	m_pLoop = NULL;
+
+	m_pRequestCallback = NULL;
+	m_pCloseCallback = NULL;
+	m_dwUser = 0;
+
+	m_ullNextCallID = ROSA_RPC_CALL_NIL;
+	m_bBroken = false;
+
+	m_uiRecvLength = 0;
+	m_bRecving = false;
+	m_bClosing = false;
+	m_lBroken = 0;
+	m_lOutstanding = 0;
+	memset(&m_RecvOverlapped, 0, sizeof(m_RecvOverlapped));
+
+	InitializeCriticalSection(&m_csCall);
+	InitializeCriticalSection(&m_csRecv);
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaRpc()
+// @Purpose: CRosaRpc
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaRpc::~CRosaRpc()
+{
+	CRosaRpcDestroy();
+
+	DeleteCriticalSection(&m_csRecv);
+	DeleteCriticalSection(&m_csCall);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRpcCreate()
+// @Purpose: CRosaRpcӲʼ
+// @Since: v1.00a
+// @Para: SOCKET s(ӵص׽, )
+// @Para: CRosaEventLoop* pLoop(Ѿ¼ѭ, صִ߳)
+// @Para: HANDLE_RPC_REQUEST_CALLBACK pRequestCallback(ص, NULLʱԶһɻظNOMETHOD)
+// @Para: HANDLE_RPC_CLOSE_CALLBACK pCloseCallback(ӶϿص, ΪNULL)
+// @Para: DWORD_PTR dwUser(û)
+// @Para: UINT uiMaxBytes(Ͷڴ)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSARPC_CALLMODE CRosaRpc::CRosaRpcCreate(SOCKET s, CRosaEventLoop * pLoop, HANDLE_RPC_REQUEST_CALLBACK pRequestCallback, HANDLE_RPC_CLOSE_CALLBACK pCloseCallback, DWORD_PTR dwUser, UINT uiMaxBytes)
+{
+	if (m_Socket != INVALID_SOCKET || s == INVALID_SOCKET || pLoop == NULL)
+	{
+		return false;
+	}
+
+	// Ͷֻڴ, Ҫˮλص
+	if (!m_SendQueue.CRosaSendQueueCreate(s, pLoop, NULL, OnSendClose, (DWORD_PTR)this, uiMaxBytes, uiMaxBytes / 4, uiMaxBytes))
+	{
+		return false;
+	}
+
+	m_pRequestCallback = pRequestCallback;
+	m_pCloseCallback = pCloseCallback;
+	m_dwUser = dwUser;
+
+	m_bBroken = false;
+	m_lBroken = 0;
+	m_bClosing = false;
+	m_lOutstanding = 0;
+
+	m_vecRecv.resize(ROSA_RPC_RECV_BUFFER);
+	m_uiRecvLength = 0;
+
+	m_RecvOverlapped.pCallback = OnRecvComplete;
+	m_RecvOverlapped.pUser = this;
+
+	m_Socket = s;
+	m_pLoop = pLoop;
+
+	CThreadSafe ThreadSafe(&m_csRecv);
+
+	if (!PostRecv())
+	{
+		m_SendQueue.CRosaSendQueueDestroy();
+		m_Socket = INVALID_SOCKET;
+		m_pLoop = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRpcDestroy()
+// @Purpose: CRosaRpcֹͣղͶ, δɵڵǰ̻߳صCLOSED(ر׽, ڱ˵Ļصе)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSARPC_CALLMODE CRosaRpc::CRosaRpcDestroy()
+{
+	if (m_Socket == INVALID_SOCKET)
+	{
+		return;
+	}
+
+	{
+		CThreadSafe ThreadSafe(&m_csRecv);
+
+		m_bClosing = true;
+
+		if (m_bRecving)
+		{
+			CancelIoEx((HANDLE)m_Socket, &m_RecvOverlapped.Overlapped);
+		}
+	}
+
+	// ȴȡĽ(¼ѭֹͣٴ)
+	while (m_lOutstanding != 0 && m_pLoop->CRosaEventLoopIsRunning())
+	{
+		Sleep(0);
+	}
+
+	m_SendQueue.CRosaSendQueueDestroy();
+
+	FailAll(ROSA_RPC_STATUS_CLOSED);
+
+	{
+		CThreadSafe ThreadSafe(&m_csCall);
+		m_setIncoming.clear();
+	}
+
+	m_vecRecv.clear();
+	m_uiRecvLength = 0;
+	m_bRecving = false;
+
+	m_Socket = INVALID_SOCKET;
+	m_pLoop = NULL;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRpcCall()
+// @Purpose: CRosaRpc(; ЧIDʱصǡִһ: Ӧ¼ѭ߳, ʱڶʱ߳, ȡ/ڵ߳)
+// @Since: v1.00a
+// @Para: USHORT sMethod()
+// @Para: const char* pData(, غͷ)
+// @Para: UINT uiSize(󳤶, Ϊ0)
+// @Para: DWORD dwTimeOutMSec(ʱ, ROSA_RPC_NO_DEADLINE:)
+// @Para: HANDLE_RPC_RESPONSE_CALLBACK pCallback(Ӧص, ΪNULL)
+// @Para: DWORD_PTR dwUser(û)
+// @Return: ULONGLONG ullCallID (ROSA_RPC_CALL_NIL:δ󶨻ѶϿ, ص)
+//------------------------------------------------------------------
+ULONGLONG ROSARPC_CALLMODE CRosaRpc::CRosaRpcCall(USHORT sMethod, const char * pData, UINT uiSize, DWORD dwTimeOutMSec, HANDLE_RPC_RESPONSE_CALLBACK pCallback, DWORD_PTR dwUser)
+{
+	if (m_Socket == INVALID_SOCKET || (pData == NULL && uiSize != 0) || uiSize > ROSA_RPC_MAX_FRAME - sizeof(S_RPCHEADER))
+	{
+		return ROSA_RPC_CALL_NIL;
+	}
+
+	LPS_RPCCALL pCall = new (std::nothrow) S_RPCCALL;
+	if (pCall == NULL)
+	{
+		return ROSA_RPC_CALL_NIL;
+	}
+
+	pCall->pRpc = this;
+	pCall->ullTimerID = 0;
+	pCall->pCallback = pCallback;
+	pCall->dwUser = dwUser;
+
+	// ȵǼٷ, Ӧڱص; ʱڵǼǺ, ʱһҵ(뿪ٽpCallѱͷ)
+	ULONGLONG ullCallID = ROSA_RPC_CALL_NIL;
+
+	{
+		CThreadSafe ThreadSafe(&m_csCall);
+
+		if (m_bBroken)
+		{
+			delete pCall;
+			return ROSA_RPC_CALL_NIL;
+		}
+
+		pCall->ullCallID = ++m_ullNextCallID;
+		ullCallID = pCall->ullCallID;
+		m_mapCall.insert(pair<ULONGLONG, LPS_RPCCALL>(pCall->ullCallID, pCall));
+
+		if (dwTimeOutMSec != ROSA_RPC_NO_DEADLINE)
+		{
+			pCall->ullTimerID = m_pLoop->CRosaEventLoopSetTimer(dwTimeOutMSec, 0, OnDeadline, pCall);
+		}
+	}
+
+	int nRet = SendFrame(ROSA_RPC_TYPE_REQUEST, sMethod, ROSA_RPC_STATUS_OK, ullCallID, dwTimeOutMSec, pData, uiSize);
+	if (nRet != SOB_RET_OK)
+	{
+		// ӶϿʱBrokenͳһ
+		pCall = TakeCall(ullCallID);
+		if (pCall != NULL)
+		{
+			CompleteCall(pCall, (nRet == SOB_RET_CLOSE) ? ROSA_RPC_STATUS_CLOSED : ROSA_RPC_STATUS_SENDFAIL, NULL, 0);
+		}
+	}
+
+	return ullCallID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRpcCallFuture()
+// @Purpose: CRosaRpcòصȴ(ɺȡnStatus/pData/uiSize)
+// @Since: v1.00a
+// @Para: USHORT sMethod()
+// @Para: const char* pData()
+// @Para: UINT uiSize(󳤶)
+// @Para: DWORD dwTimeOutMSec(ʱ, ROSA_RPC_NO_DEADLINE:)
+// @Return: LPS_RPCFUTURE pFuture (NULL:ʧ; ʹúCRosaRpcFutureRelease)
+//------------------------------------------------------------------
+LPS_RPCFUTURE ROSARPC_CALLMODE CRosaRpc::CRosaRpcCallFuture(USHORT sMethod, const char * pData, UINT uiSize, DWORD dwTimeOutMSec)
+{
+	LPS_RPCFUTURE pFuture = new (std::nothrow) S_RPCFUTURE;
+	if (pFuture == NULL)
+	{
+		return NULL;
+	}
+
+	pFuture->hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+	pFuture->lRef = 2;
+	pFuture->ullCallID = ROSA_RPC_CALL_NIL;
+	pFuture->nStatus = ROSA_RPC_STATUS_CLOSED;
+	pFuture->pData = NULL;
+	pFuture->uiSize = 0;
+
+	if (pFuture->hEvent == NULL)
+	{
+		delete pFuture;
+		return NULL;
+	}
+
+	pFuture->ullCallID = CRosaRpcCall(sMethod, pData, uiSize, dwTimeOutMSec, OnFutureComplete, (DWORD_PTR)pFuture);
+	if (pFuture->ullCallID == ROSA_RPC_CALL_NIL)
+	{
+		CloseHandle(pFuture->hEvent);
+		delete pFuture;
+		return NULL;
+	}
+
+	return pFuture;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRpcCancel()
+// @Purpose: CRosaRpcȡ(ڵǰ̻߳صCANCELLED, ֪ͨԶ˲ػظ)
+// @Since: v1.00a
+// @Para: ULONGLONG ullCallID(ID)
+// @Return: bool bRet (true:ȡ, false:òڻѾ)
+//------------------------------------------------------------------
+bool ROSARPC_CALLMODE CRosaRpc::CRosaRpcCancel(ULONGLONG ullCallID)
+{
+	LPS_RPCCALL pCall = TakeCall(ullCallID);
+	if (pCall == NULL)
+	{
+		return false;
+	}
+
+	SendFrame(ROSA_RPC_TYPE_CANCEL, 0, ROSA_RPC_STATUS_CANCELLED, ullCallID, 0, NULL, 0);
+	CompleteCall(pCall, ROSA_RPC_STATUS_CANCELLED, NULL, 0);
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRpcReply()
+// @Purpose: CRosaRpcظ(߳, ÿֻܻظһ)
+// @Since: v1.00a
+// @Para: ULONGLONG ullCallID(S_RPCREQUEST::ullCallID)
+// @Para: int nStatus(ROSA_RPC_STATUS_OKӦԶ״̬)
+// @Para: const char* pData(Ӧ, غͷ)
+// @Para: UINT uiSize(Ӧ𳤶, Ϊ0)
+// @Return: int nRet (SOB_RET_OK:, SOB_RET_FAIL:󲻴/ѱȡ/ڴ, SOB_RET_CLOSE:ѶϿ)
+//------------------------------------------------------------------
+int ROSARPC_CALLMODE CRosaRpc::CRosaRpcReply(ULONGLONG ullCallID, int nStatus, const char * pData, UINT uiSize)
+{
+	if (nStatus < 0 || nStatus > 0xFF || (pData == NULL && uiSize != 0) || uiSize > ROSA_RPC_MAX_FRAME - sizeof(S_RPCHEADER))
+	{
+		return SOB_RET_FAIL;
+	}
+
+	{
+		CThreadSafe ThreadSafe(&m_csCall);
+
+		if (m_setIncoming.erase(ullCallID) == 0)
+		{
+			return SOB_RET_FAIL;
+		}
+	}
+
+	return SendFrame(ROSA_RPC_TYPE_RESPONSE, 0, (BYTE)nStatus, ullCallID, 0, pData, uiSize);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRpcGetPendingCount()
+// @Purpose: CRosaRpcȡδɵĵ
+// @Since: v1.00a
+// @Para: None
+// @Return: UINT uiCount
+//------------------------------------------------------------------
+UINT ROSARPC_CALLMODE CRosaRpc::CRosaRpcGetPendingCount()
+{
+	CThreadSafe ThreadSafe(&m_csCall);
+
+	return (UINT)m_mapCall.size();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRpcGetIncomingCount()
+// @Purpose: CRosaRpcȡδظĶԶ
+// @Since: v1.00a
+// @Para: None
+// @Return: UINT uiCount
+//------------------------------------------------------------------
+UINT ROSARPC_CALLMODE CRosaRpc::CRosaRpcGetIncomingCount()
+{
+	CThreadSafe ThreadSafe(&m_csCall);
+
+	return (UINT)m_setIncoming.size();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRpcGetSocket()
+// @Purpose: CRosaRpcȡ׽
+// @Since: v1.00a
+// @Para: None
+// @Return: SOCKET s
+//------------------------------------------------------------------
+SOCKET ROSARPC_CALLMODE CRosaRpc::CRosaRpcGetSocket() const
+{
+	return m_Socket;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRpcFutureWait()
+// @Purpose: CRosaRpcȴ
+// @Since: v1.00a
+// @Para: LPS_RPCFUTURE pFuture(ȴ)
+// @Para: DWORD dwMSec(ȴʱ)
+// @Return: int nRet (SOB_RET_OK:, SOB_RET_TIMEOUT:ȴʱ, SOB_RET_FAIL:Ч)
+//------------------------------------------------------------------
+int ROSARPC_CALLMODE CRosaRpc::CRosaRpcFutureWait(LPS_RPCFUTURE pFuture, DWORD dwMSec)
+{
+	if (pFuture == NULL)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	DWORD dwRet = WaitForSingleObject(pFuture->hEvent, dwMSec);
+
+	return (dwRet == WAIT_OBJECT_0) ? SOB_RET_OK : ((dwRet == WAIT_TIMEOUT) ? SOB_RET_TIMEOUT : SOB_RET_FAIL);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaRpcFutureRelease()
+// @Purpose: CRosaRpcͷŵȴ(δʱȡ, Ӧ𵽴ͷ)
+// @Since: v1.00a
+// @Para: LPS_RPCFUTURE pFuture(ȴ)
+// @Return: None
+//------------------------------------------------------------------
+void ROSARPC_CALLMODE CRosaRpc::CRosaRpcFutureRelease(LPS_RPCFUTURE pFuture)
+{
+	if (pFuture == NULL || InterlockedDecrement(&pFuture->lRef) != 0)
+	{
+		return;
+	}
+
+	CloseHandle(pFuture->hEvent);
+
+	if (pFuture->pData)
+	{
+		delete[] pFuture->pData;
+	}
+
+	delete pFuture;
+}
+
+//------------------------------------------------------------------
+// @Function:	 SendFrame()
+// @Purpose: CRosaRpc֡д뷢Ͷ(֡ͷͬһ, һֻ֡ռһϢ, ߳д벻ύ)
+// @Since: v1.00a
+// @Para: BYTE byType(֡)
+// @Para: USHORT sMethod()
+// @Para: BYTE byStatus(Ӧ״̬)
+// @Para: ULONGLONG ullCallID(ID)
+// @Para: DWORD dwTimeOutMSec(ʱ)
+// @Para: const char* pData()
+// @Para: UINT uiSize(ݳ)
+// @Return: int nRet (ͬCRosaSendQueueSendShared)
+//------------------------------------------------------------------
+int CRosaRpc::SendFrame(BYTE byType, USHORT sMethod, BYTE byStatus, ULONGLONG ullCallID, DWORD dwTimeOutMSec, const char * pData, UINT uiSize)
+{
+	LPS_SHAREDPAYLOAD pPayload = CRosaSendQueue::CRosaSendQueueAllocPayload(sizeof(S_RPCHEADER) + uiSize);
+	if (pPayload == NULL)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	S_RPCHEADER sHeader;
+	sHeader.dwLength = sizeof(S_RPCHEADER) + uiSize;
+	sHeader.sMethod = sMethod;
+	sHeader.byType = byType;
+	sHeader.byStatus = byStatus;
+	sHeader.ullCallID = ullCallID;
+	sHeader.dwTimeOutMSec = dwTimeOutMSec;
+	sHeader.dwReserved = 0;
+
+	memcpy(pPayload->chData, &sHeader, sizeof(sHeader));
+	if (uiSize > 0)
+	{
+		memcpy(pPayload->chData + sizeof(sHeader), pData, uiSize);
+	}
+	pPayload->uiSize = sHeader.dwLength;
+
+	int nRet = m_SendQueue.CRosaSendQueueSendShared(pPayload);
+	CRosaSendQueue::CRosaSendQueueReleasePayload(pPayload);
+
+	return nRet;
+}
+
+//------------------------------------------------------------------
+// @Function:	 TakeCall()
+// @Purpose: CRosaRpcδɵƳ(Ӧ/ʱ/ȡ/Ͽʱֻһȡ)
+// @Since: v1.00a
+// @Para: ULONGLONG ullCallID(ID)
+// @Return: LPS_RPCCALL pCall (NULL:ڻѾ)
+//------------------------------------------------------------------
+LPS_RPCCALL CRosaRpc::TakeCall(ULONGLONG ullCallID)
+{
+	CThreadSafe ThreadSafe(&m_csCall);
+
+	map<ULONGLONG, LPS_RPCCALL>::iterator iter = m_mapCall.find(ullCallID);
+	if (iter == m_mapCall.end())
+	{
+		return NULL;
+	}
+
+	LPS_RPCCALL pCall = iter->second;
+	m_mapCall.erase(iter);
+
+	return pCall;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CompleteCall()
+// @Purpose: CRosaRpcɾʱص, Ȼͷŵ(m_csCall, ɾʱʱܵȴص)
+// @Since: v1.00a
+// @Para: LPS_RPCCALL pCall(TakeCallƳĵ)
+// @Para: int nStatus(Ӧ״̬)
+// @Para: const char* pData(Ӧ)
+// @Para: UINT uiSize(Ӧ𳤶)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaRpc::CompleteCall(LPS_RPCCALL pCall, int nStatus, const char * pData, UINT uiSize)
+{
+	// ڻصִ, Ҳú󷵻; ɾʱغͷpCall
+	if (pCall->ullTimerID != 0)
+	{
+		m_pLoop->CRosaEventLoopKillTimer(pCall->ullTimerID);
+	}
+
+	if (pCall->pCallback)
+	{
+		pCall->pCallback(pCall->ullCallID, nStatus, pData, uiSize, pCall->dwUser);
+	}
+
+	delete pCall;
+}
+
+//------------------------------------------------------------------
+// @Function:	 FailAll()
+// @Purpose: CRosaRpcȫδɵnStatus(֮ĵֱʧ)
+// @Since: v1.00a
+// @Para: int nStatus(Ӧ״̬)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaRpc::FailAll(int nStatus)
+{
+	map<ULONGLONG, LPS_RPCCALL> mapCall;
+
+	{
+		CThreadSafe ThreadSafe(&m_csCall);
+
+		m_bBroken = true;
+		mapCall.swap(m_mapCall);
+	}
+
+	for (map<ULONGLONG, LPS_RPCCALL>::iterator iter = mapCall.begin(); iter != mapCall.end(); ++iter)
+	{
+		CompleteCall(iter->second, nStatus, NULL, 0);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 PostRecv()
+// @Purpose: CRosaRpcͶWSARecv(вʱ󻺳, ߳m_csRecv)
+// @Since: v1.00a
+// @Para: None
+// @Return: bool bRet (true:Ͷ, false:ʧ)
+//------------------------------------------------------------------
+bool CRosaRpc::PostRecv()
+{
+	if (m_bClosing)
+	{
+		return false;
+	}
+
+	// δɵ֡Ȼ峤ʱ֡
+	UINT uiNeed = m_uiRecvLength + ROSA_RPC_RECV_MIN;
+	if (m_uiRecvLength >= sizeof(S_RPCHEADER))
+	{
+		S_RPCHEADER sHeader;
+		memcpy(&sHeader, &m_vecRecv[0], sizeof(sHeader));
+
+		if (sHeader.dwLength > uiNeed)
+		{
+			uiNeed = sHeader.dwLength;
+		}
+	}
+
+	if (m_vecRecv.size() < uiNeed)
+	{
+		m_vecRecv.resize(uiNeed);
+	}
+
+	WSABUF wsaBuf;
+	wsaBuf.buf = &m_vecRecv[0] + m_uiRecvLength;
+	wsaBuf.len = (ULONG)(m_vecRecv.size() - m_uiRecvLength);
+
+	memset(&m_RecvOverlapped.Overlapped, 0, sizeof(m_RecvOverlapped.Overlapped));
+
+	InterlockedIncrement(&m_lOutstanding);
+	m_bRecving = true;
+
+	DWORD dwFlags = 0;
+	if (WSARecv(m_Socket, &wsaBuf, 1, NULL, &dwFlags, &m_RecvOverlapped.Overlapped, NULL) == SOCKET_ERROR)
+	{
+		if (WSAGetLastError() != WSA_IO_PENDING)
+		{
+			m_bRecving = false;
+			InterlockedDecrement(&m_lOutstanding);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ParseFrames()
+// @Purpose: CRosaRpcе֡, ʣಿƵͷ(ͬһʱֻһ, ֡˳)
+// @Since: v1.00a
+// @Para: None
+// @Return: bool bRet (true:ɹ, false:֡ͷЧ)
+//------------------------------------------------------------------
+bool CRosaRpc::ParseFrames()
+{
+	UINT uiOffset = 0;
+
+	while (m_uiRecvLength - uiOffset >= sizeof(S_RPCHEADER))
+	{
+		const char* pFrame = &m_vecRecv[0] + uiOffset;
+
+		S_RPCHEADER sHeader;
+		memcpy(&sHeader, pFrame, sizeof(sHeader));
+
+		if (sHeader.dwLength < sizeof(S_RPCHEADER) || sHeader.dwLength > ROSA_RPC_MAX_FRAME ||
+			sHeader.byType < ROSA_RPC_TYPE_REQUEST || sHeader.byType > ROSA_RPC_TYPE_CANCEL)
+		{
+			return false;
+		}
+
+		if (m_uiRecvLength - uiOffset < sHeader.dwLength)
+		{
+			break;
+		}
+
+		OnFrame(sHeader, pFrame + sizeof(S_RPCHEADER), sHeader.dwLength - sizeof(S_RPCHEADER));
+		uiOffset += sHeader.dwLength;
+	}
+
+	if (uiOffset > 0)
+	{
+		m_uiRecvLength -= uiOffset;
+
+		if (m_uiRecvLength > 0)
+		{
+			memmove(&m_vecRecv[0], &m_vecRecv[0] + uiOffset, m_uiRecvLength);
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnFrame()
+// @Purpose: CRosaRpcһ֡(ָջ, ֻڱЧ)
+// @Since: v1.00a
+// @Para: const S_RPCHEADER& sHeader(֡ͷ)
+// @Para: const char* pData()
+// @Para: UINT uiSize(ݳ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaRpc::OnFrame(const S_RPCHEADER & sHeader, const char * pData, UINT uiSize)
+{
+	switch (sHeader.byType)
+	{
+	case ROSA_RPC_TYPE_REQUEST:
+		{
+			{
+				CThreadSafe ThreadSafe(&m_csCall);
+				m_setIncoming.insert(sHeader.ullCallID);
+			}
+
+			if (m_pRequestCallback == NULL)
+			{
+				CRosaRpcReply(sHeader.ullCallID, ROSA_RPC_STATUS_NOMETHOD, NULL, 0);
+				break;
+			}
+
+			S_RPCREQUEST sRequest;
+			sRequest.ullCallID = sHeader.ullCallID;
+			sRequest.sMethod = sHeader.sMethod;
+			sRequest.dwTimeOutMSec = sHeader.dwTimeOutMSec;
+			sRequest.pData = pData;
+			sRequest.uiSize = uiSize;
+
+			m_pRequestCallback(this, &sRequest, m_dwUser);
+		}
+		break;
+	case ROSA_RPC_TYPE_RESPONSE:
+		{
+			// ѳʱȡĵóٵӦֱӶ
+			LPS_RPCCALL pCall = TakeCall(sHeader.ullCallID);
+			if (pCall != NULL)
+			{
+				CompleteCall(pCall, sHeader.byStatus, pData, uiSize);
+			}
+		}
+		break;
+	case ROSA_RPC_TYPE_CANCEL:
+		{
+			// ֮CRosaRpcReplyʧ, ٷӦ
+			CThreadSafe ThreadSafe(&m_csCall);
+			m_setIncoming.erase(sHeader.ullCallID);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 Broken()
+// @Purpose: CRosaRpcӶϿ(ջʧ, ֻһ; δɵûصCLOSEDصϿ)
+// @Since: v1.00a
+// @Para: int nResult(SOB_RET_CLOSE:Զ˹ر, SOB_RET_FAIL:)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaRpc::Broken(int nResult)
+{
+	if (InterlockedExchange(&m_lBroken, 1) != 0)
+	{
+		return;
+	}
+
+	FailAll(ROSA_RPC_STATUS_CLOSED);
+
+	{
+		CThreadSafe ThreadSafe(&m_csCall);
+		m_setIncoming.clear();
+	}
+
+	if (m_pCloseCallback && !m_bClosing)
+	{
+		m_pCloseCallback(this, nResult, m_dwUser);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnRecvComplete()
+// @Purpose: CRosaRpc(¼ѭ߳, ֡)
+// @Since: v1.00a
+// @Para: LPS_ROSAOVERLAPPED pOverlapped(m_RecvOverlapped)
+// @Para: DWORD dwBytes(ֽ)
+// @Para: DWORD dwError()
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaRpc::OnRecvComplete(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError)
+{
+	CRosaRpc* pThis = (CRosaRpc*)pOverlapped->pUser;
+
+	{
+		CThreadSafe ThreadSafe(&pThis->m_csRecv);
+		pThis->m_bRecving = false;
+	}
+
+	if (!pThis->m_bClosing)
+	{
+		if (dwError != 0 || dwBytes == 0)
+		{
+			pThis->Broken((dwError == 0 || dwError == WSAECONNRESET || dwError == ERROR_NETNAME_DELETED) ? SOB_RET_CLOSE : SOB_RET_FAIL);
+		}
+		else
+		{
+			pThis->m_uiRecvLength += dwBytes;
+
+			if (!pThis->ParseFrames())
+			{
+				pThis->Broken(SOB_RET_FAIL);
+			}
+			else
+			{
+				CThreadSafe ThreadSafe(&pThis->m_csRecv);
+
+				if (!pThis->m_bClosing && !pThis->PostRecv())
+				{
+					pThis->Broken(SOB_RET_FAIL);
+				}
+			}
+		}
+	}
+
+	InterlockedDecrement(&pThis->m_lOutstanding);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnDeadline()
+// @Purpose: CRosaRpcֹʱ䵽(صTIMEOUT֪ͨԶȡ; ʱ)
+// @Since: v1.00a
+// @Para: ULONGLONG ullTimerID(ʱID)
+// @Para: void* pUser(S_RPCCALL, ɷɾʱغͷ)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaRpc::OnDeadline(ULONGLONG ullTimerID, void * pUser)
+{
+	LPS_RPCCALL pCall = (LPS_RPCCALL)pUser;
+	CRosaRpc* pThis = pCall->pRpc;
+
+	if (pThis->TakeCall(pCall->ullCallID) == NULL)
+	{
+		return;
+	}
+
+	// һԶʱѾɾ
+	pCall->ullTimerID = 0;
+
+	pThis->SendFrame(ROSA_RPC_TYPE_CANCEL, 0, ROSA_RPC_STATUS_TIMEOUT, pCall->ullCallID, 0, NULL, 0);
+	pThis->CompleteCall(pCall, ROSA_RPC_STATUS_TIMEOUT, NULL, 0);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnSendClose()
+// @Purpose: CRosaRpcʧ(Ͷ)
+// @Since: v1.00a
+// @Para: SOCKET s(׽)
+// @Para: int nResult(SOB_RET_CLOSE/SOB_RET_FAIL)
+// @Para: DWORD_PTR dwUser(CRosaRpc)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaRpc::OnSendClose(SOCKET s, int nResult, DWORD_PTR dwUser)
+{
+	CRosaRpc* pThis = (CRosaRpc*)dwUser;
+
+	pThis->Broken(nResult);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnFutureComplete()
+// @Purpose: CRosaRpcȴ(Ӧλ¼)
+// @Since: v1.00a
+// @Para: ULONGLONG ullCallID(ID)
+// @Para: int nStatus(Ӧ״̬)
+// @Para: const char* pData(Ӧ)
+// @Para: UINT uiSize(Ӧ𳤶)
+// @Para: DWORD_PTR dwUser(S_RPCFUTURE)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaRpc::OnFutureComplete(ULONGLONG ullCallID, int nStatus, const char * pData, UINT uiSize, DWORD_PTR dwUser)
+{
+	LPS_RPCFUTURE pFuture = (LPS_RPCFUTURE)dwUser;
+
+	pFuture->nStatus = nStatus;
+
+	if (uiSize > 0)
+	{
+		pFuture->pData = new (std::nothrow) char[uiSize];
+		if (pFuture->pData)
+		{
+			memcpy(pFuture->pData, pData, uiSize);
+			pFuture->uiSize = uiSize;
+		}
+	}
+
+	SetEvent(pFuture->hEvent);
+	CRosaRpcFutureRelease(pFuture);
+}
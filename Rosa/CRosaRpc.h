@@ -0,0 +1,168 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaRpc.h
+* @brief	This File is RosaRpc Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSARPC_H__
+#define __CROSARPC_H__
+
+//Include Rosa Header File
+#include "CRosaSocket.h"
+#include "CRosaEventLoop.h"
+#include "CRosaSendQueue.h"
+
+//Include C/C++ Header File
+#include <map>
+#include <set>
+#include <vector>
+
+using namespace std;
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSARPC_API	__declspec(dllexport)
+#else
+#define ROSARPC_API	__declspec(dllimport)
+#endif
+
+#define ROSARPC_CALLMODE	__stdcall
+
+#define ROSA_RPC_TYPE_REQUEST		1					//֡:
+#define ROSA_RPC_TYPE_RESPONSE		2					//֡:Ӧ
+#define ROSA_RPC_TYPE_CANCEL		3					//֡:ȡ(÷ٵȴӦ)
+
+#define ROSA_RPC_STATUS_OK			0					//óɹ
+#define ROSA_RPC_STATUS_TIMEOUT		1					//ֹʱ䵽(ж)
+#define ROSA_RPC_STATUS_CANCELLED	2					//÷ȡ
+#define ROSA_RPC_STATUS_CLOSED		3					//ӶϿ˵
+#define ROSA_RPC_STATUS_NOMETHOD	4					//Զûص
+#define ROSA_RPC_STATUS_SENDFAIL	5					//Ͷоܾд(ڴ)
+#define ROSA_RPC_STATUS_USER		16					//ӦԶ״̬ʼֵ(16~255)
+
+#define ROSA_RPC_CALL_NIL			0					//ЧID
+#define ROSA_RPC_NO_DEADLINE		0					//ֹʱ
+#define ROSA_RPC_RECV_BUFFER		(64 * 1024)			//ջʼ(֡ʱ)
+#define ROSA_RPC_RECV_MIN			4096				//ÿWSARecvСг
+#define ROSA_RPC_MAX_FRAME			(16 * 1024 * 1024)	//֡󳤶(жΪЭ)
+
+//Struct Definition
+typedef struct
+{
+	DWORD dwLength;							// ֡(֡ͷ)
+	USHORT sMethod;							// 
+	BYTE byType;							// ֡(ROSA_RPC_TYPE_*)
+	BYTE byStatus;							// Ӧ״̬(ROSA_RPC_STATUS_*)
+	ULONGLONG ullCallID;					// ID(ɵ÷, Ӧԭ)
+	DWORD dwTimeOutMSec;					// ÷ʱ(, 0:)
+	DWORD dwReserved;						// 
+}S_RPCHEADER, *LPS_RPCHEADER;
+
+typedef struct
+{
+	ULONGLONG ullCallID;					// ID(ظʱʹ)
+	USHORT sMethod;							// 
+	DWORD dwTimeOutMSec;					// ÷ʱ(, 0:)
+	const char* pData;						// (ֻڻصڼЧ)
+	UINT uiSize;							// 󳤶
+}S_RPCREQUEST, *LPS_RPCREQUEST;
+
+typedef struct
+{
+	HANDLE hEvent;							// ¼
+	volatile LONG lRef;						// ü(߼ɻصһ)
+	ULONGLONG ullCallID;					// ID(ȡ)
+	int nStatus;							// Ӧ״̬(ɺЧ)
+	char* pData;							// Ӧ(ɺЧ)
+	UINT uiSize;							// Ӧ𳤶
+}S_RPCFUTURE, *LPS_RPCFUTURE;
+
+//Class Declaration
+class CRosaRpc;
+
+//Callback Definition
+typedef void(__stdcall *HANDLE_RPC_RESPONSE_CALLBACK)(ULONGLONG ullCallID, int nStatus, const char* pData, UINT uiSize, DWORD_PTR dwUser);	//Ӧص(ÿεǡûصһ, ֻڻصڼЧ)
+typedef void(__stdcall *HANDLE_RPC_REQUEST_CALLBACK)(CRosaRpc* pRpc, const S_RPCREQUEST* pRequest, DWORD_PTR dwUser);					//ص(̵֮߳CRosaRpcReply)
+typedef void(__stdcall *HANDLE_RPC_CLOSE_CALLBACK)(CRosaRpc* pRpc, int nResult, DWORD_PTR dwUser);										//ӶϿص(δɵѻصCLOSED, Ӧùر)
+
+typedef struct
+{
+	CRosaRpc* pRpc;							// ˵
+	ULONGLONG ullCallID;					// ID
+	ULONGLONG ullTimerID;					// ֹʱ䶨ʱ(0:)
+	HANDLE_RPC_RESPONSE_CALLBACK pCallback;	// Ӧص
+	DWORD_PTR dwUser;						// û
+}S_RPCCALL, *LPS_RPCCALL;
+
+//Class Definition
+class ROSARPC_API CRosaRpc
+{
+public:
+	CRosaRpc();			// CRosaRpc 캯
+	~CRosaRpc();		// CRosaRpc 
+
+public:
+	bool ROSARPC_CALLMODE CRosaRpcCreate(SOCKET s, CRosaEventLoop* pLoop, HANDLE_RPC_REQUEST_CALLBACK pRequestCallback, HANDLE_RPC_CLOSE_CALLBACK pCloseCallback, DWORD_PTR dwUser, UINT uiMaxBytes = ROSA_SENDQUEUE_MAX_BYTES);	// CRosaRpc Ӳʼ
+	void ROSARPC_CALLMODE CRosaRpcDestroy();												// CRosaRpc ֹͣ, δɵûصCLOSED(ر׽)
+
+	ULONGLONG ROSARPC_CALLMODE CRosaRpcCall(USHORT sMethod, const char* pData, UINT uiSize, DWORD dwTimeOutMSec, HANDLE_RPC_RESPONSE_CALLBACK pCallback, DWORD_PTR dwUser);	// CRosaRpc (, صID)
+	LPS_RPCFUTURE ROSARPC_CALLMODE CRosaRpcCallFuture(USHORT sMethod, const char* pData, UINT uiSize, DWORD dwTimeOutMSec);	// CRosaRpc (صȴ)
+	bool ROSARPC_CALLMODE CRosaRpcCancel(ULONGLONG ullCallID);							// CRosaRpc ȡ(صCANCELLED֪ͨԶ)
+	int ROSARPC_CALLMODE CRosaRpcReply(ULONGLONG ullCallID, int nStatus, const char* pData, UINT uiSize);	// CRosaRpc ظ(߳)
+
+	UINT ROSARPC_CALLMODE CRosaRpcGetPendingCount();										// CRosaRpc ȡδɵĵ
+	UINT ROSARPC_CALLMODE CRosaRpcGetIncomingCount();										// CRosaRpc ȡδظ
+	SOCKET ROSARPC_CALLMODE CRosaRpcGetSocket() const;									// CRosaRpc ȡ׽
+
+	static int ROSARPC_CALLMODE CRosaRpcFutureWait(LPS_RPCFUTURE pFuture, DWORD dwMSec = INFINITE);	// CRosaRpc ȴ
+	static void ROSARPC_CALLMODE CRosaRpcFutureRelease(LPS_RPCFUTURE pFuture);						// CRosaRpc ͷŵȴ(֮ǰͷ)
+
+private:
+	int SendFrame(BYTE byType, USHORT sMethod, BYTE byStatus, ULONGLONG ullCallID, DWORD dwTimeOutMSec, const char* pData, UINT uiSize);	// CRosaRpc ֡д뷢Ͷ
+	LPS_RPCCALL TakeCall(ULONGLONG ullCallID);											// CRosaRpc δɵƳ(NULL:Ѿ)
+	void CompleteCall(LPS_RPCCALL pCall, int nStatus, const char* pData, UINT uiSize);	// CRosaRpc ɾʱص(Ƴ)
+	void FailAll(int nStatus);															// CRosaRpc ȫδɵnStatus
+	bool PostRecv();																	// CRosaRpc ͶWSARecv(߳m_csRecv)
+	bool ParseFrames();																	// CRosaRpc е֡(false:Э)
+	void OnFrame(const S_RPCHEADER& sHeader, const char* pData, UINT uiSize);			// CRosaRpc һ֡
+	void Broken(int nResult);															// CRosaRpc ӶϿ(ֻһ)
+
+	static void __stdcall OnRecvComplete(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError);	// CRosaRpc (¼ѭ߳)
+	static void __stdcall OnDeadline(ULONGLONG ullTimerID, void* pUser);							// CRosaRpc ֹʱ䵽(ʱ߳)
+	static void __stdcall OnSendClose(SOCKET s, int nResult, DWORD_PTR dwUser);						// CRosaRpc ʧ
+	static void __stdcall OnFutureComplete(ULONGLONG ullCallID, int nStatus, const char* pData, UINT uiSize, DWORD_PTR dwUser);	// CRosaRpc ȴ
+
+private:
+	SOCKET m_Socket;										// CRosaRpc ׽
+	CRosaEventLoop* m_pLoop;								// CRosaRpc ¼ѭ
+	CRosaSendQueue m_SendQueue;								// CRosaRpc Ͷ(һ֡һϢ, ߳д벻)
+
+	HANDLE_RPC_REQUEST_CALLBACK m_pRequestCallback;			// CRosaRpc ص
+	HANDLE_RPC_CLOSE_CALLBACK m_pCloseCallback;				// CRosaRpc ӶϿص
+	DWORD_PTR m_dwUser;										// CRosaRpc û
+
+	CRITICAL_SECTION m_csCall;								// CRosaRpc ñٽ
+	map<ULONGLONG, LPS_RPCCALL> m_mapCall;					// CRosaRpc δɵĵ(ID)
+	set<ULONGLONG> m_setIncoming;							// CRosaRpc δظĶԶ(ȡƳ)
+	ULONGLONG m_ullNextCallID;								// CRosaRpc һID
+	bool m_bBroken;											// CRosaRpc ѶϿ(֮ĵֱʧ)
+
+	CRITICAL_SECTION m_csRecv;								// CRosaRpc ٽ(Ͷȡ)
+	vector<char> m_vecRecv;									// CRosaRpc ջ
+	UINT m_uiRecvLength;									// CRosaRpc ѽյĳ
+	bool m_bRecving;										// CRosaRpc ǷWSARecvδ
+	bool m_bClosing;										// CRosaRpc (ٻصϿ)
+	volatile LONG m_lBroken;								// CRosaRpc ϿǷѴ
+	volatile LONG m_lOutstanding;							// CRosaRpc δĽ(ɻصִ)
+	S_ROSAOVERLAPPED m_RecvOverlapped;						// CRosaRpc صṹ
+
+};
+
+#endif // !__CROSARPC_H__
@@ -0,0 +1,1000 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaSendQueue.cpp
+* @brief	This File is RosaSendQueue Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaSendQueue.h"
+#include "CThreadSafe.h"
+
+//CRosaSendQueue Ͷ(д벻, ɶ˿, ߵˮλѹ, ߳̿Ծд, ѡ)
+
+// ݻ(ROSA_SENDQUEUE_POOL_BLOCK, ̬ʼΪ; ͷźĿײڵ, ѷMEMORY_ALLOCATION_ALIGNMENT)
+static SLIST_HEADER s_PayloadPool;
+static volatile LONG s_lPayloadPoolCount = 0;
+
+// ʹתΪֵ(ѶϿSOB_RET_CLOSE)
+static int TranslateSendError(DWORD dwError)
+{
+	switch (dwError)
+	{
+	case WSAECONNRESET:
+	case WSAECONNABORTED:
+	case WSAENETRESET:
+	case WSAESHUTDOWN:
+	case ERROR_NETNAME_DELETED:
+		return SOB_RET_CLOSE;
+	default:
+		return SOB_RET_FAIL;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSendQueue()
+// @Purpose: CRosaSendQueue캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaSendQueue::CRosaSendQueue()
+{
+	m_Socket = INVALID_SOCKET;
+	m_pLoop = NULL;
+
+	m_pWatermarkCallback = NULL;
+	m_pCloseCallback = NULL;
+	m_dwUser = 0;
+
+	m_uiHighBytes = ROSA_SENDQUEUE_HIGH_BYTES;
+	m_uiLowBytes = ROSA_SENDQUEUE_LOW_BYTES;
+	m_uiMaxBytes = ROSA_SENDQUEUE_MAX_BYTES;
+
+	m_lQueuedBytes = 0;
+	m_uiPeakBytes = 0;
+	m_uiInFlight = 0;
+	m_bSending = false;
+	m_bAboveHigh = false;
+	m_bBroken = false;
+	m_bClosing = false;
+	m_lOutstanding = 0;
+	memset(&m_SendOverlapped, 0, sizeof(m_SendOverlapped));
+
+	m_lDrainPosted = 0;
+	memset(&m_DrainOverlapped, 0, sizeof(m_DrainOverlapped));
+
+	m_pLimiter = NULL;
+	m_uiRateFlow = ROSA_RATELIMIT_NIL;
+	m_bThrottled = false;
+	m_lResumePosted = 0;
+	memset(&m_ResumeOverlapped, 0, sizeof(m_ResumeOverlapped));
+
+	InitializeCriticalSection(&m_csQueue);
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaSendQueue()
+// @Purpose: CRosaSendQueue
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaSendQueue::~CRosaSendQueue()
+{
+	CRosaSendQueueDestroy();
+
+	DeleteCriticalSection(&m_csQueue);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSendQueueCreate()
+// @Purpose: CRosaSendQueue׽ּ¼ѭ
+// @Since: v1.00a
+// @Para: SOCKET s(ӵص׽)
+// @Para: CRosaEventLoop* pLoop(Ѿ¼ѭ, صִ߳)
+// @Para: HANDLE_SENDQUEUE_WATERMARK_CALLBACK pWatermarkCallback(ˮλص, ΪNULL)
+// @Para: HANDLE_SENDQUEUE_CLOSE_CALLBACK pCloseCallback(ʧܻص, ΪNULL)
+// @Para: DWORD_PTR dwUser(û)
+// @Para: UINT uiHighBytes(ˮλ)
+// @Para: UINT uiLowBytes(ˮλ, ڸˮλ)
+// @Para: UINT uiMaxBytes(ڴ, Сڸˮλ, С2GB)
+// @Para: bool bAttach(Ƿ¼ѭ, Ѿͬһ¼ѭʱfalse)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSASENDQUEUE_CALLMODE CRosaSendQueue::CRosaSendQueueCreate(SOCKET s, CRosaEventLoop * pLoop, HANDLE_SENDQUEUE_WATERMARK_CALLBACK pWatermarkCallback, HANDLE_SENDQUEUE_CLOSE_CALLBACK pCloseCallback, DWORD_PTR dwUser, UINT uiHighBytes, UINT uiLowBytes, UINT uiMaxBytes, bool bAttach)
+{
+	if (m_Socket != INVALID_SOCKET || s == INVALID_SOCKET || pLoop == NULL || uiLowBytes > uiHighBytes || uiHighBytes > uiMaxBytes || uiMaxBytes > MAXLONG)
+	{
+		return false;
+	}
+
+	if (bAttach && !pLoop->CRosaEventLoopAttach((HANDLE)s))
+	{
+		return false;
+	}
+
+	m_pWatermarkCallback = pWatermarkCallback;
+	m_pCloseCallback = pCloseCallback;
+	m_dwUser = dwUser;
+
+	m_uiHighBytes = uiHighBytes;
+	m_uiLowBytes = uiLowBytes;
+	m_uiMaxBytes = uiMaxBytes;
+
+	m_lQueuedBytes = 0;
+	m_uiPeakBytes = 0;
+	m_uiInFlight = 0;
+	m_bSending = false;
+	m_bAboveHigh = false;
+	m_bBroken = false;
+	m_bClosing = false;
+	m_lOutstanding = 0;
+	m_lDrainPosted = 0;
+	m_bThrottled = false;
+	m_lResumePosted = 0;
+
+	m_SendOverlapped.pCallback = OnSendComplete;
+	m_SendOverlapped.pUser = this;
+
+	m_DrainOverlapped.pCallback = OnDrainPosted;
+	m_DrainOverlapped.pUser = this;
+
+	m_ResumeOverlapped.pCallback = OnRateResumed;
+	m_ResumeOverlapped.pUser = this;
+
+	m_Socket = s;
+	m_pLoop = pLoop;
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSendQueueDestroy()
+// @Purpose: CRosaSendQueueȡͲ(ر׽, ǰֹͣд)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSASENDQUEUE_CALLMODE CRosaSendQueue::CRosaSendQueueDestroy()
+{
+	if (m_Socket == INVALID_SOCKET)
+	{
+		return;
+	}
+
+	{
+		CThreadSafe ThreadSafe(&m_csQueue);
+
+		m_bClosing = true;
+
+		if (m_bSending)
+		{
+			CancelIoEx((HANDLE)m_Socket, &m_SendOverlapped.Overlapped);
+		}
+
+		// Ƴٻص
+		if (m_pLimiter != NULL)
+		{
+			m_pLimiter->CRosaRateLimiterRemoveFlow(m_uiRateFlow);
+			m_pLimiter = NULL;
+			m_uiRateFlow = ROSA_RATELIMIT_NIL;
+		}
+	}
+
+	// ȴȡķͼͶݵȡ/ָɰ(¼ѭֹͣٴ)
+	while (m_lOutstanding != 0 && m_pLoop->CRosaEventLoopIsRunning())
+	{
+		Sleep(0);
+	}
+
+	while (!m_Posted.CRosaMPSCQueueIsEmpty())
+	{
+		LPS_MPSCNODE pNode = m_Posted.CRosaMPSCQueuePop();
+		if (pNode != NULL)
+		{
+			FreeNode((LPS_SENDNODE)pNode);
+		}
+	}
+
+	for (deque<LPS_SENDNODE>::iterator iter = m_dqQueue.begin(); iter != m_dqQueue.end(); ++iter)
+	{
+		FreeNode(*iter);
+	}
+
+	m_dqQueue.clear();
+	m_lQueuedBytes = 0;
+	m_uiInFlight = 0;
+	m_bSending = false;
+	m_lDrainPosted = 0;
+	m_bThrottled = false;
+	m_lResumePosted = 0;
+
+	m_Socket = INVALID_SOCKET;
+	m_pLoop = NULL;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSendQueueSend()
+// @Purpose: CRosaSendQueueдϢ(ƺ, ɶ˿ڰ)
+// @Since: v1.00a
+// @Para: const char* pSendBuffer(, غͷ)
+// @Para: UINT uiBufferSize(ͳ)
+// @Return: int nRet (SOB_RET_OK:, SOB_RET_FAIL:ڴ޻δ, SOB_RET_CLOSE:ѶϿ)
+//------------------------------------------------------------------
+int ROSASENDQUEUE_CALLMODE CRosaSendQueue::CRosaSendQueueSend(const char * pSendBuffer, UINT uiBufferSize)
+{
+	if (uiBufferSize == 0)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	LPS_SENDNODE pNode = AllocNode(pSendBuffer, uiBufferSize);
+	if (pNode == NULL)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	CThreadSafe ThreadSafe(&m_csQueue);
+
+	return SendNode(pNode);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSendQueuePost()
+// @Purpose: CRosaSendQueueдϢ(߳, ·, ¼ѭ߳ȡ)
+// @Since: v1.00a
+// @Para: const char* pSendBuffer(, غͷ)
+// @Para: UINT uiBufferSize(ͳ)
+// @Return: int nRet (SOB_RET_OK:, SOB_RET_FAIL:ڴ޻δ, SOB_RET_CLOSE:ѶϿ)
+//------------------------------------------------------------------
+int ROSASENDQUEUE_CALLMODE CRosaSendQueue::CRosaSendQueuePost(const char * pSendBuffer, UINT uiBufferSize)
+{
+	if (uiBufferSize == 0)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	LPS_SENDNODE pNode = AllocNode(pSendBuffer, uiBufferSize);
+	if (pNode == NULL)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	return PostNode(pNode);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSendQueueSendShared()
+// @Purpose: CRosaSendQueueд빲(, ɻʱͷ)
+// @Since: v1.00a
+// @Para: LPS_SHAREDPAYLOAD pPayload(, ߳еò)
+// @Return: int nRet (SOB_RET_OK:, SOB_RET_FAIL:ڴ޻δ, SOB_RET_CLOSE:ѶϿ)
+//------------------------------------------------------------------
+int ROSASENDQUEUE_CALLMODE CRosaSendQueue::CRosaSendQueueSendShared(LPS_SHAREDPAYLOAD pPayload)
+{
+	if (pPayload == NULL || pPayload->uiSize == 0)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	LPS_SENDNODE pNode = AllocSharedNode(pPayload);
+	if (pNode == NULL)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	CThreadSafe ThreadSafe(&m_csQueue);
+
+	return SendNode(pNode);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSendQueuePostShared()
+// @Purpose: CRosaSendQueueд빲(߳, ·)
+// @Since: v1.00a
+// @Para: LPS_SHAREDPAYLOAD pPayload(, ߳еò)
+// @Return: int nRet (SOB_RET_OK:, SOB_RET_FAIL:ڴ޻δ, SOB_RET_CLOSE:ѶϿ)
+//------------------------------------------------------------------
+int ROSASENDQUEUE_CALLMODE CRosaSendQueue::CRosaSendQueuePostShared(LPS_SHAREDPAYLOAD pPayload)
+{
+	if (pPayload == NULL || pPayload->uiSize == 0)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	LPS_SENDNODE pNode = AllocSharedNode(pPayload);
+	if (pNode == NULL)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	return PostNode(pNode);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSendQueueSetRateLimit()
+// @Purpose: CRosaSendQueue÷(ͬһ¼ѭ, ͣʱռ߳, ʱָ)
+// @Since: v1.00a
+// @Para: CRosaRateLimiter* pLimiter(, NULLʱ)
+// @Para: UINT uiGroup(, ӹٲƽ)
+// @Para: const S_RATELIMIT& sLimit()
+// @Para: UINT uiWeight(Ȩ)
+// @Return: bool bRet (true:ɹ, false:δ󶨻鲻)
+//------------------------------------------------------------------
+bool ROSASENDQUEUE_CALLMODE CRosaSendQueue::CRosaSendQueueSetRateLimit(CRosaRateLimiter * pLimiter, UINT uiGroup, const S_RATELIMIT & sLimit, UINT uiWeight)
+{
+	CThreadSafe ThreadSafe(&m_csQueue);
+
+	if (m_Socket == INVALID_SOCKET || m_bClosing)
+	{
+		return false;
+	}
+
+	// ͬһֻ޸Ĳ, ѹ״̬
+	if (pLimiter != NULL && pLimiter == m_pLimiter)
+	{
+		return m_pLimiter->CRosaRateLimiterSetFlowLimit(m_uiRateFlow, sLimit, uiWeight);
+	}
+
+	if (m_pLimiter != NULL)
+	{
+		m_pLimiter->CRosaRateLimiterRemoveFlow(m_uiRateFlow);
+		m_pLimiter = NULL;
+		m_uiRateFlow = ROSA_RATELIMIT_NIL;
+	}
+
+	bool bRet = true;
+
+	if (pLimiter != NULL)
+	{
+		m_uiRateFlow = pLimiter->CRosaRateLimiterAddFlow(uiGroup, sLimit, uiWeight, OnRateResume, (DWORD_PTR)this);
+		if (m_uiRateFlow != ROSA_RATELIMIT_NIL)
+		{
+			m_pLimiter = pLimiter;
+		}
+		else
+		{
+			bRet = false;
+		}
+	}
+
+	// 
+	m_bThrottled = false;
+
+	if (!m_bBroken && !m_bSending)
+	{
+		StartSend();
+	}
+
+	return bRet;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSendQueueIsThrottled()
+// @Purpose: CRosaSendQueueǷͣ
+// @Since: v1.00a
+// @Para: None
+// @Return: bool bRet (true:ͣ, false:ͻ)
+//------------------------------------------------------------------
+bool ROSASENDQUEUE_CALLMODE CRosaSendQueue::CRosaSendQueueIsThrottled()
+{
+	// ȡ, 
+	return m_bThrottled;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSendQueueCreatePayload()
+// @Purpose: CRosaSendQueue(һ, ֮дͶ)
+// @Since: v1.00a
+// @Para: const char* pBuffer()
+// @Para: UINT uiBufferSize(ݳ)
+// @Return: LPS_SHAREDPAYLOAD pPayload (üΪ1, ʹϺCRosaSendQueueReleasePayload; NULL:ڴ治)
+//------------------------------------------------------------------
+LPS_SHAREDPAYLOAD ROSASENDQUEUE_CALLMODE CRosaSendQueue::CRosaSendQueueCreatePayload(const char * pBuffer, UINT uiBufferSize)
+{
+	LPS_SHAREDPAYLOAD pPayload = CRosaSendQueueAllocPayload(uiBufferSize);
+	if (pPayload == NULL)
+	{
+		return NULL;
+	}
+
+	memcpy(pPayload->chData, pBuffer, uiBufferSize);
+
+	// С鰴С, uiSizeĻʵʳ, ѻеľһ𷢳
+	pPayload->uiSize = uiBufferSize;
+
+	return pPayload;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSendQueueAllocPayload()
+// @Purpose: CRosaSendQueue乲(Ϣֱӹڷͻ, ʡȥһθ; СȡԻ)
+// @Since: v1.00a
+// @Para: UINT uiCapacity()
+// @Return: LPS_SHAREDPAYLOAD pPayload (üΪ1, uiSizeΪ(СΪС), дΪʵʳ; NULL:ڴ治)
+//------------------------------------------------------------------
+LPS_SHAREDPAYLOAD ROSASENDQUEUE_CALLMODE CRosaSendQueue::CRosaSendQueueAllocPayload(UINT uiCapacity)
+{
+	LPS_SHAREDPAYLOAD pPayload = NULL;
+
+	if (uiCapacity <= ROSA_SENDQUEUE_POOL_BLOCK)
+	{
+		pPayload = (LPS_SHAREDPAYLOAD)InterlockedPopEntrySList(&s_PayloadPool);
+		if (pPayload != NULL)
+		{
+			InterlockedDecrement(&s_lPayloadPoolCount);
+		}
+
+		uiCapacity = ROSA_SENDQUEUE_POOL_BLOCK;
+	}
+
+	if (pPayload == NULL)
+	{
+		pPayload = (LPS_SHAREDPAYLOAD)new (std::nothrow) char[FIELD_OFFSET(S_SHAREDPAYLOAD, chData) + uiCapacity];
+		if (pPayload == NULL)
+		{
+			return NULL;
+		}
+	}
+
+	pPayload->lRef = 1;
+	pPayload->uiSize = uiCapacity;
+	pPayload->uiCapacity = uiCapacity;
+
+	return pPayload;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSendQueueAddRefPayload()
+// @Purpose: CRosaSendQueueӹ
+// @Since: v1.00a
+// @Para: LPS_SHAREDPAYLOAD pPayload()
+// @Return: None
+//------------------------------------------------------------------
+void ROSASENDQUEUE_CALLMODE CRosaSendQueue::CRosaSendQueueAddRefPayload(LPS_SHAREDPAYLOAD pPayload)
+{
+	InterlockedIncrement(&pPayload->lRef);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSendQueueReleasePayload()
+// @Purpose: CRosaSendQueueͷŹ(һͷڴ, δʱСŻػ)
+// @Since: v1.00a
+// @Para: LPS_SHAREDPAYLOAD pPayload()
+// @Return: None
+//------------------------------------------------------------------
+void ROSASENDQUEUE_CALLMODE CRosaSendQueue::CRosaSendQueueReleasePayload(LPS_SHAREDPAYLOAD pPayload)
+{
+	if (InterlockedDecrement(&pPayload->lRef) != 0)
+	{
+		return;
+	}
+
+	if (pPayload->uiCapacity == ROSA_SENDQUEUE_POOL_BLOCK && InterlockedIncrement(&s_lPayloadPoolCount) <= ROSA_SENDQUEUE_POOL_MAX)
+	{
+		InterlockedPushEntrySList(&s_PayloadPool, (PSLIST_ENTRY)pPayload);
+		return;
+	}
+
+	if (pPayload->uiCapacity == ROSA_SENDQUEUE_POOL_BLOCK)
+	{
+		InterlockedDecrement(&s_lPayloadPoolCount);
+	}
+
+	delete[] (char*)pPayload;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSendQueueGetQueuedBytes()
+// @Purpose: CRosaSendQueueȡδɵֽ(δȡд)
+// @Since: v1.00a
+// @Para: None
+// @Return: UINT uiBytes
+//------------------------------------------------------------------
+UINT ROSASENDQUEUE_CALLMODE CRosaSendQueue::CRosaSendQueueGetQueuedBytes()
+{
+	// ȡ, д߿Ծݴ
+	return (UINT)m_lQueuedBytes;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSendQueueGetPeakBytes()
+// @Purpose: CRosaSendQueueȡδֽķֵ
+// @Since: v1.00a
+// @Para: None
+// @Return: UINT uiBytes
+//------------------------------------------------------------------
+UINT ROSASENDQUEUE_CALLMODE CRosaSendQueue::CRosaSendQueueGetPeakBytes()
+{
+	CThreadSafe ThreadSafe(&m_csQueue);
+
+	return m_uiPeakBytes;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSendQueueIsAboveHigh()
+// @Purpose: CRosaSendQueueǷڸˮλ
+// @Since: v1.00a
+// @Para: None
+// @Return: bool bRet (true:ˮλ, false:Լд)
+//------------------------------------------------------------------
+bool ROSASENDQUEUE_CALLMODE CRosaSendQueue::CRosaSendQueueIsAboveHigh()
+{
+	// ȡ, 㲥ʱжϲöٽ
+	return m_bAboveHigh;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSendQueueGetSocket()
+// @Purpose: CRosaSendQueueȡ׽
+// @Since: v1.00a
+// @Para: None
+// @Return: SOCKET s
+//------------------------------------------------------------------
+SOCKET ROSASENDQUEUE_CALLMODE CRosaSendQueue::CRosaSendQueueGetSocket() const
+{
+	return m_Socket;
+}
+
+//------------------------------------------------------------------
+// @Function:	 AllocNode()
+// @Purpose: CRosaSendQueueϢڵ㲢(ɺcharͷ)
+// @Since: v1.00a
+// @Para: const char* pSendBuffer()
+// @Para: UINT uiBufferSize(ͳ)
+// @Return: LPS_SENDNODE pNode (NULL:ڴ治)
+//------------------------------------------------------------------
+LPS_SENDNODE CRosaSendQueue::AllocNode(const char * pSendBuffer, UINT uiBufferSize)
+{
+	LPS_SENDNODE pNode = (LPS_SENDNODE)new (std::nothrow) char[FIELD_OFFSET(S_SENDNODE, chData) + uiBufferSize];
+	if (pNode == NULL)
+	{
+		return NULL;
+	}
+
+	pNode->pShared = NULL;
+	pNode->uiSize = uiBufferSize;
+	memcpy(pNode->chData, pSendBuffer, uiBufferSize);
+
+	return pNode;
+}
+
+//------------------------------------------------------------------
+// @Function:	 AllocSharedNode()
+// @Purpose: CRosaSendQueueùݵϢڵ(һ)
+// @Since: v1.00a
+// @Para: LPS_SHAREDPAYLOAD pPayload()
+// @Return: LPS_SENDNODE pNode (NULL:ڴ治)
+//------------------------------------------------------------------
+LPS_SENDNODE CRosaSendQueue::AllocSharedNode(LPS_SHAREDPAYLOAD pPayload)
+{
+	LPS_SENDNODE pNode = (LPS_SENDNODE)new (std::nothrow) char[FIELD_OFFSET(S_SENDNODE, chData)];
+	if (pNode == NULL)
+	{
+		return NULL;
+	}
+
+	CRosaSendQueueAddRefPayload(pPayload);
+
+	pNode->pShared = pPayload;
+	pNode->uiSize = pPayload->uiSize;
+
+	return pNode;
+}
+
+//------------------------------------------------------------------
+// @Function:	 FreeNode()
+// @Purpose: CRosaSendQueueͷϢڵ()
+// @Since: v1.00a
+// @Para: LPS_SENDNODE pNode(Ϣڵ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaSendQueue::FreeNode(LPS_SENDNODE pNode)
+{
+	if (pNode->pShared != NULL)
+	{
+		CRosaSendQueueReleasePayload(pNode->pShared);
+	}
+
+	delete[] (char*)pNode;
+}
+
+//------------------------------------------------------------------
+// @Function:	 SendNode()
+// @Purpose: CRosaSendQueueϢڵ뷢Ͷ(߳m_csQueue, ʧʱͷŽڵ)
+// @Since: v1.00a
+// @Para: LPS_SENDNODE pNode(Ϣڵ)
+// @Return: int nRet (SOB_RET_OK:, SOB_RET_FAIL:ڴ޻δ, SOB_RET_CLOSE:ѶϿ)
+//------------------------------------------------------------------
+int CRosaSendQueue::SendNode(LPS_SENDNODE pNode)
+{
+	if (m_Socket == INVALID_SOCKET || m_bClosing)
+	{
+		FreeNode(pNode);
+		return SOB_RET_FAIL;
+	}
+
+	if (m_bBroken)
+	{
+		FreeNode(pNode);
+		return SOB_RET_CLOSE;
+	}
+
+	// ڴ޵Ϣܾ, ض
+	if ((ULONG)(InterlockedExchangeAdd(&m_lQueuedBytes, (LONG)pNode->uiSize) + (LONG)pNode->uiSize) > m_uiMaxBytes)
+	{
+		InterlockedExchangeAdd(&m_lQueuedBytes, -(LONG)pNode->uiSize);
+		FreeNode(pNode);
+		return SOB_RET_FAIL;
+	}
+
+	// ȡ֮߳ǰдϢ, д˳
+	DrainPosted();
+
+	m_dqQueue.push_back(pNode);
+	m_uiPeakBytes = max(m_uiPeakBytes, (UINT)m_lQueuedBytes);
+
+	CheckHighWater();
+
+	if (!m_bSending && !m_bThrottled)
+	{
+		StartSend();
+	}
+
+	return m_bBroken ? SOB_RET_CLOSE : SOB_RET_OK;
+}
+
+//------------------------------------------------------------------
+// @Function:	 PostNode()
+// @Purpose: CRosaSendQueueϢڵ(߳, ʧʱͷŽڵ)
+// @Since: v1.00a
+// @Para: LPS_SENDNODE pNode(Ϣڵ)
+// @Return: int nRet (SOB_RET_OK:, SOB_RET_FAIL:ڴ޻δ, SOB_RET_CLOSE:ѶϿ)
+//------------------------------------------------------------------
+int CRosaSendQueue::PostNode(LPS_SENDNODE pNode)
+{
+	if (m_Socket == INVALID_SOCKET || m_bClosing)
+	{
+		FreeNode(pNode);
+		return SOB_RET_FAIL;
+	}
+
+	if (m_bBroken)
+	{
+		FreeNode(pNode);
+		return SOB_RET_CLOSE;
+	}
+
+	// ڴ޵Ϣܾ, ض
+	if ((ULONG)(InterlockedExchangeAdd(&m_lQueuedBytes, (LONG)pNode->uiSize) + (LONG)pNode->uiSize) > m_uiMaxBytes)
+	{
+		InterlockedExchangeAdd(&m_lQueuedBytes, -(LONG)pNode->uiSize);
+		FreeNode(pNode);
+		return SOB_RET_FAIL;
+	}
+
+	m_Posted.CRosaMPSCQueuePush(&pNode->Node);
+
+	// ֻеһͶȡɰ, ȡʼǰ־
+	if (InterlockedExchange(&m_lDrainPosted, 1) == 0)
+	{
+		InterlockedIncrement(&m_lOutstanding);
+
+		memset(&m_DrainOverlapped.Overlapped, 0, sizeof(m_DrainOverlapped.Overlapped));
+
+		if (!m_pLoop->CRosaEventLoopPost(&m_DrainOverlapped))
+		{
+			// ¼ѭѾֹͣ: ڵҼڴ, ޷, ԰ӷ(߲ͷŻط)
+			// ֮CRosaSendQueueSendٽȡ, CRosaSendQueueDestroyͷ
+			InterlockedExchange(&m_lDrainPosted, 0);
+			InterlockedDecrement(&m_lOutstanding);
+		}
+	}
+
+	return SOB_RET_OK;
+}
+
+//------------------------------------------------------------------
+// @Function:	 DrainPosted()
+// @Purpose: CRosaSendQueueеϢ뷢Ͷ(߳m_csQueue, Ψһ)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaSendQueue::DrainPosted()
+{
+	while (!m_Posted.CRosaMPSCQueueIsEmpty())
+	{
+		LPS_SENDNODE pNode = (LPS_SENDNODE)m_Posted.CRosaMPSCQueuePop();
+
+		// ߽֮δ, ֻһָ
+		if (pNode == NULL)
+		{
+			YieldProcessor();
+			continue;
+		}
+
+		if (m_bBroken)
+		{
+			InterlockedExchangeAdd(&m_lQueuedBytes, -(LONG)pNode->uiSize);
+			FreeNode(pNode);
+			continue;
+		}
+
+		m_dqQueue.push_back(pNode);
+	}
+
+	m_uiPeakBytes = max(m_uiPeakBytes, (UINT)m_lQueuedBytes);
+
+	CheckHighWater();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CheckHighWater()
+// @Purpose: CRosaSendQueueǷﵽˮλ(߳m_csQueue)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaSendQueue::CheckHighWater()
+{
+	// ٽڻص, ˮλصȺ˳
+	if (!m_bAboveHigh && !m_bBroken && (UINT)m_lQueuedBytes >= m_uiHighBytes)
+	{
+		m_bAboveHigh = true;
+
+		if (m_pWatermarkCallback)
+		{
+			m_pWatermarkCallback(m_Socket, true, m_dwUser);
+		}
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 StartSend()
+// @Purpose: CRosaSendQueueϢϲΪһWSASend(߳m_csQueue)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaSendQueue::StartSend()
+{
+	if (m_dqQueue.empty())
+	{
+		return;
+	}
+
+	WSABUF wsaBuf[ROSA_SENDQUEUE_MAX_WSABUF];
+	DWORD dwCount = 0;
+
+	for (deque<LPS_SENDNODE>::iterator iter = m_dqQueue.begin(); iter != m_dqQueue.end() && dwCount < ROSA_SENDQUEUE_MAX_WSABUF; ++iter)
+	{
+		wsaBuf[dwCount].buf = ((*iter)->pShared != NULL) ? (*iter)->pShared->chData : (*iter)->chData;
+		wsaBuf[dwCount].len = (*iter)->uiSize;
+		dwCount++;
+	}
+
+	// ʱֻͷе, һҲʱͣص
+	if (m_pLimiter != NULL)
+	{
+		UINT uiSizes[ROSA_SENDQUEUE_MAX_WSABUF];
+		for (DWORD i = 0; i < dwCount; ++i)
+		{
+			uiSizes[i] = wsaBuf[i].len;
+		}
+
+		dwCount = m_pLimiter->CRosaRateLimiterAcquire(m_uiRateFlow, uiSizes, dwCount, dwCount == m_dqQueue.size());
+		if (dwCount == 0)
+		{
+			m_bThrottled = true;
+			return;
+		}
+	}
+
+	memset(&m_SendOverlapped.Overlapped, 0, sizeof(m_SendOverlapped.Overlapped));
+	m_uiInFlight = dwCount;
+	m_bSending = true;
+	InterlockedIncrement(&m_lOutstanding);
+
+	// ʱͶɰ, ͳһOnSendCompleteг
+	if (WSASend(m_Socket, wsaBuf, dwCount, NULL, 0, &m_SendOverlapped.Overlapped, NULL) == SOCKET_ERROR && WSAGetLastError() != WSA_IO_PENDING)
+	{
+		int nResult = TranslateSendError(WSAGetLastError());
+
+		m_uiInFlight = 0;
+		m_bSending = false;
+		InterlockedDecrement(&m_lOutstanding);
+
+		Broken(nResult);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 Broken()
+// @Purpose: CRosaSendQueueնвصʧ(߳m_csQueue)
+// @Since: v1.00a
+// @Para: int nResult(SOB_RET_FAIL/SOB_RET_CLOSE)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaSendQueue::Broken(int nResult)
+{
+	m_bBroken = true;
+
+	LONG lFreed = 0;
+
+	for (deque<LPS_SENDNODE>::iterator iter = m_dqQueue.begin(); iter != m_dqQueue.end(); ++iter)
+	{
+		lFreed += (LONG)(*iter)->uiSize;
+		FreeNode(*iter);
+	}
+
+	m_dqQueue.clear();
+	InterlockedExchangeAdd(&m_lQueuedBytes, -lFreed);
+	m_uiInFlight = 0;
+
+	if (m_pCloseCallback && !m_bClosing)
+	{
+		m_pCloseCallback(m_Socket, nResult, m_dwUser);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnSendComplete()
+// @Purpose: CRosaSendQueue(¼ѭ߳, ͬһʱֻһ)
+// @Since: v1.00a
+// @Para: LPS_ROSAOVERLAPPED pOverlapped(m_SendOverlapped)
+// @Para: DWORD dwBytes(ֽ)
+// @Para: DWORD dwError()
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaSendQueue::OnSendComplete(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError)
+{
+	CRosaSendQueue* pThis = (CRosaSendQueue*)pOverlapped->pUser;
+
+	{
+		CThreadSafe ThreadSafe(&pThis->m_csQueue);
+
+		pThis->m_bSending = false;
+
+		if (pThis->m_bClosing)
+		{
+			pThis->m_uiInFlight = 0;
+		}
+		else if (dwError != 0)
+		{
+			pThis->Broken(TranslateSendError(dwError));
+		}
+		else
+		{
+			DWORD dwExpect = 0;
+
+			for (UINT i = 0; i < pThis->m_uiInFlight; ++i)
+			{
+				dwExpect += pThis->m_dqQueue.front()->uiSize;
+				FreeNode(pThis->m_dqQueue.front());
+				pThis->m_dqQueue.pop_front();
+			}
+
+			InterlockedExchangeAdd(&pThis->m_lQueuedBytes, -(LONG)dwExpect);
+			pThis->m_uiInFlight = 0;
+
+			// صֻڳʱ
+			if (dwBytes != dwExpect)
+			{
+				pThis->Broken(SOB_RET_FAIL);
+			}
+			else
+			{
+				if (pThis->m_bAboveHigh && (UINT)pThis->m_lQueuedBytes <= pThis->m_uiLowBytes)
+				{
+					pThis->m_bAboveHigh = false;
+
+					if (pThis->m_pWatermarkCallback)
+					{
+						pThis->m_pWatermarkCallback(pThis->m_Socket, false, pThis->m_dwUser);
+					}
+				}
+
+				if (!pThis->m_bSending && !pThis->m_bThrottled)
+				{
+					pThis->StartSend();
+				}
+			}
+		}
+	}
+
+	// 뿪ٽ֮ż, CRosaSendQueueDestroyغٷʶ
+	InterlockedDecrement(&pThis->m_lOutstanding);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnDrainPosted()
+// @Purpose: CRosaSendQueueȡдϢʼ(¼ѭ߳)
+// @Since: v1.00a
+// @Para: LPS_ROSAOVERLAPPED pOverlapped(m_DrainOverlapped)
+// @Para: DWORD dwBytes(δʹ)
+// @Para: DWORD dwError(δʹ)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaSendQueue::OnDrainPosted(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError)
+{
+	CRosaSendQueue* pThis = (CRosaSendQueue*)pOverlapped->pUser;
+
+	{
+		CThreadSafe ThreadSafe(&pThis->m_csQueue);
+
+		// ־, ֮ӵͶ
+		InterlockedExchange(&pThis->m_lDrainPosted, 0);
+
+		if (!pThis->m_bClosing)
+		{
+			pThis->DrainPosted();
+
+			if (!pThis->m_bBroken && !pThis->m_bSending && !pThis->m_bThrottled)
+			{
+				pThis->StartSend();
+			}
+		}
+	}
+
+	// 뿪ٽ֮ż, CRosaSendQueueDestroyغٷʶ
+	InterlockedDecrement(&pThis->m_lOutstanding);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnRateResume()
+// @Purpose: CRosaSendQueueָ(ٽ, Խm_csQueue, ֻͶɰ)
+// @Since: v1.00a
+// @Para: DWORD_PTR dwUser(Ͷ)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaSendQueue::OnRateResume(DWORD_PTR dwUser)
+{
+	CRosaSendQueue* pThis = (CRosaSendQueue*)dwUser;
+
+	if (InterlockedExchange(&pThis->m_lResumePosted, 1) == 0)
+	{
+		InterlockedIncrement(&pThis->m_lOutstanding);
+
+		memset(&pThis->m_ResumeOverlapped.Overlapped, 0, sizeof(pThis->m_ResumeOverlapped.Overlapped));
+
+		if (!pThis->m_pLoop->CRosaEventLoopPost(&pThis->m_ResumeOverlapped))
+		{
+			InterlockedExchange(&pThis->m_lResumePosted, 0);
+			InterlockedDecrement(&pThis->m_lOutstanding);
+		}
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnRateResumed()
+// @Purpose: CRosaSendQueueָ(¼ѭ߳)
+// @Since: v1.00a
+// @Para: LPS_ROSAOVERLAPPED pOverlapped(m_ResumeOverlapped)
+// @Para: DWORD dwBytes(δʹ)
+// @Para: DWORD dwError(δʹ)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaSendQueue::OnRateResumed(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError)
+{
+	CRosaSendQueue* pThis = (CRosaSendQueue*)pOverlapped->pUser;
+
+	{
+		CThreadSafe ThreadSafe(&pThis->m_csQueue);
+
+		InterlockedExchange(&pThis->m_lResumePosted, 0);
+		pThis->m_bThrottled = false;
+
+		if (!pThis->m_bClosing && !pThis->m_bBroken && !pThis->m_bSending)
+		{
+			pThis->StartSend();
+		}
+	}
+
+	// 뿪ٽ֮ż, CRosaSendQueueDestroyغٷʶ
+	InterlockedDecrement(&pThis->m_lOutstanding);
+}
@@ -0,0 +1,146 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaSendQueue.h
+* @brief	This File is RosaSendQueue Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSASENDQUEUE_H__
+#define __CROSASENDQUEUE_H__
+
+//Include Rosa Header File
+#include "CRosaSocket.h"
+#include "CRosaEventLoop.h"
+#include "CRosaMPSCQueue.h"
+#include "CRosaRateLimiter.h"
+
+//Include C/C++ Header File
+#include <deque>
+
+using namespace std;
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSASENDQUEUE_API	__declspec(dllexport)
+#else
+#define ROSASENDQUEUE_API	__declspec(dllimport)
+#endif
+
+#define ROSASENDQUEUE_CALLMODE	__stdcall
+
+#define ROSA_SENDQUEUE_HIGH_BYTES		(1024 * 1024)		//ˮλ(ֽ, ﵽصͣ)
+#define ROSA_SENDQUEUE_LOW_BYTES		(256 * 1024)		//ˮλ(ֽ, ˮλ֮󽵵ֵص߻ָ)
+#define ROSA_SENDQUEUE_MAX_BYTES		(8 * 1024 * 1024)	//ڴ(ֽ, ʱܾд)
+#define ROSA_SENDQUEUE_MAX_WSABUF		32					//WSASendύϢ
+#define ROSA_SENDQUEUE_POOL_BLOCK		4096				//Ĺ(óȵʹͬһ)
+#define ROSA_SENDQUEUE_POOL_MAX			1024				//໺Ĺݿ
+
+//Struct Definition
+typedef struct
+{
+	volatile LONG lRef;						// ü
+	UINT uiSize;							// ݳ
+	UINT uiCapacity;						// 
+	char chData[1];							// (д뷢Ͷ֮󲻿޸)
+}S_SHAREDPAYLOAD, *LPS_SHAREDPAYLOAD;
+
+typedef struct
+{
+	S_MPSCNODE Node;						// нڵ(λλ)
+	LPS_SHAREDPAYLOAD pShared;				// (NULLʱλchData)
+	UINT uiSize;							// Ϣ
+	char chData[1];							// Ϣ(ȷ)
+}S_SENDNODE, *LPS_SENDNODE;
+
+//Callback Definition
+typedef void(__stdcall *HANDLE_SENDQUEUE_WATERMARK_CALLBACK)(SOCKET s, bool bHigh, DWORD_PTR dwUser);	//ˮλص(bHighΪtrueʱﵽˮλ, falseʱ䵽ˮλ)
+typedef void(__stdcall *HANDLE_SENDQUEUE_CLOSE_CALLBACK)(SOCKET s, int nResult, DWORD_PTR dwUser);	//巢ʧܻص(, Ӧùر)
+
+//Class Definition
+class ROSASENDQUEUE_API CRosaSendQueue
+{
+public:
+	CRosaSendQueue();			// CRosaSendQueue 캯
+	~CRosaSendQueue();			// CRosaSendQueue 
+
+public:
+	bool ROSASENDQUEUE_CALLMODE CRosaSendQueueCreate(SOCKET s, CRosaEventLoop* pLoop, HANDLE_SENDQUEUE_WATERMARK_CALLBACK pWatermarkCallback, HANDLE_SENDQUEUE_CLOSE_CALLBACK pCloseCallback, DWORD_PTR dwUser, UINT uiHighBytes = ROSA_SENDQUEUE_HIGH_BYTES, UINT uiLowBytes = ROSA_SENDQUEUE_LOW_BYTES, UINT uiMaxBytes = ROSA_SENDQUEUE_MAX_BYTES, bool bAttach = true);	// CRosaSendQueue ׽ּ¼ѭ
+	void ROSASENDQUEUE_CALLMODE CRosaSendQueueDestroy();								// CRosaSendQueue ȡͲ(ر׽)
+
+	int ROSASENDQUEUE_CALLMODE CRosaSendQueueSend(const char* pSendBuffer, UINT uiBufferSize);	// CRosaSendQueue дϢ(, ڴʱSOB_RET_FAIL)
+	int ROSASENDQUEUE_CALLMODE CRosaSendQueuePost(const char* pSendBuffer, UINT uiBufferSize);	// CRosaSendQueue дϢ(߳, ¼ѭ߳ȡ)
+	int ROSASENDQUEUE_CALLMODE CRosaSendQueueSendShared(LPS_SHAREDPAYLOAD pPayload);			// CRosaSendQueue д빲(, ɺͷ)
+	int ROSASENDQUEUE_CALLMODE CRosaSendQueuePostShared(LPS_SHAREDPAYLOAD pPayload);			// CRosaSendQueue д빲(߳)
+
+	bool ROSASENDQUEUE_CALLMODE CRosaSendQueueSetRateLimit(CRosaRateLimiter* pLimiter, UINT uiGroup, const S_RATELIMIT& sLimit, UINT uiWeight = 1);	// CRosaSendQueue ÷(pLimiterΪNULLʱ)
+	bool ROSASENDQUEUE_CALLMODE CRosaSendQueueIsThrottled();							// CRosaSendQueue Ƿͣ
+
+	static LPS_SHAREDPAYLOAD ROSASENDQUEUE_CALLMODE CRosaSendQueueCreatePayload(const char* pBuffer, UINT uiBufferSize);	// CRosaSendQueue (üΪ1)
+	static LPS_SHAREDPAYLOAD ROSASENDQUEUE_CALLMODE CRosaSendQueueAllocPayload(UINT uiCapacity);	// CRosaSendQueue 乲(ʼ, ֱдchDatauiSizeΪʵʳ)
+	static void ROSASENDQUEUE_CALLMODE CRosaSendQueueAddRefPayload(LPS_SHAREDPAYLOAD pPayload);	// CRosaSendQueue ӹ
+	static void ROSASENDQUEUE_CALLMODE CRosaSendQueueReleasePayload(LPS_SHAREDPAYLOAD pPayload);	// CRosaSendQueue ͷŹ(Ϊ0ʱͷڴ)
+
+	UINT ROSASENDQUEUE_CALLMODE CRosaSendQueueGetQueuedBytes();							// CRosaSendQueue ȡδɵֽ
+	UINT ROSASENDQUEUE_CALLMODE CRosaSendQueueGetPeakBytes();							// CRosaSendQueue ȡδֽķֵ
+	bool ROSASENDQUEUE_CALLMODE CRosaSendQueueIsAboveHigh();							// CRosaSendQueue Ƿڸˮλ(δ䵽ˮλ)
+	SOCKET ROSASENDQUEUE_CALLMODE CRosaSendQueueGetSocket() const;						// CRosaSendQueue ȡ׽
+
+private:
+	static LPS_SENDNODE AllocNode(const char* pSendBuffer, UINT uiBufferSize);		// CRosaSendQueue Ϣڵ㲢
+	static LPS_SENDNODE AllocSharedNode(LPS_SHAREDPAYLOAD pPayload);					// CRosaSendQueue ùݵϢڵ
+	static void FreeNode(LPS_SENDNODE pNode);											// CRosaSendQueue ͷϢڵ()
+	int SendNode(LPS_SENDNODE pNode);													// CRosaSendQueue Ϣڵ뷢Ͷ(߳m_csQueue)
+	int PostNode(LPS_SENDNODE pNode);													// CRosaSendQueue Ϣڵ
+	void DrainPosted();																	// CRosaSendQueue еϢ뷢Ͷ(߳m_csQueue)
+	void CheckHighWater();																// CRosaSendQueue Ƿﵽˮλ(߳m_csQueue)
+	void StartSend();																	// CRosaSendQueue ϢϲΪһWSASend(߳m_csQueue)
+	void Broken(int nResult);															// CRosaSendQueue նвصʧ(߳m_csQueue)
+
+	static void __stdcall OnSendComplete(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError);	// CRosaSendQueue (¼ѭ߳)
+	static void __stdcall OnDrainPosted(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError);	// CRosaSendQueue ȡдϢ(¼ѭ߳)
+	static void __stdcall OnRateResume(DWORD_PTR dwUser);												// CRosaSendQueue ָ(Ͷɰ)
+	static void __stdcall OnRateResumed(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError);	// CRosaSendQueue ָ(¼ѭ߳)
+
+private:
+	SOCKET m_Socket;										// CRosaSendQueue ׽
+	CRosaEventLoop* m_pLoop;								// CRosaSendQueue ¼ѭ
+
+	HANDLE_SENDQUEUE_WATERMARK_CALLBACK m_pWatermarkCallback;	// CRosaSendQueue ˮλص
+	HANDLE_SENDQUEUE_CLOSE_CALLBACK m_pCloseCallback;		// CRosaSendQueue ʧܻص
+	DWORD_PTR m_dwUser;										// CRosaSendQueue û
+
+	UINT m_uiHighBytes;										// CRosaSendQueue ˮλ
+	UINT m_uiLowBytes;										// CRosaSendQueue ˮλ
+	UINT m_uiMaxBytes;										// CRosaSendQueue ڴ
+
+	CRITICAL_SECTION m_csQueue;								// CRosaSendQueue ٽ
+	deque<LPS_SENDNODE> m_dqQueue;							// CRosaSendQueue Ϣ(m_uiInFlightڷ)
+	volatile LONG m_lQueuedBytes;							// CRosaSendQueue δɵֽ(ڷͼ)
+	UINT m_uiPeakBytes;										// CRosaSendQueue δֵֽ
+	UINT m_uiInFlight;										// CRosaSendQueue ڷ͵Ϣ
+	bool m_bSending;										// CRosaSendQueue ǷWSASendδ
+	bool m_bAboveHigh;										// CRosaSendQueue Ƿڸˮλ
+	bool m_bBroken;											// CRosaSendQueue ʧ(֮д뷵SOB_RET_CLOSE)
+	bool m_bClosing;										// CRosaSendQueue (ٻص)
+	volatile LONG m_lOutstanding;							// CRosaSendQueue δķ(ɻصִ)
+	S_ROSAOVERLAPPED m_SendOverlapped;						// CRosaSendQueue صṹ
+
+	CRosaMPSCQueue m_Posted;								// CRosaSendQueue дϢ(߳m_csQueue)
+	volatile LONG m_lDrainPosted;							// CRosaSendQueue ǷͶȡɰ
+	S_ROSAOVERLAPPED m_DrainOverlapped;						// CRosaSendQueue ȡɰ
+
+	CRosaRateLimiter* m_pLimiter;							// CRosaSendQueue 
+	UINT m_uiRateFlow;										// CRosaSendQueue е
+	bool m_bThrottled;										// CRosaSendQueue Ƿͣ
+	volatile LONG m_lResumePosted;							// CRosaSendQueue ǷͶݻָɰ
+	S_ROSAOVERLAPPED m_ResumeOverlapped;					// CRosaSendQueue ָɰ
+
+};
+
+#endif // !__CROSASENDQUEUE_H__
@@ -10,6 +10,7 @@
 * @date		2018-09-17	v1.00a	alopex	Create This File.
 */
 #include "CRosaSerial.h"
+#include "CRosaTrace.h"
 #include "CThreadSafe.h"
 
 //CRosaSerial ͨ(첽ͨ)
@@ -32,6 +33,13 @@ CRosaSerial::CRosaSerial()
 	memset(&m_ovRead, 0, sizeof(m_ovRead));
 	memset(&m_ovWait, 0, sizeof(m_ovWait));
 
+	m_pWriteHistogram = NULL;
+
+	m_pCompress = NULL;
+	m_bPeerHello = false;
+	m_bPeerCompress = false;
+	m_bHelloPending = false;
+
 	m_dwSendCount = 0;
 	m_dwRecvCount = 0;
 	memset(m_chSendBuf, 0, sizeof(m_chSendBuf));
@@ -84,6 +92,8 @@ CRosaSerial::~CRosaSerial()
 		m_hListenThread = INVALID_HANDLE_VALUE;
 	}
 
+	SafeDelete(m_pCompress);
+
 	DeleteCriticalSection(&m_csCOMSync);
 }
 
@@ -126,6 +136,85 @@ void ROSASERIAL_CALLMODE CRosaSerial::CRosaSerialSetRecv(bool bRecv)
 	m_bRecv = bRecv;
 }
 
+//------------------------------------------------------------------
+// @Function:	 CRosaSerialSetHistogram()
+// @Purpose: CRosaSerialдӳͳ(ͳƶɵ߹)
+// @Since: v1.00a
+// @Para: CRosaHistogram* pHistogram(дӳͳ, NULLʾȡ)
+// @Return: None
+//------------------------------------------------------------------
+void ROSASERIAL_CALLMODE CRosaSerial::CRosaSerialSetHistogram(CRosaHistogram * pHistogram)
+{
+	m_pWriteHistogram = pHistogram;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSerialSetCompress()
+// @Purpose: CRosaSerial֡ѹ(ڿܶʧ, ֻʹÿ֡Ŀģʽ; ֵͬʱѹ, ֻ֡)
+// @Since: v1.00a
+// @Para: bool bEnable(true:, false:ָԭʼֽ)
+// @Para: const char* pDict(Ԥֵ, ͱĵƴ)
+// @Para: UINT uiDictSize(ֵ䳤)
+// @Return: bool bRet (true:ɹ, false:Ѵ)
+//------------------------------------------------------------------
+bool ROSASERIAL_CALLMODE CRosaSerial::CRosaSerialSetCompress(bool bEnable, const char * pDict, UINT uiDictSize)
+{
+	if (m_bOpen)
+	{
+		return false;
+	}
+
+	SafeDelete(m_pCompress);
+	m_vecFrame.clear();
+
+	if (!bEnable)
+	{
+		return true;
+	}
+
+	m_pCompress = new CRosaCompress;
+	if (!m_pCompress->CRosaCompressCreate(ROSA_COMPRESS_MODE_BLOCK, pDict, uiDictSize))
+	{
+		SafeDelete(m_pCompress);
+		return false;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSerialIsCompressed()
+// @Purpose: CRosaSerialдǷѹ
+// @Since: v1.00a
+// @Para: None
+// @Return: bool bRet (true:Զֵͬ, false:ֻ֡δ)
+//------------------------------------------------------------------
+bool ROSASERIAL_CALLMODE CRosaSerial::CRosaSerialIsCompressed() const
+{
+	return m_pCompress != NULL && m_bPeerCompress;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSerialGetCompressStats()
+// @Purpose: CRosaSerialȡѹͳ(д߳, ڽ߳)
+// @Since: v1.00a
+// @Para: S_COMPRESSSTATS& sStats(ͳ)
+// @Para: bool bReset(Ƿ)
+// @Return: bool bRet (true:ɹ, false:δ)
+//------------------------------------------------------------------
+bool ROSASERIAL_CALLMODE CRosaSerial::CRosaSerialGetCompressStats(S_COMPRESSSTATS & sStats, bool bReset)
+{
+	if (m_pCompress == NULL)
+	{
+		memset(&sStats, 0, sizeof(sStats));
+		return false;
+	}
+
+	m_pCompress->CRosaCompressGetStats(sStats, bReset);
+
+	return true;
+}
+
 //------------------------------------------------------------------
 // @Function:	 CRosaSerialSetSendBuf()
 // @Purpose: CRosaSerial÷ͻ
@@ -169,6 +258,12 @@ bool ROSASERIAL_CALLMODE CRosaSerial::CRosaSerialOpenPort(S_SERIALPORT_PROPERTY
 {
 	bool bRet = false;
 
+	// ÿδ
+	m_bPeerHello = false;
+	m_bPeerCompress = false;
+	m_bHelloPending = (m_pCompress != NULL);
+	m_vecFrame.clear();
+
 	// ʼ
 	bRet = CRosaSerialInit(sCommProperty);
 	if (!bRet)
@@ -223,14 +318,53 @@ bool ROSASERIAL_CALLMODE CRosaSerial::OnTranslateBuffer()
 	memcpy_s(chSendBuf, sizeof(chSendBuf), m_chSendBuf, sizeof(m_chSendBuf));
 	LeaveCriticalSection(&m_csCOMSync);
 
-	bStatus = WriteFile(m_hCOM, chSendBuf, m_dwSendCount, &dwBytes, &m_ovWrite);
+	// д뵽ɵĺʱ(δͳʱȡ)
+	LONGLONG llStart = 0;
+	if (m_pWriteHistogram != NULL || CRosaHistogram::CRosaHistogramIsGlobalEnabled())
+	{
+		llStart = CRosaHistogram::CRosaHistogramNow();
+	}
+
+	// ֡: Ҫʱȸ֡, Զֵͬѹ
+	const BYTE* pWrite = chSendBuf;
+	DWORD dwWrite = m_dwSendCount;
+	BYTE chFrame[SERIALPORT_COMM_FRAME_BUFFER_SIZE];
+
+	if (m_pCompress != NULL)
+	{
+		dwWrite = 0;
+
+		if (m_bHelloPending)
+		{
+			m_bHelloPending = false;
+
+			S_COMPRESSHEADER sHello;
+			CRosaCompress::CRosaCompressMakeHeader(sHello, ROSA_COMPRESS_FLAG_HELLO | (m_bPeerHello ? ROSA_COMPRESS_FLAG_ACK : 0), ROSA_COMPRESS_MODE_BLOCK, m_pCompress->CRosaCompressGetDictID());
+			memcpy(chFrame, &sHello, sizeof(sHello));
+			dwWrite = sizeof(sHello);
+		}
+
+		UINT uiFrameSize = 0;
+		UINT uiSize = (m_dwSendCount < sizeof(chSendBuf)) ? m_dwSendCount : sizeof(chSendBuf);
+		const char* pFrame = m_pCompress->CRosaCompressEncodeFrame((const char*)chSendBuf, uiSize, uiFrameSize, m_bPeerCompress);
+
+		memcpy(chFrame + dwWrite, pFrame, uiFrameSize);
+		dwWrite += uiFrameSize;
+		pWrite = chFrame;
+	}
+
+	bStatus = WriteFile(m_hCOM, pWrite, dwWrite, &dwBytes, &m_ovWrite);
 	if (FALSE == bStatus && GetLastError() == ERROR_IO_PENDING)
 	{
 		if (FALSE == ::GetOverlappedResult(m_hCOM, &m_ovWrite, &dwBytes, TRUE))
 		{
+			ROSA_TRACE(ROSA_TRACE_SERIAL_WRITE, m_hCOM, -1);
 			return false;
 		}
 	}
+	ROSA_TRACE(ROSA_TRACE_SERIAL_WRITE, m_hCOM, (LONG)dwBytes);
+
+	CRosaHistogram::CRosaHistogramRecordGlobal(ROSA_HISTOGRAM_OP_SERIALWRITE, llStart, m_pWriteHistogram);
 
 	return true;
 }
@@ -270,6 +404,7 @@ unsigned int CRosaSerial::OnReceiveBuffer(LPVOID lpParameters)
 		{
 			bStatus = ::GetOverlappedResult(pCSerialPortBase->m_hCOM, &pCSerialPortBase->m_ovWait, &dwBytes, TRUE);
 		}
+		ROSA_TRACE(ROSA_TRACE_SERIAL_WAIT, pCSerialPortBase->m_hCOM, bStatus ? (LONG)dwWaitEvent : -1);
 
 		ClearCommError(pCSerialPortBase->m_hCOM, &dwError, &cs);
 
@@ -280,8 +415,16 @@ unsigned int CRosaSerial::OnReceiveBuffer(LPVOID lpParameters)
 
 			memset(chReadBuf, 0, sizeof(chReadBuf));
 			bStatus = ReadFile(pCSerialPortBase->m_hCOM, chReadBuf, sizeof(chReadBuf), &dwBytes, &pCSerialPortBase->m_ovRead);
+			ROSA_TRACE(ROSA_TRACE_SERIAL_READ, pCSerialPortBase->m_hCOM, bStatus ? (LONG)dwBytes : -1);
 			PurgeComm(pCSerialPortBase->m_hCOM, PURGE_RXCLEAR | PURGE_RXABORT);
 
+			// ֡ʱ֡, һ֡Ϊջ
+			if (pCSerialPortBase->m_pCompress != NULL)
+			{
+				pCSerialPortBase->OnReceiveFrames(chReadBuf, dwBytes);
+				continue;
+			}
+
 			EnterCriticalSection(&pCSerialPortBase->m_csCOMSync);
 			pCSerialPortBase->m_dwRecvCount = dwBytes;
 			memset(pCSerialPortBase->m_chRecvBuf, 0, sizeof(pCSerialPortBase->m_chRecvBuf));
@@ -295,6 +438,78 @@ unsigned int CRosaSerial::OnReceiveBuffer(LPVOID lpParameters)
 	return 0;
 }
 
+//------------------------------------------------------------------
+// @Function:	 OnReceiveFrames()
+// @Purpose: CRosaSerial鲢յ֡(֡ͷЧʧʱһֽͬ)
+// @Since: v1.00a
+// @Para: const BYTE* pData(ζȡ)
+// @Para: DWORD dwBytes(ζȡĳ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaSerial::OnReceiveFrames(const BYTE * pData, DWORD dwBytes)
+{
+	BYTE chRaw[SERIALPORT_COMM_OUTPUT_BUFFER_SIZE] = { 0 };
+	size_t uiPos = 0;
+
+	m_vecFrame.insert(m_vecFrame.end(), pData, pData + dwBytes);
+
+	while (m_vecFrame.size() - uiPos >= sizeof(S_COMPRESSHEADER))
+	{
+		S_COMPRESSHEADER sHeader;
+		memcpy(&sHeader, &m_vecFrame[uiPos], sizeof(sHeader));
+
+		bool bHello = (sHeader.byFlags & ROSA_COMPRESS_FLAG_HELLO) != 0;
+
+		if (!CRosaCompress::CRosaCompressCheckHeader(sHeader) || (!bHello && (sHeader.dwRawSize > sizeof(chRaw) || sHeader.dwDataSize > SERIALPORT_COMM_FRAME_BUFFER_SIZE)))
+		{
+			++uiPos;
+			continue;
+		}
+
+		size_t uiFrame = sizeof(S_COMPRESSHEADER) + (bHello ? 0 : sHeader.dwDataSize);
+		if (m_vecFrame.size() - uiPos < uiFrame)
+		{
+			break;
+		}
+
+		if (bHello)
+		{
+			// Զ˽ʹԼֵ, ֵIDͬſѹ
+			bool bUseDict = false;
+			int nAgree = CRosaCompress::CRosaCompressAgree(ROSA_COMPRESS_MODE_BLOCK, m_pCompress->CRosaCompressGetDictID(), sHeader, bUseDict);
+
+			m_bPeerCompress = (nAgree != ROSA_COMPRESS_MODE_NONE && sHeader.dwDataSize == m_pCompress->CRosaCompressGetDictID());
+			m_bPeerHello = true;
+
+			// Զδյ(򿪻´)ʱٴη
+			if (!(sHeader.byFlags & ROSA_COMPRESS_FLAG_ACK))
+			{
+				m_bHelloPending = true;
+			}
+		}
+		else
+		{
+			int nRaw = m_pCompress->CRosaCompressDecodeFrame(sHeader, (const char*)&m_vecFrame[uiPos + sizeof(S_COMPRESSHEADER)], (char*)chRaw, sizeof(chRaw));
+			if (nRaw < 0)
+			{
+				++uiPos;
+				continue;
+			}
+
+			EnterCriticalSection(&m_csCOMSync);
+			m_dwRecvCount = (DWORD)nRaw;
+			memset(m_chRecvBuf, 0, sizeof(m_chRecvBuf));
+			memcpy_s(m_chRecvBuf, sizeof(m_chRecvBuf), chRaw, nRaw);
+			m_bRecv = true;
+			LeaveCriticalSection(&m_csCOMSync);
+		}
+
+		uiPos += uiFrame;
+	}
+
+	m_vecFrame.erase(m_vecFrame.begin(), m_vecFrame.begin() + uiPos);
+}
+
 //------------------------------------------------------------------
 // @Function:	 EnumSerialPort()
 // @Purpose: CRosaSerialöٴ
@@ -17,6 +17,10 @@
 //Include Window Header File
 #include <Windows.h>
 
+//Include Rosa Header File
+#include "CRosaHistogram.h"
+#include "CRosaCompress.h"
+
 //Include C/C++ Header File
 #include <stdio.h>
 #include <stdlib.h>
@@ -49,6 +53,7 @@ using namespace std;
 
 #define SERIALPORT_COMM_INPUT_BUFFER_SIZE	4096	// ͨ뻺С
 #define SERIALPORT_COMM_OUTPUT_BUFFER_SIZE	4096	// ͨС
+#define SERIALPORT_COMM_FRAME_BUFFER_SIZE	(SERIALPORT_COMM_INPUT_BUFFER_SIZE + 64)	// ڷ֡д뻺С(֡+һ֡󳤶)
 
 //Template Release
 template<class T>
@@ -103,6 +108,16 @@ private:
 	OVERLAPPED m_ovRead;	// CRosaSerial OverLapped Read
 	OVERLAPPED m_ovWait;	// CRosaSerial OverLapped Wait
 
+private:
+	CRosaHistogram* m_pWriteHistogram;	// CRosaSerial Write Latency Histogram(дӳͳ)
+
+private:
+	CRosaCompress* m_pCompress;			// CRosaSerial Frame Codec(֡ģʽѹ, NULLʾԭʼֽ)
+	volatile bool m_bPeerHello;			// CRosaSerial Peer Hello Received(յԶ)
+	volatile bool m_bPeerCompress;		// CRosaSerial Peer Compress(Զֵͬ, дʱѹ)
+	volatile bool m_bHelloPending;		// CRosaSerial Hello Pending(´дʱ֡)
+	vector<BYTE> m_vecFrame;			// CRosaSerial Frame Reassembly(֡, ֻڽ߳ʹ)
+
 public:
 	volatile bool m_bOpen;	// CRosaSerial Open Flag(ڴ򿪱־)
 	volatile bool m_bRecv;	// CRosaSerial Recv Flag(ڽձ־)
@@ -140,6 +155,11 @@ public:
 	bool ROSASERIAL_CALLMODE CRosaSerialGetStatus() const;			// CRosaSerial ȡ״̬
 	bool ROSASERIAL_CALLMODE CRosaSerialGetRecv() const;			// CRosaSerial ȡձ־
 	void ROSASERIAL_CALLMODE CRosaSerialSetRecv(bool bRecv);		// CRosaSerial ýձ־
+	void ROSASERIAL_CALLMODE CRosaSerialSetHistogram(CRosaHistogram* pHistogram);	// CRosaSerial дӳͳ(NULLʾȡ)
+
+	bool ROSASERIAL_CALLMODE CRosaSerialSetCompress(bool bEnable, const char* pDict = NULL, UINT uiDictSize = 0);	// CRosaSerial ֡ѹ(򿪴֮ǰ, ˶뿪)
+	bool ROSASERIAL_CALLMODE CRosaSerialIsCompressed() const;						// CRosaSerial дǷѹ(յֵͬĶԶֺ)
+	bool ROSASERIAL_CALLMODE CRosaSerialGetCompressStats(S_COMPRESSSTATS& sStats, bool bReset = false);	// CRosaSerial ȡѹͳ
 
 	void ROSASERIAL_CALLMODE CRosaSerialSetSendBuf(unsigned char* pBuff, int nSize, DWORD& dwSendCount);	// CRosaSerial ÷ͻ
 	void ROSASERIAL_CALLMODE CRosaSerialGetRecvBuf(unsigned char* pBuff, int nSize, DWORD& dwRecvCount);	// CRosaSerial ȡջ
@@ -150,6 +170,9 @@ public:
 	bool ROSASERIAL_CALLMODE OnTranslateBuffer();										// CRosaSerial ڷ
 	static unsigned int CALLBACK OnReceiveBuffer(LPVOID lpParameters);	// CRosaSerial ڽ߳
 
+private:
+	void OnReceiveFrames(const BYTE* pData, DWORD dwBytes);				// CRosaSerial 鲢յ֡(߳)
+
 };
 
 #endif // !__ROSASERIAL_H_
@@ -0,0 +1,1016 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaShmSocket.cpp
+* @brief	This File is RosaShmSocket Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaShmSocket.h"
+
+//Include C/C++ Header File
+#include <stdio.h>
+
+//CRosaShmSocket ڴ洫(ͬһĽ̼, ӿCRosaSocketͬ; ÿһߵ߻λ, ¼)
+
+// ͻ(IDһӶ)
+static volatile LONG s_lConnectSeq = 0;
+
+// ʼ(϶Զ˲ͬʱ, )
+static UINT InitialSpin()
+{
+	SYSTEM_INFO si;
+	GetSystemInfo(&si);
+
+	return (si.dwNumberOfProcessors > 1) ? ROSA_SHM_SPIN_INIT : 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaShmSocket()
+// @Purpose: CRosaShmSocket캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaShmSocket::CRosaShmSocket()
+{
+	m_sPort = 0;
+	m_uiRingSize = ROSA_SHM_RING_SIZE;
+
+	m_hListenMapping = NULL;
+	m_pListen = NULL;
+	m_hListenMutex = NULL;
+	m_hAcceptEvent = NULL;
+
+	m_hMapping = NULL;
+	m_pView = NULL;
+	m_pHeader = NULL;
+	memset(m_hEvent, 0, sizeof(m_hEvent));
+	m_hPeerProcess = NULL;
+	m_nSide = ROSA_SHM_SIDE_CLIENT;
+	m_bIsConnected = false;
+
+	m_uiSpin[0] = m_uiSpin[1] = InitialSpin();
+
+	m_nLastError = 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaShmSocket()
+// @Purpose: CRosaShmSocket
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaShmSocket::~CRosaShmSocket()
+{
+	CRosaShmSocketDestroy();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaShmSocketBindOnPort()
+// @Purpose: CRosaShmSocket󶨷˶˿(ڴ, ͬһ˿ֻһ)
+// @Since: v1.00a
+// @Para: USHORT sPort(˿ں)
+// @Return: bool bRet (true:ɹ, false:ʧܻ˿ѱռ)
+//------------------------------------------------------------------
+bool ROSASHMSOCKET_CALLMODE CRosaShmSocket::CRosaShmSocketBindOnPort(USHORT sPort)
+{
+	char chName[ROSA_SHM_NAME_LENGTH] = { 0 };
+
+	if (m_hListenMapping != NULL || m_bIsConnected)
+	{
+		return false;
+	}
+
+	MakeName(chName, "", sPort);
+	m_hListenMapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, sizeof(S_SHMLISTEN), chName);
+	m_nLastError = GetLastError();
+
+	if (m_hListenMapping == NULL || m_nLastError == ERROR_ALREADY_EXISTS)
+	{
+		CloseListener();
+		return false;
+	}
+
+	m_pListen = (LPS_SHMLISTEN)MapViewOfFile(m_hListenMapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(S_SHMLISTEN));
+
+	MakeName(chName, ".Lock", sPort);
+	m_hListenMutex = CreateMutexA(NULL, FALSE, chName);
+
+	MakeName(chName, ".Accept", sPort);
+	m_hAcceptEvent = CreateEventA(NULL, FALSE, FALSE, chName);
+
+	if (m_pListen == NULL || m_hListenMutex == NULL || m_hAcceptEvent == NULL)
+	{
+		m_nLastError = GetLastError();
+		CloseListener();
+		return false;
+	}
+
+	m_pListen->dwServerPID = GetCurrentProcessId();
+	m_pListen->lListening = 0;
+	m_pListen->lBacklog = SOB_DEFAULT_BACKLOG;
+	m_pListen->lCount = 0;
+	m_pListen->dwMagic = ROSA_SHM_MAGIC;
+
+	m_sPort = sPort;
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaShmSocketListen()
+// @Purpose: CRosaShmSocketʼ
+// @Since: v1.00a
+// @Para: int nBacklog(г, ROSA_SHM_BACKLOG_MAX)
+// @Return: bool bRet (true:ɹ, false:δ)
+//------------------------------------------------------------------
+bool ROSASHMSOCKET_CALLMODE CRosaShmSocket::CRosaShmSocketListen(int nBacklog)
+{
+	if (m_pListen == NULL)
+	{
+		return false;
+	}
+
+	nBacklog = (nBacklog < 1) ? 1 : ((nBacklog > ROSA_SHM_BACKLOG_MAX) ? ROSA_SHM_BACKLOG_MAX : nBacklog);
+
+	WaitForSingleObject(m_hListenMutex, INFINITE);
+	m_pListen->lBacklog = nBacklog;
+	ReleaseMutex(m_hListenMutex);
+
+	InterlockedExchange(&m_pListen->lListening, 1);
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaShmSocketAccept()
+// @Purpose: CRosaShmSocketտͻ(ÿһӶ󲢻ص)
+// @Since: v1.00a
+// @Para: HANDLE_SHM_ACCEPT_CALLBACK pCallback(ӻص, ڱִ߳)
+// @Para: DWORD dwUser(û)
+// @Para: BOOL* pExitFlag(˳־, NULLʱ˳)
+// @Para: USHORT nLoopTimeOutSec(˳־)
+// @Return: bool bRet (true:˳־λ, false:δȴʧ)
+//------------------------------------------------------------------
+bool ROSASHMSOCKET_CALLMODE CRosaShmSocket::CRosaShmSocketAccept(HANDLE_SHM_ACCEPT_CALLBACK pCallback, DWORD dwUser, BOOL * pExitFlag, USHORT nLoopTimeOutSec)
+{
+	DWORD dwRequest[ROSA_SHM_BACKLOG_MAX][2];
+
+	if (m_pListen == NULL || m_pListen->lListening == 0 || pCallback == NULL)
+	{
+		return false;
+	}
+
+	while (pExitFlag == NULL || !(*pExitFlag))
+	{
+		DWORD dwRet = WaitForSingleObject(m_hAcceptEvent, nLoopTimeOutSec * 1000);
+		if (dwRet == WAIT_TIMEOUT)
+		{
+			continue;
+		}
+
+		if (dwRet != WAIT_OBJECT_0)
+		{
+			m_nLastError = GetLastError();
+			return false;
+		}
+
+		// ȡȫŶӵ, ڳлʱص
+		LONG lCount = 0;
+
+		dwRet = WaitForSingleObject(m_hListenMutex, INFINITE);
+		if (dwRet == WAIT_OBJECT_0 || dwRet == WAIT_ABANDONED)
+		{
+			lCount = (m_pListen->lCount > ROSA_SHM_BACKLOG_MAX) ? ROSA_SHM_BACKLOG_MAX : m_pListen->lCount;
+			memcpy(dwRequest, m_pListen->dwRequest, lCount * sizeof(dwRequest[0]));
+			m_pListen->lCount = 0;
+
+			ReleaseMutex(m_hListenMutex);
+		}
+
+		for (LONG i = 0; i < lCount; ++i)
+		{
+			CRosaShmSocket* pConn = new CRosaShmSocket();
+
+			// ͻѾʱʱʧ
+			if (!pConn->OpenConnection(m_sPort, dwRequest[i][0], dwRequest[i][1]))
+			{
+				delete pConn;
+				continue;
+			}
+
+			pCallback(pConn, dwUser);
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaShmSocketAcceptOne()
+// @Purpose: CRosaShmSocketһ(ȡŶӵ, ûʱȴ; CRosaSocketѡ)
+// @Since: v1.00a
+// @Para: USHORT nTimeOutSec(ʱʱ)
+// @Return: CRosaShmSocket* pConn (, ɵdelete; NULL:ʱ(m_nLastErrorΪWAIT_TIMEOUT)ʧ)
+//------------------------------------------------------------------
+CRosaShmSocket* ROSASHMSOCKET_CALLMODE CRosaShmSocket::CRosaShmSocketAcceptOne(USHORT nTimeOutSec)
+{
+	if (m_pListen == NULL || m_pListen->lListening == 0)
+	{
+		m_nLastError = ERROR_INVALID_HANDLE;
+		return NULL;
+	}
+
+	ULONGLONG ullDeadline = GetTickCount64() + (ULONGLONG)nTimeOutSec * 1000;
+
+	for (;;)
+	{
+		DWORD dwRequest[2] = { 0 };
+		bool bFound = false;
+
+		// ֻȡ, ڶ(¼Զλ, Ȳٵȴ)
+		DWORD dwRet = WaitForSingleObject(m_hListenMutex, INFINITE);
+		if (dwRet == WAIT_OBJECT_0 || dwRet == WAIT_ABANDONED)
+		{
+			LONG lCount = (m_pListen->lCount > ROSA_SHM_BACKLOG_MAX) ? ROSA_SHM_BACKLOG_MAX : m_pListen->lCount;
+
+			if (lCount > 0)
+			{
+				memcpy(dwRequest, m_pListen->dwRequest[0], sizeof(dwRequest));
+				memmove(m_pListen->dwRequest[0], m_pListen->dwRequest[1], (lCount - 1) * sizeof(m_pListen->dwRequest[0]));
+				m_pListen->lCount = lCount - 1;
+				bFound = true;
+			}
+
+			ReleaseMutex(m_hListenMutex);
+		}
+
+		if (bFound)
+		{
+			CRosaShmSocket* pConn = new CRosaShmSocket();
+
+			// ͻѾʱʱʧ, ȡһ
+			if (pConn->OpenConnection(m_sPort, dwRequest[0], dwRequest[1]))
+			{
+				return pConn;
+			}
+
+			delete pConn;
+			continue;
+		}
+
+		ULONGLONG ullNow = GetTickCount64();
+		if (ullNow >= ullDeadline)
+		{
+			m_nLastError = WAIT_TIMEOUT;
+			return NULL;
+		}
+
+		dwRet = WaitForSingleObject(m_hAcceptEvent, (DWORD)(ullDeadline - ullNow));
+		if (dwRet == WAIT_TIMEOUT)
+		{
+			m_nLastError = WAIT_TIMEOUT;
+			return NULL;
+		}
+
+		if (dwRet != WAIT_OBJECT_0)
+		{
+			m_nLastError = GetLastError();
+			return NULL;
+		}
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaShmSocketConnect()
+// @Purpose: CRosaShmSocketͷ(ӹڴ˼, ȴ)
+// @Since: v1.00a
+// @Para: const char* pcRemoteIP(˵ַ, ֻ֧NULL/127.0.0.1/localhost/::1)
+// @Para: USHORT sPort(˶˿ں)
+// @Para: USHORT nTimeOutSec(ʱʱ)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSASHMSOCKET_CALLMODE CRosaShmSocket::CRosaShmSocketConnect(const char * pcRemoteIP, USHORT sPort, USHORT nTimeOutSec)
+{
+	char chName[ROSA_SHM_NAME_LENGTH] = { 0 };
+
+	if (m_bIsConnected || m_hListenMapping != NULL)
+	{
+		return false;
+	}
+
+	// ڴֻӱ
+	if (pcRemoteIP != NULL && strcmp(pcRemoteIP, "127.0.0.1") != 0 && _stricmp(pcRemoteIP, "localhost") != 0 && strcmp(pcRemoteIP, "::1") != 0)
+	{
+		m_nLastError = ERROR_NOT_SUPPORTED;
+		return false;
+	}
+
+	ULONGLONG ullDeadline = GetTickCount64() + (ULONGLONG)nTimeOutSec * 1000;
+
+	// 򿪷˼(ֻڼʹ)
+	MakeName(chName, "", sPort);
+	HANDLE hListenMapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, chName);
+	if (hListenMapping == NULL)
+	{
+		m_nLastError = GetLastError();
+		return false;
+	}
+
+	LPS_SHMLISTEN pListen = (LPS_SHMLISTEN)MapViewOfFile(hListenMapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(S_SHMLISTEN));
+
+	MakeName(chName, ".Lock", sPort);
+	HANDLE hListenMutex = OpenMutexA(SYNCHRONIZE | MUTEX_MODIFY_STATE, FALSE, chName);
+
+	MakeName(chName, ".Accept", sPort);
+	HANDLE hAcceptEvent = OpenEventA(EVENT_MODIFY_STATE, FALSE, chName);
+
+	bool bQueued = false;
+	DWORD dwSeq = (DWORD)InterlockedIncrement(&s_lConnectSeq);
+
+	if (pListen == NULL || hListenMutex == NULL || hAcceptEvent == NULL)
+	{
+		m_nLastError = GetLastError();
+	}
+	else if (pListen->dwMagic != ROSA_SHM_MAGIC || pListen->lListening == 0)
+	{
+		m_nLastError = ERROR_CONNECTION_REFUSED;
+	}
+	else if (CreateConnection(sPort, GetCurrentProcessId(), dwSeq))
+	{
+		ULONGLONG ullNow = GetTickCount64();
+		DWORD dwRet = WaitForSingleObject(hListenMutex, (ullDeadline > ullNow) ? (DWORD)(ullDeadline - ullNow) : 0);
+
+		if (dwRet == WAIT_OBJECT_0 || dwRet == WAIT_ABANDONED)
+		{
+			if (pListen->lCount < pListen->lBacklog && pListen->lCount < ROSA_SHM_BACKLOG_MAX)
+			{
+				pListen->dwRequest[pListen->lCount][0] = GetCurrentProcessId();
+				pListen->dwRequest[pListen->lCount][1] = dwSeq;
+				pListen->lCount++;
+				bQueued = true;
+			}
+			else
+			{
+				m_nLastError = ERROR_CONNECTION_REFUSED;
+			}
+
+			ReleaseMutex(hListenMutex);
+		}
+		else
+		{
+			m_nLastError = WAIT_TIMEOUT;
+		}
+
+		if (bQueued)
+		{
+			SetEvent(hAcceptEvent);
+		}
+	}
+
+	DWORD dwServerPID = (pListen != NULL) ? pListen->dwServerPID : 0;
+
+	if (pListen)
+	{
+		UnmapViewOfFile(pListen);
+	}
+	if (hListenMutex)
+	{
+		CloseHandle(hListenMutex);
+	}
+	if (hAcceptEvent)
+	{
+		CloseHandle(hAcceptEvent);
+	}
+	CloseHandle(hListenMapping);
+
+	if (!bQueued)
+	{
+		CloseConnection();
+		return false;
+	}
+
+	// ˽ܺλ˵ͻ˵¼
+	while (m_pHeader->lAccepted == 0)
+	{
+		ULONGLONG ullNow = GetTickCount64();
+		if (ullNow >= ullDeadline || WaitForSingleObject(m_hEvent[ROSA_SHM_SIDE_SERVER][0], (DWORD)(ullDeadline - ullNow)) == WAIT_FAILED)
+		{
+			m_nLastError = WAIT_TIMEOUT;
+			CloseConnection();
+			return false;
+		}
+	}
+
+	m_hPeerProcess = OpenProcess(SYNCHRONIZE, FALSE, (m_pHeader->lServerPID != 0) ? (DWORD)m_pHeader->lServerPID : dwServerPID);
+	m_sPort = sPort;
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaShmSocketDisConnect()
+// @Purpose: CRosaShmSocketϿ(Զ˶ʣݺ󷵻SOB_RET_CLOSE)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSASHMSOCKET_CALLMODE CRosaShmSocket::CRosaShmSocketDisConnect()
+{
+	CloseConnection();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaShmSocketSendBuffer()
+// @Purpose: CRosaShmSocketͻ(Ƶͻ, ռ䲻ʱȴԶ˶ȡ)
+// @Since: v1.00a
+// @Para: char* pSendBuffer(ͻ)
+// @Para: UINT uiBufferSize(ͳ)
+// @Para: USHORT nTimeOutSec(ʱʱ)
+// @Return: int nRet (SOB_RET_OK:ɹ, SOB_RET_FAIL:ʧ, SOB_RET_TIMEOUT:ʱ, SOB_RET_CLOSE:Զѹر)
+//------------------------------------------------------------------
+int ROSASHMSOCKET_CALLMODE CRosaShmSocket::CRosaShmSocketSendBuffer(char * pSendBuffer, UINT uiBufferSize, USHORT nTimeOutSec)
+{
+	if (!m_bIsConnected)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	UINT uiRing = (UINT)m_nSide;
+	LPS_SHMRING pRing = &m_pHeader->Ring[uiRing];
+	char* pData = m_pView + ROSA_SHM_HEADER_SIZE + uiRing * m_uiRingSize;
+	ULONGLONG ullDeadline = GetTickCount64() + (ULONGLONG)nTimeOutSec * 1000;
+	UINT uiSent = 0;
+
+	while (uiSent < uiBufferSize)
+	{
+		if (m_pHeader->lClosed[1 - m_nSide])
+		{
+			return SOB_RET_CLOSE;
+		}
+
+		ULONG ulHead = (ULONG)pRing->lHead;
+		ULONG ulTail = (ULONG)pRing->lTail;
+		UINT uiUsed = (UINT)(ulHead - ulTail);
+
+		if (uiUsed > m_uiRingSize)
+		{
+			return SOB_RET_FAIL;
+		}
+
+		if (uiUsed == m_uiRingSize)
+		{
+			int nRet = WaitRing(uiRing, true, ullDeadline);
+			if (nRet != SOB_RET_OK)
+			{
+				return nRet;
+			}
+			continue;
+		}
+
+		UINT uiCopy = m_uiRingSize - uiUsed;
+		uiCopy = (uiCopy < uiBufferSize - uiSent) ? uiCopy : (uiBufferSize - uiSent);
+
+		UINT uiPos = ulHead & (m_uiRingSize - 1);
+		UINT uiFirst = (uiCopy < m_uiRingSize - uiPos) ? uiCopy : (m_uiRingSize - uiPos);
+
+		memcpy(pData + uiPos, pSendBuffer + uiSent, uiFirst);
+		if (uiCopy > uiFirst)
+		{
+			memcpy(pData, pSendBuffer + uiSent + uiFirst, uiCopy - uiFirst);
+		}
+
+		// д֮ٷдλ
+		InterlockedExchange(&pRing->lHead, (LONG)(ulHead + uiCopy));
+		uiSent += uiCopy;
+
+		WakePeer(uiRing, true);
+	}
+
+	return SOB_RET_OK;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaShmSocketRecvOnce()
+// @Purpose: CRosaShmSocketջ(ʱѵĲ)
+// @Since: v1.00a
+// @Para: char* pRecvBuffer(ջ)
+// @Para: UINT uiBufferSize(ջ峤)
+// @Para: UINT& uiRecv(ճ)
+// @Para: USHORT nTimeOutSec(ʱʱ)
+// @Return: int nRet (SOB_RET_OK:ɹ, SOB_RET_FAIL:ʧ, SOB_RET_TIMEOUT:ʱ, SOB_RET_CLOSE:ԶѹرѶ)
+//------------------------------------------------------------------
+int ROSASHMSOCKET_CALLMODE CRosaShmSocket::CRosaShmSocketRecvOnce(char * pRecvBuffer, UINT uiBufferSize, UINT & uiRecv, USHORT nTimeOutSec)
+{
+	uiRecv = 0;
+
+	if (uiBufferSize == 0)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	return ReadRing(pRecvBuffer, 1, uiBufferSize, uiRecv, nTimeOutSec);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaShmSocketRecvBuffer()
+// @Purpose: CRosaShmSocketջ(յuiRecvSizeֽں󷵻)
+// @Since: v1.00a
+// @Para: char* pRecvBuffer(ջ)
+// @Para: UINT uiBufferSize(ջ峤)
+// @Para: UINT uiRecvSize(ճ, ڻ峤)
+// @Para: USHORT nTimeOutSec(ʱʱ)
+// @Return: int nRet (SOB_RET_OK:ɹ, SOB_RET_FAIL:ʧ, SOB_RET_TIMEOUT:ʱ, SOB_RET_CLOSE:Զѹر)
+//------------------------------------------------------------------
+int ROSASHMSOCKET_CALLMODE CRosaShmSocket::CRosaShmSocketRecvBuffer(char * pRecvBuffer, UINT uiBufferSize, UINT uiRecvSize, USHORT nTimeOutSec)
+{
+	UINT uiRecv = 0;
+
+	if (uiRecvSize == 0 || uiRecvSize > uiBufferSize)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	return ReadRing(pRecvBuffer, uiRecvSize, uiRecvSize, uiRecv, nTimeOutSec);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaShmSocketSetBufferSize()
+// @Purpose: CRosaShmSocketÿĻλ峤(ȡΪ2, ֮ǰ)
+// @Since: v1.00a
+// @Para: UINT uiByte(峤)
+// @Return: None
+//------------------------------------------------------------------
+void ROSASHMSOCKET_CALLMODE CRosaShmSocket::CRosaShmSocketSetBufferSize(UINT uiByte)
+{
+	if (m_bIsConnected)
+	{
+		return;
+	}
+
+	UINT uiSize = ROSA_SHM_RING_MIN;
+	while (uiSize < uiByte && uiSize < ROSA_SHM_RING_MAX)
+	{
+		uiSize <<= 1;
+	}
+
+	m_uiRingSize = uiSize;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaShmSocketIsConnected()
+// @Purpose: CRosaShmSocketȡ״̬
+// @Since: v1.00a
+// @Para: None
+// @Return: bool bRet (true:, false:δ)
+//------------------------------------------------------------------
+bool ROSASHMSOCKET_CALLMODE CRosaShmSocket::CRosaShmSocketIsConnected() const
+{
+	return m_bIsConnected;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaShmSocketGetPort()
+// @Purpose: CRosaShmSocketȡ˿ں
+// @Since: v1.00a
+// @Para: None
+// @Return: USHORT sPort
+//------------------------------------------------------------------
+USHORT ROSASHMSOCKET_CALLMODE CRosaShmSocket::CRosaShmSocketGetPort() const
+{
+	return m_sPort;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaShmSocketDestroy()
+// @Purpose: CRosaShmSocketϿӲֹͣ
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSASHMSOCKET_CALLMODE CRosaShmSocket::CRosaShmSocketDestroy()
+{
+	CloseConnection();
+	CloseListener();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CreateConnection()
+// @Purpose: CRosaShmSocketӹڴ漰¼(ͻ, ֮Ϊλ)
+// @Since: v1.00a
+// @Para: USHORT sPort(˿ں)
+// @Para: DWORD dwClientPID(ͻ˽ID)
+// @Para: DWORD dwSeq()
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool CRosaShmSocket::CreateConnection(USHORT sPort, DWORD dwClientPID, DWORD dwSeq)
+{
+	char chName[ROSA_SHM_NAME_LENGTH] = { 0 };
+	DWORD dwSize = ROSA_SHM_HEADER_SIZE + 2 * m_uiRingSize;
+
+	MakeName(chName, "", sPort, dwClientPID, dwSeq);
+	m_hMapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, dwSize, chName);
+	m_nLastError = GetLastError();
+
+	if (m_hMapping == NULL || m_nLastError == ERROR_ALREADY_EXISTS)
+	{
+		CloseConnection();
+		return false;
+	}
+
+	m_pView = (char*)MapViewOfFile(m_hMapping, FILE_MAP_ALL_ACCESS, 0, 0, dwSize);
+	if (m_pView == NULL || !OpenEvents(sPort, dwClientPID, dwSeq, true))
+	{
+		m_nLastError = GetLastError();
+		CloseConnection();
+		return false;
+	}
+
+	// ½ӳѾ
+	m_pHeader = (LPS_SHMHEADER)m_pView;
+	m_pHeader->dwRingSize = m_uiRingSize;
+	m_pHeader->dwClientPID = dwClientPID;
+	m_pHeader->dwMagic = ROSA_SHM_MAGIC;
+
+	m_nSide = ROSA_SHM_SIDE_CLIENT;
+	m_uiSpin[0] = m_uiSpin[1] = InitialSpin();
+	m_bIsConnected = true;
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OpenConnection()
+// @Purpose: CRosaShmSocketӹڴ漰¼(, Уѽܲѿͻ)
+// @Since: v1.00a
+// @Para: USHORT sPort(˿ں)
+// @Para: DWORD dwClientPID(ͻ˽ID)
+// @Para: DWORD dwSeq()
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool CRosaShmSocket::OpenConnection(USHORT sPort, DWORD dwClientPID, DWORD dwSeq)
+{
+	char chName[ROSA_SHM_NAME_LENGTH] = { 0 };
+
+	MakeName(chName, "", sPort, dwClientPID, dwSeq);
+	m_hMapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, chName);
+	if (m_hMapping == NULL)
+	{
+		m_nLastError = GetLastError();
+		return false;
+	}
+
+	m_pView = (char*)MapViewOfFile(m_hMapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+	if (m_pView == NULL)
+	{
+		m_nLastError = GetLastError();
+		CloseConnection();
+		return false;
+	}
+
+	// λ峤ɿͻд, Уʹñظ
+	m_pHeader = (LPS_SHMHEADER)m_pView;
+	UINT uiRingSize = m_pHeader->dwRingSize;
+
+	MEMORY_BASIC_INFORMATION mbi;
+	memset(&mbi, 0, sizeof(mbi));
+	VirtualQuery(m_pView, &mbi, sizeof(mbi));
+
+	if (m_pHeader->dwMagic != ROSA_SHM_MAGIC || uiRingSize < ROSA_SHM_RING_MIN || uiRingSize > ROSA_SHM_RING_MAX ||
+		(uiRingSize & (uiRingSize - 1)) != 0 || mbi.RegionSize < ROSA_SHM_HEADER_SIZE + 2 * (SIZE_T)uiRingSize ||
+		!OpenEvents(sPort, dwClientPID, dwSeq, false))
+	{
+		m_nLastError = ERROR_INVALID_DATA;
+		m_pHeader = NULL;
+		CloseConnection();
+		return false;
+	}
+
+	m_uiRingSize = uiRingSize;
+	m_hPeerProcess = OpenProcess(SYNCHRONIZE, FALSE, dwClientPID);
+	m_nSide = ROSA_SHM_SIDE_SERVER;
+	m_uiSpin[0] = m_uiSpin[1] = InitialSpin();
+	m_sPort = sPort;
+	m_bIsConnected = true;
+
+	InterlockedExchange(&m_pHeader->lServerPID, (LONG)GetCurrentProcessId());
+	InterlockedExchange(&m_pHeader->lAccepted, 1);
+	SetEvent(m_hEvent[ROSA_SHM_SIDE_SERVER][0]);
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OpenEvents()
+// @Purpose: CRosaShmSocket¼(ÿһ¼һռ¼, Զλ)
+// @Since: v1.00a
+// @Para: USHORT sPort(˿ں)
+// @Para: DWORD dwClientPID(ͻ˽ID)
+// @Para: DWORD dwSeq()
+// @Para: bool bCreate(true:, false:)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool CRosaShmSocket::OpenEvents(USHORT sPort, DWORD dwClientPID, DWORD dwSeq, bool bCreate)
+{
+	static const char* pcSuffix[2][2] = { { ".D0", ".S0" }, { ".D1", ".S1" } };
+	char chName[ROSA_SHM_NAME_LENGTH] = { 0 };
+
+	for (int r = 0; r < 2; ++r)
+	{
+		for (int k = 0; k < 2; ++k)
+		{
+			MakeName(chName, pcSuffix[r][k], sPort, dwClientPID, dwSeq);
+
+			m_hEvent[r][k] = bCreate ? CreateEventA(NULL, FALSE, FALSE, chName) : OpenEventA(SYNCHRONIZE | EVENT_MODIFY_STATE, FALSE, chName);
+			if (m_hEvent[r][k] == NULL)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CloseConnection()
+// @Purpose: CRosaShmSocketͷԴ(ʱȱǹرղѶԶ)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaShmSocket::CloseConnection()
+{
+	if (m_bIsConnected && m_pHeader != NULL)
+	{
+		InterlockedExchange(&m_pHeader->lClosed[m_nSide], 1);
+
+		// Զ˿ڶ˵ķͻд˵Ľջ
+		SetEvent(m_hEvent[m_nSide][0]);
+		SetEvent(m_hEvent[1 - m_nSide][1]);
+	}
+
+	m_bIsConnected = false;
+	m_pHeader = NULL;
+
+	if (m_pView)
+	{
+		UnmapViewOfFile(m_pView);
+		m_pView = NULL;
+	}
+
+	if (m_hMapping)
+	{
+		CloseHandle(m_hMapping);
+		m_hMapping = NULL;
+	}
+
+	for (int r = 0; r < 2; ++r)
+	{
+		for (int k = 0; k < 2; ++k)
+		{
+			if (m_hEvent[r][k])
+			{
+				CloseHandle(m_hEvent[r][k]);
+				m_hEvent[r][k] = NULL;
+			}
+		}
+	}
+
+	if (m_hPeerProcess)
+	{
+		CloseHandle(m_hPeerProcess);
+		m_hPeerProcess = NULL;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CloseListener()
+// @Purpose: CRosaShmSocketͷżԴ(֮ʧ)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaShmSocket::CloseListener()
+{
+	if (m_pListen)
+	{
+		InterlockedExchange(&m_pListen->lListening, 0);
+		UnmapViewOfFile(m_pListen);
+		m_pListen = NULL;
+	}
+
+	if (m_hListenMapping)
+	{
+		CloseHandle(m_hListenMapping);
+		m_hListenMapping = NULL;
+	}
+
+	if (m_hListenMutex)
+	{
+		CloseHandle(m_hListenMutex);
+		m_hListenMutex = NULL;
+	}
+
+	if (m_hAcceptEvent)
+	{
+		CloseHandle(m_hAcceptEvent);
+		m_hAcceptEvent = NULL;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 ReadRing()
+// @Purpose: CRosaShmSocketӽջȡuiMinֽ, uiMaxֽ(ݲʱȴ)
+// @Since: v1.00a
+// @Para: char* pRecvBuffer(ջ)
+// @Para: UINT uiMin(ٳ)
+// @Para: UINT uiMax(೤)
+// @Para: UINT& uiRecv(ճ)
+// @Para: USHORT nTimeOutSec(ʱʱ)
+// @Return: int nRet (SOB_RET_OK:ɹ, SOB_RET_FAIL:ʧ, SOB_RET_TIMEOUT:ʱ, SOB_RET_CLOSE:ԶѹرѶ)
+//------------------------------------------------------------------
+int CRosaShmSocket::ReadRing(char * pRecvBuffer, UINT uiMin, UINT uiMax, UINT & uiRecv, USHORT nTimeOutSec)
+{
+	uiRecv = 0;
+
+	if (!m_bIsConnected)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	UINT uiRing = (UINT)(1 - m_nSide);
+	LPS_SHMRING pRing = &m_pHeader->Ring[uiRing];
+	char* pData = m_pView + ROSA_SHM_HEADER_SIZE + uiRing * m_uiRingSize;
+	ULONGLONG ullDeadline = GetTickCount64() + (ULONGLONG)nTimeOutSec * 1000;
+
+	while (uiRecv < uiMin)
+	{
+		ULONG ulTail = (ULONG)pRing->lTail;
+		ULONG ulHead = (ULONG)pRing->lHead;
+		UINT uiAvail = (UINT)(ulHead - ulTail);
+
+		if (uiAvail > m_uiRingSize)
+		{
+			return SOB_RET_FAIL;
+		}
+
+		if (uiAvail == 0)
+		{
+			// Զȷٱǹر, رպȷһ
+			if (m_pHeader->lClosed[1 - m_nSide])
+			{
+				if ((ULONG)pRing->lHead == ulTail)
+				{
+					return SOB_RET_CLOSE;
+				}
+				continue;
+			}
+
+			int nRet = WaitRing(uiRing, false, ullDeadline);
+			if (nRet != SOB_RET_OK)
+			{
+				return nRet;
+			}
+			continue;
+		}
+
+		UINT uiCopy = (uiAvail < uiMax - uiRecv) ? uiAvail : (uiMax - uiRecv);
+		UINT uiPos = ulTail & (m_uiRingSize - 1);
+		UINT uiFirst = (uiCopy < m_uiRingSize - uiPos) ? uiCopy : (m_uiRingSize - uiPos);
+
+		memcpy(pRecvBuffer + uiRecv, pData + uiPos, uiFirst);
+		if (uiCopy > uiFirst)
+		{
+			memcpy(pRecvBuffer + uiRecv + uiFirst, pData, uiCopy - uiFirst);
+		}
+
+		// ݸ֮ٹ黹ռ
+		InterlockedExchange(&pRing->lTail, (LONG)(ulTail + uiCopy));
+		uiRecv += uiCopy;
+
+		WakePeer(uiRing, false);
+	}
+
+	return SOB_RET_OK;
+}
+
+//------------------------------------------------------------------
+// @Function:	 WaitRing()
+// @Purpose: CRosaShmSocketȴݻռ(ڼȵӱ´, ; Զ˽˳ʱǹر)
+// @Since: v1.00a
+// @Para: UINT uiRing()
+// @Para: bool bWriter(true:ȴռ, false:ȴ)
+// @Para: ULONGLONG ullDeadline(ֹʱ, GetTickCount64)
+// @Return: int nRet (SOB_RET_OK:ܾԶѹر, ɵ¼; SOB_RET_TIMEOUT:ʱ; SOB_RET_FAIL:ȴʧ)
+//------------------------------------------------------------------
+int CRosaShmSocket::WaitRing(UINT uiRing, bool bWriter, ULONGLONG ullDeadline)
+{
+	LPS_SHMRING pRing = &m_pHeader->Ring[uiRing];
+	volatile LONG* pWaiting = bWriter ? &pRing->lWriterWaiting : &pRing->lReaderWaiting;
+	volatile LONG* pPeerClosed = &m_pHeader->lClosed[1 - m_nSide];
+	UINT& uiSpin = m_uiSpin[bWriter ? 1 : 0];
+
+	// дȴռ, ȴ
+	for (UINT i = 0; i < uiSpin; ++i)
+	{
+		UINT uiUsed = (UINT)((ULONG)pRing->lHead - (ULONG)pRing->lTail);
+
+		if ((bWriter ? (uiUsed < m_uiRingSize) : (uiUsed != 0)) || *pPeerClosed)
+		{
+			uiSpin = (uiSpin * 2 > ROSA_SHM_SPIN_MAX) ? ROSA_SHM_SPIN_MAX : uiSpin * 2;
+			return SOB_RET_OK;
+		}
+
+		YieldProcessor();
+	}
+
+	// ȴټһ, Զ"ȷλټȴ־", ᶪʧ
+	InterlockedExchange(pWaiting, 1);
+
+	UINT uiUsed = (UINT)((ULONG)pRing->lHead - (ULONG)pRing->lTail);
+	if ((bWriter ? (uiUsed < m_uiRingSize) : (uiUsed != 0)) || *pPeerClosed)
+	{
+		InterlockedExchange(pWaiting, 0);
+		return SOB_RET_OK;
+	}
+
+	// ûеȵ, ´(ʱΪ0)
+	if (uiSpin / 2 >= ROSA_SHM_SPIN_MIN)
+	{
+		uiSpin /= 2;
+	}
+
+	ULONGLONG ullNow = GetTickCount64();
+	if (ullNow >= ullDeadline)
+	{
+		InterlockedExchange(pWaiting, 0);
+		return SOB_RET_TIMEOUT;
+	}
+
+	HANDLE hWait[2] = { m_hEvent[uiRing][bWriter ? 1 : 0], m_hPeerProcess };
+	DWORD dwRet = WaitForMultipleObjects((m_hPeerProcess != NULL) ? 2 : 1, hWait, FALSE, (DWORD)(ullDeadline - ullNow));
+
+	InterlockedExchange(pWaiting, 0);
+
+	switch (dwRet)
+	{
+	case WAIT_OBJECT_0:
+		return SOB_RET_OK;
+	case WAIT_OBJECT_0 + 1:
+		InterlockedExchange(pPeerClosed, 1);
+		return SOB_RET_OK;
+	case WAIT_TIMEOUT:
+		return SOB_RET_TIMEOUT;
+	default:
+		m_nLastError = GetLastError();
+		return SOB_RET_FAIL;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 WakePeer()
+// @Purpose: CRosaShmSocketѵȴеĶԶ(ֻڶԶȴʱں)
+// @Since: v1.00a
+// @Para: UINT uiRing()
+// @Para: bool bWriter(true:д, false:ڳ˿ռ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaShmSocket::WakePeer(UINT uiRing, bool bWriter)
+{
+	LPS_SHMRING pRing = &m_pHeader->Ring[uiRing];
+	volatile LONG* pWaiting = bWriter ? &pRing->lReaderWaiting : &pRing->lWriterWaiting;
+
+	if (*pWaiting != 0 && InterlockedExchange(pWaiting, 0) != 0)
+	{
+		SetEvent(m_hEvent[uiRing][bWriter ? 0 : 1]);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 MakeName()
+// @Purpose: CRosaShmSocketɶ(Ựڿɼ; ͻ˽IDΪ0ʱΪ)
+// @Since: v1.00a
+// @Para: char* pcName(, ROSA_SHM_NAME_LENGTH)
+// @Para: const char* pcSuffix(׺)
+// @Para: USHORT sPort(˿ں)
+// @Para: DWORD dwClientPID(ͻ˽ID)
+// @Para: DWORD dwSeq()
+// @Return: None
+//------------------------------------------------------------------
+void CRosaShmSocket::MakeName(char * pcName, const char * pcSuffix, USHORT sPort, DWORD dwClientPID, DWORD dwSeq)
+{
+	if (dwClientPID == 0)
+	{
+		sprintf_s(pcName, ROSA_SHM_NAME_LENGTH, "Local\\RosaShm.%u%s", sPort, pcSuffix);
+	}
+	else
+	{
+		sprintf_s(pcName, ROSA_SHM_NAME_LENGTH, "Local\\RosaShm.%u.%lu.%lu%s", sPort, dwClientPID, dwSeq, pcSuffix);
+	}
+}
@@ -0,0 +1,151 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaShmSocket.h
+* @brief	This File is RosaShmSocket Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSASHMSOCKET_H__
+#define __CROSASHMSOCKET_H__
+
+//Include Rosa Header File
+#include "CRosaSocket.h"
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSASHMSOCKET_API	__declspec(dllexport)
+#else
+#define ROSASHMSOCKET_API	__declspec(dllimport)
+#endif
+
+#define ROSASHMSOCKET_CALLMODE	__stdcall
+
+#define ROSA_SHM_MAGIC				0x52534D31			//ڴʶ("RSM1")
+#define ROSA_SHM_NAME_LENGTH		96					//󳤶
+#define ROSA_SHM_CACHE_LINE			64					//г(дλ÷д)
+#define ROSA_SHM_HEADER_SIZE		4096				//ӿ(λݴӴ˿ʼ)
+#define ROSA_SHM_RING_SIZE			(256 * 1024)		//ĬÿĻλ峤
+#define ROSA_SHM_RING_MIN			4096				//λС
+#define ROSA_SHM_RING_MAX			(64 * 1024 * 1024)	//λ󳤶
+#define ROSA_SHM_BACKLOG_MAX		64					//󳤶
+#define ROSA_SHM_SPIN_INIT			1024				//ȴǰĳʼ
+#define ROSA_SHM_SPIN_MIN			16					//(ʱ)
+#define ROSA_SHM_SPIN_MAX			16384				//
+
+#define ROSA_SHM_SIDE_CLIENT		0					//ͻ(д0Ż, 1Ż)
+#define ROSA_SHM_SIDE_SERVER		1					//(д1Ż, 0Ż)
+
+//Struct Definition
+typedef struct
+{
+	volatile LONG lHead;										// дλ(ֻд޸, 32λ)
+	BYTE byPad0[ROSA_SHM_CACHE_LINE - sizeof(LONG)];
+	volatile LONG lTail;										// ȡλ(ֻɶ޸)
+	BYTE byPad1[ROSA_SHM_CACHE_LINE - sizeof(LONG)];
+	volatile LONG lReaderWaiting;								// ѽȴ(дݺλ¼)
+	volatile LONG lWriterWaiting;								// дѽȴ(ڳռλռ¼)
+	BYTE byPad2[ROSA_SHM_CACHE_LINE - 2 * sizeof(LONG)];
+}S_SHMRING, *LPS_SHMRING;
+
+typedef struct
+{
+	DWORD dwMagic;												// ڴʶ
+	DWORD dwRingSize;											// ÿλ峤(2)
+	DWORD dwClientPID;											// ͻ˽ID
+	volatile LONG lServerPID;									// ˽ID(ʱд)
+	volatile LONG lAccepted;									// Ƿѱ
+	volatile LONG lClosed[2];									// Ƿѹر
+	BYTE byPad[ROSA_SHM_CACHE_LINE - 7 * sizeof(LONG)];
+	S_SHMRING Ring[2];											// 0:ͻ˵, 1:˵ͻ
+}S_SHMHEADER, *LPS_SHMHEADER;
+
+typedef struct
+{
+	DWORD dwMagic;												// ڴʶ
+	DWORD dwServerPID;											// ˽ID
+	volatile LONG lListening;									// Ƿڼ
+	LONG lBacklog;												// г
+	LONG lCount;												// Ŷӵ(мʱ)
+	DWORD dwRequest[ROSA_SHM_BACKLOG_MAX][2];					// (ͻ˽ID, )
+}S_SHMLISTEN, *LPS_SHMLISTEN;
+
+//Class Declaration
+class CRosaShmSocket;
+
+//Callback Definition
+typedef void(__stdcall *HANDLE_SHM_ACCEPT_CALLBACK)(CRosaShmSocket* pConn, DWORD dwUser);		//ӻص(pConn, ɻصdelete)
+
+//Class Definition
+class ROSASHMSOCKET_API CRosaShmSocket
+{
+public:
+	CRosaShmSocket();			// CRosaShmSocket 캯
+	~CRosaShmSocket();			// CRosaShmSocket 
+
+// 
+public:
+	bool ROSASHMSOCKET_CALLMODE CRosaShmSocketBindOnPort(USHORT sPort);							// CRosaShmSocket 󶨷˶˿(˿ںֻ, TCP˿ڻӰ)
+	bool ROSASHMSOCKET_CALLMODE CRosaShmSocketListen(int nBacklog = SOB_DEFAULT_BACKLOG);		// CRosaShmSocket ʼ
+	bool ROSASHMSOCKET_CALLMODE CRosaShmSocketAccept(HANDLE_SHM_ACCEPT_CALLBACK pCallback, DWORD dwUser, BOOL* pExitFlag = NULL, USHORT nLoopTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);	// CRosaShmSocket տͻ(˳־λ󷵻)
+	CRosaShmSocket* ROSASHMSOCKET_CALLMODE CRosaShmSocketAcceptOne(USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);	// CRosaShmSocket һ(NULL:ʱʧ, ɵdelete)
+
+// ͻ
+public:
+	bool ROSASHMSOCKET_CALLMODE CRosaShmSocketConnect(const char* pcRemoteIP = NULL, USHORT sPort = 0, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);	// CRosaShmSocket ͷ(ֱַֻ֧)
+	void ROSASHMSOCKET_CALLMODE CRosaShmSocketDisConnect();									// CRosaShmSocket Ͽ
+
+	int ROSASHMSOCKET_CALLMODE CRosaShmSocketSendBuffer(char* pSendBuffer, UINT uiBufferSize, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);					// CRosaShmSocket ͻ(һ)
+	int ROSASHMSOCKET_CALLMODE CRosaShmSocketRecvOnce(char* pRecvBuffer, UINT uiBufferSize, UINT& uiRecv, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);		// CRosaShmSocket ջ(ѵ)
+	int ROSASHMSOCKET_CALLMODE CRosaShmSocketRecvBuffer(char* pRecvBuffer, UINT uiBufferSize, UINT uiRecvSize, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);	// CRosaShmSocket ջ(һ)
+
+// 
+public:
+	void ROSASHMSOCKET_CALLMODE CRosaShmSocketSetBufferSize(UINT uiByte);						// CRosaShmSocket ÿĻλ峤(֮ǰ, ɿͻ˾)
+	bool ROSASHMSOCKET_CALLMODE CRosaShmSocketIsConnected() const;								// CRosaShmSocket ȡ״̬
+	USHORT ROSASHMSOCKET_CALLMODE CRosaShmSocketGetPort() const;								// CRosaShmSocket ȡ˿ں
+	void ROSASHMSOCKET_CALLMODE CRosaShmSocketDestroy();										// CRosaShmSocket ϿӲֹͣ
+
+private:
+	bool CreateConnection(USHORT sPort, DWORD dwClientPID, DWORD dwSeq);						// CRosaShmSocket ӹڴ漰¼(ͻ)
+	bool OpenConnection(USHORT sPort, DWORD dwClientPID, DWORD dwSeq);							// CRosaShmSocket ӹڴ漰¼()
+	bool OpenEvents(USHORT sPort, DWORD dwClientPID, DWORD dwSeq, bool bCreate);				// CRosaShmSocket ¼
+	void CloseConnection();																		// CRosaShmSocket ͷԴ
+	void CloseListener();																		// CRosaShmSocket ͷżԴ
+
+	int ReadRing(char* pRecvBuffer, UINT uiMin, UINT uiMax, UINT& uiRecv, USHORT nTimeOutSec);	// CRosaShmSocket ӽջȡuiMinֽ, uiMaxֽ
+	int WaitRing(UINT uiRing, bool bWriter, ULONGLONG ullDeadline);							// CRosaShmSocket ȴݻռ(SOB_RET_OKʱɵ¼)
+	void WakePeer(UINT uiRing, bool bWriter);													// CRosaShmSocket ѵȴеĶԶ
+
+	static void MakeName(char* pcName, const char* pcSuffix, USHORT sPort, DWORD dwClientPID = 0, DWORD dwSeq = 0);	// CRosaShmSocket ɶ(ͻ˽IDΪ0ʱΪ)
+
+private:
+	USHORT m_sPort;									// CRosaShmSocket ˿ں
+	UINT m_uiRingSize;								// CRosaShmSocket ʱʹõĻλ峤
+
+	HANDLE m_hListenMapping;						// CRosaShmSocket ڴ
+	LPS_SHMLISTEN m_pListen;						// CRosaShmSocket 
+	HANDLE m_hListenMutex;							// CRosaShmSocket л
+	HANDLE m_hAcceptEvent;							// CRosaShmSocket ¼
+
+	HANDLE m_hMapping;								// CRosaShmSocket ӹڴ
+	char* m_pView;									// CRosaShmSocket ӹڴͼ
+	LPS_SHMHEADER m_pHeader;						// CRosaShmSocket ӿ
+	HANDLE m_hEvent[2][2];							// CRosaShmSocket ¼([][0:, 1:ռ], Զλ)
+	HANDLE m_hPeerProcess;							// CRosaShmSocket Զ˽(˳ʱжϿ)
+	int m_nSide;									// CRosaShmSocket (ROSA_SHM_SIDE_*)
+	bool m_bIsConnected;							// CRosaShmSocket ״̬
+
+	UINT m_uiSpin[2];								// CRosaShmSocket Ӧ([0:, 1:])
+
+public:
+	int m_nLastError;								// CRosaShmSocket ϵͳ
+
+};
+
+#endif // !__CROSASHMSOCKET_H__
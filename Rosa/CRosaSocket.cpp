@@ -10,14 +10,183 @@
 * @date		2018-10-08	v1.00a	alopex	Create This File.
 */
 #include "CRosaSocket.h"
+#include "CRosaResolver.h"
+#include "CRosaShmSocket.h"
+#include "CRosaEventLoop.h"
+#include "CRosaTrace.h"
 #include "CThreadSafe.h"
 
 #include <Windows.h>
 #include <Ws2tcpip.h>
+#include <mstcpip.h>
 #include <process.h>
 
+// ɰSDK(10.0.17063֮ǰ)ûafunix.h
+#if __has_include(<afunix.h>)
+#include <afunix.h>
+#else
+#define UNIX_PATH_MAX	108
+
+typedef struct sockaddr_un
+{
+	ADDRESS_FAMILY sun_family;
+	char sun_path[UNIX_PATH_MAX];
+}SOCKADDR_UN, *PSOCKADDR_UN;
+#endif
+
+#ifndef SIO_AF_UNIX_GETPEERPID
+#define SIO_AF_UNIX_GETPEERPID			_WSAIOR(IOC_VENDOR, 256)
+#endif
+
 #pragma warning(disable:4996)
 
+// ɰSDK(10.0.19041֮ǰ)ûUDPֶ/ϲжصĶ
+#ifndef UDP_SEND_MSG_SIZE
+#define UDP_SEND_MSG_SIZE				2
+#endif
+
+#ifndef UDP_RECV_MAX_COALESCED_SIZE
+#define UDP_RECV_MAX_COALESCED_SIZE		3
+#endif
+
+#ifndef UDP_COALESCED_INFO
+#define UDP_COALESCED_INFO				3
+#endif
+
+// ƬԤͶݵAcceptEx
+typedef struct
+{
+	SOCKET sAccept;						// Ԥȴ׽
+	WSAOVERLAPPED Overlapped;			// صṹ(hEventΪ¼)
+	char chAddrBuf[2 * (sizeof(SOCKADDR_IN) + 16)];		// /Զ̵ַ
+}S_ACCEPTSLOT, *LPS_ACCEPTSLOT;
+
+// Ƭ̲߳
+typedef struct _S_ACCEPTSHARD
+{
+	CRosaSocket* pSocket;				// 
+	USHORT nShard;						// Ƭ
+	USHORT nShards;						// Ƭ
+	DWORD dwProcessor;					// 󶨵Ĵ
+	HANDLE_SHARD_ACCEPT_CALLBACK pCallback;		// ӻص
+	DWORD dwUser;						// û
+	BOOL* pExitFlag;					// ˳־
+	bool bSteerToRSS;					// ǷRSSת
+	USHORT nLoopTimeOutSec;				// ȴʱ
+	bool bActive;						// Ƭ߳Ƿ(˳Ƭת, csHandoff)
+	bool bFailed;						// Ƭ߳Ƿ쳣˳(׽ʧЧȴʧ)
+	LPFN_ACCEPTEX pfnAcceptEx;			// AcceptExչ
+	LPFN_GETACCEPTEXSOCKADDRS pfnGetAcceptExSockaddrs;	// GetAcceptExSockaddrsչ
+	struct _S_ACCEPTSHARD* pShards;		// ȫƬ(ת)
+	WSAEVENT hHandoffEvent;				// ת¼
+	CRITICAL_SECTION csHandoff;			// תٽ
+	vector<S_CLIENTINFO> vecHandoff;	// Ƭת
+}S_ACCEPTSHARD, *LPS_ACCEPTSHARD;
+
+// 㿽첽״̬(̳߳ػصһ)
+typedef struct
+{
+	WSAOVERLAPPED Overlapped;			// صṹ(hEventΪ¼)
+	WSAEVENT hEvent;					// ¼
+	SOCKET Socket;						// ׽
+	HANDLE hWait;						// ̳߳صȴ
+	volatile LONG nRef;					// ü
+	const char* pSendBuffer;			// û(ǰͷ)
+	UINT uiBufferSize;					// ͳ
+	HANDLE_SEND_COMPLETE_CALLBACK pCallback;	// ɻص
+	DWORD_PTR dwUser;					// û
+}S_ZEROCOPYSEND, *LPS_ZEROCOPYSEND;
+
+// 㿽첽ͷһ
+static void ReleaseZeroCopySend(LPS_ZEROCOPYSEND pSend)
+{
+	if (InterlockedDecrement(&pSend->nRef) != 0)
+	{
+		return;
+	}
+
+	// صڵʱUnregisterWaitERROR_IO_PENDING, ȴԻᱻɾ
+	if (pSend->hWait != NULL)
+	{
+		UnregisterWait(pSend->hWait);
+	}
+
+	WSACloseEvent(pSend->hEvent);
+	delete pSend;
+}
+
+// صʹתΪֵ
+static int TranslateSendError(DWORD dwError)
+{
+	switch (dwError)
+	{
+	case WSAECONNRESET:
+	case WSAECONNABORTED:
+	case WSAENETRESET:
+	case WSAESHUTDOWN:
+	case ERROR_NETNAME_DELETED:
+		return SOB_RET_CLOSE;
+	default:
+		return SOB_RET_FAIL;
+	}
+}
+
+// Unix·תΪַ('@'ͷΪַ, صַ, 0ʾ·Ч)
+static int MakeUnixAddr(const char* pcPath, SOCKADDR_UN* pAddr)
+{
+	memset(pAddr, 0, sizeof(SOCKADDR_UN));
+	pAddr->sun_family = AF_UNIX;
+
+	size_t nLen = (pcPath != NULL) ? strlen(pcPath) : 0;
+	if (nLen == 0 || nLen >= sizeof(pAddr->sun_path))
+	{
+		return 0;
+	}
+
+	memcpy(pAddr->sun_path, pcPath, nLen);
+
+	// ַ0ͷҲβ0, Ⱦ
+	if (pcPath[0] == '@')
+	{
+		pAddr->sun_path[0] = '\0';
+		return (int)(offsetof(SOCKADDR_UN, sun_path) + nLen);
+	}
+
+	return (int)sizeof(SOCKADDR_UN);
+}
+
+// ƬͶһAcceptEx
+static bool PostAcceptSlot(LPS_ACCEPTSHARD pShard, SOCKET sListen, LPS_ACCEPTSLOT pSlot)
+{
+	// صṹ¼(Ͷʧʱ۱ֿУ¼ٴ)
+	WSAEVENT hEvent = pSlot->Overlapped.hEvent;
+	memset(&pSlot->Overlapped, 0, sizeof(pSlot->Overlapped));
+	pSlot->Overlapped.hEvent = hEvent;
+	WSAResetEvent(hEvent);
+
+	pSlot->sAccept = WSASocket(AF_INET, SOCK_STREAM, IPPROTO_TCP, NULL, 0, WSA_FLAG_OVERLAPPED);
+	if (pSlot->sAccept == INVALID_SOCKET)
+	{
+		return false;
+	}
+
+	DWORD dwBytes = 0;
+	if (!pShard->pfnAcceptEx(sListen, pSlot->sAccept, pSlot->chAddrBuf, 0, sizeof(SOCKADDR_IN) + 16, sizeof(SOCKADDR_IN) + 16, &dwBytes, &pSlot->Overlapped))
+	{
+		int nError = WSAGetLastError();
+
+		if (nError != ERROR_IO_PENDING)
+		{
+			closesocket(pSlot->sAccept);
+			pSlot->sAccept = INVALID_SOCKET;
+			WSASetLastError(nError);
+			return false;
+		}
+	}
+
+	return true;
+}
+
 char CRosaSocket::m_pcLocalIP[SOB_IP_LENGTH] = { 0 };
 USHORT CRosaSocket::m_sLocalPort = 0;
 
@@ -34,11 +203,37 @@ CRosaSocket::CRosaSocket()
 	m_nAcceptCount = 0;
 	m_mapAccept.clear();
 
+	InitializeCriticalSection(&m_csIdle);
+	m_pIdleLoop = NULL;
+	m_dwIdleTimeOut = 0;
+	m_ullIdleNextID = 0;
+
 	memset(m_pcRemoteIP, 0, SOB_IP_LENGTH);
 	m_sRemotePort = 0;
 
 	memset(m_pcHostIP, 0, SOB_IP_LENGTH);
 	m_sHostPort = 0;
+
+	m_bUDPSendOffload = false;
+	m_bUDPRecvOffload = false;
+	m_sUDPSegmentSize = SOB_UDP_SEGMENT_SIZE;
+	m_pfnWSARecvMsg = NULL;
+
+	m_pfnTransmitFile = NULL;
+
+	InitializeCriticalSection(&m_csCompress);
+
+	memset(m_pcUnixPath, 0, SOB_UNIX_PATH_LENGTH);
+	m_bUnixListen = false;
+	m_bUnixClient = false;
+
+	m_nTransport = SOB_TRANSPORT_TCP;
+	m_pShm = NULL;
+	InitializeCriticalSection(&m_csShm);
+	m_ulShmNextID = 0;
+
+	memset(m_pHistogram, 0, sizeof(m_pHistogram));
+	m_lFirstBytePending = 0;
 }
 
 // CRosaSocket 
@@ -50,6 +245,17 @@ CRosaSocket::~CRosaSocket()
 		m_socket = NULL;
 	}
 
+	// ·ļ׽ֹرպȻ, ɾ´ΰʧ
+	if (m_bUnixListen)
+	{
+		if (m_pcUnixPath[0] != '@')
+		{
+			DeleteFileA(m_pcUnixPath);
+		}
+
+		m_bUnixListen = false;
+	}
+
 	if (m_SocketWriteEvent)
 	{
 		WSACloseEvent(m_SocketWriteEvent);
@@ -62,6 +268,38 @@ CRosaSocket::~CRosaSocket()
 		m_SocketReadEvent = NULL;
 	}
 
+	// ֹͣȫмʱ(ȴִеĳʱص)
+	if (m_pIdleLoop)
+	{
+		CRosaSocketSetIdleTimeOut(NULL, 0);
+	}
+
+	DeleteCriticalSection(&m_csIdle);
+
+	// ͷδƳѹ״̬
+	for (map<SOCKET, CRosaCompress*>::iterator iter = m_mapCompress.begin(); iter != m_mapCompress.end(); ++iter)
+	{
+		delete iter->second;
+	}
+	m_mapCompress.clear();
+
+	DeleteCriticalSection(&m_csCompress);
+
+	// ڴ/ͻӼδرյĽ
+	if (m_pShm)
+	{
+		delete m_pShm;
+		m_pShm = NULL;
+	}
+
+	for (map<SOCKET, CRosaShmSocket*>::iterator iter = m_mapShm.begin(); iter != m_mapShm.end(); ++iter)
+	{
+		delete iter->second;
+	}
+	m_mapShm.clear();
+
+	DeleteCriticalSection(&m_csShm);
+
 }
 
 // CRosaSocket ʼSocket
@@ -73,6 +311,8 @@ void CRosaSocket::CRosaSocketLibInit()
 
 	wVersionRequested = MAKEWORD(2, 2);
 
+	CRosaTrace::CRosaTraceRegister();				// עٵ(CRosaSocketLibReleaseɶ)
+
 	nErr = WSAStartup(wVersionRequested, &wsaData);	// ʼSOCKET
 	if (nErr != 0)
 	{
@@ -84,6 +324,8 @@ void CRosaSocket::CRosaSocketLibInit()
 void CRosaSocket::CRosaSocketLibRelease()
 {
 	WSACleanup();	// SOCKET
+
+	CRosaTrace::CRosaTraceUnregister();
 }
 
 // CRosaSocket TCP׽
@@ -142,6 +384,32 @@ SOCKET CRosaSocket::CreateUDPSocket()
 	return s;
 }
 
+// CRosaSocket Unix׽(Windows 10 1803֧֮, ֧ݱ)
+SOCKET CRosaSocket::CreateUnixSocket()
+{
+	SOCKET s = socket(AF_UNIX, SOCK_STREAM, 0);		// Unix Socket
+
+	// Ϊ
+	if (s == INVALID_SOCKET)
+	{
+		s = NULL;
+		m_nLastWSAError = WSAGetLastError();
+	}
+
+	// 첽¼
+	if (m_SocketWriteEvent == NULL)
+	{
+		m_SocketWriteEvent = WSACreateEvent();
+	}
+
+	if (m_SocketReadEvent == NULL)
+	{
+		m_SocketReadEvent = WSACreateEvent();
+	}
+
+	return s;
+}
+
 // CRosaSocket ýݳʱʱ
 void ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSetRecvTimeOut(UINT uiMSec)
 {
@@ -170,12 +438,49 @@ void ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSetSendBufferSize(UINT uiByte)
 	setsockopt(m_socket, SOL_SOCKET, SO_SNDBUF, (char*)&uiBufferSize, sizeof(uiBufferSize));
 }
 
+// CRosaSocket ǷNagle(ͻ)
+bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSetNoDelay(bool bNoDelay)
+{
+	return CRosaSocketSetNoDelay(m_socket, bNoDelay);
+}
+
+// CRosaSocket ǷNagle()<رTCP_NODELAYЭջϲС, Զӳȷϵʱӳٿɴٺ>
+bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSetNoDelay(SOCKET Socket, bool bNoDelay)
+{
+	const char chOpt = bNoDelay ? 1 : 0;
+	if (setsockopt(Socket, IPPROTO_TCP, TCP_NODELAY, &chOpt, sizeof(char)) == SOCKET_ERROR)
+	{
+		m_nLastWSAError = WSAGetLastError();
+		return false;
+	}
+
+	return true;
+}
+
+// CRosaSocket öӳͳ(ROSA_HISTOGRAM_OP_*, NULLʾȡ, ͳƶɵ߹)
+bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSetHistogram(int nOp, CRosaHistogram * pHistogram)
+{
+	if (nOp < 0 || nOp >= ROSA_HISTOGRAM_OP_COUNT || nOp == ROSA_HISTOGRAM_OP_SERIALWRITE)
+	{
+		return false;
+	}
+
+	m_pHistogram[nOp] = pHistogram;
+	return true;
+}
+
 // CRosaSocket ȡSocket
 SOCKET ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketGetRawSocket() const
 {
 	return m_socket;
 }
 
+// CRosaSocket ȡһWSA
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketGetLastWSAError() const
+{
+	return m_nLastWSAError;
+}
+
 // CRosaSocket Socket׽
 bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketAttachRawSocket(SOCKET s, bool bIsConnected)
 {
@@ -199,17 +504,40 @@ bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketAttachRawSocket(SOCKET s, bool
 	// ȡԶϢ
 	if (bIsConnected)
 	{
-		struct sockaddr_in addrPeer;
+		SOCKADDR_STORAGE addrPeer;
 		int nLen = sizeof(addrPeer);
 		if (getpeername(s, (struct sockaddr*)&addrPeer, &nLen) == SOCKET_ERROR)
 		{
 			return false;
 		}
 
-		InetNtopA(AF_INET, &addrPeer.sin_addr, m_pcRemoteIP, SOB_IP_LENGTH);
-		InetNtopW(AF_INET, &addrPeer.sin_addr, m_pwcRemoteIP, SOB_IP_LENGTH);
+		// ֧CRosaConnectorIPv6
+		if (addrPeer.ss_family == AF_INET6)
+		{
+			SOCKADDR_IN6* pAddr6 = (SOCKADDR_IN6*)&addrPeer;
+			InetNtopA(AF_INET6, &pAddr6->sin6_addr, m_pcRemoteIP, SOB_IP_LENGTH);
+			InetNtopW(AF_INET6, &pAddr6->sin6_addr, m_pwcRemoteIP, SOB_IP_LENGTH);
+
+			m_sRemotePort = ntohs(pAddr6->sin6_port);
+		}
+		else if (addrPeer.ss_family == AF_UNIX)
+		{
+			// UnixûеַͶ˿, ¼Զ·(δ󶨵ĿͻΪ)
+			SOCKADDR_UN* pAddrUnix = (SOCKADDR_UN*)&addrPeer;
+			memset(m_pcRemoteIP, 0, SOB_IP_LENGTH);
+			memset(m_pwcRemoteIP, 0, sizeof(m_pwcRemoteIP));
+			strncpy_s(m_pcRemoteIP, SOB_IP_LENGTH, pAddrUnix->sun_path, _TRUNCATE);
+
+			m_sRemotePort = 0;
+		}
+		else
+		{
+			SOCKADDR_IN* pAddr4 = (SOCKADDR_IN*)&addrPeer;
+			InetNtopA(AF_INET, &pAddr4->sin_addr, m_pcRemoteIP, SOB_IP_LENGTH);
+			InetNtopW(AF_INET, &pAddr4->sin_addr, m_pwcRemoteIP, SOB_IP_LENGTH);
 
-		m_sRemotePort = ntohs(addrPeer.sin_port);
+			m_sRemotePort = ntohs(pAddr4->sin_port);
+		}
 	}
 
 	return true;
@@ -260,6 +588,26 @@ bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketIsConnected() const
 	return m_bIsConnected;
 }
 
+// CRosaSocket ô䷽ʽ(TCP򱾻ڴ, ֮Bind/Listen/Accept/Connectշѡִ, Ӧô벻)
+bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSetTransport(int nTransport)
+{
+	if ((nTransport != SOB_TRANSPORT_TCP && nTransport != SOB_TRANSPORT_SHM) || m_socket != NULL || m_pShm != NULL)
+	{
+		m_nLastWSAError = WSAEINVAL;
+		return false;
+	}
+
+	m_nTransport = nTransport;
+
+	return true;
+}
+
+// CRosaSocket ȡ䷽ʽ
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketGetTransport() const
+{
+	return m_nTransport;
+}
+
 // CRosaSocket ɾSocketBase
 void ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketDestory()
 {
@@ -269,6 +617,25 @@ void ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketDestory()
 // CRosaSocket 󶨷˶˿
 bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketBindOnPort(USHORT uPort)
 {
+	// ڴ洫Զ˿ں
+	if (m_nTransport == SOB_TRANSPORT_SHM)
+	{
+		if (m_pShm == NULL)
+		{
+			m_pShm = new CRosaShmSocket();
+		}
+
+		m_sHostPort = uPort;
+
+		if (!m_pShm->CRosaShmSocketBindOnPort(uPort))
+		{
+			m_nLastWSAError = m_pShm->m_nLastError;
+			return false;
+		}
+
+		return true;
+	}
+
 	// socketЧ½Ϊ˿ظ
 	if (m_socket == NULL)
 	{
@@ -299,10 +666,15 @@ bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketBindOnPort(USHORT uPort)
 }
 
 // CRosaSocket ˶˿
-bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketListen()
+bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketListen(int nBacklog)
 {
+	if (m_nTransport == SOB_TRANSPORT_SHM)
+	{
+		return (m_pShm != NULL) && m_pShm->CRosaShmSocketListen(nBacklog);
+	}
+
 	// 
-	int nRet = listen(m_socket, 5);
+	int nRet = listen(m_socket, nBacklog);
 
 	// ΨһԭǶ˿ڱռ
 	if (nRet == SOCKET_ERROR)
@@ -317,6 +689,11 @@ bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketListen()
 // CRosaSocket տͻ
 bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketAccept(HANDLE_ACCEPT_THREAD pThreadFunc, HANDLE_ACCEPT_CALLBACK pCallback, DWORD dwUser, BOOL * pExitFlag, USHORT nLoopTimeOutSec)
 {
+	if (m_nTransport == SOB_TRANSPORT_SHM)
+	{
+		return AcceptShm(pThreadFunc, pCallback, dwUser, pExitFlag, nLoopTimeOutSec);
+	}
+
 	// ע¼
 	WSAResetEvent(m_SocketReadEvent);           // ֮ǰδ¼
 	WSAEventSelect(m_socket, m_SocketReadEvent, FD_ACCEPT | FD_CLOSE);
@@ -345,12 +722,13 @@ bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketAccept(HANDLE_ACCEPT_THREAD pTh
 					continue;
 				}
 
-				// ¼Զ̵ַ
-				SOCKADDR_IN addrRemote;
-				memset(&addrRemote, 0, sizeof(addrRemote));
-				int nAddrSize = sizeof(addrRemote);
+				// ¼Զ̵ַ(ַȽ, Unixַֻ)
+				SOCKADDR_STORAGE addrStorage;
+				memset(&addrStorage, 0, sizeof(addrStorage));
+				int nAddrSize = sizeof(addrStorage);
 
-				SOCKET sockRemote = accept(m_socket, (PSOCKADDR)&addrRemote, &nAddrSize);
+				SOCKET sockRemote = accept(m_socket, (PSOCKADDR)&addrStorage, &nAddrSize);
+				ROSA_TRACE(ROSA_TRACE_ACCEPT, sockRemote, (sockRemote == INVALID_SOCKET) ? WSAGetLastError() : 0);
 
 				// Ч
 				if (sockRemote == INVALID_SOCKET)
@@ -361,6 +739,17 @@ bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketAccept(HANDLE_ACCEPT_THREAD pTh
 					continue;
 				}
 
+				SOCKADDR_IN addrRemote;
+				memset(&addrRemote, 0, sizeof(addrRemote));
+				if (addrStorage.ss_family == AF_INET)
+				{
+					memcpy(&addrRemote, &addrStorage, sizeof(addrRemote));
+				}
+				else
+				{
+					addrRemote.sin_family = addrStorage.ss_family;
+				}
+
 				// ̺߳߳
 				if (pThreadFunc)
 				{
@@ -373,22 +762,41 @@ bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketAccept(HANDLE_ACCEPT_THREAD pTh
 					sClientInfo.Socket = sockRemote;
 					sClientInfo.SocketAddr = addrRemote;
 
+					IdleAdd(sockRemote);
+					FirstByteAdd(sockRemote);
+
 					hThread = (HANDLE)_beginthreadex(NULL, 0, pThreadFunc, (void*)(&sClientInfo), 0, &unThreadID);
 
+					// ̴߳ʧʱɱر, ͬʱƳʱǼ
+					if (hThread == NULL)
+					{
+						CRosaSocketCloseClient(sockRemote);
+						continue;
+					}
+
+					EnterCriticalSection(&m_csIdle);
 					m_mapAccept.insert(pair<int, HANDLE>(m_nAcceptCount++, hThread));
+					LeaveCriticalSection(&m_csIdle);
 
 					// ѾҪHANDLE
 					//CloseHandle(hThread);
 				}
 				else if (pCallback)		// صлص
 				{
+					IdleAdd(sockRemote);
+					FirstByteAdd(sockRemote);
 					pCallback(&addrRemote, sockRemote, dwUser);
 				}
 			}
 		}
 		else
 		{
-			// ȴʱ¿ʼ
+			// ȴʱѾ̺߳¿ʼ
+			if (m_dwIdleTimeOut > 0)
+			{
+				ReapAcceptThreads();
+			}
+
 			continue;
 		}
 	}
@@ -396,74 +804,518 @@ bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketAccept(HANDLE_ACCEPT_THREAD pTh
 	return true;
 }
 
-// CRosaSocket ͻ(ӦñȴҪһŰȫ)<ȫ>
-int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendOnce(SOCKET Socket, char * pSendBuffer, USHORT nTimeOutSec)
+// CRosaSocket ڴ洫(ԴSOB_SHM_SOCKET_TAGǵ׽ֵص, շݴתڴ, CRosaSocketCloseClientر)
+bool CRosaSocket::AcceptShm(HANDLE_ACCEPT_THREAD pThreadFunc, HANDLE_ACCEPT_CALLBACK pCallback, DWORD dwUser, BOOL * pExitFlag, USHORT nLoopTimeOutSec)
 {
-	bool bIsTimeOut = false;
+	if (m_pShm == NULL)
+	{
+		m_nLastWSAError = WSAEINVAL;
+		return false;
+	}
 
-	// ǰע¼
-	WSAResetEvent(m_SocketWriteEvent);
-	WSAEventSelect(Socket, m_SocketWriteEvent, FD_WRITE | FD_CLOSE);
+	while ((pExitFlag == NULL ? TRUE : !(*pExitFlag)))
+	{
+		CRosaShmSocket* pShmConn = m_pShm->CRosaShmSocketAcceptOne(nLoopTimeOutSec);
+		if (pShmConn == NULL)
+		{
+			if (m_pShm->m_nLastError != WAIT_TIMEOUT)
+			{
+				m_nLastWSAError = m_pShm->m_nLastError;
+				return false;
+			}
 
-	// Է
-	int nRet = send(Socket, pSendBuffer, (int)strlen(pSendBuffer), NULL);
+			// ȴʱѾ̺߳¿ʼ
+			if (m_dwIdleTimeOut > 0)
+			{
+				ReapAcceptThreads();
+			}
 
-	if (nRet == SOCKET_ERROR)
-	{
-		m_nLastWSAError = WSAGetLastError();
+			continue;
+		}
 
-		// 
-		if (m_nLastWSAError == WSAEWOULDBLOCK)
+		// Ƿﵽ(ڴѾ, ʱֱӹر)
+		if (m_nAcceptCount + 1 > m_sMaxCount)
 		{
-			DWORD dwRet = WSAWaitForMultipleEvents(1, &m_SocketWriteEvent, FALSE, nTimeOutSec * 1000, FALSE);
+			delete pShmConn;
+			continue;
+		}
 
-			// ¼
-			WSANETWORKEVENTS wsaEvents;
-			memset(&wsaEvents, 0, sizeof(wsaEvents));
+		EnterCriticalSection(&m_csShm);
+		SOCKET sockRemote = (SOCKET)((++m_ulShmNextID << 2) | SOB_SHM_SOCKET_TAG);
+		m_mapShm.insert(pair<SOCKET, CRosaShmSocket*>(sockRemote, pShmConn));
+		LeaveCriticalSection(&m_csShm);
 
-			if (dwRet == WSA_WAIT_EVENT_0)
-			{
-				WSAResetEvent(m_SocketWriteEvent);
-				WSAEnumNetworkEvents(Socket, m_SocketWriteEvent, &wsaEvents);
+		SOCKADDR_IN addrRemote;
+		memset(&addrRemote, 0, sizeof(addrRemote));
+		addrRemote.sin_family = AF_INET;
+		addrRemote.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
 
-				// ͿԽвûд
-				if ((wsaEvents.lNetworkEvents & FD_WRITE) &&
-					(wsaEvents.iErrorCode[FD_WRITE_BIT] == 0))
-				{
-					// ٴηı
-					nRet = (int)send(Socket, pSendBuffer, (int)strlen(pSendBuffer), NULL);
+		// ̺߳߳
+		if (pThreadFunc)
+		{
+			unsigned unThreadID;
+			S_CLIENTINFO sClientInfo = { 0 };
 
-					if (nRet > 0)
-					{
-						// ֽڴ0ͳɹ
-						return SOB_RET_OK;
-					}
-				}
-				else if ((wsaEvents.lNetworkEvents & FD_CLOSE) &&
-					(wsaEvents.iErrorCode[FD_CLOSE_BIT] == 0))
-				{
-					// ͻѾر
-					return SOB_RET_CLOSE;
-				}
-			}
-			else
+			sClientInfo.Socket = sockRemote;
+			sClientInfo.SocketAddr = addrRemote;
+
+			HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, pThreadFunc, (void*)(&sClientInfo), 0, &unThreadID);
+			if (hThread == NULL)
 			{
-				// ʱ
-				bIsTimeOut = true;
+				CRosaSocketCloseClient(sockRemote);
+				continue;
 			}
+
+			EnterCriticalSection(&m_csIdle);
+			m_mapAccept.insert(pair<int, HANDLE>(m_nAcceptCount++, hThread));
+			LeaveCriticalSection(&m_csIdle);
 		}
-		else
+		else if (pCallback)		// صлص
 		{
-
+			pCallback(&addrRemote, sockRemote, dwUser);
 		}
 	}
-	else
+
+	return true;
+}
+
+// CRosaSocket ҹڴ(ʵ׽ֲ, ٽ)
+CRosaShmSocket * CRosaSocket::ShmFind(SOCKET Socket)
+{
+	if ((Socket & SOB_SHM_SOCKET_TAG) != SOB_SHM_SOCKET_TAG)
 	{
-		// һα㷢ͳɹ
-		return SOB_RET_OK;
+		return NULL;
 	}
 
-	// ʱ
+	CThreadSafe ThreadSafe(&m_csShm);
+
+	map<SOCKET, CRosaShmSocket*>::iterator iter = m_mapShm.find(Socket);
+
+	return (iter != m_mapShm.end()) ? iter->second : NULL;
+}
+
+// CRosaSocket Ƭտͻ(ÿƬһ̰߳һԤͶAcceptExصڷƬִ߳; Ƭ쳣˳ʱfalse, CRosaSocketGetLastWSAError)
+bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketAcceptSharded(USHORT nShards, HANDLE_SHARD_ACCEPT_CALLBACK pCallback, DWORD dwUser, BOOL * pExitFlag, bool bSteerToRSS, USHORT nLoopTimeOutSec)
+{
+	if (pCallback == NULL || nShards == 0)
+	{
+		return false;
+	}
+
+	if (nShards > SOB_SHARD_MAX_COUNT)
+	{
+		nShards = SOB_SHARD_MAX_COUNT;
+	}
+
+	// ׽ָAcceptExգȡ¼ѡ
+	WSAEventSelect(m_socket, m_SocketReadEvent, 0);
+
+	// ȡAcceptExչ
+	LPFN_ACCEPTEX pfnAcceptEx = NULL;
+	LPFN_GETACCEPTEXSOCKADDRS pfnGetAcceptExSockaddrs = NULL;
+	GUID guidAcceptEx = WSAID_ACCEPTEX;
+	GUID guidGetAcceptExSockaddrs = WSAID_GETACCEPTEXSOCKADDRS;
+	DWORD dwBytes = 0;
+
+	if (WSAIoctl(m_socket, SIO_GET_EXTENSION_FUNCTION_POINTER, &guidAcceptEx, sizeof(guidAcceptEx), &pfnAcceptEx, sizeof(pfnAcceptEx), &dwBytes, NULL, NULL) == SOCKET_ERROR ||
+		WSAIoctl(m_socket, SIO_GET_EXTENSION_FUNCTION_POINTER, &guidGetAcceptExSockaddrs, sizeof(guidGetAcceptExSockaddrs), &pfnGetAcceptExSockaddrs, sizeof(pfnGetAcceptExSockaddrs), &dwBytes, NULL, NULL) == SOCKET_ERROR)
+	{
+		m_nLastWSAError = WSAGetLastError();
+		return false;
+	}
+
+	// (ֻʹõһ)
+	SYSTEM_INFO si;
+	GetSystemInfo(&si);
+
+	DWORD dwProcessors = si.dwNumberOfProcessors;
+	if (dwProcessors == 0)
+	{
+		dwProcessors = 1;
+	}
+	if (dwProcessors > sizeof(DWORD_PTR) * 8)
+	{
+		dwProcessors = sizeof(DWORD_PTR) * 8;
+	}
+
+	// ʼƬ
+	LPS_ACCEPTSHARD pShards = new S_ACCEPTSHARD[nShards];
+
+	for (USHORT i = 0; i < nShards; ++i)
+	{
+		pShards[i].pSocket = this;
+		pShards[i].nShard = i;
+		pShards[i].nShards = nShards;
+		pShards[i].dwProcessor = i % dwProcessors;
+		pShards[i].pCallback = pCallback;
+		pShards[i].dwUser = dwUser;
+		pShards[i].pExitFlag = pExitFlag;
+		pShards[i].bSteerToRSS = bSteerToRSS;
+		pShards[i].nLoopTimeOutSec = nLoopTimeOutSec;
+		pShards[i].bActive = true;
+		pShards[i].bFailed = false;
+		pShards[i].pfnAcceptEx = pfnAcceptEx;
+		pShards[i].pfnGetAcceptExSockaddrs = pfnGetAcceptExSockaddrs;
+		pShards[i].pShards = pShards;
+		pShards[i].hHandoffEvent = WSACreateEvent();
+		InitializeCriticalSection(&pShards[i].csHandoff);
+	}
+
+	// Ƭ߳
+	HANDLE hThreads[SOB_SHARD_MAX_COUNT] = { 0 };
+	DWORD dwThreads = 0;
+
+	for (USHORT i = 0; i < nShards; ++i)
+	{
+		unsigned unThreadID;
+		HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, OnAcceptShard, (void*)(&pShards[i]), 0, &unThreadID);
+
+		if (hThread)
+		{
+			hThreads[dwThreads++] = hThread;
+		}
+	}
+
+	// ȴȫƬ˳
+	if (dwThreads > 0)
+	{
+		WaitForMultipleObjects(dwThreads, hThreads, TRUE, INFINITE);
+	}
+
+	for (DWORD i = 0; i < dwThreads; ++i)
+	{
+		CloseHandle(hThreads[i]);
+	}
+
+	// ͷŷƬرδת
+	bool bFailed = false;
+
+	for (USHORT i = 0; i < nShards; ++i)
+	{
+		bFailed = bFailed || pShards[i].bFailed;
+
+		for (vector<S_CLIENTINFO>::iterator iter = pShards[i].vecHandoff.begin(); iter != pShards[i].vecHandoff.end(); ++iter)
+		{
+			closesocket(iter->Socket);
+		}
+
+		WSACloseEvent(pShards[i].hHandoffEvent);
+		DeleteCriticalSection(&pShards[i].csHandoff);
+	}
+
+	delete[] pShards;
+
+	return (dwThreads == nShards) && !bFailed;
+}
+
+// CRosaSocket Ƭ߳
+unsigned __stdcall CRosaSocket::OnAcceptShard(void * pParam)
+{
+	LPS_ACCEPTSHARD pShard = reinterpret_cast<LPS_ACCEPTSHARD>(pParam);
+	SOCKET sListen = pShard->pSocket->m_socket;
+
+	// 󶨴
+	SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << pShard->dwProcessor);
+
+	// ԤͶAcceptExһ¼ڽƬת
+	S_ACCEPTSLOT sSlots[SOB_SHARD_ACCEPT_DEPTH];
+	WSAEVENT hEvents[SOB_SHARD_ACCEPT_DEPTH + 1];
+	bool bRunning = true;
+
+	for (int i = 0; i < SOB_SHARD_ACCEPT_DEPTH; ++i)
+	{
+		memset(&sSlots[i], 0, sizeof(sSlots[i]));
+		sSlots[i].sAccept = INVALID_SOCKET;
+		sSlots[i].Overlapped.hEvent = WSACreateEvent();
+		hEvents[i] = sSlots[i].Overlapped.hEvent;
+	}
+
+	hEvents[SOB_SHARD_ACCEPT_DEPTH] = pShard->hHandoffEvent;
+
+	// ȴ
+	while (bRunning && (pShard->pExitFlag == NULL ? TRUE : !(*pShard->pExitFlag)))
+	{
+		// ͶݿеĲ(ԴʱʱԺԣ׽ʧЧʱƬ˳)
+		bool bIdle = false;
+
+		for (int i = 0; i < SOB_SHARD_ACCEPT_DEPTH; ++i)
+		{
+			if (sSlots[i].sAccept != INVALID_SOCKET || PostAcceptSlot(pShard, sListen, &sSlots[i]))
+			{
+				continue;
+			}
+
+			int nError = WSAGetLastError();
+			pShard->pSocket->m_nLastWSAError = nError;
+
+			if (nError == WSAENOTSOCK || nError == WSAEINVAL)
+			{
+				pShard->bFailed = true;
+				bRunning = false;
+				break;
+			}
+
+			bIdle = true;
+		}
+
+		if (!bRunning)
+		{
+			break;
+		}
+
+		DWORD dwRet = WSAWaitForMultipleEvents(SOB_SHARD_ACCEPT_DEPTH + 1, hEvents, FALSE, bIdle ? SOB_SHARD_RETRY_MSEC : pShard->nLoopTimeOutSec * 1000, FALSE);
+
+		if (dwRet == WSA_WAIT_TIMEOUT)
+		{
+			// ȴʱ¿ʼ
+			continue;
+		}
+
+		if (dwRet == WSA_WAIT_FAILED)
+		{
+			pShard->pSocket->m_nLastWSAError = WSAGetLastError();
+			pShard->bFailed = true;
+			break;
+		}
+
+		DWORD dwIndex = dwRet - WSA_WAIT_EVENT_0;
+
+		// Ƭת
+		if (dwIndex == SOB_SHARD_ACCEPT_DEPTH)
+		{
+			vector<S_CLIENTINFO> vecHandoff;
+
+			WSAResetEvent(pShard->hHandoffEvent);
+
+			EnterCriticalSection(&pShard->csHandoff);
+			vecHandoff.swap(pShard->vecHandoff);
+			LeaveCriticalSection(&pShard->csHandoff);
+
+			for (vector<S_CLIENTINFO>::iterator iter = vecHandoff.begin(); iter != vecHandoff.end(); ++iter)
+			{
+				pShard->pCallback(&iter->SocketAddr, iter->Socket, pShard->nShard, pShard->dwUser);
+			}
+
+			continue;
+		}
+
+		LPS_ACCEPTSLOT pSlot = &sSlots[dwIndex];
+		DWORD dwBytes = 0;
+		DWORD dwFlags = 0;
+
+		// еĲûеȴеAcceptEx
+		if (pSlot->sAccept == INVALID_SOCKET)
+		{
+			WSAResetEvent(pSlot->Overlapped.hEvent);
+			continue;
+		}
+
+		BOOL bRet = WSAGetOverlappedResult(sListen, &pSlot->Overlapped, &dwBytes, FALSE, &dwFlags);
+		SOCKET sockRemote = pSlot->sAccept;
+		pSlot->sAccept = INVALID_SOCKET;
+
+		// Ч(һͶ)
+		if (!bRet)
+		{
+			closesocket(sockRemote);
+			continue;
+		}
+
+		// ̳м׽ԣʹgetpeernameȺ
+		setsockopt(sockRemote, SOL_SOCKET, SO_UPDATE_ACCEPT_CONTEXT, (char*)&sListen, sizeof(sListen));
+
+		// ¼Զ̵ַ
+		SOCKADDR_IN addrRemote;
+		memset(&addrRemote, 0, sizeof(addrRemote));
+
+		SOCKADDR* pAddrLocal = NULL;
+		SOCKADDR* pAddrRemote = NULL;
+		int nLocalLen = 0;
+		int nRemoteLen = 0;
+
+		pShard->pfnGetAcceptExSockaddrs(pSlot->chAddrBuf, 0, sizeof(SOCKADDR_IN) + 16, sizeof(SOCKADDR_IN) + 16, &pAddrLocal, &nLocalLen, &pAddrRemote, &nRemoteLen);
+
+		if (pAddrRemote != NULL && nRemoteLen >= (int)sizeof(addrRemote))
+		{
+			memcpy(&addrRemote, pAddrRemote, sizeof(addrRemote));
+		}
+
+		// Ͷݣ֤ʼеȴеAcceptEx(ʧʱһ)
+		if (!PostAcceptSlot(pShard, sListen, pSlot))
+		{
+			pShard->pSocket->m_nLastWSAError = WSAGetLastError();
+		}
+
+		// ѯӵRSSת󶨸ôķƬ
+		USHORT nTarget = pShard->nShard;
+
+		if (pShard->bSteerToRSS)
+		{
+			SOCKET_PROCESSOR_AFFINITY spa;
+			memset(&spa, 0, sizeof(spa));
+
+			if (WSAIoctl(sockRemote, SIO_QUERY_RSS_PROCESSOR_INFO, NULL, 0, &spa, sizeof(spa), &dwBytes, NULL, NULL) == 0 && spa.Processor.Group == 0)
+			{
+				for (USHORT i = 0; i < pShard->nShards; ++i)
+				{
+					if (pShard->pShards[i].dwProcessor == spa.Processor.Number)
+					{
+						nTarget = i;
+						break;
+					}
+				}
+			}
+		}
+
+		// ĿƬѾ˳ʱڱƬ
+		bool bHandoff = false;
+
+		if (nTarget != pShard->nShard)
+		{
+			LPS_ACCEPTSHARD pTarget = &pShard->pShards[nTarget];
+			S_CLIENTINFO sClientInfo = { 0 };
+
+			sClientInfo.Socket = sockRemote;
+			sClientInfo.SocketAddr = addrRemote;
+
+			EnterCriticalSection(&pTarget->csHandoff);
+			if (pTarget->bActive)
+			{
+				pTarget->vecHandoff.push_back(sClientInfo);
+				bHandoff = true;
+			}
+			LeaveCriticalSection(&pTarget->csHandoff);
+
+			if (bHandoff)
+			{
+				WSASetEvent(pTarget->hHandoffEvent);
+			}
+		}
+
+		if (!bHandoff)
+		{
+			pShard->pCallback(&addrRemote, sockRemote, pShard->nShard, pShard->dwUser);
+		}
+	}
+
+	// ֹͣת쳣˳ʱת(˳ʱCRosaSocketAcceptShardedر)
+	vector<S_CLIENTINFO> vecHandoff;
+
+	EnterCriticalSection(&pShard->csHandoff);
+	pShard->bActive = false;
+	if (pShard->bFailed)
+	{
+		vecHandoff.swap(pShard->vecHandoff);
+	}
+	LeaveCriticalSection(&pShard->csHandoff);
+
+	for (vector<S_CLIENTINFO>::iterator iter = vecHandoff.begin(); iter != vecHandoff.end(); ++iter)
+	{
+		pShard->pCallback(&iter->SocketAddr, iter->Socket, pShard->nShard, pShard->dwUser);
+	}
+
+	// ȡδɵAcceptEx
+	for (int i = 0; i < SOB_SHARD_ACCEPT_DEPTH; ++i)
+	{
+		if (sSlots[i].sAccept != INVALID_SOCKET)
+		{
+			DWORD dwBytes = 0;
+			DWORD dwFlags = 0;
+
+			CancelIoEx((HANDLE)sListen, &sSlots[i].Overlapped);
+			WSAGetOverlappedResult(sListen, &sSlots[i].Overlapped, &dwBytes, TRUE, &dwFlags);
+			closesocket(sSlots[i].sAccept);
+		}
+
+		WSACloseEvent(sSlots[i].Overlapped.hEvent);
+	}
+
+	return 0;
+}
+
+// CRosaSocket ͻ(ӦñȴҪһŰȫ)<ȫ>
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendOnce(SOCKET Socket, char * pSendBuffer, USHORT nTimeOutSec)
+{
+	CRosaShmSocket* pShmConn = ShmFind(Socket);
+	if (pShmConn != NULL)
+	{
+		return pShmConn->CRosaShmSocketSendBuffer(pSendBuffer, (UINT)strlen(pSendBuffer), nTimeOutSec);
+	}
+
+	LONGLONG llStart = LatencyStart(ROSA_HISTOGRAM_OP_SEND);
+
+	bool bIsTimeOut = false;
+
+	// ǰע¼
+	WSAResetEvent(m_SocketWriteEvent);
+	WSAEventSelect(Socket, m_SocketWriteEvent, FD_WRITE | FD_CLOSE);
+
+	// Է
+	int nRet = send(Socket, pSendBuffer, (int)strlen(pSendBuffer), NULL);
+	ROSA_TRACE(ROSA_TRACE_SEND, Socket, nRet);
+
+	if (nRet == SOCKET_ERROR)
+	{
+		m_nLastWSAError = WSAGetLastError();
+
+		// 
+		if (m_nLastWSAError == WSAEWOULDBLOCK)
+		{
+			DWORD dwRet = WSAWaitForMultipleEvents(1, &m_SocketWriteEvent, FALSE, nTimeOutSec * 1000, FALSE);
+
+			// ¼
+			WSANETWORKEVENTS wsaEvents;
+			memset(&wsaEvents, 0, sizeof(wsaEvents));
+
+			if (dwRet == WSA_WAIT_EVENT_0)
+			{
+				WSAResetEvent(m_SocketWriteEvent);
+				WSAEnumNetworkEvents(Socket, m_SocketWriteEvent, &wsaEvents);
+
+				// ͿԽвûд
+				if ((wsaEvents.lNetworkEvents & FD_WRITE) &&
+					(wsaEvents.iErrorCode[FD_WRITE_BIT] == 0))
+				{
+					// ٴηı
+					nRet = (int)send(Socket, pSendBuffer, (int)strlen(pSendBuffer), NULL);
+					ROSA_TRACE(ROSA_TRACE_SEND, Socket, nRet);
+
+					if (nRet > 0)
+					{
+						// ֽڴ0ͳɹ
+						IdleTouch(Socket);
+						LatencyRecord(ROSA_HISTOGRAM_OP_SEND, llStart);
+						return SOB_RET_OK;
+					}
+				}
+				else if ((wsaEvents.lNetworkEvents & FD_CLOSE) &&
+					(wsaEvents.iErrorCode[FD_CLOSE_BIT] == 0))
+				{
+					// ͻѾر
+					CRosaSocketIdleRemove(Socket);
+					return SOB_RET_CLOSE;
+				}
+			}
+			else
+			{
+				// ʱ
+				bIsTimeOut = true;
+			}
+		}
+		else
+		{
+
+		}
+	}
+	else
+	{
+		// һα㷢ͳɹ
+		IdleTouch(Socket);
+		LatencyRecord(ROSA_HISTOGRAM_OP_SEND, llStart);
+		return SOB_RET_OK;
+	}
+
+	// ʱ
 	if (bIsTimeOut)
 	{
 		return SOB_RET_TIMEOUT;
@@ -478,6 +1330,14 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendOnce(SOCKET Socket, char * p
 // CRosaSocket ͻ(ӦñȴҪһŰȫ)<һ>
 int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendBuffer(SOCKET Socket, char * pSendBuffer, UINT uiBufferSize, USHORT nTimeOutSec)
 {
+	CRosaShmSocket* pShmConn = ShmFind(Socket);
+	if (pShmConn != NULL)
+	{
+		return pShmConn->CRosaShmSocketSendBuffer(pSendBuffer, uiBufferSize, nTimeOutSec);
+	}
+
+	LONGLONG llStart = LatencyStart(ROSA_HISTOGRAM_OP_SEND);
+
 	bool bIsTimeOut = false;
 
 	// ǰע¼
@@ -505,6 +1365,7 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendBuffer(SOCKET Socket, char *
 		}
 
 		int nRet = send(Socket, pcSentPos, uiLeftBuffer, NULL);
+		ROSA_TRACE(ROSA_TRACE_SEND, Socket, nRet);
 
 		if (nRet == SOCKET_ERROR)
 		{
@@ -530,6 +1391,7 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendBuffer(SOCKET Socket, char *
 					{
 						// ٴηı
 						nRet = send(Socket, pcSentPos, uiLeftBuffer, NULL);
+						ROSA_TRACE(ROSA_TRACE_SEND, Socket, nRet);
 
 						if (nRet > 0)
 						{
@@ -560,6 +1422,7 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendBuffer(SOCKET Socket, char *
 						(wsaEvents.iErrorCode[FD_CLOSE_BIT] == 0))
 					{
 						// ͻѾر
+						CRosaSocketIdleRemove(Socket);
 						return SOB_RET_CLOSE;
 					}
 				}
@@ -590,6 +1453,8 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendBuffer(SOCKET Socket, char *
 	// 
 	if (nSent == uiBufferSize)
 	{
+		IdleTouch(Socket);
+		LatencyRecord(ROSA_HISTOGRAM_OP_SEND, llStart);
 		return SOB_RET_OK;
 	}
 
@@ -608,6 +1473,14 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendBuffer(SOCKET Socket, char *
 // CRosaSocket ջ(ӦñȴҪһŰȫ)<ȫ>
 int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvOnce(SOCKET Socket, char * pRecvBuffer, UINT uiBufferSize, UINT & uiRecv, USHORT nTimeOutSec)
 {
+	CRosaShmSocket* pShmConn = ShmFind(Socket);
+	if (pShmConn != NULL)
+	{
+		return pShmConn->CRosaShmSocketRecvOnce(pRecvBuffer, uiBufferSize, uiRecv, nTimeOutSec);
+	}
+
+	LONGLONG llStart = LatencyStart(ROSA_HISTOGRAM_OP_RECV);
+
 	bool bIsTimeOut = false;
 
 	// ǰע¼
@@ -616,6 +1489,7 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvOnce(SOCKET Socket, char * p
 
 	// Խ
 	int nRet = recv(Socket, pRecvBuffer, uiBufferSize, NULL);
+	ROSA_TRACE(ROSA_TRACE_RECV, Socket, nRet);
 
 	if (nRet == SOCKET_ERROR)
 	{
@@ -641,11 +1515,15 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvOnce(SOCKET Socket, char * p
 				{
 					// ٴνı
 					nRet = recv(Socket, pRecvBuffer, uiBufferSize, NULL);
+					ROSA_TRACE(ROSA_TRACE_RECV, Socket, nRet);
 
 					if (nRet > 0)
 					{
 						// ֽڴ0ͳɹ
 						uiRecv = nRet;
+						IdleTouch(Socket);
+						LatencyRecord(ROSA_HISTOGRAM_OP_RECV, llStart);
+						FirstByteRecord(Socket);
 						return SOB_RET_OK;
 					}
 				}
@@ -653,6 +1531,7 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvOnce(SOCKET Socket, char * p
 					(wsaEvents.iErrorCode[FD_CLOSE_BIT] == 0))
 				{
 					// ͻѾر
+					CRosaSocketIdleRemove(Socket);
 					return SOB_RET_CLOSE;
 				}
 			}
@@ -669,6 +1548,9 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvOnce(SOCKET Socket, char * p
 	{
 		// һαճɹ
 		uiRecv = nRet;
+		IdleTouch(Socket);
+		LatencyRecord(ROSA_HISTOGRAM_OP_RECV, llStart);
+		FirstByteRecord(Socket);
 		return SOB_RET_OK;
 	}
 
@@ -687,6 +1569,14 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvOnce(SOCKET Socket, char * p
 // CRosaSocket ջ(ӦñȴҪһŰȫ)<һ>
 int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvBuffer(SOCKET Socket, char * pRecvBuffer, UINT uiBufferSize, UINT uiRecvSize, USHORT nTimeOutSec)
 {
+	CRosaShmSocket* pShmConn = ShmFind(Socket);
+	if (pShmConn != NULL)
+	{
+		return pShmConn->CRosaShmSocketRecvBuffer(pRecvBuffer, uiBufferSize, uiRecvSize, nTimeOutSec);
+	}
+
+	LONGLONG llStart = LatencyStart(ROSA_HISTOGRAM_OP_RECV);
+
 	bool bIsTimeOut = false;
 
 	// ǰע¼
@@ -713,6 +1603,7 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvBuffer(SOCKET Socket, char *
 		}
 
 		int nRet = recv(Socket, pcRecvPos, uiBufferSize, NULL);
+		ROSA_TRACE(ROSA_TRACE_RECV, Socket, nRet);
 
 		if (nRet == SOCKET_ERROR)
 		{
@@ -738,6 +1629,7 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvBuffer(SOCKET Socket, char *
 					{
 						// ٴν
 						nRet = recv(Socket, pcRecvPos, uiBufferSize, NULL);
+						ROSA_TRACE(ROSA_TRACE_RECV, Socket, nRet);
 
 						if (nRet > 0)
 						{
@@ -768,6 +1660,7 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvBuffer(SOCKET Socket, char *
 						(wsaEvents.iErrorCode[FD_CLOSE_BIT] == 0))
 					{
 						// ͻѾر
+						CRosaSocketIdleRemove(Socket);
 						return SOB_RET_CLOSE;
 					}
 				}
@@ -802,6 +1695,9 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvBuffer(SOCKET Socket, char *
 	// 
 	if (nReceived == uiRecvSize)
 	{
+		IdleTouch(Socket);
+		LatencyRecord(ROSA_HISTOGRAM_OP_RECV, llStart);
+		FirstByteRecord(Socket);
 		return SOB_RET_OK;
 	}
 
@@ -847,18 +1743,341 @@ void ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSetConnectCount(int nAcceptCoun
 	m_nAcceptCount = nAcceptCount;
 }
 
-// CRosaSocket ͷ(޲ñʾ)
-bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketConnect(const char * pcRemoteIP, USHORT sPort, USHORT nTimeOutSec)
+// CRosaSocket ÿгʱ(֮ܵӳdwIdleMSecûгɹշshutdown, ߳շʧ˳)
+bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSetIdleTimeOut(CRosaEventLoop * pLoop, DWORD dwIdleMSec)
 {
-	// socketЧ½Ϊ˿ظ
-	if (m_socket == NULL)
+	if (dwIdleMSec > 0 && pLoop == NULL)
 	{
-		m_socket = CreateTCPSocket();
+		return false;
 	}
 
-	// 趨ԶIP
-	SOCKADDR_IN addrRemote;
-	memset(&addrRemote, 0, sizeof(addrRemote));
+	map<ULONGLONG, LPS_IDLECONN> mapIdle;
+
+	EnterCriticalSection(&m_csIdle);
+	mapIdle.swap(m_mapIdle);
+	m_mapIdleSocket.clear();
+	CRosaEventLoop* pOldLoop = m_pIdleLoop;
+	m_pIdleLoop = pLoop;
+	m_dwIdleTimeOut = dwIdleMSec;
+	LeaveCriticalSection(&m_csIdle);
+
+	// ɵĶʱٽɾ(ɾʱܵȴʱص)
+	for (map<ULONGLONG, LPS_IDLECONN>::iterator iter = mapIdle.begin(); iter != mapIdle.end(); ++iter)
+	{
+		pOldLoop->CRosaEventLoopKillTimer(iter->second->ullTimerID);
+		delete iter->second;
+	}
+
+	return true;
+}
+
+// CRosaSocket ֹͣӵĿмʱ
+void ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketIdleRemove(SOCKET Socket)
+{
+	EnterCriticalSection(&m_csIdle);
+
+	// رǰûյݵӲֽںʱ
+	if (m_lFirstBytePending > 0 && m_mapFirstByte.erase(Socket) > 0)
+	{
+		InterlockedDecrement(&m_lFirstBytePending);
+	}
+
+	map<SOCKET, ULONGLONG>::iterator iterSocket = m_mapIdleSocket.find(Socket);
+	if (iterSocket == m_mapIdleSocket.end())
+	{
+		LeaveCriticalSection(&m_csIdle);
+		return;
+	}
+
+	map<ULONGLONG, LPS_IDLECONN>::iterator iter = m_mapIdle.find(iterSocket->second);
+	m_mapIdleSocket.erase(iterSocket);
+
+	if (iter == m_mapIdle.end())
+	{
+		LeaveCriticalSection(&m_csIdle);
+		return;
+	}
+
+	LPS_IDLECONN pConn = iter->second;
+	CRosaEventLoop* pLoop = m_pIdleLoop;
+	m_mapIdle.erase(iter);
+
+	LeaveCriticalSection(&m_csIdle);
+
+	pLoop->CRosaEventLoopKillTimer(pConn->ullTimerID);
+	delete pConn;
+}
+
+// CRosaSocket رսܵ(ǼرһƳ, ֵú󲻻µ)
+void ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketCloseClient(SOCKET Socket)
+{
+	CRosaSocketIdleRemove(Socket);
+
+	// ڴû׽־, ͷӶ
+	if ((Socket & SOB_SHM_SOCKET_TAG) == SOB_SHM_SOCKET_TAG)
+	{
+		CRosaShmSocket* pShmConn = NULL;
+
+		EnterCriticalSection(&m_csShm);
+
+		map<SOCKET, CRosaShmSocket*>::iterator iter = m_mapShm.find(Socket);
+		if (iter != m_mapShm.end())
+		{
+			pShmConn = iter->second;
+			m_mapShm.erase(iter);
+		}
+
+		LeaveCriticalSection(&m_csShm);
+
+		delete pShmConn;
+		return;
+	}
+
+	closesocket(Socket);
+}
+
+// CRosaSocket ȡмʱе
+UINT ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketGetIdleCount()
+{
+	CThreadSafe ThreadSafe(&m_csIdle);
+
+	return (UINT)m_mapIdle.size();
+}
+
+// CRosaSocket ʼмʱ(׽־ʱ滻ɵļʱ)
+void CRosaSocket::IdleAdd(SOCKET Socket)
+{
+	if (m_dwIdleTimeOut == 0)
+	{
+		return;
+	}
+
+	CRosaSocketIdleRemove(Socket);
+
+	LPS_IDLECONN pConn = new S_IDLECONN;
+	pConn->pSocket = this;
+	pConn->Socket = Socket;
+
+	// ¼Զ˵ַ, ʱʱݴȷϾûбӸ
+	pConn->nPeerLen = sizeof(pConn->addrPeer);
+	if (getpeername(Socket, (SOCKADDR*)&pConn->addrPeer, &pConn->nPeerLen) == SOCKET_ERROR)
+	{
+		pConn->nPeerLen = 0;
+	}
+
+	CThreadSafe ThreadSafe(&m_csIdle);
+
+	if (m_pIdleLoop == NULL)
+	{
+		delete pConn;
+		return;
+	}
+
+	pConn->ullConnID = ++m_ullIdleNextID;
+
+	// ٽãʱصֻڵǼ֮鵽
+	pConn->ullTimerID = m_pIdleLoop->CRosaEventLoopSetTimer(m_dwIdleTimeOut, 0, OnIdleTimeOut, pConn);
+	m_mapIdle[pConn->ullConnID] = pConn;
+	m_mapIdleSocket[Socket] = pConn->ullConnID;
+}
+
+// CRosaSocket շɹ¼ʱ(ʱŶ, ڴ)
+void CRosaSocket::IdleTouch(SOCKET Socket)
+{
+	if (m_dwIdleTimeOut == 0)
+	{
+		return;
+	}
+
+	CThreadSafe ThreadSafe(&m_csIdle);
+
+	map<SOCKET, ULONGLONG>::iterator iterSocket = m_mapIdleSocket.find(Socket);
+	if (iterSocket == m_mapIdleSocket.end())
+	{
+		return;
+	}
+
+	map<ULONGLONG, LPS_IDLECONN>::iterator iter = m_mapIdle.find(iterSocket->second);
+	if (iter != m_mapIdle.end())
+	{
+		m_pIdleLoop->CRosaEventLoopResetTimer(iter->second->ullTimerID, m_dwIdleTimeOut);
+	}
+}
+
+// CRosaSocket ¼ӵʱ(Ӻ, ״νճɹʱֽںʱ)
+void CRosaSocket::FirstByteAdd(SOCKET Socket)
+{
+	LONGLONG llStart = LatencyStart(ROSA_HISTOGRAM_OP_FIRSTBYTE);
+	if (llStart == 0)
+	{
+		return;
+	}
+
+	CThreadSafe ThreadSafe(&m_csIdle);
+
+	// ׽־ʱ滻ɵʱ
+	if (m_mapFirstByte.insert(pair<SOCKET, LONGLONG>(Socket, llStart)).second)
+	{
+		InterlockedIncrement(&m_lFirstBytePending);
+	}
+	else
+	{
+		m_mapFirstByte[Socket] = llStart;
+	}
+}
+
+// CRosaSocket ״νճɹ(ûеȴеʱٽ)
+void CRosaSocket::FirstByteRecord(SOCKET Socket)
+{
+	if (m_lFirstBytePending == 0)
+	{
+		return;
+	}
+
+	LONGLONG llStart = 0;
+
+	{
+		CThreadSafe ThreadSafe(&m_csIdle);
+
+		map<SOCKET, LONGLONG>::iterator iter = m_mapFirstByte.find(Socket);
+		if (iter == m_mapFirstByte.end())
+		{
+			return;
+		}
+
+		llStart = iter->second;
+		m_mapFirstByte.erase(iter);
+		InterlockedDecrement(&m_lFirstBytePending);
+	}
+
+	CRosaHistogram::CRosaHistogramRecordGlobal(ROSA_HISTOGRAM_OP_FIRSTBYTE, llStart, m_pHistogram[ROSA_HISTOGRAM_OP_FIRSTBYTE]);
+}
+
+// CRosaSocket ʼʱ(ûöͳȫͳδʱ0, ȡ)
+LONGLONG CRosaSocket::LatencyStart(int nOp) const
+{
+	if (m_pHistogram[nOp] == NULL && !CRosaHistogram::CRosaHistogramIsGlobalEnabled())
+	{
+		return 0;
+	}
+
+	return CRosaHistogram::CRosaHistogramNow();
+}
+
+// CRosaSocket ¼ʱͳƼȫͳ
+void CRosaSocket::LatencyRecord(int nOp, LONGLONG llStart) const
+{
+	CRosaHistogram::CRosaHistogramRecordGlobal(nOp, llStart, m_pHistogram[nOp]);
+}
+
+// CRosaSocket Ѿ߳̾
+void CRosaSocket::ReapAcceptThreads()
+{
+	CThreadSafe ThreadSafe(&m_csIdle);
+
+	for (map<int, HANDLE>::iterator iter = m_mapAccept.begin(); iter != m_mapAccept.end();)
+	{
+		if (iter->second != NULL && WaitForSingleObject(iter->second, 0) == WAIT_OBJECT_0)
+		{
+			CloseHandle(iter->second);
+			iter = m_mapAccept.erase(iter);
+		}
+		else
+		{
+			++iter;
+		}
+	}
+}
+
+// CRosaSocket гʱ(¼ѭʱִ߳)
+void __stdcall CRosaSocket::OnIdleTimeOut(ULONGLONG ullTimerID, void * pUser)
+{
+	LPS_IDLECONN pConn = reinterpret_cast<LPS_IDLECONN>(pUser);
+	CRosaSocket* pSocket = pConn->pSocket;
+	SOCKET Socket = pConn->Socket;
+	ULONGLONG ullConnID = pConn->ullConnID;
+
+	// ѾƳƳͷ(ӴŲ, ֵܾӰ)
+	EnterCriticalSection(&pSocket->m_csIdle);
+
+	map<ULONGLONG, LPS_IDLECONN>::iterator iter = pSocket->m_mapIdle.find(ullConnID);
+	if (iter == pSocket->m_mapIdle.end() || iter->second != pConn)
+	{
+		LeaveCriticalSection(&pSocket->m_csIdle);
+		return;
+	}
+
+	pSocket->m_mapIdle.erase(iter);
+
+	map<SOCKET, ULONGLONG>::iterator iterSocket = pSocket->m_mapIdleSocket.find(Socket);
+	if (iterSocket != pSocket->m_mapIdleSocket.end() && iterSocket->second == ullConnID)
+	{
+		pSocket->m_mapIdleSocket.erase(iterSocket);
+	}
+
+	LeaveCriticalSection(&pSocket->m_csIdle);
+
+	// Ӧùر׽ʱûƳǼ, ֵ: Զ˵ַһʱ
+	SOCKADDR_STORAGE addrPeer;
+	int nPeerLen = sizeof(addrPeer);
+	bool bSame = (getpeername(Socket, (SOCKADDR*)&addrPeer, &nPeerLen) != SOCKET_ERROR)
+		&& (nPeerLen == pConn->nPeerLen) && (memcmp(&addrPeer, &pConn->addrPeer, nPeerLen) == 0);
+
+	delete pConn;
+
+	if (!bSame)
+	{
+		return;
+	}
+
+	// رվ(߳ʹ)ֹֻշеĵȴ֮ضϿ
+	shutdown(Socket, SD_BOTH);
+
+	pSocket->ReapAcceptThreads();
+}
+
+// CRosaSocket ͷ(޲ñʾ)
+bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketConnect(const char * pcRemoteIP, USHORT sPort, USHORT nTimeOutSec)
+{
+	LONGLONG llStart = LatencyStart(ROSA_HISTOGRAM_OP_CONNECT);
+
+	// ڴ洫ֻӱ(ַTCPͬ, ֻл)
+	if (m_nTransport == SOB_TRANSPORT_SHM)
+	{
+		if (pcRemoteIP != NULL && sPort != 0)
+		{
+			memset(m_pcRemoteIP, 0, SOB_IP_LENGTH);
+			strcpy(m_pcRemoteIP, pcRemoteIP);
+
+			m_sRemotePort = sPort;
+		}
+
+		if (m_pShm == NULL)
+		{
+			m_pShm = new CRosaShmSocket();
+		}
+
+		m_bIsConnected = m_pShm->CRosaShmSocketIsConnected() || m_pShm->CRosaShmSocketConnect(m_pcRemoteIP, m_sRemotePort, nTimeOutSec);
+		if (!m_bIsConnected)
+		{
+			m_nLastWSAError = m_pShm->m_nLastError;
+			return false;
+		}
+
+		LatencyRecord(ROSA_HISTOGRAM_OP_CONNECT, llStart);
+
+		return true;
+	}
+
+	// socketЧ½Ϊ˿ظ
+	if (m_socket == NULL)
+	{
+		m_socket = CreateTCPSocket();
+	}
+
+	// 趨ԶIP
+	SOCKADDR_IN addrRemote;
+	memset(&addrRemote, 0, sizeof(addrRemote));
 
 	// Ҫ²ʾõǰIP
 	if (pcRemoteIP != NULL && sPort != 0)
@@ -867,18 +2086,35 @@ bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketConnect(const char * pcRemoteIP
 		strcpy(m_pcRemoteIP, pcRemoteIP);
 
 		m_sRemotePort = sPort;
+		m_bUnixClient = false;
 	}
 
 	addrRemote.sin_family = AF_INET;
 	addrRemote.sin_addr.S_un.S_addr = inet_addr(m_pcRemoteIP);
 	addrRemote.sin_port = htons(m_sRemotePort);
 
+	if (!ConnectAddr((SOCKADDR*)&addrRemote, sizeof(addrRemote), nTimeOutSec))
+	{
+		return false;
+	}
+
+	LatencyRecord(ROSA_HISTOGRAM_OP_CONNECT, llStart);
+
+	// ؽ
+	return m_bIsConnected;
+}
+
+// CRosaSocket ַָ(TCPUnix, ʧʱر׽)
+bool CRosaSocket::ConnectAddr(const SOCKADDR * pAddr, int nAddrLen, USHORT nTimeOutSec)
+{
+	m_bIsConnected = false;
+
 	// ע¼
 	WSAResetEvent(m_SocketWriteEvent);           // ֮ǰδ¼
 	WSAEventSelect(m_socket, m_SocketWriteEvent, FD_CONNECT | FD_CLOSE);
 
 	// 
-	int nRet = connect(m_socket, (SOCKADDR*)&addrRemote, sizeof(addrRemote));
+	int nRet = connect(m_socket, pAddr, nAddrLen);
 
 	if (nRet == SOCKET_ERROR)
 	{
@@ -898,28 +2134,16 @@ bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketConnect(const char * pcRemoteIP
 				WSAResetEvent(m_SocketWriteEvent);
 				WSAEnumNetworkEvents(m_socket, m_SocketWriteEvent, &wsaEvents);
 
-				// ӽܲûд
-				if ((wsaEvents.lNetworkEvents & FD_CONNECT) &&
-					(wsaEvents.iErrorCode[FD_CONNECT_BIT] == 0))
+				// FD_CONNECTЯӽٴεconnect
+				if (wsaEvents.lNetworkEvents & FD_CONNECT)
 				{
-					// ʵʵĵԾңͣ٣ᱨ˷ѽ10022
-					// ͬһsocketconnect̫̿ǲе,Magic Number50ʵĽSleep(1)һʱƬƺ
-					Sleep(50);
-					nRet = connect(m_socket, (SOCKADDR*)&addrRemote, sizeof(addrRemote));
-
-					if (nRet == SOCKET_ERROR)
+					if (wsaEvents.iErrorCode[FD_CONNECT_BIT] == 0)
 					{
-						m_nLastWSAError = WSAGetLastError();
-
-						// ʵѾ
-						if (m_nLastWSAError == WSAEISCONN)
-						{
-							m_bIsConnected = true;
-						}
+						m_bIsConnected = true;
 					}
-					else    // ӳɹ
+					else
 					{
-						m_bIsConnected = true;
+						m_nLastWSAError = wsaEvents.iErrorCode[FD_CONNECT_BIT];
 					}
 				}
 			}
@@ -943,23 +2167,32 @@ bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketConnect(const char * pcRemoteIP
 		m_socket = NULL;
 	}
 
-	// ؽ
 	return m_bIsConnected;
 }
 
 // CRosaSocket ӷ
 bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketReConnect()
 {
+	// ӽFD_CONNECTϿ(ӵʹCRosaReConnector)
 	CRosaSocketDisConnect();
 
-	Sleep(100);
-
-	return CRosaSocketConnect();
+	return m_bUnixClient ? CRosaSocketUnixConnect() : CRosaSocketConnect();
 }
 
 // CRosaSocket Ͽ
 void ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketDisConnect()
 {
+	if (m_nTransport == SOB_TRANSPORT_SHM)
+	{
+		if (m_pShm != NULL)
+		{
+			m_pShm->CRosaShmSocketDisConnect();
+		}
+
+		m_bIsConnected = false;
+		return;
+	}
+
 	if (m_socket == NULL)
 	{
 		return;
@@ -973,6 +2206,9 @@ void ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketDisConnect()
 		m_bIsConnected = false;
 	}
 
+	// ӺЭ
+	CRosaSocketCompressRemove(m_socket);
+
 	closesocket(m_socket);
 	m_socket = NULL;
 }
@@ -980,6 +2216,13 @@ void ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketDisConnect()
 // CRosaSocket ͻ(ӦñȴҪһŰȫ)<ȫ>
 int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendOnce(char * pSendBuffer, USHORT nTimeOutSec)
 {
+	if (m_nTransport == SOB_TRANSPORT_SHM)
+	{
+		return (m_pShm != NULL) ? m_pShm->CRosaShmSocketSendBuffer(pSendBuffer, (UINT)strlen(pSendBuffer), nTimeOutSec) : SOB_RET_FAIL;
+	}
+
+	LONGLONG llStart = LatencyStart(ROSA_HISTOGRAM_OP_SEND);
+
 	bool bIsTimeOut = false;
 
 	// ״̬
@@ -994,6 +2237,7 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendOnce(char * pSendBuffer, USH
 
 	// Է
 	int nRet = send(m_socket, pSendBuffer, (int)strlen(pSendBuffer), NULL);
+	ROSA_TRACE(ROSA_TRACE_SEND, m_socket, nRet);
 
 	if (nRet == SOCKET_ERROR)
 	{
@@ -1019,10 +2263,12 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendOnce(char * pSendBuffer, USH
 				{
 					// ٴηı
 					nRet = (int)send(m_socket, pSendBuffer, (int)strlen(pSendBuffer), NULL);
+					ROSA_TRACE(ROSA_TRACE_SEND, m_socket, nRet);
 
 					if (nRet > 0)
 					{
 						// ֽڴ0ͳɹ
+						LatencyRecord(ROSA_HISTOGRAM_OP_SEND, llStart);
 						return SOB_RET_OK;
 					}
 				}
@@ -1047,6 +2293,7 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendOnce(char * pSendBuffer, USH
 	else
 	{
 		// һα㷢ͳɹ
+		LatencyRecord(ROSA_HISTOGRAM_OP_SEND, llStart);
 		return SOB_RET_OK;
 	}
 
@@ -1065,6 +2312,13 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendOnce(char * pSendBuffer, USH
 // CRosaSocket ͻ(ӦñȴҪһŰȫ)<һ>
 int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendBuffer(char * pSendBuffer, UINT uiBufferSize, USHORT nTimeOutSec)
 {
+	if (m_nTransport == SOB_TRANSPORT_SHM)
+	{
+		return (m_pShm != NULL) ? m_pShm->CRosaShmSocketSendBuffer(pSendBuffer, uiBufferSize, nTimeOutSec) : SOB_RET_FAIL;
+	}
+
+	LONGLONG llStart = LatencyStart(ROSA_HISTOGRAM_OP_SEND);
+
 	bool bIsTimeOut = false;
 
 	// ״̬
@@ -1098,6 +2352,7 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendBuffer(char * pSendBuffer, U
 		}
 
 		int nRet = send(m_socket, pcSentPos, uiLeftBuffer, NULL);
+		ROSA_TRACE(ROSA_TRACE_SEND, m_socket, nRet);
 
 		if (nRet == SOCKET_ERROR)
 		{
@@ -1123,6 +2378,7 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendBuffer(char * pSendBuffer, U
 					{
 						// ٴηı
 						nRet = send(m_socket, pcSentPos, uiLeftBuffer, NULL);
+						ROSA_TRACE(ROSA_TRACE_SEND, m_socket, nRet);
 
 						if (nRet > 0)
 						{
@@ -1184,6 +2440,7 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendBuffer(char * pSendBuffer, U
 	// 
 	if (nSent == uiBufferSize)
 	{
+		LatencyRecord(ROSA_HISTOGRAM_OP_SEND, llStart);
 		return SOB_RET_OK;
 	}
 
@@ -1202,6 +2459,13 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendBuffer(char * pSendBuffer, U
 // CRosaSocket ջ(ӦñȴҪһŰȫ)<ȫ>
 int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvOnce(char * pRecvBuffer, UINT uiBufferSize, UINT & uiRecv, USHORT nTimeOutSec)
 {
+	if (m_nTransport == SOB_TRANSPORT_SHM)
+	{
+		return (m_pShm != NULL) ? m_pShm->CRosaShmSocketRecvOnce(pRecvBuffer, uiBufferSize, uiRecv, nTimeOutSec) : SOB_RET_FAIL;
+	}
+
+	LONGLONG llStart = LatencyStart(ROSA_HISTOGRAM_OP_RECV);
+
 	bool bIsTimeOut = false;
 
 	// ״̬
@@ -1216,6 +2480,7 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvOnce(char * pRecvBuffer, UIN
 
 	// Խ
 	int nRet = recv(m_socket, pRecvBuffer, uiBufferSize, NULL);
+	ROSA_TRACE(ROSA_TRACE_RECV, m_socket, nRet);
 
 	if (nRet == SOCKET_ERROR)
 	{
@@ -1241,11 +2506,13 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvOnce(char * pRecvBuffer, UIN
 				{
 					// ٴνı
 					nRet = recv(m_socket, pRecvBuffer, uiBufferSize, NULL);
+					ROSA_TRACE(ROSA_TRACE_RECV, m_socket, nRet);
 
 					if (nRet > 0)
 					{
 						// ֽڴ0ͳɹ
 						uiRecv = nRet;
+						LatencyRecord(ROSA_HISTOGRAM_OP_RECV, llStart);
 						return SOB_RET_OK;
 					}
 				}
@@ -1270,6 +2537,7 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvOnce(char * pRecvBuffer, UIN
 	{
 		// һαճɹ
 		uiRecv = nRet;
+		LatencyRecord(ROSA_HISTOGRAM_OP_RECV, llStart);
 		return SOB_RET_OK;
 	}
 
@@ -1288,6 +2556,13 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvOnce(char * pRecvBuffer, UIN
 // CRosaSocket ջ(ӦñȴҪһŰȫ)<һ>
 int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvBuffer(char * pRecvBuffer, UINT uiBufferSize, UINT uiRecvSize, USHORT nTimeOutSec)
 {
+	if (m_nTransport == SOB_TRANSPORT_SHM)
+	{
+		return (m_pShm != NULL) ? m_pShm->CRosaShmSocketRecvBuffer(pRecvBuffer, uiBufferSize, uiRecvSize, nTimeOutSec) : SOB_RET_FAIL;
+	}
+
+	LONGLONG llStart = LatencyStart(ROSA_HISTOGRAM_OP_RECV);
+
 	bool bIsTimeOut = false;
 
 	// ״̬
@@ -1320,6 +2595,7 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvBuffer(char * pRecvBuffer, U
 		}
 
 		int nRet = recv(m_socket, pcRecvPos, uiBufferSize, NULL);
+		ROSA_TRACE(ROSA_TRACE_RECV, m_socket, nRet);
 
 		if (nRet == SOCKET_ERROR)
 		{
@@ -1345,6 +2621,7 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvBuffer(char * pRecvBuffer, U
 					{
 						// ٴν
 						nRet = recv(m_socket, pcRecvPos, uiBufferSize, NULL);
+						ROSA_TRACE(ROSA_TRACE_RECV, m_socket, nRet);
 
 						if (nRet > 0)
 						{
@@ -1411,6 +2688,7 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvBuffer(char * pRecvBuffer, U
 	// 
 	if (nReceived == uiRecvSize)
 	{
+		LatencyRecord(ROSA_HISTOGRAM_OP_RECV, llStart);
 		return SOB_RET_OK;
 	}
 
@@ -1426,236 +2704,1497 @@ int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvBuffer(char * pRecvBuffer, U
 	return SOB_RET_FAIL;
 }
 
-// CRosaSocket UDP˿
-bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketUDPBindOnPort(const char * pcRemoteIP, UINT uiPort)
+// CRosaSocket ļ()
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendFile(SOCKET Socket, const char * pcFileName, ULONGLONG ullOffset, ULONGLONG ullLength, USHORT nTimeOutSec)
 {
-	// socketЧ½Ϊ˿ظ
-	if (m_socket == NULL)
+	// ˳ȡʾϵͳӴԤļɻֱӽЭջûڴ
+	HANDLE hFile = CreateFileA(pcFileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
 	{
-		m_socket = CreateUDPSocket();
+		m_nLastWSAError = GetLastError();
+		return SOB_RET_FAIL;
 	}
 
-	// ؼ
-	SOCKADDR_IN addrLocal;
-	memset(&addrLocal, 0, sizeof(addrLocal));
-
-	addrLocal.sin_family = AF_INET;
-	addrLocal.sin_addr.s_addr = inet_addr(pcRemoteIP);
-	addrLocal.sin_port = htons(uiPort);
-
-	// 
-	int nRet = bind(m_socket, (PSOCKADDR)&addrLocal, sizeof(addrLocal));
+	LARGE_INTEGER liFileSize;
+	if (!GetFileSizeEx(hFile, &liFileSize) || ullOffset > (ULONGLONG)liFileSize.QuadPart)
+	{
+		m_nLastWSAError = GetLastError();
+		CloseHandle(hFile);
+		return SOB_RET_FAIL;
+	}
 
-	// ΨһԭǶ˿ڱռ
-	if (nRet == SOCKET_ERROR)
+	// Ϊ0Խļĩβʱ͵ĩβ
+	ULONGLONG ullLeft = (ULONGLONG)liFileSize.QuadPart - ullOffset;
+	if (ullLength == 0 || ullLength > ullLeft)
 	{
-		m_nLastWSAError = WSAGetLastError();
-		return false;
+		ullLength = ullLeft;
 	}
-	m_bIsConnected = true;
 
-	return true;
+	int nRet = TransmitFileRange(Socket, hFile, ullOffset, ullLength, nTimeOutSec);
+
+	CloseHandle(hFile);
+
+	return nRet;
 }
 
-// CRosaSocket ͻ(UDP)
-int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketUDPSendBuffer(const char * pcIP, SHORT sPort, char * pBuffer, UINT uiBufferSize, USHORT nTimeOutSec)
+// CRosaSocket ļ(ͻ)
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendFile(const char * pcFileName, ULONGLONG ullOffset, ULONGLONG ullLength, USHORT nTimeOutSec)
 {
-	if (m_socket == NULL)
+	// ״̬
+	if (!m_bIsConnected)
 	{
-		m_socket = CreateUDPSocket();
+		return SOB_RET_FAIL;
 	}
 
-	bool bIsTimeOut = false;
-
-	// 
-	int nSent = 0;
+	int nRet = CRosaSocketSendFile(m_socket, pcFileName, ullOffset, ullLength, nTimeOutSec);
+
+	if (nRet == SOB_RET_CLOSE)
+	{
+		m_bIsConnected = false;
+	}
+
+	return nRet;
+}
+
+// CRosaSocket 㿽ʹ黺()<ͶصWSASend, SO_SNDBUFΪ0ʱЭջֱû>
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendZeroCopy(SOCKET Socket, const char * pSendBuffer, UINT uiBufferSize, USHORT nTimeOutSec)
+{
+	WSAEVENT hEvent = WSACreateEvent();
+	if (hEvent == WSA_INVALID_EVENT)
+	{
+		m_nLastWSAError = WSAGetLastError();
+		return SOB_RET_FAIL;
+	}
+
+	int nRet = SOB_RET_OK;
+	UINT uiSent = 0;
+
+	while (uiSent < uiBufferSize)
+	{
+		UINT uiChunk = min(uiBufferSize - uiSent, (UINT)SOB_BULK_CHUNK_SIZE);
+
+		WSABUF wsaBuf;
+		wsaBuf.buf = (char*)pSendBuffer + uiSent;
+		wsaBuf.len = uiChunk;
+
+		// ¼λ1׽ֹɶ˿ʱͶɰ
+		WSAOVERLAPPED Overlapped;
+		memset(&Overlapped, 0, sizeof(Overlapped));
+		Overlapped.hEvent = (WSAEVENT)((DWORD_PTR)hEvent | 1);
+		WSAResetEvent(hEvent);
+
+		DWORD dwSent = 0;
+		if (WSASend(Socket, &wsaBuf, 1, NULL, 0, &Overlapped, NULL) == SOCKET_ERROR && WSAGetLastError() != WSA_IO_PENDING)
+		{
+			m_nLastWSAError = WSAGetLastError();
+			nRet = TranslateSendError(m_nLastWSAError);
+			break;
+		}
+
+		nRet = WaitOverlappedSend(Socket, &Overlapped, dwSent, nTimeOutSec);
+		if (nRet != SOB_RET_OK)
+		{
+			break;
+		}
+
+		uiSent += dwSent;
+	}
+
+	WSACloseEvent(hEvent);
+
+	return nRet;
+}
+
+// CRosaSocket 㿽ʹ黺(ͻ)
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendZeroCopy(const char * pSendBuffer, UINT uiBufferSize, USHORT nTimeOutSec)
+{
+	// ״̬
+	if (!m_bIsConnected)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	int nRet = CRosaSocketSendZeroCopy(m_socket, pSendBuffer, uiBufferSize, nTimeOutSec);
+
+	if (nRet == SOB_RET_CLOSE)
+	{
+		m_bIsConnected = false;
+	}
+
+	return nRet;
+}
+
+// CRosaSocket 㿽ʹ黺(, ɺص)
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendZeroCopyAsync(SOCKET Socket, const char * pSendBuffer, UINT uiBufferSize, HANDLE_SEND_COMPLETE_CALLBACK pCallback, DWORD_PTR dwUser)
+{
+	if (pCallback == NULL)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	LPS_ZEROCOPYSEND pSend = new S_ZEROCOPYSEND;
+	memset(&pSend->Overlapped, 0, sizeof(pSend->Overlapped));
+	pSend->hEvent = WSACreateEvent();
+	pSend->Socket = Socket;
+	pSend->hWait = NULL;
+	pSend->nRef = 2;
+	pSend->pSendBuffer = pSendBuffer;
+	pSend->uiBufferSize = uiBufferSize;
+	pSend->pCallback = pCallback;
+	pSend->dwUser = dwUser;
+
+	if (pSend->hEvent == WSA_INVALID_EVENT)
+	{
+		m_nLastWSAError = WSAGetLastError();
+		delete pSend;
+		return SOB_RET_FAIL;
+	}
+
+	// ¼λ1׽ֹɶ˿ʱͶɰ
+	pSend->Overlapped.hEvent = (WSAEVENT)((DWORD_PTR)pSend->hEvent | 1);
+
+	WSABUF wsaBuf;
+	wsaBuf.buf = (char*)pSendBuffer;
+	wsaBuf.len = uiBufferSize;
+
+	if (WSASend(Socket, &wsaBuf, 1, NULL, 0, &pSend->Overlapped, NULL) == SOCKET_ERROR && WSAGetLastError() != WSA_IO_PENDING)
+	{
+		m_nLastWSAError = WSAGetLastError();
+		WSACloseEvent(pSend->hEvent);
+		delete pSend;
+		return SOB_RET_FAIL;
+	}
+
+	// ¼̳߳صȴصڱǰִ
+	if (!RegisterWaitForSingleObject(&pSend->hWait, pSend->hEvent, OnZeroCopyComplete, pSend, INFINITE, WT_EXECUTEONLYONCE))
+	{
+		// ޷עȴʱͬȴɺص֤ص岻
+		m_nLastWSAError = GetLastError();
+		pSend->hWait = NULL;
+		WaitForSingleObject(pSend->hEvent, INFINITE);
+		OnZeroCopyComplete(pSend, FALSE);
+	}
+
+	ReleaseZeroCopySend(pSend);
+
+	return SOB_RET_OK;
+}
+
+// CRosaSocket 㿽ʹ黺(ͻ, ɺص)
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendZeroCopyAsync(const char * pSendBuffer, UINT uiBufferSize, HANDLE_SEND_COMPLETE_CALLBACK pCallback, DWORD_PTR dwUser)
+{
+	// ״̬
+	if (!m_bIsConnected)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	return CRosaSocketSendZeroCopyAsync(m_socket, pSendBuffer, uiBufferSize, pCallback, dwUser);
+}
+
+// CRosaSocket ЭӵϢѹ()<˸һ֡ٽնԶ˵֡, ȡ˫ģʽĽС, ֵIDͬʱʹֵ>
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketNegotiateCompress(SOCKET Socket, int nMode, const char * pDict, UINT uiDictSize, USHORT nTimeOutSec)
+{
+	if (nMode < ROSA_COMPRESS_MODE_NONE || nMode > ROSA_COMPRESS_MODE_STREAM)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	DWORD dwDictID = CRosaCompress::CRosaCompressDictID(pDict, uiDictSize);
+
+	S_COMPRESSHEADER sHello;
+	CRosaCompress::CRosaCompressMakeHeader(sHello, ROSA_COMPRESS_FLAG_HELLO, (DWORD)nMode, dwDictID);
+
+	int nRet = CRosaSocketSendBuffer(Socket, (char*)&sHello, sizeof(sHello), nTimeOutSec);
+	if (nRet != SOB_RET_OK)
+	{
+		return nRet;
+	}
+
+	// ֻ֡֡ͷ, ֡ͷȽղ֮Ϣ
+	S_COMPRESSHEADER sPeerHello;
+	nRet = CRosaSocketRecvBuffer(Socket, (char*)&sPeerHello, sizeof(sPeerHello), sizeof(sPeerHello), nTimeOutSec);
+	if (nRet != SOB_RET_OK)
+	{
+		return nRet;
+	}
+
+	if (!CRosaCompress::CRosaCompressCheckHeader(sPeerHello) || !(sPeerHello.byFlags & ROSA_COMPRESS_FLAG_HELLO))
+	{
+		return SOB_RET_FAIL;
+	}
+
+	bool bUseDict = false;
+	int nAgree = CRosaCompress::CRosaCompressAgree(nMode, dwDictID, sPeerHello, bUseDict);
+
+	CRosaCompress* pCompress = NULL;
+	if (nAgree != ROSA_COMPRESS_MODE_NONE)
+	{
+		pCompress = new CRosaCompress;
+		pCompress->CRosaCompressCreate(nAgree, bUseDict ? pDict : NULL, bUseDict ? uiDictSize : 0);
+	}
+
+	// Эʱ滻ɵ״̬
+	CRosaSocketCompressRemove(Socket);
+
+	if (pCompress != NULL)
+	{
+		CThreadSafe ThreadSafe(&m_csCompress);
+		m_mapCompress[Socket] = pCompress;
+	}
+
+	return SOB_RET_OK;
+}
+
+// CRosaSocket ЭӵϢѹ(ͻ)
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketNegotiateCompress(int nMode, const char * pDict, UINT uiDictSize, USHORT nTimeOutSec)
+{
+	// ״̬
+	if (!m_bIsConnected)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	int nRet = CRosaSocketNegotiateCompress(m_socket, nMode, pDict, uiDictSize, nTimeOutSec);
+
+	if (nRet == SOB_RET_CLOSE)
+	{
+		m_bIsConnected = false;
+	}
+
+	return nRet;
+}
+
+// CRosaSocket ȡЭ̽
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketGetCompressMode(SOCKET Socket)
+{
+	CRosaCompress* pCompress = CompressFind(Socket);
+
+	return (pCompress != NULL) ? pCompress->CRosaCompressGetMode() : ROSA_COMPRESS_MODE_NONE;
+}
+
+// CRosaSocket ȡӵѹͳ
+bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketGetCompressStats(SOCKET Socket, S_COMPRESSSTATS & sStats, bool bReset)
+{
+	CThreadSafe ThreadSafe(&m_csCompress);
+
+	map<SOCKET, CRosaCompress*>::iterator iter = m_mapCompress.find(Socket);
+	if (iter == m_mapCompress.end())
+	{
+		memset(&sStats, 0, sizeof(sStats));
+		return false;
+	}
+
+	iter->second->CRosaCompressGetStats(sStats, bReset);
+
+	return true;
+}
+
+// CRosaSocket ͷӵѹ״̬(û߳շӵϢ)
+void ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketCompressRemove(SOCKET Socket)
+{
+	CRosaCompress* pCompress = NULL;
+
+	EnterCriticalSection(&m_csCompress);
+
+	map<SOCKET, CRosaCompress*>::iterator iter = m_mapCompress.find(Socket);
+	if (iter != m_mapCompress.end())
+	{
+		pCompress = iter->second;
+		m_mapCompress.erase(iter);
+	}
+
+	LeaveCriticalSection(&m_csCompress);
+
+	if (pCompress != NULL)
+	{
+		delete pCompress;
+	}
+}
+
+// CRosaSocket һϢ()<֡ͷ+һη, Эʱѹ, СԭʼȲʹѹ>
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendMessage(SOCKET Socket, const char * pMessage, UINT uiSize, USHORT nTimeOutSec)
+{
+	if (uiSize > ROSA_COMPRESS_MAX_MESSAGE)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	CRosaCompress* pCompress = CompressFind(Socket);
+	if (pCompress != NULL)
+	{
+		UINT uiFrameSize = 0;
+		const char* pFrame = pCompress->CRosaCompressEncodeFrame(pMessage, uiSize, uiFrameSize);
+
+		return CRosaSocketSendBuffer(Socket, const_cast<char*>(pFrame), uiFrameSize, nTimeOutSec);
+	}
+
+	// δЭѹʱֻ֡ͷ
+	vector<char> vecFrame(sizeof(S_COMPRESSHEADER) + uiSize);
+	CRosaCompress::CRosaCompressMakeHeader(*reinterpret_cast<LPS_COMPRESSHEADER>(&vecFrame[0]), 0, uiSize, uiSize);
+
+	if (uiSize > 0)
+	{
+		memcpy(&vecFrame[sizeof(S_COMPRESSHEADER)], pMessage, uiSize);
+	}
+
+	return CRosaSocketSendBuffer(Socket, &vecFrame[0], (UINT)vecFrame.size(), nTimeOutSec);
+}
+
+// CRosaSocket һϢ(ͻ)
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketSendMessage(const char * pMessage, UINT uiSize, USHORT nTimeOutSec)
+{
+	// ״̬
+	if (!m_bIsConnected)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	int nRet = CRosaSocketSendMessage(m_socket, pMessage, uiSize, nTimeOutSec);
+
+	if (nRet == SOB_RET_CLOSE)
+	{
+		m_bIsConnected = false;
+	}
+
+	return nRet;
+}
+
+// CRosaSocket һϢ()<Ƚ֡ͷ, δѹĸֱӽյû; ʧ߽ܺ֡Ѷʧ, ر>
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvMessage(SOCKET Socket, char * pBuffer, UINT uiBufferSize, UINT & uiRecv, USHORT nTimeOutSec)
+{
+	uiRecv = 0;
+
+	S_COMPRESSHEADER sHeader;
+	int nRet = CRosaSocketRecvBuffer(Socket, (char*)&sHeader, sizeof(sHeader), sizeof(sHeader), nTimeOutSec);
+	if (nRet != SOB_RET_OK)
+	{
+		return nRet;
+	}
+
+	if (!CRosaCompress::CRosaCompressCheckHeader(sHeader) || (sHeader.byFlags & ROSA_COMPRESS_FLAG_HELLO) || sHeader.dwRawSize > uiBufferSize)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	CRosaCompress* pCompress = CompressFind(Socket);
+	char* pData = pBuffer;
+
+	if (sHeader.byFlags & ROSA_COMPRESS_FLAG_COMPRESSED)
+	{
+		if (pCompress == NULL)
+		{
+			return SOB_RET_FAIL;
+		}
+
+		pData = pCompress->CRosaCompressGetDecodeBuffer(sHeader.dwDataSize);
+	}
+
+	if (sHeader.dwDataSize > 0)
+	{
+		nRet = CRosaSocketRecvBuffer(Socket, pData, sHeader.dwDataSize, sHeader.dwDataSize, nTimeOutSec);
+		if (nRet != SOB_RET_OK)
+		{
+			return nRet;
+		}
+	}
+
+	// ģʽδѹϢͬʷ
+	if (pCompress != NULL && pCompress->CRosaCompressDecodeFrame(sHeader, pData, pBuffer, uiBufferSize) < 0)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	uiRecv = sHeader.dwRawSize;
+
+	return SOB_RET_OK;
+}
+
+// CRosaSocket һϢ(ͻ)
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketRecvMessage(char * pBuffer, UINT uiBufferSize, UINT & uiRecv, USHORT nTimeOutSec)
+{
+	// ״̬
+	if (!m_bIsConnected)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	int nRet = CRosaSocketRecvMessage(m_socket, pBuffer, uiBufferSize, uiRecv, nTimeOutSec);
+
+	if (nRet == SOB_RET_CLOSE)
+	{
+		m_bIsConnected = false;
+	}
+
+	return nRet;
+}
+
+// CRosaSocket ӵѹ״̬(շڼ䲻ᱻͷ, ͷɵڹرʱ)
+CRosaCompress * CRosaSocket::CompressFind(SOCKET Socket)
+{
+	CThreadSafe ThreadSafe(&m_csCompress);
+
+	map<SOCKET, CRosaCompress*>::iterator iter = m_mapCompress.find(Socket);
+
+	return (iter != m_mapCompress.end()) ? iter->second : NULL;
+}
+
+// CRosaSocket ֶεTransmitFileļ(εó, ֶҲʹʱȼ)
+int CRosaSocket::TransmitFileRange(SOCKET Socket, HANDLE hFile, ULONGLONG ullOffset, ULONGLONG ullLength, USHORT nTimeOutSec)
+{
+	// ȡTransmitFileչ(ÿεʱMswsockҷṩ)
+	if (m_pfnTransmitFile == NULL)
+	{
+		GUID guidTransmitFile = WSAID_TRANSMITFILE;
+		DWORD dwBytes = 0;
+
+		if (WSAIoctl(Socket, SIO_GET_EXTENSION_FUNCTION_POINTER, &guidTransmitFile, sizeof(guidTransmitFile), &m_pfnTransmitFile, sizeof(m_pfnTransmitFile), &dwBytes, NULL, NULL) == SOCKET_ERROR)
+		{
+			m_nLastWSAError = WSAGetLastError();
+			m_pfnTransmitFile = NULL;
+			return SOB_RET_FAIL;
+		}
+	}
+
+	WSAEVENT hEvent = WSACreateEvent();
+	if (hEvent == WSA_INVALID_EVENT)
+	{
+		m_nLastWSAError = WSAGetLastError();
+		return SOB_RET_FAIL;
+	}
+
+	int nRet = SOB_RET_OK;
+
+	while (ullLength > 0)
+	{
+		DWORD dwChunk = (DWORD)min(ullLength, (ULONGLONG)SOB_BULK_CHUNK_SIZE);
+
+		// ļƫصṹ
+		WSAOVERLAPPED Overlapped;
+		memset(&Overlapped, 0, sizeof(Overlapped));
+		Overlapped.Offset = (DWORD)(ullOffset & 0xFFFFFFFF);
+		Overlapped.OffsetHigh = (DWORD)(ullOffset >> 32);
+		Overlapped.hEvent = (WSAEVENT)((DWORD_PTR)hEvent | 1);
+		WSAResetEvent(hEvent);
+
+		DWORD dwSent = 0;
+		if (!m_pfnTransmitFile(Socket, hFile, dwChunk, 0, &Overlapped, NULL, TF_USE_KERNEL_APC) && WSAGetLastError() != WSA_IO_PENDING)
+		{
+			m_nLastWSAError = WSAGetLastError();
+			nRet = TranslateSendError(m_nLastWSAError);
+			break;
+		}
+
+		nRet = WaitOverlappedSend(Socket, &Overlapped, dwSent, nTimeOutSec);
+		if (nRet != SOB_RET_OK)
+		{
+			break;
+		}
+
+		// ļضʱTransmitFileǰ
+		if (dwSent == 0)
+		{
+			nRet = SOB_RET_FAIL;
+			break;
+		}
+
+		ullOffset += dwSent;
+		ullLength -= min((ULONGLONG)dwSent, ullLength);
+	}
+
+	WSACloseEvent(hEvent);
+
+	return nRet;
+}
+
+// CRosaSocket ȴص(ʱʱȡȴȡ, صṹſͷ)
+int CRosaSocket::WaitOverlappedSend(SOCKET Socket, LPWSAOVERLAPPED pOverlapped, DWORD & dwSent, USHORT nTimeOutSec)
+{
+	WSAEVENT hEvent = (WSAEVENT)((DWORD_PTR)pOverlapped->hEvent & ~(DWORD_PTR)1);
+	DWORD dwFlags = 0;
+	bool bIsTimeOut = false;
+
+	dwSent = 0;
+
+	if (WSAWaitForMultipleEvents(1, &hEvent, FALSE, nTimeOutSec * 1000, FALSE) != WSA_WAIT_EVENT_0)
+	{
+		bIsTimeOut = true;
+		CancelIoEx((HANDLE)Socket, pOverlapped);
+	}
+
+	if (!WSAGetOverlappedResult(Socket, pOverlapped, &dwSent, TRUE, &dwFlags))
+	{
+		m_nLastWSAError = WSAGetLastError();
+
+		if (bIsTimeOut && m_nLastWSAError == WSA_OPERATION_ABORTED)
+		{
+			return SOB_RET_TIMEOUT;
+		}
+
+		return TranslateSendError(m_nLastWSAError);
+	}
+
+	// ȡ֮ǰǡ
+	return SOB_RET_OK;
+}
+
+// CRosaSocket 㿽(̳߳صȴص)
+void __stdcall CRosaSocket::OnZeroCopyComplete(PVOID pParam, BOOLEAN bTimedOut)
+{
+	LPS_ZEROCOPYSEND pSend = (LPS_ZEROCOPYSEND)pParam;
+
+	DWORD dwSent = 0;
+	DWORD dwFlags = 0;
+	int nResult = SOB_RET_OK;
+
+	if (!WSAGetOverlappedResult(pSend->Socket, &pSend->Overlapped, &dwSent, FALSE, &dwFlags))
+	{
+		nResult = TranslateSendError(WSAGetLastError());
+	}
+	else if (dwSent != pSend->uiBufferSize)
+	{
+		nResult = SOB_RET_FAIL;
+	}
+
+	pSend->pCallback(pSend->pSendBuffer, dwSent, nResult, pSend->dwUser);
+
+	ReleaseZeroCopySend(pSend);
+}
+
+// CRosaSocket UDP˿
+bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketUDPBindOnPort(const char * pcRemoteIP, UINT uiPort)
+{
+	// socketЧ½Ϊ˿ظ
+	if (m_socket == NULL)
+	{
+		m_socket = CreateUDPSocket();
+	}
+
+	// ؼ
+	SOCKADDR_IN addrLocal;
+	memset(&addrLocal, 0, sizeof(addrLocal));
+
+	addrLocal.sin_family = AF_INET;
+	addrLocal.sin_addr.s_addr = inet_addr(pcRemoteIP);
+	addrLocal.sin_port = htons(uiPort);
+
+	// 
+	int nRet = bind(m_socket, (PSOCKADDR)&addrLocal, sizeof(addrLocal));
+
+	// ΨһԭǶ˿ڱռ
+	if (nRet == SOCKET_ERROR)
+	{
+		m_nLastWSAError = WSAGetLastError();
+		return false;
+	}
+	m_bIsConnected = true;
+
+	return true;
+}
+
+// CRosaSocket ͻ(UDP)
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketUDPSendBuffer(const char * pcIP, SHORT sPort, char * pBuffer, UINT uiBufferSize, USHORT nTimeOutSec)
+{
+	if (m_socket == NULL)
+	{
+		m_socket = CreateUDPSocket();
+	}
+
+	bool bIsTimeOut = false;
+
+	// 
+	int nSent = 0;
 
 	// ܷʹΪʹһ޶
 	int nSendTimes = 0;
 	int nSendLimitTimes = nTimeOutSec * 1000 / 100;						// ȴ100msط
 	UINT uiLeftBuffer = uiBufferSize;									// δĻС
 
-	// תԶ̵ַ
-	SOCKADDR_IN addrRemote;
-	memset(&addrRemote, 0, sizeof(addrRemote));
+	// תԶ̵ַ
+	SOCKADDR_IN addrRemote;
+	memset(&addrRemote, 0, sizeof(addrRemote));
+
+	addrRemote.sin_family = AF_INET;
+	addrRemote.sin_addr.s_addr = inet_addr(pcIP);
+	addrRemote.sin_port = htons(sPort);
+
+	// α
+	char* pcSentPos = pBuffer;
+
+	// ֱеĻ嶼
+	while (nSent < (int)uiBufferSize)
+	{
+		// 鷢ʹǷ
+		if (nSendTimes > nSendLimitTimes)
+		{
+			bIsTimeOut = true;
+			break;
+		}
+
+		int nRet = sendto(m_socket, pcSentPos, uiLeftBuffer, NULL, (PSOCKADDR)&addrRemote, sizeof(addrRemote));
+		ROSA_TRACE(ROSA_TRACE_SEND, m_socket, nRet);
+
+		if (nRet == SOCKET_ERROR)
+		{
+			m_nLastWSAError = WSAGetLastError();
+			break;
+		}
+		else
+		{
+			// ͳɹۼӷα
+			nSendTimes++;
+
+			nSent += nRet;
+			uiLeftBuffer -= nRet;
+			pcSentPos += nRet;
+		}
+	}
+
+	// 
+	if (nSent == uiBufferSize)
+	{
+		return SOB_RET_OK;
+	}
+
+	// ʱ
+	if (bIsTimeOut)
+	{
+		return SOB_RET_TIMEOUT;
+	}
+
+	// ûܳɹ
+	m_nLastWSAError = WSAGetLastError();
+
+	return SOB_RET_FAIL;
+}
+
+// CRosaSocket ջ(UDP)
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketUDPRecvBuffer(char * pBuffer, UINT uiBufferSize, UINT & uiRecv, char * pcIP, USHORT & uPort, USHORT nTimeOutSec)
+{
+	bool bIsTimeOut = false;
+
+	// ǰע¼
+	WSAResetEvent(m_SocketReadEvent);
+	WSAEventSelect(m_socket, m_SocketReadEvent, FD_READ);
+
+	// ԶϢ
+	SOCKADDR_IN addrRemote;
+	int nAddrLen = sizeof(addrRemote);
+	memset(&addrRemote, 0, nAddrLen);
+
+	// Խ
+	int nRet = recvfrom(m_socket, pBuffer, uiBufferSize, NULL, (PSOCKADDR)&addrRemote, &nAddrLen);
+	ROSA_TRACE(ROSA_TRACE_RECV, m_socket, nRet);
+
+	if (nRet == SOCKET_ERROR)
+	{
+		m_nLastWSAError = WSAGetLastError();
+
+		// 
+		if (m_nLastWSAError == WSAEWOULDBLOCK)
+		{
+			DWORD dwRet = WSAWaitForMultipleEvents(1, &m_SocketReadEvent, FALSE, nTimeOutSec * 1000, FALSE);
+
+			// ¼
+			WSANETWORKEVENTS wsaEvents;
+			memset(&wsaEvents, 0, sizeof(wsaEvents));
+
+			if (dwRet == WSA_WAIT_EVENT_0)
+			{
+				WSAResetEvent(m_SocketReadEvent);
+				int nEnum = WSAEnumNetworkEvents(m_socket, m_SocketReadEvent, &wsaEvents);
+
+				// ܿԽвûд
+				if ((wsaEvents.lNetworkEvents & FD_READ) &&
+					(wsaEvents.iErrorCode[FD_READ_BIT] == 0))
+				{
+					// ٴνı
+					nRet = recvfrom(m_socket, pBuffer, uiBufferSize, NULL, (PSOCKADDR)&addrRemote, &nAddrLen);
+					ROSA_TRACE(ROSA_TRACE_RECV, m_socket, nRet);
+
+					if (nRet > 0)
+					{
+						// ֽڴ0ճɹ
+						uiRecv = nRet;
+
+						// IPͶ˿
+						strcpy(pcIP, inet_ntoa(addrRemote.sin_addr));
+						uPort = ntohs(addrRemote.sin_port);
+
+						return SOB_RET_OK;
+					}
+				}
+				else if ((wsaEvents.lNetworkEvents & FD_CLOSE) &&
+					(wsaEvents.iErrorCode[FD_CLOSE_BIT] == 0))
+				{
+					// Ѿر
+					return SOB_RET_CLOSE;
+				}
+			}
+			else
+			{
+				bIsTimeOut = true;
+			}
+		}
+	}
+	else
+	{
+		// һαճɹ
+		uiRecv = nRet;
+
+		// IPͶ˿
+		strcpy(pcIP, inet_ntoa(addrRemote.sin_addr));
+		uPort = ntohs(addrRemote.sin_port);
+
+		return SOB_RET_OK;
+	}
+
+	// ʱ
+	if (bIsTimeOut)
+	{
+		return SOB_RET_TIMEOUT;
+	}
+
+	// ʧ
+	m_nLastWSAError = WSAGetLastError();
+
+	return SOB_RET_FAIL;
+}
+
+// CRosaSocket ÷ֶη/ϲж(UDP)<ں˲֧ʱfalseԶ˻շ>
+bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketUDPSetOffload(bool bSendOffload, bool bRecvOffload, USHORT sSegmentSize)
+{
+	if (m_socket == NULL)
+	{
+		m_socket = CreateUDPSocket();
+	}
+
+	m_sUDPSegmentSize = sSegmentSize;
+
+	// ֶηж: һ̽ں֧֣㣬ֻʱϢֶδС
+	DWORD dwValue = sSegmentSize;
+	m_bUDPSendOffload = false;
+
+	if (bSendOffload && sSegmentSize > 0)
+	{
+		if (setsockopt(m_socket, IPPROTO_UDP, UDP_SEND_MSG_SIZE, (char*)&dwValue, sizeof(dwValue)) == SOCKET_ERROR)
+		{
+			m_nLastWSAError = WSAGetLastError();
+		}
+		else
+		{
+			m_bUDPSendOffload = true;
+		}
+
+		dwValue = 0;
+		setsockopt(m_socket, IPPROTO_UDP, UDP_SEND_MSG_SIZE, (char*)&dwValue, sizeof(dwValue));
+	}
+
+	// ϲж: ҪWSARecvMsgȡغϲϢӦʹCRosaSocketUDPRecvBatch
+	if (bRecvOffload && m_pfnWSARecvMsg == NULL)
+	{
+		GUID guidWSARecvMsg = WSAID_WSARECVMSG;
+		DWORD dwBytes = 0;
+
+		if (WSAIoctl(m_socket, SIO_GET_EXTENSION_FUNCTION_POINTER, &guidWSARecvMsg, sizeof(guidWSARecvMsg), &m_pfnWSARecvMsg, sizeof(m_pfnWSARecvMsg), &dwBytes, NULL, NULL) == SOCKET_ERROR)
+		{
+			m_nLastWSAError = WSAGetLastError();
+			m_pfnWSARecvMsg = NULL;
+		}
+	}
+
+	dwValue = (bRecvOffload && m_pfnWSARecvMsg != NULL) ? SOB_UDP_OFFLOAD_MAX_BYTES : 0;
+	m_bUDPRecvOffload = false;
+
+	if (setsockopt(m_socket, IPPROTO_UDP, UDP_RECV_MAX_COALESCED_SIZE, (char*)&dwValue, sizeof(dwValue)) == SOCKET_ERROR)
+	{
+		m_nLastWSAError = WSAGetLastError();
+	}
+	else
+	{
+		m_bUDPRecvOffload = (dwValue != 0);
+	}
+
+	return (m_bUDPSendOffload == bSendOffload) && (m_bUDPRecvOffload == bRecvOffload);
+}
+
+// CRosaSocket ȡֶηж״̬(UDP)
+bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketUDPIsSendOffload() const
+{
+	return m_bUDPSendOffload;
+}
+
+// CRosaSocket ȡϲж״̬(UDP)
+bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketUDPIsRecvOffload() const
+{
+	return m_bUDPRecvOffload;
+}
+
+// CRosaSocket ݱ(UDP)<尴sSegmentSizeзΪݱһԽ϶; sSegmentSizeΪ0ʱʹжʱķֶδС>
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketUDPSendBatch(const char * pcIP, USHORT sPort, char * pBuffer, UINT uiBufferSize, USHORT sSegmentSize, USHORT nTimeOutSec)
+{
+	if (m_socket == NULL)
+	{
+		m_socket = CreateUDPSocket();
+	}
+
+	// δֶָδСʱʹCRosaSocketUDPSetOffloadõķֶδС
+	if (sSegmentSize == 0)
+	{
+		sSegmentSize = m_sUDPSegmentSize;
+	}
+
+	if (sSegmentSize == 0)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	bool bIsTimeOut = false;
+
+	// תԶ̵ַ
+	SOCKADDR_IN addrRemote;
+	memset(&addrRemote, 0, sizeof(addrRemote));
+
+	addrRemote.sin_family = AF_INET;
+	addrRemote.sin_addr.s_addr = inet_addr(pcIP);
+	addrRemote.sin_port = htons(sPort);
+
+	// жط͵󳤶(ֶδС)
+	UINT uiBatchLimit = (SOB_UDP_OFFLOAD_MAX_BYTES / sSegmentSize) * sSegmentSize;
+	if (uiBatchLimit > (UINT)sSegmentSize * SOB_UDP_OFFLOAD_MAX_SEGMENTS)
+	{
+		uiBatchLimit = (UINT)sSegmentSize * SOB_UDP_OFFLOAD_MAX_SEGMENTS;
+	}
+
+	// 
+	UINT uiSent = 0;
+
+	// α
+	char* pcSentPos = pBuffer;
+
+	// ֱеĻ嶼
+	while (uiSent < uiBufferSize)
+	{
+		UINT uiLeftBuffer = uiBufferSize - uiSent;
+		int nRet = SOCKET_ERROR;
+		DWORD dwBytes = 0;
+
+		if (m_bUDPSendOffload && uiLeftBuffer > sSegmentSize && uiBatchLimit > 0)
+		{
+			// һϵͳ÷ͶֶΣЭջз
+			WSABUF wsaBuf;
+			wsaBuf.buf = pcSentPos;
+			wsaBuf.len = (uiLeftBuffer > uiBatchLimit) ? uiBatchLimit : uiLeftBuffer;
+
+			char chControl[WSA_CMSG_SPACE(sizeof(DWORD))];
+			memset(chControl, 0, sizeof(chControl));
+
+			WSAMSG wsaMsg;
+			memset(&wsaMsg, 0, sizeof(wsaMsg));
+			wsaMsg.name = (LPSOCKADDR)&addrRemote;
+			wsaMsg.namelen = sizeof(addrRemote);
+			wsaMsg.lpBuffers = &wsaBuf;
+			wsaMsg.dwBufferCount = 1;
+			wsaMsg.Control.buf = chControl;
+			wsaMsg.Control.len = sizeof(chControl);
+
+			WSACMSGHDR* pCmsg = WSA_CMSG_FIRSTHDR(&wsaMsg);
+			pCmsg->cmsg_level = IPPROTO_UDP;
+			pCmsg->cmsg_type = UDP_SEND_MSG_SIZE;
+			pCmsg->cmsg_len = WSA_CMSG_LEN(sizeof(DWORD));
+			*(DWORD*)WSA_CMSG_DATA(pCmsg) = sSegmentSize;
+
+			nRet = WSASendMsg(m_socket, &wsaMsg, 0, &dwBytes, NULL, NULL);
+			ROSA_TRACE(ROSA_TRACE_SEND, m_socket, (nRet == SOCKET_ERROR) ? SOCKET_ERROR : (LONG)dwBytes);
+
+			if (nRet == SOCKET_ERROR)
+			{
+				m_nLastWSAError = WSAGetLastError();
+
+				// Эջֶܷжأ˻
+				if (m_nLastWSAError == WSAEINVAL || m_nLastWSAError == WSAENOPROTOOPT || m_nLastWSAError == WSAEOPNOTSUPP)
+				{
+					m_bUDPSendOffload = false;
+					continue;
+				}
+			}
+			else
+			{
+				nRet = (int)dwBytes;
+			}
+		}
+		else
+		{
+			// 
+			nRet = sendto(m_socket, pcSentPos, (uiLeftBuffer > sSegmentSize) ? sSegmentSize : uiLeftBuffer, NULL, (PSOCKADDR)&addrRemote, sizeof(addrRemote));
+			ROSA_TRACE(ROSA_TRACE_SEND, m_socket, nRet);
+
+			if (nRet == SOCKET_ERROR)
+			{
+				m_nLastWSAError = WSAGetLastError();
+			}
+		}
+
+		if (nRet == SOCKET_ERROR)
+		{
+			// (׽Ѿע¼)ȴд
+			if (m_nLastWSAError == WSAEWOULDBLOCK)
+			{
+				WSAResetEvent(m_SocketWriteEvent);
+				WSAEventSelect(m_socket, m_SocketWriteEvent, FD_WRITE);
+
+				DWORD dwRet = WSAWaitForMultipleEvents(1, &m_SocketWriteEvent, FALSE, nTimeOutSec * 1000, FALSE);
+
+				if (dwRet == WSA_WAIT_EVENT_0)
+				{
+					WSAResetEvent(m_SocketWriteEvent);
+					continue;
+				}
+
+				// ʱ
+				bIsTimeOut = true;
+			}
+
+			break;
+		}
+
+		// ͳɹۼӷα
+		uiSent += nRet;
+		pcSentPos += nRet;
+	}
+
+	// 
+	if (uiSent == uiBufferSize)
+	{
+		return SOB_RET_OK;
+	}
+
+	// ʱ
+	if (bIsTimeOut)
+	{
+		return SOB_RET_TIMEOUT;
+	}
+
+	return SOB_RET_FAIL;
+}
+
+// CRosaSocket ݱ(UDP)<ϲյĻΪݱpDatagramsָpBufferڲ; ɲʱSOB_RET_FAILҴΪWSAEMSGSIZE, uiDatagramsΪõݱ>
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketUDPRecvBatch(char * pBuffer, UINT uiBufferSize, S_UDPDATAGRAM * pDatagrams, UINT uiMaxDatagrams, UINT & uiDatagrams, char * pcIP, USHORT & uPort, USHORT nTimeOutSec)
+{
+	bool bIsTimeOut = false;
+	bool bIsRecv = false;
+	bool bIsTruncated = false;
+
+	uiDatagrams = 0;
+
+	// ǰע¼
+	WSAResetEvent(m_SocketReadEvent);
+	WSAEventSelect(m_socket, m_SocketReadEvent, FD_READ);
+
+	// ԶϢ
+	SOCKADDR_IN addrRemote;
+	UINT uiRecv = 0;
+	UINT uiSegmentSize = 0;
+
+	// Խ
+	int nRet = RecvUDPMessage(pBuffer, uiBufferSize, &addrRemote, uiRecv, uiSegmentSize);
+
+	if (nRet == SOCKET_ERROR)
+	{
+		m_nLastWSAError = WSAGetLastError();
+
+		// ݳڻ(յĲȻַ)
+		if (m_nLastWSAError == WSAEMSGSIZE && uiRecv > 0)
+		{
+			bIsRecv = true;
+			bIsTruncated = true;
+		}
+
+		// 
+		if (m_nLastWSAError == WSAEWOULDBLOCK)
+		{
+			DWORD dwRet = WSAWaitForMultipleEvents(1, &m_SocketReadEvent, FALSE, nTimeOutSec * 1000, FALSE);
+
+			// ¼
+			WSANETWORKEVENTS wsaEvents;
+			memset(&wsaEvents, 0, sizeof(wsaEvents));
+
+			if (dwRet == WSA_WAIT_EVENT_0)
+			{
+				WSAResetEvent(m_SocketReadEvent);
+				WSAEnumNetworkEvents(m_socket, m_SocketReadEvent, &wsaEvents);
+
+				// ܿԽвûд
+				if ((wsaEvents.lNetworkEvents & FD_READ) &&
+					(wsaEvents.iErrorCode[FD_READ_BIT] == 0))
+				{
+					// ٴν
+					nRet = RecvUDPMessage(pBuffer, uiBufferSize, &addrRemote, uiRecv, uiSegmentSize);
+					bIsTruncated = (nRet == SOCKET_ERROR && WSAGetLastError() == WSAEMSGSIZE);
+					bIsRecv = ((nRet != SOCKET_ERROR || bIsTruncated) && uiRecv > 0);
+				}
+			}
+			else
+			{
+				bIsTimeOut = true;
+			}
+		}
+	}
+	else
+	{
+		// һαճɹ
+		bIsRecv = true;
+	}
+
+	// ʱ
+	if (bIsTimeOut)
+	{
+		return SOB_RET_TIMEOUT;
+	}
+
+	if (!bIsRecv)
+	{
+		// ʧ
+		m_nLastWSAError = WSAGetLastError();
+		return SOB_RET_FAIL;
+	}
+
+	// ûкϲϢʾֻյһݱ
+	if (uiSegmentSize == 0 || uiSegmentSize > uiRecv)
+	{
+		uiSegmentSize = uiRecv;
+	}
+
+	// ֶδС֣һݱԽ϶
+	char* pcRecvPos = pBuffer;
+	UINT uiLeft = uiRecv;
+
+	while (uiLeft > 0 && uiDatagrams < uiMaxDatagrams)
+	{
+		UINT uiSize = (uiLeft > uiSegmentSize) ? uiSegmentSize : uiLeft;
+
+		pDatagrams[uiDatagrams].pBuffer = pcRecvPos;
+		pDatagrams[uiDatagrams].uiSize = uiSize;
+		uiDatagrams++;
+
+		pcRecvPos += uiSize;
+		uiLeft -= uiSize;
+	}
+
+	// IPͶ˿
+	strcpy(pcIP, inet_ntoa(addrRemote.sin_addr));
+	uPort = ntohs(addrRemote.sin_port);
+
+	// ջݱ鲻ȫֶ(uiDatagramsΪѲֵĲ, Ѷ)
+	if (bIsTruncated || uiLeft > 0)
+	{
+		m_nLastWSAError = WSAEMSGSIZE;
+		return SOB_RET_FAIL;
+	}
+
+	return SOB_RET_OK;
+}
 
-	addrRemote.sin_family = AF_INET;
-	addrRemote.sin_addr.s_addr = inet_addr(pcIP);
-	addrRemote.sin_port = htons(sPort);
+// CRosaSocket UDPϢ(ϲʱͨϢȡطֶδС)
+int CRosaSocket::RecvUDPMessage(char * pBuffer, UINT uiBufferSize, SOCKADDR_IN * pAddrRemote, UINT & uiRecv, UINT & uiSegmentSize)
+{
+	int nAddrLen = sizeof(SOCKADDR_IN);
+	memset(pAddrRemote, 0, nAddrLen);
 
-	// α
-	char* pcSentPos = pBuffer;
+	uiRecv = 0;
+	uiSegmentSize = 0;
 
-	// ֱеĻ嶼
-	while (nSent < (int)uiBufferSize)
+	// δϲ
+	if (!m_bUDPRecvOffload || m_pfnWSARecvMsg == NULL)
 	{
-		// 鷢ʹǷ
-		if (nSendTimes > nSendLimitTimes)
+		int nRet = recvfrom(m_socket, pBuffer, uiBufferSize, NULL, (PSOCKADDR)pAddrRemote, &nAddrLen);
+		ROSA_TRACE(ROSA_TRACE_RECV, m_socket, nRet);
+
+		if (nRet != SOCKET_ERROR)
 		{
-			bIsTimeOut = true;
-			break;
+			uiRecv = nRet;
+		}
+		else if (WSAGetLastError() == WSAEMSGSIZE)
+		{
+			// ݱڻ, , ಿֶ
+			uiRecv = uiBufferSize;
 		}
 
-		int nRet = sendto(m_socket, pcSentPos, uiLeftBuffer, NULL, (PSOCKADDR)&addrRemote, sizeof(addrRemote));
+		return nRet;
+	}
 
-		if (nRet == SOCKET_ERROR)
+	WSABUF wsaBuf;
+	wsaBuf.buf = pBuffer;
+	wsaBuf.len = uiBufferSize;
+
+	char chControl[WSA_CMSG_SPACE(sizeof(DWORD))];
+	memset(chControl, 0, sizeof(chControl));
+
+	WSAMSG wsaMsg;
+	memset(&wsaMsg, 0, sizeof(wsaMsg));
+	wsaMsg.name = (LPSOCKADDR)pAddrRemote;
+	wsaMsg.namelen = nAddrLen;
+	wsaMsg.lpBuffers = &wsaBuf;
+	wsaMsg.dwBufferCount = 1;
+	wsaMsg.Control.buf = chControl;
+	wsaMsg.Control.len = sizeof(chControl);
+
+	DWORD dwRecv = 0;
+	int nRet = m_pfnWSARecvMsg(m_socket, &wsaMsg, &dwRecv, NULL, NULL);
+	ROSA_TRACE(ROSA_TRACE_RECV, m_socket, (nRet == SOCKET_ERROR) ? SOCKET_ERROR : (LONG)dwRecv);
+
+	if (nRet == SOCKET_ERROR)
+	{
+		if (WSAGetLastError() == WSAEMSGSIZE)
+		{
+			uiRecv = uiBufferSize;
+		}
+
+		return nRet;
+	}
+
+	uiRecv = dwRecv;
+
+	// ϲݳڻ, ಿֶ
+	if (wsaMsg.dwFlags & MSG_TRUNC)
+	{
+		WSASetLastError(WSAEMSGSIZE);
+		nRet = SOCKET_ERROR;
+	}
+
+	// ȡغϲϢ
+	for (WSACMSGHDR* pCmsg = WSA_CMSG_FIRSTHDR(&wsaMsg); pCmsg != NULL; pCmsg = WSA_CMSG_NXTHDR(&wsaMsg, pCmsg))
+	{
+		if (pCmsg->cmsg_level == IPPROTO_UDP && pCmsg->cmsg_type == UDP_COALESCED_INFO)
+		{
+			uiSegmentSize = *(DWORD*)WSA_CMSG_DATA(pCmsg);
+		}
+	}
+
+	return (nRet == SOCKET_ERROR) ? SOCKET_ERROR : (int)dwRecv;
+}
+
+// CRosaSocket 󶨷·(Unix׽, ·ļ˼ʱɾ; '@'ͷΪַ, ļ)
+bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketUnixBindOnPath(const char * pcPath)
+{
+	SOCKADDR_UN addrLocal;
+	int nAddrLen = MakeUnixAddr(pcPath, &addrLocal);
+
+	if (nAddrLen == 0 || m_socket != NULL)
+	{
+		m_nLastWSAError = WSAEINVAL;
+		return false;
+	}
+
+	m_socket = CreateUnixSocket();
+	if (m_socket == NULL)
+	{
+		return false;
+	}
+
+	// ϴ쳣˳·ļ: , ֻбܾ(˼)ʱɾ, ռڼ·
+	if (pcPath[0] != '@' && GetFileAttributesA(pcPath) != INVALID_FILE_ATTRIBUTES)
+	{
+		SOCKET sProbe = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (sProbe == INVALID_SOCKET)
 		{
 			m_nLastWSAError = WSAGetLastError();
-			break;
+
+			closesocket(m_socket);
+			m_socket = NULL;
+			return false;
 		}
-		else
+
+		int nProbe = connect(sProbe, (PSOCKADDR)&addrLocal, nAddrLen);
+		int nProbeError = (nProbe == SOCKET_ERROR) ? WSAGetLastError() : 0;
+
+		closesocket(sProbe);
+
+		if (nProbe != SOCKET_ERROR)
 		{
-			// ͳɹۼӷα
-			nSendTimes++;
+			m_nLastWSAError = WSAEADDRINUSE;
 
-			nSent += nRet;
-			uiLeftBuffer -= nRet;
-			pcSentPos += nRet;
+			closesocket(m_socket);
+			m_socket = NULL;
+			return false;
+		}
+
+		if (nProbeError == WSAECONNREFUSED)
+		{
+			DeleteFileA(pcPath);
 		}
 	}
 
-	// 
-	if (nSent == uiBufferSize)
+	// 
+	int nRet = bind(m_socket, (PSOCKADDR)&addrLocal, nAddrLen);
+
+	if (nRet == SOCKET_ERROR)
 	{
-		return SOB_RET_OK;
+		m_nLastWSAError = WSAGetLastError();
+
+		closesocket(m_socket);
+		m_socket = NULL;
+		return false;
 	}
 
-	// ʱ
-	if (bIsTimeOut)
+	strcpy_s(m_pcUnixPath, SOB_UNIX_PATH_LENGTH, pcPath);
+	m_bUnixListen = true;
+
+	return true;
+}
+
+// CRosaSocket Unix(ӺTCPͻʹͬշ)
+bool ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketUnixConnect(const char * pcPath, USHORT nTimeOutSec)
+{
+	LONGLONG llStart = LatencyStart(ROSA_HISTOGRAM_OP_CONNECT);
+
+	// Ҫ·ʾõǰ·
+	if (pcPath != NULL)
 	{
-		return SOB_RET_TIMEOUT;
+		if (m_bUnixListen || strlen(pcPath) >= SOB_UNIX_PATH_LENGTH)
+		{
+			m_nLastWSAError = WSAEINVAL;
+			return false;
+		}
+
+		strcpy_s(m_pcUnixPath, SOB_UNIX_PATH_LENGTH, pcPath);
+		m_bUnixClient = true;
 	}
 
-	// ûܳɹ
-	m_nLastWSAError = WSAGetLastError();
+	SOCKADDR_UN addrRemote;
+	int nAddrLen = MakeUnixAddr(m_pcUnixPath, &addrRemote);
 
-	return SOB_RET_FAIL;
+	if (nAddrLen == 0 || !m_bUnixClient)
+	{
+		m_nLastWSAError = WSAEINVAL;
+		return false;
+	}
+
+	// socketЧ½Ϊ˿ظ
+	if (m_socket == NULL)
+	{
+		m_socket = CreateUnixSocket();
+		if (m_socket == NULL)
+		{
+			return false;
+		}
+	}
+
+	memset(m_pcRemoteIP, 0, SOB_IP_LENGTH);
+	m_sRemotePort = 0;
+
+	if (!ConnectAddr((SOCKADDR*)&addrRemote, nAddrLen, nTimeOutSec))
+	{
+		return false;
+	}
+
+	LatencyRecord(ROSA_HISTOGRAM_OP_CONNECT, llStart);
+
+	return true;
 }
 
-// CRosaSocket ջ(UDP)
-int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketUDPRecvBuffer(char * pBuffer, UINT uiBufferSize, UINT & uiRecv, char * pcIP, USHORT & uPort, USHORT nTimeOutSec)
+// CRosaSocket ȡ󶨻ӵ·
+const char * ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketUnixGetPath() const
 {
-	bool bIsTimeOut = false;
+	return m_pcUnixPath;
+}
 
-	// ǰע¼
-	WSAResetEvent(m_SocketReadEvent);
-	WSAEventSelect(m_socket, m_SocketReadEvent, FD_READ);
+// CRosaSocket ȡUnixӵĶԶ˽ID(Windows 10 1809֧֮)
+DWORD ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketUnixGetPeerPID(SOCKET Socket)
+{
+	ULONG ulPID = 0;
+	DWORD dwBytes = 0;
 
-	// ԶϢ
-	SOCKADDR_IN addrRemote;
-	int nAddrLen = sizeof(addrRemote);
-	memset(&addrRemote, 0, nAddrLen);
+	if (WSAIoctl(Socket, SIO_AF_UNIX_GETPEERPID, NULL, 0, &ulPID, sizeof(ulPID), &dwBytes, NULL, NULL) == SOCKET_ERROR)
+	{
+		m_nLastWSAError = WSAGetLastError();
+		return 0;
+	}
 
-	// Խ
-	int nRet = recvfrom(m_socket, pBuffer, uiBufferSize, NULL, (PSOCKADDR)&addrRemote, &nAddrLen);
+	return ulPID;
+}
 
-	if (nRet == SOCKET_ERROR)
+// CRosaSocket Զ˽̴׽(SCM_RIGHTS: Զ˽IDƺ͸Ϣ, ͻʹCRosaSocketGetRawSocket()ΪSocket)
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketUnixSendSocket(SOCKET Socket, SOCKET sPass, USHORT nTimeOutSec)
+{
+	DWORD dwPeerPID = CRosaSocketUnixGetPeerPID(Socket);
+	if (dwPeerPID == 0)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	S_UNIXHANDOFF sHandoff;
+	memset(&sHandoff, 0, sizeof(sHandoff));
+	sHandoff.dwMagic = SOB_UNIX_HANDOFF_MAGIC;
+	sHandoff.dwType = SOB_UNIX_HANDOFF_SOCKET;
+	sHandoff.dwSenderPID = GetCurrentProcessId();
+
+	if (WSADuplicateSocketW(sPass, dwPeerPID, &sHandoff.sProtocolInfo) == SOCKET_ERROR)
 	{
 		m_nLastWSAError = WSAGetLastError();
+		return SOB_RET_FAIL;
+	}
 
-		// 
-		if (m_nLastWSAError == WSAEWOULDBLOCK)
-		{
-			DWORD dwRet = WSAWaitForMultipleEvents(1, &m_SocketReadEvent, FALSE, nTimeOutSec * 1000, FALSE);
+	// ԶδȡõĸϢڱ˹رsPassʧЧ
+	return CRosaSocketSendBuffer(Socket, (char*)&sHandoff, sizeof(sHandoff), nTimeOutSec);
+}
 
-			// ¼
-			WSANETWORKEVENTS wsaEvents;
-			memset(&wsaEvents, 0, sizeof(wsaEvents));
+// CRosaSocket Զ˽̴ں˾(紮ھ, ֱӸƵԶ˽̺;ֵ)
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketUnixSendHandle(SOCKET Socket, HANDLE hPass, USHORT nTimeOutSec)
+{
+	DWORD dwPeerPID = CRosaSocketUnixGetPeerPID(Socket);
+	if (dwPeerPID == 0)
+	{
+		return SOB_RET_FAIL;
+	}
 
-			if (dwRet == WSA_WAIT_EVENT_0)
-			{
-				WSAResetEvent(m_SocketReadEvent);
-				int nEnum = WSAEnumNetworkEvents(m_socket, m_SocketReadEvent, &wsaEvents);
+	HANDLE hPeer = OpenProcess(PROCESS_DUP_HANDLE, FALSE, dwPeerPID);
+	if (hPeer == NULL)
+	{
+		m_nLastWSAError = GetLastError();
+		return SOB_RET_FAIL;
+	}
 
-				// ܿԽвûд
-				if ((wsaEvents.lNetworkEvents & FD_READ) &&
-					(wsaEvents.iErrorCode[FD_READ_BIT] == 0))
-				{
-					// ٴνı
-					nRet = recvfrom(m_socket, pBuffer, uiBufferSize, NULL, (PSOCKADDR)&addrRemote, &nAddrLen);
+	HANDLE hRemote = NULL;
+	if (!DuplicateHandle(GetCurrentProcess(), hPass, hPeer, &hRemote, 0, FALSE, DUPLICATE_SAME_ACCESS))
+	{
+		m_nLastWSAError = GetLastError();
+		CloseHandle(hPeer);
+		return SOB_RET_FAIL;
+	}
 
-					if (nRet > 0)
-					{
-						// ֽڴ0ճɹ
-						uiRecv = nRet;
+	S_UNIXHANDOFF sHandoff;
+	memset(&sHandoff, 0, sizeof(sHandoff));
+	sHandoff.dwMagic = SOB_UNIX_HANDOFF_MAGIC;
+	sHandoff.dwType = SOB_UNIX_HANDOFF_HANDLE;
+	sHandoff.dwSenderPID = GetCurrentProcessId();
+	sHandoff.ullHandle = (ULONGLONG)(ULONG_PTR)hRemote;
 
-						// IPͶ˿
-						strcpy(pcIP, inet_ntoa(addrRemote.sin_addr));
-						uPort = ntohs(addrRemote.sin_port);
+	int nRet = CRosaSocketSendBuffer(Socket, (char*)&sHandoff, sizeof(sHandoff), nTimeOutSec);
 
-						return SOB_RET_OK;
-					}
-				}
-				else if ((wsaEvents.lNetworkEvents & FD_CLOSE) &&
-					(wsaEvents.iErrorCode[FD_CLOSE_BIT] == 0))
-				{
-					// Ѿر
-					return SOB_RET_CLOSE;
-				}
-			}
-			else
-			{
-				bIsTimeOut = true;
-			}
-		}
-	}
-	else
+	// ʧʱԶ˲֪, ڶԶ˽йر
+	if (nRet != SOB_RET_OK)
 	{
-		// һαճɹ
-		uiRecv = nRet;
+		DuplicateHandle(hPeer, hRemote, NULL, NULL, 0, FALSE, DUPLICATE_CLOSE_SOURCE);
+	}
 
-		// IPͶ˿
-		strcpy(pcIP, inet_ntoa(addrRemote.sin_addr));
-		uPort = ntohs(addrRemote.sin_port);
+	CloseHandle(hPeer);
 
-		return SOB_RET_OK;
+	return nRet;
+}
+
+// CRosaSocket նԶ˴ݵ׽(ͲʱͷյĶ󲢷ʧ)
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketUnixRecvSocket(SOCKET Socket, SOCKET & sRecv, USHORT nTimeOutSec)
+{
+	sRecv = INVALID_SOCKET;
+
+	S_UNIXHANDOFF sHandoff;
+	memset(&sHandoff, 0, sizeof(sHandoff));
+
+	int nRet = CRosaSocketRecvBuffer(Socket, (char*)&sHandoff, sizeof(sHandoff), sizeof(sHandoff), nTimeOutSec);
+	if (nRet != SOB_RET_OK)
+	{
+		return nRet;
 	}
 
-	// ʱ
-	if (bIsTimeOut)
+	if (!CheckHandoff(Socket, sHandoff, SOB_UNIX_HANDOFF_SOCKET))
 	{
-		return SOB_RET_TIMEOUT;
+		return SOB_RET_FAIL;
 	}
 
-	// ʧ
-	m_nLastWSAError = WSAGetLastError();
+	sRecv = WSASocketW(FROM_PROTOCOL_INFO, FROM_PROTOCOL_INFO, FROM_PROTOCOL_INFO, &sHandoff.sProtocolInfo, 0, WSA_FLAG_OVERLAPPED);
+	if (sRecv == INVALID_SOCKET)
+	{
+		m_nLastWSAError = WSAGetLastError();
+		return SOB_RET_FAIL;
+	}
 
-	return SOB_RET_FAIL;
+	return SOB_RET_OK;
 }
 
-// CRosaSocket ַתΪIPַ
-bool CRosaSocket::ResolveAddressToIp(const char * pcAddress, char * pcIp)
+// CRosaSocket նԶ˴ݵں˾(Ͳʱʧ, յľֵᱻر)
+int ROSASOCKET_CALLMODE CRosaSocket::CRosaSocketUnixRecvHandle(SOCKET Socket, HANDLE & hRecv, USHORT nTimeOutSec)
 {
-	addrinfo adiHints, *padiResult;
-	int	nRet;
+	hRecv = NULL;
+
+	S_UNIXHANDOFF sHandoff;
+	memset(&sHandoff, 0, sizeof(sHandoff));
+
+	int nRet = CRosaSocketRecvBuffer(Socket, (char*)&sHandoff, sizeof(sHandoff), sizeof(sHandoff), nTimeOutSec);
+	if (nRet != SOB_RET_OK)
+	{
+		return nRet;
+	}
 
-	memset(&adiHints, 0, sizeof(addrinfo));
+	if (!CheckHandoff(Socket, sHandoff, SOB_UNIX_HANDOFF_HANDLE))
+	{
+		return SOB_RET_FAIL;
+	}
 
-	// IPV4ĵַ
-	adiHints.ai_flags = AI_CANONNAME;
-	adiHints.ai_family = AF_INET;
-	adiHints.ai_socktype = SOCK_STREAM;
-	adiHints.ai_protocol = IPPROTO_TCP;
+	hRecv = (HANDLE)(ULONG_PTR)sHandoff.ullHandle;
 
-	// תַ
-	nRet = ::getaddrinfo(pcAddress, NULL, &adiHints, &padiResult);
+	return SOB_RET_OK;
+}
 
-	// 
-	if (nRet != 0)
+// CRosaSocket յĴ֡(δֱ֪Ӿܾ; ͲʱͷյĶ, ֻڷͽȷΪԶ˽ʱر, Զ˽˹رձ̵)
+bool CRosaSocket::CheckHandoff(SOCKET Socket, const S_UNIXHANDOFF & sHandoff, DWORD dwType)
+{
+	if (sHandoff.dwMagic != SOB_UNIX_HANDOFF_MAGIC || (sHandoff.dwType != SOB_UNIX_HANDOFF_SOCKET && sHandoff.dwType != SOB_UNIX_HANDOFF_HANDLE))
 	{
-		freeaddrinfo(padiResult);
+		m_nLastWSAError = WSAEINVAL;
 		return false;
 	}
 
-	// ,ֻһ
-	if (padiResult->ai_addr != NULL)
+	// ͽIDӵĶԶ˽һ
+	DWORD dwPeerPID = CRosaSocketUnixGetPeerPID(Socket);
+	if (dwPeerPID == 0 || sHandoff.dwSenderPID != dwPeerPID)
 	{
-		::strcpy(pcIp, inet_ntoa(((sockaddr_in*)padiResult->ai_addr)->sin_addr));
+		m_nLastWSAError = WSAEACCES;
+		return false;
 	}
 
-	freeaddrinfo(padiResult);
+	if (sHandoff.dwType == dwType)
+	{
+		return true;
+	}
 
-	return true;
+	// ͲʱֻرձԼĶ: ׽ɸϢڱ½ر(ͷŶԶ˵ĸ)
+	// ֵɶԶд, ޷ȷǶԶ˸ƹľ, ر(ܹرձʹõ)
+	if (sHandoff.dwType == SOB_UNIX_HANDOFF_SOCKET)
+	{
+		SOCKET s = WSASocketW(FROM_PROTOCOL_INFO, FROM_PROTOCOL_INFO, FROM_PROTOCOL_INFO, (LPWSAPROTOCOL_INFOW)&sHandoff.sProtocolInfo, 0, WSA_FLAG_OVERLAPPED);
+		if (s != INVALID_SOCKET)
+		{
+			closesocket(s);
+		}
+	}
+
+	m_nLastWSAError = WSAEINVAL;
+	return false;
+}
+
+// CRosaSocket ַתΪIPַ(ĬϽ, ֻͬһ)
+bool CRosaSocket::ResolveAddressToIp(const char * pcAddress, char * pcIp, USHORT nTimeOutSec)
+{
+	vector<SOCKADDR_STORAGE> vecAddress;
+
+	// תַ(getaddrinfoڽִ߳, ȴnTimeOutSec, ʹCRosaConnector)
+	if (CRosaResolver::CRosaResolverGetDefault().CRosaResolverResolve(pcAddress, vecAddress, nTimeOutSec * 1000) != SOB_RET_OK)
+	{
+		return false;
+	}
+
+	// صһIPV4ĵַ
+	for (vector<SOCKADDR_STORAGE>::iterator iter = vecAddress.begin(); iter != vecAddress.end(); ++iter)
+	{
+		if (iter->ss_family == AF_INET)
+		{
+			::strcpy(pcIp, inet_ntoa(((sockaddr_in*)&(*iter))->sin_addr));
+			return true;
+		}
+	}
+
+	return false;
 }
 
 // CRosaSocket ȡIPַ
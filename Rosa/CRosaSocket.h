@@ -16,6 +16,11 @@
 
 //Include WinSock2 Header File
 #include <WinSock2.h>
+#include <MSWSock.h>
+
+//Include Rosa Header File
+#include "CRosaHistogram.h"
+#include "CRosaCompress.h"
 
 //Include C/C++ Header File
 #include <iostream>
@@ -24,6 +29,7 @@
 
 //Include WinSock2 Library
 #pragma comment(lib, "Ws2_32.lib")
+#pragma comment(lib, "Mswsock.lib")
 
 using namespace std;
 
@@ -52,14 +58,39 @@ using namespace std;
 #define SOB_TCP_RECV_BUFFER			32*1024			//TCPջ32K
 #define SOB_UDP_RECV_BUFFER			32*1024			//UDPջ32K
 
+#define SOB_UDP_SEGMENT_SIZE		1472			//UDPĬϷֶδС(̫MTU)
+#define SOB_UDP_OFFLOAD_MAX_BYTES	63*1024			//UDPжص/ϲ
+#define SOB_UDP_OFFLOAD_MAX_SEGMENTS	64			//UDPжصֶ
+
 #define SOB_DEFAULT_TIMEOUT_SEC		5				//Ĭϵĳʱʱ
 #define SOB_DEFAULT_MAX_CLIENT		10				//ĬϷ
+#define SOB_DEFAULT_BACKLOG			5				//ĬϷ˼г
+
+#define SOB_BULK_CHUNK_SIZE			4*1024*1024		//鷢͵ύ(ÿύ㳬ʱ)
+
+#define SOB_SHARD_MAX_COUNT			64				//Ƭ߳
+#define SOB_SHARD_ACCEPT_DEPTH		8				//Ƭÿ߳ԤͶAcceptEx
+#define SOB_SHARD_RETRY_MSEC		100				//ƬAcceptExͶʧܺԼ
+
+#define SOB_UNIX_PATH_LENGTH		108				//Unix׽·󳤶(β0, '@'ͷʾַ)
+#define SOB_UNIX_HANDOFF_MAGIC		0x52534846		//֡ʶ("RSHF")
+#define SOB_UNIX_HANDOFF_SOCKET		1				//׽(WSADuplicateSocket)
+#define SOB_UNIX_HANDOFF_HANDLE		2				//ں˾(DuplicateHandle, 紮)
+
+#define SOB_TRANSPORT_TCP			0				//䷽ʽ: TCP(Ĭ)
+#define SOB_TRANSPORT_SHM			1				//䷽ʽ: ڴ(CRosaShmSocket, ˿ںֻ)
+#define SOB_SHM_SOCKET_TAG			3				//ڴӵ׽ֵ2λ(ʵ׽־4ı, ͻ)
 
 #define SOB_RET_OK					1				//
 #define SOB_RET_FAIL				0				//
 #define SOB_RET_TIMEOUT				-1				//ʱ
 #define SOB_RET_CLOSE				-2				//Ͽ
 
+//Class Declaration
+class CRosaSocket;
+class CRosaEventLoop;
+class CRosaShmSocket;
+
 //Struct Definition
 typedef struct
 {
@@ -67,9 +98,37 @@ typedef struct
 	SOCKADDR_IN SocketAddr;
 }S_CLIENTINFO, *LPS_CLIENTINFO;
 
+typedef struct
+{
+	char* pBuffer;			// ݱʼַ(ָջڲ)
+	UINT uiSize;			// ݱ
+}S_UDPDATAGRAM, *LPS_UDPDATAGRAM;
+
+typedef struct
+{
+	CRosaSocket* pSocket;		// 
+	SOCKET Socket;				// ͻ׽
+	ULONGLONG ullConnID;		// Ӵ(ÿεǼǵ, ׽־ʱ¾)
+	ULONGLONG ullTimerID;		// гʱʱ
+	SOCKADDR_STORAGE addrPeer;	// ǼʱĶԶ˵ַ(ʱʱ˶Ծͬһ)
+	int nPeerLen;				// Զ˵ַ(0:δȡ)
+}S_IDLECONN, *LPS_IDLECONN;
+
+typedef struct
+{
+	DWORD dwMagic;						// ֡ʶ
+	DWORD dwType;						// (SOB_UNIX_HANDOFF_*)
+	DWORD dwSenderPID;					// ͽID
+	DWORD dwReserved;					// 
+	ULONGLONG ullHandle;				// ѸƵս̵ľֵ(SOB_UNIX_HANDOFF_HANDLE)
+	WSAPROTOCOL_INFOW sProtocolInfo;	// ׽ָϢ(SOB_UNIX_HANDOFF_SOCKET)
+}S_UNIXHANDOFF, *LPS_UNIXHANDOFF;
+
 //Callback Definition
 typedef unsigned(__stdcall *HANDLE_ACCEPT_THREAD)(void*);		//̺߳
 typedef void(__stdcall *HANDLE_ACCEPT_CALLBACK)(SOCKADDR_IN* pRemoteAddr, SOCKET s, DWORD dwUser);		//̺߳
+typedef void(__stdcall *HANDLE_SHARD_ACCEPT_CALLBACK)(SOCKADDR_IN* pRemoteAddr, SOCKET s, USHORT nShard, DWORD dwUser);		//Ƭӻص
+typedef void(__stdcall *HANDLE_SEND_COMPLETE_CALLBACK)(const char* pSendBuffer, UINT uiSent, int nResult, DWORD_PTR dwUser);		//㿽ɻص(ִ̳߳, ֮󻺳ͷ)
 
 //Class Definition
 class ROSASOCKET_API CRosaSocket
@@ -85,6 +144,34 @@ public:
 private:
 	SOCKET CreateTCPSocket();					// CRosaSocket TCP׽
 	SOCKET CreateUDPSocket();					// CRosaSocket UDP׽
+	SOCKET CreateUnixSocket();					// CRosaSocket Unix׽
+
+	bool ConnectAddr(const SOCKADDR* pAddr, int nAddrLen, USHORT nTimeOutSec);		// CRosaSocket ַָ(ʧʱر׽)
+
+	static unsigned __stdcall OnAcceptShard(void* pParam);		// CRosaSocket Ƭ߳
+
+	int TransmitFileRange(SOCKET Socket, HANDLE hFile, ULONGLONG ullOffset, ULONGLONG ullLength, USHORT nTimeOutSec);		// CRosaSocket ֶεTransmitFileļ
+	int WaitOverlappedSend(SOCKET Socket, LPWSAOVERLAPPED pOverlapped, DWORD& dwSent, USHORT nTimeOutSec);				// CRosaSocket ȴص(ʱȡ)
+	bool CheckHandoff(SOCKET Socket, const S_UNIXHANDOFF& sHandoff, DWORD dwType);						// CRosaSocket յĴ֡(Ͳʱֻͷű½׽)
+
+	bool AcceptShm(HANDLE_ACCEPT_THREAD pThreadFunc, HANDLE_ACCEPT_CALLBACK pCallback, DWORD dwUser, BOOL* pExitFlag, USHORT nLoopTimeOutSec);	// CRosaSocket ڴ洫(Աǵ׽ֵص)
+	CRosaShmSocket* ShmFind(SOCKET Socket);							// CRosaSocket ҹڴ(NULL:ǹڴ)
+
+	void IdleAdd(SOCKET Socket);									// CRosaSocket ʼмʱ(Ӻ)
+	void IdleTouch(SOCKET Socket);									// CRosaSocket շɹ¼ʱ
+	void ReapAcceptThreads();										// CRosaSocket Ѿ߳̾
+
+	CRosaCompress* CompressFind(SOCKET Socket);						// CRosaSocket ӵѹ״̬(NULL:δЭ̻ѹ)
+
+	void FirstByteAdd(SOCKET Socket);								// CRosaSocket ¼ӵʱ
+	void FirstByteRecord(SOCKET Socket);							// CRosaSocket ״νճɹʱ¼ֽںʱ
+	LONGLONG LatencyStart(int nOp) const;							// CRosaSocket ʼʱ(δͳʱ0)
+	void LatencyRecord(int nOp, LONGLONG llStart) const;			// CRosaSocket ¼ʱ
+
+	static void __stdcall OnIdleTimeOut(ULONGLONG ullTimerID, void* pUser);			// CRosaSocket гʱ(رӵշ)
+	static void __stdcall OnZeroCopyComplete(PVOID pParam, BOOLEAN bTimedOut);		// CRosaSocket 㿽(̳߳صȴص)
+
+	int RecvUDPMessage(char* pBuffer, UINT uiBufferSize, SOCKADDR_IN* pAddrRemote, UINT& uiRecv, UINT& uiSegmentSize);	// CRosaSocket UDPϢ(ϲ)
 
 // óԱ
 public:
@@ -92,8 +179,12 @@ public:
 	void ROSASOCKET_CALLMODE CRosaSocketSetSendTimeOut(UINT uiMSec);			// CRosaSocket ÷ͳʱʱ
 	void ROSASOCKET_CALLMODE CRosaSocketSetRecvBufferSize(UINT uiByte);		// CRosaSocket ý鳤
 	void ROSASOCKET_CALLMODE CRosaSocketSetSendBufferSize(UINT uiByte);		// CRosaSocket ÷鳤
+	bool ROSASOCKET_CALLMODE CRosaSocketSetNoDelay(bool bNoDelay);			// CRosaSocket ǷNagle(ĬϽ, СϢCRosaCoalescerϲ)
+	bool ROSASOCKET_CALLMODE CRosaSocketSetNoDelay(SOCKET Socket, bool bNoDelay);	// CRosaSocket ǷNagle()
+	bool ROSASOCKET_CALLMODE CRosaSocketSetHistogram(int nOp, CRosaHistogram* pHistogram);	// CRosaSocket öӳͳ(///ֽ)
 
 	SOCKET ROSASOCKET_CALLMODE CRosaSocketGetRawSocket() const;				// CRosaSocket ȡSocket
+	int ROSASOCKET_CALLMODE CRosaSocketGetLastWSAError() const;				// CRosaSocket ȡһWSA
 	bool ROSASOCKET_CALLMODE CRosaSocketAttachRawSocket(SOCKET s, bool bIsConnected);	// CRosaSocket Socket׽
 	void ROSASOCKET_CALLMODE CRosaSocketDettachRawSocket();					// CRosaSocket Socket׽
 
@@ -102,13 +193,16 @@ public:
 	ULONG ROSASOCKET_CALLMODE CRosaSocketGetRemoteIPUL() const;				// CRosaSocket ȡԶIPַ(ULONG)
 	USHORT ROSASOCKET_CALLMODE CRosaSocketGetRemotePort() const;				// CRosaSocket ȡԶ̶˿ں
 	bool ROSASOCKET_CALLMODE CRosaSocketIsConnected() const;					// CRosaSocket ȡ״̬(ͻ)
+	bool ROSASOCKET_CALLMODE CRosaSocketSetTransport(int nTransport);			// CRosaSocket ô䷽ʽ(SOB_TRANSPORT_*, 󶨻֮ǰ; ڴֻתBind/Listen/Accept/Connectշ, ļ/㿽/Ϣ/UDPֻ֧TCP)
+	int ROSASOCKET_CALLMODE CRosaSocketGetTransport() const;					// CRosaSocket ȡ䷽ʽ
 	void ROSASOCKET_CALLMODE CRosaSocketDestory();								// CRosaSocket ɾSocketBase
 
 // TCP˳Ա
 public:
 	bool ROSASOCKET_CALLMODE CRosaSocketBindOnPort(USHORT uPort);	// CRosaSocket 󶨷˶˿
-	bool ROSASOCKET_CALLMODE CRosaSocketListen();					// CRosaSocket ˶˿
+	bool ROSASOCKET_CALLMODE CRosaSocketListen(int nBacklog = SOB_DEFAULT_BACKLOG);	// CRosaSocket ˶˿
 	bool ROSASOCKET_CALLMODE CRosaSocketAccept(HANDLE_ACCEPT_THREAD pThreadFunc, HANDLE_ACCEPT_CALLBACK pCallback, DWORD dwUser, BOOL* pExitFlag = NULL, USHORT nLoopTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);	// CRosaSocket տͻ
+	bool ROSASOCKET_CALLMODE CRosaSocketAcceptSharded(USHORT nShards, HANDLE_SHARD_ACCEPT_CALLBACK pCallback, DWORD dwUser, BOOL* pExitFlag = NULL, bool bSteerToRSS = false, USHORT nLoopTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);	// CRosaSocket Ƭտͻ(ÿһ߳)
 
 	int ROSASOCKET_CALLMODE CRosaSocketSendOnce(SOCKET Socket, char* pSendBuffer, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);										// CRosaSocket ͻ(ȫ)
 	int ROSASOCKET_CALLMODE CRosaSocketSendBuffer(SOCKET Socket, char* pSendBuffer, UINT uiBufferSize, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);					// CRosaSocket ͻ(һ)
@@ -122,6 +216,11 @@ public:
 	void ROSASOCKET_CALLMODE CRosaSocketSetConnectMaxCount(USHORT sMaxCount);																							// CRosaSocket 
 	void ROSASOCKET_CALLMODE CRosaSocketSetConnectCount(int nAcceptCount);																								// CRosaSocket õǰ
 
+	bool ROSASOCKET_CALLMODE CRosaSocketSetIdleTimeOut(CRosaEventLoop* pLoop, DWORD dwIdleMSec);																		// CRosaSocket ÿгʱ(ʱշӱshutdown, 0ʾر)
+	void ROSASOCKET_CALLMODE CRosaSocketIdleRemove(SOCKET Socket);																										// CRosaSocket ֹͣӵĿмʱ(ر׽֮ǰ)
+	void ROSASOCKET_CALLMODE CRosaSocketCloseClient(SOCKET Socket);																										// CRosaSocket رսܵ(ֹͣмʱֽڼʱ)
+	UINT ROSASOCKET_CALLMODE CRosaSocketGetIdleCount();																													// CRosaSocket ȡмʱе
+
 // TCPͻ˳Ա
 public:
 	bool ROSASOCKET_CALLMODE CRosaSocketConnect(const char* pcRemoteIP = NULL, USHORT sPort = 0, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);						// CRosaSocket ͷ
@@ -133,6 +232,28 @@ public:
 	int ROSASOCKET_CALLMODE CRosaSocketRecvOnce(char* pRecvBuffer, UINT uiBufferSize, UINT& uiRecv, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);						// CRosaSocket ջ(ȫ)
 	int ROSASOCKET_CALLMODE CRosaSocketRecvBuffer(char* pRecvBuffer, UINT uiBufferSize, UINT uiRecvSize, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);				// CRosaSocket ջ(һ)
 
+// 鷢ͳԱ
+public:
+	int ROSASOCKET_CALLMODE CRosaSocketSendFile(SOCKET Socket, const char* pcFileName, ULONGLONG ullOffset = 0, ULONGLONG ullLength = 0, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);						// CRosaSocket ļ(, TransmitFile, ullLengthΪ0ʱ͵ļĩβ)
+	int ROSASOCKET_CALLMODE CRosaSocketSendFile(const char* pcFileName, ULONGLONG ullOffset = 0, ULONGLONG ullLength = 0, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);										// CRosaSocket ļ(ͻ)
+	int ROSASOCKET_CALLMODE CRosaSocketSendZeroCopy(SOCKET Socket, const char* pSendBuffer, UINT uiBufferSize, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);											// CRosaSocket 㿽ʹ黺(, ȫݺ󷵻)
+	int ROSASOCKET_CALLMODE CRosaSocketSendZeroCopy(const char* pSendBuffer, UINT uiBufferSize, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);															// CRosaSocket 㿽ʹ黺(ͻ)
+	int ROSASOCKET_CALLMODE CRosaSocketSendZeroCopyAsync(SOCKET Socket, const char* pSendBuffer, UINT uiBufferSize, HANDLE_SEND_COMPLETE_CALLBACK pCallback, DWORD_PTR dwUser);						// CRosaSocket 㿽ʹ黺(, , ɺص)
+	int ROSASOCKET_CALLMODE CRosaSocketSendZeroCopyAsync(const char* pSendBuffer, UINT uiBufferSize, HANDLE_SEND_COMPLETE_CALLBACK pCallback, DWORD_PTR dwUser);										// CRosaSocket 㿽ʹ黺(ͻ)
+
+// ϢԱ
+public:
+	int ROSASOCKET_CALLMODE CRosaSocketNegotiateCompress(SOCKET Socket, int nMode, const char* pDict = NULL, UINT uiDictSize = 0, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);		// CRosaSocket ЭӵϢѹ(, ͬʱ, ROSA_COMPRESS_MODE_NONEʾѹ)
+	int ROSASOCKET_CALLMODE CRosaSocketNegotiateCompress(int nMode, const char* pDict = NULL, UINT uiDictSize = 0, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);					// CRosaSocket ЭӵϢѹ(ͻ)
+	int ROSASOCKET_CALLMODE CRosaSocketGetCompressMode(SOCKET Socket);																												// CRosaSocket ȡЭ̽(ROSA_COMPRESS_MODE_*)
+	bool ROSASOCKET_CALLMODE CRosaSocketGetCompressStats(SOCKET Socket, S_COMPRESSSTATS& sStats, bool bReset = false);																// CRosaSocket ȡӵѹͳ
+	void ROSASOCKET_CALLMODE CRosaSocketCompressRemove(SOCKET Socket);																												// CRosaSocket ͷӵѹ״̬(ر׽֮ǰ)
+
+	int ROSASOCKET_CALLMODE CRosaSocketSendMessage(SOCKET Socket, const char* pMessage, UINT uiSize, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);									// CRosaSocket һϢ(, ֡ͷ, Эʱѹ)
+	int ROSASOCKET_CALLMODE CRosaSocketSendMessage(const char* pMessage, UINT uiSize, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);													// CRosaSocket һϢ(ͻ)
+	int ROSASOCKET_CALLMODE CRosaSocketRecvMessage(SOCKET Socket, char* pBuffer, UINT uiBufferSize, UINT& uiRecv, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);						// CRosaSocket һϢ(, 岻ʱʧ, ر)
+	int ROSASOCKET_CALLMODE CRosaSocketRecvMessage(char* pBuffer, UINT uiBufferSize, UINT& uiRecv, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);										// CRosaSocket һϢ(ͻ)
+
 // UDPԱ
 public:
 	bool ROSASOCKET_CALLMODE CRosaSocketUDPBindOnPort(const char* pcRemoteIP, UINT uiPort);																							// CRosaSocket 󶨶˿(UDP)
@@ -140,9 +261,27 @@ public:
 	int ROSASOCKET_CALLMODE CRosaSocketUDPSendBuffer(const char* pcIP, SHORT sPort, char* pBuffer, UINT uiBufferSize, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);					// CRosaSocket ݻ(UDP)
 	int ROSASOCKET_CALLMODE CRosaSocketUDPRecvBuffer(char* pBuffer, UINT uiBufferSize, UINT& uiRecv, char* pcIP, USHORT& uPort, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);			// CRosaSocket ݻ(UDP)
 
+	bool ROSASOCKET_CALLMODE CRosaSocketUDPSetOffload(bool bSendOffload, bool bRecvOffload, USHORT sSegmentSize = SOB_UDP_SEGMENT_SIZE);												// CRosaSocket ÷ֶη/ϲж(UDP)
+	bool ROSASOCKET_CALLMODE CRosaSocketUDPIsSendOffload() const;																														// CRosaSocket ȡֶηж״̬(UDP)
+	bool ROSASOCKET_CALLMODE CRosaSocketUDPIsRecvOffload() const;																														// CRosaSocket ȡϲж״̬(UDP)
+	int ROSASOCKET_CALLMODE CRosaSocketUDPSendBatch(const char* pcIP, USHORT sPort, char* pBuffer, UINT uiBufferSize, USHORT sSegmentSize, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);		// CRosaSocket ݱ(UDP, sSegmentSizeΪ0ʱʹжʱķֶδС)
+	int ROSASOCKET_CALLMODE CRosaSocketUDPRecvBatch(char* pBuffer, UINT uiBufferSize, S_UDPDATAGRAM* pDatagrams, UINT uiMaxDatagrams, UINT& uiDatagrams, char* pcIP, USHORT& uPort, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);	// CRosaSocket ݱ(UDP, ɲʱSOB_RET_FAIL/WSAEMSGSIZE)
+
+// UnixԱ
+public:
+	bool ROSASOCKET_CALLMODE CRosaSocketUnixBindOnPath(const char* pcPath);																							// CRosaSocket 󶨷·(Unix׽, ֮ʹListen/Accept)
+	bool ROSASOCKET_CALLMODE CRosaSocketUnixConnect(const char* pcPath = NULL, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);										// CRosaSocket Unix(NULLʾõǰ·, ֮ʹÿͻշ)
+	const char* ROSASOCKET_CALLMODE CRosaSocketUnixGetPath() const;																								// CRosaSocket ȡ󶨻ӵ·
+	DWORD ROSASOCKET_CALLMODE CRosaSocketUnixGetPeerPID(SOCKET Socket);																								// CRosaSocket ȡUnixӵĶԶ˽ID(0:ʧ)
+
+	int ROSASOCKET_CALLMODE CRosaSocketUnixSendSocket(SOCKET Socket, SOCKET sPass, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);									// CRosaSocket Զ˽̴׽(ɹ󱾶˿ԹرsPass)
+	int ROSASOCKET_CALLMODE CRosaSocketUnixSendHandle(SOCKET Socket, HANDLE hPass, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);									// CRosaSocket Զ˽̴ں˾(ɹ󱾶˿ԹرhPass)
+	int ROSASOCKET_CALLMODE CRosaSocketUnixRecvSocket(SOCKET Socket, SOCKET& sRecv, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);									// CRosaSocket նԶ˴ݵ׽(ص׽, ɵ߹ر)
+	int ROSASOCKET_CALLMODE CRosaSocketUnixRecvHandle(SOCKET Socket, HANDLE& hRecv, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);									// CRosaSocket նԶ˴ݵں˾(ɵ߹ر)
+
 // 
 public:
-	static bool ResolveAddressToIp(const char* pcAddress, char* pcIp);			// CRosaSocket ַתΪIPַ
+	static bool ResolveAddressToIp(const char* pcAddress, char* pcIp, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);	// CRosaSocket ַתΪIPַ(ȴĬϽĺ̨)
 	static void GetLocalIPAddr();												// CRosaSocket ȡIPַ
 	void ROSASOCKET_CALLMODE GetLocalIPPort();														// CRosaSocket ȡض˿ں
 
@@ -174,19 +313,57 @@ private:
 	int m_nAcceptCount;				// CRosaSocket 
 	USHORT m_sMaxCount;				// CRosaSocket 
 
+	CRITICAL_SECTION m_csIdle;				// CRosaSocket мʱ߳ٽ
+	CRosaEventLoop* m_pIdleLoop;			// CRosaSocket мʱ¼ѭ
+	DWORD m_dwIdleTimeOut;					// CRosaSocket гʱ(, 0ʾʱ)
+	map<ULONGLONG, LPS_IDLECONN> m_mapIdle;	// CRosaSocket мʱе(Ӵ)
+	map<SOCKET, ULONGLONG> m_mapIdleSocket;	// CRosaSocket ׽ֵǰӦӴ
+	ULONGLONG m_ullIdleNextID;				// CRosaSocket һӴ
+
+	map<SOCKET, LONGLONG> m_mapFirstByte;	// CRosaSocket δյݵ(ʱ)
+	volatile LONG m_lFirstBytePending;		// CRosaSocket δյݵ
+
 // TCPͻ˳Ա
 private:
 	bool m_bIsConnected;			// CRosaSocket Socket״̬
 
+// 鷢ͳԱ
+private:
+	LPFN_TRANSMITFILE m_pfnTransmitFile;			// CRosaSocket TransmitFileչ
+
+// ϢԱ
+private:
+	CRITICAL_SECTION m_csCompress;					// CRosaSocket ѹ״̬ٽ
+	map<SOCKET, CRosaCompress*> m_mapCompress;		// CRosaSocket Эѹ(ÿͬһʱһ̼߳һ߳)
+
 // UDPԱ
 private:
+	bool m_bUDPSendOffload;							// CRosaSocket UDPֶηж(USO)
+	bool m_bUDPRecvOffload;							// CRosaSocket UDPϲж(URO)
+	USHORT m_sUDPSegmentSize;						// CRosaSocket UDPĬϷֶδС(δֶָδСʱʹ)
+	LPFN_WSARECVMSG m_pfnWSARecvMsg;				// CRosaSocket WSARecvMsgչ
 
+// UnixԱ
+private:
+	char m_pcUnixPath[SOB_UNIX_PATH_LENGTH];		// CRosaSocket Unix·
+	bool m_bUnixListen;								// CRosaSocket ǷUnix·(ʱɾ·ļ)
+	bool m_bUnixClient;								// CRosaSocket ͻǷUnix·(ʱʹ)
+
+// Ա
+private:
+	int m_nTransport;								// CRosaSocket ䷽ʽ(SOB_TRANSPORT_*)
+	CRosaShmSocket* m_pShm;							// CRosaSocket ڴͻӻ˼
+	CRITICAL_SECTION m_csShm;						// CRosaSocket ڴٽ
+	map<SOCKET, CRosaShmSocket*> m_mapShm;			// CRosaSocket ܵĹڴ(ǵ׽ֵ)
+	ULONG_PTR m_ulShmNextID;						// CRosaSocket һڴ
 
 // Ա
 private:
 	static char m_pcLocalIP[SOB_IP_LENGTH];			// CRosaSocket IPַ
 	static USHORT m_sLocalPort;						// CRosaSocket ˿ں
 
+	CRosaHistogram* m_pHistogram[ROSA_HISTOGRAM_OP_COUNT];	// CRosaSocket ӳͳ
+
 };
 
 
@@ -0,0 +1,475 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaSocketPool.cpp
+* @brief	This File is RosaSocketPool Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaSocketPool.h"
+#include "CThreadSafe.h"
+
+#include <process.h>
+#include <vector>
+
+#pragma warning(disable:4996)
+
+//CRosaSocketPool ͻӳ(IP:˿ڷ)
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSocketPool()
+// @Purpose: CRosaSocketPool캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaSocketPool::CRosaSocketPool()
+{
+	m_sMaxIdle = ROSA_POOL_MAX_IDLE;
+	m_sMaxTotal = ROSA_POOL_MAX_TOTAL;
+	m_dwIdleTimeOut = ROSA_POOL_IDLE_TIMEOUT;
+	m_dwCheckMSec = ROSA_POOL_CHECK_MSEC;
+
+	m_hCheckThread = NULL;
+	m_hExitEvent = NULL;
+	m_bRunning = false;
+
+	InitializeCriticalSection(&m_csPool);
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaSocketPool()
+// @Purpose: CRosaSocketPool
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaSocketPool::~CRosaSocketPool()
+{
+	CRosaSocketPoolDestroy();
+
+	for (map<string, LPS_POOLENDPOINT>::iterator iter = m_mapEndpoint.begin(); iter != m_mapEndpoint.end(); ++iter)
+	{
+		delete iter->second;
+	}
+
+	m_mapEndpoint.clear();
+	m_mapLeased.clear();
+
+	DeleteCriticalSection(&m_csPool);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSocketPoolCreate()
+// @Purpose: CRosaSocketPoolӳؼӼ߳
+// @Since: v1.00a
+// @Para: USHORT sMaxIdle(ÿ˵)
+// @Para: USHORT sMaxTotal(ÿ˵)
+// @Para: DWORD dwIdleTimeOut(ӳʱ, )
+// @Para: DWORD dwCheckMSec(, )
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSASOCKETPOOL_CALLMODE CRosaSocketPool::CRosaSocketPoolCreate(USHORT sMaxIdle, USHORT sMaxTotal, DWORD dwIdleTimeOut, DWORD dwCheckMSec)
+{
+	if (m_bRunning || sMaxTotal == 0 || sMaxIdle > sMaxTotal || dwCheckMSec == 0)
+	{
+		return false;
+	}
+
+	m_sMaxIdle = sMaxIdle;
+	m_sMaxTotal = sMaxTotal;
+	m_dwIdleTimeOut = dwIdleTimeOut;
+	m_dwCheckMSec = dwCheckMSec;
+
+	m_hExitEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+	if (m_hExitEvent == NULL)
+	{
+		return false;
+	}
+
+	m_bRunning = true;
+
+	m_hCheckThread = (HANDLE)_beginthreadex(NULL, 0, OnCheckThread, this, 0, NULL);
+	if (m_hCheckThread == NULL)
+	{
+		m_bRunning = false;
+		CloseHandle(m_hExitEvent);
+		m_hExitEvent = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSocketPoolDestroy()
+// @Purpose: CRosaSocketPoolرտӲֹͣ߳(ӹ黹ʱر)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSASOCKETPOOL_CALLMODE CRosaSocketPool::CRosaSocketPoolDestroy()
+{
+	if (!m_bRunning)
+	{
+		return;
+	}
+
+	vector<CRosaSocket*> vecClose;
+
+	EnterCriticalSection(&m_csPool);
+
+	m_bRunning = false;
+
+	for (map<string, LPS_POOLENDPOINT>::iterator iter = m_mapEndpoint.begin(); iter != m_mapEndpoint.end(); ++iter)
+	{
+		LPS_POOLENDPOINT pEndpoint = iter->second;
+
+		for (deque<S_POOLIDLE>::iterator it = pEndpoint->dqIdle.begin(); it != pEndpoint->dqIdle.end(); ++it)
+		{
+			vecClose.push_back(it->pSocket);
+		}
+
+		pEndpoint->sTotal -= (USHORT)pEndpoint->dqIdle.size();
+		pEndpoint->dqIdle.clear();
+
+		// ѵȴе
+		WakeAllConditionVariable(&pEndpoint->cvIdle);
+	}
+
+	LeaveCriticalSection(&m_csPool);
+
+	SetEvent(m_hExitEvent);
+	WaitForSingleObject(m_hCheckThread, INFINITE);
+	CloseHandle(m_hCheckThread);
+	CloseHandle(m_hExitEvent);
+	m_hCheckThread = NULL;
+	m_hExitEvent = NULL;
+
+	for (vector<CRosaSocket*>::iterator iter = vecClose.begin(); iter != vecClose.end(); ++iter)
+	{
+		(*iter)->CRosaSocketDisConnect();
+		delete (*iter);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSocketPoolLease()
+// @Purpose: CRosaSocketPoolӵCRosaSocket(ȸ黹Ŀ)
+// @Since: v1.00a
+// @Para: const char* pcHost(IPַ)
+// @Para: USHORT sPort(˿ں)
+// @Para: USHORT nTimeOutSec(ȴӼӳʱ)
+// @Return: CRosaSocket* pSocket (NULL:ʧܻȴʱ)
+//------------------------------------------------------------------
+CRosaSocket * ROSASOCKETPOOL_CALLMODE CRosaSocketPool::CRosaSocketPoolLease(const char * pcHost, USHORT sPort, USHORT nTimeOutSec)
+{
+	char chKey[SOB_IP_LENGTH + 8] = { 0 };
+	vector<CRosaSocket*> vecClose;
+	CRosaSocket* pSocket = NULL;
+	LPS_POOLENDPOINT pEndpoint = NULL;
+	bool bReserved = false;
+	ULONGLONG ullDeadline = GetTickCount64() + (ULONGLONG)nTimeOutSec * 1000;
+
+	if (pcHost == NULL || strlen(pcHost) >= SOB_IP_LENGTH)
+	{
+		return NULL;
+	}
+
+	sprintf(chKey, "%s:%u", pcHost, sPort);
+
+	EnterCriticalSection(&m_csPool);
+
+	if (!m_bRunning)
+	{
+		LeaveCriticalSection(&m_csPool);
+		return NULL;
+	}
+
+	map<string, LPS_POOLENDPOINT>::iterator iter = m_mapEndpoint.find(chKey);
+	if (iter == m_mapEndpoint.end())
+	{
+		pEndpoint = new S_POOLENDPOINT;
+		strcpy(pEndpoint->chHost, pcHost);
+		pEndpoint->sPort = sPort;
+		pEndpoint->sTotal = 0;
+		InitializeConditionVariable(&pEndpoint->cvIdle);
+
+		m_mapEndpoint.insert(pair<string, LPS_POOLENDPOINT>(chKey, pEndpoint));
+	}
+	else
+	{
+		pEndpoint = iter->second;
+	}
+
+	for (;;)
+	{
+		// 黹(ȻЧ)
+		while (!pEndpoint->dqIdle.empty())
+		{
+			CRosaSocket* pIdle = pEndpoint->dqIdle.back().pSocket;
+			pEndpoint->dqIdle.pop_back();
+
+			if (CRosaSocketPoolIsHealthy(pIdle))
+			{
+				pSocket = pIdle;
+				break;
+			}
+
+			vecClose.push_back(pIdle);
+			pEndpoint->sTotal--;
+		}
+
+		if (pSocket != NULL)
+		{
+			m_mapLeased.insert(pair<CRosaSocket*, LPS_POOLENDPOINT>(pSocket, pEndpoint));
+			break;
+		}
+
+		// δ½
+		if (pEndpoint->sTotal < m_sMaxTotal)
+		{
+			pEndpoint->sTotal++;
+			bReserved = true;
+			break;
+		}
+
+		// ȴ̹߳黹
+		ULONGLONG ullNow = GetTickCount64();
+		if (ullNow >= ullDeadline)
+		{
+			break;
+		}
+
+		SleepConditionVariableCS(&pEndpoint->cvIdle, &m_csPool, (DWORD)(ullDeadline - ullNow));
+
+		if (!m_bRunning)
+		{
+			break;
+		}
+	}
+
+	LeaveCriticalSection(&m_csPool);
+
+	for (vector<CRosaSocket*>::iterator it = vecClose.begin(); it != vecClose.end(); ++it)
+	{
+		(*it)->CRosaSocketDisConnect();
+		delete (*it);
+	}
+
+	if (!bReserved)
+	{
+		return pSocket;
+	}
+
+	// ⽨
+	char chIP[SOB_IP_LENGTH] = { 0 };
+	bool bResolved = true;
+
+	if (inet_addr(pcHost) == INADDR_NONE)
+	{
+		bResolved = CRosaSocket::ResolveAddressToIp(pcHost, chIP, nTimeOutSec);
+	}
+	else
+	{
+		strcpy(chIP, pcHost);
+	}
+
+	pSocket = new CRosaSocket;
+
+	if (!bResolved || !pSocket->CRosaSocketConnect(chIP, sPort, nTimeOutSec))
+	{
+		delete pSocket;
+		pSocket = NULL;
+	}
+
+	EnterCriticalSection(&m_csPool);
+
+	if (pSocket != NULL)
+	{
+		m_mapLeased.insert(pair<CRosaSocket*, LPS_POOLENDPOINT>(pSocket, pEndpoint));
+	}
+	else
+	{
+		pEndpoint->sTotal--;
+		WakeConditionVariable(&pEndpoint->cvIdle);
+	}
+
+	LeaveCriticalSection(&m_csPool);
+
+	return pSocket;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSocketPoolReturn()
+// @Purpose: CRosaSocketPool黹CRosaSocket(ɸûʱر)
+// @Since: v1.00a
+// @Para: CRosaSocket* pSocket(õ)
+// @Para: bool bReusable(ǷԸ, շЭ״̬δ֪ʱΪfalse)
+// @Return: bool bRet (true:ɹ, false:Ǳӳ, ͷ)
+//------------------------------------------------------------------
+bool ROSASOCKETPOOL_CALLMODE CRosaSocketPool::CRosaSocketPoolReturn(CRosaSocket * pSocket, bool bReusable)
+{
+	EnterCriticalSection(&m_csPool);
+
+	map<CRosaSocket*, LPS_POOLENDPOINT>::iterator iter = m_mapLeased.find(pSocket);
+	if (iter == m_mapLeased.end())
+	{
+		LeaveCriticalSection(&m_csPool);
+		return false;
+	}
+
+	LPS_POOLENDPOINT pEndpoint = iter->second;
+	m_mapLeased.erase(iter);
+
+	if (m_bRunning && bReusable && pSocket->CRosaSocketIsConnected() && pEndpoint->dqIdle.size() < m_sMaxIdle)
+	{
+		S_POOLIDLE sIdle;
+		sIdle.pSocket = pSocket;
+		sIdle.ullIdleSince = GetTickCount64();
+
+		pEndpoint->dqIdle.push_back(sIdle);
+
+		WakeConditionVariable(&pEndpoint->cvIdle);
+		LeaveCriticalSection(&m_csPool);
+		return true;
+	}
+
+	pEndpoint->sTotal--;
+	WakeConditionVariable(&pEndpoint->cvIdle);
+
+	LeaveCriticalSection(&m_csPool);
+
+	pSocket->CRosaSocketDisConnect();
+	delete pSocket;
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSocketPoolEvictIdle()
+// @Purpose: CRosaSocketPoolʱʧЧ(Զ˹ر)Ŀ
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSASOCKETPOOL_CALLMODE CRosaSocketPool::CRosaSocketPoolEvictIdle()
+{
+	vector<CRosaSocket*> vecClose;
+	ULONGLONG ullNow = GetTickCount64();
+
+	EnterCriticalSection(&m_csPool);
+
+	for (map<string, LPS_POOLENDPOINT>::iterator iter = m_mapEndpoint.begin(); iter != m_mapEndpoint.end(); ++iter)
+	{
+		LPS_POOLENDPOINT pEndpoint = iter->second;
+		deque<S_POOLIDLE>::iterator it = pEndpoint->dqIdle.begin();
+
+		while (it != pEndpoint->dqIdle.end())
+		{
+			if (ullNow - it->ullIdleSince >= m_dwIdleTimeOut || !CRosaSocketPoolIsHealthy(it->pSocket))
+			{
+				vecClose.push_back(it->pSocket);
+				it = pEndpoint->dqIdle.erase(it);
+
+				pEndpoint->sTotal--;
+				WakeConditionVariable(&pEndpoint->cvIdle);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	LeaveCriticalSection(&m_csPool);
+
+	for (vector<CRosaSocket*>::iterator iter = vecClose.begin(); iter != vecClose.end(); ++iter)
+	{
+		(*iter)->CRosaSocketDisConnect();
+		delete (*iter);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSocketPoolGetIdleCount()
+// @Purpose: CRosaSocketPoolȡ
+// @Since: v1.00a
+// @Para: None
+// @Return: int nCount
+//------------------------------------------------------------------
+int ROSASOCKETPOOL_CALLMODE CRosaSocketPool::CRosaSocketPoolGetIdleCount()
+{
+	CThreadSafe ThreadSafe(&m_csPool);
+
+	int nCount = 0;
+
+	for (map<string, LPS_POOLENDPOINT>::iterator iter = m_mapEndpoint.begin(); iter != m_mapEndpoint.end(); ++iter)
+	{
+		nCount += (int)iter->second->dqIdle.size();
+	}
+
+	return nCount;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSocketPoolGetLeasedCount()
+// @Purpose: CRosaSocketPoolȡ
+// @Since: v1.00a
+// @Para: None
+// @Return: int nCount
+//------------------------------------------------------------------
+int ROSASOCKETPOOL_CALLMODE CRosaSocketPool::CRosaSocketPoolGetLeasedCount()
+{
+	CThreadSafe ThreadSafe(&m_csPool);
+	return (int)m_mapLeased.size();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaSocketPoolIsHealthy()
+// @Purpose: CRosaSocketPoolǷ(̽: Զ˹رջݾΪ)
+// @Since: v1.00a
+// @Para: CRosaSocket* pSocket()
+// @Return: bool bRet (true:, false:)
+//------------------------------------------------------------------
+bool ROSASOCKETPOOL_CALLMODE CRosaSocketPool::CRosaSocketPoolIsHealthy(CRosaSocket * pSocket)
+{
+	if (pSocket == NULL || !pSocket->CRosaSocketIsConnected())
+	{
+		return false;
+	}
+
+	// ӺWSAEventSelectΪ
+	char ch = 0;
+	int nRet = recv(pSocket->CRosaSocketGetRawSocket(), &ch, 1, MSG_PEEK);
+
+	if (nRet == SOCKET_ERROR)
+	{
+		return (WSAGetLastError() == WSAEWOULDBLOCK);
+	}
+
+	// 0:ԶѾر, >0:һ
+	return false;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnCheckThread()
+// @Purpose: CRosaSocketPoolӼ߳
+// @Since: v1.00a
+// @Para: void* pParam(CRosaSocketPool)
+// @Return: unsigned
+//------------------------------------------------------------------
+unsigned __stdcall CRosaSocketPool::OnCheckThread(void * pParam)
+{
+	CRosaSocketPool* pThis = reinterpret_cast<CRosaSocketPool*>(pParam);
+
+	while (WaitForSingleObject(pThis->m_hExitEvent, pThis->m_dwCheckMSec) == WAIT_TIMEOUT)
+	{
+		pThis->CRosaSocketPoolEvictIdle();
+	}
+
+	return 0;
+}
@@ -0,0 +1,96 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaSocketPool.h
+* @brief	This File is RosaSocketPool Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSASOCKETPOOL_H__
+#define __CROSASOCKETPOOL_H__
+
+//Include Rosa Header File
+#include "CRosaSocket.h"
+
+//Include C/C++ Header File
+#include <map>
+#include <deque>
+#include <string>
+
+using namespace std;
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSASOCKETPOOL_API	__declspec(dllexport)
+#else
+#define ROSASOCKETPOOL_API	__declspec(dllimport)
+#endif
+
+#define ROSASOCKETPOOL_CALLMODE	__stdcall
+
+#define ROSA_POOL_MAX_IDLE			8				//ÿ˵
+#define ROSA_POOL_MAX_TOTAL			64				//ÿ˵(+)
+#define ROSA_POOL_IDLE_TIMEOUT		60000			//ӳʱ()
+#define ROSA_POOL_CHECK_MSEC		1000			//Ӽ()
+
+//Struct Definition
+typedef struct
+{
+	CRosaSocket* pSocket;					// 
+	ULONGLONG ullIdleSince;					// 黹ʱ
+}S_POOLIDLE, *LPS_POOLIDLE;
+
+typedef struct
+{
+	char chHost[SOB_IP_LENGTH];				// ԶIPַ
+	USHORT sPort;							// Զ˶˿ں
+	deque<S_POOLIDLE> dqIdle;				// (β黹)
+	USHORT sTotal;							// (++)
+	CONDITION_VARIABLE cvIdle;				// ȴ
+}S_POOLENDPOINT, *LPS_POOLENDPOINT;
+
+//Class Definition
+class ROSASOCKETPOOL_API CRosaSocketPool
+{
+public:
+	CRosaSocketPool();			// CRosaSocketPool 캯
+	~CRosaSocketPool();			// CRosaSocketPool 
+
+public:
+	bool ROSASOCKETPOOL_CALLMODE CRosaSocketPoolCreate(USHORT sMaxIdle = ROSA_POOL_MAX_IDLE, USHORT sMaxTotal = ROSA_POOL_MAX_TOTAL, DWORD dwIdleTimeOut = ROSA_POOL_IDLE_TIMEOUT, DWORD dwCheckMSec = ROSA_POOL_CHECK_MSEC);	// CRosaSocketPool ӳؼ߳
+	void ROSASOCKETPOOL_CALLMODE CRosaSocketPoolDestroy();								// CRosaSocketPool رտӲֹͣ߳
+
+	CRosaSocket* ROSASOCKETPOOL_CALLMODE CRosaSocketPoolLease(const char* pcHost, USHORT sPort, USHORT nTimeOutSec = SOB_DEFAULT_TIMEOUT_SEC);	// CRosaSocketPool ӵCRosaSocket
+	bool ROSASOCKETPOOL_CALLMODE CRosaSocketPoolReturn(CRosaSocket* pSocket, bool bReusable = true);											// CRosaSocketPool 黹CRosaSocket(ʱbReusableΪfalse)
+
+	void ROSASOCKETPOOL_CALLMODE CRosaSocketPoolEvictIdle();							// CRosaSocketPool ʱʧЧĿ
+	int ROSASOCKETPOOL_CALLMODE CRosaSocketPoolGetIdleCount();							// CRosaSocketPool ȡ
+	int ROSASOCKETPOOL_CALLMODE CRosaSocketPoolGetLeasedCount();						// CRosaSocketPool ȡ
+
+	static bool ROSASOCKETPOOL_CALLMODE CRosaSocketPoolIsHealthy(CRosaSocket* pSocket);	// CRosaSocketPool Ƿ
+
+private:
+	static unsigned __stdcall OnCheckThread(void* pParam);		// CRosaSocketPool Ӽ߳
+
+private:
+	USHORT m_sMaxIdle;										// CRosaSocketPool ÿ˵
+	USHORT m_sMaxTotal;										// CRosaSocketPool ÿ˵
+	DWORD m_dwIdleTimeOut;									// CRosaSocketPool ӳʱ
+	DWORD m_dwCheckMSec;									// CRosaSocketPool 
+
+	CRITICAL_SECTION m_csPool;								// CRosaSocketPool ӳٽ
+	map<string, LPS_POOLENDPOINT> m_mapEndpoint;			// CRosaSocketPool ˵(IP:˿)
+	map<CRosaSocket*, LPS_POOLENDPOINT> m_mapLeased;		// CRosaSocketPool 
+
+	HANDLE m_hCheckThread;									// CRosaSocketPool ߳
+	HANDLE m_hExitEvent;									// CRosaSocketPool ˳¼
+	volatile bool m_bRunning;								// CRosaSocketPool б־
+
+};
+
+#endif // !__CROSASOCKETPOOL_H__
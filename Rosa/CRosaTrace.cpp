@@ -0,0 +1,251 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaTrace.cpp
+* @brief	This File is RosaTrace Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaTrace.h"
+
+//Include ETW Header File
+#include <TraceLoggingProvider.h>
+#include <winmeta.h>
+
+//CRosaTrace ٵ(ETW TraceLogging̬ٵ㼰ûص, ûиʱٵֻһη֧)
+
+// ETWṩ"Rosa"(ỰʱʹGUID)
+// {d7c1b6e4-5a3f-5b2e-9c41-2f6a8e0d3b17}
+TRACELOGGING_DEFINE_PROVIDER(g_hRosaProvider, "Rosa", (0xd7c1b6e4, 0x5a3f, 0x5b2e, 0x9c, 0x41, 0x2f, 0x6a, 0x8e, 0x0d, 0x3b, 0x17));
+
+volatile LONG CRosaTrace::s_lActive = 0;
+volatile LONG CRosaTrace::s_lEtwEnabled = 0;
+volatile LONG CRosaTrace::s_lRegistered = 0;
+
+LPS_TRACECALLBACK volatile CRosaTrace::s_pCallback = NULL;
+LPS_TRACECALLBACK volatile CRosaTrace::s_pRetired = NULL;
+
+// ٵ
+static const char* g_pcEventName[ROSA_TRACE_COUNT] = { "Accept", "Send", "Recv", "SerialWait", "SerialRead", "SerialWrite", "Lock" };
+
+//------------------------------------------------------------------
+// @Function:	 CRosaTrace()
+// @Purpose: CRosaTrace캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaTrace::CRosaTrace()
+{
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaTrace()
+// @Purpose: CRosaTrace
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaTrace::~CRosaTrace()
+{
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaTraceRegister()
+// @Purpose: CRosaTraceעETWṩ(ظ, עɶ)
+// @Since: v1.00a
+// @Para: None
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool ROSATRACE_CALLMODE CRosaTrace::CRosaTraceRegister()
+{
+	if (InterlockedIncrement(&s_lRegistered) != 1)
+	{
+		return true;
+	}
+
+	// עʱѾڵĻỰҲ֪ͨ
+	if (FAILED(TraceLoggingRegisterEx(g_hRosaProvider, (PENABLECALLBACK)OnEtwEnable, NULL)))
+	{
+		InterlockedDecrement(&s_lRegistered);
+		return false;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaTraceUnregister()
+// @Purpose: CRosaTraceעETWṩ(һעʱЧ)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void ROSATRACE_CALLMODE CRosaTrace::CRosaTraceUnregister()
+{
+	if (InterlockedDecrement(&s_lRegistered) != 0)
+	{
+		return;
+	}
+
+	InterlockedExchange(&s_lEtwEnabled, 0);
+	UpdateActive();
+
+	TraceLoggingUnregister(g_hRosaProvider);
+
+	// CRosaSocketLibRelease֮иٵȡɵĻص
+	LPS_TRACECALLBACK pRetired = (LPS_TRACECALLBACK)InterlockedExchangePointer((PVOID volatile*)&s_pRetired, NULL);
+	while (pRetired)
+	{
+		LPS_TRACECALLBACK pNext = pRetired->pRetired;
+		delete pRetired;
+		pRetired = pNext;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaTraceSetCallback()
+// @Purpose: CRosaTraceøٻص(صûݷͬһ鷢; ȡִеĻصδ)
+// @Since: v1.00a
+// @Para: HANDLE_TRACE_CALLBACK pCallback(ٻص, NULLʾȡ)
+// @Para: DWORD_PTR dwUser(û)
+// @Return: None
+//------------------------------------------------------------------
+void ROSATRACE_CALLMODE CRosaTrace::CRosaTraceSetCallback(HANDLE_TRACE_CALLBACK pCallback, DWORD_PTR dwUser)
+{
+	LPS_TRACECALLBACK pNew = NULL;
+
+	if (pCallback)
+	{
+		pNew = new S_TRACECALLBACK;
+		pNew->pCallback = pCallback;
+		pNew->dwUser = dwUser;
+		pNew->pRetired = NULL;
+	}
+
+	// ص鷢޸, ٵ㲻»صû
+	LPS_TRACECALLBACK pOld = (LPS_TRACECALLBACK)InterlockedExchangePointer((PVOID volatile*)&s_pCallback, pNew);
+
+	UpdateActive();
+
+	// ܸ߳̿նȡ˾ɿ, ͷ
+	if (pOld)
+	{
+		LPS_TRACECALLBACK pHead;
+		do
+		{
+			pHead = s_pRetired;
+			pOld->pRetired = pHead;
+		} while (InterlockedCompareExchangePointer((PVOID volatile*)&s_pRetired, pOld, pHead) != pHead);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaTraceFire()
+// @Purpose: CRosaTraceٵ(дETW¼ûص)
+// @Since: v1.00a
+// @Para: int nEvent(ROSA_TRACE_*)
+// @Para: ULONG_PTR ulHandle(׽//ٽ)
+// @Para: LONG lResult()
+// @Return: None
+//------------------------------------------------------------------
+void ROSATRACE_CALLMODE CRosaTrace::CRosaTraceFire(int nEvent, ULONG_PTR ulHandle, LONG lResult)
+{
+	if (nEvent < 0 || nEvent >= ROSA_TRACE_COUNT)
+	{
+		return;
+	}
+
+	// ٵλϵͳ֮, Ҫȡ
+	DWORD dwLastError = GetLastError();
+
+	if (s_lEtwEnabled)
+	{
+		// ¼Ϊ, ÿٵһؼ, Ự԰ؼֹ
+		switch (nEvent)
+		{
+		case ROSA_TRACE_ACCEPT:
+			TraceLoggingWrite(g_hRosaProvider, "Accept", TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE), TraceLoggingKeyword(1 << ROSA_TRACE_ACCEPT), TraceLoggingValue((ULONGLONG)ulHandle, "Handle"), TraceLoggingValue(lResult, "Result"));
+			break;
+		case ROSA_TRACE_SEND:
+			TraceLoggingWrite(g_hRosaProvider, "Send", TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE), TraceLoggingKeyword(1 << ROSA_TRACE_SEND), TraceLoggingValue((ULONGLONG)ulHandle, "Handle"), TraceLoggingValue(lResult, "Result"));
+			break;
+		case ROSA_TRACE_RECV:
+			TraceLoggingWrite(g_hRosaProvider, "Recv", TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE), TraceLoggingKeyword(1 << ROSA_TRACE_RECV), TraceLoggingValue((ULONGLONG)ulHandle, "Handle"), TraceLoggingValue(lResult, "Result"));
+			break;
+		case ROSA_TRACE_SERIAL_WAIT:
+			TraceLoggingWrite(g_hRosaProvider, "SerialWait", TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE), TraceLoggingKeyword(1 << ROSA_TRACE_SERIAL_WAIT), TraceLoggingValue((ULONGLONG)ulHandle, "Handle"), TraceLoggingValue(lResult, "Result"));
+			break;
+		case ROSA_TRACE_SERIAL_READ:
+			TraceLoggingWrite(g_hRosaProvider, "SerialRead", TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE), TraceLoggingKeyword(1 << ROSA_TRACE_SERIAL_READ), TraceLoggingValue((ULONGLONG)ulHandle, "Handle"), TraceLoggingValue(lResult, "Result"));
+			break;
+		case ROSA_TRACE_SERIAL_WRITE:
+			TraceLoggingWrite(g_hRosaProvider, "SerialWrite", TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE), TraceLoggingKeyword(1 << ROSA_TRACE_SERIAL_WRITE), TraceLoggingValue((ULONGLONG)ulHandle, "Handle"), TraceLoggingValue(lResult, "Result"));
+			break;
+		case ROSA_TRACE_LOCK:
+			TraceLoggingWrite(g_hRosaProvider, "Lock", TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE), TraceLoggingKeyword(1 << ROSA_TRACE_LOCK), TraceLoggingValue((ULONGLONG)ulHandle, "Handle"), TraceLoggingValue(lResult, "Result"));
+			break;
+		default:
+			break;
+		}
+	}
+
+	LPS_TRACECALLBACK pCallback = s_pCallback;
+
+	if (pCallback)
+	{
+		pCallback->pCallback(nEvent, ulHandle, lResult, pCallback->dwUser);
+	}
+
+	SetLastError(dwLastError);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaTraceGetEventName()
+// @Purpose: CRosaTraceȡٵ(ETW¼ͬ)
+// @Since: v1.00a
+// @Para: int nEvent(ROSA_TRACE_*)
+// @Return: const char* pcName
+//------------------------------------------------------------------
+const char * ROSATRACE_CALLMODE CRosaTrace::CRosaTraceGetEventName(int nEvent)
+{
+	if (nEvent < 0 || nEvent >= ROSA_TRACE_COUNT)
+	{
+		return "";
+	}
+
+	return g_pcEventName[nEvent];
+}
+
+//------------------------------------------------------------------
+// @Function:	 UpdateActive()
+// @Purpose: CRosaTrace¼ٵ㿪־
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaTrace::UpdateActive()
+{
+	InterlockedExchange(&s_lActive, (s_lEtwEnabled || s_pCallback != NULL) ? 1 : 0);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnEtwEnable()
+// @Purpose: CRosaTrace ETWỰ/ر֪ͨ(xperf/WPR/tracelogֹͣỰʱ)
+// @Since: v1.00a
+// @Para: ULONG ulIsEnabled(0:ر, 1:, 2:״̬)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaTrace::OnEtwEnable(const GUID * pSourceId, ULONG ulIsEnabled, UCHAR ucLevel, ULONGLONG ullMatchAnyKeyword, ULONGLONG ullMatchAllKeyword, _EVENT_FILTER_DESCRIPTOR * pFilterData, PVOID pContext)
+{
+	if (ulIsEnabled == 2)
+	{
+		return;
+	}
+
+	InterlockedExchange(&s_lEtwEnabled, ulIsEnabled ? 1 : 0);
+	UpdateActive();
+}
@@ -0,0 +1,89 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaTrace.h
+* @brief	This File is RosaTrace Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSATRACE_H__
+#define __CROSATRACE_H__
+
+//Include Windows Header File
+#include <Windows.h>
+
+//Macro Definition
+#ifdef  ROSA_EXPORTS
+#define ROSATRACE_API	__declspec(dllexport)
+#else
+#define ROSATRACE_API	__declspec(dllimport)
+#endif
+
+#define ROSATRACE_CALLMODE	__stdcall
+
+#define ROSA_TRACE_ACCEPT			0			//ٵ:(:׽, :0ɹ/WSA)
+#define ROSA_TRACE_SEND				1			//ٵ:ϵͳ(:׽, :ֽ/SOCKET_ERROR)
+#define ROSA_TRACE_RECV				2			//ٵ:ϵͳ(:׽, :ֽ/0ر/SOCKET_ERROR)
+#define ROSA_TRACE_SERIAL_WAIT		3			//ٵ:WaitCommEvent(:, :¼)
+#define ROSA_TRACE_SERIAL_READ		4			//ٵ:ڶȡ(:, :ֽ/-1ʧ)
+#define ROSA_TRACE_SERIAL_WRITE		5			//ٵ:д(:, :ֽ/-1ʧ)
+#define ROSA_TRACE_LOCK				6			//ٵ:CThreadSafe(:ٽ, :0δ/1)
+#define ROSA_TRACE_COUNT			7
+
+//Callback Definition
+typedef void(__stdcall *HANDLE_TRACE_CALLBACK)(int nEvent, ULONG_PTR ulHandle, LONG lResult, DWORD_PTR dwUser);	//ٻص(ڴ߳ͬ, ٴδٵ)
+
+//Struct Definition
+typedef struct _S_TRACECALLBACK
+{
+	HANDLE_TRACE_CALLBACK pCallback;		// ٻص
+	DWORD_PTR dwUser;						// û
+	struct _S_TRACECALLBACK* pRetired;		// 滻Ļص(ٵڶȡ, һעʱͷ)
+}S_TRACECALLBACK, *LPS_TRACECALLBACK;
+
+//Class Definition
+class ROSATRACE_API CRosaTrace
+{
+public:
+	CRosaTrace();			// CRosaTrace 캯
+	~CRosaTrace();			// CRosaTrace 
+
+public:
+	static bool ROSATRACE_CALLMODE CRosaTraceRegister();											// CRosaTrace עETWṩ(CRosaSocketLibInitʱ)
+	static void ROSATRACE_CALLMODE CRosaTraceUnregister();											// CRosaTrace עETWṩ(CRosaSocketLibReleaseʱ)
+
+	static void ROSATRACE_CALLMODE CRosaTraceSetCallback(HANDLE_TRACE_CALLBACK pCallback, DWORD_PTR dwUser);	// CRosaTrace øٻص(NULLʾȡ)
+	static void ROSATRACE_CALLMODE CRosaTraceFire(int nEvent, ULONG_PTR ulHandle, LONG lResult);	// CRosaTrace ٵ(ROSA_TRACE)
+
+	static const char* ROSATRACE_CALLMODE CRosaTraceGetEventName(int nEvent);						// CRosaTrace ȡٵ
+
+private:
+	static void UpdateActive();												// CRosaTrace ¼ٵ㿪־
+
+	static void __stdcall OnEtwEnable(const GUID* pSourceId, ULONG ulIsEnabled, UCHAR ucLevel, ULONGLONG ullMatchAnyKeyword, ULONGLONG ullMatchAllKeyword, struct _EVENT_FILTER_DESCRIPTOR* pFilterData, PVOID pContext);	// CRosaTrace ETWỰ/ر֪ͨ
+
+public:
+	static volatile LONG s_lActive;			// CRosaTrace ٵ㿪־(ETWỰصʱ0, ٵֻȡֵ)
+
+private:
+	static volatile LONG s_lEtwEnabled;		// CRosaTrace ETWỰ־
+	static volatile LONG s_lRegistered;		// CRosaTrace ETWṩע
+
+	static LPS_TRACECALLBACK volatile s_pCallback;	// CRosaTrace ٻصû(滻, ٵһζȡõɶԵֵ)
+	static LPS_TRACECALLBACK volatile s_pRetired;	// CRosaTrace 滻Ļص
+
+};
+
+// ٵ: ûиʱֻһζȡͷ֧, ROSA_TRACE_DISABLEʱȫȥ
+#ifdef ROSA_TRACE_DISABLE
+#define ROSA_TRACE(nEvent, Handle, lResult)		((void)0)
+#else
+#define ROSA_TRACE(nEvent, Handle, lResult)		do { if (CRosaTrace::s_lActive) CRosaTrace::CRosaTraceFire((nEvent), (ULONG_PTR)(Handle), (LONG)(lResult)); } while (0)
+#endif
+
+#endif // !__CROSATRACE_H__
@@ -10,13 +10,28 @@
 * @date		2018-10-08	v1.00a	alopex	Create This File.
 */
 #include "CThreadSafe.h"
+#include "CRosaTrace.h"
 
 CThreadSafe::CThreadSafe(const CRITICAL_SECTION* pCriticalSection, const bool bThreadSafe)
 {
 	m_pCriticalSection = (CRITICAL_SECTION*)pCriticalSection;
 	m_bThreadSafe = bThreadSafe;
 
-	if (m_bThreadSafe) EnterCriticalSection(m_pCriticalSection);
+	if (!m_bThreadSafe) return;
+
+#ifndef ROSA_TRACE_DISABLE
+	// иʱȳԼ, Ƿ
+	if (CRosaTrace::s_lActive)
+	{
+		BOOL bFree = TryEnterCriticalSection(m_pCriticalSection);
+		if (!bFree) EnterCriticalSection(m_pCriticalSection);
+
+		CRosaTrace::CRosaTraceFire(ROSA_TRACE_LOCK, (ULONG_PTR)m_pCriticalSection, bFree ? 0 : 1);
+		return;
+	}
+#endif
+
+	EnterCriticalSection(m_pCriticalSection);
 }
 
 CThreadSafe::~CThreadSafe()
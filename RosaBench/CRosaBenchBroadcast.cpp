@@ -0,0 +1,426 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchBroadcast.cpp
+* @brief	This File is RosaBenchBroadcast Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchBroadcast.h"
+
+//Include C/C++ Header File
+#include <process.h>
+#include <stdio.h>
+
+//CRosaBenchBroadcast 㲥(ػȳ1KBϢ, 빲ݹ㲥ȳʱʹ)
+
+// ѡ(бʱȡĬֵ)
+static vector<UINT> g_vecBroadcastClient;
+
+// ʽ
+static const char* g_pcBroadcastModeName[ROSABENCH_BROADCAST_COUNT] = { "loop", "broadcast" };
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchBroadcast()
+// @Purpose: CRosaBenchBroadcast캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchBroadcast::CRosaBenchBroadcast()
+{
+	memset(&m_sConfig, 0, sizeof(m_sConfig));
+
+	m_bExit = FALSE;
+
+	InitializeCriticalSection(&m_csAccepted);
+	m_llDelivered = 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchBroadcast()
+// @Purpose: CRosaBenchBroadcast
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchBroadcast::~CRosaBenchBroadcast()
+{
+	DeleteCriticalSection(&m_csAccepted);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchBroadcastRun()
+// @Purpose: CRosaBenchBroadcastһ(һȳ, ͻɶȡ߳̾ȡ)
+// @Since: v1.00a
+// @Para: const S_BROADCASTBENCHCONFIG& sConfig(Բ)
+// @Return: string strJson ()
+//------------------------------------------------------------------
+string CRosaBenchBroadcast::CRosaBenchBroadcastRun(const S_BROADCASTBENCHCONFIG & sConfig)
+{
+	char chHead[512] = { 0 };
+
+	m_sConfig = sConfig;
+	m_sConfig.uiClients = (m_sConfig.uiClients < 1) ? 1 : m_sConfig.uiClients;
+
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"broadcast\",\"mode\":\"%s\",\"clients\":%u,\"size\":%d",
+		CRosaBenchBroadcastGetModeName(m_sConfig.nMode), m_sConfig.uiClients, ROSABENCH_BROADCAST_MESSAGE);
+
+	// ͷʽɼ׽ֶ, 
+	if (!m_Server.CRosaBenchServerStart(m_sConfig.sPort, OnAccept, this))
+	{
+		char chError[128] = { 0 };
+		sprintf_s(chError, sizeof(chError), ",\"error\":\"listen failed (WSA %d)\"}", m_Server.CRosaBenchServerGetError());
+
+		return string("{") + chHead + chError;
+	}
+
+	m_bExit = FALSE;
+	m_llDelivered = 0;
+
+	// ͻ(ԭʼ׽, һʱÿ¼)
+	SOCKADDR_IN addrServer;
+	memset(&addrServer, 0, sizeof(addrServer));
+	addrServer.sin_family = AF_INET;
+	addrServer.sin_port = htons(m_sConfig.sPort);
+	addrServer.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	for (UINT i = 0; i < m_sConfig.uiClients; ++i)
+	{
+		SOCKET s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+		if (s == INVALID_SOCKET)
+		{
+			break;
+		}
+
+		if (connect(s, (SOCKADDR*)&addrServer, sizeof(addrServer)) == SOCKET_ERROR)
+		{
+			closesocket(s);
+			break;
+		}
+
+		m_vecClient.push_back(s);
+	}
+
+	for (DWORD dwWait = 0; dwWait < ROSABENCH_BROADCAST_ACCEPT_WAIT; dwWait += 10)
+	{
+		EnterCriticalSection(&m_csAccepted);
+		size_t nAccepted = m_vecAccepted.size();
+		LeaveCriticalSection(&m_csAccepted);
+
+		if (nAccepted >= m_vecClient.size())
+		{
+			break;
+		}
+
+		Sleep(10);
+	}
+
+	if (m_vecClient.size() < m_sConfig.uiClients || m_vecAccepted.size() < m_vecClient.size())
+	{
+		char chError[128] = { 0 };
+		sprintf_s(chError, sizeof(chError), ",\"error\":\"connected %u, accepted %u\"}", (UINT)m_vecClient.size(), (UINT)m_vecAccepted.size());
+
+		CloseAll();
+		return string("{") + chHead + chError;
+	}
+
+	// ݷʽÿһͶ
+	CRosaEventLoop Loop;
+	CRosaBroadcaster Broadcaster;
+	vector<CRosaSendQueue*> vecQueue;
+
+	if (m_sConfig.nMode == ROSABENCH_BROADCAST_SHARED)
+	{
+		Loop.CRosaEventLoopCreate(ROSABENCH_BROADCAST_LOOP_THREADS);
+
+		for (size_t i = 0; i < m_vecAccepted.size(); ++i)
+		{
+			CRosaSendQueue* pQueue = new CRosaSendQueue();
+			vecQueue.push_back(pQueue);
+
+			if (pQueue->CRosaSendQueueCreate(m_vecAccepted[i], &Loop, NULL, NULL, 0))
+			{
+				Broadcaster.CRosaBroadcasterAdd(pQueue);
+			}
+		}
+	}
+
+	// ȡ߳
+	vector<S_BROADCASTBENCHREADER> vecReader((m_vecClient.size() + ROSABENCH_BROADCAST_POLL_GROUP - 1) / ROSABENCH_BROADCAST_POLL_GROUP);
+	vector<HANDLE> vecThread;
+
+	for (size_t i = 0; i < vecReader.size(); ++i)
+	{
+		vecReader[i].pBench = this;
+		vecReader[i].nBegin = i * ROSABENCH_BROADCAST_POLL_GROUP;
+		vecReader[i].nEnd = min(m_vecClient.size(), (i + 1) * ROSABENCH_BROADCAST_POLL_GROUP);
+
+		HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, OnReaderThread, &vecReader[i], 0, NULL);
+		if (hThread)
+		{
+			vecThread.push_back(hThread);
+		}
+	}
+
+	// 
+	char chMessage[ROSABENCH_BROADCAST_MESSAGE];
+	memset(chMessage, 'R', sizeof(chMessage));
+
+	CRosaHistogram Fanout;
+	Fanout.CRosaHistogramCreate(1);
+
+	LARGE_INTEGER liFrequency;
+	QueryPerformanceFrequency(&liFrequency);
+
+	ULONGLONG ullFanouts = 0;
+	ULONGLONG ullWritten = 0;
+	ULONGLONG ullSkipped = 0;
+
+	S_BENCHCPU sCpu;
+	BenchCpuStart(sCpu);
+
+	LONGLONG llDeadline = CRosaHistogram::CRosaHistogramNow() + liFrequency.QuadPart * m_sConfig.uiSeconds;
+
+	while (CRosaHistogram::CRosaHistogramNow() < llDeadline)
+	{
+		LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+		UINT uiWritten = 0;
+
+		if (m_sConfig.nMode == ROSABENCH_BROADCAST_SHARED)
+		{
+			uiWritten = Broadcaster.CRosaBroadcasterSend(chMessage, sizeof(chMessage));
+		}
+		else
+		{
+			for (size_t i = 0; i < m_vecAccepted.size(); ++i)
+			{
+				if (m_Server.CRosaBenchServerGetSocket()->CRosaSocketSendBuffer(m_vecAccepted[i], chMessage, sizeof(chMessage), 1) == SOB_RET_OK)
+				{
+					uiWritten++;
+				}
+			}
+		}
+
+		Fanout.CRosaHistogramRecordSince(llStart);
+
+		ullFanouts++;
+		ullWritten += uiWritten;
+		ullSkipped += m_vecAccepted.size() - uiWritten;
+	}
+
+	double dSeconds = 0.0;
+	double dCpu = BenchCpuStop(sCpu, dSeconds);
+	LONGLONG llDelivered = m_llDelivered;
+
+	// ƳٷͶ(ʣϢ), ֮رʹȡ߳˳
+	for (size_t i = 0; i < vecQueue.size(); ++i)
+	{
+		Broadcaster.CRosaBroadcasterRemove(vecQueue[i]);
+		vecQueue[i]->CRosaSendQueueDestroy();
+		delete vecQueue[i];
+	}
+	vecQueue.clear();
+
+	Loop.CRosaEventLoopDestroy();
+
+	m_bExit = TRUE;
+	for (size_t i = 0; i < vecThread.size(); ++i)
+	{
+		WaitForSingleObject(vecThread[i], INFINITE);
+		CloseHandle(vecThread[i]);
+	}
+
+	CloseAll();
+
+	// ʹ = ͻյϢ / дϢ
+	double dDelivered = (double)llDelivered / ROSABENCH_BROADCAST_MESSAGE;
+
+	char chResult[512] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"seconds\":%.3f,\"fanouts\":%llu,\"fanouts_per_sec\":%.1f,\"written\":%llu,\"skipped\":%llu,\"deliveries_per_sec\":%.1f,\"delivered_ratio\":%.4f,\"cpu_percent\":%.1f,\"fanout_ns\":",
+		dSeconds, ullFanouts, (dSeconds > 0.0) ? ullFanouts / dSeconds : 0.0, ullWritten, ullSkipped,
+		(dSeconds > 0.0) ? dDelivered / dSeconds : 0.0, ullWritten ? dDelivered / ullWritten : 0.0, dCpu);
+
+	return string("{") + chHead + chResult + BenchSummaryJson(Fanout) + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchBroadcastGetModeName()
+// @Purpose: CRosaBenchBroadcastȡ㲥ʽ
+// @Since: v1.00a
+// @Para: int nMode(ROSABENCH_BROADCAST_*)
+// @Return: const char* pcName
+//------------------------------------------------------------------
+const char * CRosaBenchBroadcast::CRosaBenchBroadcastGetModeName(int nMode)
+{
+	if (nMode < 0 || nMode >= ROSABENCH_BROADCAST_COUNT)
+	{
+		return "";
+	}
+
+	return g_pcBroadcastModeName[nMode];
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAccept()
+// @Purpose: CRosaBenchBroadcast
+// @Since: v1.00a
+// @Para: void* pContext(Զ)
+// @Para: SOCKET s(ͻ׽)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchBroadcast::OnAccept(void * pContext, SOCKET s, USHORT nShard)
+{
+	CRosaBenchBroadcast* pBench = reinterpret_cast<CRosaBenchBroadcast*>(pContext);
+
+	EnterCriticalSection(&pBench->m_csAccepted);
+	pBench->m_vecAccepted.push_back(s);
+	LeaveCriticalSection(&pBench->m_csAccepted);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnReaderThread()
+// @Purpose: CRosaBenchBroadcastȡ߳(WSAPollһͻ, ˳־λ󷵻)
+// @Since: v1.00a
+// @Para: void* pParam(S_BROADCASTBENCHREADER)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchBroadcast::OnReaderThread(void * pParam)
+{
+	LPS_BROADCASTBENCHREADER pReader = reinterpret_cast<LPS_BROADCASTBENCHREADER>(pParam);
+	CRosaBenchBroadcast* pBench = pReader->pBench;
+
+	vector<WSAPOLLFD> vecPoll;
+	for (size_t i = pReader->nBegin; i < pReader->nEnd; ++i)
+	{
+		WSAPOLLFD sPoll = { pBench->m_vecClient[i], POLLRDNORM, 0 };
+		vecPoll.push_back(sPoll);
+	}
+
+	char* pBuffer = new char[ROSABENCH_BROADCAST_RECV_BUFFER];
+
+	while (!pBench->m_bExit && !vecPoll.empty())
+	{
+		if (WSAPoll(&vecPoll[0], (ULONG)vecPoll.size(), 10) <= 0)
+		{
+			continue;
+		}
+
+		for (size_t i = 0; i < vecPoll.size(); ++i)
+		{
+			if (vecPoll[i].revents == 0)
+			{
+				continue;
+			}
+
+			int nRecv = recv(vecPoll[i].fd, pBuffer, ROSABENCH_BROADCAST_RECV_BUFFER, 0);
+			if (nRecv <= 0)
+			{
+				vecPoll[i].events = 0;
+				continue;
+			}
+
+			InterlockedExchangeAdd64(&pBench->m_llDelivered, nRecv);
+		}
+	}
+
+	delete[] pBuffer;
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CloseAll()
+// @Purpose: CRosaBenchBroadcastر˫(ر, TIME_WAIT)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchBroadcast::CloseAll()
+{
+	LINGER sLinger = { 1, 0 };
+
+	EnterCriticalSection(&m_csAccepted);
+	for (vector<SOCKET>::iterator iter = m_vecAccepted.begin(); iter != m_vecAccepted.end(); ++iter)
+	{
+		setsockopt(*iter, SOL_SOCKET, SO_LINGER, (char*)&sLinger, sizeof(sLinger));
+		closesocket(*iter);
+	}
+	m_vecAccepted.clear();
+	LeaveCriticalSection(&m_csAccepted);
+
+	for (vector<SOCKET>::iterator iter = m_vecClient.begin(); iter != m_vecClient.end(); ++iter)
+	{
+		setsockopt(*iter, SOL_SOCKET, SO_LINGER, (char*)&sLinger, sizeof(sLinger));
+		closesocket(*iter);
+	}
+	m_vecClient.clear();
+
+	m_Server.CRosaBenchServerStop();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchBroadcastUsage()
+// @Purpose: CRosaBenchBroadcastѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchBroadcast::CRosaBenchBroadcastUsage()
+{
+	fprintf(stderr,
+		"  --broadcast-clients <list> loopback clients receiving each 1 KB fan-out (default: " ROSABENCH_DEFAULT_BROADCAST_CLIENTS ")\n");
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchBroadcastParse()
+// @Purpose: CRosaBenchBroadcastѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchBroadcast::CRosaBenchBroadcastParse(const char * pcArg, const char * pcValue)
+{
+	bool bOk = false;
+
+	if (strcmp(pcArg, "--broadcast-clients") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecBroadcastClient);
+	}
+	else
+	{
+		return ROSABENCH_PARSE_UNKNOWN;
+	}
+
+	return bOk ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchBroadcastMain()
+// @Purpose: CRosaBenchBroadcastȫ(ͻ*㲥ʽ)
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchBroadcast::CRosaBenchBroadcastMain(const S_BENCHCOMMON & sCommon)
+{
+	if (g_vecBroadcastClient.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_BROADCAST_CLIENTS, g_vecBroadcastClient);
+	}
+
+	CRosaBenchBroadcast BenchBroadcast;
+
+	for (size_t c = 0; c < g_vecBroadcastClient.size(); ++c)
+	{
+		for (int m = 0; m < ROSABENCH_BROADCAST_COUNT; ++m)
+		{
+			S_BROADCASTBENCHCONFIG sConfig = { m, g_vecBroadcastClient[c], sCommon.uiSeconds, sCommon.sPort };
+			BenchOutput(BenchBroadcast.CRosaBenchBroadcastRun(sConfig));
+		}
+	}
+}
@@ -0,0 +1,92 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchBroadcast.h
+* @brief	This File is RosaBenchBroadcast Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHBROADCAST_H__
+#define __CROSABENCHBROADCAST_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Include Rosa Header File
+#include "../Rosa/CRosaEventLoop.h"
+#include "../Rosa/CRosaSendQueue.h"
+#include "../Rosa/CRosaBroadcaster.h"
+
+//Macro Definition
+#define ROSABENCH_BROADCAST_LOOP		0				//:CRosaSocketSendBuffer(ԭ)
+#define ROSABENCH_BROADCAST_SHARED		1				//:CRosaBroadcasterSend(һ, ˮλ)
+#define ROSABENCH_BROADCAST_COUNT		2
+
+#define ROSABENCH_BROADCAST_MESSAGE		1024			//Ϣ
+#define ROSABENCH_BROADCAST_LOOP_THREADS	2			//Ͷ¼ѭ߳
+#define ROSABENCH_BROADCAST_POLL_GROUP	1024			//ÿȡ̸߳Ŀͻ
+#define ROSABENCH_BROADCAST_RECV_BUFFER	(64 * 1024)		//ȡ߳̽ջ峤
+#define ROSABENCH_BROADCAST_ACCEPT_WAIT	15000			//ȴȫӱܵʱ()
+
+#define ROSABENCH_DEFAULT_BROADCAST_CLIENTS	"1K,10K"	//ĬϿͻ
+
+//Struct Definition
+typedef struct
+{
+	int nMode;					// 㲥ʽ(ROSABENCH_BROADCAST_*)
+	UINT uiClients;				// ͻ
+	UINT uiSeconds;				// ʱ
+	USHORT sPort;				// ˿
+}S_BROADCASTBENCHCONFIG, *LPS_BROADCASTBENCHCONFIG;
+
+//Class Declaration
+class CRosaBenchBroadcast;
+
+typedef struct
+{
+	CRosaBenchBroadcast* pBench;	// 
+	size_t nBegin;					// Ŀͻʼ
+	size_t nEnd;					// Ŀͻӽ()
+}S_BROADCASTBENCHREADER, *LPS_BROADCASTBENCHREADER;
+
+//Class Definition
+class CRosaBenchBroadcast
+{
+public:
+	CRosaBenchBroadcast();		// CRosaBenchBroadcast 캯
+	~CRosaBenchBroadcast();		// CRosaBenchBroadcast 
+
+public:
+	string CRosaBenchBroadcastRun(const S_BROADCASTBENCHCONFIG& sConfig);	// CRosaBenchBroadcast һ(JSON)
+
+	static const char* CRosaBenchBroadcastGetModeName(int nMode);			// CRosaBenchBroadcast ȡ㲥ʽ
+
+	static void CRosaBenchBroadcastUsage();												// CRosaBenchBroadcast ѡ˵
+	static int CRosaBenchBroadcastParse(const char* pcArg, const char* pcValue);			// CRosaBenchBroadcast ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchBroadcastMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchBroadcast ȫ
+
+private:
+	static void OnAccept(void* pContext, SOCKET s, USHORT nShard);							// CRosaBenchBroadcast 
+	static unsigned __stdcall OnReaderThread(void* pParam);									// CRosaBenchBroadcast ȡ߳(һͻ)
+
+	void CloseAll();												// CRosaBenchBroadcast ر˫
+
+private:
+	S_BROADCASTBENCHCONFIG m_sConfig;			// CRosaBenchBroadcast ǰԲ
+
+	CRosaBenchServer m_Server;					// CRosaBenchBroadcast (ÿ¼, ԭɼ׽ֶ)
+	BOOL m_bExit;								// CRosaBenchBroadcast ȡ߳˳־
+
+	CRITICAL_SECTION m_csAccepted;				// CRosaBenchBroadcast ѽٽ
+	vector<SOCKET> m_vecAccepted;				// CRosaBenchBroadcast 
+	vector<SOCKET> m_vecClient;					// CRosaBenchBroadcast ͻ
+	volatile LONGLONG m_llDelivered;			// CRosaBenchBroadcast ȫͻյֽ
+
+};
+
+#endif // !__CROSABENCHBROADCAST_H__
@@ -0,0 +1,460 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchBulk.cpp
+* @brief	This File is RosaBenchBulk Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchBulk.h"
+
+//Include C/C++ Header File
+#include <limits.h>
+#include <process.h>
+#include <stdio.h>
+
+//CRosaBenchBulk 鷢Ͳ(塢TransmitFile㿽͵¼ÿGBCPUʱ, ظȷ)
+
+// ѡ(бʱȡĬֵ)
+static vector<UINT> g_vecBulkSize;
+
+// ʽ
+static const char* g_pcBulkModeName[ROSABENCH_BULK_COUNT] = { "buffer", "sendfile", "zerocopy" };
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchBulk()
+// @Purpose: CRosaBenchBulk캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchBulk::CRosaBenchBulk()
+{
+	memset(&m_sConfig, 0, sizeof(m_sConfig));
+	m_ullSize = 0;
+
+	m_lServerConn = 0;
+
+	m_ullFileSize = 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchBulk()
+// @Purpose: CRosaBenchBulk(ɾʱļ)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchBulk::~CRosaBenchBulk()
+{
+	if (!m_strFile.empty())
+	{
+		DeleteFileA(m_strFile.c_str());
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchBulkRun()
+// @Purpose: CRosaBenchBulkһ(һ, ÿεȴȷ)
+// @Since: v1.00a
+// @Para: const S_BULKBENCHCONFIG& sConfig(Բ)
+// @Return: string strJson (, ʧʱԭ)
+//------------------------------------------------------------------
+string CRosaBenchBulk::CRosaBenchBulkRun(const S_BULKBENCHCONFIG & sConfig)
+{
+	char chHead[512] = { 0 };
+
+	m_sConfig = sConfig;
+	m_ullSize = (ULONGLONG)m_sConfig.uiSizeMB * 1024 * 1024;
+
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"bulk\",\"mode\":\"%s\",\"size_mb\":%u",
+		CRosaBenchBulkGetModeName(m_sConfig.nMode), m_sConfig.uiSizeMB);
+
+	// 㿽ʽ黺ڴ, ෽ʽʹļ
+	char* pBuffer = NULL;
+
+	if (m_sConfig.nMode == ROSABENCH_BULK_ZEROCOPY)
+	{
+		if (m_sConfig.uiSizeMB > m_sConfig.uiMaxMemoryMB || m_ullSize > UINT_MAX)
+		{
+			return string("{") + chHead + ",\"skipped\":\"buffer exceeds --max-memory\"}";
+		}
+
+		pBuffer = (char*)VirtualAlloc(NULL, (SIZE_T)m_ullSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+		if (pBuffer == NULL)
+		{
+			return string("{") + chHead + ",\"skipped\":\"buffer allocation failed\"}";
+		}
+
+		memset(pBuffer, 'R', (size_t)m_ullSize);
+	}
+	else
+	{
+		if (!PrepareFile(m_ullSize))
+		{
+			return string("{") + chHead + ",\"error\":\"temp file\"}";
+		}
+
+		pBuffer = new char[ROSABENCH_BULK_CHUNK];
+	}
+
+	// 
+	m_lServerConn = 0;
+
+	if (!m_Server.CRosaBenchServerStart(m_sConfig.sPort, OnAccept, this))
+	{
+		char chError[128] = { 0 };
+		sprintf_s(chError, sizeof(chError), ",\"error\":\"listen failed (WSA %d)\"}", m_Server.CRosaBenchServerGetError());
+
+		FreeBuffer(pBuffer);
+		return string("{") + chHead + chError;
+	}
+
+	// , һ
+	CRosaSocket Client;
+	CRosaHistogram Transfer;
+	Transfer.CRosaHistogramCreate(1);
+
+	ULONGLONG ullTransfers = 0;
+	ULONGLONG ullErrors = 0;
+	double dSeconds = 0.0;
+	double dCpu = 0.0;
+
+	if (Client.CRosaSocketConnect("127.0.0.1", m_sConfig.sPort))
+	{
+		LARGE_INTEGER liFrequency;
+		QueryPerformanceFrequency(&liFrequency);
+
+		S_BENCHCPU sCpu;
+		BenchCpuStart(sCpu);
+
+		LONGLONG llDeadline = CRosaHistogram::CRosaHistogramNow() + liFrequency.QuadPart * m_sConfig.uiSeconds;
+
+		do
+		{
+			LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+			ULONGLONG ullAck = 0;
+
+			if (SendOnce(&Client, pBuffer) != SOB_RET_OK ||
+				Client.CRosaSocketRecvBuffer((char*)&ullAck, sizeof(ullAck), sizeof(ullAck), ROSABENCH_BULK_TIMEOUT) != SOB_RET_OK || ullAck != m_ullSize)
+			{
+				ullErrors++;
+				break;
+			}
+
+			Transfer.CRosaHistogramRecordSince(llStart);
+			ullTransfers++;
+
+		} while (CRosaHistogram::CRosaHistogramNow() < llDeadline);
+
+		dCpu = BenchCpuStop(sCpu, dSeconds);
+
+		Client.CRosaSocketDisConnect();
+	}
+	else
+	{
+		ullErrors++;
+	}
+
+	// ֹͣ(߳1ڷ), ߳ڿͻ˶Ͽ˳
+	m_Server.CRosaBenchServerStop();
+
+	for (DWORD dwWait = 0; m_lServerConn > 0 && dwWait < ROSABENCH_BULK_TIMEOUT * 1000; dwWait += 10)
+	{
+		Sleep(10);
+	}
+
+	FreeBuffer(pBuffer);
+
+	// ÿGBCPUʱ(ȫʱ, ˽)
+	SYSTEM_INFO sInfo;
+	GetSystemInfo(&sInfo);
+
+	double dGB = (double)m_ullSize * ullTransfers / (1024.0 * 1024.0 * 1024.0);
+	double dCpuSeconds = dCpu / 100.0 * sInfo.dwNumberOfProcessors * dSeconds;
+
+	char chResult[512] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"seconds\":%.3f,\"transfers\":%llu,\"errors\":%llu,\"mb_per_sec\":%.1f,\"cpu_percent\":%.1f,\"cpu_sec_per_gb\":%.3f,\"transfer_ns\":",
+		dSeconds, ullTransfers, ullErrors, (dSeconds > 0.0) ? dGB * 1024.0 / dSeconds : 0.0, dCpu, (dGB > 0.0) ? dCpuSeconds / dGB : 0.0);
+
+	return string("{") + chHead + chResult + BenchSummaryJson(Transfer) + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchBulkGetModeName()
+// @Purpose: CRosaBenchBulkȡͷʽ
+// @Since: v1.00a
+// @Para: int nMode(ROSABENCH_BULK_*)
+// @Return: const char* pcName
+//------------------------------------------------------------------
+const char * CRosaBenchBulk::CRosaBenchBulkGetModeName(int nMode)
+{
+	if (nMode < 0 || nMode >= ROSABENCH_BULK_COUNT)
+	{
+		return "";
+	}
+
+	return g_pcBulkModeName[nMode];
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAccept()
+// @Purpose: CRosaBenchBulk
+// @Since: v1.00a
+// @Para: void* pContext(Զ)
+// @Para: SOCKET s(ͻ׽)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchBulk::OnAccept(void * pContext, SOCKET s, USHORT nShard)
+{
+	CRosaBenchBulk* pBench = reinterpret_cast<CRosaBenchBulk*>(pContext);
+
+	BenchStartConnThread(OnServerConn, pBench, s, pBench->m_lServerConn);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnServerConn()
+// @Purpose: CRosaBenchBulk߳(ÿһδ䳤Ȼظյֽ, ͻ˹رպ˳)
+// @Since: v1.00a
+// @Para: void* pParam(S_BENCHCONN)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchBulk::OnServerConn(void * pParam)
+{
+	LPS_BENCHCONN pConn = reinterpret_cast<LPS_BENCHCONN>(pParam);
+	CRosaBenchBulk* pBench = reinterpret_cast<CRosaBenchBulk*>(pConn->pContext);
+
+	CRosaSocket Conn;
+	Conn.CRosaSocketAttachRawSocket(pConn->Socket, true);
+	delete pConn;
+
+	char* pBuffer = new char[ROSABENCH_BULK_RECV_BUFFER];
+	ULONGLONG ullReceived = 0;
+
+	while (true)
+	{
+		ULONGLONG ullRemain = pBench->m_ullSize - ullReceived;
+		UINT uiRecv = 0;
+
+		int nRet = Conn.CRosaSocketRecvOnce(pBuffer, (UINT)min(ullRemain, (ULONGLONG)ROSABENCH_BULK_RECV_BUFFER), uiRecv, ROSABENCH_BULK_TIMEOUT);
+		if (nRet != SOB_RET_OK || uiRecv == 0)
+		{
+			break;
+		}
+
+		ullReceived += uiRecv;
+
+		if (ullReceived == pBench->m_ullSize)
+		{
+			if (Conn.CRosaSocketSendBuffer((char*)&ullReceived, sizeof(ullReceived)) != SOB_RET_OK)
+			{
+				break;
+			}
+
+			ullReceived = 0;
+		}
+	}
+
+	delete[] pBuffer;
+
+	InterlockedDecrement(&pBench->m_lServerConn);
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 PrepareFile()
+// @Purpose: CRosaBenchBulkָȵʱļ(ͬʱ, һδ֮ļϵͳ)
+// @Since: v1.00a
+// @Para: ULONGLONG ullSize(ļ)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool CRosaBenchBulk::PrepareFile(ULONGLONG ullSize)
+{
+	if (!m_strFile.empty() && m_ullFileSize == ullSize)
+	{
+		return true;
+	}
+
+	if (m_strFile.empty())
+	{
+		char chTemp[MAX_PATH] = { 0 };
+		char chPath[MAX_PATH + 64] = { 0 };
+
+		if (GetTempPathA(sizeof(chTemp), chTemp) == 0)
+		{
+			return false;
+		}
+
+		sprintf_s(chPath, sizeof(chPath), "%sRosaBench.%lu.bulk", chTemp, GetCurrentProcessId());
+		m_strFile = chPath;
+	}
+
+	m_ullFileSize = 0;
+
+	HANDLE hFile = CreateFileA(m_strFile.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	char* pChunk = new char[ROSABENCH_BULK_CHUNK];
+	memset(pChunk, 'R', ROSABENCH_BULK_CHUNK);
+
+	bool bOk = true;
+
+	for (ULONGLONG ullWritten = 0; ullWritten < ullSize && bOk; )
+	{
+		DWORD dwChunk = (DWORD)min(ullSize - ullWritten, (ULONGLONG)ROSABENCH_BULK_CHUNK);
+		DWORD dwWritten = 0;
+
+		bOk = (WriteFile(hFile, pChunk, dwChunk, &dwWritten, NULL) && dwWritten == dwChunk);
+		ullWritten += dwWritten;
+	}
+
+	delete[] pChunk;
+	CloseHandle(hFile);
+
+	if (bOk)
+	{
+		m_ullFileSize = ullSize;
+	}
+
+	return bOk;
+}
+
+//------------------------------------------------------------------
+// @Function:	 FreeBuffer()
+// @Purpose: CRosaBenchBulkͷŷͻ(㿽ʽΪVirtualAlloc)
+// @Since: v1.00a
+// @Para: char* pBuffer(ͻ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchBulk::FreeBuffer(char * pBuffer)
+{
+	if (m_sConfig.nMode == ROSABENCH_BULK_ZEROCOPY)
+	{
+		VirtualFree(pBuffer, 0, MEM_RELEASE);
+	}
+	else
+	{
+		delete[] pBuffer;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 SendOnce()
+// @Purpose: CRosaBenchBulkǰʽһ
+// @Since: v1.00a
+// @Para: CRosaSocket* pConn(ӵĿͻ)
+// @Para: char* pBuffer(㿽ʽΪ, 巽ʽΪȡ)
+// @Return: int nRet (SOB_RET_*)
+//------------------------------------------------------------------
+int CRosaBenchBulk::SendOnce(CRosaSocket * pConn, char * pBuffer)
+{
+	if (m_sConfig.nMode == ROSABENCH_BULK_SENDFILE)
+	{
+		return pConn->CRosaSocketSendFile(m_strFile.c_str(), 0, 0, ROSABENCH_BULK_TIMEOUT);
+	}
+
+	if (m_sConfig.nMode == ROSABENCH_BULK_ZEROCOPY)
+	{
+		return pConn->CRosaSocketSendZeroCopy(pBuffer, (UINT)m_ullSize, ROSABENCH_BULK_TIMEOUT);
+	}
+
+	// 巽ʽ: ļûٸƵں
+	HANDLE hFile = CreateFileA(m_strFile.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+	{
+		return SOB_RET_FAIL;
+	}
+
+	int nRet = SOB_RET_OK;
+
+	while (nRet == SOB_RET_OK)
+	{
+		DWORD dwRead = 0;
+		if (!ReadFile(hFile, pBuffer, ROSABENCH_BULK_CHUNK, &dwRead, NULL))
+		{
+			nRet = SOB_RET_FAIL;
+			break;
+		}
+
+		if (dwRead == 0)
+		{
+			break;
+		}
+
+		nRet = pConn->CRosaSocketSendBuffer(pBuffer, dwRead, ROSABENCH_BULK_TIMEOUT);
+	}
+
+	CloseHandle(hFile);
+
+	return nRet;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchBulkUsage()
+// @Purpose: CRosaBenchBulkѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchBulk::CRosaBenchBulkUsage()
+{
+	fprintf(stderr,
+		"  --bulk-sizes <list>    bulk transfer sizes in MB, buffer vs sendfile vs zerocopy (default: " ROSABENCH_DEFAULT_BULK_SIZES ")\n");
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchBulkParse()
+// @Purpose: CRosaBenchBulkѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchBulk::CRosaBenchBulkParse(const char * pcArg, const char * pcValue)
+{
+	bool bOk = false;
+
+	if (strcmp(pcArg, "--bulk-sizes") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecBulkSize);
+	}
+	else
+	{
+		return ROSABENCH_PARSE_UNKNOWN;
+	}
+
+	return bOk ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchBulkMain()
+// @Purpose: CRosaBenchBulkȫ(䳤*ͷʽ)
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchBulk::CRosaBenchBulkMain(const S_BENCHCOMMON & sCommon)
+{
+	if (g_vecBulkSize.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_BULK_SIZES, g_vecBulkSize);
+	}
+
+	CRosaBenchBulk BenchBulk;
+
+	for (size_t s = 0; s < g_vecBulkSize.size(); ++s)
+	{
+		for (int m = 0; m < ROSABENCH_BULK_COUNT; ++m)
+		{
+			S_BULKBENCHCONFIG sConfig = { m, g_vecBulkSize[s], sCommon.uiSeconds, sCommon.uiMaxMemory, sCommon.sPort };
+			BenchOutput(BenchBulk.CRosaBenchBulkRun(sConfig));
+		}
+	}
+}
@@ -0,0 +1,78 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchBulk.h
+* @brief	This File is RosaBenchBulk Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHBULK_H__
+#define __CROSABENCHBULK_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Macro Definition
+#define ROSABENCH_BULK_BUFFER			0				//ͻ:ļûCRosaSocketSendBuffer(ԭ)
+#define ROSABENCH_BULK_SENDFILE			1				//ͻ:CRosaSocketSendFile(TransmitFile, ļݲû)
+#define ROSABENCH_BULK_ZEROCOPY			2				//ͻ:ûCRosaSocketSendZeroCopy
+#define ROSABENCH_BULK_COUNT			3
+
+#define ROSABENCH_BULK_CHUNK			(64 * 1024)		//巽ʽÿζȡͳ
+#define ROSABENCH_BULK_RECV_BUFFER		(256 * 1024)	//˽ջ峤
+#define ROSABENCH_BULK_TIMEOUT			30				//ηͼȴȷϵĳʱ()
+
+#define ROSABENCH_DEFAULT_BULK_SIZES	"1,64,1024"		//Ĭϴ䳤(MB)
+
+//Struct Definition
+typedef struct
+{
+	int nMode;					// ͷʽ(ROSABENCH_BULK_*)
+	UINT uiSizeMB;				// 䳤(MB)
+	UINT uiSeconds;				// ʱ(һδ)
+	UINT uiMaxMemoryMB;			// 㿽ʽ
+	USHORT sPort;				// ˿
+}S_BULKBENCHCONFIG, *LPS_BULKBENCHCONFIG;
+
+//Class Definition
+class CRosaBenchBulk
+{
+public:
+	CRosaBenchBulk();			// CRosaBenchBulk 캯
+	~CRosaBenchBulk();			// CRosaBenchBulk 
+
+public:
+	string CRosaBenchBulkRun(const S_BULKBENCHCONFIG& sConfig);		// CRosaBenchBulk һ(JSON)
+
+	static const char* CRosaBenchBulkGetModeName(int nMode);			// CRosaBenchBulk ȡͷʽ
+
+	static void CRosaBenchBulkUsage();												// CRosaBenchBulk ѡ˵
+	static int CRosaBenchBulkParse(const char* pcArg, const char* pcValue);			// CRosaBenchBulk ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchBulkMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchBulk ȫ
+
+private:
+	static void OnAccept(void* pContext, SOCKET s, USHORT nShard);							// CRosaBenchBulk 
+	static unsigned __stdcall OnServerConn(void* pParam);									// CRosaBenchBulk ߳(ղȷ)
+
+	bool PrepareFile(ULONGLONG ullSize);							// CRosaBenchBulk ָȵʱļ(ͬʱ)
+	void FreeBuffer(char* pBuffer);									// CRosaBenchBulk ͷŷͻ
+	int SendOnce(CRosaSocket* pConn, char* pBuffer);				// CRosaBenchBulk ǰʽһ
+
+private:
+	S_BULKBENCHCONFIG m_sConfig;				// CRosaBenchBulk ǰԲ
+	ULONGLONG m_ullSize;						// CRosaBenchBulk ǰ䳤
+
+	CRosaBenchServer m_Server;					// CRosaBenchBulk (ÿ¼)
+	volatile LONG m_lServerConn;				// CRosaBenchBulk ߳
+
+	string m_strFile;							// CRosaBenchBulk ʱļ·
+	ULONGLONG m_ullFileSize;					// CRosaBenchBulk ʱļ
+
+};
+
+#endif // !__CROSABENCHBULK_H__
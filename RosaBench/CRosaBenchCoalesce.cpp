@@ -0,0 +1,417 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchCoalesce.cpp
+* @brief	This File is RosaBenchCoalesce Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchCoalesce.h"
+
+//Include Windows Header File
+#include <iphlpapi.h>
+
+//Include C/C++ Header File
+#include <process.h>
+#include <stdio.h>
+
+//Include Windows Library
+#pragma comment(lib, "iphlpapi.lib")
+
+//CRosaBenchCoalesce СϢϲ(CRosaCoalescerϲ͵ÿϢʹ/TCPֶ¼ӳ)
+
+// ѡ(бʱȡĬֵ)
+static vector<UINT> g_vecCoalesceSize;
+static vector<UINT> g_vecCoalesceRate;
+
+// ʽ
+static const char* g_pcCoalesceModeName[ROSABENCH_COALESCE_COUNT] = { "nodelay", "nagle", "loop", "cork", "urgent" };
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchCoalesce()
+// @Purpose: CRosaBenchCoalesce캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchCoalesce::CRosaBenchCoalesce()
+{
+	memset(&m_sConfig, 0, sizeof(m_sConfig));
+
+	m_lServerConn = 0;
+
+	m_llReceived = 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchCoalesce()
+// @Purpose: CRosaBenchCoalesce
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchCoalesce::~CRosaBenchCoalesce()
+{
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchCoalesceRun()
+// @Purpose: CRosaBenchCoalesceһ(һϰд붨Ϣ, ˰Ϣзֲ¼ӳ)
+// @Since: v1.00a
+// @Para: const S_COALESCEBENCHCONFIG& sConfig(Բ)
+// @Return: string strJson ()
+//------------------------------------------------------------------
+string CRosaBenchCoalesce::CRosaBenchCoalesceRun(const S_COALESCEBENCHCONFIG & sConfig)
+{
+	char chHead[512] = { 0 };
+
+	m_sConfig = sConfig;
+	m_sConfig.uiSize = max(m_sConfig.uiSize, (UINT)sizeof(LONGLONG));
+
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"coalesce\",\"mode\":\"%s\",\"size\":%u,\"rate\":%u",
+		CRosaBenchCoalesceGetModeName(m_sConfig.nMode), m_sConfig.uiSize, m_sConfig.uiRate);
+
+	// 
+	m_lServerConn = 0;
+	m_llReceived = 0;
+	m_Latency.CRosaHistogramCreate(1);
+
+	if (!m_Server.CRosaBenchServerStart(m_sConfig.sPort, OnAccept, this))
+	{
+		char chError[128] = { 0 };
+		sprintf_s(chError, sizeof(chError), ",\"error\":\"listen failed (WSA %d)\"}", m_Server.CRosaBenchServerGetError());
+
+		return string("{") + chHead + chError;
+	}
+
+	// ͻ(ϲʽʹһ¼ѭ߳)
+	CRosaSocket Client;
+	CRosaEventLoop Loop;
+	CRosaCoalescer Coalescer;
+
+	bool bCoalescer = (m_sConfig.nMode == ROSABENCH_COALESCE_LOOP || m_sConfig.nMode == ROSABENCH_COALESCE_CORK || m_sConfig.nMode == ROSABENCH_COALESCE_URGENT);
+	bool bConnected = Client.CRosaSocketConnect("127.0.0.1", m_sConfig.sPort);
+
+	if (bConnected && m_sConfig.nMode == ROSABENCH_COALESCE_NAGLE)
+	{
+		Client.CRosaSocketSetNoDelay(false);
+	}
+
+	if (bConnected && bCoalescer)
+	{
+		DWORD dwDelayUSec = (m_sConfig.nMode == ROSABENCH_COALESCE_CORK) ? ROSA_COALESCE_DELAY_USEC : 0;
+
+		bConnected = Loop.CRosaEventLoopCreate(1) &&
+			Coalescer.CRosaCoalescerCreate(Client.CRosaSocketGetRawSocket(), &Loop, ROSA_COALESCE_MAX_BYTES, dwDelayUSec);
+
+		if (bConnected && m_sConfig.nMode == ROSABENCH_COALESCE_CORK)
+		{
+			Coalescer.CRosaCoalescerCork();
+		}
+	}
+
+	ULONGLONG ullSent = 0;
+	ULONGLONG ullSends = 0;
+	ULONGLONG ullErrors = 0;
+	double dSeconds = 0.0;
+	double dCpu = 0.0;
+	DWORD dwSegments = 0;
+
+	if (bConnected)
+	{
+		char* pBuffer = new char[m_sConfig.uiSize];
+		memset(pBuffer, 'R', m_sConfig.uiSize);
+
+		LARGE_INTEGER liFrequency;
+		QueryPerformanceFrequency(&liFrequency);
+
+		double dInterval = (m_sConfig.uiRate > 0) ? (double)liFrequency.QuadPart / m_sConfig.uiRate : 0.0;
+
+		DWORD dwSegStart = TcpOutSegments();
+
+		S_BENCHCPU sCpu;
+		BenchCpuStart(sCpu);
+
+		LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+		LONGLONG llDeadline = llStart + liFrequency.QuadPart * m_sConfig.uiSeconds;
+
+		for (;;)
+		{
+			LONGLONG llNow = CRosaHistogram::CRosaHistogramNow();
+			if (llNow >= llDeadline)
+			{
+				break;
+			}
+
+			if (dInterval > 0.0 && llNow < llStart + (LONGLONG)(ullSent * dInterval))
+			{
+				SwitchToThread();
+				continue;
+			}
+
+			*(LONGLONG*)pBuffer = llNow;
+
+			int nRet = SOB_RET_OK;
+
+			switch (m_sConfig.nMode)
+			{
+			case ROSABENCH_COALESCE_LOOP:
+			case ROSABENCH_COALESCE_CORK:
+				nRet = Coalescer.CRosaCoalescerWrite(pBuffer, m_sConfig.uiSize);
+				break;
+			case ROSABENCH_COALESCE_URGENT:
+				nRet = Coalescer.CRosaCoalescerWrite(pBuffer, m_sConfig.uiSize, true);
+				break;
+			default:
+				nRet = Client.CRosaSocketSendBuffer(pBuffer, m_sConfig.uiSize);
+				break;
+			}
+
+			if (nRet != SOB_RET_OK)
+			{
+				ullErrors++;
+				break;
+			}
+
+			ullSent++;
+		}
+
+		// ʣݺȴ
+		if (bCoalescer)
+		{
+			Coalescer.CRosaCoalescerUncork();
+			Coalescer.CRosaCoalescerDestroy();
+			ullSends = Coalescer.CRosaCoalescerGetSendCount();
+		}
+		else
+		{
+			ullSends = ullSent;
+		}
+
+		for (DWORD dwWait = 0; (ULONGLONG)m_llReceived < ullSent && dwWait < ROSABENCH_COALESCE_DRAIN_MAX; dwWait += 1)
+		{
+			Sleep(1);
+		}
+
+		dCpu = BenchCpuStop(sCpu, dSeconds);
+		dwSegments = TcpOutSegments() - dwSegStart;
+
+		delete[] pBuffer;
+
+		Loop.CRosaEventLoopDestroy();
+		Client.CRosaSocketDisConnect();
+	}
+	else
+	{
+		ullErrors++;
+		Loop.CRosaEventLoopDestroy();
+	}
+
+	// ֹͣ(߳1ڷ), ߳ڿͻ˶Ͽ˳
+	m_Server.CRosaBenchServerStop();
+
+	for (DWORD dwWait = 0; m_lServerConn > 0 && dwWait < ROSABENCH_COALESCE_DRAIN_MAX; dwWait += 10)
+	{
+		Sleep(10);
+	}
+
+	// TCPֶΪϵͳ(ȷϼ), ڷʽ֮Ƚ
+	ULONGLONG ullReceived = (ULONGLONG)m_llReceived;
+
+	char chResult[640] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"seconds\":%.3f,\"messages\":%llu,\"received\":%llu,\"errors\":%llu,\"messages_per_sec\":%.1f,\"mb_per_sec\":%.2f,\"sends_per_message\":%.4f,\"tcp_segments_per_message\":%.4f,\"cpu_percent\":%.1f,\"latency_ns\":",
+		dSeconds, ullSent, ullReceived, ullErrors,
+		(dSeconds > 0.0) ? ullReceived / dSeconds : 0.0,
+		(dSeconds > 0.0) ? (double)ullReceived * m_sConfig.uiSize / (1024.0 * 1024.0) / dSeconds : 0.0,
+		ullSent ? (double)ullSends / ullSent : 0.0,
+		ullSent ? (double)dwSegments / ullSent : 0.0, dCpu);
+
+	return string("{") + chHead + chResult + BenchSummaryJson(m_Latency) + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchCoalesceGetModeName()
+// @Purpose: CRosaBenchCoalesceȡͷʽ
+// @Since: v1.00a
+// @Para: int nMode(ROSABENCH_COALESCE_*)
+// @Return: const char* pcName
+//------------------------------------------------------------------
+const char * CRosaBenchCoalesce::CRosaBenchCoalesceGetModeName(int nMode)
+{
+	if (nMode < 0 || nMode >= ROSABENCH_COALESCE_COUNT)
+	{
+		return "";
+	}
+
+	return g_pcCoalesceModeName[nMode];
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAccept()
+// @Purpose: CRosaBenchCoalesce
+// @Since: v1.00a
+// @Para: void* pContext(Զ)
+// @Para: SOCKET s(ͻ׽)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchCoalesce::OnAccept(void * pContext, SOCKET s, USHORT nShard)
+{
+	CRosaBenchCoalesce* pBench = reinterpret_cast<CRosaBenchCoalesce*>(pContext);
+
+	BenchStartConnThread(OnServerConn, pBench, s, pBench->m_lServerConn);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnServerConn()
+// @Purpose: CRosaBenchCoalesce߳(Ϣз, յϢݴƴ, ͻ˹رպ˳)
+// @Since: v1.00a
+// @Para: void* pParam(S_BENCHCONN)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchCoalesce::OnServerConn(void * pParam)
+{
+	LPS_BENCHCONN pConn = reinterpret_cast<LPS_BENCHCONN>(pParam);
+	CRosaBenchCoalesce* pBench = reinterpret_cast<CRosaBenchCoalesce*>(pConn->pContext);
+
+	CRosaSocket Conn;
+	Conn.CRosaSocketAttachRawSocket(pConn->Socket, true);
+	delete pConn;
+
+	UINT uiSize = pBench->m_sConfig.uiSize;
+	char* pBuffer = new char[ROSABENCH_COALESCE_RECV_BUFFER];
+	vector<char> vecPartial;
+	vecPartial.reserve(uiSize);
+
+	while (true)
+	{
+		UINT uiRecv = 0;
+
+		int nRet = Conn.CRosaSocketRecvOnce(pBuffer, ROSABENCH_COALESCE_RECV_BUFFER, uiRecv);
+		if (nRet != SOB_RET_OK || uiRecv == 0)
+		{
+			break;
+		}
+
+		const char* pPos = pBuffer;
+		const char* pEnd = pBuffer + uiRecv;
+
+		while (pPos < pEnd)
+		{
+			UINT uiTake = min((UINT)(pEnd - pPos), uiSize - (UINT)vecPartial.size());
+			vecPartial.insert(vecPartial.end(), pPos, pPos + uiTake);
+			pPos += uiTake;
+
+			if (vecPartial.size() == uiSize)
+			{
+				pBench->m_Latency.CRosaHistogramRecordSince(*(LONGLONG*)&vecPartial[0]);
+				InterlockedIncrement64(&pBench->m_llReceived);
+				vecPartial.clear();
+			}
+		}
+	}
+
+	delete[] pBuffer;
+
+	InterlockedDecrement(&pBench->m_lServerConn);
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 TcpOutSegments()
+// @Purpose: CRosaBenchCoalesceϵͳTCPͷֶμ(ػϿͻݼȷ϶)
+// @Since: v1.00a
+// @Para: None
+// @Return: DWORD dwOutSegs
+//------------------------------------------------------------------
+DWORD CRosaBenchCoalesce::TcpOutSegments()
+{
+	MIB_TCPSTATS sStats;
+	memset(&sStats, 0, sizeof(sStats));
+
+	if (GetTcpStatistics(&sStats) != NO_ERROR)
+	{
+		return 0;
+	}
+
+	return sStats.dwOutSegs;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchCoalesceUsage()
+// @Purpose: CRosaBenchCoalesceѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchCoalesce::CRosaBenchCoalesceUsage()
+{
+	fprintf(stderr,
+		"  --coalesce-sizes <list> small message sizes, per-message send vs coalescer (default: " ROSABENCH_DEFAULT_COALESCE_SIZES ")\n"
+		"  --coalesce-rates <list> message rates per second, 0 = unthrottled (default: " ROSABENCH_DEFAULT_COALESCE_RATES ")\n");
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchCoalesceParse()
+// @Purpose: CRosaBenchCoalesceѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchCoalesce::CRosaBenchCoalesceParse(const char * pcArg, const char * pcValue)
+{
+	bool bOk = false;
+
+	if (strcmp(pcArg, "--coalesce-sizes") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecCoalesceSize);
+	}
+	else if (strcmp(pcArg, "--coalesce-rates") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecCoalesceRate, true);
+	}
+	else
+	{
+		return ROSABENCH_PARSE_UNKNOWN;
+	}
+
+	return bOk ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchCoalesceMain()
+// @Purpose: CRosaBenchCoalesceȫ(*Ϣ*ͷʽ)
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchCoalesce::CRosaBenchCoalesceMain(const S_BENCHCOMMON & sCommon)
+{
+	if (g_vecCoalesceSize.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_COALESCE_SIZES, g_vecCoalesceSize);
+	}
+
+	if (g_vecCoalesceRate.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_COALESCE_RATES, g_vecCoalesceRate, true);
+	}
+
+	CRosaBenchCoalesce BenchCoalesce;
+
+	for (size_t r = 0; r < g_vecCoalesceRate.size(); ++r)
+	{
+		for (size_t s = 0; s < g_vecCoalesceSize.size(); ++s)
+		{
+			for (int m = 0; m < ROSABENCH_COALESCE_COUNT; ++m)
+			{
+				S_COALESCEBENCHCONFIG sConfig = { m, g_vecCoalesceSize[s], g_vecCoalesceRate[r], sCommon.uiSeconds, sCommon.sPort };
+				BenchOutput(BenchCoalesce.CRosaBenchCoalesceRun(sConfig));
+			}
+		}
+	}
+}
@@ -0,0 +1,81 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchCoalesce.h
+* @brief	This File is RosaBenchCoalesce Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHCOALESCE_H__
+#define __CROSABENCHCOALESCE_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Include Rosa Header File
+#include "../Rosa/CRosaEventLoop.h"
+#include "../Rosa/CRosaCoalescer.h"
+
+//Macro Definition
+#define ROSABENCH_COALESCE_NODELAY		0				//ͻ:ÿϢCRosaSocketSendBuffer(TCP_NODELAY, ԭ)
+#define ROSABENCH_COALESCE_NAGLE		1				//ͻ:ÿϢCRosaSocketSendBuffer(Nagle, )
+#define ROSABENCH_COALESCE_LOOP			2				//ͻ:CRosaCoalescerδס(¼ѭ֮ϲ)
+#define ROSABENCH_COALESCE_CORK			3				//ͻ:CRosaCoalescerס(ϲ/ϲԤ㷢)
+#define ROSABENCH_COALESCE_URGENT		4				//ͻ:CRosaCoalescerӳд(bUrgent, )
+#define ROSABENCH_COALESCE_COUNT		5
+
+#define ROSABENCH_COALESCE_RECV_BUFFER	(64 * 1024)		//˽ջ峤
+#define ROSABENCH_COALESCE_DRAIN_MAX	5000			//ȴʱ()
+
+#define ROSABENCH_DEFAULT_COALESCE_SIZES	"32,128,1K"	//ĬСϢ
+#define ROSABENCH_DEFAULT_COALESCE_RATES	"10K,0"		//ĬϢ(/, 0:)
+
+//Struct Definition
+typedef struct
+{
+	int nMode;					// ͷʽ(ROSABENCH_COALESCE_*)
+	UINT uiSize;				// Ϣ(С8ֽ, ͷΪʱܼ)
+	UINT uiRate;				// (Ϣ/, 0ʾ)
+	UINT uiSeconds;				// ʱ
+	USHORT sPort;				// ˿
+}S_COALESCEBENCHCONFIG, *LPS_COALESCEBENCHCONFIG;
+
+//Class Definition
+class CRosaBenchCoalesce
+{
+public:
+	CRosaBenchCoalesce();		// CRosaBenchCoalesce 캯
+	~CRosaBenchCoalesce();		// CRosaBenchCoalesce 
+
+public:
+	string CRosaBenchCoalesceRun(const S_COALESCEBENCHCONFIG& sConfig);	// CRosaBenchCoalesce һ(JSON)
+
+	static const char* CRosaBenchCoalesceGetModeName(int nMode);			// CRosaBenchCoalesce ȡͷʽ
+
+	static void CRosaBenchCoalesceUsage();												// CRosaBenchCoalesce ѡ˵
+	static int CRosaBenchCoalesceParse(const char* pcArg, const char* pcValue);			// CRosaBenchCoalesce ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchCoalesceMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchCoalesce ȫ
+
+private:
+	static void OnAccept(void* pContext, SOCKET s, USHORT nShard);							// CRosaBenchCoalesce 
+	static unsigned __stdcall OnServerConn(void* pParam);									// CRosaBenchCoalesce ߳(Ϣзֲ¼ӳ)
+
+	static DWORD TcpOutSegments();									// CRosaBenchCoalesce ϵͳTCPͷֶμ
+
+private:
+	S_COALESCEBENCHCONFIG m_sConfig;			// CRosaBenchCoalesce ǰԲ
+
+	CRosaBenchServer m_Server;					// CRosaBenchCoalesce (ÿ¼)
+	volatile LONG m_lServerConn;				// CRosaBenchCoalesce ߳
+
+	volatile LONGLONG m_llReceived;				// CRosaBenchCoalesce յϢ
+	CRosaHistogram m_Latency;					// CRosaBenchCoalesce д뵽յӳ(̼߳¼)
+
+};
+
+#endif // !__CROSABENCHCOALESCE_H__
@@ -0,0 +1,420 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchCompress.cpp
+* @brief	This File is RosaBenchCompress Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchCompress.h"
+
+//Include C/C++ Header File
+#include <stdio.h>
+
+//CRosaBenchCompress ѹ(̱߳¼ƵңϢ, ٶȼѹ, ·Ч)
+
+// ѡ(бʱȡĬֵ)
+static vector<UINT> g_vecCompressLinkBps;
+static const char* g_pcCompressSamples = NULL;
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchCompress()
+// @Purpose: CRosaBenchCompress캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchCompress::CRosaBenchCompress()
+{
+	m_Encode.CRosaHistogramCreate();
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchCompress()
+// @Purpose: CRosaBenchCompress
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchCompress::~CRosaBenchCompress()
+{
+	m_vecSample.clear();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchCompressLoad()
+// @Purpose: CRosaBenchCompress¼Ƶ(ÿһϢ, Կ)
+// @Since: v1.00a
+// @Para: const char* pcFile(ļ, NULL:ң)
+// @Return: bool bRet(true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool CRosaBenchCompress::CRosaBenchCompressLoad(const char * pcFile)
+{
+	m_vecSample.clear();
+	m_strDict.clear();
+
+	if (pcFile == NULL)
+	{
+		Generate();
+		m_strSource = "synthetic";
+	}
+	else
+	{
+		FILE* pFile = NULL;
+		if (fopen_s(&pFile, pcFile, "rb") != 0 || pFile == NULL)
+		{
+			return false;
+		}
+
+		string strLine;
+		char chBuffer[4096];
+		size_t nRead = 0;
+
+		while ((nRead = fread(chBuffer, 1, sizeof(chBuffer), pFile)) > 0)
+		{
+			for (size_t i = 0; i < nRead; ++i)
+			{
+				if (chBuffer[i] != '\n')
+				{
+					strLine.push_back(chBuffer[i]);
+					continue;
+				}
+
+				if (!strLine.empty() && strLine[strLine.size() - 1] == '\r')
+				{
+					strLine.erase(strLine.size() - 1);
+				}
+
+				if (!strLine.empty())
+				{
+					m_vecSample.push_back(strLine);
+				}
+
+				strLine.clear();
+			}
+		}
+
+		if (!strLine.empty())
+		{
+			m_vecSample.push_back(strLine);
+		}
+
+		fclose(pFile);
+
+		// ԴдJSON, ֻļеİȫַ
+		m_strSource.clear();
+		for (const char* p = pcFile; *p != '\0'; ++p)
+		{
+			m_strSource.push_back((*p == '"' || *p == '\\') ? '/' : *p);
+		}
+	}
+
+	// Ҫֵ֮һϢ
+	if (m_vecSample.size() <= ROSABENCH_COMPRESS_DICT_SAMPLES)
+	{
+		m_vecSample.clear();
+		return false;
+	}
+
+	for (UINT i = 0; i < ROSABENCH_COMPRESS_DICT_SAMPLES; ++i)
+	{
+		m_strDict += m_vecSample[i];
+	}
+
+	if (m_strDict.size() > ROSA_COMPRESS_WINDOW)
+	{
+		m_strDict.erase(0, m_strDict.size() - ROSA_COMPRESS_WINDOW);
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchCompressRun()
+// @Purpose: CRosaBenchCompressһ(һУ鲢ͳѹ, ٷֱظͽٶ)
+// @Since: v1.00a
+// @Para: const S_COMPRESSBENCHCONFIG& sConfig(Բ)
+// @Para: const vector<UINT>& vecLinkBps(Чµ·, /)
+// @Return: string strJson ()
+//------------------------------------------------------------------
+string CRosaBenchCompress::CRosaBenchCompressRun(const S_COMPRESSBENCHCONFIG & sConfig, const vector<UINT>& vecLinkBps)
+{
+	static const char* s_pcMode[] = { "none", "block", "stream" };
+
+	char chHead[512] = { 0 };
+
+	UINT uiFirst = ROSABENCH_COMPRESS_DICT_SAMPLES;
+	UINT uiCount = (UINT)m_vecSample.size() - uiFirst;
+
+	ULONGLONG ullRaw = 0;
+	UINT uiMaxSize = 0;
+	for (UINT i = uiFirst; i < (UINT)m_vecSample.size(); ++i)
+	{
+		ullRaw += m_vecSample[i].size();
+		uiMaxSize = max(uiMaxSize, (UINT)m_vecSample[i].size());
+	}
+
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"compress\",\"source\":\"%s\",\"mode\":\"%s\",\"dict\":%s,\"messages\":%u,\"avg_size\":%.1f",
+		m_strSource.c_str(), s_pcMode[sConfig.nMode], sConfig.bDict ? "true" : "false", uiCount, (double)ullRaw / uiCount);
+
+	const char* pDict = sConfig.bDict ? m_strDict.data() : NULL;
+	UINT uiDictSize = sConfig.bDict ? (UINT)m_strDict.size() : 0;
+
+	CRosaCompress Encoder;
+	CRosaCompress Decoder;
+
+	if (!Encoder.CRosaCompressCreate(sConfig.nMode, pDict, uiDictSize) || !Decoder.CRosaCompressCreate(sConfig.nMode, pDict, uiDictSize))
+	{
+		return string("{") + chHead + ",\"error\":\"create\"}";
+	}
+
+	// ¼һ(ʹ)
+	vector<char> vecWire;
+	vector<UINT> vecOffset;
+	vecOffset.reserve(uiCount + 1);
+
+	for (UINT i = uiFirst; i < (UINT)m_vecSample.size(); ++i)
+	{
+		UINT uiFrameSize = 0;
+		const char* pFrame = Encoder.CRosaCompressEncodeFrame(m_vecSample[i].data(), (UINT)m_vecSample[i].size(), uiFrameSize);
+		if (pFrame == NULL)
+		{
+			return string("{") + chHead + ",\"error\":\"encode\"}";
+		}
+
+		vecOffset.push_back((UINT)vecWire.size());
+		vecWire.insert(vecWire.end(), pFrame, pFrame + uiFrameSize);
+	}
+	vecOffset.push_back((UINT)vecWire.size());
+
+	S_COMPRESSSTATS sStats;
+	Encoder.CRosaCompressGetStats(sStats, true);
+
+	// У
+	vector<char> vecOut(uiMaxSize + 1);
+	bool bVerified = true;
+
+	for (UINT i = 0; i < uiCount && bVerified; ++i)
+	{
+		S_COMPRESSHEADER sHeader;
+		memcpy(&sHeader, &vecWire[vecOffset[i]], sizeof(sHeader));
+		const string& strSample = m_vecSample[uiFirst + i];
+
+		int nSize = Decoder.CRosaCompressDecodeFrame(sHeader, &vecWire[vecOffset[i]] + sizeof(S_COMPRESSHEADER), &vecOut[0], (UINT)vecOut.size());
+		bVerified = (nSize == (int)strSample.size()) && (memcmp(&vecOut[0], strSample.data(), nSize) == 0);
+	}
+
+	// ٶ(ÿӳʼ״̬ʼ, ¼ʱ֡ͬ)
+	m_Encode.CRosaHistogramReset();
+
+	ULONGLONG ullEncodeNanoSec = 0;
+	ULONGLONG ullEncodeBytes = 0;
+
+	while (ullEncodeNanoSec < (ULONGLONG)ROSABENCH_COMPRESS_MIN_MSEC * 1000000)
+	{
+		Encoder.CRosaCompressReset();
+
+		LONGLONG llPass = CRosaHistogram::CRosaHistogramNow();
+		for (UINT i = uiFirst; i < (UINT)m_vecSample.size(); ++i)
+		{
+			UINT uiFrameSize = 0;
+			LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+			Encoder.CRosaCompressEncodeFrame(m_vecSample[i].data(), (UINT)m_vecSample[i].size(), uiFrameSize);
+			m_Encode.CRosaHistogramRecordSince(llStart);
+		}
+
+		ullEncodeNanoSec += CRosaHistogram::CRosaHistogramToNanoSec(CRosaHistogram::CRosaHistogramNow() - llPass);
+		ullEncodeBytes += ullRaw;
+	}
+
+	// ٶ
+	ULONGLONG ullDecodeNanoSec = 0;
+	ULONGLONG ullDecodeBytes = 0;
+
+	while (bVerified && ullDecodeNanoSec < (ULONGLONG)ROSABENCH_COMPRESS_MIN_MSEC * 1000000)
+	{
+		Decoder.CRosaCompressReset();
+
+		LONGLONG llPass = CRosaHistogram::CRosaHistogramNow();
+		for (UINT i = 0; i < uiCount; ++i)
+		{
+			S_COMPRESSHEADER sHeader;
+			memcpy(&sHeader, &vecWire[vecOffset[i]], sizeof(sHeader));
+			Decoder.CRosaCompressDecodeFrame(sHeader, &vecWire[vecOffset[i]] + sizeof(S_COMPRESSHEADER), &vecOut[0], (UINT)vecOut.size());
+		}
+
+		ullDecodeNanoSec += CRosaHistogram::CRosaHistogramToNanoSec(CRosaHistogram::CRosaHistogramNow() - llPass);
+		ullDecodeBytes += ullRaw;
+	}
+
+	Encoder.CRosaCompressDestroy();
+	Decoder.CRosaCompressDestroy();
+
+	// ֽ/
+	double dCompress = (ullEncodeNanoSec > 0) ? ullEncodeBytes * 1e9 / ullEncodeNanoSec : 0.0;
+	double dDecompress = (ullDecodeNanoSec > 0) ? ullDecodeBytes * 1e9 / ullDecodeNanoSec : 0.0;
+	double dRatio = (sStats.ullEncodeWireBytes > 0) ? (double)sStats.ullEncodeRawBytes / sStats.ullEncodeWireBytes : 0.0;
+
+	// ·ϴԭʼݵ: ·ֽʰѹʷŴ, ˱ٶ; ׼Ϊֻ֡ѹ
+	double dBaseRatio = (double)ullRaw / (ullRaw + (ULONGLONG)uiCount * sizeof(S_COMPRESSHEADER));
+
+	string strLinks = ",\"links\":[";
+	for (size_t i = 0; i < vecLinkBps.size(); ++i)
+	{
+		double dLinkBytes = vecLinkBps[i] / 8.0;
+		double dEffective = dLinkBytes * dRatio;
+		double dBaseline = dLinkBytes * dBaseRatio;
+
+		if (sConfig.nMode != ROSA_COMPRESS_MODE_NONE)
+		{
+			dEffective = min(dEffective, min(dCompress, dDecompress));
+		}
+
+		char chLink[256] = { 0 };
+		sprintf_s(chLink, sizeof(chLink), "%s{\"bps\":%u,\"raw_kb_per_sec\":%.2f,\"baseline_kb_per_sec\":%.2f,\"speedup\":%.3f}",
+			(i == 0) ? "" : ",", vecLinkBps[i], dEffective / 1024.0, dBaseline / 1024.0, (dBaseline > 0.0) ? dEffective / dBaseline : 0.0);
+		strLinks += chLink;
+	}
+	strLinks += "]";
+
+	char chResult[512] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"ratio\":%.3f,\"compressed_percent\":%.1f,\"compress_mb_per_sec\":%.1f,\"decompress_mb_per_sec\":%.1f,\"verified\":%s",
+		dRatio,
+		(sStats.ullEncodeFrames > 0) ? sStats.ullEncodeCompressed * 100.0 / sStats.ullEncodeFrames : 0.0,
+		dCompress / (1024.0 * 1024.0), dDecompress / (1024.0 * 1024.0),
+		bVerified ? "true" : "false");
+
+	return string("{") + chHead + chResult + strLinks + ",\"compress_ns\":" + BenchSummaryJson(m_Encode) + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 Generate()
+// @Purpose: CRosaBenchCompressң(̶, 豸ֵ, ɸ)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchCompress::Generate()
+{
+	static const char* s_pcStatus[] = { "ok", "ok", "ok", "ok", "ok", "ok", "warn", "charging" };
+
+	UINT uiSeed = 20171019;
+	double dTemp[ROSABENCH_COMPRESS_SYNTH_DEVICES];
+	double dHumidity[ROSABENCH_COMPRESS_SYNTH_DEVICES];
+	double dBattery[ROSABENCH_COMPRESS_SYNTH_DEVICES];
+	UINT uiSeq[ROSABENCH_COMPRESS_SYNTH_DEVICES];
+
+	for (UINT i = 0; i < ROSABENCH_COMPRESS_SYNTH_DEVICES; ++i)
+	{
+		dTemp[i] = 20.0 + i % 10;
+		dHumidity[i] = 40.0 + i % 20;
+		dBattery[i] = 4.2;
+		uiSeq[i] = 0;
+	}
+
+	ULONGLONG ullTime = 1760000000000ULL;
+	m_vecSample.reserve(ROSABENCH_COMPRESS_SYNTH_COUNT);
+
+	for (UINT i = 0; i < ROSABENCH_COMPRESS_SYNTH_COUNT; ++i)
+	{
+		// ͬ, ȡλ
+		uiSeed = uiSeed * 1103515245 + 12345;
+		UINT uiDevice = (uiSeed >> 16) % ROSABENCH_COMPRESS_SYNTH_DEVICES;
+		uiSeed = uiSeed * 1103515245 + 12345;
+		double dStep = (double)((uiSeed >> 16) & 0x7FFF) / 0x7FFF - 0.5;
+
+		dTemp[uiDevice] += dStep * 0.2;
+		dHumidity[uiDevice] += dStep * 0.5;
+		dBattery[uiDevice] = (dBattery[uiDevice] < 3.3) ? 4.2 : dBattery[uiDevice] - 0.0005;
+		ullTime += 10 + ((uiSeed >> 8) & 0x1F);
+
+		char chMessage[256] = { 0 };
+		sprintf_s(chMessage, sizeof(chMessage),
+			"{\"ts\":%llu,\"device\":\"sensor-%03u\",\"seq\":%u,\"temp\":%.2f,\"humidity\":%.1f,\"pressure\":%.2f,\"battery\":%.3f,\"status\":\"%s\"}",
+			ullTime, uiDevice, uiSeq[uiDevice]++, dTemp[uiDevice], dHumidity[uiDevice], 1013.25 + dStep, dBattery[uiDevice],
+			s_pcStatus[(uiSeed >> 4) & 0x7]);
+
+		m_vecSample.push_back(chMessage);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchCompressUsage()
+// @Purpose: CRosaBenchCompressѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchCompress::CRosaBenchCompressUsage()
+{
+	fprintf(stderr,
+		"  --compress-samples <f> recorded messages, one per line (default: built-in telemetry)\n"
+		"  --compress-links <list> link rates in bit/s for effective throughput (default: " ROSABENCH_DEFAULT_COMPRESS_LINKS ")\n");
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchCompressParse()
+// @Purpose: CRosaBenchCompressѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchCompress::CRosaBenchCompressParse(const char * pcArg, const char * pcValue)
+{
+	bool bOk = false;
+
+	if (strcmp(pcArg, "--compress-samples") == 0)
+	{
+		g_pcCompressSamples = pcValue;
+		bOk = true;
+	}
+	else if (strcmp(pcArg, "--compress-links") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecCompressLinkBps);
+	}
+	else
+	{
+		return ROSABENCH_PARSE_UNKNOWN;
+	}
+
+	return bOk ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchCompressMain()
+// @Purpose: CRosaBenchCompressȫ(ѹ/ѹ/Ԥֵѹ/ѹ)
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchCompress::CRosaBenchCompressMain(const S_BENCHCOMMON & sCommon)
+{
+	if (g_vecCompressLinkBps.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_COMPRESS_LINKS, g_vecCompressLinkBps);
+	}
+
+	CRosaBenchCompress BenchCompress;
+
+	if (!BenchCompress.CRosaBenchCompressLoad(g_pcCompressSamples))
+	{
+		fprintf(stderr, "RosaBench: cannot load compress samples (need more than %d lines)\n", ROSABENCH_COMPRESS_DICT_SAMPLES);
+		return;
+	}
+
+	S_COMPRESSBENCHCONFIG sConfigs[] = {
+		{ ROSA_COMPRESS_MODE_NONE, false },
+		{ ROSA_COMPRESS_MODE_BLOCK, false },
+		{ ROSA_COMPRESS_MODE_BLOCK, true },
+		{ ROSA_COMPRESS_MODE_STREAM, false },
+	};
+
+	for (size_t c = 0; c < sizeof(sConfigs) / sizeof(sConfigs[0]); ++c)
+	{
+		BenchOutput(BenchCompress.CRosaBenchCompressRun(sConfigs[c], g_vecCompressLinkBps));
+	}
+}
@@ -0,0 +1,64 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchCompress.h
+* @brief	This File is RosaBenchCompress Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHCOMPRESS_H__
+#define __CROSABENCHCOMPRESS_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Include Rosa Header File
+#include "../Rosa/CRosaCompress.h"
+
+//Macro Definition
+#define ROSABENCH_COMPRESS_DICT_SAMPLES		64				//ǰƴΪԤֵ(ģʽ)
+#define ROSABENCH_COMPRESS_MIN_MSEC			1000			//ѹѹԵ̲ʱ()
+#define ROSABENCH_COMPRESS_SYNTH_COUNT		20000			//ң
+#define ROSABENCH_COMPRESS_SYNTH_DEVICES	50				//ң豸
+
+#define ROSABENCH_DEFAULT_COMPRESS_LINKS	"115200,1000000,10000000"	//ĬЧµ·(bit/s)
+
+//Struct Definition
+typedef struct
+{
+	int nMode;					// ѹģʽ(ROSA_COMPRESS_MODE_*)
+	bool bDict;					// ǷʹԤֵ
+}S_COMPRESSBENCHCONFIG, *LPS_COMPRESSBENCHCONFIG;
+
+//Class Definition
+class CRosaBenchCompress
+{
+public:
+	CRosaBenchCompress();		// CRosaBenchCompress 캯
+	~CRosaBenchCompress();		// CRosaBenchCompress 
+
+public:
+	bool CRosaBenchCompressLoad(const char* pcFile);															// CRosaBenchCompress ¼Ƶ(ÿһϢ, NULL:ң)
+	string CRosaBenchCompressRun(const S_COMPRESSBENCHCONFIG& sConfig, const vector<UINT>& vecLinkBps);		// CRosaBenchCompress һ(JSON)
+
+	static void CRosaBenchCompressUsage();												// CRosaBenchCompress ѡ˵
+	static int CRosaBenchCompressParse(const char* pcArg, const char* pcValue);			// CRosaBenchCompress ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchCompressMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchCompress ȫ
+
+private:
+	void Generate();																							// CRosaBenchCompress ң(̶)
+
+private:
+	vector<string> m_vecSample;				// CRosaBenchCompress (ǰROSABENCH_COMPRESS_DICT_SAMPLESΪֵ)
+	string m_strDict;						// CRosaBenchCompress Ԥֵ
+	string m_strSource;						// CRosaBenchCompress Դ
+	CRosaHistogram m_Encode;				// CRosaBenchCompress ÿϢıʱ
+
+};
+
+#endif // !__CROSABENCHCOMPRESS_H__
@@ -0,0 +1,491 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchConnect.cpp
+* @brief	This File is RosaBenchConnect Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchConnect.h"
+
+//Include C/C++ Header File
+#include <process.h>
+#include <stdio.h>
+
+//CRosaBenchConnect ӽ(ͻ, ˽ܺر, ÿʱ)
+
+// ѡ(бʱȡĬֵ)
+static vector<UINT> g_vecConnectThread;
+
+// ʽ
+static const char* g_pcAcceptName[ROSABENCH_ACCEPT_COUNT] = { "single", "sharded" };
+static const char* g_pcConnectName[ROSABENCH_CONNECT_COUNT] = { "blocking", "connector" };
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchConnect()
+// @Purpose: CRosaBenchConnect캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchConnect::CRosaBenchConnect()
+{
+	memset(&m_sConfig, 0, sizeof(m_sConfig));
+	m_lAccepted = 0;
+	memset((void*)m_lShardAccepted, 0, sizeof(m_lShardAccepted));
+	m_nShards = 0;
+	m_hStartEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+
+	m_pConnector = NULL;
+	memset(&m_addrServer, 0, sizeof(m_addrServer));
+	m_llDeadline = 0;
+	m_lInFlight = 0;
+
+	m_Latency.CRosaHistogramCreate();
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchConnect()
+// @Purpose: CRosaBenchConnect
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchConnect::~CRosaBenchConnect()
+{
+	if (m_hStartEvent)
+	{
+		CloseHandle(m_hStartEvent);
+		m_hStartEvent = NULL;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchConnectRun()
+// @Purpose: CRosaBenchConnectһ(ÿ¼, ˷ʽ֮以Ӱ)
+// @Since: v1.00a
+// @Para: const S_CONNBENCHCONFIG& sConfig(Բ)
+// @Return: string strJson ()
+//------------------------------------------------------------------
+string CRosaBenchConnect::CRosaBenchConnectRun(const S_CONNBENCHCONFIG & sConfig)
+{
+	char chHead[512] = { 0 };
+
+	m_sConfig = sConfig;
+	m_sConfig.uiThreads = (m_sConfig.uiThreads < 1) ? 1 : m_sConfig.uiThreads;
+
+	// Ƭ봦ͬ
+	SYSTEM_INFO sInfo;
+	GetSystemInfo(&sInfo);
+	m_nShards = (m_sConfig.nAccept == ROSABENCH_ACCEPT_SHARDED) ? (USHORT)min(sInfo.dwNumberOfProcessors, (DWORD)SOB_SHARD_MAX_COUNT) : 1;
+	m_nShards = (m_nShards < 1) ? 1 : m_nShards;
+
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"connect\",\"accept\":\"%s\",\"connect\":\"%s\",\"shards\":%u,\"threads\":%u",
+		CRosaBenchConnectGetAcceptName(m_sConfig.nAccept), CRosaBenchConnectGetConnectName(m_sConfig.nConnect), m_nShards, m_sConfig.uiThreads);
+
+	m_lAccepted = 0;
+	memset((void*)m_lShardAccepted, 0, sizeof(m_lShardAccepted));
+
+	USHORT nAcceptShards = (m_sConfig.nAccept == ROSABENCH_ACCEPT_SHARDED) ? m_nShards : 0;
+	if (!m_Server.CRosaBenchServerStart(m_sConfig.sPort, OnAccept, this, nAcceptShards))
+	{
+		char chError[128] = { 0 };
+		sprintf_s(chError, sizeof(chError), ",\"error\":\"listen failed (WSA %d)\"}", m_Server.CRosaBenchServerGetError());
+
+		return string("{") + chHead + chError;
+	}
+
+	// ͻ߳(ʽֻһ߳¼ѭ)
+	UINT uiClientThreads = (m_sConfig.nConnect == ROSABENCH_CONNECT_BLOCKING) ? m_sConfig.uiThreads : 1;
+	vector<S_CONNBENCHCLIENT> vecClient(uiClientThreads);
+	vector<HANDLE> vecThread;
+
+	for (UINT i = 0; i < uiClientThreads; ++i)
+	{
+		memset(&vecClient[i], 0, sizeof(S_CONNBENCHCLIENT));
+		vecClient[i].pBench = this;
+
+		HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, OnClientThread, &vecClient[i], 0, NULL);
+		if (hThread)
+		{
+			vecThread.push_back(hThread);
+		}
+	}
+
+	m_Latency.CRosaHistogramReset();
+
+	S_BENCHCPU sCpu;
+	BenchCpuStart(sCpu);
+	SetEvent(m_hStartEvent);
+
+	for (size_t i = 0; i < vecThread.size(); ++i)
+	{
+		WaitForSingleObject(vecThread[i], INFINITE);
+		CloseHandle(vecThread[i]);
+	}
+
+	double dSeconds = 0.0;
+	double dCpu = BenchCpuStop(sCpu, dSeconds);
+	ResetEvent(m_hStartEvent);
+
+	// ֹͣ(߳1ڷ)
+	m_Server.CRosaBenchServerStop();
+
+	// 
+	ULONGLONG ullConnects = 0;
+	ULONGLONG ullErrors = 0;
+
+	for (UINT i = 0; i < uiClientThreads; ++i)
+	{
+		ullConnects += vecClient[i].ullConnects;
+		ullErrors += vecClient[i].ullErrors;
+	}
+
+	// Ƭ֮ĸز(/, 1Ϊȫ)
+	LONG lShardMin = m_lShardAccepted[0];
+	LONG lShardMax = m_lShardAccepted[0];
+	for (USHORT i = 1; i < m_nShards; ++i)
+	{
+		LONG lShard = m_lShardAccepted[i];
+		lShardMin = min(lShardMin, lShard);
+		lShardMax = max(lShardMax, lShard);
+	}
+
+	char chResult[512] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"seconds\":%.3f,\"connects\":%llu,\"accepted\":%ld,\"errors\":%llu,\"connects_per_sec\":%.1f,\"shard_min_max\":%.3f,\"cpu_percent\":%.1f,\"connect_ns\":",
+		dSeconds, ullConnects, m_lAccepted, ullErrors, (dSeconds > 0.0) ? ullConnects / dSeconds : 0.0,
+		(lShardMax > 0) ? (double)lShardMin / lShardMax : 0.0, dCpu);
+
+	return string("{") + chHead + chResult + BenchSummaryJson(m_Latency) + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchConnectGetAcceptName()
+// @Purpose: CRosaBenchConnectȡ˷ʽ
+// @Since: v1.00a
+// @Para: int nAccept(ROSABENCH_ACCEPT_*)
+// @Return: const char* pcName
+//------------------------------------------------------------------
+const char * CRosaBenchConnect::CRosaBenchConnectGetAcceptName(int nAccept)
+{
+	if (nAccept < 0 || nAccept >= ROSABENCH_ACCEPT_COUNT)
+	{
+		return "";
+	}
+
+	return g_pcAcceptName[nAccept];
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchConnectGetConnectName()
+// @Purpose: CRosaBenchConnectȡͻ˷ʽ
+// @Since: v1.00a
+// @Para: int nConnect(ROSABENCH_CONNECT_*)
+// @Return: const char* pcName
+//------------------------------------------------------------------
+const char * CRosaBenchConnect::CRosaBenchConnectGetConnectName(int nConnect)
+{
+	if (nConnect < 0 || nConnect >= ROSABENCH_CONNECT_COUNT)
+	{
+		return "";
+	}
+
+	return g_pcConnectName[nConnect];
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAccept()
+// @Purpose: CRosaBenchConnect(̻߳Ƭ߳)
+// @Since: v1.00a
+// @Para: void* pContext(Զ)
+// @Para: SOCKET s(ͻ׽)
+// @Para: USHORT nShard(Ƭ, ߳ʱΪ0)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchConnect::OnAccept(void * pContext, SOCKET s, USHORT nShard)
+{
+	reinterpret_cast<CRosaBenchConnect*>(pContext)->AcceptOne(s, nShard);
+}
+
+//------------------------------------------------------------------
+// @Function:	 AcceptOne()
+// @Purpose: CRosaBenchConnectͳƲرһ
+// @Since: v1.00a
+// @Para: SOCKET s(ͻ׽)
+// @Para: USHORT nShard(Ƭ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchConnect::AcceptOne(SOCKET s, USHORT nShard)
+{
+	InterlockedIncrement(&m_lAccepted);
+
+	if (nShard < SOB_SHARD_MAX_COUNT)
+	{
+		InterlockedIncrement(&m_lShardAccepted[nShard]);
+	}
+
+	AbortiveClose(s);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnClientThread()
+// @Purpose: CRosaBenchConnectͻ߳
+// @Since: v1.00a
+// @Para: void* pParam(S_CONNBENCHCLIENT)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchConnect::OnClientThread(void * pParam)
+{
+	LPS_CONNBENCHCLIENT pClient = reinterpret_cast<LPS_CONNBENCHCLIENT>(pParam);
+	CRosaBenchConnect* pBench = pClient->pBench;
+
+	WaitForSingleObject(pBench->m_hStartEvent, INFINITE);
+
+	LARGE_INTEGER liFrequency;
+	QueryPerformanceFrequency(&liFrequency);
+
+	LONGLONG llDeadline = CRosaHistogram::CRosaHistogramNow() + liFrequency.QuadPart * pBench->m_sConfig.uiSeconds;
+
+	if (pBench->m_sConfig.nConnect == ROSABENCH_CONNECT_CONNECTOR)
+	{
+		pBench->ClientConnector(pClient, llDeadline);
+	}
+	else
+	{
+		pBench->ClientBlocking(pClient, llDeadline);
+	}
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ClientBlocking()
+// @Purpose: CRosaBenchConnectѭ(ÿ½CRosaSocket, Ӧöӵ÷ͬ)
+// @Since: v1.00a
+// @Para: LPS_CONNBENCHCLIENT pClient(ͻ߳)
+// @Para: LONGLONG llDeadline(ʱܼ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchConnect::ClientBlocking(LPS_CONNBENCHCLIENT pClient, LONGLONG llDeadline)
+{
+	while (CRosaHistogram::CRosaHistogramNow() < llDeadline)
+	{
+		CRosaSocket Client;
+
+		LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+		if (!Client.CRosaSocketConnect("127.0.0.1", m_sConfig.sPort, 1))
+		{
+			pClient->ullErrors++;
+			continue;
+		}
+
+		m_Latency.CRosaHistogramRecordSince(llStart);
+		pClient->ullConnects++;
+
+		// CRosaSocketر, ֻر
+		LINGER sLinger = { 1, 0 };
+		setsockopt(Client.CRosaSocketGetRawSocket(), SOL_SOCKET, SO_LINGER, (char*)&sLinger, sizeof(sLinger));
+		Client.CRosaSocketDisConnect();
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 ClientConnector()
+// @Purpose: CRosaBenchConnect첽ѭ(ÿɺʼһ, ʱȴ;)
+// @Since: v1.00a
+// @Para: LPS_CONNBENCHCLIENT pClient(ͻ߳)
+// @Para: LONGLONG llDeadline(ʱܼ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchConnect::ClientConnector(LPS_CONNBENCHCLIENT pClient, LONGLONG llDeadline)
+{
+	CRosaEventLoop Loop;
+	CRosaConnector Connector;
+
+	if (!Loop.CRosaEventLoopCreate(1) || !Connector.CRosaConnectorCreate(&Loop))
+	{
+		pClient->ullErrors++;
+		Loop.CRosaEventLoopDestroy();
+		return;
+	}
+
+	// ֱʹõַ, ӱǽ
+	SOCKADDR_IN* pAddr = (SOCKADDR_IN*)&m_addrServer;
+	memset(&m_addrServer, 0, sizeof(m_addrServer));
+	pAddr->sin_family = AF_INET;
+	pAddr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	pAddr->sin_port = htons(m_sConfig.sPort);
+
+	m_pConnector = &Connector;
+	m_llDeadline = llDeadline;
+	m_lInFlight = (LONG)m_sConfig.uiThreads;
+
+	vector<S_CONNBENCHSLOT> vecSlot(m_sConfig.uiThreads);
+
+	for (UINT i = 0; i < m_sConfig.uiThreads; ++i)
+	{
+		memset(&vecSlot[i], 0, sizeof(S_CONNBENCHSLOT));
+		vecSlot[i].pBench = this;
+
+		StartConnect(&vecSlot[i]);
+	}
+
+	// ڵʱٿʼ, ȫ򳬹ſʱ(δɵӱȡ)
+	for (DWORD dwWait = 0; m_lInFlight > 0 && dwWait < ROSABENCH_CONNECT_DRAIN_MAX + m_sConfig.uiSeconds * 1000; dwWait += 10)
+	{
+		Sleep(10);
+	}
+
+	Connector.CRosaConnectorDestroy();
+	Loop.CRosaEventLoopDestroy();
+	m_pConnector = NULL;
+
+	for (UINT i = 0; i < m_sConfig.uiThreads; ++i)
+	{
+		pClient->ullConnects += vecSlot[i].ullConnects;
+		pClient->ullErrors += vecSlot[i].ullErrors;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 StartConnect()
+// @Purpose: CRosaBenchConnectʼһ첽(ʱ޷ʼʱò)
+// @Since: v1.00a
+// @Para: LPS_CONNBENCHSLOT pSlot(Ӳ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchConnect::StartConnect(LPS_CONNBENCHSLOT pSlot)
+{
+	for (;;)
+	{
+		pSlot->llStart = CRosaHistogram::CRosaHistogramNow();
+		if (pSlot->llStart >= m_llDeadline)
+		{
+			break;
+		}
+
+		if (m_pConnector->CRosaConnectorConnectAddr(&m_addrServer, 1, OnConnectorDone, (DWORD_PTR)pSlot, 1000) != 0)
+		{
+			return;
+		}
+
+		// ʧ(ص)
+		pSlot->ullErrors++;
+	}
+
+	InterlockedDecrement(&m_lInFlight);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnConnectorDone()
+// @Purpose: CRosaBenchConnect첽(¼ѭ߳, ͬһͬʱֻһ)
+// @Since: v1.00a
+// @Para: ULONGLONG ullConnectID(ID)
+// @Para: SOCKET s(ӵ׽, ʧʱΪINVALID_SOCKET)
+// @Para: int nResult(SOB_RET_*)
+// @Para: DWORD_PTR dwUser(S_CONNBENCHSLOT)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaBenchConnect::OnConnectorDone(ULONGLONG ullConnectID, SOCKET s, int nResult, DWORD_PTR dwUser)
+{
+	LPS_CONNBENCHSLOT pSlot = reinterpret_cast<LPS_CONNBENCHSLOT>(dwUser);
+	CRosaBenchConnect* pBench = pSlot->pBench;
+
+	if (nResult == SOB_RET_OK)
+	{
+		pBench->m_Latency.CRosaHistogramRecordSince(pSlot->llStart);
+		pSlot->ullConnects++;
+
+		AbortiveClose(s);
+	}
+	else
+	{
+		pSlot->ullErrors++;
+	}
+
+	pBench->StartConnect(pSlot);
+}
+
+//------------------------------------------------------------------
+// @Function:	 AbortiveClose()
+// @Purpose: CRosaBenchConnectر(ػÿ, رյTIME_WAITľʱ˿)
+// @Since: v1.00a
+// @Para: SOCKET s(׽)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchConnect::AbortiveClose(SOCKET s)
+{
+	LINGER sLinger = { 1, 0 };
+	setsockopt(s, SOL_SOCKET, SO_LINGER, (char*)&sLinger, sizeof(sLinger));
+
+	closesocket(s);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchConnectUsage()
+// @Purpose: CRosaBenchConnectѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchConnect::CRosaBenchConnectUsage()
+{
+	fprintf(stderr,
+		"  --connect-threads <list> client threads, or connections in flight for the async connector (default: " ROSABENCH_DEFAULT_CONNECT_THREADS ")\n");
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchConnectParse()
+// @Purpose: CRosaBenchConnectѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchConnect::CRosaBenchConnectParse(const char * pcArg, const char * pcValue)
+{
+	bool bOk = false;
+
+	if (strcmp(pcArg, "--connect-threads") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecConnectThread);
+	}
+	else
+	{
+		return ROSABENCH_PARSE_UNKNOWN;
+	}
+
+	return bOk ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchConnectMain()
+// @Purpose: CRosaBenchConnectȫ(ͻ˷ʽ*˷ʽ*߳)
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchConnect::CRosaBenchConnectMain(const S_BENCHCOMMON & sCommon)
+{
+	if (g_vecConnectThread.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_CONNECT_THREADS, g_vecConnectThread);
+	}
+
+	CRosaBenchConnect BenchConnect;
+
+	for (int c = 0; c < ROSABENCH_CONNECT_COUNT; ++c)
+	{
+		for (int a = 0; a < ROSABENCH_ACCEPT_COUNT; ++a)
+		{
+			for (size_t t = 0; t < g_vecConnectThread.size(); ++t)
+			{
+				S_CONNBENCHCONFIG sConfig = { a, c, g_vecConnectThread[t], sCommon.uiSeconds, sCommon.sPort };
+				BenchOutput(BenchConnect.CRosaBenchConnectRun(sConfig));
+			}
+		}
+	}
+}
@@ -0,0 +1,111 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchConnect.h
+* @brief	This File is RosaBenchConnect Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHCONNECT_H__
+#define __CROSABENCHCONNECT_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Include Rosa Header File
+#include "../Rosa/CRosaEventLoop.h"
+#include "../Rosa/CRosaConnector.h"
+
+//Macro Definition
+#define ROSABENCH_ACCEPT_SINGLE			0				//:߳CRosaSocketAccept
+#define ROSABENCH_ACCEPT_SHARDED		1				//:ÿһ߳CRosaSocketAcceptSharded
+#define ROSABENCH_ACCEPT_COUNT			2
+
+#define ROSABENCH_CONNECT_BLOCKING		0				//ͻ:CRosaSocketConnectϿ
+#define ROSABENCH_CONNECT_CONNECTOR		1				//ͻ:CRosaConnector첽(һ¼ѭ߳, ̶ֹ;)
+#define ROSABENCH_CONNECT_COUNT			2
+
+#define ROSABENCH_CONNECT_DRAIN_MAX		5000			//ʽȴ;ɵʱ()
+
+#define ROSABENCH_DEFAULT_CONNECT_THREADS	"1,4"		//ĬϿͻ߳(ʽΪ;)
+
+//Struct Definition
+typedef struct
+{
+	int nAccept;				// ˷ʽ(ROSABENCH_ACCEPT_*)
+	int nConnect;				// ͻ˷ʽ(ROSABENCH_CONNECT_*)
+	UINT uiThreads;				// ͻ߳(ʽΪͬʱ;)
+	UINT uiSeconds;				// ʱ
+	USHORT sPort;				// ˿
+}S_CONNBENCHCONFIG, *LPS_CONNBENCHCONFIG;
+
+//Class Declaration
+class CRosaBenchConnect;
+
+typedef struct
+{
+	CRosaBenchConnect* pBench;	// 
+	ULONGLONG ullConnects;		// ɹ
+	ULONGLONG ullErrors;		// ʧܴ
+}S_CONNBENCHCLIENT, *LPS_CONNBENCHCLIENT;
+
+typedef struct
+{
+	CRosaBenchConnect* pBench;	// 
+	LONGLONG llStart;			// ӿʼʱܼ
+	ULONGLONG ullConnects;		// ɹ
+	ULONGLONG ullErrors;		// ʧܴ
+}S_CONNBENCHSLOT, *LPS_CONNBENCHSLOT;
+
+//Class Definition
+class CRosaBenchConnect
+{
+public:
+	CRosaBenchConnect();		// CRosaBenchConnect 캯
+	~CRosaBenchConnect();		// CRosaBenchConnect 
+
+public:
+	string CRosaBenchConnectRun(const S_CONNBENCHCONFIG& sConfig);		// CRosaBenchConnect һ(JSON)
+
+	static const char* CRosaBenchConnectGetAcceptName(int nAccept);		// CRosaBenchConnect ȡ˷ʽ
+	static const char* CRosaBenchConnectGetConnectName(int nConnect);	// CRosaBenchConnect ȡͻ˷ʽ
+
+	static void CRosaBenchConnectUsage();												// CRosaBenchConnect ѡ˵
+	static int CRosaBenchConnectParse(const char* pcArg, const char* pcValue);			// CRosaBenchConnect ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchConnectMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchConnect ȫ
+
+private:
+	static void OnAccept(void* pContext, SOCKET s, USHORT nShard);							// CRosaBenchConnect (̻߳Ƭ߳)
+	static unsigned __stdcall OnClientThread(void* pParam);									// CRosaBenchConnect ͻ߳
+	static void __stdcall OnConnectorDone(ULONGLONG ullConnectID, SOCKET s, int nResult, DWORD_PTR dwUser);	// CRosaBenchConnect 첽(¼ѭ߳)
+
+	void AcceptOne(SOCKET s, USHORT nShard);						// CRosaBenchConnect ͳƲرһ
+	void ClientBlocking(LPS_CONNBENCHCLIENT pClient, LONGLONG llDeadline);	// CRosaBenchConnect ѭ
+	void ClientConnector(LPS_CONNBENCHCLIENT pClient, LONGLONG llDeadline);	// CRosaBenchConnect 첽ѭ
+	void StartConnect(LPS_CONNBENCHSLOT pSlot);						// CRosaBenchConnect ʼһ첽(ʧʱò)
+
+	static void AbortiveClose(SOCKET s);							// CRosaBenchConnect ر(TIME_WAIT)
+
+private:
+	CRosaBenchServer m_Server;					// CRosaBenchConnect (ÿ¼)
+
+	S_CONNBENCHCONFIG m_sConfig;				// CRosaBenchConnect ǰԲ
+	volatile LONG m_lAccepted;					// CRosaBenchConnect ˽ܵ
+	volatile LONG m_lShardAccepted[SOB_SHARD_MAX_COUNT];	// CRosaBenchConnect ÿƬܵ
+	USHORT m_nShards;							// CRosaBenchConnect Ƭ
+	HANDLE m_hStartEvent;						// CRosaBenchConnect ͻ߳ͬʱʼ
+
+	CRosaConnector* m_pConnector;				// CRosaBenchConnect 첽(ʽ)
+	SOCKADDR_STORAGE m_addrServer;				// CRosaBenchConnect ˵ַ(ʽ, )
+	LONGLONG m_llDeadline;						// CRosaBenchConnect ʱܼ(ʽ)
+	volatile LONG m_lInFlight;					// CRosaBenchConnect ڼӲ(ʽ)
+	CRosaHistogram m_Latency;					// CRosaBenchConnect ӽʱ
+
+};
+
+#endif // !__CROSABENCHCONNECT_H__
@@ -0,0 +1,546 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchCoroutine.cpp
+* @brief	This File is RosaBenchCoroutine Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchCoroutine.h"
+
+//Include Rosa Header File
+#include "../Rosa/CRosaAsyncEcho.h"
+
+//Include C/C++ Header File
+#include <process.h>
+#include <stdio.h>
+#include <tlhelp32.h>
+
+//CRosaBenchCoroutine Է˲(ÿһ̡߳ÿһЭ̼ɶ˿/RIOʱ¼߳)
+
+// ѡ(бʱȡĬֵ)
+static vector<UINT> g_vecEchoConn;
+static vector<UINT> g_vecEchoSize;
+
+// ʽ
+static const char* g_pcEchoServerName[ROSABENCH_ECHO_COUNT] = { "thread", "coroutine", "iocp", "rio" };
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchCoroutine()
+// @Purpose: CRosaBenchCoroutine캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchCoroutine::CRosaBenchCoroutine()
+{
+	memset(&m_sConfig, 0, sizeof(m_sConfig));
+
+	m_bExit = FALSE;
+	m_lServerConn = 0;
+
+	m_pLoop = NULL;
+	m_pEcho = NULL;
+	m_pEngine = NULL;
+	m_lSendFull = 0;
+
+	m_hStartEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+
+	m_Latency.CRosaHistogramCreate();
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchCoroutine()
+// @Purpose: CRosaBenchCoroutine
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchCoroutine::~CRosaBenchCoroutine()
+{
+	CloseConnections();
+	StopServer();
+
+	if (m_hStartEvent)
+	{
+		CloseHandle(m_hStartEvent);
+		m_hStartEvent = NULL;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchCoroutineRun()
+// @Purpose: CRosaBenchCoroutineһ(ÿ)
+// @Since: v1.00a
+// @Para: const S_ECHOBENCHCONFIG& sConfig(Բ)
+// @Return: string strJson ()
+//------------------------------------------------------------------
+string CRosaBenchCoroutine::CRosaBenchCoroutineRun(const S_ECHOBENCHCONFIG & sConfig)
+{
+	char chHead[512] = { 0 };
+
+	m_sConfig = sConfig;
+	m_sConfig.uiConnections = (m_sConfig.uiConnections < 1) ? 1 : m_sConfig.uiConnections;
+	m_sConfig.uiSize = (m_sConfig.uiSize < 1) ? 1 : m_sConfig.uiSize;
+
+	UINT uiThreads = min(m_sConfig.uiConnections, (UINT)ROSABENCH_ECHO_CLIENT_THREADS);
+
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"echo\",\"server\":\"%s\",\"connections\":%u,\"size\":%u,\"client_threads\":%u,\"loop_threads\":%u",
+		CRosaBenchCoroutineGetServerName(m_sConfig.nServer), m_sConfig.uiConnections, m_sConfig.uiSize, uiThreads,
+		(m_sConfig.nServer == ROSABENCH_ECHO_THREAD) ? 0 : ROSABENCH_ECHO_LOOP_THREADS);
+
+	DWORD dwIdleThreads = ProcessThreadCount();
+
+	if (!StartServer())
+	{
+		StopServer();
+		return string("{") + chHead + ",\"error\":\"server start failed\"}";
+	}
+
+	// ϵͳ֧RIOʱ˵ɶ˿, עʵ
+	if (m_sConfig.nServer == ROSABENCH_ECHO_RIO && m_pEngine->CRosaIOEngineGetEngine() != ROSA_IO_ENGINE_RIO)
+	{
+		StopServer();
+		return string("{") + chHead + ",\"skipped\":\"RIO not available\"}";
+	}
+
+	// 
+	for (UINT i = 0; i < m_sConfig.uiConnections; ++i)
+	{
+		CRosaSocket* pConn = new CRosaSocket();
+		m_vecConn.push_back(pConn);
+
+		if (!pConn->CRosaSocketConnect("127.0.0.1", m_sConfig.sPort))
+		{
+			char chError[128] = { 0 };
+			sprintf_s(chError, sizeof(chError), ",\"error\":\"connect failed at %u (WSA %d)\"}", i, pConn->m_nLastWSAError);
+
+			CloseConnections();
+			StopServer();
+			return string("{") + chHead + chError;
+		}
+	}
+
+	// Ӳͻ߳
+	vector<S_ECHOBENCHCLIENT> vecClient(uiThreads);
+	vector<HANDLE> vecThread;
+
+	for (UINT i = 0; i < uiThreads; ++i)
+	{
+		UINT uiFirst = (UINT)((ULONGLONG)m_sConfig.uiConnections * i / uiThreads);
+		UINT uiLast = (UINT)((ULONGLONG)m_sConfig.uiConnections * (i + 1) / uiThreads);
+
+		memset(&vecClient[i], 0, sizeof(S_ECHOBENCHCLIENT));
+		vecClient[i].pBench = this;
+		vecClient[i].uiFirst = uiFirst;
+		vecClient[i].uiCount = uiLast - uiFirst;
+
+		HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, OnClientThread, &vecClient[i], 0, NULL);
+		if (hThread)
+		{
+			vecThread.push_back(hThread);
+		}
+	}
+
+	// ȫӽ߳(ͻ߳, ̷߳ʽȵȴ߳ȫ)
+	for (DWORD dwWait = 0; m_sConfig.nServer == ROSABENCH_ECHO_THREAD && (UINT)m_lServerConn < m_sConfig.uiConnections && dwWait < ROSABENCH_ECHO_DRAIN_MAX; dwWait += 10)
+	{
+		Sleep(10);
+	}
+
+	DWORD dwServerThreads = ProcessThreadCount() - (DWORD)vecThread.size() - dwIdleThreads;
+
+	m_Latency.CRosaHistogramReset();
+
+	S_BENCHCPU sCpu;
+	BenchCpuStart(sCpu);
+	SetEvent(m_hStartEvent);
+
+	for (size_t i = 0; i < vecThread.size(); ++i)
+	{
+		WaitForSingleObject(vecThread[i], INFINITE);
+		CloseHandle(vecThread[i]);
+	}
+
+	double dSeconds = 0.0;
+	double dCpu = BenchCpuStop(sCpu, dSeconds);
+	ResetEvent(m_hStartEvent);
+
+	CloseConnections();
+	StopServer();
+
+	LONG lSendFull = m_lSendFull;
+
+	// 
+	ULONGLONG ullMessages = 0;
+	ULONGLONG ullErrors = 0;
+
+	for (UINT i = 0; i < uiThreads; ++i)
+	{
+		ullMessages += vecClient[i].ullMessages;
+		ullErrors += vecClient[i].ullErrors;
+	}
+
+	char chResult[512] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"seconds\":%.3f,\"messages\":%llu,\"errors\":%llu,\"messages_per_sec\":%.1f,\"server_threads\":%lu,\"send_full\":%ld,\"cpu_percent\":%.1f,\"rtt_ns\":",
+		dSeconds, ullMessages, ullErrors, (dSeconds > 0.0) ? ullMessages / dSeconds : 0.0, dwServerThreads, lSendFull, dCpu);
+
+	return string("{") + chHead + chResult + BenchSummaryJson(m_Latency) + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchCoroutineGetServerName()
+// @Purpose: CRosaBenchCoroutineȡ˷ʽ
+// @Since: v1.00a
+// @Para: int nServer(ROSABENCH_ECHO_*)
+// @Return: const char* pcName
+//------------------------------------------------------------------
+const char * CRosaBenchCoroutine::CRosaBenchCoroutineGetServerName(int nServer)
+{
+	if (nServer < 0 || nServer >= ROSABENCH_ECHO_COUNT)
+	{
+		return "";
+	}
+
+	return g_pcEchoServerName[nServer];
+}
+
+//------------------------------------------------------------------
+// @Function:	 StartServer()
+// @Purpose: CRosaBenchCoroutineǰʽĻԷ
+// @Since: v1.00a
+// @Para: None
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool CRosaBenchCoroutine::StartServer()
+{
+	if (m_sConfig.nServer == ROSABENCH_ECHO_COROUTINE)
+	{
+		m_pLoop = new CRosaEventLoop();
+		m_pEcho = new CRosaAsyncEcho();
+
+		return (m_pLoop->CRosaEventLoopCreate(ROSABENCH_ECHO_LOOP_THREADS) && m_pEcho->CRosaAsyncEchoStart(m_pLoop, m_sConfig.sPort));
+	}
+
+	if (m_sConfig.nServer == ROSABENCH_ECHO_IOCP || m_sConfig.nServer == ROSABENCH_ECHO_RIO)
+	{
+		// ÿԤͶݵĽռһϢķ軺Ƭ
+		UINT uiSlices = m_sConfig.uiConnections * (ROSA_IO_RECV_DEPTH + (m_sConfig.uiSize + ROSA_IO_SLICE_SIZE - 1) / ROSA_IO_SLICE_SIZE);
+		uiSlices = max(uiSlices, (UINT)ROSA_IO_SLICE_COUNT);
+
+		m_pLoop = new CRosaEventLoop();
+		m_pEngine = new CRosaIOEngine();
+		m_lSendFull = 0;
+
+		return (m_pLoop->CRosaEventLoopCreate(ROSABENCH_ECHO_LOOP_THREADS) &&
+			m_pEngine->CRosaIOEngineCreate(m_pLoop, OnEngineRecv, (DWORD_PTR)this, (m_sConfig.nServer == ROSABENCH_ECHO_RIO) ? ROSA_IO_ENGINE_RIO : ROSA_IO_ENGINE_IOCP,
+				max(m_sConfig.uiConnections, (UINT)ROSA_IO_MAX_CONNECTIONS), uiSlices) &&
+			m_pEngine->CRosaIOEngineListen(m_sConfig.sPort, NULL));
+	}
+
+	m_bExit = FALSE;
+	m_lServerConn = 0;
+
+	return m_Server.CRosaBenchServerStart(m_sConfig.sPort, OnAccept, this);
+}
+
+//------------------------------------------------------------------
+// @Function:	 StopServer()
+// @Purpose: CRosaBenchCoroutineֹͣԷ(Э̷ʽȴȫỰ, ̷߳ʽȴ߳˳)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchCoroutine::StopServer()
+{
+	if (m_pEcho)
+	{
+		m_pEcho->CRosaAsyncEchoStop();
+		delete m_pEcho;
+		m_pEcho = NULL;
+	}
+
+	if (m_pEngine)
+	{
+		m_pEngine->CRosaIOEngineDestroy();
+		delete m_pEngine;
+		m_pEngine = NULL;
+	}
+
+	if (m_pLoop)
+	{
+		m_pLoop->CRosaEventLoopDestroy();
+		delete m_pLoop;
+		m_pLoop = NULL;
+	}
+
+	m_bExit = TRUE;
+	m_Server.CRosaBenchServerStop();
+
+	for (DWORD dwWait = 0; m_lServerConn > 0 && dwWait < ROSABENCH_ECHO_DRAIN_MAX; dwWait += 10)
+	{
+		Sleep(10);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CloseConnections()
+// @Purpose: CRosaBenchCoroutineرտͻ
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchCoroutine::CloseConnections()
+{
+	for (vector<CRosaSocket*>::iterator iter = m_vecConn.begin(); iter != m_vecConn.end(); ++iter)
+	{
+		delete *iter;
+	}
+
+	m_vecConn.clear();
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAccept()
+// @Purpose: CRosaBenchCoroutine(ÿһСջ߳)
+// @Since: v1.00a
+// @Para: void* pContext(Զ)
+// @Para: SOCKET s(ͻ׽)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchCoroutine::OnAccept(void * pContext, SOCKET s, USHORT nShard)
+{
+	CRosaBenchCoroutine* pBench = reinterpret_cast<CRosaBenchCoroutine*>(pContext);
+
+	BenchStartConnThread(OnServerConn, pBench, s, pBench->m_lServerConn, ROSABENCH_THREAD_STACK);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnServerConn()
+// @Purpose: CRosaBenchCoroutine߳(յٻԶ, CRosaAsyncEchoͬ; ͻ˹رպ˳)
+// @Since: v1.00a
+// @Para: void* pParam(S_BENCHCONN)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchCoroutine::OnServerConn(void * pParam)
+{
+	LPS_BENCHCONN pConn = reinterpret_cast<LPS_BENCHCONN>(pParam);
+	CRosaBenchCoroutine* pBench = reinterpret_cast<CRosaBenchCoroutine*>(pConn->pContext);
+
+	CRosaSocket Conn;
+	Conn.CRosaSocketAttachRawSocket(pConn->Socket, true);
+	delete pConn;
+
+	char* pBuffer = new char[ROSA_ECHO_BUFFER_SIZE];
+
+	while (true)
+	{
+		UINT uiRecv = 0;
+		int nRet = Conn.CRosaSocketRecvOnce(pBuffer, ROSA_ECHO_BUFFER_SIZE, uiRecv, 1);
+
+		if (nRet == SOB_RET_TIMEOUT && !pBench->m_bExit)
+		{
+			continue;
+		}
+
+		if (nRet != SOB_RET_OK || uiRecv == 0 || Conn.CRosaSocketSendBuffer(pBuffer, uiRecv) != SOB_RET_OK)
+		{
+			break;
+		}
+	}
+
+	delete[] pBuffer;
+
+	InterlockedDecrement(&pBench->m_lServerConn);
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnEngineRecv()
+// @Purpose: CRosaBenchCoroutineյ(¼ѭ߳, ԭ; עỺ岻ʱر, ͻ˼Ϊʧ)
+// @Since: v1.00a
+// @Para: ULONGLONG ullConnID(ID)
+// @Para: const char* pData()
+// @Para: UINT uiSize(ݳ)
+// @Para: int nResult(SOB_RET_*)
+// @Para: DWORD_PTR dwUser(Զ)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaBenchCoroutine::OnEngineRecv(ULONGLONG ullConnID, const char * pData, UINT uiSize, int nResult, DWORD_PTR dwUser)
+{
+	CRosaBenchCoroutine* pBench = reinterpret_cast<CRosaBenchCoroutine*>(dwUser);
+
+	if (nResult != SOB_RET_OK)
+	{
+		return;
+	}
+
+	if (pBench->m_pEngine->CRosaIOEngineSend(ullConnID, pData, uiSize) != SOB_RET_OK)
+	{
+		InterlockedIncrement(&pBench->m_lSendFull);
+		pBench->m_pEngine->CRosaIOEngineClose(ullConnID);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnClientThread()
+// @Purpose: CRosaBenchCoroutineͻ߳(ÿһ)
+// @Since: v1.00a
+// @Para: void* pParam(S_ECHOBENCHCLIENT)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchCoroutine::OnClientThread(void * pParam)
+{
+	LPS_ECHOBENCHCLIENT pClient = reinterpret_cast<LPS_ECHOBENCHCLIENT>(pParam);
+	CRosaBenchCoroutine* pBench = pClient->pBench;
+
+	UINT uiSize = pBench->m_sConfig.uiSize;
+	char* pSendBuffer = new char[uiSize];
+	char* pRecvBuffer = new char[uiSize];
+	memset(pSendBuffer, 'R', uiSize);
+
+	WaitForSingleObject(pBench->m_hStartEvent, INFINITE);
+
+	LARGE_INTEGER liFrequency;
+	QueryPerformanceFrequency(&liFrequency);
+
+	LONGLONG llDeadline = CRosaHistogram::CRosaHistogramNow() + liFrequency.QuadPart * pBench->m_sConfig.uiSeconds;
+
+	while (CRosaHistogram::CRosaHistogramNow() < llDeadline && pClient->ullErrors == 0)
+	{
+		for (UINT i = 0; i < pClient->uiCount; ++i)
+		{
+			CRosaSocket* pConn = pBench->m_vecConn[pClient->uiFirst + i];
+			LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+
+			if (pConn->CRosaSocketSendBuffer(pSendBuffer, uiSize) != SOB_RET_OK ||
+				pConn->CRosaSocketRecvBuffer(pRecvBuffer, uiSize, uiSize) != SOB_RET_OK)
+			{
+				pClient->ullErrors++;
+				break;
+			}
+
+			pBench->m_Latency.CRosaHistogramRecordSince(llStart);
+			pClient->ullMessages++;
+		}
+	}
+
+	delete[] pSendBuffer;
+	delete[] pRecvBuffer;
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ProcessThreadCount()
+// @Purpose: CRosaBenchCoroutineȡ߳
+// @Since: v1.00a
+// @Para: None
+// @Return: DWORD dwThreads
+//------------------------------------------------------------------
+DWORD CRosaBenchCoroutine::ProcessThreadCount()
+{
+	HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+	if (hSnapshot == INVALID_HANDLE_VALUE)
+	{
+		return 0;
+	}
+
+	DWORD dwProcessID = GetCurrentProcessId();
+	DWORD dwThreads = 0;
+
+	THREADENTRY32 sEntry;
+	sEntry.dwSize = sizeof(sEntry);
+
+	for (BOOL bMore = Thread32First(hSnapshot, &sEntry); bMore; bMore = Thread32Next(hSnapshot, &sEntry))
+	{
+		if (sEntry.th32OwnerProcessID == dwProcessID)
+		{
+			dwThreads++;
+		}
+	}
+
+	CloseHandle(hSnapshot);
+
+	return dwThreads;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchCoroutineUsage()
+// @Purpose: CRosaBenchCoroutineѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchCoroutine::CRosaBenchCoroutineUsage()
+{
+	fprintf(stderr,
+		"  --echo-conns <list>    connections to the thread, coroutine, IOCP and RIO echo servers (default: " ROSABENCH_DEFAULT_ECHO_CONNS ")\n"
+		"  --echo-sizes <list>    echo message sizes (default: " ROSABENCH_DEFAULT_ECHO_SIZES ")\n");
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchCoroutineParse()
+// @Purpose: CRosaBenchCoroutineѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchCoroutine::CRosaBenchCoroutineParse(const char * pcArg, const char * pcValue)
+{
+	bool bOk = false;
+
+	if (strcmp(pcArg, "--echo-conns") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecEchoConn);
+	}
+	else if (strcmp(pcArg, "--echo-sizes") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecEchoSize);
+	}
+	else
+	{
+		return ROSABENCH_PARSE_UNKNOWN;
+	}
+
+	return bOk ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchCoroutineMain()
+// @Purpose: CRosaBenchCoroutineȫ(˷ʽ*Ϣ*)
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchCoroutine::CRosaBenchCoroutineMain(const S_BENCHCOMMON & sCommon)
+{
+	if (g_vecEchoConn.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_ECHO_CONNS, g_vecEchoConn);
+	}
+
+	if (g_vecEchoSize.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_ECHO_SIZES, g_vecEchoSize);
+	}
+
+	CRosaBenchCoroutine BenchCoroutine;
+
+	for (int e = 0; e < ROSABENCH_ECHO_COUNT; ++e)
+	{
+		for (size_t s = 0; s < g_vecEchoSize.size(); ++s)
+		{
+			for (size_t c = 0; c < g_vecEchoConn.size(); ++c)
+			{
+				S_ECHOBENCHCONFIG sConfig = { e, g_vecEchoConn[c], g_vecEchoSize[s], sCommon.uiSeconds, sCommon.sPort };
+				BenchOutput(BenchCoroutine.CRosaBenchCoroutineRun(sConfig));
+			}
+		}
+	}
+}
@@ -0,0 +1,107 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchCoroutine.h
+* @brief	This File is RosaBenchCoroutine Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHCOROUTINE_H__
+#define __CROSABENCHCOROUTINE_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Include Rosa Header File
+#include "../Rosa/CRosaEventLoop.h"
+#include "../Rosa/CRosaIOEngine.h"
+
+//Macro Definition
+#define ROSABENCH_ECHO_THREAD			0				//:CRosaSocketAcceptÿһ߳
+#define ROSABENCH_ECHO_COROUTINE		1				//:CRosaAsyncEchoÿһЭ(¼ѭ߳)
+#define ROSABENCH_ECHO_IOCP				2				//:CRosaIOEngineɶ˿
+#define ROSABENCH_ECHO_RIO				3				//:CRosaIOEngine RIO(עỺ, ȡ)
+#define ROSABENCH_ECHO_COUNT			4
+
+#define ROSABENCH_ECHO_LOOP_THREADS		2				//Э̼¼ѭ߳
+#define ROSABENCH_ECHO_CLIENT_THREADS	4				//ͻ߳(ƽ, )
+#define ROSABENCH_ECHO_DRAIN_MAX		3000			//ȴ߳˳ʱ()
+
+#define ROSABENCH_DEFAULT_ECHO_CONNS	"100,1000"		//Ĭ
+#define ROSABENCH_DEFAULT_ECHO_SIZES	"64,16K"		//ĬϢ
+
+//Struct Definition
+typedef struct
+{
+	int nServer;				// ˷ʽ(ROSABENCH_ECHO_*)
+	UINT uiConnections;			// 
+	UINT uiSize;				// Ϣ
+	UINT uiSeconds;				// ʱ
+	USHORT sPort;				// ˿
+}S_ECHOBENCHCONFIG, *LPS_ECHOBENCHCONFIG;
+
+//Class Declaration
+class CRosaBenchCoroutine;
+class CRosaAsyncEcho;
+
+typedef struct
+{
+	CRosaBenchCoroutine* pBench;	// 
+	UINT uiFirst;				// һ
+	UINT uiCount;				// 
+	ULONGLONG ullMessages;		// ɵ
+	ULONGLONG ullErrors;		// ʧܴ
+}S_ECHOBENCHCLIENT, *LPS_ECHOBENCHCLIENT;
+
+//Class Definition
+class CRosaBenchCoroutine
+{
+public:
+	CRosaBenchCoroutine();		// CRosaBenchCoroutine 캯
+	~CRosaBenchCoroutine();		// CRosaBenchCoroutine 
+
+public:
+	string CRosaBenchCoroutineRun(const S_ECHOBENCHCONFIG& sConfig);	// CRosaBenchCoroutine һ(JSON)
+
+	static const char* CRosaBenchCoroutineGetServerName(int nServer);	// CRosaBenchCoroutine ȡ˷ʽ
+
+	static void CRosaBenchCoroutineUsage();												// CRosaBenchCoroutine ѡ˵
+	static int CRosaBenchCoroutineParse(const char* pcArg, const char* pcValue);			// CRosaBenchCoroutine ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchCoroutineMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchCoroutine ȫ
+
+private:
+	static void OnAccept(void* pContext, SOCKET s, USHORT nShard);							// CRosaBenchCoroutine (ÿһСջ߳)
+	static unsigned __stdcall OnServerConn(void* pParam);									// CRosaBenchCoroutine ߳()
+	static unsigned __stdcall OnClientThread(void* pParam);									// CRosaBenchCoroutine ͻ߳
+	static void __stdcall OnEngineRecv(ULONGLONG ullConnID, const char* pData, UINT uiSize, int nResult, DWORD_PTR dwUser);	// CRosaBenchCoroutine յ()
+
+	bool StartServer();												// CRosaBenchCoroutine ǰʽĻԷ
+	void StopServer();												// CRosaBenchCoroutine ֹͣԷ
+	void CloseConnections();										// CRosaBenchCoroutine رտͻ
+
+	static DWORD ProcessThreadCount();								// CRosaBenchCoroutine ȡ߳
+
+private:
+	S_ECHOBENCHCONFIG m_sConfig;				// CRosaBenchCoroutine ǰԲ
+
+	CRosaBenchServer m_Server;					// CRosaBenchCoroutine ̷߳ʽ
+	BOOL m_bExit;								// CRosaBenchCoroutine ˳־(̷߳ʽ߳)
+	volatile LONG m_lServerConn;				// CRosaBenchCoroutine ̷߳ʽ߳
+
+	CRosaEventLoop* m_pLoop;					// CRosaBenchCoroutine Э̷ʽ¼ѭ
+	CRosaAsyncEcho* m_pEcho;					// CRosaBenchCoroutine Э̷ʽԷ(ͷļҪ/await, ֻԴļа)
+	CRosaIOEngine* m_pEngine;					// CRosaBenchCoroutine 淽ʽԷ
+	volatile LONG m_lSendFull;					// CRosaBenchCoroutine 淽ʽעỺ岻رյ
+
+	vector<CRosaSocket*> m_vecConn;				// CRosaBenchCoroutine ͻ
+	HANDLE m_hStartEvent;						// CRosaBenchCoroutine ͻ߳ͬʱʼ
+	CRosaHistogram m_Latency;					// CRosaBenchCoroutine ʱ
+
+};
+
+#endif // !__CROSABENCHCOROUTINE_H__
@@ -0,0 +1,572 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchHeartbeat.cpp
+* @brief	This File is RosaBenchHeartbeat Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchHeartbeat.h"
+
+//Include C/C++ Header File
+#include <process.h>
+#include <stdio.h>
+
+//CRosaBenchHeartbeat (ֶԶ˶жʱ, Լʱ̼߳ӵCPUռ)
+
+// ѡ(бʱȡĬֵ)
+static vector<UINT> g_vecHbConn;
+static UINT g_uiHbLoopback = ROSABENCH_DEFAULT_HB_LOOPBACK;
+static UINT g_uiHbFrozen = ROSABENCH_DEFAULT_HB_FROZEN;
+
+// ʽ
+static const char* g_pcHeartbeatModeName[ROSABENCH_HEARTBEAT_COUNT] = { "simulated", "loopback" };
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchHeartbeat()
+// @Purpose: CRosaBenchHeartbeat캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchHeartbeat::CRosaBenchHeartbeat()
+{
+	memset(&m_sConfig, 0, sizeof(m_sConfig));
+	m_pHeartbeat = NULL;
+	m_bExit = FALSE;
+
+	InitializeCriticalSection(&m_csPeer);
+	m_lPongs = 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchHeartbeat()
+// @Purpose: CRosaBenchHeartbeat
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchHeartbeat::~CRosaBenchHeartbeat()
+{
+	DeleteCriticalSection(&m_csPeer);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchHeartbeatRun()
+// @Purpose: CRosaBenchHeartbeatһ(ӿʼʱ, жʱӦӽ+Ӧʱ)
+// @Since: v1.00a
+// @Para: const S_HEARTBEATBENCHCONFIG& sConfig(Բ)
+// @Return: string strJson ()
+//------------------------------------------------------------------
+string CRosaBenchHeartbeat::CRosaBenchHeartbeatRun(const S_HEARTBEATBENCHCONFIG & sConfig)
+{
+	char chHead[512] = { 0 };
+
+	m_sConfig = sConfig;
+	m_sConfig.uiConnections = (m_sConfig.uiConnections < 1) ? 1 : m_sConfig.uiConnections;
+	m_sConfig.uiFrozenPercent = min(m_sConfig.uiFrozenPercent, (UINT)100);
+
+	UINT uiFrozen = (UINT)((ULONGLONG)m_sConfig.uiConnections * m_sConfig.uiFrozenPercent / 100);
+	UINT uiSeconds = max(m_sConfig.uiSeconds, (UINT)((ROSABENCH_HEARTBEAT_INTERVAL + ROSABENCH_HEARTBEAT_TIMEOUT) * ROSABENCH_HEARTBEAT_ROUNDS / 1000));
+
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"heartbeat\",\"mode\":\"%s\",\"connections\":%u,\"frozen\":%u,\"interval_ms\":%d,\"timeout_ms\":%d,\"tick_ms\":%d",
+		CRosaBenchHeartbeatGetModeName(m_sConfig.nMode), m_sConfig.uiConnections, uiFrozen,
+		ROSABENCH_HEARTBEAT_INTERVAL, ROSABENCH_HEARTBEAT_TIMEOUT, ROSABENCH_HEARTBEAT_TICK);
+
+	// ӱ(ģⷽʽ׽ֵֻΪ)
+	EnterCriticalSection(&m_csPeer);
+	m_mapPeer.clear();
+	LeaveCriticalSection(&m_csPeer);
+	m_lPongs = 0;
+
+	if (m_sConfig.nMode == ROSABENCH_HEARTBEAT_LOOPBACK)
+	{
+		if (!StartLoopback(uiFrozen))
+		{
+			StopLoopback();
+			return string("{") + chHead + ",\"error\":\"loopback connect failed\"}";
+		}
+	}
+	else
+	{
+		EnterCriticalSection(&m_csPeer);
+		for (UINT i = 0; i < m_sConfig.uiConnections; ++i)
+		{
+			S_HEARTBEATBENCHPEER sPeer = { (i < uiFrozen), false, 0 };
+			m_mapPeer[(SOCKET)((i + 1) * 4)] = sPeer;
+		}
+		LeaveCriticalSection(&m_csPeer);
+	}
+
+	// ¼ѭ̳߳еȫ
+	CRosaEventLoop Loop;
+	CRosaHeartbeat Heartbeat;
+
+	if (!Loop.CRosaEventLoopCreate(1) ||
+		!Heartbeat.CRosaHeartbeatCreate(&Loop, OnDead, (DWORD_PTR)this, ROSABENCH_HEARTBEAT_INTERVAL, ROSABENCH_HEARTBEAT_TIMEOUT, ROSABENCH_HEARTBEAT_TICK))
+	{
+		Loop.CRosaEventLoopDestroy();
+		StopLoopback();
+		return string("{") + chHead + ",\"error\":\"event loop\"}";
+	}
+
+	Heartbeat.CRosaHeartbeatSetPingCallback(OnPing);
+	m_pHeartbeat = &Heartbeat;
+
+	S_BENCHCPU sCpu;
+	BenchCpuStart(sCpu);
+
+	EnterCriticalSection(&m_csPeer);
+	for (map<SOCKET, S_HEARTBEATBENCHPEER>::iterator iter = m_mapPeer.begin(); iter != m_mapPeer.end(); ++iter)
+	{
+		Heartbeat.CRosaHeartbeatAdd(iter->first);
+	}
+	LeaveCriticalSection(&m_csPeer);
+
+	LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+
+	Sleep(uiSeconds * 1000);
+
+	double dSeconds = 0.0;
+	double dCpu = BenchCpuStop(sCpu, dSeconds);
+
+	ULONGLONG ullPings = Heartbeat.CRosaHeartbeatGetPingCount();
+	UINT uiMonitored = Heartbeat.CRosaHeartbeatGetCount();
+
+	m_pHeartbeat = NULL;
+	Heartbeat.CRosaHeartbeatDestroy();
+	Loop.CRosaEventLoopDestroy();
+
+	StopLoopback();
+
+	// 
+	CRosaHistogram Detect;
+	Detect.CRosaHistogramCreate(1);
+
+	UINT uiDetected = 0;
+	UINT uiFalseDead = 0;
+
+	EnterCriticalSection(&m_csPeer);
+	for (map<SOCKET, S_HEARTBEATBENCHPEER>::iterator iter = m_mapPeer.begin(); iter != m_mapPeer.end(); ++iter)
+	{
+		if (!iter->second.bDead)
+		{
+			continue;
+		}
+
+		if (iter->second.bFrozen)
+		{
+			Detect.CRosaHistogramRecord(CRosaHistogram::CRosaHistogramToNanoSec(iter->second.llDead - llStart));
+			uiDetected++;
+		}
+		else
+		{
+			uiFalseDead++;
+		}
+	}
+	m_mapPeer.clear();
+	LeaveCriticalSection(&m_csPeer);
+
+	char chResult[512] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"seconds\":%.3f,\"pings\":%llu,\"pongs\":%ld,\"pings_per_sec\":%.1f,\"detected\":%u,\"false_dead\":%u,\"still_monitored\":%u,\"cpu_percent\":%.2f,\"detect_ns\":",
+		dSeconds, ullPings, m_lPongs, (dSeconds > 0.0) ? ullPings / dSeconds : 0.0, uiDetected, uiFalseDead, uiMonitored, dCpu);
+
+	return string("{") + chHead + chResult + BenchSummaryJson(Detect) + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchHeartbeatGetModeName()
+// @Purpose: CRosaBenchHeartbeatȡӷʽ
+// @Since: v1.00a
+// @Para: int nMode(ROSABENCH_HEARTBEAT_*)
+// @Return: const char* pcName
+//------------------------------------------------------------------
+const char * CRosaBenchHeartbeat::CRosaBenchHeartbeatGetModeName(int nMode)
+{
+	if (nMode < 0 || nMode >= ROSABENCH_HEARTBEAT_COUNT)
+	{
+		return "";
+	}
+
+	return g_pcHeartbeatModeName[nMode];
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnPing()
+// @Purpose: CRosaBenchHeartbeatping(ģⷽʽδΪյpong, ػʽһֽ)
+// @Since: v1.00a
+// @Para: SOCKET s(׽)
+// @Para: DWORD_PTR dwUser(Զ)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaBenchHeartbeat::OnPing(SOCKET s, DWORD_PTR dwUser)
+{
+	CRosaBenchHeartbeat* pBench = reinterpret_cast<CRosaBenchHeartbeat*>(dwUser);
+
+	if (pBench->m_sConfig.nMode == ROSABENCH_HEARTBEAT_LOOPBACK)
+	{
+		char chPing = 'P';
+		send(s, &chPing, 1, 0);
+		return;
+	}
+
+	EnterCriticalSection(&pBench->m_csPeer);
+	map<SOCKET, S_HEARTBEATBENCHPEER>::iterator iter = pBench->m_mapPeer.find(s);
+	bool bAnswer = (iter != pBench->m_mapPeer.end() && !iter->second.bFrozen);
+	LeaveCriticalSection(&pBench->m_csPeer);
+
+	CRosaHeartbeat* pHeartbeat = pBench->m_pHeartbeat;
+	if (bAnswer && pHeartbeat)
+	{
+		InterlockedIncrement(&pBench->m_lPongs);
+		pHeartbeat->CRosaHeartbeatNotifyRecv(s);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnDead()
+// @Purpose: CRosaBenchHeartbeatԶʧЧ(¼жʱ, ڲԽʱر)
+// @Since: v1.00a
+// @Para: SOCKET s(׽)
+// @Para: DWORD_PTR dwUser(Զ)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaBenchHeartbeat::OnDead(SOCKET s, DWORD_PTR dwUser)
+{
+	CRosaBenchHeartbeat* pBench = reinterpret_cast<CRosaBenchHeartbeat*>(dwUser);
+	LONGLONG llNow = CRosaHistogram::CRosaHistogramNow();
+
+	EnterCriticalSection(&pBench->m_csPeer);
+
+	map<SOCKET, S_HEARTBEATBENCHPEER>::iterator iter = pBench->m_mapPeer.find(s);
+	if (iter != pBench->m_mapPeer.end() && !iter->second.bDead)
+	{
+		iter->second.bDead = true;
+		iter->second.llDead = llNow;
+	}
+
+	LeaveCriticalSection(&pBench->m_csPeer);
+}
+
+//------------------------------------------------------------------
+// @Function:	 StartLoopback()
+// @Purpose: CRosaBenchHeartbeatػӲǶ(˿ڶӦ, ˳򲻱˳һ)
+// @Since: v1.00a
+// @Para: UINT uiFrozen()
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool CRosaBenchHeartbeat::StartLoopback(UINT uiFrozen)
+{
+	if (!m_Server.CRosaBenchServerStart(m_sConfig.sPort, OnAccept, this))
+	{
+		return false;
+	}
+
+	map<USHORT, bool> mapClientFrozen;
+
+	for (UINT i = 0; i < m_sConfig.uiConnections; ++i)
+	{
+		CRosaSocket* pClient = new CRosaSocket();
+		m_vecClient.push_back(pClient);
+		m_vecClientFrozen.push_back(i < uiFrozen);
+
+		if (!pClient->CRosaSocketConnect("127.0.0.1", m_sConfig.sPort))
+		{
+			break;
+		}
+
+		SOCKADDR_IN addrLocal;
+		int nLength = sizeof(addrLocal);
+		getsockname(pClient->CRosaSocketGetRawSocket(), (SOCKADDR*)&addrLocal, &nLength);
+		mapClientFrozen[ntohs(addrLocal.sin_port)] = (i < uiFrozen);
+	}
+
+	// ȴȫӱֹܺͣ
+	for (DWORD dwWait = 0; dwWait < 5000; dwWait += 10)
+	{
+		EnterCriticalSection(&m_csPeer);
+		size_t nAccepted = m_vecServerSock.size();
+		LeaveCriticalSection(&m_csPeer);
+
+		if (nAccepted >= mapClientFrozen.size())
+		{
+			break;
+		}
+
+		Sleep(10);
+	}
+
+	m_Server.CRosaBenchServerStop();
+
+	EnterCriticalSection(&m_csPeer);
+	for (vector<SOCKET>::iterator iter = m_vecServerSock.begin(); iter != m_vecServerSock.end(); ++iter)
+	{
+		SOCKADDR_IN addrPeer;
+		int nLength = sizeof(addrPeer);
+		getpeername(*iter, (SOCKADDR*)&addrPeer, &nLength);
+
+		S_HEARTBEATBENCHPEER sPeer = { mapClientFrozen[ntohs(addrPeer.sin_port)], false, 0 };
+		m_mapPeer[*iter] = sPeer;
+	}
+	size_t nPeers = m_mapPeer.size();
+	LeaveCriticalSection(&m_csPeer);
+
+	if (nPeers < m_sConfig.uiConnections)
+	{
+		return false;
+	}
+
+	// ԶӦ̼߳˽߳(StopLoopbackλ˳־)
+	m_bExit = FALSE;
+
+	HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, OnPeerThread, this, 0, NULL);
+	if (hThread)
+	{
+		CloseHandle(hThread);
+	}
+
+	hThread = (HANDLE)_beginthreadex(NULL, 0, OnReaderThread, this, 0, NULL);
+	if (hThread)
+	{
+		CloseHandle(hThread);
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 StopLoopback()
+// @Purpose: CRosaBenchHeartbeatرջػ(Ӧ𼰽߳ÿ10˳־)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchHeartbeat::StopLoopback()
+{
+	if (m_vecClient.empty())
+	{
+		return;
+	}
+
+	m_bExit = TRUE;
+	Sleep(100);
+
+	for (vector<CRosaSocket*>::iterator iter = m_vecClient.begin(); iter != m_vecClient.end(); ++iter)
+	{
+		delete *iter;
+	}
+	m_vecClient.clear();
+	m_vecClientFrozen.clear();
+
+	EnterCriticalSection(&m_csPeer);
+	for (vector<SOCKET>::iterator iter = m_vecServerSock.begin(); iter != m_vecServerSock.end(); ++iter)
+	{
+		closesocket(*iter);
+	}
+	m_vecServerSock.clear();
+	LeaveCriticalSection(&m_csPeer);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAccept()
+// @Purpose: CRosaBenchHeartbeat(Ϊ׽)
+// @Since: v1.00a
+// @Para: void* pContext(Զ)
+// @Para: SOCKET s(ͻ׽)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchHeartbeat::OnAccept(void * pContext, SOCKET s, USHORT nShard)
+{
+	CRosaBenchHeartbeat* pBench = reinterpret_cast<CRosaBenchHeartbeat*>(pContext);
+
+	EnterCriticalSection(&pBench->m_csPeer);
+	pBench->m_vecServerSock.push_back(s);
+	LeaveCriticalSection(&pBench->m_csPeer);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnPeerThread()
+// @Purpose: CRosaBenchHeartbeatԶ߳(յpingظһֽpong, Ӷȡظ)
+// @Since: v1.00a
+// @Para: void* pParam(Զ)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchHeartbeat::OnPeerThread(void * pParam)
+{
+	CRosaBenchHeartbeat* pBench = reinterpret_cast<CRosaBenchHeartbeat*>(pParam);
+
+	vector<WSAPOLLFD> vecPoll;
+	for (size_t i = 0; i < pBench->m_vecClient.size(); ++i)
+	{
+		WSAPOLLFD sPoll = { pBench->m_vecClient[i]->CRosaSocketGetRawSocket(), POLLRDNORM, 0 };
+		vecPoll.push_back(sPoll);
+	}
+
+	char chBuffer[64];
+
+	while (!pBench->m_bExit && !vecPoll.empty())
+	{
+		if (WSAPoll(&vecPoll[0], (ULONG)vecPoll.size(), 10) <= 0)
+		{
+			continue;
+		}
+
+		for (size_t i = 0; i < vecPoll.size(); ++i)
+		{
+			if (vecPoll[i].revents == 0)
+			{
+				continue;
+			}
+
+			if (recv(vecPoll[i].fd, chBuffer, sizeof(chBuffer), 0) <= 0)
+			{
+				vecPoll[i].events = 0;
+				continue;
+			}
+
+			if (!pBench->m_vecClientFrozen[i])
+			{
+				char chPong = 'O';
+				send(vecPoll[i].fd, &chPong, 1, 0);
+			}
+		}
+	}
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnReaderThread()
+// @Purpose: CRosaBenchHeartbeat˽߳(յpong֪ͨ)
+// @Since: v1.00a
+// @Para: void* pParam(Զ)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchHeartbeat::OnReaderThread(void * pParam)
+{
+	CRosaBenchHeartbeat* pBench = reinterpret_cast<CRosaBenchHeartbeat*>(pParam);
+
+	vector<WSAPOLLFD> vecPoll;
+
+	EnterCriticalSection(&pBench->m_csPeer);
+	for (size_t i = 0; i < pBench->m_vecServerSock.size(); ++i)
+	{
+		WSAPOLLFD sPoll = { pBench->m_vecServerSock[i], POLLRDNORM, 0 };
+		vecPoll.push_back(sPoll);
+	}
+	LeaveCriticalSection(&pBench->m_csPeer);
+
+	char chBuffer[64];
+
+	while (!pBench->m_bExit && !vecPoll.empty())
+	{
+		if (WSAPoll(&vecPoll[0], (ULONG)vecPoll.size(), 10) <= 0)
+		{
+			continue;
+		}
+
+		for (size_t i = 0; i < vecPoll.size(); ++i)
+		{
+			if (vecPoll[i].revents == 0)
+			{
+				continue;
+			}
+
+			if (recv(vecPoll[i].fd, chBuffer, sizeof(chBuffer), 0) <= 0)
+			{
+				vecPoll[i].events = 0;
+				continue;
+			}
+
+			InterlockedIncrement(&pBench->m_lPongs);
+
+			// 񴴽֮ǰ֮յݲ֪ͨ
+			CRosaHeartbeat* pHeartbeat = pBench->m_pHeartbeat;
+			if (pHeartbeat)
+			{
+				pHeartbeat->CRosaHeartbeatNotifyRecv(vecPoll[i].fd);
+			}
+		}
+	}
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchHeartbeatUsage()
+// @Purpose: CRosaBenchHeartbeatѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchHeartbeat::CRosaBenchHeartbeatUsage()
+{
+	fprintf(stderr,
+		"  --hb-conns <list>      simulated connections watched by one heartbeat thread (default: " ROSABENCH_DEFAULT_HB_CONNS ")\n"
+		"  --hb-loopback <n>      loopback connections answering pings over TCP (default: %d)\n"
+		"  --hb-frozen <n>        percent of peers that stop answering (default: %d)\n",
+		ROSABENCH_DEFAULT_HB_LOOPBACK, ROSABENCH_DEFAULT_HB_FROZEN);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchHeartbeatParse()
+// @Purpose: CRosaBenchHeartbeatѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchHeartbeat::CRosaBenchHeartbeatParse(const char * pcArg, const char * pcValue)
+{
+	bool bOk = false;
+
+	if (strcmp(pcArg, "--hb-conns") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecHbConn);
+	}
+	else if (strcmp(pcArg, "--hb-loopback") == 0)
+	{
+		g_uiHbLoopback = strtoul(pcValue, NULL, 10);
+		bOk = (g_uiHbLoopback > 0);
+	}
+	else if (strcmp(pcArg, "--hb-frozen") == 0)
+	{
+		g_uiHbFrozen = strtoul(pcValue, NULL, 10);
+		bOk = (g_uiHbFrozen <= 100);
+	}
+	else
+	{
+		return ROSABENCH_PARSE_UNKNOWN;
+	}
+
+	return bOk ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchHeartbeatMain()
+// @Purpose: CRosaBenchHeartbeatȫ(ÿģ)ػ
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchHeartbeat::CRosaBenchHeartbeatMain(const S_BENCHCOMMON & sCommon)
+{
+	if (g_vecHbConn.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_HB_CONNS, g_vecHbConn);
+	}
+
+	CRosaBenchHeartbeat BenchHeartbeat;
+
+	for (size_t c = 0; c < g_vecHbConn.size(); ++c)
+	{
+		S_HEARTBEATBENCHCONFIG sConfig = { ROSABENCH_HEARTBEAT_SIMULATED, g_vecHbConn[c], g_uiHbFrozen, sCommon.uiSeconds, sCommon.sPort };
+		BenchOutput(BenchHeartbeat.CRosaBenchHeartbeatRun(sConfig));
+	}
+
+	S_HEARTBEATBENCHCONFIG sLoopback = { ROSABENCH_HEARTBEAT_LOOPBACK, g_uiHbLoopback, g_uiHbFrozen, sCommon.uiSeconds, sCommon.sPort };
+	BenchOutput(BenchHeartbeat.CRosaBenchHeartbeatRun(sLoopback));
+}
@@ -0,0 +1,99 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchHeartbeat.h
+* @brief	This File is RosaBenchHeartbeat Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHHEARTBEAT_H__
+#define __CROSABENCHHEARTBEAT_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Include Rosa Header File
+#include "../Rosa/CRosaHeartbeat.h"
+
+//Include C/C++ Header File
+#include <map>
+
+//Macro Definition
+#define ROSABENCH_HEARTBEAT_SIMULATED	0				//ģ(׽ֵֻΪ, pingصֱΪյpong, ɴ5)
+#define ROSABENCH_HEARTBEAT_LOOPBACK	1				//ػ(ping/pongʵ׽, ĶԶ˲Ӧ)
+#define ROSABENCH_HEARTBEAT_COUNT		2
+
+#define ROSABENCH_HEARTBEAT_INTERVAL	1000			//()
+#define ROSABENCH_HEARTBEAT_TIMEOUT		1000			//Ӧʱ()
+#define ROSABENCH_HEARTBEAT_TICK		100				//()
+#define ROSABENCH_HEARTBEAT_ROUNDS		3				//ʱΪ(+Ӧʱ)ı, Ӷж
+
+#define ROSABENCH_DEFAULT_HB_CONNS		"1K,50K"		//Ĭģ
+#define ROSABENCH_DEFAULT_HB_LOOPBACK	100				//Ĭϻػ
+#define ROSABENCH_DEFAULT_HB_FROZEN		10				//Ĭ϶ĶԶ˱(ٷֱ)
+
+//Struct Definition
+typedef struct
+{
+	int nMode;					// ӷʽ(ROSABENCH_HEARTBEAT_*)
+	UINT uiConnections;			// 
+	UINT uiFrozenPercent;		// (Ӧ)ӱ
+	UINT uiSeconds;				// ʱ
+	USHORT sPort;				// ˿(ػʽ)
+}S_HEARTBEATBENCHCONFIG, *LPS_HEARTBEATBENCHCONFIG;
+
+typedef struct
+{
+	bool bFrozen;				// Ƿ񶳽
+	bool bDead;					// ǷжʧЧ
+	LONGLONG llDead;			// жʧЧʱܼ
+}S_HEARTBEATBENCHPEER, *LPS_HEARTBEATBENCHPEER;
+
+//Class Definition
+class CRosaBenchHeartbeat
+{
+public:
+	CRosaBenchHeartbeat();		// CRosaBenchHeartbeat 캯
+	~CRosaBenchHeartbeat();		// CRosaBenchHeartbeat 
+
+public:
+	string CRosaBenchHeartbeatRun(const S_HEARTBEATBENCHCONFIG& sConfig);	// CRosaBenchHeartbeat һ(JSON)
+
+	static const char* CRosaBenchHeartbeatGetModeName(int nMode);			// CRosaBenchHeartbeat ȡӷʽ
+
+	static void CRosaBenchHeartbeatUsage();												// CRosaBenchHeartbeat ѡ˵
+	static int CRosaBenchHeartbeatParse(const char* pcArg, const char* pcValue);			// CRosaBenchHeartbeat ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchHeartbeatMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchHeartbeat ȫ
+
+private:
+	static void __stdcall OnPing(SOCKET s, DWORD_PTR dwUser);								// CRosaBenchHeartbeat ping(¼ѭ߳)
+	static void __stdcall OnDead(SOCKET s, DWORD_PTR dwUser);								// CRosaBenchHeartbeat ԶʧЧ(¼ѭ߳)
+	static void OnAccept(void* pContext, SOCKET s, USHORT nShard);							// CRosaBenchHeartbeat 
+	static unsigned __stdcall OnPeerThread(void* pParam);									// CRosaBenchHeartbeat Զ߳(յpingظpong, Ӳظ)
+	static unsigned __stdcall OnReaderThread(void* pParam);									// CRosaBenchHeartbeat ˽߳(յpong֪ͨ)
+
+	bool StartLoopback(UINT uiFrozen);								// CRosaBenchHeartbeat ػӲǶ
+	void StopLoopback();											// CRosaBenchHeartbeat رջػ
+
+private:
+	S_HEARTBEATBENCHCONFIG m_sConfig;			// CRosaBenchHeartbeat ǰԲ
+	CRosaHeartbeat* m_pHeartbeat;				// CRosaBenchHeartbeat 
+	BOOL m_bExit;								// CRosaBenchHeartbeat ˳־
+
+	CRITICAL_SECTION m_csPeer;					// CRosaBenchHeartbeat ӱٽ
+	map<SOCKET, S_HEARTBEATBENCHPEER> m_mapPeer;	// CRosaBenchHeartbeat (Ϊ׽)
+	volatile LONG m_lPongs;						// CRosaBenchHeartbeat յpong
+
+	CRosaBenchServer m_Server;					// CRosaBenchHeartbeat ػʽ(, ȫӽֹܺͣ)
+	vector<SOCKET> m_vecServerSock;				// CRosaBenchHeartbeat ػʽ׽
+	vector<CRosaSocket*> m_vecClient;			// CRosaBenchHeartbeat ػʽԶ
+	vector<bool> m_vecClientFrozen;				// CRosaBenchHeartbeat ػʽԶǷ񶳽
+
+};
+
+#endif // !__CROSABENCHHEARTBEAT_H__
@@ -0,0 +1,297 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchHistogram.cpp
+* @brief	This File is RosaBenchHistogram Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchHistogram.h"
+
+//Include C/C++ Header File
+#include <process.h>
+#include <stdio.h>
+
+//CRosaBenchHistogram ӳͳƿ(̼̹߳߳һͳʱÿμ¼ĺʱ, ԼδʱI/O·ϵĿ)
+
+// ѡ(бʱȡĬֵ)
+static vector<UINT> g_vecHistThread;
+
+// ʽ
+static const char* g_pcHistogramModeName[ROSABENCH_HISTOGRAM_COUNT] = { "disabled", "record", "object", "global" };
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchHistogram()
+// @Purpose: CRosaBenchHistogram캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchHistogram::CRosaBenchHistogram()
+{
+	memset(&m_sConfig, 0, sizeof(m_sConfig));
+	m_hStartEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+
+	m_Target.CRosaHistogramCreate();
+	m_Batch.CRosaHistogramCreate();
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchHistogram()
+// @Purpose: CRosaBenchHistogram
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchHistogram::~CRosaBenchHistogram()
+{
+	if (m_hStartEvent)
+	{
+		CloseHandle(m_hStartEvent);
+		m_hStartEvent = NULL;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchHistogramRun()
+// @Purpose: CRosaBenchHistogramһ(ȫͳƷʽʱ, ָԭ״̬)
+// @Since: v1.00a
+// @Para: const S_HISTBENCHCONFIG& sConfig(Բ)
+// @Return: string strJson ()
+//------------------------------------------------------------------
+string CRosaBenchHistogram::CRosaBenchHistogramRun(const S_HISTBENCHCONFIG & sConfig)
+{
+	char chHead[512] = { 0 };
+
+	m_sConfig = sConfig;
+	m_sConfig.uiThreads = (m_sConfig.uiThreads < 1) ? 1 : m_sConfig.uiThreads;
+
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"histogram\",\"mode\":\"%s\",\"threads\":%u",
+		CRosaBenchHistogramGetModeName(m_sConfig.nMode), m_sConfig.uiThreads);
+
+	bool bGlobal = CRosaHistogram::CRosaHistogramIsGlobalEnabled();
+	CRosaHistogram::CRosaHistogramEnableGlobal(m_sConfig.nMode == ROSABENCH_HISTOGRAM_GLOBAL);
+
+	m_Target.CRosaHistogramReset();
+	m_Batch.CRosaHistogramReset();
+
+	ULONGLONG ullGlobalStart = 0;
+	if (m_sConfig.nMode == ROSABENCH_HISTOGRAM_GLOBAL)
+	{
+		S_HISTOGRAMSUMMARY sGlobal;
+		CRosaHistogram::CRosaHistogramGetGlobal(ROSA_HISTOGRAM_OP_SEND)->CRosaHistogramGetSummary(sGlobal);
+		ullGlobalStart = sGlobal.ullCount;
+	}
+
+	vector<S_HISTBENCHTHREAD> vecThread(m_sConfig.uiThreads);
+	vector<HANDLE> vecHandle;
+
+	for (UINT i = 0; i < m_sConfig.uiThreads; ++i)
+	{
+		memset(&vecThread[i], 0, sizeof(S_HISTBENCHTHREAD));
+		vecThread[i].pBench = this;
+		vecThread[i].uiSeed = 2463534242U + i * 7919U;
+
+		HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, OnRecordThread, &vecThread[i], 0, NULL);
+		if (hThread)
+		{
+			vecHandle.push_back(hThread);
+		}
+	}
+
+	S_BENCHCPU sCpu;
+	BenchCpuStart(sCpu);
+	SetEvent(m_hStartEvent);
+
+	for (size_t i = 0; i < vecHandle.size(); ++i)
+	{
+		WaitForSingleObject(vecHandle[i], INFINITE);
+		CloseHandle(vecHandle[i]);
+	}
+
+	double dSeconds = 0.0;
+	double dCpu = BenchCpuStop(sCpu, dSeconds);
+	ResetEvent(m_hStartEvent);
+
+	// ¼ϲļӦһ(δʽ¼)
+	ULONGLONG ullRecords = 0;
+	LONGLONG llElapsed = 0;
+
+	for (UINT i = 0; i < m_sConfig.uiThreads; ++i)
+	{
+		ullRecords += vecThread[i].ullRecords;
+		llElapsed += vecThread[i].llElapsed;
+	}
+
+	S_HISTOGRAMSUMMARY sTarget;
+	ULONGLONG ullCounted = 0;
+
+	switch (m_sConfig.nMode)
+	{
+	case ROSABENCH_HISTOGRAM_RECORD:
+	case ROSABENCH_HISTOGRAM_OBJECT:
+		m_Target.CRosaHistogramGetSummary(sTarget);
+		ullCounted = sTarget.ullCount;
+		break;
+	case ROSABENCH_HISTOGRAM_GLOBAL:
+		CRosaHistogram::CRosaHistogramGetGlobal(ROSA_HISTOGRAM_OP_SEND)->CRosaHistogramGetSummary(sTarget);
+		ullCounted = sTarget.ullCount - ullGlobalStart;
+		break;
+	default:
+		ullCounted = ullRecords;
+		break;
+	}
+
+	CRosaHistogram::CRosaHistogramEnableGlobal(bGlobal);
+
+	double dRecordNs = ullRecords ? (double)CRosaHistogram::CRosaHistogramToNanoSec(llElapsed) / ullRecords : 0.0;
+
+	char chResult[512] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"seconds\":%.3f,\"records\":%llu,\"counted\":%llu,\"count_ok\":%s,\"records_per_sec\":%.1f,\"ns_per_record\":%.2f,\"cpu_percent\":%.1f,\"batch_ns_per_record\":",
+		dSeconds, ullRecords, ullCounted, (ullCounted == ullRecords) ? "true" : "false",
+		(dSeconds > 0.0) ? ullRecords / dSeconds : 0.0, dRecordNs, dCpu);
+
+	return string("{") + chHead + chResult + BenchSummaryJson(m_Batch) + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchHistogramGetModeName()
+// @Purpose: CRosaBenchHistogramȡ¼ʽ
+// @Since: v1.00a
+// @Para: int nMode(ROSABENCH_HISTOGRAM_*)
+// @Return: const char* pcName
+//------------------------------------------------------------------
+const char * CRosaBenchHistogram::CRosaBenchHistogramGetModeName(int nMode)
+{
+	if (nMode < 0 || nMode >= ROSABENCH_HISTOGRAM_COUNT)
+	{
+		return "";
+	}
+
+	return g_pcHistogramModeName[nMode];
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnRecordThread()
+// @Purpose: CRosaBenchHistogram¼߳(ʱ, ÿμ¼ĺʱȡֵѭ)
+// @Since: v1.00a
+// @Para: void* pParam(S_HISTBENCHTHREAD)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchHistogram::OnRecordThread(void * pParam)
+{
+	LPS_HISTBENCHTHREAD pThread = reinterpret_cast<LPS_HISTBENCHTHREAD>(pParam);
+	CRosaBenchHistogram* pBench = pThread->pBench;
+
+	int nMode = pBench->m_sConfig.nMode;
+	CRosaHistogram* pLocal = (nMode == ROSABENCH_HISTOGRAM_OBJECT) ? &pBench->m_Target : NULL;
+	UINT uiSeed = pThread->uiSeed;
+
+	WaitForSingleObject(pBench->m_hStartEvent, INFINITE);
+
+	LARGE_INTEGER liFrequency;
+	QueryPerformanceFrequency(&liFrequency);
+
+	LONGLONG llDeadline = CRosaHistogram::CRosaHistogramNow() + liFrequency.QuadPart * pBench->m_sConfig.uiSeconds;
+
+	for (;;)
+	{
+		LONGLONG llBatch = CRosaHistogram::CRosaHistogramNow();
+		if (llBatch >= llDeadline)
+		{
+			break;
+		}
+
+		for (UINT i = 0; i < ROSABENCH_HISTOGRAM_BATCH; ++i)
+		{
+			// xorshift32, ¼ֲֵڲͬͰ
+			uiSeed ^= uiSeed << 13;
+			uiSeed ^= uiSeed >> 17;
+			uiSeed ^= uiSeed << 5;
+
+			if (nMode == ROSABENCH_HISTOGRAM_RECORD)
+			{
+				pBench->m_Target.CRosaHistogramRecord(uiSeed >> 12);
+				continue;
+			}
+
+			// CRosaSocketеļʱͬ: δöͳȫͳδʱȡܼ
+			LONGLONG llStart = (pLocal == NULL && !CRosaHistogram::CRosaHistogramIsGlobalEnabled()) ? 0 : CRosaHistogram::CRosaHistogramNow();
+			CRosaHistogram::CRosaHistogramRecordGlobal(ROSA_HISTOGRAM_OP_SEND, llStart, pLocal);
+		}
+
+		LONGLONG llUsed = CRosaHistogram::CRosaHistogramNow() - llBatch;
+
+		pThread->llElapsed += llUsed;
+		pThread->ullRecords += ROSABENCH_HISTOGRAM_BATCH;
+		pBench->m_Batch.CRosaHistogramRecord(CRosaHistogram::CRosaHistogramToNanoSec(llUsed) / ROSABENCH_HISTOGRAM_BATCH);
+	}
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchHistogramUsage()
+// @Purpose: CRosaBenchHistogramѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchHistogram::CRosaBenchHistogramUsage()
+{
+	fprintf(stderr,
+		"  --hist-threads <list>  threads recording into one latency histogram (default: " ROSABENCH_DEFAULT_HIST_THREADS ")\n");
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchHistogramParse()
+// @Purpose: CRosaBenchHistogramѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchHistogram::CRosaBenchHistogramParse(const char * pcArg, const char * pcValue)
+{
+	bool bOk = false;
+
+	if (strcmp(pcArg, "--hist-threads") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecHistThread);
+	}
+	else
+	{
+		return ROSABENCH_PARSE_UNKNOWN;
+	}
+
+	return bOk ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchHistogramMain()
+// @Purpose: CRosaBenchHistogramȫ(߳*¼ʽ)
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchHistogram::CRosaBenchHistogramMain(const S_BENCHCOMMON & sCommon)
+{
+	if (g_vecHistThread.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_HIST_THREADS, g_vecHistThread);
+	}
+
+	CRosaBenchHistogram BenchHistogram;
+
+	for (size_t t = 0; t < g_vecHistThread.size(); ++t)
+	{
+		for (int m = 0; m < ROSABENCH_HISTOGRAM_COUNT; ++m)
+		{
+			S_HISTBENCHCONFIG sConfig = { m, g_vecHistThread[t], sCommon.uiSeconds };
+			BenchOutput(BenchHistogram.CRosaBenchHistogramRun(sConfig));
+		}
+	}
+}
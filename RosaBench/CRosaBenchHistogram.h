@@ -0,0 +1,78 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchHistogram.h
+* @brief	This File is RosaBenchHistogram Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHHISTOGRAM_H__
+#define __CROSABENCHHISTOGRAM_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Macro Definition
+#define ROSABENCH_HISTOGRAM_DISABLED	0				//δͳʱI/O·ϵж(ȫͳƾδ)
+#define ROSABENCH_HISTOGRAM_RECORD		1				//CRosaHistogramRecord(ֻм¼)
+#define ROSABENCH_HISTOGRAM_OBJECT		2				//ȡܼ + CRosaHistogramRecordGlobal¼ͳ
+#define ROSABENCH_HISTOGRAM_GLOBAL		3				//ȡܼ + CRosaHistogramRecordGlobal¼ȫͳ
+#define ROSABENCH_HISTOGRAM_COUNT		4
+
+#define ROSABENCH_HISTOGRAM_BATCH		4096			//ÿ¼(ÿһνʱ䲢¼ƽʱ)
+
+#define ROSABENCH_DEFAULT_HIST_THREADS	"1,4"			//Ĭϼ¼߳
+
+//Struct Definition
+typedef struct
+{
+	int nMode;					// ¼ʽ(ROSABENCH_HISTOGRAM_*)
+	UINT uiThreads;				// ¼߳
+	UINT uiSeconds;				// ʱ
+}S_HISTBENCHCONFIG, *LPS_HISTBENCHCONFIG;
+
+//Class Declaration
+class CRosaBenchHistogram;
+
+typedef struct
+{
+	CRosaBenchHistogram* pBench;	// 
+	UINT uiSeed;					// ״̬
+	ULONGLONG ullRecords;			// ¼
+	LONGLONG llElapsed;				// ¼ʱ(ܼ)
+}S_HISTBENCHTHREAD, *LPS_HISTBENCHTHREAD;
+
+//Class Definition
+class CRosaBenchHistogram
+{
+public:
+	CRosaBenchHistogram();		// CRosaBenchHistogram 캯
+	~CRosaBenchHistogram();		// CRosaBenchHistogram 
+
+public:
+	string CRosaBenchHistogramRun(const S_HISTBENCHCONFIG& sConfig);	// CRosaBenchHistogram һ(JSON)
+
+	static const char* CRosaBenchHistogramGetModeName(int nMode);		// CRosaBenchHistogram ȡ¼ʽ
+
+	static void CRosaBenchHistogramUsage();												// CRosaBenchHistogram ѡ˵
+	static int CRosaBenchHistogramParse(const char* pcArg, const char* pcValue);			// CRosaBenchHistogram ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchHistogramMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchHistogram ȫ
+
+private:
+	static unsigned __stdcall OnRecordThread(void* pParam);			// CRosaBenchHistogram ¼߳
+
+private:
+	S_HISTBENCHCONFIG m_sConfig;				// CRosaBenchHistogram ǰԲ
+	HANDLE m_hStartEvent;						// CRosaBenchHistogram ¼߳ͬʱʼ
+
+	CRosaHistogram m_Target;					// CRosaBenchHistogram ͳ(̹߳, ֲ)
+	CRosaHistogram m_Batch;						// CRosaBenchHistogram ÿƽÿμ¼ʱ
+
+};
+
+#endif // !__CROSABENCHHISTOGRAM_H__
@@ -0,0 +1,416 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchMPSC.cpp
+* @brief	This File is RosaBenchMPSC Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchMPSC.h"
+
+//Include C/C++ Header File
+#include <process.h>
+#include <stdio.h>
+
+//CRosaBenchMPSC ̷߳Ͳ(߳ͬһд, Ӧò㻥뷢Ͷ/ӵ¼ÿдʱ)
+
+// ѡ(бʱȡĬֵ)
+static vector<UINT> g_vecMpscProducer;
+
+// ʽ
+static const char* g_pcMPSCModeName[ROSABENCH_MPSC_COUNT] = { "mutex", "send", "post" };
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchMPSC()
+// @Purpose: CRosaBenchMPSC캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchMPSC::CRosaBenchMPSC()
+{
+	memset(&m_sConfig, 0, sizeof(m_sConfig));
+
+	m_bExit = FALSE;
+	m_Accepted = INVALID_SOCKET;
+	m_hAcceptEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+	m_hStartEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+
+	InitializeCriticalSection(&m_csSend);
+	m_pQueue = NULL;
+	m_pReader = NULL;
+	m_llDelivered = 0;
+	m_Latency.CRosaHistogramCreate();
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchMPSC()
+// @Purpose: CRosaBenchMPSC
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchMPSC::~CRosaBenchMPSC()
+{
+	DeleteCriticalSection(&m_csSend);
+
+	if (m_hStartEvent)
+	{
+		CloseHandle(m_hStartEvent);
+		m_hStartEvent = NULL;
+	}
+
+	if (m_hAcceptEvent)
+	{
+		CloseHandle(m_hAcceptEvent);
+		m_hAcceptEvent = NULL;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchMPSCRun()
+// @Purpose: CRosaBenchMPSCһ(߹÷˽ܵһ, ͻ˾ȡ)
+// @Since: v1.00a
+// @Para: const S_MPSCBENCHCONFIG& sConfig(Բ)
+// @Return: string strJson ()
+//------------------------------------------------------------------
+string CRosaBenchMPSC::CRosaBenchMPSCRun(const S_MPSCBENCHCONFIG & sConfig)
+{
+	char chHead[512] = { 0 };
+
+	m_sConfig = sConfig;
+	m_sConfig.uiProducers = (m_sConfig.uiProducers < 1) ? 1 : m_sConfig.uiProducers;
+
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"mpsc\",\"mode\":\"%s\",\"producers\":%u,\"size\":%d",
+		CRosaBenchMPSCGetModeName(m_sConfig.nMode), m_sConfig.uiProducers, ROSABENCH_MPSC_MESSAGE);
+
+	m_Accepted = INVALID_SOCKET;
+	m_llDelivered = 0;
+	ResetEvent(m_hAcceptEvent);
+
+	// ֻʹõһ, ֮ܵر
+	if (!m_Server.CRosaBenchServerStart(m_sConfig.sPort, OnAccept, this))
+	{
+		char chError[128] = { 0 };
+		sprintf_s(chError, sizeof(chError), ",\"error\":\"listen failed (WSA %d)\"}", m_Server.CRosaBenchServerGetError());
+
+		return string("{") + chHead + chError;
+	}
+
+	CRosaSocket Reader;
+	CRosaEventLoop Loop;
+	CRosaSendQueue Queue;
+
+	bool bConnected = Reader.CRosaSocketConnect("127.0.0.1", m_sConfig.sPort) &&
+		WaitForSingleObject(m_hAcceptEvent, ROSABENCH_MPSC_ACCEPT_WAIT) == WAIT_OBJECT_0;
+
+	if (bConnected && m_sConfig.nMode != ROSABENCH_MPSC_MUTEX)
+	{
+		bConnected = Loop.CRosaEventLoopCreate(1) &&
+			Queue.CRosaSendQueueCreate(m_Accepted, &Loop, NULL, NULL, 0);
+		m_pQueue = &Queue;
+	}
+
+	if (!bConnected)
+	{
+		m_pQueue = NULL;
+		Queue.CRosaSendQueueDestroy();
+		Loop.CRosaEventLoopDestroy();
+
+		if (m_Accepted != INVALID_SOCKET)
+		{
+			closesocket(m_Accepted);
+			m_Accepted = INVALID_SOCKET;
+		}
+
+		m_Server.CRosaBenchServerStop();
+		return string("{") + chHead + ",\"error\":\"connect failed\"}";
+	}
+
+	// ȡ߳
+	m_bExit = FALSE;
+	m_pReader = &Reader;
+
+	HANDLE hReader = (HANDLE)_beginthreadex(NULL, 0, OnReaderThread, this, 0, NULL);
+
+	// ߳
+	vector<S_MPSCBENCHPRODUCER> vecProducer(m_sConfig.uiProducers);
+	vector<HANDLE> vecThread;
+
+	for (UINT i = 0; i < m_sConfig.uiProducers; ++i)
+	{
+		memset(&vecProducer[i], 0, sizeof(S_MPSCBENCHPRODUCER));
+		vecProducer[i].pBench = this;
+
+		HANDLE hThread = (HANDLE)_beginthreadex(NULL, ROSABENCH_THREAD_STACK, OnProducerThread, &vecProducer[i], STACK_SIZE_PARAM_IS_A_RESERVATION, NULL);
+		if (hThread)
+		{
+			vecThread.push_back(hThread);
+		}
+	}
+
+	m_Latency.CRosaHistogramReset();
+
+	S_BENCHCPU sCpu;
+	BenchCpuStart(sCpu);
+	LONGLONG llDeliveredStart = m_llDelivered;
+	SetEvent(m_hStartEvent);
+
+	for (size_t i = 0; i < vecThread.size(); ++i)
+	{
+		WaitForSingleObject(vecThread[i], INFINITE);
+		CloseHandle(vecThread[i]);
+	}
+
+	double dSeconds = 0.0;
+	double dCpu = BenchCpuStop(sCpu, dSeconds);
+	LONGLONG llDelivered = m_llDelivered - llDeliveredStart;
+	ResetEvent(m_hStartEvent);
+
+	// ˳, ֹͣ(߳1ڷ)
+	m_Server.CRosaBenchServerStop();
+
+	// ʣϢ, رպȡ߳˳
+	m_pQueue = NULL;
+	Queue.CRosaSendQueueDestroy();
+	Loop.CRosaEventLoopDestroy();
+
+	LINGER sLinger = { 1, 0 };
+	setsockopt(m_Accepted, SOL_SOCKET, SO_LINGER, (char*)&sLinger, sizeof(sLinger));
+	closesocket(m_Accepted);
+	m_Accepted = INVALID_SOCKET;
+
+	m_bExit = TRUE;
+	if (hReader)
+	{
+		WaitForSingleObject(hReader, INFINITE);
+		CloseHandle(hReader);
+	}
+
+	m_pReader = NULL;
+	Reader.CRosaSocketDisConnect();
+
+	// 
+	ULONGLONG ullMessages = 0;
+	ULONGLONG ullRejected = 0;
+	ULONGLONG ullErrors = 0;
+
+	for (UINT i = 0; i < m_sConfig.uiProducers; ++i)
+	{
+		ullMessages += vecProducer[i].ullMessages;
+		ullRejected += vecProducer[i].ullRejected;
+		ullErrors += vecProducer[i].ullErrors;
+	}
+
+	char chResult[512] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"seconds\":%.3f,\"messages\":%llu,\"rejected\":%llu,\"errors\":%llu,\"messages_per_sec\":%.1f,\"delivered_per_sec\":%.1f,\"cpu_percent\":%.1f,\"write_ns\":",
+		dSeconds, ullMessages, ullRejected, ullErrors,
+		(dSeconds > 0.0) ? ullMessages / dSeconds : 0.0,
+		(dSeconds > 0.0) ? (double)llDelivered / ROSABENCH_MPSC_MESSAGE / dSeconds : 0.0, dCpu);
+
+	return string("{") + chHead + chResult + BenchSummaryJson(m_Latency) + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchMPSCGetModeName()
+// @Purpose: CRosaBenchMPSCȡʽ
+// @Since: v1.00a
+// @Para: int nMode(ROSABENCH_MPSC_*)
+// @Return: const char* pcName
+//------------------------------------------------------------------
+const char * CRosaBenchMPSC::CRosaBenchMPSCGetModeName(int nMode)
+{
+	if (nMode < 0 || nMode >= ROSABENCH_MPSC_COUNT)
+	{
+		return "";
+	}
+
+	return g_pcMPSCModeName[nMode];
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAccept()
+// @Purpose: CRosaBenchMPSC(ֻһ)
+// @Since: v1.00a
+// @Para: void* pContext(Զ)
+// @Para: SOCKET s(ͻ׽)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchMPSC::OnAccept(void * pContext, SOCKET s, USHORT nShard)
+{
+	CRosaBenchMPSC* pBench = reinterpret_cast<CRosaBenchMPSC*>(pContext);
+
+	if (pBench->m_Accepted != INVALID_SOCKET)
+	{
+		closesocket(s);
+		return;
+	}
+
+	pBench->m_Accepted = s;
+	SetEvent(pBench->m_hAcceptEvent);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnProducerThread()
+// @Purpose: CRosaBenchMPSC߳(ʱȴ, гڴʱó)
+// @Since: v1.00a
+// @Para: void* pParam(S_MPSCBENCHPRODUCER)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchMPSC::OnProducerThread(void * pParam)
+{
+	LPS_MPSCBENCHPRODUCER pProducer = reinterpret_cast<LPS_MPSCBENCHPRODUCER>(pParam);
+	CRosaBenchMPSC* pBench = pProducer->pBench;
+
+	char chMessage[ROSABENCH_MPSC_MESSAGE];
+	memset(chMessage, 'R', sizeof(chMessage));
+
+	WaitForSingleObject(pBench->m_hStartEvent, INFINITE);
+
+	LARGE_INTEGER liFrequency;
+	QueryPerformanceFrequency(&liFrequency);
+
+	LONGLONG llDeadline = CRosaHistogram::CRosaHistogramNow() + liFrequency.QuadPart * pBench->m_sConfig.uiSeconds;
+
+	while (CRosaHistogram::CRosaHistogramNow() < llDeadline)
+	{
+		LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+		int nRet = SOB_RET_OK;
+
+		switch (pBench->m_sConfig.nMode)
+		{
+		case ROSABENCH_MPSC_SEND:
+			nRet = pBench->m_pQueue->CRosaSendQueueSend(chMessage, sizeof(chMessage));
+			break;
+		case ROSABENCH_MPSC_POST:
+			nRet = pBench->m_pQueue->CRosaSendQueuePost(chMessage, sizeof(chMessage));
+			break;
+		default:
+			EnterCriticalSection(&pBench->m_csSend);
+			nRet = pBench->m_Server.CRosaBenchServerGetSocket()->CRosaSocketSendBuffer(pBench->m_Accepted, chMessage, sizeof(chMessage));
+			LeaveCriticalSection(&pBench->m_csSend);
+			break;
+		}
+
+		pBench->m_Latency.CRosaHistogramRecordSince(llStart);
+
+		if (nRet == SOB_RET_OK)
+		{
+			pProducer->ullMessages++;
+		}
+		else if (nRet == SOB_RET_FAIL && pBench->m_sConfig.nMode != ROSABENCH_MPSC_MUTEX)
+		{
+			pProducer->ullRejected++;
+			SwitchToThread();
+		}
+		else
+		{
+			pProducer->ullErrors++;
+			break;
+		}
+	}
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnReaderThread()
+// @Purpose: CRosaBenchMPSCȡ߳(ȡ, ӹرջ˳־λ˳)
+// @Since: v1.00a
+// @Para: void* pParam(Զ)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchMPSC::OnReaderThread(void * pParam)
+{
+	CRosaBenchMPSC* pBench = reinterpret_cast<CRosaBenchMPSC*>(pParam);
+
+	char* pBuffer = new char[ROSABENCH_MPSC_RECV_BUFFER];
+
+	while (!pBench->m_bExit)
+	{
+		UINT uiRecv = 0;
+
+		int nRet = pBench->m_pReader->CRosaSocketRecvOnce(pBuffer, ROSABENCH_MPSC_RECV_BUFFER, uiRecv, 1);
+		if (nRet == SOB_RET_TIMEOUT)
+		{
+			continue;
+		}
+
+		if (nRet != SOB_RET_OK || uiRecv == 0)
+		{
+			break;
+		}
+
+		InterlockedExchangeAdd64(&pBench->m_llDelivered, uiRecv);
+	}
+
+	delete[] pBuffer;
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchMPSCUsage()
+// @Purpose: CRosaBenchMPSCѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchMPSC::CRosaBenchMPSCUsage()
+{
+	fprintf(stderr,
+		"  --mpsc-producers <list> threads writing to one server connection, mutex vs send queue (default: " ROSABENCH_DEFAULT_MPSC_PRODUCERS ")\n");
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchMPSCParse()
+// @Purpose: CRosaBenchMPSCѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchMPSC::CRosaBenchMPSCParse(const char * pcArg, const char * pcValue)
+{
+	bool bOk = false;
+
+	if (strcmp(pcArg, "--mpsc-producers") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecMpscProducer);
+	}
+	else
+	{
+		return ROSABENCH_PARSE_UNKNOWN;
+	}
+
+	return bOk ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchMPSCMain()
+// @Purpose: CRosaBenchMPSCȫ(*д뷽ʽ)
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchMPSC::CRosaBenchMPSCMain(const S_BENCHCOMMON & sCommon)
+{
+	if (g_vecMpscProducer.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_MPSC_PRODUCERS, g_vecMpscProducer);
+	}
+
+	CRosaBenchMPSC BenchMPSC;
+
+	for (size_t p = 0; p < g_vecMpscProducer.size(); ++p)
+	{
+		for (int m = 0; m < ROSABENCH_MPSC_COUNT; ++m)
+		{
+			S_MPSCBENCHCONFIG sConfig = { m, g_vecMpscProducer[p], sCommon.uiSeconds, sCommon.sPort };
+			BenchOutput(BenchMPSC.CRosaBenchMPSCRun(sConfig));
+		}
+	}
+}
@@ -0,0 +1,94 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchMPSC.h
+* @brief	This File is RosaBenchMPSC Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHMPSC_H__
+#define __CROSABENCHMPSC_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Include Rosa Header File
+#include "../Rosa/CRosaEventLoop.h"
+#include "../Rosa/CRosaSendQueue.h"
+
+//Macro Definition
+#define ROSABENCH_MPSC_MUTEX			0				//:ٽCRosaSocketSendBuffer(SOCKET, ...)(ԭ)
+#define ROSABENCH_MPSC_SEND				1				//:CRosaSendQueueSend(ٽ)
+#define ROSABENCH_MPSC_POST				2				//:CRosaSendQueuePost(, ¼ѭ߳ȡ)
+#define ROSABENCH_MPSC_COUNT			3
+
+#define ROSABENCH_MPSC_MESSAGE			64				//Ϣ
+#define ROSABENCH_MPSC_RECV_BUFFER		(64 * 1024)		//ȡ˽ջ峤
+#define ROSABENCH_MPSC_ACCEPT_WAIT		5000			//ȴ˽ӵʱ()
+
+#define ROSABENCH_DEFAULT_MPSC_PRODUCERS	"1,4,16,32"	//Ĭ߳
+
+//Struct Definition
+typedef struct
+{
+	int nMode;					// ʽ(ROSABENCH_MPSC_*)
+	UINT uiProducers;			// ߳
+	UINT uiSeconds;				// ʱ
+	USHORT sPort;				// ˿
+}S_MPSCBENCHCONFIG, *LPS_MPSCBENCHCONFIG;
+
+//Class Declaration
+class CRosaBenchMPSC;
+
+typedef struct
+{
+	CRosaBenchMPSC* pBench;		// 
+	ULONGLONG ullMessages;		// дɹϢ
+	ULONGLONG ullRejected;		// ڴޱܾĴ
+	ULONGLONG ullErrors;		// ʧܴ
+}S_MPSCBENCHPRODUCER, *LPS_MPSCBENCHPRODUCER;
+
+//Class Definition
+class CRosaBenchMPSC
+{
+public:
+	CRosaBenchMPSC();			// CRosaBenchMPSC 캯
+	~CRosaBenchMPSC();			// CRosaBenchMPSC 
+
+public:
+	string CRosaBenchMPSCRun(const S_MPSCBENCHCONFIG& sConfig);		// CRosaBenchMPSC һ(JSON)
+
+	static const char* CRosaBenchMPSCGetModeName(int nMode);		// CRosaBenchMPSC ȡʽ
+
+	static void CRosaBenchMPSCUsage();												// CRosaBenchMPSC ѡ˵
+	static int CRosaBenchMPSCParse(const char* pcArg, const char* pcValue);			// CRosaBenchMPSC ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchMPSCMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchMPSC ȫ
+
+private:
+	static void OnAccept(void* pContext, SOCKET s, USHORT nShard);							// CRosaBenchMPSC (Ϊ߹õķ)
+	static unsigned __stdcall OnProducerThread(void* pParam);								// CRosaBenchMPSC ߳
+	static unsigned __stdcall OnReaderThread(void* pParam);									// CRosaBenchMPSC ȡ߳(ͻ)
+
+private:
+	S_MPSCBENCHCONFIG m_sConfig;				// CRosaBenchMPSC ǰԲ
+
+	CRosaBenchServer m_Server;					// CRosaBenchMPSC (ÿ¼, ԭɼ׽ֶ)
+	BOOL m_bExit;								// CRosaBenchMPSC ˳־(ȡ߳)
+	SOCKET m_Accepted;							// CRosaBenchMPSC 
+	HANDLE m_hAcceptEvent;						// CRosaBenchMPSC ѽ
+	HANDLE m_hStartEvent;						// CRosaBenchMPSC ߳ͬʱʼ
+
+	CRITICAL_SECTION m_csSend;					// CRosaBenchMPSC ԭӦò㻥
+	CRosaSendQueue* m_pQueue;					// CRosaBenchMPSC Ͷ(зʽ)
+	CRosaSocket* m_pReader;						// CRosaBenchMPSC ͻ˶ȡ
+	volatile LONGLONG m_llDelivered;			// CRosaBenchMPSC ȡյֽ
+	CRosaHistogram m_Latency;					// CRosaBenchMPSC ÿдʱ
+
+};
+
+#endif // !__CROSABENCHMPSC_H__
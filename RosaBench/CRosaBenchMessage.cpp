@@ -0,0 +1,716 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchMessage.cpp
+* @brief	This File is RosaBenchMessage Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchMessage.h"
+
+//Include C/C++ Header File
+#include <stdio.h>
+
+//CRosaBenchMessage Ϣʽ(ͬһң¼ֱƫƲ/ֶδ/TLV, ̲߳ÿʱ)
+
+// ֶδTLVд/ȡ(ƫƲͬ, Ϣܳȿͷ)
+#define BENCH_PUT(p, v)		{ memcpy((p), &(v), sizeof(v)); (p) += sizeof(v); }
+#define BENCH_GET(p, e, v)	{ if ((e) - (p) < (ptrdiff_t)sizeof(v)) return false; memcpy(&(v), (p), sizeof(v)); (p) += sizeof(v); }
+
+// TLVǩ
+enum
+{
+	BENCH_TLV_TIME = 1,
+	BENCH_TLV_DEVICE,
+	BENCH_TLV_SEQ,
+	BENCH_TLV_TEMP,
+	BENCH_TLV_HUMIDITY,
+	BENCH_TLV_PRESSURE,
+	BENCH_TLV_BATTERY,
+	BENCH_TLV_STATUS,
+	BENCH_TLV_NAME,
+	BENCH_TLV_PAYLOAD,
+};
+
+// дһTLV
+static char* PutTlv(char* p, BYTE byTag, const void* pValue, USHORT sLength)
+{
+	*p++ = (char)byTag;
+	memcpy(p, &sLength, sizeof(sLength));
+	p += sizeof(sLength);
+	memcpy(p, pValue, sLength);
+
+	return p + sLength;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchMessage()
+// @Purpose: CRosaBenchMessage캯(ɹ̶ӵĲԼ¼)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchMessage::CRosaBenchMessage()
+{
+	UINT uiSeed = 20171019;
+
+	m_ullSink = 0;
+	m_vecRecord.resize(ROSABENCH_MESSAGE_RECORDS);
+	m_vecWire.resize(ROSABENCH_MESSAGE_RECORDS * ROSABENCH_MESSAGE_MAX_WIRE);
+	m_vecWireSize.resize(ROSABENCH_MESSAGE_RECORDS);
+
+	for (UINT i = 0; i < ROSABENCH_MESSAGE_RECORDS; ++i)
+	{
+		S_MESSAGERECORD& sRecord = m_vecRecord[i];
+		memset(&sRecord, 0, sizeof(sRecord));
+
+		uiSeed = uiSeed * 1103515245 + 12345;
+
+		sRecord.ullTime = 1760000000000ULL + i * 17;
+		sRecord.uiDevice = (uiSeed >> 16) % 500;
+		sRecord.uiSeq = i;
+		sRecord.dTemp = 20.0 + (double)((uiSeed >> 8) & 0xFF) / 16.0;
+		sRecord.fHumidity = 40.0f + (float)((uiSeed >> 4) & 0x3F);
+		sRecord.fPressure = 1013.25f;
+		sRecord.fBattery = 3.3f + (float)(uiSeed & 0xF) / 16.0f;
+		sRecord.byStatus = (BYTE)(uiSeed >> 28);
+		sRecord.uiNameSize = (UINT)sprintf_s(sRecord.chName, sizeof(sRecord.chName), "sensor-%03u", sRecord.uiDevice);
+		sRecord.uiPayloadSize = 16 + ((uiSeed >> 12) % (ROSABENCH_MESSAGE_PAYLOAD - 15));
+
+		for (UINT j = 0; j < sRecord.uiPayloadSize; ++j)
+		{
+			sRecord.byPayload[j] = (BYTE)(i + j);
+		}
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchMessage()
+// @Purpose: CRosaBenchMessage
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchMessage::~CRosaBenchMessage()
+{
+	m_vecRecord.clear();
+	m_vecWire.clear();
+	m_vecWireSize.clear();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchMessageRun()
+// @Purpose: CRosaBenchMessageһָʽ(ȱȫ¼У, ٷֱ)
+// @Since: v1.00a
+// @Para: int nFormat(ROSABENCH_MESSAGE_FORMAT_*)
+// @Return: string strJson ()
+//------------------------------------------------------------------
+string CRosaBenchMessage::CRosaBenchMessageRun(int nFormat)
+{
+	static const char* s_pcFormat[] = { "offset", "struct", "tlv" };
+
+	char chHead[256] = { 0 };
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"message\",\"format\":\"%s\",\"records\":%u", s_pcFormat[nFormat], ROSABENCH_MESSAGE_RECORDS);
+
+	// 벢У
+	ULONGLONG ullWire = 0;
+	bool bVerified = true;
+
+	for (UINT i = 0; i < ROSABENCH_MESSAGE_RECORDS && bVerified; ++i)
+	{
+		const S_MESSAGERECORD& sRecord = m_vecRecord[i];
+		char* pWire = &m_vecWire[i * ROSABENCH_MESSAGE_MAX_WIRE];
+
+		m_vecWireSize[i] = Encode(nFormat, sRecord, pWire);
+		ullWire += m_vecWireSize[i];
+
+		S_MESSAGERECORD sOut;
+		const char* pName = NULL;
+		const char* pPayload = NULL;
+
+		bVerified = (m_vecWireSize[i] > 0) && Decode(nFormat, pWire, m_vecWireSize[i], sOut, pName, pPayload)
+			&& sOut.ullTime == sRecord.ullTime && sOut.uiDevice == sRecord.uiDevice && sOut.uiSeq == sRecord.uiSeq
+			&& sOut.dTemp == sRecord.dTemp && sOut.fHumidity == sRecord.fHumidity && sOut.fPressure == sRecord.fPressure
+			&& sOut.fBattery == sRecord.fBattery && sOut.byStatus == sRecord.byStatus
+			&& sOut.uiNameSize == sRecord.uiNameSize && memcmp(pName, sRecord.chName, sRecord.uiNameSize) == 0
+			&& sOut.uiPayloadSize == sRecord.uiPayloadSize && memcmp(pPayload, sRecord.byPayload, sRecord.uiPayloadSize) == 0
+			&& DecodePartial(nFormat, pWire, m_vecWireSize[i]);
+	}
+
+	if (nFormat == ROSABENCH_MESSAGE_FORMAT_OFFSET && bVerified && !CheckCrossVersion())
+	{
+		return string("{") + chHead + ",\"error\":\"cross_version\"}";
+	}
+
+	if (!bVerified)
+	{
+		return string("{") + chHead + ",\"error\":\"verify\"}";
+	}
+
+	double dEncode = Measure(nFormat, ROSABENCH_MESSAGE_OP_ENCODE);
+	double dPayload = Measure(nFormat, ROSABENCH_MESSAGE_OP_PAYLOAD);
+	double dDecode = Measure(nFormat, ROSABENCH_MESSAGE_OP_DECODE);
+	double dPartial = Measure(nFormat, ROSABENCH_MESSAGE_OP_PARTIAL);
+
+	char chResult[512] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"wire_bytes\":%.1f,\"encode_ns\":%.1f,\"encode_payload_ns\":%.1f,\"decode_ns\":%.1f,\"decode_partial_ns\":%.1f,"
+		"\"encode_mmsg_per_sec\":%.2f,\"decode_mmsg_per_sec\":%.2f,\"verified\":true",
+		(double)ullWire / ROSABENCH_MESSAGE_RECORDS, dEncode, dPayload, dDecode, dPartial,
+		(dEncode > 0.0) ? 1000.0 / dEncode : 0.0, (dDecode > 0.0) ? 1000.0 / dDecode : 0.0);
+
+	return string("{") + chHead + chResult + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 Encode()
+// @Purpose: CRosaBenchMessage뵽(岻СROSABENCH_MESSAGE_MAX_WIRE)
+// @Since: v1.00a
+// @Para: int nFormat(ʽ)
+// @Para: const S_MESSAGERECORD& sRecord(¼)
+// @Para: char* pBuffer()
+// @Return: UINT uiSize (볤, 0:ʧ)
+//------------------------------------------------------------------
+UINT CRosaBenchMessage::Encode(int nFormat, const S_MESSAGERECORD & sRecord, char * pBuffer)
+{
+	switch (nFormat)
+	{
+	case ROSABENCH_MESSAGE_FORMAT_OFFSET:
+	{
+		CRosaMessageWriter<BenchMessageSchema> Writer;
+		if (!Writer.CRosaMessageWriterAttach(pBuffer, ROSABENCH_MESSAGE_MAX_WIRE))
+		{
+			return 0;
+		}
+
+		Writer.CRosaMessageWriterSet<BENCHMSG_TIME>(sRecord.ullTime);
+		Writer.CRosaMessageWriterSet<BENCHMSG_DEVICE>(sRecord.uiDevice);
+		Writer.CRosaMessageWriterSet<BENCHMSG_SEQ>(sRecord.uiSeq);
+		Writer.CRosaMessageWriterSet<BENCHMSG_TEMP>(sRecord.dTemp);
+		Writer.CRosaMessageWriterSet<BENCHMSG_HUMIDITY>(sRecord.fHumidity);
+		Writer.CRosaMessageWriterSet<BENCHMSG_PRESSURE>(sRecord.fPressure);
+		Writer.CRosaMessageWriterSet<BENCHMSG_BATTERY>(sRecord.fBattery);
+		Writer.CRosaMessageWriterSet<BENCHMSG_STATUS>(sRecord.byStatus);
+
+		if (!Writer.CRosaMessageWriterSetBytes<BENCHMSG_NAME>(sRecord.chName, sRecord.uiNameSize)
+			|| !Writer.CRosaMessageWriterSetBytes<BENCHMSG_PAYLOAD>(sRecord.byPayload, sRecord.uiPayloadSize))
+		{
+			return 0;
+		}
+
+		return Writer.CRosaMessageWriterFinish();
+	}
+	case ROSABENCH_MESSAGE_FORMAT_STRUCT:
+	{
+		char* p = pBuffer + sizeof(UINT);
+
+		BENCH_PUT(p, sRecord.ullTime);
+		BENCH_PUT(p, sRecord.uiDevice);
+		BENCH_PUT(p, sRecord.uiSeq);
+		BENCH_PUT(p, sRecord.dTemp);
+		BENCH_PUT(p, sRecord.fHumidity);
+		BENCH_PUT(p, sRecord.fPressure);
+		BENCH_PUT(p, sRecord.fBattery);
+		BENCH_PUT(p, sRecord.byStatus);
+		BENCH_PUT(p, sRecord.uiNameSize);
+		memcpy(p, sRecord.chName, sRecord.uiNameSize);
+		p += sRecord.uiNameSize;
+		BENCH_PUT(p, sRecord.uiPayloadSize);
+		memcpy(p, sRecord.byPayload, sRecord.uiPayloadSize);
+		p += sRecord.uiPayloadSize;
+
+		UINT uiSize = (UINT)(p - pBuffer);
+		memcpy(pBuffer, &uiSize, sizeof(uiSize));
+
+		return uiSize;
+	}
+	case ROSABENCH_MESSAGE_FORMAT_TLV:
+	{
+		char* p = pBuffer + sizeof(UINT);
+
+		p = PutTlv(p, BENCH_TLV_TIME, &sRecord.ullTime, sizeof(sRecord.ullTime));
+		p = PutTlv(p, BENCH_TLV_DEVICE, &sRecord.uiDevice, sizeof(sRecord.uiDevice));
+		p = PutTlv(p, BENCH_TLV_SEQ, &sRecord.uiSeq, sizeof(sRecord.uiSeq));
+		p = PutTlv(p, BENCH_TLV_TEMP, &sRecord.dTemp, sizeof(sRecord.dTemp));
+		p = PutTlv(p, BENCH_TLV_HUMIDITY, &sRecord.fHumidity, sizeof(sRecord.fHumidity));
+		p = PutTlv(p, BENCH_TLV_PRESSURE, &sRecord.fPressure, sizeof(sRecord.fPressure));
+		p = PutTlv(p, BENCH_TLV_BATTERY, &sRecord.fBattery, sizeof(sRecord.fBattery));
+		p = PutTlv(p, BENCH_TLV_STATUS, &sRecord.byStatus, sizeof(sRecord.byStatus));
+		p = PutTlv(p, BENCH_TLV_NAME, sRecord.chName, (USHORT)sRecord.uiNameSize);
+		p = PutTlv(p, BENCH_TLV_PAYLOAD, sRecord.byPayload, (USHORT)sRecord.uiPayloadSize);
+
+		UINT uiSize = (UINT)(p - pBuffer);
+		memcpy(pBuffer, &uiSize, sizeof(uiSize));
+
+		return uiSize;
+	}
+	default:
+		return 0;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 EncodePayload()
+// @Purpose: CRosaBenchMessageΪͶй(ƫƲֱдĹ, ʽȴٸ)
+// @Since: v1.00a
+// @Para: int nFormat(ʽ)
+// @Para: const S_MESSAGERECORD& sRecord(¼)
+// @Return: LPS_SHAREDPAYLOAD pPayload (NULL:ʧ)
+//------------------------------------------------------------------
+LPS_SHAREDPAYLOAD CRosaBenchMessage::EncodePayload(int nFormat, const S_MESSAGERECORD & sRecord)
+{
+	if (nFormat == ROSABENCH_MESSAGE_FORMAT_OFFSET)
+	{
+		LPS_SHAREDPAYLOAD pPayload = CRosaSendQueue::CRosaSendQueueAllocPayload(ROSABENCH_MESSAGE_MAX_WIRE);
+		if (pPayload == NULL)
+		{
+			return NULL;
+		}
+
+		pPayload->uiSize = Encode(nFormat, sRecord, pPayload->chData);
+
+		return pPayload;
+	}
+
+	char chBuffer[ROSABENCH_MESSAGE_MAX_WIRE];
+	UINT uiSize = Encode(nFormat, sRecord, chBuffer);
+
+	return CRosaSendQueue::CRosaSendQueueCreatePayload(chBuffer, uiSize);
+}
+
+//------------------------------------------------------------------
+// @Function:	 Decode()
+// @Purpose: CRosaBenchMessage(ֶδTLVƵ¼, ƫƲְλöȡ, 䳤ֶû)
+// @Since: v1.00a
+// @Para: int nFormat(ʽ)
+// @Para: const char* pBuffer()
+// @Para: UINT uiSize()
+// @Para: S_MESSAGERECORD& sRecord(ֶμ䳤ֶγ)
+// @Para: const char*& pName(豸λ)
+// @Para: const char*& pPayload(λ)
+// @Return: bool bRet(true:ɹ, false:ݴ)
+//------------------------------------------------------------------
+bool CRosaBenchMessage::Decode(int nFormat, const char * pBuffer, UINT uiSize, S_MESSAGERECORD & sRecord, const char *& pName, const char *& pPayload)
+{
+	switch (nFormat)
+	{
+	case ROSABENCH_MESSAGE_FORMAT_OFFSET:
+	{
+		CRosaMessageReader<BenchMessageSchema> Reader;
+		if (!Reader.CRosaMessageReaderAttach(pBuffer, uiSize))
+		{
+			return false;
+		}
+
+		sRecord.ullTime = Reader.CRosaMessageReaderGet<BENCHMSG_TIME>();
+		sRecord.uiDevice = Reader.CRosaMessageReaderGet<BENCHMSG_DEVICE>();
+		sRecord.uiSeq = Reader.CRosaMessageReaderGet<BENCHMSG_SEQ>();
+		sRecord.dTemp = Reader.CRosaMessageReaderGet<BENCHMSG_TEMP>();
+		sRecord.fHumidity = Reader.CRosaMessageReaderGet<BENCHMSG_HUMIDITY>();
+		sRecord.fPressure = Reader.CRosaMessageReaderGet<BENCHMSG_PRESSURE>();
+		sRecord.fBattery = Reader.CRosaMessageReaderGet<BENCHMSG_BATTERY>();
+		sRecord.byStatus = Reader.CRosaMessageReaderGet<BENCHMSG_STATUS>();
+
+		pName = Reader.CRosaMessageReaderGetBytes<BENCHMSG_NAME>(sRecord.uiNameSize);
+		pPayload = Reader.CRosaMessageReaderGetBytes<BENCHMSG_PAYLOAD>(sRecord.uiPayloadSize);
+
+		return (pName != NULL && pPayload != NULL);
+	}
+	case ROSABENCH_MESSAGE_FORMAT_STRUCT:
+	{
+		const char* p = pBuffer;
+		const char* pEnd = pBuffer + uiSize;
+		UINT uiTotal = 0;
+
+		BENCH_GET(p, pEnd, uiTotal);
+		BENCH_GET(p, pEnd, sRecord.ullTime);
+		BENCH_GET(p, pEnd, sRecord.uiDevice);
+		BENCH_GET(p, pEnd, sRecord.uiSeq);
+		BENCH_GET(p, pEnd, sRecord.dTemp);
+		BENCH_GET(p, pEnd, sRecord.fHumidity);
+		BENCH_GET(p, pEnd, sRecord.fPressure);
+		BENCH_GET(p, pEnd, sRecord.fBattery);
+		BENCH_GET(p, pEnd, sRecord.byStatus);
+		BENCH_GET(p, pEnd, sRecord.uiNameSize);
+
+		if (sRecord.uiNameSize > sizeof(sRecord.chName) || pEnd - p < (ptrdiff_t)sRecord.uiNameSize)
+		{
+			return false;
+		}
+		memcpy(sRecord.chName, p, sRecord.uiNameSize);
+		p += sRecord.uiNameSize;
+
+		BENCH_GET(p, pEnd, sRecord.uiPayloadSize);
+
+		if (sRecord.uiPayloadSize > sizeof(sRecord.byPayload) || pEnd - p < (ptrdiff_t)sRecord.uiPayloadSize)
+		{
+			return false;
+		}
+		memcpy(sRecord.byPayload, p, sRecord.uiPayloadSize);
+
+		pName = sRecord.chName;
+		pPayload = (const char*)sRecord.byPayload;
+
+		return true;
+	}
+	case ROSABENCH_MESSAGE_FORMAT_TLV:
+	{
+		const char* p = pBuffer + sizeof(UINT);
+		const char* pEnd = pBuffer + uiSize;
+
+		if (uiSize < sizeof(UINT))
+		{
+			return false;
+		}
+
+		memset(&sRecord, 0, FIELD_OFFSET(S_MESSAGERECORD, chName));
+		sRecord.uiPayloadSize = 0;
+
+		while (pEnd - p >= 3)
+		{
+			BYTE byTag = (BYTE)*p++;
+			USHORT sLength = 0;
+			memcpy(&sLength, p, sizeof(sLength));
+			p += sizeof(sLength);
+
+			if (pEnd - p < sLength)
+			{
+				return false;
+			}
+
+			// Ȳ֪ǩδ֪ǩ(TLVİ汾ݷʽ)
+			void* pField = NULL;
+			UINT uiFieldSize = 0;
+
+			switch (byTag)
+			{
+			case BENCH_TLV_TIME:		pField = &sRecord.ullTime;		uiFieldSize = sizeof(sRecord.ullTime);		break;
+			case BENCH_TLV_DEVICE:		pField = &sRecord.uiDevice;		uiFieldSize = sizeof(sRecord.uiDevice);		break;
+			case BENCH_TLV_SEQ:			pField = &sRecord.uiSeq;		uiFieldSize = sizeof(sRecord.uiSeq);		break;
+			case BENCH_TLV_TEMP:		pField = &sRecord.dTemp;		uiFieldSize = sizeof(sRecord.dTemp);		break;
+			case BENCH_TLV_HUMIDITY:	pField = &sRecord.fHumidity;	uiFieldSize = sizeof(sRecord.fHumidity);	break;
+			case BENCH_TLV_PRESSURE:	pField = &sRecord.fPressure;	uiFieldSize = sizeof(sRecord.fPressure);	break;
+			case BENCH_TLV_BATTERY:		pField = &sRecord.fBattery;		uiFieldSize = sizeof(sRecord.fBattery);		break;
+			case BENCH_TLV_STATUS:		pField = &sRecord.byStatus;		uiFieldSize = sizeof(sRecord.byStatus);		break;
+			case BENCH_TLV_NAME:
+				if (sLength <= sizeof(sRecord.chName))
+				{
+					pField = sRecord.chName;
+					uiFieldSize = sRecord.uiNameSize = sLength;
+				}
+				break;
+			case BENCH_TLV_PAYLOAD:
+				if (sLength <= sizeof(sRecord.byPayload))
+				{
+					pField = sRecord.byPayload;
+					uiFieldSize = sRecord.uiPayloadSize = sLength;
+				}
+				break;
+			default:
+				break;
+			}
+
+			if (pField != NULL && uiFieldSize == sLength)
+			{
+				memcpy(pField, p, sLength);
+			}
+
+			p += sLength;
+		}
+
+		pName = sRecord.chName;
+		pPayload = (const char*)sRecord.byPayload;
+
+		return (p == pEnd);
+	}
+	default:
+		return false;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 DecodePartial()
+// @Purpose: CRosaBenchMessageֻȡ豸ż(ƫƲֱӶλ, ʽ֮ǰֶ)
+// @Since: v1.00a
+// @Para: int nFormat(ʽ)
+// @Para: const char* pBuffer()
+// @Para: UINT uiSize()
+// @Return: bool bRet(true:ɹ, false:ݴ)
+//------------------------------------------------------------------
+bool CRosaBenchMessage::DecodePartial(int nFormat, const char * pBuffer, UINT uiSize)
+{
+	UINT uiDevice = 0;
+	const char* pPayload = NULL;
+	UINT uiPayloadSize = 0;
+
+	switch (nFormat)
+	{
+	case ROSABENCH_MESSAGE_FORMAT_OFFSET:
+	{
+		CRosaMessageReader<BenchMessageSchema> Reader;
+		if (!Reader.CRosaMessageReaderAttach(pBuffer, uiSize))
+		{
+			return false;
+		}
+
+		uiDevice = Reader.CRosaMessageReaderGet<BENCHMSG_DEVICE>();
+		pPayload = Reader.CRosaMessageReaderGetBytes<BENCHMSG_PAYLOAD>(uiPayloadSize);
+		break;
+	}
+	case ROSABENCH_MESSAGE_FORMAT_STRUCT:
+	{
+		// 豸λù̶, ڱ䳤豸֮
+		const char* p = pBuffer + sizeof(UINT) + sizeof(ULONGLONG);
+		const char* pEnd = pBuffer + uiSize;
+		UINT uiNameSize = 0;
+
+		const UINT uiSkip = sizeof(UINT) + sizeof(double) + sizeof(float) * 3 + sizeof(BYTE);
+
+		BENCH_GET(p, pEnd, uiDevice);
+		if (pEnd - p < (ptrdiff_t)uiSkip)
+		{
+			return false;
+		}
+		p += uiSkip;
+		BENCH_GET(p, pEnd, uiNameSize);
+
+		if (pEnd - p < (ptrdiff_t)uiNameSize)
+		{
+			return false;
+		}
+		p += uiNameSize;
+
+		BENCH_GET(p, pEnd, uiPayloadSize);
+
+		if (pEnd - p < (ptrdiff_t)uiPayloadSize)
+		{
+			return false;
+		}
+		pPayload = p;
+		break;
+	}
+	case ROSABENCH_MESSAGE_FORMAT_TLV:
+	{
+		const char* p = pBuffer + sizeof(UINT);
+		const char* pEnd = pBuffer + uiSize;
+
+		while (pEnd - p >= 3 && pPayload == NULL)
+		{
+			BYTE byTag = (BYTE)*p++;
+			USHORT sLength = 0;
+			memcpy(&sLength, p, sizeof(sLength));
+			p += sizeof(sLength);
+
+			if (pEnd - p < sLength)
+			{
+				return false;
+			}
+
+			if (byTag == BENCH_TLV_DEVICE && sLength == sizeof(uiDevice))
+			{
+				memcpy(&uiDevice, p, sizeof(uiDevice));
+			}
+			else if (byTag == BENCH_TLV_PAYLOAD)
+			{
+				pPayload = p;
+				uiPayloadSize = sLength;
+			}
+
+			p += sLength;
+		}
+		break;
+	}
+	default:
+		return false;
+	}
+
+	if (pPayload == NULL || uiPayloadSize == 0)
+	{
+		return false;
+	}
+
+	m_ullSink += uiDevice + (BYTE)pPayload[uiPayloadSize - 1];
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 Measure()
+// @Purpose: CRosaBenchMessageظһֱ̲ʱ(ÿ鴦ȫ¼)
+// @Since: v1.00a
+// @Para: int nFormat(ʽ)
+// @Para: int nOp(ROSABENCH_MESSAGE_OP_*)
+// @Return: double dNanoSec (ÿʱ)
+//------------------------------------------------------------------
+double CRosaBenchMessage::Measure(int nFormat, int nOp)
+{
+	ULONGLONG ullNanoSec = 0;
+	ULONGLONG ullCount = 0;
+
+	while (ullNanoSec < (ULONGLONG)ROSABENCH_MESSAGE_MIN_MSEC * 1000000)
+	{
+		LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+
+		for (UINT i = 0; i < ROSABENCH_MESSAGE_RECORDS; ++i)
+		{
+			char* pWire = &m_vecWire[i * ROSABENCH_MESSAGE_MAX_WIRE];
+
+			switch (nOp)
+			{
+			case ROSABENCH_MESSAGE_OP_ENCODE:
+				m_ullSink += Encode(nFormat, m_vecRecord[i], pWire);
+				break;
+			case ROSABENCH_MESSAGE_OP_PAYLOAD:
+			{
+				LPS_SHAREDPAYLOAD pPayload = EncodePayload(nFormat, m_vecRecord[i]);
+				if (pPayload != NULL)
+				{
+					m_ullSink += pPayload->uiSize;
+					CRosaSendQueue::CRosaSendQueueReleasePayload(pPayload);
+				}
+				break;
+			}
+			case ROSABENCH_MESSAGE_OP_DECODE:
+			{
+				S_MESSAGERECORD sRecord;
+				const char* pName = NULL;
+				const char* pPayload = NULL;
+
+				if (Decode(nFormat, pWire, m_vecWireSize[i], sRecord, pName, pPayload))
+				{
+					m_ullSink += sRecord.ullTime + sRecord.uiDevice + sRecord.uiSeq + (ULONGLONG)sRecord.dTemp + (ULONGLONG)sRecord.fHumidity
+						+ (ULONGLONG)sRecord.fPressure + (ULONGLONG)sRecord.fBattery + sRecord.byStatus
+						+ (BYTE)pName[sRecord.uiNameSize - 1] + (BYTE)pPayload[sRecord.uiPayloadSize - 1];
+				}
+				break;
+			}
+			case ROSABENCH_MESSAGE_OP_PARTIAL:
+				DecodePartial(nFormat, pWire, m_vecWireSize[i]);
+				break;
+			default:
+				break;
+			}
+		}
+
+		ullNanoSec += CRosaHistogram::CRosaHistogramToNanoSec(CRosaHistogram::CRosaHistogramNow() - llStart);
+		ullCount += ROSABENCH_MESSAGE_RECORDS;
+	}
+
+	return (double)ullNanoSec / ullCount;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CheckCrossVersion()
+// @Purpose: CRosaBenchMessage¾ɰ汾ṹȡ(v2v1ʱ׷ֶȡĬֵ, v1v2ʱ׷ֶ)
+// @Since: v1.00a
+// @Para: None
+// @Return: bool bRet (true:ͨ, false:ʧ)
+//------------------------------------------------------------------
+bool CRosaBenchMessage::CheckCrossVersion()
+{
+	static_assert(BenchMessageSchemaV2::Field<2>::OFFSET < BenchMessageSchemaV1::FIXED_END, "cross version check must append inside the v1 padding");
+
+	char chWire[ROSABENCH_MESSAGE_MAX_WIRE] = { 0 };
+	const ULONGLONG ullTime = 0x0123456789ABCDEFULL;
+	const UINT uiDevice = 0x5A5A5A5A;
+	const UINT uiDefault = 0xFFFFFFFF;
+
+	// v1д, v2ȡ
+	CRosaMessageWriter<BenchMessageSchemaV1> WriterV1;
+	if (!WriterV1.CRosaMessageWriterAttach(chWire, sizeof(chWire)))
+	{
+		return false;
+	}
+
+	WriterV1.CRosaMessageWriterSet<0>(ullTime);
+	WriterV1.CRosaMessageWriterSet<1>(uiDevice);
+	UINT uiSize = WriterV1.CRosaMessageWriterFinish();
+
+	CRosaMessageReader<BenchMessageSchemaV2> ReaderV2;
+	UINT uiBytes = 0;
+
+	if (uiSize == 0 || !ReaderV2.CRosaMessageReaderAttach(chWire, uiSize)
+		|| ReaderV2.CRosaMessageReaderGet<0>() != ullTime || ReaderV2.CRosaMessageReaderGet<1>() != uiDevice
+		|| ReaderV2.CRosaMessageReaderHas<2>() || ReaderV2.CRosaMessageReaderGet<2>(uiDefault) != uiDefault
+		|| ReaderV2.CRosaMessageReaderHas<3>() || ReaderV2.CRosaMessageReaderGetBytes<3>(uiBytes) != NULL)
+	{
+		return false;
+	}
+
+	// v2д, v1ȡ
+	CRosaMessageWriter<BenchMessageSchemaV2> WriterV2;
+	if (!WriterV2.CRosaMessageWriterAttach(chWire, sizeof(chWire)))
+	{
+		return false;
+	}
+
+	WriterV2.CRosaMessageWriterSet<0>(ullTime);
+	WriterV2.CRosaMessageWriterSet<1>(uiDevice);
+	WriterV2.CRosaMessageWriterSet<2>(0u);
+	if (!WriterV2.CRosaMessageWriterSetBytes<3>("v2", 2))
+	{
+		return false;
+	}
+	uiSize = WriterV2.CRosaMessageWriterFinish();
+
+	CRosaMessageReader<BenchMessageSchemaV1> ReaderV1;
+
+	if (uiSize == 0 || !ReaderV1.CRosaMessageReaderAttach(chWire, uiSize)
+		|| ReaderV1.CRosaMessageReaderGet<0>() != ullTime || ReaderV1.CRosaMessageReaderGet<1>() != uiDevice
+		|| ReaderV1.CRosaMessageReaderGetSize() != uiSize)
+	{
+		return false;
+	}
+
+	// v2д׷ֶΪ0ʱԴ(v1ȱٸֶ)
+	if (!ReaderV2.CRosaMessageReaderAttach(chWire, uiSize) || !ReaderV2.CRosaMessageReaderHas<2>()
+		|| ReaderV2.CRosaMessageReaderGet<2>(uiDefault) != 0 || ReaderV2.CRosaMessageReaderGetBytes<3>(uiBytes) == NULL || uiBytes != 2)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchMessageUsage()
+// @Purpose: CRosaBenchMessageѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchMessage::CRosaBenchMessageUsage()
+{
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchMessageParse()
+// @Purpose: CRosaBenchMessageѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchMessage::CRosaBenchMessageParse(const char * pcArg, const char * pcValue)
+{
+	return ROSABENCH_PARSE_UNKNOWN;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchMessageMain()
+// @Purpose: CRosaBenchMessageȫʽ
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchMessage::CRosaBenchMessageMain(const S_BENCHCOMMON & sCommon)
+{
+	CRosaBenchMessage BenchMessage;
+
+	for (int f = 0; f < ROSABENCH_MESSAGE_FORMAT_COUNT; ++f)
+	{
+		BenchOutput(BenchMessage.CRosaBenchMessageRun(f));
+	}
+}
@@ -0,0 +1,110 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchMessage.h
+* @brief	This File is RosaBenchMessage Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHMESSAGE_H__
+#define __CROSABENCHMESSAGE_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Include Rosa Header File
+#include "../Rosa/CRosaMessage.h"
+#include "../Rosa/CRosaSendQueue.h"
+
+//Macro Definition
+#define ROSABENCH_MESSAGE_RECORDS		1024			//ÿļ¼
+#define ROSABENCH_MESSAGE_NAME			16				//豸󳤶
+#define ROSABENCH_MESSAGE_PAYLOAD		64				//󳤶
+#define ROSABENCH_MESSAGE_MAX_WIRE		256				//һ󳤶(ʽͬ)
+#define ROSABENCH_MESSAGE_MIN_MSEC		500				//ÿ̲ʱ()
+
+#define ROSABENCH_MESSAGE_FORMAT_OFFSET	0				//ƫƲ(CRosaMessage)
+#define ROSABENCH_MESSAGE_FORMAT_STRUCT	1				//ֶmemcpy
+#define ROSABENCH_MESSAGE_FORMAT_TLV	2				//ǩ--ֵ
+#define ROSABENCH_MESSAGE_FORMAT_COUNT	3
+
+#define ROSABENCH_MESSAGE_OP_ENCODE		0				//뵽ػ
+#define ROSABENCH_MESSAGE_OP_PAYLOAD	1				//ΪͶй(++ͷ)
+#define ROSABENCH_MESSAGE_OP_DECODE		2				//ȡȫֶ
+#define ROSABENCH_MESSAGE_OP_PARTIAL	3				//ȡֶ
+
+//Struct Definition
+typedef struct
+{
+	ULONGLONG ullTime;									// ʱ
+	UINT uiDevice;										// 豸
+	UINT uiSeq;											// 
+	double dTemp;										// ¶
+	float fHumidity;									// ʪ
+	float fPressure;									// ѹ
+	float fBattery;										// ѹ
+	BYTE byStatus;										// ״̬
+	UINT uiNameSize;									// 豸
+	char chName[ROSABENCH_MESSAGE_NAME];				// 豸
+	UINT uiPayloadSize;									// ݳ
+	BYTE byPayload[ROSABENCH_MESSAGE_PAYLOAD];			// 
+}S_MESSAGERECORD, *LPS_MESSAGERECORD;
+
+//Schema Definition
+enum
+{
+	BENCHMSG_TIME,
+	BENCHMSG_DEVICE,
+	BENCHMSG_SEQ,
+	BENCHMSG_TEMP,
+	BENCHMSG_HUMIDITY,
+	BENCHMSG_PRESSURE,
+	BENCHMSG_BATTERY,
+	BENCHMSG_STATUS,
+	BENCHMSG_NAME,
+	BENCHMSG_PAYLOAD,
+};
+
+typedef CRosaMessageSchema<0x0B01, ULONGLONG, UINT, UINT, double, float, float, float, BYTE, CRosaMessageBytes, CRosaMessageBytes> BenchMessageSchema;
+
+// 汾(v2v1ĩβ׷ֶ, һ׷ֶλv1Ķ)
+typedef CRosaMessageSchema<0x0B02, ULONGLONG, UINT> BenchMessageSchemaV1;
+typedef CRosaMessageSchema<0x0B02, ULONGLONG, UINT, UINT, CRosaMessageBytes> BenchMessageSchemaV2;
+
+//Class Definition
+class CRosaBenchMessage
+{
+public:
+	CRosaBenchMessage();		// CRosaBenchMessage 캯
+	~CRosaBenchMessage();		// CRosaBenchMessage 
+
+public:
+	string CRosaBenchMessageRun(int nFormat);				// CRosaBenchMessage һָʽ(JSON)
+
+	static void CRosaBenchMessageUsage();												// CRosaBenchMessage ѡ˵
+	static int CRosaBenchMessageParse(const char* pcArg, const char* pcValue);			// CRosaBenchMessage ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchMessageMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchMessage ȫ
+
+private:
+	UINT Encode(int nFormat, const S_MESSAGERECORD& sRecord, char* pBuffer);				// CRosaBenchMessage 뵽(س, 0:ʧ)
+	LPS_SHAREDPAYLOAD EncodePayload(int nFormat, const S_MESSAGERECORD& sRecord);			// CRosaBenchMessage ΪͶй
+	bool Decode(int nFormat, const char* pBuffer, UINT uiSize, S_MESSAGERECORD& sRecord, const char*& pName, const char*& pPayload);	// CRosaBenchMessage (䳤ֶλpName/pPayload, ƫƲֲ)
+	bool DecodePartial(int nFormat, const char* pBuffer, UINT uiSize);						// CRosaBenchMessage ֻȡ豸ż
+
+	double Measure(int nFormat, int nOp);													// CRosaBenchMessage ظһֱ̲ʱ(ÿ)
+	bool CheckCrossVersion();																// CRosaBenchMessage ¾ɰ汾ṹȡ(׷ֶ)
+
+private:
+	vector<S_MESSAGERECORD> m_vecRecord;		// CRosaBenchMessage Լ¼
+	vector<char> m_vecWire;						// CRosaBenchMessage (ÿROSABENCH_MESSAGE_MAX_WIRE)
+	vector<UINT> m_vecWireSize;					// CRosaBenchMessage 볤
+	volatile ULONGLONG m_ullSink;				// CRosaBenchMessage ȡۼ(ⱻŻ)
+
+};
+
+#endif // !__CROSABENCHMESSAGE_H__
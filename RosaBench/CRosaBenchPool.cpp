@@ -0,0 +1,418 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchPool.cpp
+* @brief	This File is RosaBenchPool Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchPool.h"
+
+//Include C/C++ Header File
+#include <process.h>
+#include <stdio.h>
+
+//CRosaBenchPool ӳز(Ӧ, Ƚÿӳõÿʱֲ)
+
+// ѡ(бʱȡĬֵ)
+static vector<UINT> g_vecPoolThread;
+static UINT g_uiPoolSize = ROSABENCH_DEFAULT_POOL_SIZE;
+
+// ʽ
+static const char* g_pcPoolModeName[ROSABENCH_POOL_COUNT] = { "connect", "pool" };
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchPool()
+// @Purpose: CRosaBenchPool캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchPool::CRosaBenchPool()
+{
+	m_bExit = FALSE;
+
+	memset(&m_sConfig, 0, sizeof(m_sConfig));
+	m_pPool = NULL;
+	m_lServerConn = 0;
+	m_lAccepted = 0;
+	m_hStartEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+
+	m_Latency.CRosaHistogramCreate();
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchPool()
+// @Purpose: CRosaBenchPool
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchPool::~CRosaBenchPool()
+{
+	if (m_hStartEvent)
+	{
+		CloseHandle(m_hStartEvent);
+		m_hStartEvent = NULL;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchPoolRun()
+// @Purpose: CRosaBenchPoolһ(ÿ¼, ӳطʽڼʱ֮ǰ)
+// @Since: v1.00a
+// @Para: const S_POOLBENCHCONFIG& sConfig(Բ)
+// @Return: string strJson ()
+//------------------------------------------------------------------
+string CRosaBenchPool::CRosaBenchPoolRun(const S_POOLBENCHCONFIG & sConfig)
+{
+	char chHead[512] = { 0 };
+
+	m_sConfig = sConfig;
+	m_sConfig.uiThreads = (m_sConfig.uiThreads < 1) ? 1 : min(m_sConfig.uiThreads, (UINT)ROSA_POOL_MAX_TOTAL);
+	m_sConfig.uiSize = (m_sConfig.uiSize < 1) ? 1 : m_sConfig.uiSize;
+
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"pool\",\"mode\":\"%s\",\"threads\":%u,\"size\":%u",
+		CRosaBenchPoolGetModeName(m_sConfig.nMode), m_sConfig.uiThreads, m_sConfig.uiSize);
+
+	m_bExit = FALSE;
+	m_lServerConn = 0;
+	m_lAccepted = 0;
+
+	if (!m_Server.CRosaBenchServerStart(m_sConfig.sPort, OnAccept, this))
+	{
+		char chError[128] = { 0 };
+		sprintf_s(chError, sizeof(chError), ",\"error\":\"listen failed (WSA %d)\"}", m_Server.CRosaBenchServerGetError());
+
+		return string("{") + chHead + chError;
+	}
+
+	// ӳ߳ͬ, òȴ̹߳黹
+	CRosaSocketPool Pool;
+
+	if (m_sConfig.nMode == ROSABENCH_POOL_LEASE)
+	{
+		Pool.CRosaSocketPoolCreate((USHORT)m_sConfig.uiThreads, (USHORT)m_sConfig.uiThreads);
+		m_pPool = &Pool;
+
+		// ԤȽȫ, ȶ״̬µü黹
+		vector<CRosaSocket*> vecWarm;
+		for (UINT i = 0; i < m_sConfig.uiThreads; ++i)
+		{
+			CRosaSocket* pConn = Pool.CRosaSocketPoolLease("127.0.0.1", m_sConfig.sPort);
+			if (pConn)
+			{
+				vecWarm.push_back(pConn);
+			}
+		}
+
+		for (size_t i = 0; i < vecWarm.size(); ++i)
+		{
+			Pool.CRosaSocketPoolReturn(vecWarm[i]);
+		}
+	}
+
+	LONG lWarmAccepted = m_lAccepted;
+
+	// ͻ߳
+	vector<S_POOLBENCHCLIENT> vecClient(m_sConfig.uiThreads);
+	vector<HANDLE> vecThread;
+
+	for (UINT i = 0; i < m_sConfig.uiThreads; ++i)
+	{
+		memset(&vecClient[i], 0, sizeof(S_POOLBENCHCLIENT));
+		vecClient[i].pBench = this;
+
+		HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, OnClientThread, &vecClient[i], 0, NULL);
+		if (hThread)
+		{
+			vecThread.push_back(hThread);
+		}
+	}
+
+	m_Latency.CRosaHistogramReset();
+
+	S_BENCHCPU sCpu;
+	BenchCpuStart(sCpu);
+	SetEvent(m_hStartEvent);
+
+	for (size_t i = 0; i < vecThread.size(); ++i)
+	{
+		WaitForSingleObject(vecThread[i], INFINITE);
+		CloseHandle(vecThread[i]);
+	}
+
+	double dSeconds = 0.0;
+	double dCpu = BenchCpuStop(sCpu, dSeconds);
+	ResetEvent(m_hStartEvent);
+
+	LONG lAccepted = m_lAccepted - lWarmAccepted;
+
+	// رտӺ߳յر˳
+	if (m_pPool)
+	{
+		Pool.CRosaSocketPoolDestroy();
+		m_pPool = NULL;
+	}
+
+	m_bExit = TRUE;
+	m_Server.CRosaBenchServerStop();
+
+	for (DWORD dwWait = 0; m_lServerConn > 0 && dwWait < ROSABENCH_POOL_DRAIN_MAX; dwWait += 10)
+	{
+		Sleep(10);
+	}
+
+	// 
+	ULONGLONG ullRequests = 0;
+	ULONGLONG ullErrors = 0;
+
+	for (UINT i = 0; i < m_sConfig.uiThreads; ++i)
+	{
+		ullRequests += vecClient[i].ullRequests;
+		ullErrors += vecClient[i].ullErrors;
+	}
+
+	char chResult[512] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"seconds\":%.3f,\"requests\":%llu,\"errors\":%llu,\"requests_per_sec\":%.1f,\"new_connections\":%ld,\"cpu_percent\":%.1f,\"request_ns\":",
+		dSeconds, ullRequests, ullErrors, (dSeconds > 0.0) ? ullRequests / dSeconds : 0.0, lAccepted, dCpu);
+
+	return string("{") + chHead + chResult + BenchSummaryJson(m_Latency) + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchPoolGetModeName()
+// @Purpose: CRosaBenchPoolȡͻ˷ʽ
+// @Since: v1.00a
+// @Para: int nMode(ROSABENCH_POOL_*)
+// @Return: const char* pcName
+//------------------------------------------------------------------
+const char * CRosaBenchPool::CRosaBenchPoolGetModeName(int nMode)
+{
+	if (nMode < 0 || nMode >= ROSABENCH_POOL_COUNT)
+	{
+		return "";
+	}
+
+	return g_pcPoolModeName[nMode];
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAccept()
+// @Purpose: CRosaBenchPool(ÿһСջ߳)
+// @Since: v1.00a
+// @Para: void* pContext(Զ)
+// @Para: SOCKET s(ͻ׽)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchPool::OnAccept(void * pContext, SOCKET s, USHORT nShard)
+{
+	CRosaBenchPool* pBench = reinterpret_cast<CRosaBenchPool*>(pContext);
+
+	InterlockedIncrement(&pBench->m_lAccepted);
+	BenchStartConnThread(OnServerConn, pBench, s, pBench->m_lServerConn, ROSABENCH_THREAD_STACK);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnServerConn()
+// @Purpose: CRosaBenchPool߳(Թ̶, ͻ˹رպ˳; еĳӲʱر)
+// @Since: v1.00a
+// @Para: void* pParam(S_BENCHCONN)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchPool::OnServerConn(void * pParam)
+{
+	LPS_BENCHCONN pConn = reinterpret_cast<LPS_BENCHCONN>(pParam);
+	CRosaBenchPool* pBench = reinterpret_cast<CRosaBenchPool*>(pConn->pContext);
+
+	CRosaSocket Conn;
+	Conn.CRosaSocketAttachRawSocket(pConn->Socket, true);
+	delete pConn;
+
+	UINT uiSize = pBench->m_sConfig.uiSize;
+	char* pBuffer = new char[uiSize];
+
+	while (true)
+	{
+		int nRet = Conn.CRosaSocketRecvBuffer(pBuffer, uiSize, uiSize, 1);
+
+		if (nRet == SOB_RET_TIMEOUT && !pBench->m_bExit)
+		{
+			continue;
+		}
+
+		if (nRet != SOB_RET_OK || Conn.CRosaSocketSendBuffer(pBuffer, uiSize) != SOB_RET_OK)
+		{
+			break;
+		}
+	}
+
+	delete[] pBuffer;
+
+	// ӷʽͻر, ҲرձTIME_WAIT
+	LINGER sLinger = { 1, 0 };
+	setsockopt(Conn.CRosaSocketGetRawSocket(), SOL_SOCKET, SO_LINGER, (char*)&sLinger, sizeof(sLinger));
+	Conn.CRosaSocketDisConnect();
+
+	InterlockedDecrement(&pBench->m_lServerConn);
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnClientThread()
+// @Purpose: CRosaBenchPoolͻ߳(ʱӻ)
+// @Since: v1.00a
+// @Para: void* pParam(S_POOLBENCHCLIENT)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchPool::OnClientThread(void * pParam)
+{
+	LPS_POOLBENCHCLIENT pClient = reinterpret_cast<LPS_POOLBENCHCLIENT>(pParam);
+	CRosaBenchPool* pBench = pClient->pBench;
+
+	UINT uiSize = pBench->m_sConfig.uiSize;
+	char* pSendBuffer = new char[uiSize];
+	char* pRecvBuffer = new char[uiSize];
+	memset(pSendBuffer, 'R', uiSize);
+
+	WaitForSingleObject(pBench->m_hStartEvent, INFINITE);
+
+	LARGE_INTEGER liFrequency;
+	QueryPerformanceFrequency(&liFrequency);
+
+	LONGLONG llDeadline = CRosaHistogram::CRosaHistogramNow() + liFrequency.QuadPart * pBench->m_sConfig.uiSeconds;
+
+	while (CRosaHistogram::CRosaHistogramNow() < llDeadline)
+	{
+		LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+		bool bOk = false;
+
+		if (pBench->m_sConfig.nMode == ROSABENCH_POOL_LEASE)
+		{
+			CRosaSocket* pConn = pBench->m_pPool->CRosaSocketPoolLease("127.0.0.1", pBench->m_sConfig.sPort, 1);
+			if (pConn)
+			{
+				bOk = pBench->Transact(pConn, pSendBuffer, pRecvBuffer);
+				pBench->m_pPool->CRosaSocketPoolReturn(pConn, bOk);
+			}
+		}
+		else
+		{
+			CRosaSocket Conn;
+			if (Conn.CRosaSocketConnect("127.0.0.1", pBench->m_sConfig.sPort, 1))
+			{
+				bOk = pBench->Transact(&Conn, pSendBuffer, pRecvBuffer);
+
+				LINGER sLinger = { 1, 0 };
+				setsockopt(Conn.CRosaSocketGetRawSocket(), SOL_SOCKET, SO_LINGER, (char*)&sLinger, sizeof(sLinger));
+				Conn.CRosaSocketDisConnect();
+			}
+		}
+
+		if (bOk)
+		{
+			pBench->m_Latency.CRosaHistogramRecordSince(llStart);
+			pClient->ullRequests++;
+		}
+		else
+		{
+			pClient->ullErrors++;
+		}
+	}
+
+	delete[] pSendBuffer;
+	delete[] pRecvBuffer;
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 Transact()
+// @Purpose: CRosaBenchPoolһӦ
+// @Since: v1.00a
+// @Para: CRosaSocket* pConn(ӵĿͻ)
+// @Para: char* pSendBuffer()
+// @Para: char* pRecvBuffer(Ӧ)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool CRosaBenchPool::Transact(CRosaSocket * pConn, char * pSendBuffer, char * pRecvBuffer)
+{
+	UINT uiSize = m_sConfig.uiSize;
+
+	return (pConn->CRosaSocketSendBuffer(pSendBuffer, uiSize) == SOB_RET_OK &&
+		pConn->CRosaSocketRecvBuffer(pRecvBuffer, uiSize, uiSize) == SOB_RET_OK);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchPoolUsage()
+// @Purpose: CRosaBenchPoolѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchPool::CRosaBenchPoolUsage()
+{
+	fprintf(stderr,
+		"  --pool-threads <list>  request/response client threads, connect per request vs pooled (default: " ROSABENCH_DEFAULT_POOL_THREADS ")\n"
+		"  --pool-size <n>        request and response size (default: %d)\n",
+		ROSABENCH_DEFAULT_POOL_SIZE);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchPoolParse()
+// @Purpose: CRosaBenchPoolѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchPool::CRosaBenchPoolParse(const char * pcArg, const char * pcValue)
+{
+	bool bOk = false;
+
+	if (strcmp(pcArg, "--pool-threads") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecPoolThread);
+	}
+	else if (strcmp(pcArg, "--pool-size") == 0)
+	{
+		g_uiPoolSize = strtoul(pcValue, NULL, 10);
+		bOk = (g_uiPoolSize > 0);
+	}
+	else
+	{
+		return ROSABENCH_PARSE_UNKNOWN;
+	}
+
+	return bOk ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchPoolMain()
+// @Purpose: CRosaBenchPoolȫ(ͻ˷ʽ*߳)
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchPool::CRosaBenchPoolMain(const S_BENCHCOMMON & sCommon)
+{
+	if (g_vecPoolThread.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_POOL_THREADS, g_vecPoolThread);
+	}
+
+	CRosaBenchPool BenchPool;
+
+	for (int m = 0; m < ROSABENCH_POOL_COUNT; ++m)
+	{
+		for (size_t t = 0; t < g_vecPoolThread.size(); ++t)
+		{
+			S_POOLBENCHCONFIG sConfig = { m, g_vecPoolThread[t], g_uiPoolSize, sCommon.uiSeconds, sCommon.sPort };
+			BenchOutput(BenchPool.CRosaBenchPoolRun(sConfig));
+		}
+	}
+}
@@ -0,0 +1,89 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchPool.h
+* @brief	This File is RosaBenchPool Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHPOOL_H__
+#define __CROSABENCHPOOL_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Include Rosa Header File
+#include "../Rosa/CRosaSocketPool.h"
+
+//Macro Definition
+#define ROSABENCH_POOL_CONNECT			0				//ͻ:ÿӡշϿ
+#define ROSABENCH_POOL_LEASE			1				//ͻ:CRosaSocketPoolӵCRosaSocket, շ黹
+#define ROSABENCH_POOL_COUNT			2
+
+#define ROSABENCH_POOL_DRAIN_MAX		3000			//ȴ߳˳ʱ()
+
+#define ROSABENCH_DEFAULT_POOL_THREADS	"1,4"			//ĬϿͻ߳
+#define ROSABENCH_DEFAULT_POOL_SIZE		64				//ĬӦ𳤶
+
+//Struct Definition
+typedef struct
+{
+	int nMode;					// ͻ˷ʽ(ROSABENCH_POOL_*)
+	UINT uiThreads;				// ͻ߳(ӳÿ˵ͬ)
+	UINT uiSize;				// Ӧ𳤶
+	UINT uiSeconds;				// ʱ
+	USHORT sPort;				// ˿
+}S_POOLBENCHCONFIG, *LPS_POOLBENCHCONFIG;
+
+//Class Declaration
+class CRosaBenchPool;
+
+typedef struct
+{
+	CRosaBenchPool* pBench;		// 
+	ULONGLONG ullRequests;		// ɵ
+	ULONGLONG ullErrors;		// ʧܴ
+}S_POOLBENCHCLIENT, *LPS_POOLBENCHCLIENT;
+
+//Class Definition
+class CRosaBenchPool
+{
+public:
+	CRosaBenchPool();			// CRosaBenchPool 캯
+	~CRosaBenchPool();			// CRosaBenchPool 
+
+public:
+	string CRosaBenchPoolRun(const S_POOLBENCHCONFIG& sConfig);		// CRosaBenchPool һ(JSON)
+
+	static const char* CRosaBenchPoolGetModeName(int nMode);			// CRosaBenchPool ȡͻ˷ʽ
+
+	static void CRosaBenchPoolUsage();												// CRosaBenchPool ѡ˵
+	static int CRosaBenchPoolParse(const char* pcArg, const char* pcValue);			// CRosaBenchPool ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchPoolMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchPool ȫ
+
+private:
+	static void OnAccept(void* pContext, SOCKET s, USHORT nShard);							// CRosaBenchPool (ÿһСջ߳)
+	static unsigned __stdcall OnServerConn(void* pParam);									// CRosaBenchPool ߳()
+	static unsigned __stdcall OnClientThread(void* pParam);									// CRosaBenchPool ͻ߳
+
+	bool Transact(CRosaSocket* pConn, char* pSendBuffer, char* pRecvBuffer);				// CRosaBenchPool һӦ
+
+private:
+	CRosaBenchServer m_Server;					// CRosaBenchPool (ÿ¼)
+	BOOL m_bExit;								// CRosaBenchPool ˳־(߳)
+
+	S_POOLBENCHCONFIG m_sConfig;				// CRosaBenchPool ǰԲ
+	CRosaSocketPool* m_pPool;					// CRosaBenchPool ӳ(÷ʽ)
+	volatile LONG m_lServerConn;				// CRosaBenchPool ߳
+	volatile LONG m_lAccepted;					// CRosaBenchPool ˽ܵ
+	HANDLE m_hStartEvent;						// CRosaBenchPool ͻ߳ͬʱʼ
+	CRosaHistogram m_Latency;					// CRosaBenchPool ʱ(ӻ)
+
+};
+
+#endif // !__CROSABENCHPOOL_H__
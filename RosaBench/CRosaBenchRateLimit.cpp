@@ -0,0 +1,396 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchRateLimit.cpp
+* @brief	This File is RosaBenchRateLimit Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchRateLimit.h"
+
+//Include C/C++ Header File
+#include <stdio.h>
+
+//CRosaBenchRateLimit ٵȲ(ģֱӵCRosaRateLimiterAcquire, ׽, ȿƫбµĹƽ)
+
+// ѡ(бʱȡĬֵ)
+static vector<UINT> g_vecRlFlow;
+static UINT g_uiRlHeavy = ROSABENCH_DEFAULT_RL_HEAVY;
+static UINT g_uiRlSize = ROSABENCH_DEFAULT_RL_SIZE;
+static UINT g_uiRlRate = ROSABENCH_DEFAULT_RL_RATE;
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchRateLimit()
+// @Purpose: CRosaBenchRateLimit캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchRateLimit::CRosaBenchRateLimit()
+{
+	memset(&m_sConfig, 0, sizeof(m_sConfig));
+	m_dLightOffer = 0.0;
+	m_lStop = 0;
+
+	m_Acquire.CRosaHistogramCreate();
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchRateLimit()
+// @Purpose: CRosaBenchRateLimit
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchRateLimit::~CRosaBenchRateLimit()
+{
+	m_Limiter.CRosaRateLimiterDestroy();
+	m_Loop.CRosaEventLoopDestroy();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchRateLimitRun()
+// @Purpose: CRosaBenchRateLimitһ(һ, ظʼջѹ, ḺӰƽݶһϢ)
+// @Since: v1.00a
+// @Para: const S_RLBENCHCONFIG& sConfig(Բ)
+// @Return: string strJson ()
+//------------------------------------------------------------------
+string CRosaBenchRateLimit::CRosaBenchRateLimitRun(const S_RLBENCHCONFIG & sConfig)
+{
+	char chHead[512] = { 0 };
+
+	m_sConfig = sConfig;
+
+	UINT uiHeavy = (UINT)((ULONGLONG)m_sConfig.uiFlows * m_sConfig.uiHeavyPercent / 100);
+	uiHeavy = (uiHeavy == 0) ? 1 : ((uiHeavy > m_sConfig.uiFlows) ? m_sConfig.uiFlows : uiHeavy);
+
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"ratelimit\",\"flows\":%u,\"heavy\":%u,\"size\":%u,\"rate_mb\":%u",
+		m_sConfig.uiFlows, uiHeavy, m_sConfig.uiSize, m_sConfig.uiRateMB);
+
+	ULONGLONG ullRate = (ULONGLONG)m_sConfig.uiRateMB * 1024 * 1024;
+	if (ullRate == 0 || ullRate > MAXDWORD)
+	{
+		return string("{") + chHead + ",\"error\":\"rate out of range\"}";
+	}
+
+	// ߳¼ѭ, ģӵ״ֻ̬ѭ߳жд
+	if (!m_Loop.CRosaEventLoopCreate(1) || !m_Limiter.CRosaRateLimiterCreate(&m_Loop))
+	{
+		m_Loop.CRosaEventLoopDestroy();
+		return string("{") + chHead + ",\"error\":\"event loop\"}";
+	}
+
+	// ͻȡһڵ, ʼƲӰ
+	S_RATELIMIT sGroupLimit = { (UINT)ullRate, (UINT)(ullRate * ROSA_RATELIMIT_TICK_MSEC / 1000), 0, 0 };
+	S_RATELIMIT sFlowLimit = { 0, 0, 0, 0 };
+
+	UINT uiGroup = m_Limiter.CRosaRateLimiterCreateGroup(sGroupLimit);
+
+	m_vecFlow.clear();
+	m_vecFlow.resize(m_sConfig.uiFlows);
+
+	for (UINT i = 0; i < m_sConfig.uiFlows; ++i)
+	{
+		LPS_RLBENCHFLOW pFlow = &m_vecFlow[i];
+		memset(pFlow, 0, sizeof(S_RLBENCHFLOW));
+
+		pFlow->Ready.pCallback = OnFlowReady;
+		pFlow->Ready.pUser = pFlow;
+		pFlow->pBench = this;
+		pFlow->bHeavy = (i < uiHeavy);
+		pFlow->uiFlow = m_Limiter.CRosaRateLimiterAddFlow(uiGroup, sFlowLimit, 1, OnResume, (DWORD_PTR)pFlow);
+	}
+
+	// ḺӵĲΪƽݶһ, ݶظƽ
+	double dLightBytes = (double)ullRate / m_sConfig.uiFlows / 2.0;
+	m_dLightOffer = dLightBytes * ROSABENCH_RL_OFFER_MSEC / 1000.0 / m_sConfig.uiSize;
+	m_lStop = 0;
+
+	m_Acquire.CRosaHistogramReset();
+
+	S_RATELIMITSTATS sStats;
+	m_Limiter.CRosaRateLimiterGetStats(sStats, true);
+
+	S_BENCHCPU sCpu;
+	BenchCpuStart(sCpu);
+
+	ULONGLONG ullOfferTimerID = m_Loop.CRosaEventLoopSetTimer(ROSABENCH_RL_OFFER_MSEC, ROSABENCH_RL_OFFER_MSEC, OnOfferTimer, this);
+
+	for (UINT i = 0; i < uiHeavy; ++i)
+	{
+		PostFlow(&m_vecFlow[i]);
+	}
+
+	Sleep(m_sConfig.uiSeconds * 1000);
+
+	// ֹͣڶеɰֱӷ, ˳֮
+	InterlockedExchange(&m_lStop, 1);
+
+	double dSeconds = 0.0;
+	double dCpu = BenchCpuStop(sCpu, dSeconds);
+
+	m_Loop.CRosaEventLoopKillTimer(ullOfferTimerID);
+	m_Limiter.CRosaRateLimiterGetStats(sStats);
+	m_Limiter.CRosaRateLimiterDestroy();
+	m_Loop.CRosaEventLoopDestroy();
+
+	// 
+	ULONGLONG ullTotal = 0;
+	ULONGLONG ullLight = 0;
+	double dHeavySum = 0.0;
+	double dHeavySquare = 0.0;
+	double dHeavyMin = 0.0;
+	double dHeavyMax = 0.0;
+
+	for (UINT i = 0; i < m_sConfig.uiFlows; ++i)
+	{
+		double dBytes = (double)m_vecFlow[i].ullBytes;
+		ullTotal += m_vecFlow[i].ullBytes;
+
+		if (!m_vecFlow[i].bHeavy)
+		{
+			ullLight += m_vecFlow[i].ullBytes;
+			continue;
+		}
+
+		dHeavySum += dBytes;
+		dHeavySquare += dBytes * dBytes;
+		dHeavyMin = (i == 0 || dBytes < dHeavyMin) ? dBytes : dHeavyMin;
+		dHeavyMax = (dBytes > dHeavyMax) ? dBytes : dHeavyMax;
+	}
+
+	m_vecFlow.clear();
+
+	// Jainƽָ(1Ϊȫƽ), Ḻ(Ӧӽ1)
+	double dJain = (dHeavySquare > 0.0) ? dHeavySum * dHeavySum / (uiHeavy * dHeavySquare) : 0.0;
+	double dLightOffered = dLightBytes * (m_sConfig.uiFlows - uiHeavy) * dSeconds;
+
+	char chResult[1024] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"seconds\":%.3f,\"mb_per_sec\":%.3f,\"utilization\":%.3f,\"heavy_jain\":%.4f,\"heavy_min_max\":%.3f,\"light_satisfaction\":%.3f,"
+		"\"acquire_per_sec\":%.1f,\"stalls\":%llu,\"resumes\":%llu,\"ticks\":%llu,\"tick_mean_ns\":%llu,\"tick_max_ns\":%llu,\"cpu_percent\":%.1f,\"acquire_ns\":",
+		dSeconds,
+		(dSeconds > 0.0) ? ullTotal / dSeconds / (1024.0 * 1024.0) : 0.0,
+		(dSeconds > 0.0) ? ullTotal / (ullRate * dSeconds) : 0.0,
+		dJain,
+		(dHeavyMax > 0.0) ? dHeavyMin / dHeavyMax : 0.0,
+		(dLightOffered > 0.0) ? ullLight / dLightOffered : 0.0,
+		(dSeconds > 0.0) ? sStats.ullAcquire / dSeconds : 0.0,
+		sStats.ullStalled, sStats.ullResumed, sStats.ullTicks,
+		(sStats.ullTicks > 0) ? sStats.ullTickNanoSec / sStats.ullTicks : 0ULL, sStats.ullTickMaxNanoSec,
+		dCpu);
+
+	return string("{") + chHead + chResult + BenchSummaryJson(m_Acquire) + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnFlowReady()
+// @Purpose: CRosaBenchRateLimit뷢(кٴͶ, ൱ڷ˲, ֻ)
+// @Since: v1.00a
+// @Para: LPS_ROSAOVERLAPPED pOverlapped(S_RLBENCHFLOW)
+// @Para: DWORD dwBytes(δʹ)
+// @Para: DWORD dwError(δʹ)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaBenchRateLimit::OnFlowReady(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError)
+{
+	LPS_RLBENCHFLOW pFlow = reinterpret_cast<LPS_RLBENCHFLOW>(pOverlapped->pUser);
+	CRosaBenchRateLimit* pBench = pFlow->pBench;
+
+	pFlow->bPosted = false;
+
+	if (pBench->m_lStop || pFlow->bStalled)
+	{
+		return;
+	}
+
+	UINT uiCount = pFlow->bHeavy ? ROSABENCH_RL_BATCH : min(pFlow->uiPending, (UINT)ROSABENCH_RL_BATCH);
+	if (uiCount == 0)
+	{
+		return;
+	}
+
+	UINT uiSizes[ROSABENCH_RL_BATCH];
+	for (UINT i = 0; i < uiCount; ++i)
+	{
+		uiSizes[i] = pBench->m_sConfig.uiSize;
+	}
+
+	LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+	UINT uiGranted = pBench->m_Limiter.CRosaRateLimiterAcquire(pFlow->uiFlow, uiSizes, uiCount, !pFlow->bHeavy && uiCount == pFlow->uiPending);
+	pBench->m_Acquire.CRosaHistogramRecordSince(llStart);
+
+	pFlow->ullBytes += (ULONGLONG)uiGranted * pBench->m_sConfig.uiSize;
+
+	if (!pFlow->bHeavy)
+	{
+		pFlow->uiPending -= uiGranted;
+	}
+
+	if (uiGranted == 0)
+	{
+		pFlow->bStalled = true;
+		return;
+	}
+
+	if (pFlow->bHeavy || pFlow->uiPending > 0)
+	{
+		pBench->PostFlow(pFlow);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnResume()
+// @Purpose: CRosaBenchRateLimitָص(ʱ̼߳Ψһѭ߳)
+// @Since: v1.00a
+// @Para: DWORD_PTR dwUser(S_RLBENCHFLOW)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaBenchRateLimit::OnResume(DWORD_PTR dwUser)
+{
+	LPS_RLBENCHFLOW pFlow = reinterpret_cast<LPS_RLBENCHFLOW>(dwUser);
+
+	pFlow->bStalled = false;
+	pFlow->pBench->PostFlow(pFlow);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnOfferTimer()
+// @Purpose: CRosaBenchRateLimitḺӲϢ(еͶ)
+// @Since: v1.00a
+// @Para: ULONGLONG ullTimerID(ʱID)
+// @Para: void* pUser(Զ)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaBenchRateLimit::OnOfferTimer(ULONGLONG ullTimerID, void * pUser)
+{
+	CRosaBenchRateLimit* pBench = reinterpret_cast<CRosaBenchRateLimit*>(pUser);
+
+	if (pBench->m_lStop)
+	{
+		return;
+	}
+
+	for (vector<S_RLBENCHFLOW>::iterator iter = pBench->m_vecFlow.begin(); iter != pBench->m_vecFlow.end(); ++iter)
+	{
+		if (iter->bHeavy)
+		{
+			continue;
+		}
+
+		iter->dOffer += pBench->m_dLightOffer;
+
+		UINT uiNew = (UINT)iter->dOffer;
+		iter->dOffer -= uiNew;
+		iter->uiPending += uiNew;
+
+		if (uiNew > 0 && !iter->bStalled)
+		{
+			pBench->PostFlow(&(*iter));
+		}
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 PostFlow()
+// @Purpose: CRosaBenchRateLimitͶ(Ͷʱ)
+// @Since: v1.00a
+// @Para: LPS_RLBENCHFLOW pFlow(ģ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchRateLimit::PostFlow(LPS_RLBENCHFLOW pFlow)
+{
+	if (pFlow->bPosted)
+	{
+		return;
+	}
+
+	pFlow->bPosted = true;
+	memset(&pFlow->Ready.Overlapped, 0, sizeof(pFlow->Ready.Overlapped));
+
+	if (!m_Loop.CRosaEventLoopPost(&pFlow->Ready))
+	{
+		pFlow->bPosted = false;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchRateLimitUsage()
+// @Purpose: CRosaBenchRateLimitѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchRateLimit::CRosaBenchRateLimitUsage()
+{
+	fprintf(stderr,
+		"  --rl-flows <list>      simulated connections in one rate-limited group (default: " ROSABENCH_DEFAULT_RL_FLOWS ")\n"
+		"  --rl-heavy <percent>   backlogged connections, the rest offer half their share (default: %d)\n"
+		"  --rl-size <n>          message size (default: %d)\n"
+		"  --rl-rate <MB>         group byte rate in MB/s (default: %d)\n",
+		ROSABENCH_DEFAULT_RL_HEAVY, ROSABENCH_DEFAULT_RL_SIZE, ROSABENCH_DEFAULT_RL_RATE);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchRateLimitParse()
+// @Purpose: CRosaBenchRateLimitѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchRateLimit::CRosaBenchRateLimitParse(const char * pcArg, const char * pcValue)
+{
+	bool bOk = false;
+
+	if (strcmp(pcArg, "--rl-flows") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecRlFlow);
+	}
+	else if (strcmp(pcArg, "--rl-heavy") == 0)
+	{
+		g_uiRlHeavy = strtoul(pcValue, NULL, 10);
+		bOk = (g_uiRlHeavy > 0 && g_uiRlHeavy <= 100);
+	}
+	else if (strcmp(pcArg, "--rl-size") == 0)
+	{
+		g_uiRlSize = strtoul(pcValue, NULL, 10);
+		bOk = (g_uiRlSize > 0);
+	}
+	else if (strcmp(pcArg, "--rl-rate") == 0)
+	{
+		g_uiRlRate = strtoul(pcValue, NULL, 10);
+		bOk = (g_uiRlRate > 0);
+	}
+	else
+	{
+		return ROSABENCH_PARSE_UNKNOWN;
+	}
+
+	return bOk ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchRateLimitMain()
+// @Purpose: CRosaBenchRateLimitȫ(ÿ)
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchRateLimit::CRosaBenchRateLimitMain(const S_BENCHCOMMON & sCommon)
+{
+	if (g_vecRlFlow.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_RL_FLOWS, g_vecRlFlow);
+	}
+
+	CRosaBenchRateLimit BenchRateLimit;
+
+	for (size_t f = 0; f < g_vecRlFlow.size(); ++f)
+	{
+		S_RLBENCHCONFIG sConfig = { g_vecRlFlow[f], g_uiRlHeavy, g_uiRlSize, g_uiRlRate, sCommon.uiSeconds };
+		BenchOutput(BenchRateLimit.CRosaBenchRateLimitRun(sConfig));
+	}
+}
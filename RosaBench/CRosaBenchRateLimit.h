@@ -0,0 +1,91 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchRateLimit.h
+* @brief	This File is RosaBenchRateLimit Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHRATELIMIT_H__
+#define __CROSABENCHRATELIMIT_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Include Rosa Header File
+#include "../Rosa/CRosaEventLoop.h"
+#include "../Rosa/CRosaRateLimiter.h"
+
+//Macro Definition
+#define ROSABENCH_RL_BATCH			32				//ÿϢ(뷢ͶеWSASendͬ)
+#define ROSABENCH_RL_OFFER_MSEC		10				//ḺӲϢ()
+
+#define ROSABENCH_DEFAULT_RL_FLOWS	"100,10K"		//Ĭͬһģ
+#define ROSABENCH_DEFAULT_RL_HEAVY	10				//Ĭϳѹӱ(ٷֱ)
+#define ROSABENCH_DEFAULT_RL_SIZE	1024			//ĬϢ
+#define ROSABENCH_DEFAULT_RL_RATE	100				//Ĭֽ(MB/s)
+
+//Struct Definition
+typedef struct
+{
+	UINT uiFlows;				// 
+	UINT uiHeavyPercent;		// ظӱ(ʼջѹ, ӰƽݶһϢ)
+	UINT uiSize;				// Ϣ
+	UINT uiRateMB;				// ֽ(MB/s)
+	UINT uiSeconds;				// ʱ
+}S_RLBENCHCONFIG, *LPS_RLBENCHCONFIG;
+
+//Class Declaration
+class CRosaBenchRateLimit;
+
+typedef struct
+{
+	S_ROSAOVERLAPPED Ready;		// Լ(ָصģⷢͶ)
+	CRosaBenchRateLimit* pBench;// 
+	UINT uiFlow;				// 
+	bool bHeavy;				// Ƿظ
+	bool bPosted;				// ǷͶ(ֻ¼ѭ߳жд)
+	bool bStalled;				// Ƿȴָص
+	UINT uiPending;				// Ϣ(Ḻ)
+	double dOffer;				// δΪϢĲ(Ḻ)
+	ULONGLONG ullBytes;			// ֽ
+}S_RLBENCHFLOW, *LPS_RLBENCHFLOW;
+
+//Class Definition
+class CRosaBenchRateLimit
+{
+public:
+	CRosaBenchRateLimit();		// CRosaBenchRateLimit 캯
+	~CRosaBenchRateLimit();		// CRosaBenchRateLimit 
+
+public:
+	string CRosaBenchRateLimitRun(const S_RLBENCHCONFIG& sConfig);		// CRosaBenchRateLimit һ(JSON)
+
+	static void CRosaBenchRateLimitUsage();												// CRosaBenchRateLimit ѡ˵
+	static int CRosaBenchRateLimitParse(const char* pcArg, const char* pcValue);			// CRosaBenchRateLimit ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchRateLimitMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchRateLimit ȫ
+
+private:
+	static void __stdcall OnFlowReady(LPS_ROSAOVERLAPPED pOverlapped, DWORD dwBytes, DWORD dwError);	// CRosaBenchRateLimit 뷢(¼ѭ߳)
+	static void __stdcall OnResume(DWORD_PTR dwUser);													// CRosaBenchRateLimit ָص
+	static void __stdcall OnOfferTimer(ULONGLONG ullTimerID, void* pUser);								// CRosaBenchRateLimit ḺӲϢ
+
+	void PostFlow(LPS_RLBENCHFLOW pFlow);								// CRosaBenchRateLimit Ͷ(Ͷʱ)
+
+private:
+	S_RLBENCHCONFIG m_sConfig;					// CRosaBenchRateLimit ǰԲ
+	CRosaEventLoop m_Loop;						// CRosaBenchRateLimit ¼ѭ(߳, ״̬)
+	CRosaRateLimiter m_Limiter;					// CRosaBenchRateLimit 
+	vector<S_RLBENCHFLOW> m_vecFlow;			// CRosaBenchRateLimit ģ
+	double m_dLightOffer;						// CRosaBenchRateLimit ḺÿڲϢ
+	volatile LONG m_lStop;						// CRosaBenchRateLimit ֹͣ־
+	CRosaHistogram m_Acquire;					// CRosaBenchRateLimit ʱ
+
+};
+
+#endif // !__CROSABENCHRATELIMIT_H__
@@ -0,0 +1,417 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchReconnect.cpp
+* @brief	This File is RosaBenchReconnect Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchReconnect.h"
+
+//Include C/C++ Header File
+#include <process.h>
+#include <stdio.h>
+
+//CRosaBenchReconnect ָ(ȫӽֹͣһʱ, ĻָʱֹͣڼĳԴǷʹ)
+
+// ѡ(бʱȡĬֵ)
+static vector<UINT> g_vecReconnectLink;
+static UINT g_uiReconnectOutage = ROSABENCH_DEFAULT_OUTAGE;
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchReconnect()
+// @Purpose: CRosaBenchReconnect캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchReconnect::CRosaBenchReconnect()
+{
+	memset(&m_sConfig, 0, sizeof(m_sConfig));
+
+	InitializeCriticalSection(&m_csBench);
+	m_lConnected = 0;
+	m_bCountAttempts = false;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchReconnect()
+// @Purpose: CRosaBenchReconnect
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchReconnect::~CRosaBenchReconnect()
+{
+	StopServer();
+
+	DeleteCriticalSection(&m_csBench);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchReconnectRun()
+// @Purpose: CRosaBenchReconnectһ
+// @Since: v1.00a
+// @Para: const S_RECONNBENCHCONFIG& sConfig(Բ)
+// @Return: string strJson ()
+//------------------------------------------------------------------
+string CRosaBenchReconnect::CRosaBenchReconnectRun(const S_RECONNBENCHCONFIG & sConfig)
+{
+	char chHead[512] = { 0 };
+
+	m_sConfig = sConfig;
+
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"reconnect\",\"links\":%u,\"outage_ms\":%u,\"backoff_base_ms\":%u,\"backoff_max_ms\":%u",
+		m_sConfig.uiLinks, m_sConfig.uiOutageMSec, ROSA_RECONNECT_BASE_MSEC, ROSA_RECONNECT_MAX_MSEC);
+
+	if (!StartServer())
+	{
+		return string("{") + chHead + ",\"error\":\"listen failed\"}";
+	}
+
+	CRosaEventLoop Loop;
+	CRosaReConnector ReConnector;
+
+	if (!Loop.CRosaEventLoopCreate(1) || !ReConnector.CRosaReConnectorCreate(&Loop, OnLinkState, (DWORD_PTR)this))
+	{
+		Loop.CRosaEventLoopDestroy();
+		StopServer();
+		return string("{") + chHead + ",\"error\":\"event loop\"}";
+	}
+
+	// ӱ֮ǰ, ״̬صֻҲ
+	vector<CRosaSocket*> vecSocket(m_sConfig.uiLinks);
+	m_lConnected = 0;
+	m_bCountAttempts = false;
+
+	EnterCriticalSection(&m_csBench);
+	m_mapLink.clear();
+	for (UINT i = 0; i < m_sConfig.uiLinks; ++i)
+	{
+		vecSocket[i] = new CRosaSocket();
+
+		S_RECONNBENCHLINK sLink = { 0, false, 0, 0 };
+		m_mapLink[vecSocket[i]] = sLink;
+	}
+	LeaveCriticalSection(&m_csBench);
+
+	for (UINT i = 0; i < m_sConfig.uiLinks; ++i)
+	{
+		ULONGLONG ullLinkID = ReConnector.CRosaReConnectorAdd(vecSocket[i], "127.0.0.1", m_sConfig.sPort);
+
+		EnterCriticalSection(&m_csBench);
+		m_mapLink[vecSocket[i]].ullLinkID = ullLinkID;
+		LeaveCriticalSection(&m_csBench);
+	}
+
+	string strResult;
+
+	if (!WaitConnected(ROSABENCH_RECONNECT_WAIT_MAX))
+	{
+		strResult = string("{") + chHead + ",\"error\":\"initial connect timed out\"}";
+	}
+	else
+	{
+		// ֹͣ, ӦñϿ(շSOB_RET_CLOSEʱͬ), ֮дл
+		StopServer();
+
+		// ӱ, ָȴϿصʱ
+		EnterCriticalSection(&m_csBench);
+		for (map<CRosaSocket*, S_RECONNBENCHLINK>::iterator iter = m_mapLink.begin(); iter != m_mapLink.end(); ++iter)
+		{
+			iter->second.bConnected = false;
+		}
+		m_lConnected = 0;
+		m_bCountAttempts = true;
+		LeaveCriticalSection(&m_csBench);
+
+		char chMessage[ROSABENCH_RECONNECT_MESSAGE];
+		memset(chMessage, 'R', sizeof(chMessage));
+
+		ULONGLONG ullQueued = 0;
+
+		for (UINT i = 0; i < m_sConfig.uiLinks; ++i)
+		{
+			ULONGLONG ullLinkID = m_mapLink[vecSocket[i]].ullLinkID;
+
+			ReConnector.CRosaReConnectorReportBroken(ullLinkID);
+
+			if (ReConnector.CRosaReConnectorSend(ullLinkID, chMessage, sizeof(chMessage)) == SOB_RET_OK)
+			{
+				ullQueued += sizeof(chMessage);
+			}
+		}
+
+		Sleep(m_sConfig.uiOutageMSec);
+
+		// ¼, ָʱӴ˿̼
+		LONGLONG llRestart = CRosaHistogram::CRosaHistogramNow();
+		bool bServer = StartServer();
+		bool bRecovered = bServer && WaitConnected(ROSABENCH_RECONNECT_WAIT_MAX);
+
+		Sleep(ROSABENCH_RECONNECT_SETTLE);
+		ULONGLONG ullDelivered = PendingBytes();
+
+		// 
+		CRosaHistogram Recover;
+		Recover.CRosaHistogramCreate(1);
+
+		UINT uiRecovered = 0;
+		UINT uiAttemptMax = 0;
+		ULONGLONG ullAttempts = 0;
+
+		EnterCriticalSection(&m_csBench);
+		m_bCountAttempts = false;
+
+		for (map<CRosaSocket*, S_RECONNBENCHLINK>::iterator iter = m_mapLink.begin(); iter != m_mapLink.end(); ++iter)
+		{
+			ullAttempts += iter->second.uiAttempts;
+			uiAttemptMax = max(uiAttemptMax, iter->second.uiAttempts);
+
+			if (iter->second.bConnected && iter->second.llConnected >= llRestart)
+			{
+				Recover.CRosaHistogramRecord(CRosaHistogram::CRosaHistogramToNanoSec(iter->second.llConnected - llRestart));
+				uiRecovered++;
+			}
+		}
+
+		LeaveCriticalSection(&m_csBench);
+
+		char chResult[512] = { 0 };
+		sprintf_s(chResult, sizeof(chResult), ",\"recovered\":%u,\"all_recovered\":%s,\"attempts_mean\":%.2f,\"attempts_max\":%u,\"queued_bytes\":%llu,\"delivered_bytes\":%llu,\"recover_ns\":",
+			uiRecovered, bRecovered ? "true" : "false",
+			(m_sConfig.uiLinks > 0) ? (double)ullAttempts / m_sConfig.uiLinks : 0.0, uiAttemptMax, ullQueued, ullDelivered);
+
+		strResult = string("{") + chHead + chResult + BenchSummaryJson(Recover) + "}";
+	}
+
+	ReConnector.CRosaReConnectorDestroy();
+	Loop.CRosaEventLoopDestroy();
+	StopServer();
+
+	for (UINT i = 0; i < m_sConfig.uiLinks; ++i)
+	{
+		delete vecSocket[i];
+	}
+
+	EnterCriticalSection(&m_csBench);
+	m_mapLink.clear();
+	LeaveCriticalSection(&m_csBench);
+
+	return strResult;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAccept()
+// @Purpose: CRosaBenchReconnect(ֹͣ, ȡ)
+// @Since: v1.00a
+// @Para: void* pContext(Զ)
+// @Para: SOCKET s(ͻ׽)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchReconnect::OnAccept(void * pContext, SOCKET s, USHORT nShard)
+{
+	CRosaBenchReconnect* pBench = reinterpret_cast<CRosaBenchReconnect*>(pContext);
+
+	EnterCriticalSection(&pBench->m_csBench);
+	pBench->m_vecAccepted.push_back(s);
+	LeaveCriticalSection(&pBench->m_csBench);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnLinkState()
+// @Purpose: CRosaBenchReconnect״̬仯(¼״̬ʱ估ֹ֮ͣĳԴ)
+// @Since: v1.00a
+// @Para: CRosaSocket* pSocket(ͻ׽)
+// @Para: int nNewState(״̬)
+// @Para: DWORD_PTR dwUser(Զ)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaBenchReconnect::OnLinkState(ULONGLONG ullLinkID, CRosaSocket * pSocket, int nOldState, int nNewState, DWORD_PTR dwUser)
+{
+	CRosaBenchReconnect* pBench = reinterpret_cast<CRosaBenchReconnect*>(dwUser);
+	LONGLONG llNow = CRosaHistogram::CRosaHistogramNow();
+
+	EnterCriticalSection(&pBench->m_csBench);
+
+	map<CRosaSocket*, S_RECONNBENCHLINK>::iterator iter = pBench->m_mapLink.find(pSocket);
+	if (iter == pBench->m_mapLink.end())
+	{
+		LeaveCriticalSection(&pBench->m_csBench);
+		return;
+	}
+
+	if (nNewState == ROSA_LINK_STATE_CONNECTING && pBench->m_bCountAttempts)
+	{
+		iter->second.uiAttempts++;
+	}
+
+	if (nNewState == ROSA_LINK_STATE_CONNECTED && !iter->second.bConnected)
+	{
+		iter->second.bConnected = true;
+		iter->second.llConnected = llNow;
+		InterlockedIncrement(&pBench->m_lConnected);
+	}
+	else if (nNewState != ROSA_LINK_STATE_CONNECTED && iter->second.bConnected)
+	{
+		iter->second.bConnected = false;
+		InterlockedDecrement(&pBench->m_lConnected);
+	}
+
+	LeaveCriticalSection(&pBench->m_csBench);
+}
+
+//------------------------------------------------------------------
+// @Function:	 StartServer()
+// @Purpose: CRosaBenchReconnectʼ
+// @Since: v1.00a
+// @Para: None
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool CRosaBenchReconnect::StartServer()
+{
+	return m_Server.CRosaBenchServerStart(m_sConfig.sPort, OnAccept, this);
+}
+
+//------------------------------------------------------------------
+// @Function:	 StopServer()
+// @Purpose: CRosaBenchReconnectֹͣرѽܵ(˿ڿ°)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchReconnect::StopServer()
+{
+	m_Server.CRosaBenchServerStop();
+
+	EnterCriticalSection(&m_csBench);
+
+	for (vector<SOCKET>::iterator iter = m_vecAccepted.begin(); iter != m_vecAccepted.end(); ++iter)
+	{
+		LINGER sLinger = { 1, 0 };
+		setsockopt(*iter, SOL_SOCKET, SO_LINGER, (char*)&sLinger, sizeof(sLinger));
+		closesocket(*iter);
+	}
+	m_vecAccepted.clear();
+
+	LeaveCriticalSection(&m_csBench);
+}
+
+//------------------------------------------------------------------
+// @Function:	 WaitConnected()
+// @Purpose: CRosaBenchReconnectȴȫӴ״̬
+// @Since: v1.00a
+// @Para: DWORD dwTimeOutMSec(ȴʱ)
+// @Return: bool bRet (true:ȫ, false:ʱ)
+//------------------------------------------------------------------
+bool CRosaBenchReconnect::WaitConnected(DWORD dwTimeOutMSec)
+{
+	for (DWORD dwWait = 0; dwWait < dwTimeOutMSec; dwWait += 10)
+	{
+		if ((UINT)m_lConnected >= m_sConfig.uiLinks)
+		{
+			return true;
+		}
+
+		Sleep(10);
+	}
+
+	return ((UINT)m_lConnected >= m_sConfig.uiLinks);
+}
+
+//------------------------------------------------------------------
+// @Function:	 PendingBytes()
+// @Purpose: CRosaBenchReconnectѽϵȴȡֽ(˲ȡ, ָʹĻ)
+// @Since: v1.00a
+// @Para: None
+// @Return: ULONGLONG ullBytes
+//------------------------------------------------------------------
+ULONGLONG CRosaBenchReconnect::PendingBytes()
+{
+	ULONGLONG ullBytes = 0;
+
+	EnterCriticalSection(&m_csBench);
+
+	for (vector<SOCKET>::iterator iter = m_vecAccepted.begin(); iter != m_vecAccepted.end(); ++iter)
+	{
+		u_long ulPending = 0;
+		if (ioctlsocket(*iter, FIONREAD, &ulPending) == 0)
+		{
+			ullBytes += ulPending;
+		}
+	}
+
+	LeaveCriticalSection(&m_csBench);
+
+	return ullBytes;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchReconnectUsage()
+// @Purpose: CRosaBenchReconnectѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchReconnect::CRosaBenchReconnectUsage()
+{
+	fprintf(stderr,
+		"  --reconnect-links <list> links kept by the reconnect manager across a server outage (default: " ROSABENCH_DEFAULT_RECONNECT_LINKS ")\n"
+		"  --reconnect-outage <ms> server outage length (default: %d)\n",
+		ROSABENCH_DEFAULT_OUTAGE);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchReconnectParse()
+// @Purpose: CRosaBenchReconnectѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchReconnect::CRosaBenchReconnectParse(const char * pcArg, const char * pcValue)
+{
+	bool bOk = false;
+
+	if (strcmp(pcArg, "--reconnect-links") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecReconnectLink);
+	}
+	else if (strcmp(pcArg, "--reconnect-outage") == 0)
+	{
+		g_uiReconnectOutage = strtoul(pcValue, NULL, 10);
+		bOk = true;
+	}
+	else
+	{
+		return ROSABENCH_PARSE_UNKNOWN;
+	}
+
+	return bOk ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchReconnectMain()
+// @Purpose: CRosaBenchReconnectȫ(ÿ)
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchReconnect::CRosaBenchReconnectMain(const S_BENCHCOMMON & sCommon)
+{
+	if (g_vecReconnectLink.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_RECONNECT_LINKS, g_vecReconnectLink);
+	}
+
+	CRosaBenchReconnect BenchReconnect;
+
+	for (size_t l = 0; l < g_vecReconnectLink.size(); ++l)
+	{
+		S_RECONNBENCHCONFIG sConfig = { g_vecReconnectLink[l], g_uiReconnectOutage, sCommon.sPort };
+		BenchOutput(BenchReconnect.CRosaBenchReconnectRun(sConfig));
+	}
+}
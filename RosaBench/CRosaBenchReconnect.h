@@ -0,0 +1,86 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchReconnect.h
+* @brief	This File is RosaBenchReconnect Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHRECONNECT_H__
+#define __CROSABENCHRECONNECT_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Include Rosa Header File
+#include "../Rosa/CRosaEventLoop.h"
+#include "../Rosa/CRosaReConnector.h"
+
+//Include C/C++ Header File
+#include <map>
+
+//Macro Definition
+#define ROSABENCH_RECONNECT_MESSAGE		64				//ڼÿдϢ(ָӦȫʹ)
+#define ROSABENCH_RECONNECT_WAIT_MAX	15000			//ȴȫӽ/ָʱ()
+#define ROSABENCH_RECONNECT_SETTLE		200				//ָȴʹʱ()
+
+#define ROSABENCH_DEFAULT_RECONNECT_LINKS	"10,100"	//Ĭ
+#define ROSABENCH_DEFAULT_OUTAGE			1000		//ĬϷֹͣʱ()
+
+//Struct Definition
+typedef struct
+{
+	UINT uiLinks;				// 
+	UINT uiOutageMSec;			// ֹͣʱ()
+	USHORT sPort;				// ˿
+}S_RECONNBENCHCONFIG, *LPS_RECONNBENCHCONFIG;
+
+typedef struct
+{
+	ULONGLONG ullLinkID;		// ID
+	bool bConnected;			// Ƿ״̬
+	LONGLONG llConnected;		// һν״̬ܼ
+	UINT uiAttempts;			// ֹ֮ͣӳԴ
+}S_RECONNBENCHLINK, *LPS_RECONNBENCHLINK;
+
+//Class Definition
+class CRosaBenchReconnect
+{
+public:
+	CRosaBenchReconnect();		// CRosaBenchReconnect 캯
+	~CRosaBenchReconnect();		// CRosaBenchReconnect 
+
+public:
+	string CRosaBenchReconnectRun(const S_RECONNBENCHCONFIG& sConfig);	// CRosaBenchReconnect һ(JSON)
+
+	static void CRosaBenchReconnectUsage();												// CRosaBenchReconnect ѡ˵
+	static int CRosaBenchReconnectParse(const char* pcArg, const char* pcValue);			// CRosaBenchReconnect ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchReconnectMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchReconnect ȫ
+
+private:
+	static void OnAccept(void* pContext, SOCKET s, USHORT nShard);							// CRosaBenchReconnect (ֹͣ)
+	static void __stdcall OnLinkState(ULONGLONG ullLinkID, CRosaSocket* pSocket, int nOldState, int nNewState, DWORD_PTR dwUser);	// CRosaBenchReconnect ״̬仯
+
+	bool StartServer();											// CRosaBenchReconnect ʼ
+	void StopServer();											// CRosaBenchReconnect ֹͣرѽܵ
+	bool WaitConnected(DWORD dwTimeOutMSec);					// CRosaBenchReconnect ȴȫӴ״̬
+	ULONGLONG PendingBytes();									// CRosaBenchReconnect ѽϵȴȡֽ
+
+private:
+	S_RECONNBENCHCONFIG m_sConfig;				// CRosaBenchReconnect ǰԲ
+	CRosaBenchServer m_Server;					// CRosaBenchReconnect (ֹͣʱرռ׽)
+
+	CRITICAL_SECTION m_csBench;					// CRosaBenchReconnect Ӽѽ׽ٽ
+	vector<SOCKET> m_vecAccepted;				// CRosaBenchReconnect ѽܵ
+	map<CRosaSocket*, S_RECONNBENCHLINK> m_mapLink;	// CRosaBenchReconnect ͻ(״̬صֻṩCRosaSocket)
+	volatile LONG m_lConnected;					// CRosaBenchReconnect ״̬
+	bool m_bCountAttempts;						// CRosaBenchReconnect Ƿͳӳ(ֹ֮ͣ)
+
+};
+
+#endif // !__CROSABENCHRECONNECT_H__
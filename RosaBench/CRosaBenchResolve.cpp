@@ -0,0 +1,305 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchResolve.cpp
+* @brief	This File is RosaBenchResolve Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchResolve.h"
+
+//Include C/C++ Header File
+#include <process.h>
+#include <stdio.h>
+
+//CRosaBenchResolve ƽ(hostsļеƴDNS, ȽֱgetaddrinfoδСмʧܻĲѯʱ)
+
+// ѡ(бʱȡĬֵ)
+static vector<UINT> g_vecResolveThread;
+
+// ʽ
+static const char* g_pcResolveModeName[ROSABENCH_RESOLVE_COUNT] = { "getaddrinfo", "miss", "hit", "negative" };
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchResolve()
+// @Purpose: CRosaBenchResolve캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchResolve::CRosaBenchResolve()
+{
+	memset(&m_sConfig, 0, sizeof(m_sConfig));
+	m_hStartEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+
+	m_Latency.CRosaHistogramCreate();
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchResolve()
+// @Purpose: CRosaBenchResolve
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchResolve::~CRosaBenchResolve()
+{
+	m_Resolver.CRosaResolverDestroy();
+
+	if (m_hStartEvent)
+	{
+		CloseHandle(m_hStartEvent);
+		m_hStartEvent = NULL;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchResolveRun()
+// @Purpose: CRosaBenchResolveһ(мʧܷʽڼʱ֮ǰԤȻ)
+// @Since: v1.00a
+// @Para: const S_RESOLVEBENCHCONFIG& sConfig(Բ)
+// @Return: string strJson ()
+//------------------------------------------------------------------
+string CRosaBenchResolve::CRosaBenchResolveRun(const S_RESOLVEBENCHCONFIG & sConfig)
+{
+	char chHead[512] = { 0 };
+
+	m_sConfig = sConfig;
+	m_sConfig.uiThreads = (m_sConfig.uiThreads < 1) ? 1 : m_sConfig.uiThreads;
+
+	const char* pcHost = (m_sConfig.nMode == ROSABENCH_RESOLVE_NEGATIVE) ? ROSABENCH_RESOLVE_BAD_HOST : ROSABENCH_RESOLVE_HOST;
+
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"resolve\",\"mode\":\"%s\",\"host\":\"%s\",\"threads\":%u",
+		CRosaBenchResolveGetModeName(m_sConfig.nMode), pcHost, m_sConfig.uiThreads);
+
+	if (m_Resolver.CRosaResolverGetThreadCount() == 0 && !m_Resolver.CRosaResolverCreate(1, ROSABENCH_RESOLVE_TTL, ROSABENCH_RESOLVE_TTL))
+	{
+		return string("{") + chHead + ",\"error\":\"resolver\"}";
+	}
+
+	// Ԥ: зʽҪɹ, ʧܷʽҪѻʧ
+	m_Resolver.CRosaResolverFlush();
+
+	vector<SOCKADDR_STORAGE> vecAddress;
+	int nWarm = m_Resolver.CRosaResolverResolve(pcHost, vecAddress);
+
+	if (m_sConfig.nMode == ROSABENCH_RESOLVE_HIT && nWarm != SOB_RET_OK)
+	{
+		return string("{") + chHead + ",\"error\":\"host not resolvable\"}";
+	}
+
+	if (m_sConfig.nMode == ROSABENCH_RESOLVE_NEGATIVE && nWarm == SOB_RET_OK)
+	{
+		return string("{") + chHead + ",\"error\":\"invalid host resolved\"}";
+	}
+
+	// ѯ߳
+	vector<S_RESOLVEBENCHCLIENT> vecClient(m_sConfig.uiThreads);
+	vector<HANDLE> vecThread;
+
+	for (UINT i = 0; i < m_sConfig.uiThreads; ++i)
+	{
+		memset(&vecClient[i], 0, sizeof(S_RESOLVEBENCHCLIENT));
+		vecClient[i].pBench = this;
+
+		HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, OnClientThread, &vecClient[i], 0, NULL);
+		if (hThread)
+		{
+			vecThread.push_back(hThread);
+		}
+	}
+
+	m_Latency.CRosaHistogramReset();
+
+	S_BENCHCPU sCpu;
+	BenchCpuStart(sCpu);
+	SetEvent(m_hStartEvent);
+
+	for (size_t i = 0; i < vecThread.size(); ++i)
+	{
+		WaitForSingleObject(vecThread[i], INFINITE);
+		CloseHandle(vecThread[i]);
+	}
+
+	double dSeconds = 0.0;
+	double dCpu = BenchCpuStop(sCpu, dSeconds);
+	ResetEvent(m_hStartEvent);
+
+	// 
+	ULONGLONG ullLookups = 0;
+	ULONGLONG ullErrors = 0;
+
+	for (UINT i = 0; i < m_sConfig.uiThreads; ++i)
+	{
+		ullLookups += vecClient[i].ullLookups;
+		ullErrors += vecClient[i].ullErrors;
+	}
+
+	char chResult[512] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"seconds\":%.3f,\"lookups\":%llu,\"errors\":%llu,\"lookups_per_sec\":%.1f,\"cache_entries\":%d,\"cpu_percent\":%.1f,\"lookup_ns\":",
+		dSeconds, ullLookups, ullErrors, (dSeconds > 0.0) ? ullLookups / dSeconds : 0.0, m_Resolver.CRosaResolverGetEntryCount(), dCpu);
+
+	return string("{") + chHead + chResult + BenchSummaryJson(m_Latency) + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchResolveGetModeName()
+// @Purpose: CRosaBenchResolveȡԷʽ
+// @Since: v1.00a
+// @Para: int nMode(ROSABENCH_RESOLVE_*)
+// @Return: const char* pcName
+//------------------------------------------------------------------
+const char * CRosaBenchResolve::CRosaBenchResolveGetModeName(int nMode)
+{
+	if (nMode < 0 || nMode >= ROSABENCH_RESOLVE_COUNT)
+	{
+		return "";
+	}
+
+	return g_pcResolveModeName[nMode];
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnClientThread()
+// @Purpose: CRosaBenchResolveѯ߳
+// @Since: v1.00a
+// @Para: void* pParam(S_RESOLVEBENCHCLIENT)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchResolve::OnClientThread(void * pParam)
+{
+	LPS_RESOLVEBENCHCLIENT pClient = reinterpret_cast<LPS_RESOLVEBENCHCLIENT>(pParam);
+	CRosaBenchResolve* pBench = pClient->pBench;
+
+	WaitForSingleObject(pBench->m_hStartEvent, INFINITE);
+
+	LARGE_INTEGER liFrequency;
+	QueryPerformanceFrequency(&liFrequency);
+
+	LONGLONG llDeadline = CRosaHistogram::CRosaHistogramNow() + liFrequency.QuadPart * pBench->m_sConfig.uiSeconds;
+
+	while (CRosaHistogram::CRosaHistogramNow() < llDeadline)
+	{
+		LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+
+		if (pBench->LookupOnce())
+		{
+			pBench->m_Latency.CRosaHistogramRecordSince(llStart);
+			pClient->ullLookups++;
+		}
+		else
+		{
+			pClient->ullErrors++;
+		}
+	}
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 LookupOnce()
+// @Purpose: CRosaBenchResolveǰʽѯһ
+// @Since: v1.00a
+// @Para: None
+// @Return: bool bRet (true:õԤڽ, false:)
+//------------------------------------------------------------------
+bool CRosaBenchResolve::LookupOnce()
+{
+	vector<SOCKADDR_STORAGE> vecAddress;
+
+	switch (m_sConfig.nMode)
+	{
+	case ROSABENCH_RESOLVE_GETADDRINFO:
+	{
+		ADDRINFOA sHints;
+		memset(&sHints, 0, sizeof(sHints));
+		sHints.ai_family = AF_UNSPEC;
+		sHints.ai_socktype = SOCK_STREAM;
+
+		ADDRINFOA* pResult = NULL;
+		if (getaddrinfo(ROSABENCH_RESOLVE_HOST, NULL, &sHints, &pResult) != 0)
+		{
+			return false;
+		}
+
+		freeaddrinfo(pResult);
+		return true;
+	}
+	case ROSABENCH_RESOLVE_MISS:
+		// ߳ͬʱʱڽĿ, ͬȴͬһν
+		m_Resolver.CRosaResolverFlush();
+		return (m_Resolver.CRosaResolverResolve(ROSABENCH_RESOLVE_HOST, vecAddress) == SOB_RET_OK);
+	case ROSABENCH_RESOLVE_HIT:
+		return (m_Resolver.CRosaResolverLookup(ROSABENCH_RESOLVE_HOST, vecAddress) == SOB_RET_OK && !vecAddress.empty());
+	case ROSABENCH_RESOLVE_NEGATIVE:
+		return (m_Resolver.CRosaResolverLookup(ROSABENCH_RESOLVE_BAD_HOST, vecAddress) == SOB_RET_FAIL);
+	default:
+		return false;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchResolveUsage()
+// @Purpose: CRosaBenchResolveѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchResolve::CRosaBenchResolveUsage()
+{
+	fprintf(stderr,
+		"  --resolve-threads <list> threads looking up a hosts-file name (default: " ROSABENCH_DEFAULT_RESOLVE_THREADS ")\n");
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchResolveParse()
+// @Purpose: CRosaBenchResolveѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchResolve::CRosaBenchResolveParse(const char * pcArg, const char * pcValue)
+{
+	bool bOk = false;
+
+	if (strcmp(pcArg, "--resolve-threads") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecResolveThread);
+	}
+	else
+	{
+		return ROSABENCH_PARSE_UNKNOWN;
+	}
+
+	return bOk ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchResolveMain()
+// @Purpose: CRosaBenchResolveȫ(ѯʽ*߳)
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchResolve::CRosaBenchResolveMain(const S_BENCHCOMMON & sCommon)
+{
+	if (g_vecResolveThread.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_RESOLVE_THREADS, g_vecResolveThread);
+	}
+
+	CRosaBenchResolve BenchResolve;
+
+	for (int m = 0; m < ROSABENCH_RESOLVE_COUNT; ++m)
+	{
+		for (size_t t = 0; t < g_vecResolveThread.size(); ++t)
+		{
+			S_RESOLVEBENCHCONFIG sConfig = { m, g_vecResolveThread[t], sCommon.uiSeconds };
+			BenchOutput(BenchResolve.CRosaBenchResolveRun(sConfig));
+		}
+	}
+}
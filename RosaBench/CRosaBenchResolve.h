@@ -0,0 +1,83 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchResolve.h
+* @brief	This File is RosaBenchResolve Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHRESOLVE_H__
+#define __CROSABENCHRESOLVE_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Include Rosa Header File
+#include "../Rosa/CRosaResolver.h"
+
+//Macro Definition
+#define ROSABENCH_RESOLVE_GETADDRINFO	0				//ÿֱӵgetaddrinfo(ԭResolveAddressToIp)
+#define ROSABENCH_RESOLVE_MISS			1				//ջͬ(߳ʱͬϲΪһν)
+#define ROSABENCH_RESOLVE_HIT			2				//еķѯ
+#define ROSABENCH_RESOLVE_NEGATIVE		3				//ѻĽʧ(ٲѯDNS)
+#define ROSABENCH_RESOLVE_COUNT			4
+
+#define ROSABENCH_RESOLVE_HOST			"localhost"			//hostsļ(ⲿDNS)
+#define ROSABENCH_RESOLVE_BAD_HOST		"rosabench.invalid"	//, ضʧ
+#define ROSABENCH_RESOLVE_TTL			3600000				//Խĳɹʧܻʱ(, ڼ䲻)
+
+#define ROSABENCH_DEFAULT_RESOLVE_THREADS	"1,4"		//Ĭϲѯ߳
+
+//Struct Definition
+typedef struct
+{
+	int nMode;					// Էʽ(ROSABENCH_RESOLVE_*)
+	UINT uiThreads;				// ѯ߳
+	UINT uiSeconds;				// ʱ
+}S_RESOLVEBENCHCONFIG, *LPS_RESOLVEBENCHCONFIG;
+
+//Class Declaration
+class CRosaBenchResolve;
+
+typedef struct
+{
+	CRosaBenchResolve* pBench;	// 
+	ULONGLONG ullLookups;		// õԤڽĲѯ
+	ULONGLONG ullErrors;		// ԤڲĴ
+}S_RESOLVEBENCHCLIENT, *LPS_RESOLVEBENCHCLIENT;
+
+//Class Definition
+class CRosaBenchResolve
+{
+public:
+	CRosaBenchResolve();		// CRosaBenchResolve 캯
+	~CRosaBenchResolve();		// CRosaBenchResolve 
+
+public:
+	string CRosaBenchResolveRun(const S_RESOLVEBENCHCONFIG& sConfig);	// CRosaBenchResolve һ(JSON)
+
+	static const char* CRosaBenchResolveGetModeName(int nMode);		// CRosaBenchResolve ȡԷʽ
+
+	static void CRosaBenchResolveUsage();												// CRosaBenchResolve ѡ˵
+	static int CRosaBenchResolveParse(const char* pcArg, const char* pcValue);			// CRosaBenchResolve ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchResolveMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchResolve ȫ
+
+private:
+	static unsigned __stdcall OnClientThread(void* pParam);			// CRosaBenchResolve ѯ߳
+
+	bool LookupOnce();												// CRosaBenchResolve ǰʽѯһ(ǷõԤڽ)
+
+private:
+	S_RESOLVEBENCHCONFIG m_sConfig;				// CRosaBenchResolve ǰԲ
+	CRosaResolver m_Resolver;					// CRosaBenchResolve (ʹýĬϽ, 滥Ӱ)
+	HANDLE m_hStartEvent;						// CRosaBenchResolve ѯ߳ͬʱʼ
+	CRosaHistogram m_Latency;					// CRosaBenchResolve ѯʱ
+
+};
+
+#endif // !__CROSABENCHRESOLVE_H__
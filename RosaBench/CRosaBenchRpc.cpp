@@ -0,0 +1,340 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchRpc.cpp
+* @brief	This File is RosaBenchRpc Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchRpc.h"
+
+//Include C/C++ Header File
+#include <stdio.h>
+
+//CRosaBenchRpc RPCػ(һ, ͻ˱̶ֹ;, ڽ߳л)
+
+// ѡ(бʱȡĬֵ)
+static vector<UINT> g_vecRpcDepth;
+static UINT g_uiRpcSize = ROSABENCH_DEFAULT_RPC_SIZE;
+
+// Ӧصû;λ, Զָ̬ͨ봫
+static CRosaBenchRpc* g_pBenchRpc = NULL;
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchRpc()
+// @Purpose: CRosaBenchRpc캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchRpc::CRosaBenchRpc()
+{
+	memset(&m_sConfig, 0, sizeof(m_sConfig));
+	m_lStop = 0;
+	m_lInFlight = 0;
+	m_llCompleted = 0;
+	m_llErrors = 0;
+
+	m_Latency.CRosaHistogramCreate();
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchRpc()
+// @Purpose: CRosaBenchRpc
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchRpc::~CRosaBenchRpc()
+{
+	m_Client.CRosaRpcDestroy();
+	m_Server.CRosaRpcDestroy();
+	m_Loop.CRosaEventLoopDestroy();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchRpcRun()
+// @Purpose: CRosaBenchRpcһ
+// @Since: v1.00a
+// @Para: const S_RPCBENCHCONFIG& sConfig(Բ)
+// @Return: string strJson (, ʧʱԭ)
+//------------------------------------------------------------------
+string CRosaBenchRpc::CRosaBenchRpcRun(const S_RPCBENCHCONFIG & sConfig)
+{
+	char chHead[256] = { 0 };
+
+	m_sConfig = sConfig;
+
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"rpc\",\"depth\":%u,\"size\":%u", m_sConfig.uiDepth, m_sConfig.uiSize);
+
+	SOCKET sClient = INVALID_SOCKET;
+	SOCKET sServer = INVALID_SOCKET;
+
+	if (!m_Loop.CRosaEventLoopCreate(ROSABENCH_RPC_LOOP_THREADS))
+	{
+		return string("{") + chHead + ",\"error\":\"event loop create failed\"}";
+	}
+
+	if (!Connect(sClient, sServer))
+	{
+		m_Loop.CRosaEventLoopDestroy();
+		return string("{") + chHead + ",\"error\":\"loopback connect failed\"}";
+	}
+
+	if (!m_Server.CRosaRpcCreate(sServer, &m_Loop, OnServerRequest, NULL, (DWORD_PTR)this) ||
+		!m_Client.CRosaRpcCreate(sClient, &m_Loop, NULL, NULL, (DWORD_PTR)this))
+	{
+		m_Server.CRosaRpcDestroy();
+		closesocket(sClient);
+		closesocket(sServer);
+		m_Loop.CRosaEventLoopDestroy();
+		return string("{") + chHead + ",\"error\":\"rpc create failed\"}";
+	}
+
+	g_pBenchRpc = this;
+	m_vecRequest.assign(m_sConfig.uiSize, 'R');
+	m_vecStart.assign(m_sConfig.uiDepth, 0);
+	m_lStop = 0;
+	m_lInFlight = 0;
+	m_llCompleted = 0;
+	m_llErrors = 0;
+	m_Latency.CRosaHistogramReset();
+
+	S_BENCHCPU sCpu;
+	BenchCpuStart(sCpu);
+
+	for (UINT i = 0; i < m_sConfig.uiDepth; ++i)
+	{
+		Issue(i);
+	}
+
+	Sleep(m_sConfig.uiSeconds * 1000);
+
+	InterlockedExchange(&m_lStop, 1);
+
+	double dSeconds = 0.0;
+	double dCpu = BenchCpuStop(sCpu, dSeconds);
+	LONGLONG llCompleted = m_llCompleted;
+	LONGLONG llErrors = m_llErrors;
+
+	// ȴ;, ֮ʱʣûصCLOSED
+	ULONGLONG ullDrainEnd = CRosaEventLoop::CRosaEventLoopGetTickMSec() + ROSABENCH_RPC_DRAIN_MSEC;
+	while (m_lInFlight != 0 && CRosaEventLoop::CRosaEventLoopGetTickMSec() < ullDrainEnd)
+	{
+		Sleep(1);
+	}
+
+	m_Client.CRosaRpcDestroy();
+	m_Server.CRosaRpcDestroy();
+	closesocket(sClient);
+	closesocket(sServer);
+	m_Loop.CRosaEventLoopDestroy();
+
+	char chResult[512] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"seconds\":%.3f,\"calls\":%lld,\"errors\":%lld,\"rpc_per_sec\":%.1f,\"cpu_percent\":%.1f,\"latency_ns\":",
+		dSeconds, llCompleted, llErrors, (dSeconds > 0.0) ? llCompleted / dSeconds : 0.0, dCpu);
+
+	return string("{") + chHead + chResult + BenchSummaryJson(m_Latency) + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 Connect()
+// @Purpose: CRosaBenchRpcػ(ʱ˿, ǰTIME_WAITӰ; ˾Ϊص׽, Nagle)
+// @Since: v1.00a
+// @Para: SOCKET& sClient(ͻ׽)
+// @Para: SOCKET& sServer(׽)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool CRosaBenchRpc::Connect(SOCKET & sClient, SOCKET & sServer)
+{
+	SOCKADDR_IN sAddr;
+	memset(&sAddr, 0, sizeof(sAddr));
+	sAddr.sin_family = AF_INET;
+	sAddr.sin_port = 0;
+	sAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	SOCKET sListen = WSASocket(AF_INET, SOCK_STREAM, IPPROTO_TCP, NULL, 0, WSA_FLAG_OVERLAPPED);
+	if (sListen == INVALID_SOCKET)
+	{
+		return false;
+	}
+
+	sClient = WSASocket(AF_INET, SOCK_STREAM, IPPROTO_TCP, NULL, 0, WSA_FLAG_OVERLAPPED);
+
+	int nAddrLen = sizeof(sAddr);
+
+	if (sClient == INVALID_SOCKET ||
+		bind(sListen, (SOCKADDR*)&sAddr, sizeof(sAddr)) == SOCKET_ERROR ||
+		listen(sListen, 1) == SOCKET_ERROR ||
+		getsockname(sListen, (SOCKADDR*)&sAddr, &nAddrLen) == SOCKET_ERROR ||
+		connect(sClient, (SOCKADDR*)&sAddr, sizeof(sAddr)) == SOCKET_ERROR)
+	{
+		if (sClient != INVALID_SOCKET)
+		{
+			closesocket(sClient);
+			sClient = INVALID_SOCKET;
+		}
+		closesocket(sListen);
+		return false;
+	}
+
+	// ܵ׽ּ̳м׽ֵص
+	sServer = accept(sListen, NULL, NULL);
+	closesocket(sListen);
+
+	if (sServer == INVALID_SOCKET)
+	{
+		closesocket(sClient);
+		sClient = INVALID_SOCKET;
+		return false;
+	}
+
+	BOOL bNoDelay = TRUE;
+	setsockopt(sClient, IPPROTO_TCP, TCP_NODELAY, (const char*)&bNoDelay, sizeof(bNoDelay));
+	setsockopt(sServer, IPPROTO_TCP, TCP_NODELAY, (const char*)&bNoDelay, sizeof(bNoDelay));
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 Issue()
+// @Purpose: CRosaBenchRpcһ;λϷ(λúΪû, 32λҲض)
+// @Since: v1.00a
+// @Para: UINT uiSlot(;λ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchRpc::Issue(UINT uiSlot)
+{
+	InterlockedIncrement(&m_lInFlight);
+	m_vecStart[uiSlot] = CRosaHistogram::CRosaHistogramNow();
+
+	ULONGLONG ullCallID = m_Client.CRosaRpcCall(ROSABENCH_RPC_METHOD_ECHO, m_vecRequest.empty() ? NULL : &m_vecRequest[0], (UINT)m_vecRequest.size(), ROSABENCH_RPC_DEADLINE_MSEC, OnClientResponse, (DWORD_PTR)uiSlot);
+	if (ullCallID == ROSA_RPC_CALL_NIL)
+	{
+		InterlockedIncrement64(&m_llErrors);
+		InterlockedDecrement(&m_lInFlight);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnServerRequest()
+// @Purpose: CRosaBenchRpc˻(ڽֱ߳ӻظ)
+// @Since: v1.00a
+// @Para: CRosaRpc* pRpc(˶˵)
+// @Para: const S_RPCREQUEST* pRequest()
+// @Para: DWORD_PTR dwUser(Զ)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaBenchRpc::OnServerRequest(CRosaRpc * pRpc, const S_RPCREQUEST * pRequest, DWORD_PTR dwUser)
+{
+	pRpc->CRosaRpcReply(pRequest->ullCallID, ROSA_RPC_STATUS_OK, pRequest->pData, pRequest->uiSize);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnClientResponse()
+// @Purpose: CRosaBenchRpcͻӦ(¼ӳ, ɹδֹͣʱͬһλٴη)
+// @Since: v1.00a
+// @Para: ULONGLONG ullCallID(ID)
+// @Para: int nStatus(Ӧ״̬)
+// @Para: const char* pData(Ӧ)
+// @Para: UINT uiSize(Ӧ𳤶)
+// @Para: DWORD_PTR dwUser(;λ)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaBenchRpc::OnClientResponse(ULONGLONG ullCallID, int nStatus, const char * pData, UINT uiSize, DWORD_PTR dwUser)
+{
+	CRosaBenchRpc* pBench = g_pBenchRpc;
+	UINT uiSlot = (UINT)dwUser;
+
+	// ֹ֮ͣɵĵò
+	if (nStatus == ROSA_RPC_STATUS_OK && uiSize == pBench->m_sConfig.uiSize)
+	{
+		if (pBench->m_lStop == 0)
+		{
+			pBench->m_Latency.CRosaHistogramRecordSince(pBench->m_vecStart[uiSlot]);
+			InterlockedIncrement64(&pBench->m_llCompleted);
+		}
+	}
+	else if (pBench->m_lStop == 0)
+	{
+		InterlockedIncrement64(&pBench->m_llErrors);
+	}
+
+	InterlockedDecrement(&pBench->m_lInFlight);
+
+	// ʧܵλòٷ(ʧʱصڷִ߳, ݹ)
+	if (pBench->m_lStop == 0 && nStatus == ROSA_RPC_STATUS_OK)
+	{
+		pBench->Issue(uiSlot);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchRpcUsage()
+// @Purpose: CRosaBenchRpcѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchRpc::CRosaBenchRpcUsage()
+{
+	fprintf(stderr,
+		"  --rpc-depths <list>    RPC calls in flight on one connection (default: " ROSABENCH_DEFAULT_RPC_DEPTHS ")\n"
+		"  --rpc-size <n>         RPC request and response size (default: %d)\n",
+		ROSABENCH_DEFAULT_RPC_SIZE);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchRpcParse()
+// @Purpose: CRosaBenchRpcѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchRpc::CRosaBenchRpcParse(const char * pcArg, const char * pcValue)
+{
+	bool bOk = false;
+
+	if (strcmp(pcArg, "--rpc-depths") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecRpcDepth);
+	}
+	else if (strcmp(pcArg, "--rpc-size") == 0)
+	{
+		g_uiRpcSize = strtoul(pcValue, NULL, 10);
+		bOk = (g_uiRpcSize <= ROSA_RPC_MAX_FRAME - sizeof(S_RPCHEADER));
+	}
+	else
+	{
+		return ROSABENCH_PARSE_UNKNOWN;
+	}
+
+	return bOk ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchRpcMain()
+// @Purpose: CRosaBenchRpcȫ(ÿ;)
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchRpc::CRosaBenchRpcMain(const S_BENCHCOMMON & sCommon)
+{
+	if (g_vecRpcDepth.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_RPC_DEPTHS, g_vecRpcDepth);
+	}
+
+	CRosaBenchRpc BenchRpc;
+
+	for (size_t d = 0; d < g_vecRpcDepth.size(); ++d)
+	{
+		S_RPCBENCHCONFIG sConfig = { g_vecRpcDepth[d], g_uiRpcSize, sCommon.uiSeconds };
+		BenchOutput(BenchRpc.CRosaBenchRpcRun(sConfig));
+	}
+}
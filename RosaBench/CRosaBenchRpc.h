@@ -0,0 +1,78 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchRpc.h
+* @brief	This File is RosaBenchRpc Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHRPC_H__
+#define __CROSABENCHRPC_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Include Rosa Header File
+#include "../Rosa/CRosaEventLoop.h"
+#include "../Rosa/CRosaRpc.h"
+
+//Macro Definition
+#define ROSABENCH_RPC_METHOD_ECHO		1				//Է
+#define ROSABENCH_RPC_DEADLINE_MSEC		5000			//ÿεõĽֹʱ(, ͬʱʱ)
+#define ROSABENCH_RPC_DRAIN_MSEC		10000			//ȴ;ɵʱ()
+#define ROSABENCH_RPC_LOOP_THREADS		2				//¼ѭ߳(ͻշԲ)
+
+#define ROSABENCH_DEFAULT_RPC_DEPTHS	"1,1000"		//Ĭ;
+#define ROSABENCH_DEFAULT_RPC_SIZE		64				//ĬӦ𳤶
+
+//Struct Definition
+typedef struct
+{
+	UINT uiDepth;				// ;
+	UINT uiSize;				// 󳤶(Ӧͬ)
+	UINT uiSeconds;				// ʱ
+}S_RPCBENCHCONFIG, *LPS_RPCBENCHCONFIG;
+
+//Class Definition
+class CRosaBenchRpc
+{
+public:
+	CRosaBenchRpc();			// CRosaBenchRpc 캯
+	~CRosaBenchRpc();			// CRosaBenchRpc 
+
+public:
+	string CRosaBenchRpcRun(const S_RPCBENCHCONFIG& sConfig);					// CRosaBenchRpc һ(JSON)
+
+	static void CRosaBenchRpcUsage();												// CRosaBenchRpc ѡ˵
+	static int CRosaBenchRpcParse(const char* pcArg, const char* pcValue);			// CRosaBenchRpc ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchRpcMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchRpc ȫ
+
+private:
+	bool Connect(SOCKET& sClient, SOCKET& sServer);							// CRosaBenchRpc ػ(ص׽)
+	void Issue(UINT uiSlot);													// CRosaBenchRpc һ;λϷ
+
+	static void __stdcall OnServerRequest(CRosaRpc* pRpc, const S_RPCREQUEST* pRequest, DWORD_PTR dwUser);	// CRosaBenchRpc ˻
+	static void __stdcall OnClientResponse(ULONGLONG ullCallID, int nStatus, const char* pData, UINT uiSize, DWORD_PTR dwUser);	// CRosaBenchRpc ͻӦ(¼ӳٺٴη)
+
+private:
+	CRosaEventLoop m_Loop;						// CRosaBenchRpc ¼ѭ
+	CRosaRpc m_Client;							// CRosaBenchRpc ͻ˶˵
+	CRosaRpc m_Server;							// CRosaBenchRpc ˶˵
+
+	S_RPCBENCHCONFIG m_sConfig;					// CRosaBenchRpc ǰԲ
+	vector<char> m_vecRequest;					// CRosaBenchRpc 
+	vector<LONGLONG> m_vecStart;				// CRosaBenchRpc ÿ;λõķʱ
+	volatile LONG m_lStop;						// CRosaBenchRpc ֹͣµ
+	volatile LONG m_lInFlight;					// CRosaBenchRpc ;
+	volatile LONGLONG m_llCompleted;			// CRosaBenchRpc ɹɵĵ
+	volatile LONGLONG m_llErrors;				// CRosaBenchRpc ʧܵĵ(ʱ/Ͽ/Ȳ)
+	CRosaHistogram m_Latency;					// CRosaBenchRpc ӳ
+
+};
+
+#endif // !__CROSABENCHRPC_H__
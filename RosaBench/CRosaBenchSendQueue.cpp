@@ -0,0 +1,412 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchSendQueue.cpp
+* @brief	This File is RosaBenchSendQueue Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchSendQueue.h"
+
+//Include C/C++ Header File
+#include <process.h>
+#include <stdio.h>
+
+//CRosaBenchSendQueue Ͷв(ٶȡ첽еߺʱˮλصڴ)
+
+// ѡ(бʱȡĬֵ)
+static vector<UINT> g_vecSendqReadRate;
+
+// ȡ̲߳
+typedef struct
+{
+	CRosaBenchSendQueue* pBench;
+	SOCKET Socket;
+}S_SENDQBENCHCONN, *LPS_SENDQBENCHCONN;
+
+// ʽ
+static const char* g_pcSendQueueModeName[ROSABENCH_SENDQ_COUNT] = { "blocking", "watermark", "cap" };
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchSendQueue()
+// @Purpose: CRosaBenchSendQueue캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchSendQueue::CRosaBenchSendQueue()
+{
+	memset(&m_sConfig, 0, sizeof(m_sConfig));
+
+	m_bExit = FALSE;
+	m_lReader = 0;
+	m_llDelivered = 0;
+
+	m_hResume = CreateEvent(NULL, TRUE, TRUE, NULL);
+	m_lHighEvents = 0;
+	m_lLowEvents = 0;
+	m_lBroken = 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchSendQueue()
+// @Purpose: CRosaBenchSendQueue
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchSendQueue::~CRosaBenchSendQueue()
+{
+	if (m_hResume)
+	{
+		CloseHandle(m_hResume);
+		m_hResume = NULL;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchSendQueueRun()
+// @Purpose: CRosaBenchSendQueueһ(һ򰴹̶ʶȡĶԶд, ¼ÿдʱ)
+// @Since: v1.00a
+// @Para: const S_SENDQBENCHCONFIG& sConfig(Բ)
+// @Return: string strJson ()
+//------------------------------------------------------------------
+string CRosaBenchSendQueue::CRosaBenchSendQueueRun(const S_SENDQBENCHCONFIG & sConfig)
+{
+	char chHead[512] = { 0 };
+
+	m_sConfig = sConfig;
+
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"sendqueue\",\"mode\":\"%s\",\"size\":%d,\"read_kbps\":%u,\"high_bytes\":%d,\"low_bytes\":%d,\"max_bytes\":%d",
+		CRosaBenchSendQueueGetModeName(m_sConfig.nMode), ROSABENCH_SENDQ_MESSAGE, m_sConfig.uiReadKBps,
+		ROSA_SENDQUEUE_HIGH_BYTES, ROSA_SENDQUEUE_LOW_BYTES, ROSA_SENDQUEUE_MAX_BYTES);
+
+	// (ٶȡ)
+	m_bExit = FALSE;
+	m_lReader = 0;
+	m_llDelivered = 0;
+	m_lHighEvents = 0;
+	m_lLowEvents = 0;
+	m_lBroken = 0;
+	SetEvent(m_hResume);
+
+	if (!m_Server.CRosaBenchServerStart(m_sConfig.sPort, OnAccept, this))
+	{
+		char chError[128] = { 0 };
+		sprintf_s(chError, sizeof(chError), ",\"error\":\"listen failed (WSA %d)\"}", m_Server.CRosaBenchServerGetError());
+
+		return string("{") + chHead + chError;
+	}
+
+	// 
+	CRosaSocket Client;
+	CRosaEventLoop Loop;
+	CRosaSendQueue Queue;
+	CRosaHistogram Producer;
+	Producer.CRosaHistogramCreate(1);
+
+	bool bQueue = (m_sConfig.nMode != ROSABENCH_SENDQ_BLOCKING);
+	bool bConnected = Client.CRosaSocketConnect("127.0.0.1", m_sConfig.sPort);
+
+	if (bConnected && bQueue)
+	{
+		bConnected = Loop.CRosaEventLoopCreate(1) &&
+			Queue.CRosaSendQueueCreate(Client.CRosaSocketGetRawSocket(), &Loop, OnWatermark, OnClose, (DWORD_PTR)this);
+	}
+
+	ULONGLONG ullMessages = 0;
+	ULONGLONG ullRejected = 0;
+	ULONGLONG ullTimeouts = 0;
+	ULONGLONG ullErrors = 0;
+	LONGLONG llPaused = 0;
+	UINT uiPeakBytes = 0;
+	double dSeconds = 0.0;
+
+	LARGE_INTEGER liFrequency;
+	QueryPerformanceFrequency(&liFrequency);
+
+	if (bConnected)
+	{
+		char chMessage[ROSABENCH_SENDQ_MESSAGE];
+		memset(chMessage, 'R', sizeof(chMessage));
+
+		S_BENCHCPU sCpu;
+		BenchCpuStart(sCpu);
+
+		LONGLONG llDeadline = CRosaHistogram::CRosaHistogramNow() + liFrequency.QuadPart * m_sConfig.uiSeconds;
+
+		for (;;)
+		{
+			LONGLONG llNow = CRosaHistogram::CRosaHistogramNow();
+			if (llNow >= llDeadline)
+			{
+				break;
+			}
+
+			// ˮλʽڸˮλ֮ȴˮλص(ͣʱ䲻дʱ)
+			if (m_sConfig.nMode == ROSABENCH_SENDQ_WATERMARK && WaitForSingleObject(m_hResume, 0) != WAIT_OBJECT_0)
+			{
+				DWORD dwWait = (DWORD)((llDeadline - llNow) * 1000 / liFrequency.QuadPart) + 1;
+				WaitForSingleObject(m_hResume, dwWait);
+				llPaused += CRosaHistogram::CRosaHistogramNow() - llNow;
+				continue;
+			}
+
+			LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+			int nRet = bQueue ? Queue.CRosaSendQueueSend(chMessage, sizeof(chMessage))
+				: Client.CRosaSocketSendBuffer(chMessage, sizeof(chMessage), ROSABENCH_SENDQ_TIMEOUT);
+			Producer.CRosaHistogramRecordSince(llStart);
+
+			if (nRet == SOB_RET_OK)
+			{
+				ullMessages++;
+			}
+			else if (nRet == SOB_RET_FAIL && bQueue)
+			{
+				// ڴ޷ʽó, ȴ¼ѭ
+				ullRejected++;
+				SwitchToThread();
+			}
+			else if (nRet == SOB_RET_TIMEOUT)
+			{
+				ullTimeouts++;
+			}
+			else
+			{
+				ullErrors++;
+				break;
+			}
+		}
+
+		BenchCpuStop(sCpu, dSeconds);
+
+		if (bQueue)
+		{
+			uiPeakBytes = Queue.CRosaSendQueueGetPeakBytes();
+			Queue.CRosaSendQueueDestroy();
+		}
+
+		Loop.CRosaEventLoopDestroy();
+
+		// мͻеֱӶ
+		LINGER sLinger = { 1, 0 };
+		setsockopt(Client.CRosaSocketGetRawSocket(), SOL_SOCKET, SO_LINGER, (char*)&sLinger, sizeof(sLinger));
+		Client.CRosaSocketDisConnect();
+	}
+	else
+	{
+		ullErrors++;
+		Loop.CRosaEventLoopDestroy();
+	}
+
+	// ֹͣ(߳1ڷ), ȡ߳ӹرջ˳־λ˳
+	m_bExit = TRUE;
+	m_Server.CRosaBenchServerStop();
+
+	for (DWORD dwWait = 0; m_lReader > 0 && dwWait < 5000; dwWait += 10)
+	{
+		Sleep(10);
+	}
+
+	char chResult[640] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"seconds\":%.3f,\"messages\":%llu,\"rejected\":%llu,\"timeouts\":%llu,\"errors\":%llu,\"high_events\":%ld,\"low_events\":%ld,\"broken\":%ld,\"paused_ms\":%.1f,\"peak_queued_bytes\":%u,\"within_cap\":%s,\"delivered_kbps\":%.1f,\"producer_ns\":",
+		dSeconds, ullMessages, ullRejected, ullTimeouts, ullErrors, m_lHighEvents, m_lLowEvents, m_lBroken,
+		(double)llPaused * 1000.0 / liFrequency.QuadPart, uiPeakBytes, (uiPeakBytes <= ROSA_SENDQUEUE_MAX_BYTES) ? "true" : "false",
+		(dSeconds > 0.0) ? m_llDelivered / 1024.0 / dSeconds : 0.0);
+
+	return string("{") + chHead + chResult + BenchSummaryJson(Producer) + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchSendQueueGetModeName()
+// @Purpose: CRosaBenchSendQueueȡʽ
+// @Since: v1.00a
+// @Para: int nMode(ROSABENCH_SENDQ_*)
+// @Return: const char* pcName
+//------------------------------------------------------------------
+const char * CRosaBenchSendQueue::CRosaBenchSendQueueGetModeName(int nMode)
+{
+	if (nMode < 0 || nMode >= ROSABENCH_SENDQ_COUNT)
+	{
+		return "";
+	}
+
+	return g_pcSendQueueModeName[nMode];
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAccept()
+// @Purpose: CRosaBenchSendQueue(ÿһٶȡ߳)
+// @Since: v1.00a
+// @Para: void* pContext(Զ)
+// @Para: SOCKET s(ͻ׽)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchSendQueue::OnAccept(void * pContext, SOCKET s, USHORT nShard)
+{
+	CRosaBenchSendQueue* pBench = reinterpret_cast<CRosaBenchSendQueue*>(pContext);
+
+	BenchStartConnThread(OnReaderThread, pBench, s, pBench->m_lReader);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnReaderThread()
+// @Purpose: CRosaBenchSendQueueٶȡ߳(ÿζȡȴۼֽӦʱ)
+// @Since: v1.00a
+// @Para: void* pParam(S_SENDQBENCHCONN)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchSendQueue::OnReaderThread(void * pParam)
+{
+	LPS_SENDQBENCHCONN pConn = reinterpret_cast<LPS_SENDQBENCHCONN>(pParam);
+	CRosaBenchSendQueue* pBench = pConn->pBench;
+
+	CRosaSocket Conn;
+	Conn.CRosaSocketAttachRawSocket(pConn->Socket, true);
+	delete pConn;
+
+	LARGE_INTEGER liFrequency;
+	QueryPerformanceFrequency(&liFrequency);
+
+	double dBytesPerCount = (double)pBench->m_sConfig.uiReadKBps * 1024.0 / liFrequency.QuadPart;
+	LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+
+	char chBuffer[ROSABENCH_SENDQ_READ_CHUNK];
+
+	while (!pBench->m_bExit)
+	{
+		LONGLONG llAllowed = (LONGLONG)((CRosaHistogram::CRosaHistogramNow() - llStart) * dBytesPerCount);
+		if (pBench->m_llDelivered >= llAllowed)
+		{
+			Sleep(1);
+			continue;
+		}
+
+		UINT uiRecv = 0;
+
+		int nRet = Conn.CRosaSocketRecvOnce(chBuffer, (UINT)min(llAllowed - pBench->m_llDelivered, (LONGLONG)sizeof(chBuffer)), uiRecv, 1);
+		if (nRet == SOB_RET_TIMEOUT)
+		{
+			continue;
+		}
+
+		if (nRet != SOB_RET_OK || uiRecv == 0)
+		{
+			break;
+		}
+
+		InterlockedExchangeAdd64(&pBench->m_llDelivered, uiRecv);
+	}
+
+	InterlockedDecrement(&pBench->m_lReader);
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnWatermark()
+// @Purpose: CRosaBenchSendQueueˮλص(ˮλ߳, ˮλ¼ѭ߳, б֤Ⱥ˳)
+// @Since: v1.00a
+// @Para: SOCKET s(׽)
+// @Para: bool bHigh(true:ˮλ, false:ˮλ)
+// @Para: DWORD_PTR dwUser(Զ)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaBenchSendQueue::OnWatermark(SOCKET s, bool bHigh, DWORD_PTR dwUser)
+{
+	CRosaBenchSendQueue* pBench = reinterpret_cast<CRosaBenchSendQueue*>(dwUser);
+
+	if (bHigh)
+	{
+		InterlockedIncrement(&pBench->m_lHighEvents);
+		ResetEvent(pBench->m_hResume);
+	}
+	else
+	{
+		InterlockedIncrement(&pBench->m_lLowEvents);
+		SetEvent(pBench->m_hResume);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnClose()
+// @Purpose: CRosaBenchSendQueueʧܻص(֮д뷵SOB_RET_CLOSE, ߽)
+// @Since: v1.00a
+// @Para: SOCKET s(׽)
+// @Para: int nResult(SOB_RET_FAIL/SOB_RET_CLOSE)
+// @Para: DWORD_PTR dwUser(Զ)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaBenchSendQueue::OnClose(SOCKET s, int nResult, DWORD_PTR dwUser)
+{
+	CRosaBenchSendQueue* pBench = reinterpret_cast<CRosaBenchSendQueue*>(dwUser);
+
+	InterlockedIncrement(&pBench->m_lBroken);
+	SetEvent(pBench->m_hResume);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchSendQueueUsage()
+// @Purpose: CRosaBenchSendQueueѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchSendQueue::CRosaBenchSendQueueUsage()
+{
+	fprintf(stderr,
+		"  --sendq-read-rates <list> slow reader rates in KB/s, blocking send vs send queue (default: " ROSABENCH_DEFAULT_SENDQ_RATES ")\n");
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchSendQueueParse()
+// @Purpose: CRosaBenchSendQueueѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchSendQueue::CRosaBenchSendQueueParse(const char * pcArg, const char * pcValue)
+{
+	bool bOk = false;
+
+	if (strcmp(pcArg, "--sendq-read-rates") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecSendqReadRate);
+	}
+	else
+	{
+		return ROSABENCH_PARSE_UNKNOWN;
+	}
+
+	return bOk ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchSendQueueMain()
+// @Purpose: CRosaBenchSendQueueȫ(ȡ*߷ʽ)
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchSendQueue::CRosaBenchSendQueueMain(const S_BENCHCOMMON & sCommon)
+{
+	if (g_vecSendqReadRate.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_SENDQ_RATES, g_vecSendqReadRate);
+	}
+
+	CRosaBenchSendQueue BenchSendQueue;
+
+	for (size_t r = 0; r < g_vecSendqReadRate.size(); ++r)
+	{
+		for (int m = 0; m < ROSABENCH_SENDQ_COUNT; ++m)
+		{
+			S_SENDQBENCHCONFIG sConfig = { m, g_vecSendqReadRate[r], sCommon.uiSeconds, sCommon.sPort };
+			BenchOutput(BenchSendQueue.CRosaBenchSendQueueRun(sConfig));
+		}
+	}
+}
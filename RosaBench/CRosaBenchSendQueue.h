@@ -0,0 +1,82 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchSendQueue.h
+* @brief	This File is RosaBenchSendQueue Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHSENDQUEUE_H__
+#define __CROSABENCHSENDQUEUE_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Include Rosa Header File
+#include "../Rosa/CRosaEventLoop.h"
+#include "../Rosa/CRosaSendQueue.h"
+
+//Macro Definition
+#define ROSABENCH_SENDQ_BLOCKING		0				//:CRosaSocketSendBuffer(ԭ)
+#define ROSABENCH_SENDQ_WATERMARK		1				//:CRosaSendQueueSend, ˮλͣˮλָ
+#define ROSABENCH_SENDQ_CAP				2				//:CRosaSendQueueSend, ˮλֻڴ޾ܾ
+#define ROSABENCH_SENDQ_COUNT			3
+
+#define ROSABENCH_SENDQ_MESSAGE			1024			//Ϣ
+#define ROSABENCH_SENDQ_READ_CHUNK		4096			//ٶȡÿζȡ
+#define ROSABENCH_SENDQ_TIMEOUT			1				//ͳʱ()
+
+#define ROSABENCH_DEFAULT_SENDQ_RATES	"1K,10K"		//Ĭٶȡ(KB/s)
+
+//Struct Definition
+typedef struct
+{
+	int nMode;					// ʽ(ROSABENCH_SENDQ_*)
+	UINT uiReadKBps;			// ȡ(KB/)
+	UINT uiSeconds;				// ʱ
+	USHORT sPort;				// ˿
+}S_SENDQBENCHCONFIG, *LPS_SENDQBENCHCONFIG;
+
+//Class Definition
+class CRosaBenchSendQueue
+{
+public:
+	CRosaBenchSendQueue();		// CRosaBenchSendQueue 캯
+	~CRosaBenchSendQueue();		// CRosaBenchSendQueue 
+
+public:
+	string CRosaBenchSendQueueRun(const S_SENDQBENCHCONFIG& sConfig);	// CRosaBenchSendQueue һ(JSON)
+
+	static const char* CRosaBenchSendQueueGetModeName(int nMode);		// CRosaBenchSendQueue ȡʽ
+
+	static void CRosaBenchSendQueueUsage();												// CRosaBenchSendQueue ѡ˵
+	static int CRosaBenchSendQueueParse(const char* pcArg, const char* pcValue);			// CRosaBenchSendQueue ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchSendQueueMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchSendQueue ȫ
+
+private:
+	static void OnAccept(void* pContext, SOCKET s, USHORT nShard);							// CRosaBenchSendQueue 
+	static unsigned __stdcall OnReaderThread(void* pParam);									// CRosaBenchSendQueue ٶȡ߳
+	static void __stdcall OnWatermark(SOCKET s, bool bHigh, DWORD_PTR dwUser);				// CRosaBenchSendQueue ˮλص
+	static void __stdcall OnClose(SOCKET s, int nResult, DWORD_PTR dwUser);					// CRosaBenchSendQueue ʧܻص
+
+private:
+	S_SENDQBENCHCONFIG m_sConfig;				// CRosaBenchSendQueue ǰԲ
+
+	CRosaBenchServer m_Server;					// CRosaBenchSendQueue (ÿ¼)
+	BOOL m_bExit;								// CRosaBenchSendQueue ˳־(ȡ߳)
+	volatile LONG m_lReader;					// CRosaBenchSendQueue ȡ߳
+	volatile LONGLONG m_llDelivered;			// CRosaBenchSendQueue ȡյֽ
+
+	HANDLE m_hResume;							// CRosaBenchSendQueue ˮλָ¼(ֶ, ˮλʱλ)
+	volatile LONG m_lHighEvents;				// CRosaBenchSendQueue ˮλص
+	volatile LONG m_lLowEvents;					// CRosaBenchSendQueue ˮλص
+	volatile LONG m_lBroken;					// CRosaBenchSendQueue ʧܻص
+
+};
+
+#endif // !__CROSABENCHSENDQUEUE_H__
@@ -0,0 +1,551 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchShm.cpp
+* @brief	This File is RosaBenchShm Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchShm.h"
+
+//Include C/C++ Header File
+#include <stdio.h>
+#include <process.h>
+
+//CRosaBenchShm ԱȲ(ڴ/Unix׽ػTCP, ͬһ߳, ʹͬշ)
+
+// ѡ(бʱȡĬֵ)
+static vector<UINT> g_vecShmSize;
+
+static const char* g_pcTransportName[ROSABENCH_SHM_TRANSPORT_COUNT] = { "tcp", "shm", "unix" };
+static const char* g_pcModeName[ROSABENCH_SHM_MODE_COUNT] = { "latency", "throughput" };
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchShm()
+// @Purpose: CRosaBenchShm캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchShm::CRosaBenchShm()
+{
+	memset(&m_sConfig, 0, sizeof(m_sConfig));
+	memset(&m_Client, 0, sizeof(m_Client));
+	memset(&m_Server, 0, sizeof(m_Server));
+	m_bAcceptExit = FALSE;
+	m_dwAcceptSlot = ROSABENCH_CONTEXT_SLOTS;
+	m_llReceived = 0;
+
+	m_Latency.CRosaHistogramCreate();
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchShm()
+// @Purpose: CRosaBenchShm
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchShm::~CRosaBenchShm()
+{
+	CloseLinks();
+	m_ShmListen.CRosaShmSocketDestroy();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchShmRun()
+// @Purpose: CRosaBenchShmһ(ģʽʱΪֹ)
+// @Since: v1.00a
+// @Para: const S_SHMBENCHCONFIG& sConfig(Բ)
+// @Return: string strJson (, ʧʱԭ)
+//------------------------------------------------------------------
+string CRosaBenchShm::CRosaBenchShmRun(const S_SHMBENCHCONFIG & sConfig)
+{
+	char chHead[256] = { 0 };
+
+	m_sConfig = sConfig;
+
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"shm\",\"transport\":\"%s\",\"mode\":\"%s\",\"size\":%u",
+		g_pcTransportName[m_sConfig.nTransport], g_pcModeName[m_sConfig.nMode], m_sConfig.uiSize);
+
+	bool bConnected = false;
+
+	switch (m_sConfig.nTransport)
+	{
+	case ROSABENCH_SHM_TRANSPORT_SHM:
+		bConnected = ConnectShm(m_sConfig.sPort);
+		break;
+	case ROSABENCH_SHM_TRANSPORT_UNIX:
+		bConnected = ConnectUnix();
+		break;
+	default:
+		bConnected = ConnectTcp();
+		break;
+	}
+
+	if (!bConnected)
+	{
+		CloseLinks();
+		return string("{") + chHead + ",\"error\":\"connect failed\"}";
+	}
+
+	vector<char> vecBuffer(m_sConfig.uiSize, 'S');
+	char* pBuffer = &vecBuffer[0];
+
+	m_llReceived = 0;
+	m_Latency.CRosaHistogramReset();
+
+	HANDLE hServerThread = (HANDLE)_beginthreadex(NULL, 0, OnServerThread, this, 0, NULL);
+	if (hServerThread == NULL)
+	{
+		CloseLinks();
+		return string("{") + chHead + ",\"error\":\"thread create failed\"}";
+	}
+
+	S_BENCHCPU sCpu;
+	BenchCpuStart(sCpu);
+
+	LARGE_INTEGER liFrequency;
+	QueryPerformanceFrequency(&liFrequency);
+	LONGLONG llEnd = sCpu.llWall + liFrequency.QuadPart * m_sConfig.uiSeconds;
+	LONGLONG llMessages = 0;
+	bool bFailed = false;
+
+	while (CRosaHistogram::CRosaHistogramNow() < llEnd)
+	{
+		LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+
+		if (LinkSend(m_Client, pBuffer, m_sConfig.uiSize) != SOB_RET_OK)
+		{
+			bFailed = true;
+			break;
+		}
+
+		if (m_sConfig.nMode == ROSABENCH_SHM_MODE_LATENCY)
+		{
+			if (LinkRecv(m_Client, pBuffer, m_sConfig.uiSize) != SOB_RET_OK)
+			{
+				bFailed = true;
+				break;
+			}
+
+			m_Latency.CRosaHistogramRecordSince(llStart);
+		}
+
+		++llMessages;
+	}
+
+	// ͻ˶Ͽʣ˳
+	LinkClose(m_Client);
+
+	WaitForSingleObject(hServerThread, INFINITE);
+	CloseHandle(hServerThread);
+
+	double dSeconds = 0.0;
+	double dCpu = BenchCpuStop(sCpu, dSeconds);
+
+	CloseLinks();
+
+	if (bFailed)
+	{
+		return string("{") + chHead + ",\"error\":\"transfer failed\"}";
+	}
+
+	// ӳģʽÿϢһ
+	double dBytes = (m_sConfig.nMode == ROSABENCH_SHM_MODE_LATENCY) ? (double)llMessages * m_sConfig.uiSize * 2 : (double)m_llReceived;
+
+	char chResult[512] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"seconds\":%.3f,\"messages\":%lld,\"msgs_per_sec\":%.1f,\"mb_per_sec\":%.2f,\"cpu_percent\":%.1f",
+		dSeconds, llMessages, (dSeconds > 0.0) ? llMessages / dSeconds : 0.0, (dSeconds > 0.0) ? dBytes / dSeconds / (1024.0 * 1024.0) : 0.0, dCpu);
+
+	string strJson = string("{") + chHead + chResult;
+
+	if (m_sConfig.nMode == ROSABENCH_SHM_MODE_LATENCY)
+	{
+		strJson += ",\"latency_ns\":" + BenchSummaryJson(m_Latency);
+	}
+
+	return strJson + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 ConnectTcp()
+// @Purpose: CRosaBenchShmػTCP(ʱ˿, Nagle, ˽CRosaSocketй)
+// @Since: v1.00a
+// @Para: None
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool CRosaBenchShm::ConnectTcp()
+{
+	SOCKADDR_IN sAddr;
+	memset(&sAddr, 0, sizeof(sAddr));
+	sAddr.sin_family = AF_INET;
+	sAddr.sin_port = 0;
+	sAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	SOCKET sListen = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sListen == INVALID_SOCKET)
+	{
+		return false;
+	}
+
+	SOCKET sClient = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+	int nAddrLen = sizeof(sAddr);
+
+	if (sClient == INVALID_SOCKET ||
+		bind(sListen, (SOCKADDR*)&sAddr, sizeof(sAddr)) == SOCKET_ERROR ||
+		listen(sListen, 1) == SOCKET_ERROR ||
+		getsockname(sListen, (SOCKADDR*)&sAddr, &nAddrLen) == SOCKET_ERROR ||
+		connect(sClient, (SOCKADDR*)&sAddr, sizeof(sAddr)) == SOCKET_ERROR)
+	{
+		if (sClient != INVALID_SOCKET)
+		{
+			closesocket(sClient);
+		}
+		closesocket(sListen);
+		return false;
+	}
+
+	SOCKET sServer = accept(sListen, NULL, NULL);
+	closesocket(sListen);
+
+	if (sServer == INVALID_SOCKET)
+	{
+		closesocket(sClient);
+		return false;
+	}
+
+	m_Client.pTcp = new CRosaSocket();
+	m_Client.pTcp->CRosaSocketAttachRawSocket(sClient, true);
+	m_Client.pTcp->CRosaSocketSetNoDelay(true);
+
+	m_Server.pTcp = new CRosaSocket();
+	m_Server.pTcp->CRosaSocketAttachRawSocket(sServer, true);
+	m_Server.pTcp->CRosaSocketSetNoDelay(true);
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ConnectShm()
+// @Purpose: CRosaBenchShmڴ(TCPͬİ//)
+// @Since: v1.00a
+// @Para: USHORT sPort(˿ں)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool CRosaBenchShm::ConnectShm(USHORT sPort)
+{
+	if (!m_ShmListen.CRosaShmSocketBindOnPort(sPort) || !m_ShmListen.CRosaShmSocketListen(1))
+	{
+		m_ShmListen.CRosaShmSocketDestroy();
+		return false;
+	}
+
+	// ڴܻصֻܴ32λû, òԶеλôָ
+	m_dwAcceptSlot = BenchContextAttach(this);
+	m_bAcceptExit = FALSE;
+
+	HANDLE hAcceptThread = (m_dwAcceptSlot < ROSABENCH_CONTEXT_SLOTS) ? (HANDLE)_beginthreadex(NULL, 0, OnAcceptThread, this, 0, NULL) : NULL;
+	if (hAcceptThread == NULL)
+	{
+		BenchContextDetach(m_dwAcceptSlot);
+		m_dwAcceptSlot = ROSABENCH_CONTEXT_SLOTS;
+		m_ShmListen.CRosaShmSocketDestroy();
+		return false;
+	}
+
+	m_Client.pShm = new CRosaShmSocket();
+	m_Client.pShm->CRosaShmSocketSetBufferSize((m_sConfig.uiSize * 4 > ROSA_SHM_RING_SIZE) ? m_sConfig.uiSize * 4 : ROSA_SHM_RING_SIZE);
+
+	bool bRet = m_Client.pShm->CRosaShmSocketConnect("127.0.0.1", sPort);
+
+	// ܻصλ˳־, ʧʱλ
+	m_bAcceptExit = TRUE;
+	WaitForSingleObject(hAcceptThread, INFINITE);
+	CloseHandle(hAcceptThread);
+
+	BenchContextDetach(m_dwAcceptSlot);
+	m_dwAcceptSlot = ROSABENCH_CONTEXT_SLOTS;
+	m_ShmListen.CRosaShmSocketDestroy();
+
+	return bRet && m_Server.pShm != NULL;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ConnectUnix()
+// @Purpose: CRosaBenchShmUnix(ʱ·, ӽкֱȡ, ʱɾ·ļ)
+// @Since: v1.00a
+// @Para: None
+// @Return: bool bRet (true:ɹ, false:ʧܻϵͳ֧AF_UNIX)
+//------------------------------------------------------------------
+bool CRosaBenchShm::ConnectUnix()
+{
+	string strPath = BenchUnixPath("stream");
+	CRosaSocket Listen;
+
+	if (strPath.empty() || !Listen.CRosaSocketUnixBindOnPath(strPath.c_str()) || !Listen.CRosaSocketListen(1))
+	{
+		return false;
+	}
+
+	m_Client.pTcp = new CRosaSocket();
+	if (!m_Client.pTcp->CRosaSocketUnixConnect(strPath.c_str()))
+	{
+		return false;
+	}
+
+	SOCKET sServer = accept(Listen.CRosaSocketGetRawSocket(), NULL, NULL);
+	if (sServer == INVALID_SOCKET)
+	{
+		return false;
+	}
+
+	m_Server.pTcp = new CRosaSocket();
+	m_Server.pTcp->CRosaSocketAttachRawSocket(sServer, true);
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CloseLinks()
+// @Purpose: CRosaBenchShmر
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchShm::CloseLinks()
+{
+	LinkClose(m_Client);
+	LinkClose(m_Server);
+}
+
+//------------------------------------------------------------------
+// @Function:	 LinkSend()
+// @Purpose: CRosaBenchShmһ
+// @Since: v1.00a
+// @Para: S_SHMBENCHLINK& sLink()
+// @Para: char* pBuffer(ͻ)
+// @Para: UINT uiSize(ͳ)
+// @Return: int nRet (SOB_RET_*)
+//------------------------------------------------------------------
+int CRosaBenchShm::LinkSend(S_SHMBENCHLINK & sLink, char * pBuffer, UINT uiSize)
+{
+	return sLink.pShm ? sLink.pShm->CRosaShmSocketSendBuffer(pBuffer, uiSize) : sLink.pTcp->CRosaSocketSendBuffer(pBuffer, uiSize);
+}
+
+//------------------------------------------------------------------
+// @Function:	 LinkRecv()
+// @Purpose: CRosaBenchShmһ
+// @Since: v1.00a
+// @Para: S_SHMBENCHLINK& sLink()
+// @Para: char* pBuffer(ջ)
+// @Para: UINT uiSize(ճ)
+// @Return: int nRet (SOB_RET_*)
+//------------------------------------------------------------------
+int CRosaBenchShm::LinkRecv(S_SHMBENCHLINK & sLink, char * pBuffer, UINT uiSize)
+{
+	return sLink.pShm ? sLink.pShm->CRosaShmSocketRecvBuffer(pBuffer, uiSize, uiSize) : sLink.pTcp->CRosaSocketRecvBuffer(pBuffer, uiSize, uiSize);
+}
+
+//------------------------------------------------------------------
+// @Function:	 LinkRecvOnce()
+// @Purpose: CRosaBenchShmѵ
+// @Since: v1.00a
+// @Para: S_SHMBENCHLINK& sLink()
+// @Para: char* pBuffer(ջ)
+// @Para: UINT uiBufferSize(ջ峤)
+// @Para: UINT& uiRecv(ճ)
+// @Return: int nRet (SOB_RET_*)
+//------------------------------------------------------------------
+int CRosaBenchShm::LinkRecvOnce(S_SHMBENCHLINK & sLink, char * pBuffer, UINT uiBufferSize, UINT & uiRecv)
+{
+	return sLink.pShm ? sLink.pShm->CRosaShmSocketRecvOnce(pBuffer, uiBufferSize, uiRecv) : sLink.pTcp->CRosaSocketRecvOnce(pBuffer, uiBufferSize, uiRecv);
+}
+
+//------------------------------------------------------------------
+// @Function:	 LinkClose()
+// @Purpose: CRosaBenchShmϿͷ
+// @Since: v1.00a
+// @Para: S_SHMBENCHLINK& sLink()
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchShm::LinkClose(S_SHMBENCHLINK & sLink)
+{
+	if (sLink.pShm)
+	{
+		sLink.pShm->CRosaShmSocketDisConnect();
+		delete sLink.pShm;
+		sLink.pShm = NULL;
+	}
+
+	if (sLink.pTcp)
+	{
+		sLink.pTcp->CRosaSocketDisConnect();
+		delete sLink.pTcp;
+		sLink.pTcp = NULL;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnServerThread()
+// @Purpose: CRosaBenchShm߳(ӳģʽ, ģʽ; ͻ˶Ͽ˳)
+// @Since: v1.00a
+// @Para: void* pParam(Զ)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchShm::OnServerThread(void * pParam)
+{
+	CRosaBenchShm* pBench = (CRosaBenchShm*)pParam;
+	UINT uiSize = pBench->m_sConfig.uiSize;
+	vector<char> vecBuffer((pBench->m_sConfig.nMode == ROSABENCH_SHM_MODE_LATENCY) ? uiSize : ROSABENCH_SHM_RECV_BUFFER);
+	char* pBuffer = &vecBuffer[0];
+
+	while (true)
+	{
+		int nRet = SOB_RET_OK;
+		UINT uiRecv = 0;
+
+		if (pBench->m_sConfig.nMode == ROSABENCH_SHM_MODE_LATENCY)
+		{
+			nRet = LinkRecv(pBench->m_Server, pBuffer, uiSize);
+			if (nRet == SOB_RET_OK)
+			{
+				nRet = LinkSend(pBench->m_Server, pBuffer, uiSize);
+			}
+		}
+		else
+		{
+			nRet = LinkRecvOnce(pBench->m_Server, pBuffer, (UINT)vecBuffer.size(), uiRecv);
+			pBench->m_llReceived += uiRecv;
+		}
+
+		if (nRet == SOB_RET_TIMEOUT)
+		{
+			continue;
+		}
+
+		if (nRet != SOB_RET_OK)
+		{
+			break;
+		}
+	}
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAcceptThread()
+// @Purpose: CRosaBenchShmڴ߳(һӻ˳־λ󷵻)
+// @Since: v1.00a
+// @Para: void* pParam(Զ)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchShm::OnAcceptThread(void * pParam)
+{
+	CRosaBenchShm* pBench = (CRosaBenchShm*)pParam;
+
+	pBench->m_ShmListen.CRosaShmSocketAccept(OnShmAccept, pBench->m_dwAcceptSlot, &pBench->m_bAcceptExit, 1);
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnShmAccept()
+// @Purpose: CRosaBenchShmڴܻص()
+// @Since: v1.00a
+// @Para: CRosaShmSocket* pConn(Ӷ)
+// @Para: DWORD dwUser(Զеλ)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaBenchShm::OnShmAccept(CRosaShmSocket * pConn, DWORD dwUser)
+{
+	CRosaBenchShm* pBench = reinterpret_cast<CRosaBenchShm*>(BenchContextGet(dwUser));
+
+	if (pBench == NULL || pBench->m_Server.pShm != NULL)
+	{
+		delete pConn;
+		return;
+	}
+
+	pBench->m_Server.pShm = pConn;
+	pBench->m_bAcceptExit = TRUE;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchShmUsage()
+// @Purpose: CRosaBenchShmѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchShm::CRosaBenchShmUsage()
+{
+	fprintf(stderr,
+		"  --shm-sizes <list>     shared memory / unix socket vs loopback TCP message sizes (default: " ROSABENCH_DEFAULT_SHM_SIZES ")\n");
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchShmParse()
+// @Purpose: CRosaBenchShmѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchShm::CRosaBenchShmParse(const char * pcArg, const char * pcValue)
+{
+	bool bOk = false;
+
+	if (strcmp(pcArg, "--shm-sizes") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecShmSize);
+	}
+	else
+	{
+		return ROSABENCH_PARSE_UNKNOWN;
+	}
+
+	return bOk ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchShmMain()
+// @Purpose: CRosaBenchShmȫ(ģʽ*Ϣ*䷽ʽ, ͬʱunixԵ)
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchShm::CRosaBenchShmMain(const S_BENCHCOMMON & sCommon)
+{
+	if (g_vecShmSize.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_SHM_SIZES, g_vecShmSize);
+	}
+
+	// ػTCPΪ׼ֻһ, ڴUnix--benchѡ
+	bool bShm = BenchIsSelected("shm");
+	bool bUnix = BenchIsSelected("unix");
+
+	CRosaBenchShm BenchShm;
+
+	for (int m = 0; m < ROSABENCH_SHM_MODE_COUNT; ++m)
+	{
+		for (size_t s = 0; s < g_vecShmSize.size(); ++s)
+		{
+			for (int t = 0; t < ROSABENCH_SHM_TRANSPORT_COUNT; ++t)
+			{
+				if ((t == ROSABENCH_SHM_TRANSPORT_SHM && !bShm) || (t == ROSABENCH_SHM_TRANSPORT_UNIX && !bUnix))
+				{
+					continue;
+				}
+
+				S_SHMBENCHCONFIG sConfig = { t, m, g_vecShmSize[s], sCommon.uiSeconds, sCommon.sPort };
+				BenchOutput(BenchShm.CRosaBenchShmRun(sConfig));
+			}
+		}
+	}
+}
@@ -0,0 +1,96 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchShm.h
+* @brief	This File is RosaBenchShm Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHSHM_H__
+#define __CROSABENCHSHM_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Include Rosa Header File
+#include "../Rosa/CRosaShmSocket.h"
+
+//Macro Definition
+#define ROSABENCH_SHM_TRANSPORT_TCP		0				//䷽ʽ:ػTCP
+#define ROSABENCH_SHM_TRANSPORT_SHM		1				//䷽ʽ:ڴ
+#define ROSABENCH_SHM_TRANSPORT_UNIX	2				//䷽ʽ:Unix׽
+#define ROSABENCH_SHM_TRANSPORT_COUNT	3
+
+#define ROSABENCH_SHM_MODE_LATENCY		0				//ģʽ:һһ(ӳ)
+#define ROSABENCH_SHM_MODE_THROUGHPUT	1				//ģʽ:()
+#define ROSABENCH_SHM_MODE_COUNT		2
+
+#define ROSABENCH_SHM_RECV_BUFFER		(256 * 1024)	//ģʽÿνյĻ峤
+
+#define ROSABENCH_DEFAULT_SHM_SIZES		"64,1K,16K,64K"	//ĬϢ
+
+//Struct Definition
+typedef struct
+{
+	int nTransport;				// ䷽ʽ(ROSABENCH_SHM_TRANSPORT_*)
+	int nMode;					// ģʽ(ROSABENCH_SHM_MODE_*)
+	UINT uiSize;				// Ϣ
+	UINT uiSeconds;				// ʱ
+	USHORT sPort;				// ڴ˿ں
+}S_SHMBENCHCONFIG, *LPS_SHMBENCHCONFIG;
+
+typedef struct
+{
+	CRosaSocket* pTcp;			// TCPUnix(ڴʱΪNULL)
+	CRosaShmSocket* pShm;		// ڴ(TCPʱΪNULL)
+}S_SHMBENCHLINK, *LPS_SHMBENCHLINK;
+
+//Class Definition
+class CRosaBenchShm
+{
+public:
+	CRosaBenchShm();			// CRosaBenchShm 캯
+	~CRosaBenchShm();			// CRosaBenchShm 
+
+public:
+	string CRosaBenchShmRun(const S_SHMBENCHCONFIG& sConfig);					// CRosaBenchShm һ(JSON)
+
+	static void CRosaBenchShmUsage();												// CRosaBenchShm ѡ˵
+	static int CRosaBenchShmParse(const char* pcArg, const char* pcValue);			// CRosaBenchShm ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchShmMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchShm ȫ
+
+private:
+	bool ConnectTcp();															// CRosaBenchShm ػTCP
+	bool ConnectShm(USHORT sPort);												// CRosaBenchShm ڴ
+	bool ConnectUnix();															// CRosaBenchShm Unix
+	void CloseLinks();															// CRosaBenchShm ر
+
+	static int LinkSend(S_SHMBENCHLINK& sLink, char* pBuffer, UINT uiSize);							// CRosaBenchShm (ִӿͬ)
+	static int LinkRecv(S_SHMBENCHLINK& sLink, char* pBuffer, UINT uiSize);							// CRosaBenchShm һ
+	static int LinkRecvOnce(S_SHMBENCHLINK& sLink, char* pBuffer, UINT uiBufferSize, UINT& uiRecv);	// CRosaBenchShm ѵ
+	static void LinkClose(S_SHMBENCHLINK& sLink);														// CRosaBenchShm Ͽͷ
+
+	static unsigned __stdcall OnServerThread(void* pParam);					// CRosaBenchShm ߳(Ի)
+	static unsigned __stdcall OnAcceptThread(void* pParam);					// CRosaBenchShm ڴ߳
+	static void __stdcall OnShmAccept(CRosaShmSocket* pConn, DWORD dwUser);	// CRosaBenchShm ڴܻص
+
+private:
+	S_SHMBENCHCONFIG m_sConfig;					// CRosaBenchShm ǰԲ
+	S_SHMBENCHLINK m_Client;					// CRosaBenchShm ͻ
+	S_SHMBENCHLINK m_Server;					// CRosaBenchShm 
+
+	CRosaShmSocket m_ShmListen;					// CRosaBenchShm ڴ
+	BOOL m_bAcceptExit;							// CRosaBenchShm ߳˳־
+	DWORD m_dwAcceptSlot;						// CRosaBenchShm ڲԶеλ(ܻصû)
+
+	volatile LONGLONG m_llReceived;				// CRosaBenchShm յֽ
+	CRosaHistogram m_Latency;					// CRosaBenchShm ӳ
+
+};
+
+#endif // !__CROSABENCHSHM_H__
@@ -0,0 +1,671 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchTcp.cpp
+* @brief	This File is RosaBenchTcp Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchTcp.h"
+
+//Include C/C++ Header File
+#include <process.h>
+#include <stdio.h>
+
+//CRosaBenchTcp TCPػ(ӿCRosaSocket, ÿһ̻߳)
+
+// ģʽ
+static const char* g_pcTcpModeName[ROSABENCH_TCP_MODE_COUNT] = { "pingpong", "pipeline", "stream" };
+
+// ѡ(бʱȡĬֵ)
+static vector<UINT> g_vecTcpMode;
+static vector<UINT> g_vecTcpSize;
+static vector<UINT> g_vecTcpConn;
+static vector<UINT> g_vecTcpThread;
+static UINT g_uiTcpDepth = ROSABENCH_DEFAULT_DEPTH;
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchTcp()
+// @Purpose: CRosaBenchTcp캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchTcp::CRosaBenchTcp()
+{
+	m_sPort = 0;
+	m_lServerConn = 0;
+
+	memset(&m_sConfig, 0, sizeof(m_sConfig));
+	m_uiDepth = 1;
+	m_hStartEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+
+	m_Latency.CRosaHistogramCreate();
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchTcp()
+// @Purpose: CRosaBenchTcp
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchTcp::~CRosaBenchTcp()
+{
+	CRosaBenchTcpStop();
+
+	if (m_hStartEvent)
+	{
+		CloseHandle(m_hStartEvent);
+		m_hStartEvent = NULL;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchTcpStart()
+// @Purpose: CRosaBenchTcpԷ
+// @Since: v1.00a
+// @Para: USHORT sPort(˿)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool CRosaBenchTcp::CRosaBenchTcpStart(USHORT sPort)
+{
+	m_sPort = sPort;
+
+	return m_Server.CRosaBenchServerStart(sPort, OnAccept, this);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchTcpStop()
+// @Purpose: CRosaBenchTcpֹͣԷ
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchTcp::CRosaBenchTcpStop()
+{
+	CloseConnections();
+
+	m_Server.CRosaBenchServerStop();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchTcpRun()
+// @Purpose: CRosaBenchTcpһ
+// @Since: v1.00a
+// @Para: const S_TCPBENCHCONFIG& sConfig(Բ)
+// @Return: string strJson (, ʧʱԭ)
+//------------------------------------------------------------------
+string CRosaBenchTcp::CRosaBenchTcpRun(const S_TCPBENCHCONFIG & sConfig)
+{
+	char chHead[512] = { 0 };
+
+	m_sConfig = sConfig;
+	if (m_sConfig.uiThreads > m_sConfig.uiConnections)
+	{
+		m_sConfig.uiThreads = m_sConfig.uiConnections;
+	}
+
+	// ;ݳ׽ֻʱ, ˫ڷ
+	m_uiDepth = 1;
+	if (m_sConfig.nMode == ROSABENCH_TCP_PIPELINE)
+	{
+		m_uiDepth = ROSABENCH_TCP_INFLIGHT_MAX / m_sConfig.uiSize;
+		m_uiDepth = (m_uiDepth < 1) ? 1 : ((m_uiDepth > m_sConfig.uiDepth) ? m_sConfig.uiDepth : m_uiDepth);
+	}
+
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"tcp\",\"mode\":\"%s\",\"size\":%u,\"connections\":%u,\"threads\":%u,\"depth\":%u",
+		CRosaBenchTcpGetModeName(m_sConfig.nMode), m_sConfig.uiSize, m_sConfig.uiConnections, m_sConfig.uiThreads, m_uiDepth);
+
+	// ÿһϢ, ͻÿ߳շһ
+	ULONGLONG ullServerBuffer = (m_sConfig.nMode == ROSABENCH_TCP_STREAM) ? ROSABENCH_TCP_STREAM_BUFFER : m_sConfig.uiSize;
+	ULONGLONG ullMemory = ullServerBuffer * m_sConfig.uiConnections + 2ULL * m_sConfig.uiSize * m_sConfig.uiThreads;
+	if (ullMemory > (ULONGLONG)m_sConfig.uiMaxMemoryMB * 1024 * 1024)
+	{
+		return string("{") + chHead + ",\"skipped\":\"buffer memory exceeds --max-memory\"}";
+	}
+
+	// ӲͲԲ
+	S_TCPBENCHHELLO sHello = { (DWORD)m_sConfig.nMode, m_sConfig.uiSize };
+
+	for (UINT i = 0; i < m_sConfig.uiConnections; ++i)
+	{
+		CRosaSocket* pConn = new CRosaSocket();
+		m_vecConn.push_back(pConn);
+
+		if (!pConn->CRosaSocketConnect("127.0.0.1", m_sPort) || pConn->CRosaSocketSendBuffer((char*)&sHello, sizeof(sHello)) != SOB_RET_OK)
+		{
+			char chError[128] = { 0 };
+			sprintf_s(chError, sizeof(chError), ",\"error\":\"connect failed at %u (WSA %d)\"}", i, pConn->m_nLastWSAError);
+
+			CloseConnections();
+			return string("{") + chHead + chError;
+		}
+	}
+
+	// Ӳͻ߳
+	vector<S_TCPBENCHCLIENT> vecClient(m_sConfig.uiThreads);
+	vector<HANDLE> vecThread;
+
+	for (UINT i = 0; i < m_sConfig.uiThreads; ++i)
+	{
+		UINT uiFirst = (UINT)((ULONGLONG)m_sConfig.uiConnections * i / m_sConfig.uiThreads);
+		UINT uiLast = (UINT)((ULONGLONG)m_sConfig.uiConnections * (i + 1) / m_sConfig.uiThreads);
+
+		memset(&vecClient[i], 0, sizeof(S_TCPBENCHCLIENT));
+		vecClient[i].pBench = this;
+		vecClient[i].uiFirst = uiFirst;
+		vecClient[i].uiCount = uiLast - uiFirst;
+
+		HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, OnClientThread, &vecClient[i], 0, NULL);
+		if (hThread)
+		{
+			vecThread.push_back(hThread);
+		}
+	}
+
+	m_Latency.CRosaHistogramReset();
+
+	S_BENCHCPU sCpu;
+	BenchCpuStart(sCpu);
+	SetEvent(m_hStartEvent);
+
+	for (size_t i = 0; i < vecThread.size(); ++i)
+	{
+		WaitForSingleObject(vecThread[i], INFINITE);
+		CloseHandle(vecThread[i]);
+	}
+
+	double dSeconds = 0.0;
+	double dCpu = BenchCpuStop(sCpu, dSeconds);
+	ResetEvent(m_hStartEvent);
+
+	CloseConnections();
+
+	// 
+	ULONGLONG ullMessages = 0;
+	ULONGLONG ullBytes = 0;
+	ULONGLONG ullErrors = 0;
+
+	for (UINT i = 0; i < m_sConfig.uiThreads; ++i)
+	{
+		ullMessages += vecClient[i].ullMessages;
+		ullBytes += vecClient[i].ullBytes;
+		ullErrors += vecClient[i].ullErrors;
+	}
+
+	char chResult[512] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"seconds\":%.3f,\"messages\":%llu,\"errors\":%llu,\"msgs_per_sec\":%.1f,\"mb_per_sec\":%.3f,\"cpu_percent\":%.1f,\"latency_ns\":",
+		dSeconds, ullMessages, ullErrors, (dSeconds > 0.0) ? ullMessages / dSeconds : 0.0, (dSeconds > 0.0) ? ullBytes / dSeconds / (1024.0 * 1024.0) : 0.0, dCpu);
+
+	return string("{") + chHead + chResult + BenchSummaryJson(m_Latency) + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchTcpGetModeName()
+// @Purpose: CRosaBenchTcpȡģʽ
+// @Since: v1.00a
+// @Para: int nMode(ROSABENCH_TCP_*)
+// @Return: const char* pcName
+//------------------------------------------------------------------
+const char * CRosaBenchTcp::CRosaBenchTcpGetModeName(int nMode)
+{
+	if (nMode < 0 || nMode >= ROSABENCH_TCP_MODE_COUNT)
+	{
+		return "";
+	}
+
+	return g_pcTcpModeName[nMode];
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchTcpParseMode()
+// @Purpose: CRosaBenchTcpģʽ
+// @Since: v1.00a
+// @Para: const char* pcName(ģʽ)
+// @Return: int nMode (-1:Ч)
+//------------------------------------------------------------------
+int CRosaBenchTcp::CRosaBenchTcpParseMode(const char * pcName)
+{
+	for (int i = 0; i < ROSABENCH_TCP_MODE_COUNT; ++i)
+	{
+		if (_stricmp(pcName, g_pcTcpModeName[i]) == 0)
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchTcpUsage()
+// @Purpose: CRosaBenchTcpѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchTcp::CRosaBenchTcpUsage()
+{
+	fprintf(stderr,
+		"  --tcp-modes <list>     pingpong,pipeline,stream (default: all)\n"
+		"  --sizes <list>         message sizes (default: " ROSABENCH_DEFAULT_TCP_SIZES ")\n"
+		"  --conns <list>         connection counts (default: " ROSABENCH_DEFAULT_TCP_CONNS "; up to 10000)\n"
+		"  --threads <list>       client thread counts (default: " ROSABENCH_DEFAULT_TCP_THREADS ")\n"
+		"  --depth <n>            pipeline depth per connection (default: %d)\n",
+		ROSABENCH_DEFAULT_DEPTH);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchTcpParse()
+// @Purpose: CRosaBenchTcpѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchTcp::CRosaBenchTcpParse(const char * pcArg, const char * pcValue)
+{
+	bool bOk = false;
+
+	if (strcmp(pcArg, "--tcp-modes") == 0)
+	{
+		char chModes[256] = { 0 };
+		strncpy_s(chModes, sizeof(chModes), pcValue, _TRUNCATE);
+
+		g_vecTcpMode.clear();
+		bOk = true;
+
+		char* pcContext = NULL;
+		for (char* pcMode = strtok_s(chModes, ",", &pcContext); pcMode != NULL && bOk; pcMode = strtok_s(NULL, ",", &pcContext))
+		{
+			int nMode = CRosaBenchTcpParseMode(pcMode);
+			bOk = (nMode >= 0);
+			g_vecTcpMode.push_back(nMode);
+		}
+
+		bOk = bOk && !g_vecTcpMode.empty();
+	}
+	else if (strcmp(pcArg, "--sizes") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecTcpSize);
+	}
+	else if (strcmp(pcArg, "--conns") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecTcpConn);
+	}
+	else if (strcmp(pcArg, "--threads") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecTcpThread);
+	}
+	else if (strcmp(pcArg, "--depth") == 0)
+	{
+		g_uiTcpDepth = strtoul(pcValue, NULL, 10);
+		bOk = (g_uiTcpDepth > 0);
+	}
+	else
+	{
+		return ROSABENCH_PARSE_UNKNOWN;
+	}
+
+	return bOk ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchTcpMain()
+// @Purpose: CRosaBenchTcpȫ(ģʽ***߳)
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchTcp::CRosaBenchTcpMain(const S_BENCHCOMMON & sCommon)
+{
+	if (g_vecTcpMode.empty())
+	{
+		for (int i = 0; i < ROSABENCH_TCP_MODE_COUNT; ++i)
+		{
+			g_vecTcpMode.push_back(i);
+		}
+	}
+
+	if (g_vecTcpSize.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_TCP_SIZES, g_vecTcpSize);
+	}
+
+	if (g_vecTcpConn.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_TCP_CONNS, g_vecTcpConn);
+	}
+
+	if (g_vecTcpThread.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_TCP_THREADS, g_vecTcpThread);
+	}
+
+	CRosaBenchTcp BenchTcp;
+
+	if (!BenchTcp.CRosaBenchTcpStart(sCommon.sPort))
+	{
+		fprintf(stderr, "RosaBench: cannot listen on port %u\n", sCommon.sPort);
+		return;
+	}
+
+	for (size_t m = 0; m < g_vecTcpMode.size(); ++m)
+	{
+		for (size_t s = 0; s < g_vecTcpSize.size(); ++s)
+		{
+			for (size_t c = 0; c < g_vecTcpConn.size(); ++c)
+			{
+				for (size_t t = 0; t < g_vecTcpThread.size(); ++t)
+				{
+					// ߳ʱ, ǰһͬʱ
+					UINT uiThreads = (g_vecTcpThread[t] > g_vecTcpConn[c]) ? g_vecTcpConn[c] : g_vecTcpThread[t];
+					if (t > 0 && ((g_vecTcpThread[t - 1] > g_vecTcpConn[c]) ? g_vecTcpConn[c] : g_vecTcpThread[t - 1]) == uiThreads)
+					{
+						continue;
+					}
+
+					S_TCPBENCHCONFIG sConfig = { (int)g_vecTcpMode[m], g_vecTcpSize[s], g_vecTcpConn[c], uiThreads, g_uiTcpDepth, sCommon.uiSeconds, sCommon.uiMaxMemory };
+					BenchOutput(BenchTcp.CRosaBenchTcpRun(sConfig));
+				}
+			}
+		}
+	}
+
+	BenchTcp.CRosaBenchTcpStop();
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAccept()
+// @Purpose: CRosaBenchTcp(ÿһСջ߳)
+// @Since: v1.00a
+// @Para: void* pContext(Զ)
+// @Para: SOCKET s(ͻ׽)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchTcp::OnAccept(void * pContext, SOCKET s, USHORT nShard)
+{
+	CRosaBenchTcp* pBench = reinterpret_cast<CRosaBenchTcp*>(pContext);
+
+	BenchStartConnThread(OnServerConn, pBench, s, pBench->m_lServerConn, ROSABENCH_THREAD_STACK);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnServerConn()
+// @Purpose: CRosaBenchTcp߳(Իͳֽ, ͻ˹رպ˳)
+// @Since: v1.00a
+// @Para: void* pParam(S_BENCHCONN)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchTcp::OnServerConn(void * pParam)
+{
+	LPS_BENCHCONN pConn = reinterpret_cast<LPS_BENCHCONN>(pParam);
+	CRosaBenchTcp* pBench = reinterpret_cast<CRosaBenchTcp*>(pConn->pContext);
+
+	// йܺʹÿͻ˽ӿ, ÿԼ¼
+	CRosaSocket Conn;
+	Conn.CRosaSocketAttachRawSocket(pConn->Socket, true);
+	delete pConn;
+
+	S_TCPBENCHHELLO sHello = { 0 };
+	int nRet = Conn.CRosaSocketRecvBuffer((char*)&sHello, sizeof(sHello), sizeof(sHello));
+
+	if (nRet == SOB_RET_OK && sHello.dwSize > 0)
+	{
+		if (sHello.dwMode == ROSABENCH_TCP_STREAM)
+		{
+			char* pBuffer = new char[ROSABENCH_TCP_STREAM_BUFFER];
+			ULONGLONG ullReceived = 0;
+
+			while (true)
+			{
+				UINT uiRecv = 0;
+				nRet = Conn.CRosaSocketRecvOnce(pBuffer, ROSABENCH_TCP_STREAM_BUFFER, uiRecv);
+
+				if (nRet == SOB_RET_OK)
+				{
+					ullReceived += uiRecv;
+				}
+				else if (nRet != SOB_RET_TIMEOUT)
+				{
+					break;
+				}
+			}
+
+			// ͻֻر˷ͷ, йܺظյֽ
+			SOCKET s = Conn.CRosaSocketGetRawSocket();
+			Conn.CRosaSocketAttachRawSocket(s, true);
+			Conn.CRosaSocketSendBuffer((char*)&ullReceived, sizeof(ullReceived));
+
+			delete[] pBuffer;
+		}
+		else
+		{
+			char* pBuffer = new char[sHello.dwSize];
+
+			while (true)
+			{
+				nRet = Conn.CRosaSocketRecvBuffer(pBuffer, sHello.dwSize, sHello.dwSize);
+
+				// ܶʱ, ֵ֮ǰܳʱ
+				if (nRet == SOB_RET_TIMEOUT)
+				{
+					continue;
+				}
+
+				if (nRet != SOB_RET_OK || Conn.CRosaSocketSendBuffer(pBuffer, sHello.dwSize) != SOB_RET_OK)
+				{
+					break;
+				}
+			}
+
+			delete[] pBuffer;
+		}
+	}
+
+	InterlockedDecrement(&pBench->m_lServerConn);
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnClientThread()
+// @Purpose: CRosaBenchTcpͻ߳
+// @Since: v1.00a
+// @Para: void* pParam(S_TCPBENCHCLIENT)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchTcp::OnClientThread(void * pParam)
+{
+	LPS_TCPBENCHCLIENT pClient = reinterpret_cast<LPS_TCPBENCHCLIENT>(pParam);
+	CRosaBenchTcp* pBench = pClient->pBench;
+	UINT uiSize = pBench->m_sConfig.uiSize;
+
+	char* pSendBuffer = new char[uiSize];
+	char* pRecvBuffer = new char[uiSize];
+	memset(pSendBuffer, 'R', uiSize);
+
+	WaitForSingleObject(pBench->m_hStartEvent, INFINITE);
+
+	LARGE_INTEGER liFrequency;
+	QueryPerformanceFrequency(&liFrequency);
+	LONGLONG llDeadline = CRosaHistogram::CRosaHistogramNow() + liFrequency.QuadPart * pBench->m_sConfig.uiSeconds;
+
+	switch (pBench->m_sConfig.nMode)
+	{
+	case ROSABENCH_TCP_PINGPONG:
+		pBench->ClientPingPong(pClient, pSendBuffer, pRecvBuffer, llDeadline);
+		break;
+	case ROSABENCH_TCP_PIPELINE:
+		pBench->ClientPipeline(pClient, pSendBuffer, pRecvBuffer, llDeadline);
+		break;
+	case ROSABENCH_TCP_STREAM:
+		pBench->ClientStream(pClient, pSendBuffer, llDeadline);
+		break;
+	default:
+		break;
+	}
+
+	delete[] pSendBuffer;
+	delete[] pRecvBuffer;
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ClientPingPong()
+// @Purpose: CRosaBenchTcpӦ(ÿһ)
+// @Since: v1.00a
+// @Para: LPS_TCPBENCHCLIENT pClient(ͻ߳)
+// @Para: LONGLONG llDeadline(ʱܼ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchTcp::ClientPingPong(LPS_TCPBENCHCLIENT pClient, char * pSendBuffer, char * pRecvBuffer, LONGLONG llDeadline)
+{
+	UINT uiSize = m_sConfig.uiSize;
+
+	while (CRosaHistogram::CRosaHistogramNow() < llDeadline)
+	{
+		for (UINT i = 0; i < pClient->uiCount; ++i)
+		{
+			CRosaSocket* pConn = m_vecConn[pClient->uiFirst + i];
+			LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+
+			if (pConn->CRosaSocketSendBuffer(pSendBuffer, uiSize) != SOB_RET_OK ||
+				pConn->CRosaSocketRecvBuffer(pRecvBuffer, uiSize, uiSize) != SOB_RET_OK)
+			{
+				pClient->ullErrors++;
+				return;
+			}
+
+			m_Latency.CRosaHistogramRecordSince(llStart);
+			pClient->ullMessages++;
+			pClient->ullBytes += uiSize;
+		}
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 ClientPipeline()
+// @Purpose: CRosaBenchTcpˮӦ(ÿϷm_uiDepth, ջ)
+// @Since: v1.00a
+// @Para: LPS_TCPBENCHCLIENT pClient(ͻ߳)
+// @Para: LONGLONG llDeadline(ʱܼ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchTcp::ClientPipeline(LPS_TCPBENCHCLIENT pClient, char * pSendBuffer, char * pRecvBuffer, LONGLONG llDeadline)
+{
+	UINT uiSize = m_sConfig.uiSize;
+
+	while (CRosaHistogram::CRosaHistogramNow() < llDeadline)
+	{
+		// ӳٴʼ, Ŷʱ
+		LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+
+		for (UINT i = 0; i < pClient->uiCount; ++i)
+		{
+			CRosaSocket* pConn = m_vecConn[pClient->uiFirst + i];
+
+			for (UINT d = 0; d < m_uiDepth; ++d)
+			{
+				if (pConn->CRosaSocketSendBuffer(pSendBuffer, uiSize) != SOB_RET_OK)
+				{
+					pClient->ullErrors++;
+					return;
+				}
+			}
+		}
+
+		for (UINT i = 0; i < pClient->uiCount; ++i)
+		{
+			CRosaSocket* pConn = m_vecConn[pClient->uiFirst + i];
+
+			for (UINT d = 0; d < m_uiDepth; ++d)
+			{
+				if (pConn->CRosaSocketRecvBuffer(pRecvBuffer, uiSize, uiSize) != SOB_RET_OK)
+				{
+					pClient->ullErrors++;
+					return;
+				}
+
+				m_Latency.CRosaHistogramRecordSince(llStart);
+				pClient->ullMessages++;
+				pClient->ullBytes += uiSize;
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 ClientStream()
+// @Purpose: CRosaBenchTcp(ʱرշͷ, Է˻ظֽΪ׼)
+// @Since: v1.00a
+// @Para: LPS_TCPBENCHCLIENT pClient(ͻ߳)
+// @Para: LONGLONG llDeadline(ʱܼ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchTcp::ClientStream(LPS_TCPBENCHCLIENT pClient, char * pSendBuffer, LONGLONG llDeadline)
+{
+	UINT uiSize = m_sConfig.uiSize;
+	bool bFailed = false;
+
+	while (!bFailed && CRosaHistogram::CRosaHistogramNow() < llDeadline)
+	{
+		for (UINT i = 0; i < pClient->uiCount; ++i)
+		{
+			LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+
+			if (m_vecConn[pClient->uiFirst + i]->CRosaSocketSendBuffer(pSendBuffer, uiSize) != SOB_RET_OK)
+			{
+				pClient->ullErrors++;
+				bFailed = true;
+				break;
+			}
+
+			// ¼ÿη͵õĺʱ
+			m_Latency.CRosaHistogramRecordSince(llStart);
+		}
+	}
+
+	for (UINT i = 0; i < pClient->uiCount; ++i)
+	{
+		CRosaSocket* pConn = m_vecConn[pClient->uiFirst + i];
+		ULONGLONG ullReceived = 0;
+
+		shutdown(pConn->CRosaSocketGetRawSocket(), SD_SEND);
+
+		if (pConn->CRosaSocketRecvBuffer((char*)&ullReceived, sizeof(ullReceived), sizeof(ullReceived), 30) != SOB_RET_OK)
+		{
+			pClient->ullErrors++;
+			continue;
+		}
+
+		pClient->ullBytes += ullReceived;
+		pClient->ullMessages += ullReceived / uiSize;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CloseConnections()
+// @Purpose: CRosaBenchTcpرȫͻӲȴ߳˳(10)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchTcp::CloseConnections()
+{
+	for (size_t i = 0; i < m_vecConn.size(); ++i)
+	{
+		delete m_vecConn[i];
+	}
+	m_vecConn.clear();
+
+	for (int i = 0; i < 1000 && m_lServerConn > 0; ++i)
+	{
+		Sleep(10);
+	}
+}
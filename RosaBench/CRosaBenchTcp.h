@@ -0,0 +1,108 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchTcp.h
+* @brief	This File is RosaBenchTcp Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHTCP_H__
+#define __CROSABENCHTCP_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Macro Definition
+#define ROSABENCH_TCP_PINGPONG		0				//ģʽ:Ӧ(ÿһ;)
+#define ROSABENCH_TCP_PIPELINE		1				//ģʽ:ˮӦ(ÿӶ;)
+#define ROSABENCH_TCP_STREAM		2				//ģʽ:(նͳֽ)
+#define ROSABENCH_TCP_MODE_COUNT	3
+
+#define ROSABENCH_TCP_INFLIGHT_MAX	64*1024			//ˮÿ;ֽ(ʱ˫ڷ)
+#define ROSABENCH_TCP_STREAM_BUFFER	64*1024			//ջ
+
+#define ROSABENCH_DEFAULT_DEPTH		16				//Ĭˮ(ÿδӦ)
+#define ROSABENCH_DEFAULT_TCP_SIZES	"16,256,4K,64K,1M"	//ĬϢ
+#define ROSABENCH_DEFAULT_TCP_CONNS	"1,10,100"		//Ĭ
+#define ROSABENCH_DEFAULT_TCP_THREADS	"1,4"		//ĬϿͻ߳
+
+//Struct Definition
+typedef struct
+{
+	DWORD dwMode;				// ģʽ
+	DWORD dwSize;				// Ϣ
+}S_TCPBENCHHELLO, *LPS_TCPBENCHHELLO;
+
+typedef struct
+{
+	int nMode;					// ģʽ(ROSABENCH_TCP_*)
+	UINT uiSize;				// Ϣ
+	UINT uiConnections;			// 
+	UINT uiThreads;				// ͻ߳(ƽ)
+	UINT uiDepth;				// ˮ
+	UINT uiSeconds;				// ʱ
+	UINT uiMaxMemoryMB;			// ڴ
+}S_TCPBENCHCONFIG, *LPS_TCPBENCHCONFIG;
+
+//Class Declaration
+class CRosaBenchTcp;
+
+typedef struct
+{
+	CRosaBenchTcp* pBench;		// 
+	UINT uiFirst;				// һ
+	UINT uiCount;				// 
+	ULONGLONG ullMessages;		// ɵϢ
+	ULONGLONG ullBytes;			// ɵֽ()
+	ULONGLONG ullErrors;		// ʧܴ
+}S_TCPBENCHCLIENT, *LPS_TCPBENCHCLIENT;
+
+//Class Definition
+class CRosaBenchTcp
+{
+public:
+	CRosaBenchTcp();			// CRosaBenchTcp 캯
+	~CRosaBenchTcp();			// CRosaBenchTcp 
+
+public:
+	bool CRosaBenchTcpStart(USHORT sPort);							// CRosaBenchTcp Է
+	void CRosaBenchTcpStop();										// CRosaBenchTcp ֹͣԷ
+	string CRosaBenchTcpRun(const S_TCPBENCHCONFIG& sConfig);		// CRosaBenchTcp һ(JSON)
+
+	static const char* CRosaBenchTcpGetModeName(int nMode);			// CRosaBenchTcp ȡģʽ
+	static int CRosaBenchTcpParseMode(const char* pcName);			// CRosaBenchTcp ģʽ(-1:Ч)
+
+	static void CRosaBenchTcpUsage();												// CRosaBenchTcp ѡ˵
+	static int CRosaBenchTcpParse(const char* pcArg, const char* pcValue);			// CRosaBenchTcp ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchTcpMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchTcp ȫ
+
+private:
+	static void OnAccept(void* pContext, SOCKET s, USHORT nShard);							// CRosaBenchTcp (߳)
+	static unsigned __stdcall OnServerConn(void* pParam);									// CRosaBenchTcp ߳
+	static unsigned __stdcall OnClientThread(void* pParam);									// CRosaBenchTcp ͻ߳
+
+	void ClientPingPong(LPS_TCPBENCHCLIENT pClient, char* pSendBuffer, char* pRecvBuffer, LONGLONG llDeadline);	// CRosaBenchTcp Ӧ
+	void ClientPipeline(LPS_TCPBENCHCLIENT pClient, char* pSendBuffer, char* pRecvBuffer, LONGLONG llDeadline);	// CRosaBenchTcp ˮӦ
+	void ClientStream(LPS_TCPBENCHCLIENT pClient, char* pSendBuffer, LONGLONG llDeadline);						// CRosaBenchTcp 
+
+	void CloseConnections();										// CRosaBenchTcp رȫͻӲȴ߳˳
+
+private:
+	CRosaBenchServer m_Server;					// CRosaBenchTcp Է
+	USHORT m_sPort;								// CRosaBenchTcp ˿
+	volatile LONG m_lServerConn;				// CRosaBenchTcp ߳
+
+	S_TCPBENCHCONFIG m_sConfig;					// CRosaBenchTcp ǰԲ
+	UINT m_uiDepth;								// CRosaBenchTcp ǰЧˮ
+	vector<CRosaSocket*> m_vecConn;				// CRosaBenchTcp ͻ
+	HANDLE m_hStartEvent;						// CRosaBenchTcp ͻ߳ͬʱʼ
+	CRosaHistogram m_Latency;					// CRosaBenchTcp Ϣӳ
+
+};
+
+#endif // !__CROSABENCHTCP_H__
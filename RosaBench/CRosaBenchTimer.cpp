@@ -0,0 +1,468 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchTimer.cpp
+* @brief	This File is RosaBenchTimer Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchTimer.h"
+
+//Include C/C++ Header File
+#include <process.h>
+#include <stdio.h>
+
+//CRosaBenchTimer ʱֲ(дʱʱ//ɾ, ԼǷʱ)
+
+// ѡ(бʱȡĬֵ)
+static vector<UINT> g_vecTimerThread;
+static vector<UINT> g_vecTimerLive;
+static UINT g_uiIdleConns = ROSABENCH_DEFAULT_IDLE_CONNS;
+static UINT g_uiIdleMSec = ROSABENCH_DEFAULT_IDLE_MSEC;
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchTimer()
+// @Purpose: CRosaBenchTimer캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchTimer::CRosaBenchTimer()
+{
+	memset(&m_sConfig, 0, sizeof(m_sConfig));
+	m_pLoop = NULL;
+	m_lFired = 0;
+	m_hStartEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+
+	m_Latency.CRosaHistogramCreate();
+
+	InitializeCriticalSection(&m_csAccepted);
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchTimer()
+// @Purpose: CRosaBenchTimer
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchTimer::~CRosaBenchTimer()
+{
+	DeleteCriticalSection(&m_csAccepted);
+
+	if (m_hStartEvent)
+	{
+		CloseHandle(m_hStartEvent);
+		m_hStartEvent = NULL;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchTimerChurnRun()
+// @Purpose: CRosaBenchTimerʱ//ɾ(ÿһ¶ʱһפʱɾ¶ʱ)
+// @Since: v1.00a
+// @Para: const S_TIMERBENCHCONFIG& sConfig(Բ)
+// @Return: string strJson ()
+//------------------------------------------------------------------
+string CRosaBenchTimer::CRosaBenchTimerChurnRun(const S_TIMERBENCHCONFIG & sConfig)
+{
+	char chHead[512] = { 0 };
+
+	m_sConfig = sConfig;
+	m_sConfig.uiThreads = (m_sConfig.uiThreads < 1) ? 1 : m_sConfig.uiThreads;
+	m_sConfig.uiLive = (m_sConfig.uiLive < 1) ? 1 : m_sConfig.uiLive;
+
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"timer\",\"mode\":\"churn\",\"threads\":%u,\"live_timers\":%u",
+		m_sConfig.uiThreads, m_sConfig.uiLive);
+
+	CRosaEventLoop Loop;
+	if (!Loop.CRosaEventLoopCreate(1))
+	{
+		return string("{") + chHead + ",\"error\":\"event loop\"}";
+	}
+
+	m_pLoop = &Loop;
+	m_lFired = 0;
+
+	// פʱ
+	m_vecLive.clear();
+	for (UINT i = 0; i < m_sConfig.uiLive; ++i)
+	{
+		m_vecLive.push_back(Loop.CRosaEventLoopSetTimer(ROSABENCH_TIMER_LIVE_DELAY, 0, OnTimer, this));
+	}
+
+	// /ɾ߳
+	vector<S_TIMERBENCHCLIENT> vecClient(m_sConfig.uiThreads);
+	vector<HANDLE> vecThread;
+
+	for (UINT i = 0; i < m_sConfig.uiThreads; ++i)
+	{
+		memset(&vecClient[i], 0, sizeof(S_TIMERBENCHCLIENT));
+		vecClient[i].pBench = this;
+		vecClient[i].uiSeed = 2463534242U + i * 7919U;
+
+		HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, OnChurnThread, &vecClient[i], 0, NULL);
+		if (hThread)
+		{
+			vecThread.push_back(hThread);
+		}
+	}
+
+	m_Latency.CRosaHistogramReset();
+
+	S_BENCHCPU sCpu;
+	BenchCpuStart(sCpu);
+	SetEvent(m_hStartEvent);
+
+	for (size_t i = 0; i < vecThread.size(); ++i)
+	{
+		WaitForSingleObject(vecThread[i], INFINITE);
+		CloseHandle(vecThread[i]);
+	}
+
+	double dSeconds = 0.0;
+	double dCpu = BenchCpuStop(sCpu, dSeconds);
+	ResetEvent(m_hStartEvent);
+
+	UINT uiTimers = Loop.CRosaEventLoopGetTimerCount();
+
+	for (size_t i = 0; i < m_vecLive.size(); ++i)
+	{
+		Loop.CRosaEventLoopKillTimer(m_vecLive[i]);
+	}
+	m_vecLive.clear();
+
+	Loop.CRosaEventLoopDestroy();
+	m_pLoop = NULL;
+
+	// 
+	ULONGLONG ullOps = 0;
+	ULONGLONG ullErrors = 0;
+
+	for (UINT i = 0; i < m_sConfig.uiThreads; ++i)
+	{
+		ullOps += vecClient[i].ullOps;
+		ullErrors += vecClient[i].ullErrors;
+	}
+
+	// ɾɶԼ(ÿ/ȡ)
+	char chResult[512] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"seconds\":%.3f,\"ops\":%llu,\"errors\":%llu,\"ops_per_sec\":%.1f,\"start_cancel_per_sec\":%.1f,\"timers_after\":%u,\"unexpected_fired\":%ld,\"cpu_percent\":%.1f,\"round_ns\":",
+		dSeconds, ullOps, ullErrors, (dSeconds > 0.0) ? ullOps / dSeconds : 0.0, (dSeconds > 0.0) ? ullOps / 3.0 / dSeconds : 0.0,
+		uiTimers, m_lFired, dCpu);
+
+	return string("{") + chHead + chResult + BenchSummaryJson(m_Latency) + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchTimerIdleRun()
+// @Purpose: CRosaBenchTimerӰʱ(Ӻշ, ˹رվӽʱ)
+// @Since: v1.00a
+// @Para: const S_IDLEBENCHCONFIG& sConfig(Բ)
+// @Return: string strJson ()
+//------------------------------------------------------------------
+string CRosaBenchTimer::CRosaBenchTimerIdleRun(const S_IDLEBENCHCONFIG & sConfig)
+{
+	char chHead[512] = { 0 };
+
+	UINT uiConnections = (sConfig.uiConnections < 1) ? 1 : sConfig.uiConnections;
+	UINT uiIdleMSec = (sConfig.uiIdleMSec < 1) ? 1 : sConfig.uiIdleMSec;
+
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"timer\",\"mode\":\"idle\",\"connections\":%u,\"idle_ms\":%u",
+		uiConnections, uiIdleMSec);
+
+	CRosaEventLoop Loop;
+	if (!Loop.CRosaEventLoopCreate(1))
+	{
+		return string("{") + chHead + ",\"error\":\"event loop\"}";
+	}
+
+	// ͻÿгʱ֮ſʼ
+	if (!m_Server.CRosaBenchServerStart(sConfig.sPort, OnAccept, this) ||
+		!m_Server.CRosaBenchServerGetSocket()->CRosaSocketSetIdleTimeOut(&Loop, uiIdleMSec))
+	{
+		m_Server.CRosaBenchServerStop();
+		Loop.CRosaEventLoopDestroy();
+		return string("{") + chHead + ",\"error\":\"listen failed\"}";
+	}
+
+	// Ӳ¼ԵĽʱ
+	vector<CRosaSocket*> vecConn;
+	vector<WSAPOLLFD> vecPoll;
+	vector<LONGLONG> vecConnected;
+
+	for (UINT i = 0; i < uiConnections; ++i)
+	{
+		CRosaSocket* pConn = new CRosaSocket();
+		vecConn.push_back(pConn);
+
+		if (!pConn->CRosaSocketConnect("127.0.0.1", sConfig.sPort))
+		{
+			continue;
+		}
+
+		WSAPOLLFD sPoll = { pConn->CRosaSocketGetRawSocket(), POLLRDNORM, 0 };
+		vecPoll.push_back(sPoll);
+		vecConnected.push_back(CRosaHistogram::CRosaHistogramNow());
+	}
+
+	// ȴ˹ر(ɶҶ0ֽ), ںȴROSABENCH_TIMER_IDLE_GRACE
+	CRosaHistogram Reap;
+	Reap.CRosaHistogramCreate(1);
+
+	UINT uiReaped = 0;
+	LONGLONG llLateMax = 0;
+	LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+
+	LARGE_INTEGER liFrequency;
+	QueryPerformanceFrequency(&liFrequency);
+
+	LONGLONG llIdle = liFrequency.QuadPart * uiIdleMSec / 1000;
+	LONGLONG llDeadline = llStart + liFrequency.QuadPart * (uiIdleMSec + ROSABENCH_TIMER_IDLE_GRACE) / 1000;
+
+	vector<bool> vecDone(vecPoll.size(), false);
+
+	while (uiReaped < vecPoll.size() && CRosaHistogram::CRosaHistogramNow() < llDeadline)
+	{
+		if (WSAPoll(&vecPoll[0], (ULONG)vecPoll.size(), 10) <= 0)
+		{
+			continue;
+		}
+
+		LONGLONG llNow = CRosaHistogram::CRosaHistogramNow();
+
+		for (size_t i = 0; i < vecPoll.size(); ++i)
+		{
+			if (vecDone[i] || vecPoll[i].revents == 0)
+			{
+				continue;
+			}
+
+			char chByte = 0;
+			if (recv(vecPoll[i].fd, &chByte, 1, 0) > 0)
+			{
+				continue;
+			}
+
+			vecDone[i] = true;
+			vecPoll[i].events = 0;
+			uiReaped++;
+
+			Reap.CRosaHistogramRecord(CRosaHistogram::CRosaHistogramToNanoSec(llNow - vecConnected[i]));
+			llLateMax = max(llLateMax, llNow - vecConnected[i] - llIdle);
+		}
+	}
+
+	UINT uiIdleLeft = m_Server.CRosaBenchServerGetSocket()->CRosaSocketGetIdleCount();
+
+	// ֹͣر˫(ɾ׽ʱȡȫмʱ)
+	m_Server.CRosaBenchServerStop();
+
+	EnterCriticalSection(&m_csAccepted);
+	for (vector<SOCKET>::iterator iter = m_vecAccepted.begin(); iter != m_vecAccepted.end(); ++iter)
+	{
+		closesocket(*iter);
+	}
+	m_vecAccepted.clear();
+	LeaveCriticalSection(&m_csAccepted);
+
+	for (size_t i = 0; i < vecConn.size(); ++i)
+	{
+		delete vecConn[i];
+	}
+
+	Loop.CRosaEventLoopDestroy();
+
+	// ڿʱرյ˵ʱ, lateΪʱֵ
+	char chResult[512] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"connected\":%u,\"reaped\":%u,\"idle_left\":%u,\"late_max_ms\":%.1f,\"reap_ns\":",
+		(UINT)vecPoll.size(), uiReaped, uiIdleLeft, (double)CRosaHistogram::CRosaHistogramToNanoSec(llLateMax) / 1e6);
+
+	return string("{") + chHead + chResult + BenchSummaryJson(Reap) + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnChurnThread()
+// @Purpose: CRosaBenchTimer/ɾ߳(ʱ, ʱֵĲͬ)
+// @Since: v1.00a
+// @Para: void* pParam(S_TIMERBENCHCLIENT)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchTimer::OnChurnThread(void * pParam)
+{
+	LPS_TIMERBENCHCLIENT pClient = reinterpret_cast<LPS_TIMERBENCHCLIENT>(pParam);
+	CRosaBenchTimer* pBench = pClient->pBench;
+	CRosaEventLoop* pLoop = pBench->m_pLoop;
+	UINT uiLive = (UINT)pBench->m_vecLive.size();
+
+	WaitForSingleObject(pBench->m_hStartEvent, INFINITE);
+
+	LARGE_INTEGER liFrequency;
+	QueryPerformanceFrequency(&liFrequency);
+
+	LONGLONG llDeadline = CRosaHistogram::CRosaHistogramNow() + liFrequency.QuadPart * pBench->m_sConfig.uiSeconds;
+
+	while (CRosaHistogram::CRosaHistogramNow() < llDeadline)
+	{
+		DWORD dwDelay = ROSABENCH_TIMER_CHURN_MIN + NextRandom(pClient->uiSeed) % (ROSABENCH_TIMER_LIVE_DELAY - ROSABENCH_TIMER_CHURN_MIN);
+		ULONGLONG ullLive = pBench->m_vecLive[NextRandom(pClient->uiSeed) % uiLive];
+
+		LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+
+		ULONGLONG ullTimerID = pLoop->CRosaEventLoopSetTimer(dwDelay, 0, OnTimer, pBench);
+		bool bReset = pLoop->CRosaEventLoopResetTimer(ullLive, ROSABENCH_TIMER_LIVE_DELAY - NextRandom(pClient->uiSeed) % ROSABENCH_TIMER_CHURN_MIN);
+		bool bKill = (ullTimerID != 0) && pLoop->CRosaEventLoopKillTimer(ullTimerID);
+
+		pBench->m_Latency.CRosaHistogramRecordSince(llStart);
+
+		if (ullTimerID == 0 || !bReset || !bKill)
+		{
+			pClient->ullErrors++;
+			continue;
+		}
+
+		pClient->ullOps += 3;
+	}
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnTimer()
+// @Purpose: CRosaBenchTimerʱ(ȫʱɾ֮ǰӦ)
+// @Since: v1.00a
+// @Para: ULONGLONG ullTimerID(ʱID)
+// @Para: void* pUser(Զ)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaBenchTimer::OnTimer(ULONGLONG ullTimerID, void * pUser)
+{
+	CRosaBenchTimer* pBench = reinterpret_cast<CRosaBenchTimer*>(pUser);
+
+	InterlockedIncrement(&pBench->m_lFired);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAccept()
+// @Purpose: CRosaBenchTimer(Խ, շ, ɿмʱر)
+// @Since: v1.00a
+// @Para: void* pContext(Զ)
+// @Para: SOCKET s(ͻ׽)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchTimer::OnAccept(void * pContext, SOCKET s, USHORT nShard)
+{
+	CRosaBenchTimer* pBench = reinterpret_cast<CRosaBenchTimer*>(pContext);
+
+	EnterCriticalSection(&pBench->m_csAccepted);
+	pBench->m_vecAccepted.push_back(s);
+	LeaveCriticalSection(&pBench->m_csAccepted);
+}
+
+//------------------------------------------------------------------
+// @Function:	 NextRandom()
+// @Purpose: CRosaBenchTimer߳(xorshift32, ʹrandȫ״̬)
+// @Since: v1.00a
+// @Para: UINT& uiSeed(״̬)
+// @Return: UINT uiRandom
+//------------------------------------------------------------------
+UINT CRosaBenchTimer::NextRandom(UINT & uiSeed)
+{
+	uiSeed ^= uiSeed << 13;
+	uiSeed ^= uiSeed >> 17;
+	uiSeed ^= uiSeed << 5;
+
+	return uiSeed;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchTimerUsage()
+// @Purpose: CRosaBenchTimerѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchTimer::CRosaBenchTimerUsage()
+{
+	fprintf(stderr,
+		"  --timer-threads <list> threads starting, resetting and cancelling timers (default: " ROSABENCH_DEFAULT_TIMER_THREADS ")\n"
+		"  --timer-live <list>    timers already in the wheel during churn (default: " ROSABENCH_DEFAULT_TIMER_LIVE ")\n"
+		"  --idle-conns <n>       silent connections the server must reap (default: %d)\n"
+		"  --idle-ms <n>          server idle timeout for the reap check (default: %d)\n",
+		ROSABENCH_DEFAULT_IDLE_CONNS, ROSABENCH_DEFAULT_IDLE_MSEC);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchTimerParse()
+// @Purpose: CRosaBenchTimerѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchTimer::CRosaBenchTimerParse(const char * pcArg, const char * pcValue)
+{
+	bool bOk = false;
+
+	if (strcmp(pcArg, "--timer-threads") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecTimerThread);
+	}
+	else if (strcmp(pcArg, "--timer-live") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecTimerLive);
+	}
+	else if (strcmp(pcArg, "--idle-conns") == 0)
+	{
+		g_uiIdleConns = strtoul(pcValue, NULL, 10);
+		bOk = (g_uiIdleConns > 0);
+	}
+	else if (strcmp(pcArg, "--idle-ms") == 0)
+	{
+		g_uiIdleMSec = strtoul(pcValue, NULL, 10);
+		bOk = (g_uiIdleMSec > 0);
+	}
+	else
+	{
+		return ROSABENCH_PARSE_UNKNOWN;
+	}
+
+	return bOk ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchTimerMain()
+// @Purpose: CRosaBenchTimerȫ(жʱ*߳)лղ
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchTimer::CRosaBenchTimerMain(const S_BENCHCOMMON & sCommon)
+{
+	if (g_vecTimerThread.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_TIMER_THREADS, g_vecTimerThread);
+	}
+
+	if (g_vecTimerLive.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_TIMER_LIVE, g_vecTimerLive);
+	}
+
+	CRosaBenchTimer BenchTimer;
+
+	for (size_t l = 0; l < g_vecTimerLive.size(); ++l)
+	{
+		for (size_t t = 0; t < g_vecTimerThread.size(); ++t)
+		{
+			S_TIMERBENCHCONFIG sConfig = { g_vecTimerThread[t], g_vecTimerLive[l], sCommon.uiSeconds };
+			BenchOutput(BenchTimer.CRosaBenchTimerChurnRun(sConfig));
+		}
+	}
+
+	S_IDLEBENCHCONFIG sIdle = { g_uiIdleConns, g_uiIdleMSec, sCommon.sPort };
+	BenchOutput(BenchTimer.CRosaBenchTimerIdleRun(sIdle));
+}
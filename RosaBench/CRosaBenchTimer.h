@@ -0,0 +1,95 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchTimer.h
+* @brief	This File is RosaBenchTimer Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHTIMER_H__
+#define __CROSABENCHTIMER_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Include Rosa Header File
+#include "../Rosa/CRosaEventLoop.h"
+
+//Macro Definition
+#define ROSABENCH_TIMER_LIVE_DELAY		600000			//פʱʱ(, ڼ䲻)
+#define ROSABENCH_TIMER_CHURN_MIN		1000			//õĶʱ̵ʱ(, ɾ֮ǰ)
+#define ROSABENCH_TIMER_IDLE_GRACE		3000			//лղԳʱȴʱ()
+
+#define ROSABENCH_DEFAULT_TIMER_THREADS	"1,4"			//Ĭ϶ʱ߳
+#define ROSABENCH_DEFAULT_TIMER_LIVE	"1K,100K"		//ĬʱеĶʱ
+#define ROSABENCH_DEFAULT_IDLE_CONNS	1000			//ĬϷҪյĿ
+#define ROSABENCH_DEFAULT_IDLE_MSEC		1000			//ĬϿлղԵĿгʱ()
+
+//Struct Definition
+typedef struct
+{
+	UINT uiThreads;				// /ɾ߳
+	UINT uiLive;				// פʱ(ʱеĸ)
+	UINT uiSeconds;				// ʱ
+}S_TIMERBENCHCONFIG, *LPS_TIMERBENCHCONFIG;
+
+typedef struct
+{
+	UINT uiConnections;			// 
+	UINT uiIdleMSec;			// ˿гʱ()
+	USHORT sPort;				// ˿
+}S_IDLEBENCHCONFIG, *LPS_IDLEBENCHCONFIG;
+
+//Class Declaration
+class CRosaBenchTimer;
+
+typedef struct
+{
+	CRosaBenchTimer* pBench;	// 
+	UINT uiSeed;				// ״̬
+	ULONGLONG ullOps;			// ɵĶʱ(ááɾһ)
+	ULONGLONG ullErrors;		// ʧܴ
+}S_TIMERBENCHCLIENT, *LPS_TIMERBENCHCLIENT;
+
+//Class Definition
+class CRosaBenchTimer
+{
+public:
+	CRosaBenchTimer();			// CRosaBenchTimer 캯
+	~CRosaBenchTimer();			// CRosaBenchTimer 
+
+public:
+	string CRosaBenchTimerChurnRun(const S_TIMERBENCHCONFIG& sConfig);	// CRosaBenchTimer ʱ//ɾ(JSON)
+	string CRosaBenchTimerIdleRun(const S_IDLEBENCHCONFIG& sConfig);	// CRosaBenchTimer Ӱʱ(JSON)
+
+	static void CRosaBenchTimerUsage();												// CRosaBenchTimer ѡ˵
+	static int CRosaBenchTimerParse(const char* pcArg, const char* pcValue);			// CRosaBenchTimer ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchTimerMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchTimer ȫ
+
+private:
+	static unsigned __stdcall OnChurnThread(void* pParam);									// CRosaBenchTimer /ɾ߳
+	static void __stdcall OnTimer(ULONGLONG ullTimerID, void* pUser);						// CRosaBenchTimer ʱ(ڼ䲻Ӧ)
+	static void OnAccept(void* pContext, SOCKET s, USHORT nShard);							// CRosaBenchTimer (, շ)
+
+	static UINT NextRandom(UINT& uiSeed);							// CRosaBenchTimer ߳
+
+private:
+	S_TIMERBENCHCONFIG m_sConfig;				// CRosaBenchTimer ǰԲ
+	CRosaEventLoop* m_pLoop;					// CRosaBenchTimer ¼ѭ(ʱʱ)
+	vector<ULONGLONG> m_vecLive;				// CRosaBenchTimer פʱ
+	volatile LONG m_lFired;						// CRosaBenchTimer ڼ䵽ڵĶʱ
+	HANDLE m_hStartEvent;						// CRosaBenchTimer ߳ͬʱʼ
+	CRosaHistogram m_Latency;					// CRosaBenchTimer ÿ(++ɾ)ʱ
+
+	CRosaBenchServer m_Server;					// CRosaBenchTimer лղԷ
+	CRITICAL_SECTION m_csAccepted;				// CRosaBenchTimer ѽٽ
+	vector<SOCKET> m_vecAccepted;				// CRosaBenchTimer ѽܵ
+
+};
+
+#endif // !__CROSABENCHTIMER_H__
@@ -0,0 +1,355 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchTrace.cpp
+* @brief	This File is RosaBenchTrace Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchTrace.h"
+
+//Include C/C++ Header File
+#include <process.h>
+#include <stdio.h>
+
+//CRosaBenchTrace ٵ(ûи߼ûصʱÿٵĿ, Լػ»صյĸٵ)
+
+// ʽ
+static const char* g_pcTraceModeName[ROSABENCH_TRACE_COUNT] = { "probe_off", "probe_on", "loopback_off", "loopback_on" };
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchTrace()
+// @Purpose: CRosaBenchTrace캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchTrace::CRosaBenchTrace()
+{
+	memset(&m_sConfig, 0, sizeof(m_sConfig));
+
+	m_bExit = FALSE;
+	m_lServerConn = 0;
+
+	memset((void*)m_lEvents, 0, sizeof(m_lEvents));
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchTrace()
+// @Purpose: CRosaBenchTrace
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchTrace::~CRosaBenchTrace()
+{
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchTraceRun()
+// @Purpose: CRosaBenchTraceһ(صʽȡص; ETWỰʱûиߵĽ, active)
+// @Since: v1.00a
+// @Para: const S_TRACEBENCHCONFIG& sConfig(Բ)
+// @Return: string strJson ()
+//------------------------------------------------------------------
+string CRosaBenchTrace::CRosaBenchTraceRun(const S_TRACEBENCHCONFIG & sConfig)
+{
+	char chHead[512] = { 0 };
+
+	m_sConfig = sConfig;
+
+	bool bCallback = (m_sConfig.nMode == ROSABENCH_TRACE_PROBE_ON || m_sConfig.nMode == ROSABENCH_TRACE_LOOPBACK_ON);
+
+	memset((void*)m_lEvents, 0, sizeof(m_lEvents));
+	CRosaTrace::CRosaTraceSetCallback(bCallback ? OnTrace : NULL, (DWORD_PTR)this);
+
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"trace\",\"mode\":\"%s\",\"active\":%s",
+		CRosaBenchTraceGetModeName(m_sConfig.nMode), CRosaTrace::s_lActive ? "true" : "false");
+
+	string strJson = (m_sConfig.nMode == ROSABENCH_TRACE_PROBE_OFF || m_sConfig.nMode == ROSABENCH_TRACE_PROBE_ON) ? RunProbe(chHead) : RunLoopback(chHead);
+
+	CRosaTrace::CRosaTraceSetCallback(NULL, 0);
+
+	return strJson;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchTraceGetModeName()
+// @Purpose: CRosaBenchTraceȡԷʽ
+// @Since: v1.00a
+// @Para: int nMode(ROSABENCH_TRACE_*)
+// @Return: const char* pcName
+//------------------------------------------------------------------
+const char * CRosaBenchTrace::CRosaBenchTraceGetModeName(int nMode)
+{
+	if (nMode < 0 || nMode >= ROSABENCH_TRACE_COUNT)
+	{
+		return "";
+	}
+
+	return g_pcTraceModeName[nMode];
+}
+
+//------------------------------------------------------------------
+// @Function:	 RunProbe()
+// @Purpose: CRosaBenchTraceѭٵ㿪(ͬROSA_TRACE, صʽص)
+// @Since: v1.00a
+// @Para: const char* pcHead(ͷ)
+// @Return: string strJson ()
+//------------------------------------------------------------------
+string CRosaBenchTrace::RunProbe(const char * pcHead)
+{
+	CRosaHistogram Batch;
+	Batch.CRosaHistogramCreate(1);
+
+	LARGE_INTEGER liFrequency;
+	QueryPerformanceFrequency(&liFrequency);
+
+	ULONGLONG ullProbes = 0;
+	LONGLONG llElapsed = 0;
+	LONGLONG llDeadline = CRosaHistogram::CRosaHistogramNow() + liFrequency.QuadPart * m_sConfig.uiSeconds;
+
+	for (;;)
+	{
+		LONGLONG llBatch = CRosaHistogram::CRosaHistogramNow();
+		if (llBatch >= llDeadline)
+		{
+			break;
+		}
+
+		for (UINT i = 0; i < ROSABENCH_TRACE_BATCH; ++i)
+		{
+			ROSA_TRACE(ROSA_TRACE_SEND, i, 0);
+		}
+
+		LONGLONG llUsed = CRosaHistogram::CRosaHistogramNow() - llBatch;
+
+		llElapsed += llUsed;
+		ullProbes += ROSABENCH_TRACE_BATCH;
+		Batch.CRosaHistogramRecord(CRosaHistogram::CRosaHistogramToNanoSec(llUsed) / ROSABENCH_TRACE_BATCH);
+	}
+
+	// صʽÿδӦص(Ϊ32λ, 32λȽ)
+	ULONGLONG ullCallbacks = (ULONG)m_lEvents[ROSA_TRACE_SEND];
+	bool bCallback = (m_sConfig.nMode == ROSABENCH_TRACE_PROBE_ON);
+
+	char chResult[512] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"probes\":%llu,\"callbacks\":%llu,\"events_ok\":%s,\"ns_per_probe\":%.2f,\"batch_ns_per_probe\":",
+		ullProbes, ullCallbacks, (bCallback ? (ullCallbacks == (ULONG)ullProbes) : (ullCallbacks == 0)) ? "true" : "false",
+		ullProbes ? (double)CRosaHistogram::CRosaHistogramToNanoSec(llElapsed) / ullProbes : 0.0);
+
+	return string("{") + pcHead + chResult + BenchSummaryJson(Batch) + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 RunLoopback()
+// @Purpose: CRosaBenchTraceػ(һ, صʽܡͼոٵ㶼Ѵ)
+// @Since: v1.00a
+// @Para: const char* pcHead(ͷ)
+// @Return: string strJson ()
+//------------------------------------------------------------------
+string CRosaBenchTrace::RunLoopback(const char * pcHead)
+{
+	m_bExit = FALSE;
+	m_lServerConn = 0;
+
+	if (!m_Server.CRosaBenchServerStart(m_sConfig.sPort, OnAccept, this))
+	{
+		char chError[128] = { 0 };
+		sprintf_s(chError, sizeof(chError), ",\"error\":\"listen failed (WSA %d)\"}", m_Server.CRosaBenchServerGetError());
+
+		return string("{") + pcHead + chError;
+	}
+
+	CRosaSocket Client;
+	CRosaHistogram RoundTrip;
+	RoundTrip.CRosaHistogramCreate(1);
+
+	ULONGLONG ullRoundTrips = 0;
+	ULONGLONG ullErrors = 0;
+	double dSeconds = 0.0;
+	double dCpu = 0.0;
+
+	if (Client.CRosaSocketConnect("127.0.0.1", m_sConfig.sPort))
+	{
+		char chMessage[ROSABENCH_TRACE_MESSAGE];
+		memset(chMessage, 'R', sizeof(chMessage));
+
+		LARGE_INTEGER liFrequency;
+		QueryPerformanceFrequency(&liFrequency);
+
+		S_BENCHCPU sCpu;
+		BenchCpuStart(sCpu);
+
+		LONGLONG llDeadline = CRosaHistogram::CRosaHistogramNow() + liFrequency.QuadPart * m_sConfig.uiSeconds;
+
+		while (CRosaHistogram::CRosaHistogramNow() < llDeadline)
+		{
+			LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+
+			if (Client.CRosaSocketSendBuffer(chMessage, sizeof(chMessage)) != SOB_RET_OK ||
+				Client.CRosaSocketRecvBuffer(chMessage, sizeof(chMessage), sizeof(chMessage)) != SOB_RET_OK)
+			{
+				ullErrors++;
+				break;
+			}
+
+			RoundTrip.CRosaHistogramRecordSince(llStart);
+			ullRoundTrips++;
+		}
+
+		dCpu = BenchCpuStop(sCpu, dSeconds);
+
+		Client.CRosaSocketDisConnect();
+	}
+	else
+	{
+		ullErrors++;
+	}
+
+	// ֹͣ(߳1ڷ), ߳ڿͻ˶Ͽ˳
+	m_bExit = TRUE;
+	m_Server.CRosaBenchServerStop();
+
+	for (DWORD dwWait = 0; m_lServerConn > 0 && dwWait < 5000; dwWait += 10)
+	{
+		Sleep(10);
+	}
+
+	// ÿ˫һηͼһν
+	LONG lAccept = m_lEvents[ROSA_TRACE_ACCEPT];
+	LONG lSend = m_lEvents[ROSA_TRACE_SEND];
+	LONG lRecv = m_lEvents[ROSA_TRACE_RECV];
+	LONG lLock = m_lEvents[ROSA_TRACE_LOCK];
+
+	bool bCallback = (m_sConfig.nMode == ROSABENCH_TRACE_LOOPBACK_ON);
+	bool bEventsOk = bCallback ? (lAccept >= 1 && (ULONGLONG)lSend >= ullRoundTrips * 2 && (ULONGLONG)lRecv >= ullRoundTrips * 2)
+		: (lAccept == 0 && lSend == 0 && lRecv == 0);
+
+	char chResult[640] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"seconds\":%.3f,\"round_trips\":%llu,\"errors\":%llu,\"round_trips_per_sec\":%.1f,\"accept_events\":%ld,\"send_events\":%ld,\"recv_events\":%ld,\"lock_events\":%ld,\"events_ok\":%s,\"cpu_percent\":%.1f,\"round_trip_ns\":",
+		dSeconds, ullRoundTrips, ullErrors, (dSeconds > 0.0) ? ullRoundTrips / dSeconds : 0.0,
+		lAccept, lSend, lRecv, lLock, bEventsOk ? "true" : "false", dCpu);
+
+	return string("{") + pcHead + chResult + BenchSummaryJson(RoundTrip) + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnTrace()
+// @Purpose: CRosaBenchTraceٻص(߳ͬ, ֻ)
+// @Since: v1.00a
+// @Para: int nEvent(ROSA_TRACE_*)
+// @Para: ULONG_PTR ulHandle()
+// @Para: LONG lResult()
+// @Para: DWORD_PTR dwUser(Զ)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaBenchTrace::OnTrace(int nEvent, ULONG_PTR ulHandle, LONG lResult, DWORD_PTR dwUser)
+{
+	CRosaBenchTrace* pBench = reinterpret_cast<CRosaBenchTrace*>(dwUser);
+
+	if (nEvent >= 0 && nEvent < ROSA_TRACE_COUNT)
+	{
+		InterlockedIncrement(&pBench->m_lEvents[nEvent]);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAccept()
+// @Purpose: CRosaBenchTrace
+// @Since: v1.00a
+// @Para: void* pContext(Զ)
+// @Para: SOCKET s(ͻ׽)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchTrace::OnAccept(void * pContext, SOCKET s, USHORT nShard)
+{
+	CRosaBenchTrace* pBench = reinterpret_cast<CRosaBenchTrace*>(pContext);
+
+	BenchStartConnThread(OnServerConn, pBench, s, pBench->m_lServerConn);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnServerConn()
+// @Purpose: CRosaBenchTrace߳(һϢ, ͻ˹رպ˳)
+// @Since: v1.00a
+// @Para: void* pParam(S_BENCHCONN)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchTrace::OnServerConn(void * pParam)
+{
+	LPS_BENCHCONN pConn = reinterpret_cast<LPS_BENCHCONN>(pParam);
+	CRosaBenchTrace* pBench = reinterpret_cast<CRosaBenchTrace*>(pConn->pContext);
+
+	CRosaSocket Conn;
+	Conn.CRosaSocketAttachRawSocket(pConn->Socket, true);
+	delete pConn;
+
+	char chMessage[ROSABENCH_TRACE_MESSAGE];
+
+	while (true)
+	{
+		int nRet = Conn.CRosaSocketRecvBuffer(chMessage, sizeof(chMessage), sizeof(chMessage), 1);
+
+		if (nRet == SOB_RET_TIMEOUT && !pBench->m_bExit)
+		{
+			continue;
+		}
+
+		if (nRet != SOB_RET_OK || Conn.CRosaSocketSendBuffer(chMessage, sizeof(chMessage)) != SOB_RET_OK)
+		{
+			break;
+		}
+	}
+
+	Conn.CRosaSocketDisConnect();
+
+	InterlockedDecrement(&pBench->m_lServerConn);
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchTraceUsage()
+// @Purpose: CRosaBenchTraceѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchTrace::CRosaBenchTraceUsage()
+{
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchTraceParse()
+// @Purpose: CRosaBenchTraceѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchTrace::CRosaBenchTraceParse(const char * pcArg, const char * pcValue)
+{
+	return ROSABENCH_PARSE_UNKNOWN;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchTraceMain()
+// @Purpose: CRosaBenchTraceȫԷʽ
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchTrace::CRosaBenchTraceMain(const S_BENCHCOMMON & sCommon)
+{
+	CRosaBenchTrace BenchTrace;
+
+	for (int m = 0; m < ROSABENCH_TRACE_COUNT; ++m)
+	{
+		S_TRACEBENCHCONFIG sConfig = { m, sCommon.uiSeconds, sCommon.sPort };
+		BenchOutput(BenchTrace.CRosaBenchTraceRun(sConfig));
+	}
+}
@@ -0,0 +1,76 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchTrace.h
+* @brief	This File is RosaBenchTrace Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHTRACE_H__
+#define __CROSABENCHTRACE_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Include Rosa Header File
+#include "../Rosa/CRosaTrace.h"
+
+//Macro Definition
+#define ROSABENCH_TRACE_PROBE_OFF		0				//ѭٵ(ûи)
+#define ROSABENCH_TRACE_PROBE_ON		1				//ѭٵ(üص)
+#define ROSABENCH_TRACE_LOOPBACK_OFF	2				//ػ(ûи)
+#define ROSABENCH_TRACE_LOOPBACK_ON		3				//ػ(üص, ٵ)
+#define ROSABENCH_TRACE_COUNT			4
+
+#define ROSABENCH_TRACE_BATCH			4096			//ѭÿ
+#define ROSABENCH_TRACE_MESSAGE			64				//ػϢ
+
+//Struct Definition
+typedef struct
+{
+	int nMode;					// Էʽ(ROSABENCH_TRACE_*)
+	UINT uiSeconds;				// ʱ
+	USHORT sPort;				// ˿
+}S_TRACEBENCHCONFIG, *LPS_TRACEBENCHCONFIG;
+
+//Class Definition
+class CRosaBenchTrace
+{
+public:
+	CRosaBenchTrace();			// CRosaBenchTrace 캯
+	~CRosaBenchTrace();			// CRosaBenchTrace 
+
+public:
+	string CRosaBenchTraceRun(const S_TRACEBENCHCONFIG& sConfig);		// CRosaBenchTrace һ(JSON)
+
+	static const char* CRosaBenchTraceGetModeName(int nMode);			// CRosaBenchTrace ȡԷʽ
+
+	static void CRosaBenchTraceUsage();												// CRosaBenchTrace ѡ˵
+	static int CRosaBenchTraceParse(const char* pcArg, const char* pcValue);			// CRosaBenchTrace ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchTraceMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchTrace ȫ
+
+private:
+	static void __stdcall OnTrace(int nEvent, ULONG_PTR ulHandle, LONG lResult, DWORD_PTR dwUser);	// CRosaBenchTrace ٻص(ٵ)
+	static void OnAccept(void* pContext, SOCKET s, USHORT nShard);							// CRosaBenchTrace 
+	static unsigned __stdcall OnServerConn(void* pParam);									// CRosaBenchTrace ߳()
+
+	string RunProbe(const char* pcHead);							// CRosaBenchTrace ѭٵ㿪
+	string RunLoopback(const char* pcHead);							// CRosaBenchTrace ػͳƸٵ
+
+private:
+	S_TRACEBENCHCONFIG m_sConfig;				// CRosaBenchTrace ǰԲ
+
+	CRosaBenchServer m_Server;					// CRosaBenchTrace (ÿ¼)
+	BOOL m_bExit;								// CRosaBenchTrace ˳־
+	volatile LONG m_lServerConn;				// CRosaBenchTrace ߳
+
+	volatile LONG m_lEvents[ROSA_TRACE_COUNT];	// CRosaBenchTrace ٵص
+
+};
+
+#endif // !__CROSABENCHTRACE_H__
@@ -0,0 +1,675 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchUdp.cpp
+* @brief	This File is RosaBenchUdp Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchUdp.h"
+
+//Include Windows Header File
+#include <iphlpapi.h>
+
+//Include C/C++ Header File
+#include <process.h>
+#include <stdio.h>
+
+//Include Windows Library
+#pragma comment(lib, "iphlpapi.lib")
+
+//CRosaBenchUdp UDPػ(ӿCRosaSocketUDPSendBuffer/CRosaSocketUDPRecvBufferӿCRosaSocketUDPSendBatch/CRosaSocketUDPRecvBatch, ͳƶ)
+
+// ѡ(бʱȡĬֵ)
+static vector<UINT> g_vecUdpSize;
+static vector<UINT> g_vecUdpSender;
+static vector<UINT> g_vecUdpRate;
+static UINT g_uiUdpRecvBuffer = 0;
+static bool g_bUdpSingle = true;
+static bool g_bUdpBatch = true;
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchUdp()
+// @Purpose: CRosaBenchUdp캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchUdp::CRosaBenchUdp()
+{
+	m_hRecvThread = NULL;
+	m_bExit = FALSE;
+	m_sPort = 0;
+	m_uiRecvBuffer = 0;
+	m_bRecvBatch = false;
+
+	memset(&m_sConfig, 0, sizeof(m_sConfig));
+	m_lRun = 0;
+	m_lRecvRun = 0;
+	memset(m_sPeer, 0, sizeof(m_sPeer));
+	m_lRecvCount = 0;
+	m_lRecvCalls = 0;
+	m_hStartEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+
+	m_Latency.CRosaHistogramCreate();
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchUdp()
+// @Purpose: CRosaBenchUdp
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchUdp::~CRosaBenchUdp()
+{
+	CRosaBenchUdpStop();
+
+	if (m_hStartEvent)
+	{
+		CloseHandle(m_hStartEvent);
+		m_hStartEvent = NULL;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchUdpStart()
+// @Purpose: CRosaBenchUdpն
+// @Since: v1.00a
+// @Para: USHORT sPort(ն˿)
+// @Para: UINT uiRecvBufferKB(ջ, 0:ϵͳĬ)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool CRosaBenchUdp::CRosaBenchUdpStart(USHORT sPort, UINT uiRecvBufferKB)
+{
+	if (!m_Receiver.CRosaSocketUDPBindOnPort("127.0.0.1", sPort))
+	{
+		return false;
+	}
+
+	if (uiRecvBufferKB > 0)
+	{
+		m_Receiver.CRosaSocketSetRecvBufferSize(uiRecvBufferKB * 1024);
+	}
+
+	// ¼ʵЧĽջ(ֱֵ)
+	int nRecvBuffer = 0;
+	int nLen = sizeof(nRecvBuffer);
+	getsockopt(m_Receiver.CRosaSocketGetRawSocket(), SOL_SOCKET, SO_RCVBUF, (char*)&nRecvBuffer, &nLen);
+	m_uiRecvBuffer = (UINT)nRecvBuffer;
+
+	m_sPort = sPort;
+	m_bExit = FALSE;
+
+	m_hRecvThread = (HANDLE)_beginthreadex(NULL, 0, OnRecvThread, this, 0, NULL);
+
+	return (m_hRecvThread != NULL);
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchUdpStop()
+// @Purpose: CRosaBenchUdpֹͣն
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchUdp::CRosaBenchUdpStop()
+{
+	if (m_hRecvThread)
+	{
+		m_bExit = TRUE;
+		WaitForSingleObject(m_hRecvThread, INFINITE);
+		CloseHandle(m_hRecvThread);
+		m_hRecvThread = NULL;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchUdpRun()
+// @Purpose: CRosaBenchUdpһ
+// @Since: v1.00a
+// @Para: const S_UDPBENCHCONFIG& sConfig(Բ)
+// @Return: string strJson ()
+//------------------------------------------------------------------
+string CRosaBenchUdp::CRosaBenchUdpRun(const S_UDPBENCHCONFIG & sConfig)
+{
+	char chHead[512] = { 0 };
+
+	m_sConfig = sConfig;
+	m_sConfig.uiSize = (m_sConfig.uiSize < sizeof(S_UDPBENCHHEADER)) ? sizeof(S_UDPBENCHHEADER) : ((m_sConfig.uiSize > ROSABENCH_UDP_MAX_SIZE) ? ROSABENCH_UDP_MAX_SIZE : m_sConfig.uiSize);
+	m_sConfig.uiSenders = (m_sConfig.uiSenders < 1) ? 1 : ((m_sConfig.uiSenders > ROSABENCH_UDP_MAX_SENDERS) ? ROSABENCH_UDP_MAX_SENDERS : m_sConfig.uiSenders);
+
+	// շʽһ鲻ͬʱ߳
+	bool bRecvReady = SetRecvBatch(m_sConfig.bBatch);
+
+	sprintf_s(chHead, sizeof(chHead), "\"benchmark\":\"udp\",\"mode\":\"%s\",\"size\":%u,\"senders\":%u,\"rate\":%u,\"rcvbuf\":%u,\"recv_offload\":%s",
+		m_sConfig.bBatch ? "batch" : "single", m_sConfig.uiSize, m_sConfig.uiSenders, m_sConfig.uiRate, m_uiRecvBuffer,
+		m_Receiver.CRosaSocketUDPIsRecvOffload() ? "true" : "false");
+
+	if (!bRecvReady)
+	{
+		return string("{") + chHead + ",\"error\":\"receiver\"}";
+	}
+
+	// ±֮ǰݱɽ̶߳, ߳յ±ŵĵһݱʱͳ
+	LONG lRun = InterlockedIncrement(&m_lRun);
+
+	vector<S_UDPBENCHSENDER> vecSender(m_sConfig.uiSenders);
+	vector<HANDLE> vecThread;
+
+	for (UINT i = 0; i < m_sConfig.uiSenders; ++i)
+	{
+		memset(&vecSender[i], 0, sizeof(S_UDPBENCHSENDER));
+		vecSender[i].pBench = this;
+		vecSender[i].dwSender = i;
+
+		HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, OnSenderThread, &vecSender[i], 0, NULL);
+		if (hThread)
+		{
+			vecThread.push_back(hThread);
+		}
+	}
+
+	m_Latency.CRosaHistogramReset();
+
+	DWORD dwInErrors = UdpInErrors();
+	LONG lRecvCount = m_lRecvCount;
+	LONG lRecvCalls = m_lRecvCalls;
+	ULONGLONG ullRecvCpu = ThreadCpuTime(m_hRecvThread);
+
+	S_BENCHCPU sCpu;
+	BenchCpuStart(sCpu);
+	SetEvent(m_hStartEvent);
+
+	for (size_t i = 0; i < vecThread.size(); ++i)
+	{
+		WaitForSingleObject(vecThread[i], INFINITE);
+		CloseHandle(vecThread[i]);
+	}
+
+	double dSendSeconds = CRosaHistogram::CRosaHistogramToNanoSec(CRosaHistogram::CRosaHistogramNow() - sCpu.llWall) / 1e9;
+	ResetEvent(m_hStartEvent);
+
+	// ſսջеʣݱ, նCPUհʰſʱ
+	WaitDrain();
+
+	double dSeconds = 0.0;
+	double dCpu = BenchCpuStop(sCpu, dSeconds);
+	ullRecvCpu = ThreadCpuTime(m_hRecvThread) - ullRecvCpu;
+	dwInErrors = UdpInErrors() - dwInErrors;
+	lRecvCount = m_lRecvCount - lRecvCount;
+	lRecvCalls = m_lRecvCalls - lRecvCalls;
+
+	// (ûյκݱʱͳһ)
+	bool bReceived = (m_lRecvRun == lRun);
+
+	ULONGLONG ullSent = 0;
+	ULONGLONG ullErrors = 0;
+	ULONGLONG ullReceived = 0;
+	ULONGLONG ullLost = 0;
+	ULONGLONG ullGaps = 0;
+	ULONGLONG ullLate = 0;
+	ULONGLONG ullSendCalls = 0;
+	bool bSendOffload = false;
+
+	for (UINT i = 0; i < m_sConfig.uiSenders; ++i)
+	{
+		ullSent += vecSender[i].ullSent;
+		ullErrors += vecSender[i].ullErrors;
+		ullSendCalls += vecSender[i].ullCalls;
+		bSendOffload = bSendOffload || vecSender[i].bOffload;
+
+		if (!bReceived)
+		{
+			ullLost += vecSender[i].ullSent;
+			continue;
+		}
+
+		const S_UDPBENCHPEER& sPeer = m_sPeer[i];
+		ullReceived += sPeer.ullReceived;
+		ullLate += sPeer.ullLate;
+		ullGaps += sPeer.ullGaps;
+
+		// ϶ʧһյ֮βʧ
+		ullLost += sPeer.ullLost;
+		if (vecSender[i].ullSent > sPeer.ullNextSeq)
+		{
+			ullLost += vecSender[i].ullSent - sPeer.ullNextSeq;
+			ullGaps++;
+		}
+	}
+
+	char chResult[1024] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"send_offload\":%s,\"seconds\":%.3f,\"sent\":%llu,\"send_errors\":%llu,\"received\":%llu,\"lost\":%llu,\"loss_percent\":%.3f,\"gaps\":%llu,\"late\":%llu,\"udp_in_errors\":%lu,"
+		"\"sent_pps\":%.1f,\"recv_pps\":%.1f,\"mb_per_sec\":%.3f,\"datagrams_per_send\":%.2f,\"datagrams_per_recv\":%.2f,\"recv_cpu_percent\":%.1f,\"cpu_percent\":%.1f,\"latency_ns\":",
+		bSendOffload ? "true" : "false", dSendSeconds, ullSent, ullErrors, ullReceived, ullLost, (ullSent > 0) ? ullLost * 100.0 / ullSent : 0.0, ullGaps, ullLate, dwInErrors,
+		(dSendSeconds > 0.0) ? ullSent / dSendSeconds : 0.0,
+		(dSeconds > 0.0) ? ullReceived / dSeconds : 0.0,
+		(dSeconds > 0.0) ? (double)ullReceived * m_sConfig.uiSize / dSeconds / (1024.0 * 1024.0) : 0.0,
+		(ullSendCalls > 0) ? (double)ullSent / ullSendCalls : 0.0,
+		(lRecvCalls > 0) ? (double)lRecvCount / lRecvCalls : 0.0,
+		(dSeconds > 0.0) ? ullRecvCpu / 1e7 * 100.0 / dSeconds : 0.0,
+		dCpu);
+
+	return string("{") + chHead + chResult + BenchSummaryJson(m_Latency) + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnRecvThread()
+// @Purpose: CRosaBenchUdp߳(, ˳־λ1ڷ)
+// @Since: v1.00a
+// @Para: void* pParam(Զ)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchUdp::OnRecvThread(void * pParam)
+{
+	CRosaBenchUdp* pBench = reinterpret_cast<CRosaBenchUdp*>(pParam);
+
+	// յĻһκϲ󳤶
+	UINT uiBufferSize = pBench->m_bRecvBatch ? SOB_UDP_OFFLOAD_MAX_BYTES + ROSABENCH_UDP_MAX_SIZE : ROSABENCH_UDP_MAX_SIZE;
+	char* pBuffer = new char[uiBufferSize];
+	char chIP[SOB_IP_LENGTH] = { 0 };
+	USHORT uPort = 0;
+	S_UDPDATAGRAM sDatagrams[ROSABENCH_UDP_RECV_BATCH];
+
+	while (!pBench->m_bExit)
+	{
+		if (pBench->m_bRecvBatch)
+		{
+			UINT uiDatagrams = 0;
+			int nRet = pBench->m_Receiver.CRosaSocketUDPRecvBatch(pBuffer, uiBufferSize, sDatagrams, ROSABENCH_UDP_RECV_BATCH, uiDatagrams, chIP, uPort, 1);
+
+			// ضʱѲֵݱȻЧ
+			if (nRet == SOB_RET_OK || uiDatagrams > 0)
+			{
+				for (UINT i = 0; i < uiDatagrams; ++i)
+				{
+					pBench->RecvDatagram(sDatagrams[i].pBuffer, sDatagrams[i].uiSize);
+				}
+
+				InterlockedIncrement(&pBench->m_lRecvCalls);
+			}
+
+			continue;
+		}
+
+		UINT uiRecv = 0;
+		int nRet = pBench->m_Receiver.CRosaSocketUDPRecvBuffer(pBuffer, uiBufferSize, uiRecv, chIP, uPort, 1);
+
+		if (nRet == SOB_RET_OK)
+		{
+			pBench->RecvDatagram(pBuffer, uiRecv);
+			InterlockedIncrement(&pBench->m_lRecvCalls);
+		}
+	}
+
+	delete[] pBuffer;
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnSenderThread()
+// @Purpose: CRosaBenchUdp߳(ʾȷ, ǰʱóSleep, ⰴʱڳ; ģʽÿύݱ, ʰݱ)
+// @Since: v1.00a
+// @Para: void* pParam(S_UDPBENCHSENDER)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchUdp::OnSenderThread(void * pParam)
+{
+	LPS_UDPBENCHSENDER pSender = reinterpret_cast<LPS_UDPBENCHSENDER>(pParam);
+	CRosaBenchUdp* pBench = pSender->pBench;
+	UINT uiSize = pBench->m_sConfig.uiSize;
+
+	CRosaSocket Sender;
+
+	// ģʽÿη͵ݱ(жطͲSOB_UDP_OFFLOAD_MAX_BYTES)
+	UINT uiBatch = 1;
+	if (pBench->m_sConfig.bBatch)
+	{
+		uiBatch = SOB_UDP_OFFLOAD_MAX_BYTES / uiSize;
+		uiBatch = (uiBatch < 1) ? 1 : ((uiBatch > ROSABENCH_UDP_BATCH) ? ROSABENCH_UDP_BATCH : uiBatch);
+
+		// ֧жʱCRosaSocketUDPSendBatch, Ȼӿڱ
+		Sender.CRosaSocketUDPSetOffload(true, false, (USHORT)uiSize);
+		pSender->bOffload = Sender.CRosaSocketUDPIsSendOffload();
+	}
+
+	char* pBuffer = new char[uiSize * uiBatch];
+	memset(pBuffer, 'R', uiSize * uiBatch);
+
+	for (UINT i = 0; i < uiBatch; ++i)
+	{
+		LPS_UDPBENCHHEADER pHeader = reinterpret_cast<LPS_UDPBENCHHEADER>(pBuffer + i * uiSize);
+		pHeader->dwRun = (DWORD)pBench->m_lRun;
+		pHeader->dwSender = pSender->dwSender;
+	}
+
+	WaitForSingleObject(pBench->m_hStartEvent, INFINITE);
+
+	LARGE_INTEGER liFrequency;
+	QueryPerformanceFrequency(&liFrequency);
+
+	LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+	LONGLONG llDeadline = llStart + liFrequency.QuadPart * pBench->m_sConfig.uiSeconds;
+
+	// ÿ̷ֵ߳
+	double dInterval = (pBench->m_sConfig.uiRate > 0) ? (double)liFrequency.QuadPart * pBench->m_sConfig.uiSenders / pBench->m_sConfig.uiRate : 0.0;
+	ULONGLONG ullAttempt = 0;
+
+	for (;;)
+	{
+		LONGLONG llNow = CRosaHistogram::CRosaHistogramNow();
+		if (llNow >= llDeadline)
+		{
+			break;
+		}
+
+		if (dInterval > 0.0 && llNow < llStart + (LONGLONG)(ullAttempt * dInterval))
+		{
+			SwitchToThread();
+			continue;
+		}
+
+		for (UINT i = 0; i < uiBatch; ++i)
+		{
+			LPS_UDPBENCHHEADER pHeader = reinterpret_cast<LPS_UDPBENCHHEADER>(pBuffer + i * uiSize);
+			pHeader->ullSeq = pSender->ullSent + i;
+			pHeader->llSendTime = llNow;
+		}
+
+		ullAttempt += uiBatch;
+
+		// ʧܵݱռ, ն˵ļ϶ֻӳʧ(;ʧʱѷĲְʧ)
+		int nRet = (uiBatch > 1) ? Sender.CRosaSocketUDPSendBatch("127.0.0.1", pBench->m_sPort, pBuffer, uiSize * uiBatch, (USHORT)uiSize, 1)
+			: Sender.CRosaSocketUDPSendBuffer("127.0.0.1", (SHORT)pBench->m_sPort, pBuffer, uiSize, 1);
+
+		pSender->ullCalls++;
+
+		if (nRet == SOB_RET_OK)
+		{
+			pSender->ullSent += uiBatch;
+		}
+		else
+		{
+			pSender->ullErrors++;
+		}
+	}
+
+	delete[] pBuffer;
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 RecvDatagram()
+// @Purpose: CRosaBenchUdpͳһݱ(̼߳ż϶)
+// @Since: v1.00a
+// @Para: const char* pBuffer(ݱ)
+// @Para: UINT uiRecv()
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchUdp::RecvDatagram(const char * pBuffer, UINT uiRecv)
+{
+	if (uiRecv < sizeof(S_UDPBENCHHEADER))
+	{
+		return;
+	}
+
+	const S_UDPBENCHHEADER* pHeader = reinterpret_cast<const S_UDPBENCHHEADER*>(pBuffer);
+
+	// һĳٵݱ
+	if ((LONG)pHeader->dwRun != m_lRun || pHeader->dwSender >= ROSABENCH_UDP_MAX_SENDERS)
+	{
+		return;
+	}
+
+	if ((LONG)pHeader->dwRun != m_lRecvRun)
+	{
+		memset(m_sPeer, 0, sizeof(m_sPeer));
+		InterlockedExchange(&m_lRecvRun, (LONG)pHeader->dwRun);
+	}
+
+	m_Latency.CRosaHistogramRecordSince(pHeader->llSendTime);
+
+	LPS_UDPBENCHPEER pPeer = &m_sPeer[pHeader->dwSender];
+	pPeer->ullReceived++;
+
+	if (pHeader->ullSeq == pPeer->ullNextSeq)
+	{
+		pPeer->ullNextSeq++;
+	}
+	else if (pHeader->ullSeq > pPeer->ullNextSeq)
+	{
+		pPeer->ullLost += pHeader->ullSeq - pPeer->ullNextSeq;
+		pPeer->ullGaps++;
+		pPeer->ullNextSeq = pHeader->ullSeq + 1;
+	}
+	else
+	{
+		// ѼΪʧųٵ
+		pPeer->ullLate++;
+		if (pPeer->ullLost > 0)
+		{
+			pPeer->ullLost--;
+		}
+	}
+
+	InterlockedIncrement(&m_lRecvCount);
+}
+
+//------------------------------------------------------------------
+// @Function:	 WaitDrain()
+// @Purpose: CRosaBenchUdpȴնſ(ROSABENCH_UDP_DRAIN_MSECûݱ)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchUdp::WaitDrain()
+{
+	LONG lLast = m_lRecvCount;
+
+	for (DWORD dwWait = 0; dwWait < ROSABENCH_UDP_DRAIN_MAX; dwWait += ROSABENCH_UDP_DRAIN_MSEC)
+	{
+		Sleep(ROSABENCH_UDP_DRAIN_MSEC);
+
+		LONG lCount = m_lRecvCount;
+		if (lCount == lLast)
+		{
+			break;
+		}
+		lLast = lCount;
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 SetRecvBatch()
+// @Purpose: CRosaBenchUdpлշʽ(ֹ̺ͣ߳úϲж, ·ʽ)
+// @Since: v1.00a
+// @Para: bool bBatch(Ƿ)
+// @Return: bool bRet (true:߳, false:ʧ)
+//------------------------------------------------------------------
+bool CRosaBenchUdp::SetRecvBatch(bool bBatch)
+{
+	if (m_hRecvThread == NULL)
+	{
+		return false;
+	}
+
+	if (bBatch == m_bRecvBatch)
+	{
+		return true;
+	}
+
+	CRosaBenchUdpStop();
+
+	// ֺ֧ϲʱȻʹӿ(ÿȡһݱ)
+	m_Receiver.CRosaSocketUDPSetOffload(false, bBatch);
+	m_bRecvBatch = bBatch;
+	m_bExit = FALSE;
+
+	m_hRecvThread = (HANDLE)_beginthreadex(NULL, 0, OnRecvThread, this, 0, NULL);
+
+	return (m_hRecvThread != NULL);
+}
+
+//------------------------------------------------------------------
+// @Function:	 ThreadCpuTime()
+// @Purpose: CRosaBenchUdp߳CPUʱ(ں+û)
+// @Since: v1.00a
+// @Para: HANDLE hThread(߳̾)
+// @Return: ULONGLONG ullTime (100)
+//------------------------------------------------------------------
+ULONGLONG CRosaBenchUdp::ThreadCpuTime(HANDLE hThread)
+{
+	FILETIME ftCreate, ftExit, ftKernel, ftUser;
+
+	if (hThread == NULL || !GetThreadTimes(hThread, &ftCreate, &ftExit, &ftKernel, &ftUser))
+	{
+		return 0;
+	}
+
+	ULONGLONG ullKernel = ((ULONGLONG)ftKernel.dwHighDateTime << 32) | ftKernel.dwLowDateTime;
+	ULONGLONG ullUser = ((ULONGLONG)ftUser.dwHighDateTime << 32) | ftUser.dwLowDateTime;
+
+	return ullKernel + ullUser;
+}
+
+//------------------------------------------------------------------
+// @Function:	 UdpInErrors()
+// @Purpose: CRosaBenchUdpϵͳUDPմ(Windowsṩ׽ֵ, ջʱݱֵ, Ϊȫϵͳ)
+// @Since: v1.00a
+// @Para: None
+// @Return: DWORD dwInErrors
+//------------------------------------------------------------------
+DWORD CRosaBenchUdp::UdpInErrors()
+{
+	MIB_UDPSTATS sStats;
+	memset(&sStats, 0, sizeof(sStats));
+
+	if (GetUdpStatistics(&sStats) != NO_ERROR)
+	{
+		return 0;
+	}
+
+	return sStats.dwInErrors;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchUdpUsage()
+// @Purpose: CRosaBenchUdpѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchUdp::CRosaBenchUdpUsage()
+{
+	fprintf(stderr,
+		"  --udp-sizes <list>     datagram sizes (default: " ROSABENCH_DEFAULT_UDP_SIZES ")\n"
+		"  --udp-senders <list>   sender thread counts (default: " ROSABENCH_DEFAULT_UDP_SENDERS ")\n"
+		"  --udp-rates <list>     total send rates in datagrams/s, 0 = unthrottled (default: " ROSABENCH_DEFAULT_UDP_RATES ")\n"
+		"  --udp-rcvbuf <KB>      receive socket buffer (default: system default)\n"
+		"  --udp-modes <list>     single,batch (batch = segmentation/coalescing offload calls, default: all)\n");
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchUdpParse()
+// @Purpose: CRosaBenchUdpѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchUdp::CRosaBenchUdpParse(const char * pcArg, const char * pcValue)
+{
+	bool bOk = false;
+
+	if (strcmp(pcArg, "--udp-sizes") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecUdpSize);
+	}
+	else if (strcmp(pcArg, "--udp-senders") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecUdpSender);
+	}
+	else if (strcmp(pcArg, "--udp-rates") == 0)
+	{
+		bOk = BenchParseList(pcValue, g_vecUdpRate, true);
+	}
+	else if (strcmp(pcArg, "--udp-modes") == 0)
+	{
+		g_bUdpSingle = BenchListHas(pcValue, "single");
+		g_bUdpBatch = BenchListHas(pcValue, "batch");
+		bOk = (g_bUdpSingle || g_bUdpBatch);
+	}
+	else if (strcmp(pcArg, "--udp-rcvbuf") == 0)
+	{
+		g_uiUdpRecvBuffer = strtoul(pcValue, NULL, 10);
+		bOk = (g_uiUdpRecvBuffer > 0);
+	}
+	else
+	{
+		return ROSABENCH_PARSE_UNKNOWN;
+	}
+
+	return bOk ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchUdpMain()
+// @Purpose: CRosaBenchUdpȫ(/**߳*)
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchUdp::CRosaBenchUdpMain(const S_BENCHCOMMON & sCommon)
+{
+	if (g_vecUdpSize.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_UDP_SIZES, g_vecUdpSize);
+	}
+
+	if (g_vecUdpSender.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_UDP_SENDERS, g_vecUdpSender);
+	}
+
+	if (g_vecUdpRate.empty())
+	{
+		BenchParseList(ROSABENCH_DEFAULT_UDP_RATES, g_vecUdpRate, true);
+	}
+
+	CRosaBenchUdp BenchUdp;
+
+	if (!BenchUdp.CRosaBenchUdpStart(sCommon.sPort, g_uiUdpRecvBuffer))
+	{
+		fprintf(stderr, "RosaBench: cannot bind UDP port %u\n", sCommon.sPort);
+	}
+	else
+	{
+		for (int b = 0; b < 2; ++b)
+		{
+			if ((b == 0 && !g_bUdpSingle) || (b == 1 && !g_bUdpBatch))
+			{
+				continue;
+			}
+
+			for (size_t s = 0; s < g_vecUdpSize.size(); ++s)
+			{
+				for (size_t n = 0; n < g_vecUdpSender.size(); ++n)
+				{
+					for (size_t r = 0; r < g_vecUdpRate.size(); ++r)
+					{
+						S_UDPBENCHCONFIG sConfig = { g_vecUdpSize[s], g_vecUdpSender[n], g_vecUdpRate[r], sCommon.uiSeconds, (b == 1) };
+						BenchOutput(BenchUdp.CRosaBenchUdpRun(sConfig));
+					}
+				}
+			}
+		}
+	}
+
+	BenchUdp.CRosaBenchUdpStop();
+}
@@ -0,0 +1,118 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchUdp.h
+* @brief	This File is RosaBenchUdp Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHUDP_H__
+#define __CROSABENCHUDP_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Macro Definition
+#define ROSABENCH_UDP_MAX_SIZE		65507			//ݱ(IPv4)
+#define ROSABENCH_UDP_MAX_SENDERS	64				//߳
+#define ROSABENCH_UDP_DRAIN_MSEC	100				//ͽնݸʱΪſ
+#define ROSABENCH_UDP_DRAIN_MAX		2000			//ſȴ()
+#define ROSABENCH_UDP_BATCH			16				//ģʽÿη͵ݱ(SOB_UDP_OFFLOAD_MAX_BYTES)
+#define ROSABENCH_UDP_RECV_BATCH	64				//ģʽÿνֵݱ
+
+#define ROSABENCH_DEFAULT_UDP_SIZES		"64,512,1472,8K"	//Ĭݱ
+#define ROSABENCH_DEFAULT_UDP_SENDERS	"1,4"				//ĬϷ߳
+#define ROSABENCH_DEFAULT_UDP_RATES		"100K,0"			//Ĭܷ(ݱ/, 0:)
+
+//Struct Definition
+typedef struct
+{
+	DWORD dwRun;				// Ա(һĳٵݱ)
+	DWORD dwSender;				// ̱߳
+	ULONGLONG ullSeq;			// (ÿ̴߳0)
+	LONGLONG llSendTime;		// ʱܼ(ӳ)
+}S_UDPBENCHHEADER, *LPS_UDPBENCHHEADER;
+
+typedef struct
+{
+	UINT uiSize;				// ݱ(Сڱͷ)
+	UINT uiSenders;				// ߳
+	UINT uiRate;				// ܷ(/, 0:)
+	UINT uiSeconds;				// ʱ
+	bool bBatch;				// ģʽ(CRosaSocketUDPSendBatch/CRosaSocketUDPRecvBatchֶη/ϲж)
+}S_UDPBENCHCONFIG, *LPS_UDPBENCHCONFIG;
+
+typedef struct
+{
+	ULONGLONG ullReceived;		// յݱ
+	ULONGLONG ullNextSeq;		// һ
+	ULONGLONG ullLost;			// ż϶Ķʧ(ٵݱ)
+	ULONGLONG ullGaps;			// ż϶
+	ULONGLONG ullLate;			// ٵݱ
+}S_UDPBENCHPEER, *LPS_UDPBENCHPEER;
+
+//Class Declaration
+class CRosaBenchUdp;
+
+typedef struct
+{
+	CRosaBenchUdp* pBench;		// 
+	DWORD dwSender;				// ̱߳
+	ULONGLONG ullSent;			// ͳɹݱ
+	ULONGLONG ullErrors;		// ʧܴ(WSAENOBUFS)
+	ULONGLONG ullCalls;			// ͵ô
+	bool bOffload;				// ֶηжǷЧ
+}S_UDPBENCHSENDER, *LPS_UDPBENCHSENDER;
+
+//Class Definition
+class CRosaBenchUdp
+{
+public:
+	CRosaBenchUdp();			// CRosaBenchUdp 캯
+	~CRosaBenchUdp();			// CRosaBenchUdp 
+
+public:
+	bool CRosaBenchUdpStart(USHORT sPort, UINT uiRecvBufferKB = 0);		// CRosaBenchUdp ն(uiRecvBufferKBΪ0ʱʹϵͳĬϽջ)
+	void CRosaBenchUdpStop();											// CRosaBenchUdp ֹͣն
+	string CRosaBenchUdpRun(const S_UDPBENCHCONFIG& sConfig);			// CRosaBenchUdp һ(JSON)
+
+	static void CRosaBenchUdpUsage();												// CRosaBenchUdp ѡ˵
+	static int CRosaBenchUdpParse(const char* pcArg, const char* pcValue);			// CRosaBenchUdp ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchUdpMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchUdp ȫ
+
+private:
+	static unsigned __stdcall OnRecvThread(void* pParam);				// CRosaBenchUdp ߳
+	static unsigned __stdcall OnSenderThread(void* pParam);				// CRosaBenchUdp ߳
+
+	void RecvDatagram(const char* pBuffer, UINT uiRecv);				// CRosaBenchUdp ͳһݱ
+	void WaitDrain();													// CRosaBenchUdp ȴնſ
+	bool SetRecvBatch(bool bBatch);										// CRosaBenchUdp лշʽ(߳)
+
+	static ULONGLONG ThreadCpuTime(HANDLE hThread);						// CRosaBenchUdp ߳CPUʱ(100)
+	static DWORD UdpInErrors();											// CRosaBenchUdp ϵͳUDPմ
+
+private:
+	CRosaSocket m_Receiver;						// CRosaBenchUdp ն
+	HANDLE m_hRecvThread;						// CRosaBenchUdp ߳
+	BOOL m_bExit;								// CRosaBenchUdp ˳־
+	USHORT m_sPort;								// CRosaBenchUdp ն˿
+	UINT m_uiRecvBuffer;						// CRosaBenchUdp ջʵʴС
+	bool m_bRecvBatch;							// CRosaBenchUdp ߳ʹ
+
+	S_UDPBENCHCONFIG m_sConfig;					// CRosaBenchUdp ǰԲ
+	volatile LONG m_lRun;						// CRosaBenchUdp ǰԱ
+	volatile LONG m_lRecvRun;					// CRosaBenchUdp ߳ͳеĲԱ(߳д)
+	S_UDPBENCHPEER m_sPeer[ROSABENCH_UDP_MAX_SENDERS];	// CRosaBenchUdp ÿ̵߳Ľͳ(߳д)
+	volatile LONG m_lRecvCount;					// CRosaBenchUdp ռ(ſռ)
+	volatile LONG m_lRecvCalls;					// CRosaBenchUdp ɹĽյô(ռ֮ȼÿϵͳȡصݱ)
+	HANDLE m_hStartEvent;						// CRosaBenchUdp ߳ͬʱʼ
+	CRosaHistogram m_Latency;					// CRosaBenchUdp ӳ
+
+};
+
+#endif // !__CROSABENCHUDP_H__
@@ -0,0 +1,364 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchUnix.cpp
+* @brief	This File is RosaBenchUnix Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "CRosaBenchUnix.h"
+#include "CRosaBenchShm.h"
+
+//Include C/C++ Header File
+#include <stdio.h>
+
+//CRosaBenchUnix ת(̽TCPӺUnix׽ת, ̻һϢ֤ӿ)
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchUnix()
+// @Purpose: CRosaBenchUnix캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchUnix::CRosaBenchUnix()
+{
+	memset(&m_sWorker, 0, sizeof(m_sWorker));
+	m_dwWorkerExit = 0;
+
+	m_Latency.CRosaHistogramCreate();
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchUnix()
+// @Purpose: CRosaBenchUnix
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchUnix::~CRosaBenchUnix()
+{
+	StopWorker();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchUnixHandoffRun()
+// @Purpose: CRosaBenchUnixת(ÿ½һػTCP, ׽ת, ͻյԼΪһγɹ)
+// @Since: v1.00a
+// @Para: UINT uiSeconds(ʱ)
+// @Return: string strJson (, ʧʱԭ)
+//------------------------------------------------------------------
+string CRosaBenchUnix::CRosaBenchUnixHandoffRun(UINT uiSeconds)
+{
+	const char* pcHead = "\"benchmark\":\"unix_handoff\"";
+
+	string strPath = BenchUnixPath("handoff");
+	CRosaSocket Carrier;
+
+	if (strPath.empty() || !Carrier.CRosaSocketUnixBindOnPath(strPath.c_str()) || !Carrier.CRosaSocketListen(1))
+	{
+		return string("{") + pcHead + ",\"error\":\"unix bind failed\"}";
+	}
+
+	if (!StartWorker(strPath.c_str()))
+	{
+		return string("{") + pcHead + ",\"error\":\"worker start failed\"}";
+	}
+
+	SOCKET sCarrier = AcceptTimeOut(Carrier.CRosaSocketGetRawSocket(), ROSABENCH_UNIX_WAIT_SEC);
+	if (sCarrier == INVALID_SOCKET)
+	{
+		StopWorker();
+		return string("{") + pcHead + ",\"error\":\"worker connect failed\"}";
+	}
+
+	// תӵļ(ʱ˿)
+	SOCKADDR_IN sAddr;
+	memset(&sAddr, 0, sizeof(sAddr));
+	sAddr.sin_family = AF_INET;
+	sAddr.sin_port = 0;
+	sAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	int nAddrLen = sizeof(sAddr);
+	SOCKET sTcpListen = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+	if (sTcpListen == INVALID_SOCKET ||
+		bind(sTcpListen, (SOCKADDR*)&sAddr, sizeof(sAddr)) == SOCKET_ERROR ||
+		listen(sTcpListen, SOMAXCONN) == SOCKET_ERROR ||
+		getsockname(sTcpListen, (SOCKADDR*)&sAddr, &nAddrLen) == SOCKET_ERROR)
+	{
+		if (sTcpListen != INVALID_SOCKET)
+		{
+			closesocket(sTcpListen);
+		}
+		closesocket(sCarrier);
+		StopWorker();
+		return string("{") + pcHead + ",\"error\":\"tcp listen failed\"}";
+	}
+
+	char chSend[ROSABENCH_UNIX_ECHO_SIZE];
+	char chRecv[ROSABENCH_UNIX_ECHO_SIZE];
+	LONGLONG llHandoffs = 0;
+	LONGLONG llErrors = 0;
+	bool bCarrierBroken = false;
+
+	m_Latency.CRosaHistogramReset();
+
+	S_BENCHCPU sCpu;
+	BenchCpuStart(sCpu);
+
+	LARGE_INTEGER liFrequency;
+	QueryPerformanceFrequency(&liFrequency);
+	LONGLONG llEnd = sCpu.llWall + liFrequency.QuadPart * uiSeconds;
+
+	while (CRosaHistogram::CRosaHistogramNow() < llEnd)
+	{
+		SOCKET sClient = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+		if (sClient == INVALID_SOCKET || connect(sClient, (SOCKADDR*)&sAddr, sizeof(sAddr)) == SOCKET_ERROR)
+		{
+			if (sClient != INVALID_SOCKET)
+			{
+				closesocket(sClient);
+			}
+			++llErrors;
+			continue;
+		}
+
+		SOCKET sServer = accept(sTcpListen, NULL, NULL);
+		if (sServer == INVALID_SOCKET)
+		{
+			closesocket(sClient);
+			++llErrors;
+			continue;
+		}
+
+		LONGLONG llStart = CRosaHistogram::CRosaHistogramNow();
+
+		// ת󱾽̵ĸر, ֻɹ̳
+		int nRet = Carrier.CRosaSocketUnixSendSocket(sCarrier, sServer);
+		closesocket(sServer);
+
+		if (nRet != SOB_RET_OK)
+		{
+			closesocket(sClient);
+			++llErrors;
+			bCarrierBroken = true;
+			break;
+		}
+
+		memset(chSend, (int)(llHandoffs & 0x7F), sizeof(chSend));
+
+		if (send(sClient, chSend, sizeof(chSend), 0) != sizeof(chSend) ||
+			recv(sClient, chRecv, sizeof(chRecv), MSG_WAITALL) != sizeof(chRecv) ||
+			memcmp(chSend, chRecv, sizeof(chSend)) != 0)
+		{
+			++llErrors;
+		}
+		else
+		{
+			m_Latency.CRosaHistogramRecordSince(llStart);
+			++llHandoffs;
+		}
+
+		// λر, ӲTIME_WAIT
+		LINGER sLinger = { 1, 0 };
+		setsockopt(sClient, SOL_SOCKET, SO_LINGER, (const char*)&sLinger, sizeof(sLinger));
+		closesocket(sClient);
+	}
+
+	double dSeconds = 0.0;
+	double dCpu = BenchCpuStop(sCpu, dSeconds);
+
+	// رתͨ˳
+	closesocket(sTcpListen);
+	shutdown(sCarrier, SD_BOTH);
+	closesocket(sCarrier);
+	StopWorker();
+
+	if (bCarrierBroken && llHandoffs == 0)
+	{
+		return string("{") + pcHead + ",\"error\":\"socket handoff failed\"}";
+	}
+
+	char chResult[512] = { 0 };
+	sprintf_s(chResult, sizeof(chResult), ",\"seconds\":%.3f,\"handoffs\":%lld,\"errors\":%lld,\"handoffs_per_sec\":%.1f,\"cpu_percent\":%.1f,\"worker_exit\":%lu,\"latency_ns\":",
+		dSeconds, llHandoffs, llErrors, (dSeconds > 0.0) ? llHandoffs / dSeconds : 0.0, dCpu, m_dwWorkerExit);
+
+	return string("{") + pcHead + chResult + BenchSummaryJson(m_Latency) + "}";
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchUnixWorker()
+// @Purpose: CRosaBenchUnix(תͨ, ÿյһ׽ֻһϢ, ͨرպ˳)
+// @Since: v1.00a
+// @Para: const char* pcPath(Unix·)
+// @Return: int nExit (0:, 1:ʧ, 2:ʧ)
+//------------------------------------------------------------------
+int CRosaBenchUnix::CRosaBenchUnixWorker(const char * pcPath)
+{
+	CRosaSocket Carrier;
+
+	if (!Carrier.CRosaSocketUnixConnect(pcPath, ROSABENCH_UNIX_WAIT_SEC))
+	{
+		return 1;
+	}
+
+	char chBuffer[ROSABENCH_UNIX_ECHO_SIZE];
+
+	while (true)
+	{
+		SOCKET sConn = INVALID_SOCKET;
+
+		int nRet = Carrier.CRosaSocketUnixRecvSocket(Carrier.CRosaSocketGetRawSocket(), sConn);
+		if (nRet == SOB_RET_TIMEOUT)
+		{
+			continue;
+		}
+
+		if (nRet == SOB_RET_CLOSE)
+		{
+			return 0;
+		}
+
+		if (nRet != SOB_RET_OK)
+		{
+			return 2;
+		}
+
+		if (recv(sConn, chBuffer, sizeof(chBuffer), MSG_WAITALL) == sizeof(chBuffer))
+		{
+			send(sConn, chBuffer, sizeof(chBuffer), 0);
+
+			// ȴͻȹر, TIME_WAITڹ
+			recv(sConn, chBuffer, sizeof(chBuffer), 0);
+		}
+
+		closesocket(sConn);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 StartWorker()
+// @Purpose: CRosaBenchUnix(ӹ̲)
+// @Since: v1.00a
+// @Para: const char* pcPath(Unix·)
+// @Return: bool bRet (true:ɹ, false:ʧ)
+//------------------------------------------------------------------
+bool CRosaBenchUnix::StartWorker(const char * pcPath)
+{
+	char chModule[MAX_PATH] = { 0 };
+	char chCommand[2 * MAX_PATH + 64] = { 0 };
+
+	if (GetModuleFileNameA(NULL, chModule, sizeof(chModule)) == 0)
+	{
+		return false;
+	}
+
+	sprintf_s(chCommand, sizeof(chCommand), "\"%s\" %s \"%s\"", chModule, ROSABENCH_UNIX_WORKER_ARG, pcPath);
+
+	STARTUPINFOA sStartup;
+	memset(&sStartup, 0, sizeof(sStartup));
+	sStartup.cb = sizeof(sStartup);
+
+	m_dwWorkerExit = 0;
+
+	return CreateProcessA(NULL, chCommand, NULL, NULL, FALSE, 0, NULL, NULL, &sStartup, &m_sWorker) != FALSE;
+}
+
+//------------------------------------------------------------------
+// @Function:	 AcceptTimeOut()
+// @Purpose: CRosaBenchUnixʱһ(ʧʱ)
+// @Since: v1.00a
+// @Para: SOCKET sListen(׽)
+// @Para: UINT uiSec(ʱʱ)
+// @Return: SOCKET s (INVALID_SOCKET:ʱʧ)
+//------------------------------------------------------------------
+SOCKET CRosaBenchUnix::AcceptTimeOut(SOCKET sListen, UINT uiSec)
+{
+	fd_set fdRead;
+	FD_ZERO(&fdRead);
+	FD_SET(sListen, &fdRead);
+
+	timeval tvTimeOut = { (long)uiSec, 0 };
+
+	if (select(0, &fdRead, NULL, NULL, &tvTimeOut) != 1)
+	{
+		return INVALID_SOCKET;
+	}
+
+	return accept(sListen, NULL, NULL);
+}
+
+//------------------------------------------------------------------
+// @Function:	 StopWorker()
+// @Purpose: CRosaBenchUnixȴ˳(ʱ, ˳¼m_dwWorkerExit)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchUnix::StopWorker()
+{
+	if (m_sWorker.hProcess == NULL)
+	{
+		return;
+	}
+
+	if (WaitForSingleObject(m_sWorker.hProcess, ROSABENCH_UNIX_WAIT_SEC * 1000) != WAIT_OBJECT_0)
+	{
+		TerminateProcess(m_sWorker.hProcess, (UINT)-1);
+		WaitForSingleObject(m_sWorker.hProcess, INFINITE);
+	}
+
+	GetExitCodeProcess(m_sWorker.hProcess, &m_dwWorkerExit);
+
+	CloseHandle(m_sWorker.hThread);
+	CloseHandle(m_sWorker.hProcess);
+	memset(&m_sWorker, 0, sizeof(m_sWorker));
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchUnixUsage()
+// @Purpose: CRosaBenchUnixѡ˵
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchUnix::CRosaBenchUnixUsage()
+{
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchUnixParse()
+// @Purpose: CRosaBenchUnixѡ
+// @Since: v1.00a
+// @Para: const char* pcArg(ѡ)
+// @Para: const char* pcValue(ѡֵ)
+// @Return: int nRet (ROSABENCH_PARSE_*)
+//------------------------------------------------------------------
+int CRosaBenchUnix::CRosaBenchUnixParse(const char * pcArg, const char * pcValue)
+{
+	return ROSABENCH_PARSE_UNKNOWN;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchUnixMain()
+// @Purpose: CRosaBenchUnixUnixԱȼת
+// @Since: v1.00a
+// @Para: const S_BENCHCOMMON& sCommon(ѡ)
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchUnix::CRosaBenchUnixMain(const S_BENCHCOMMON & sCommon)
+{
+	// δѡshmʱлػTCP׼Unix
+	if (!BenchIsSelected("shm"))
+	{
+		CRosaBenchShm::CRosaBenchShmMain(sCommon);
+	}
+
+	CRosaBenchUnix BenchUnix;
+
+	BenchOutput(BenchUnix.CRosaBenchUnixHandoffRun(sCommon.uiSeconds));
+}
@@ -0,0 +1,52 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		CRosaBenchUnix.h
+* @brief	This File is RosaBenchUnix Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __CROSABENCHUNIX_H__
+#define __CROSABENCHUNIX_H__
+
+//Include RosaBench Header File
+#include "RosaBench.h"
+
+//Macro Definition
+#define ROSABENCH_UNIX_WORKER_ARG		"--unix-worker"	//̲(Unix·)
+#define ROSABENCH_UNIX_ECHO_SIZE		64				//ת֤Ϣ
+#define ROSABENCH_UNIX_WAIT_SEC			10				//ȴӼ˳ʱ
+
+//Class Definition
+class CRosaBenchUnix
+{
+public:
+	CRosaBenchUnix();			// CRosaBenchUnix 캯
+	~CRosaBenchUnix();			// CRosaBenchUnix 
+
+public:
+	string CRosaBenchUnixHandoffRun(UINT uiSeconds);							// CRosaBenchUnix ת(JSON)
+	static int CRosaBenchUnixWorker(const char* pcPath);						// CRosaBenchUnix (ؽ˳)
+
+	static void CRosaBenchUnixUsage();												// CRosaBenchUnix ѡ˵
+	static int CRosaBenchUnixParse(const char* pcArg, const char* pcValue);			// CRosaBenchUnix ѡ(ROSABENCH_PARSE_*)
+	static void CRosaBenchUnixMain(const S_BENCHCOMMON& sCommon);					// CRosaBenchUnix ȫ
+
+private:
+	bool StartWorker(const char* pcPath);										// CRosaBenchUnix 
+	SOCKET AcceptTimeOut(SOCKET sListen, UINT uiSec);							// CRosaBenchUnix ʱһ
+	void StopWorker();															// CRosaBenchUnix ȴ˳(ʱ)
+
+private:
+	PROCESS_INFORMATION m_sWorker;				// CRosaBenchUnix 
+	DWORD m_dwWorkerExit;						// CRosaBenchUnix ˳
+	CRosaHistogram m_Latency;					// CRosaBenchUnix ת״ӳ
+
+};
+
+#endif // !__CROSABENCHUNIX_H__
@@ -0,0 +1,682 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		RosaBench.cpp
+* @brief	This File is RosaBench Source File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#include "RosaBench.h"
+#include "CRosaBenchTcp.h"
+#include "CRosaBenchUdp.h"
+#include "CRosaBenchRateLimit.h"
+#include "CRosaBenchCompress.h"
+#include "CRosaBenchMessage.h"
+#include "CRosaBenchRpc.h"
+#include "CRosaBenchShm.h"
+#include "CRosaBenchUnix.h"
+#include "CRosaBenchConnect.h"
+#include "CRosaBenchReconnect.h"
+#include "CRosaBenchPool.h"
+#include "CRosaBenchResolve.h"
+#include "CRosaBenchCoroutine.h"
+#include "CRosaBenchBulk.h"
+#include "CRosaBenchTimer.h"
+#include "CRosaBenchHeartbeat.h"
+#include "CRosaBenchCoalesce.h"
+#include "CRosaBenchSendQueue.h"
+#include "CRosaBenchMPSC.h"
+#include "CRosaBenchBroadcast.h"
+#include "CRosaBenchHistogram.h"
+#include "CRosaBenchTrace.h"
+
+//Include C/C++ Header File
+#include <process.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//RosaBench ܲԳ(ػ, JSON׼ļ)
+
+static FILE* g_pOutput = stdout;		// 
+static bool g_bFirstResult = true;		// Ƿһ
+static void* volatile g_pContextSlot[ROSABENCH_CONTEXT_SLOTS] = { NULL };	// ȴӵĲԶ
+
+// б(˳; ÿṩѡ˵//, ѡڸԵԴļ)
+static S_BENCHENTRY g_sBench[] = {
+	{ "tcp", true, CRosaBenchTcp::CRosaBenchTcpUsage, CRosaBenchTcp::CRosaBenchTcpParse, CRosaBenchTcp::CRosaBenchTcpMain },
+	{ "udp", true, CRosaBenchUdp::CRosaBenchUdpUsage, CRosaBenchUdp::CRosaBenchUdpParse, CRosaBenchUdp::CRosaBenchUdpMain },
+	{ "ratelimit", true, CRosaBenchRateLimit::CRosaBenchRateLimitUsage, CRosaBenchRateLimit::CRosaBenchRateLimitParse, CRosaBenchRateLimit::CRosaBenchRateLimitMain },
+	{ "compress", true, CRosaBenchCompress::CRosaBenchCompressUsage, CRosaBenchCompress::CRosaBenchCompressParse, CRosaBenchCompress::CRosaBenchCompressMain },
+	{ "message", true, CRosaBenchMessage::CRosaBenchMessageUsage, CRosaBenchMessage::CRosaBenchMessageParse, CRosaBenchMessage::CRosaBenchMessageMain },
+	{ "rpc", true, CRosaBenchRpc::CRosaBenchRpcUsage, CRosaBenchRpc::CRosaBenchRpcParse, CRosaBenchRpc::CRosaBenchRpcMain },
+	{ "shm", true, CRosaBenchShm::CRosaBenchShmUsage, CRosaBenchShm::CRosaBenchShmParse, CRosaBenchShm::CRosaBenchShmMain },
+	{ "unix", true, CRosaBenchUnix::CRosaBenchUnixUsage, CRosaBenchUnix::CRosaBenchUnixParse, CRosaBenchUnix::CRosaBenchUnixMain },
+	{ "connect", true, CRosaBenchConnect::CRosaBenchConnectUsage, CRosaBenchConnect::CRosaBenchConnectParse, CRosaBenchConnect::CRosaBenchConnectMain },
+	{ "reconnect", true, CRosaBenchReconnect::CRosaBenchReconnectUsage, CRosaBenchReconnect::CRosaBenchReconnectParse, CRosaBenchReconnect::CRosaBenchReconnectMain },
+	{ "pool", true, CRosaBenchPool::CRosaBenchPoolUsage, CRosaBenchPool::CRosaBenchPoolParse, CRosaBenchPool::CRosaBenchPoolMain },
+	{ "resolve", true, CRosaBenchResolve::CRosaBenchResolveUsage, CRosaBenchResolve::CRosaBenchResolveParse, CRosaBenchResolve::CRosaBenchResolveMain },
+	{ "echo", true, CRosaBenchCoroutine::CRosaBenchCoroutineUsage, CRosaBenchCoroutine::CRosaBenchCoroutineParse, CRosaBenchCoroutine::CRosaBenchCoroutineMain },
+	{ "bulk", true, CRosaBenchBulk::CRosaBenchBulkUsage, CRosaBenchBulk::CRosaBenchBulkParse, CRosaBenchBulk::CRosaBenchBulkMain },
+	{ "timer", true, CRosaBenchTimer::CRosaBenchTimerUsage, CRosaBenchTimer::CRosaBenchTimerParse, CRosaBenchTimer::CRosaBenchTimerMain },
+	{ "heartbeat", true, CRosaBenchHeartbeat::CRosaBenchHeartbeatUsage, CRosaBenchHeartbeat::CRosaBenchHeartbeatParse, CRosaBenchHeartbeat::CRosaBenchHeartbeatMain },
+	{ "coalesce", true, CRosaBenchCoalesce::CRosaBenchCoalesceUsage, CRosaBenchCoalesce::CRosaBenchCoalesceParse, CRosaBenchCoalesce::CRosaBenchCoalesceMain },
+	{ "sendqueue", true, CRosaBenchSendQueue::CRosaBenchSendQueueUsage, CRosaBenchSendQueue::CRosaBenchSendQueueParse, CRosaBenchSendQueue::CRosaBenchSendQueueMain },
+	{ "mpsc", true, CRosaBenchMPSC::CRosaBenchMPSCUsage, CRosaBenchMPSC::CRosaBenchMPSCParse, CRosaBenchMPSC::CRosaBenchMPSCMain },
+	{ "broadcast", true, CRosaBenchBroadcast::CRosaBenchBroadcastUsage, CRosaBenchBroadcast::CRosaBenchBroadcastParse, CRosaBenchBroadcast::CRosaBenchBroadcastMain },
+	{ "histogram", true, CRosaBenchHistogram::CRosaBenchHistogramUsage, CRosaBenchHistogram::CRosaBenchHistogramParse, CRosaBenchHistogram::CRosaBenchHistogramMain },
+	{ "trace", true, CRosaBenchTrace::CRosaBenchTraceUsage, CRosaBenchTrace::CRosaBenchTraceParse, CRosaBenchTrace::CRosaBenchTraceMain },
+};
+
+#define ROSABENCH_COUNT		(sizeof(g_sBench) / sizeof(g_sBench[0]))
+
+//------------------------------------------------------------------
+// @Function:	 BenchCpuStart()
+// @Purpose: RosaBench¼ʼʱ估CPUʱ
+// @Since: v1.00a
+// @Para: S_BENCHCPU& sCpu(ʼ״̬)
+// @Return: None
+//------------------------------------------------------------------
+void BenchCpuStart(S_BENCHCPU & sCpu)
+{
+	FILETIME ftCreate, ftExit, ftKernel, ftUser;
+	GetProcessTimes(GetCurrentProcess(), &ftCreate, &ftExit, &ftKernel, &ftUser);
+
+	sCpu.ullKernel = ((ULONGLONG)ftKernel.dwHighDateTime << 32) | ftKernel.dwLowDateTime;
+	sCpu.ullUser = ((ULONGLONG)ftUser.dwHighDateTime << 32) | ftUser.dwLowDateTime;
+	sCpu.llWall = CRosaHistogram::CRosaHistogramNow();
+}
+
+//------------------------------------------------------------------
+// @Function:	 BenchCpuStop()
+// @Purpose: RosaBenchCPUռ(շ˫ͬһ, ռȫİٷֱ)
+// @Since: v1.00a
+// @Para: const S_BENCHCPU& sCpu(ʼ״̬)
+// @Para: double& dSeconds()
+// @Return: double dPercent
+//------------------------------------------------------------------
+double BenchCpuStop(const S_BENCHCPU & sCpu, double & dSeconds)
+{
+	FILETIME ftCreate, ftExit, ftKernel, ftUser;
+	GetProcessTimes(GetCurrentProcess(), &ftCreate, &ftExit, &ftKernel, &ftUser);
+
+	ULONGLONG ullKernel = ((ULONGLONG)ftKernel.dwHighDateTime << 32) | ftKernel.dwLowDateTime;
+	ULONGLONG ullUser = ((ULONGLONG)ftUser.dwHighDateTime << 32) | ftUser.dwLowDateTime;
+
+	dSeconds = CRosaHistogram::CRosaHistogramToNanoSec(CRosaHistogram::CRosaHistogramNow() - sCpu.llWall) / 1e9;
+
+	SYSTEM_INFO sInfo;
+	GetSystemInfo(&sInfo);
+
+	if (dSeconds <= 0.0 || sInfo.dwNumberOfProcessors == 0)
+	{
+		return 0.0;
+	}
+
+	double dCpuSeconds = (double)((ullKernel - sCpu.ullKernel) + (ullUser - sCpu.ullUser)) / 1e7;
+
+	return dCpuSeconds * 100.0 / (dSeconds * sInfo.dwNumberOfProcessors);
+}
+
+//------------------------------------------------------------------
+// @Function:	 BenchParseList()
+// @Purpose: RosaBenchŷֵָб(֧K/M׺, "16,4K,1M")
+// @Since: v1.00a
+// @Para: const char* pcList(б)
+// @Para: vector<UINT>& vecValue()
+// @Para: bool bAllowZero(Ƿ0, 0ʾ)
+// @Return: bool bRet (true:ɹ, false:ʽ)
+//------------------------------------------------------------------
+bool BenchParseList(const char * pcList, vector<UINT>& vecValue, bool bAllowZero)
+{
+	vecValue.clear();
+
+	const char* pcPos = pcList;
+
+	while (*pcPos)
+	{
+		char* pcEnd = NULL;
+		unsigned long ulValue = strtoul(pcPos, &pcEnd, 10);
+
+		if (pcEnd == pcPos)
+		{
+			return false;
+		}
+
+		if (*pcEnd == 'K' || *pcEnd == 'k')
+		{
+			ulValue *= 1024;
+			pcEnd++;
+		}
+		else if (*pcEnd == 'M' || *pcEnd == 'm')
+		{
+			ulValue *= 1024 * 1024;
+			pcEnd++;
+		}
+
+		if ((ulValue == 0 && !bAllowZero) || (*pcEnd != ',' && *pcEnd != '\0'))
+		{
+			return false;
+		}
+
+		vecValue.push_back((UINT)ulValue);
+		pcPos = (*pcEnd == ',') ? pcEnd + 1 : pcEnd;
+	}
+
+	return !vecValue.empty();
+}
+
+//------------------------------------------------------------------
+// @Function:	 BenchListHas()
+// @Purpose: RosaBenchŷָбǷָ(ƥ, "reconnect""connect")
+// @Since: v1.00a
+// @Para: const char* pcList(б)
+// @Para: const char* pcName()
+// @Return: bool bRet (true:, false:)
+//------------------------------------------------------------------
+bool BenchListHas(const char * pcList, const char * pcName)
+{
+	size_t nLength = strlen(pcName);
+
+	for (const char* pcPos = pcList; *pcPos; )
+	{
+		const char* pcEnd = strchr(pcPos, ',');
+		size_t nItem = pcEnd ? (size_t)(pcEnd - pcPos) : strlen(pcPos);
+
+		if (nItem == nLength && strncmp(pcPos, pcName, nLength) == 0)
+		{
+			return true;
+		}
+
+		if (!pcEnd)
+		{
+			break;
+		}
+
+		pcPos = pcEnd + 1;
+	}
+
+	return false;
+}
+
+//------------------------------------------------------------------
+// @Function:	 BenchIsSelected()
+// @Purpose: RosaBenchָƵĲǷ(÷˵ĲԾݴ˾Ƿͬʱһִ)
+// @Since: v1.00a
+// @Para: const char* pcName(--benchе)
+// @Return: bool bRet (true:, false:δѡ򲻴)
+//------------------------------------------------------------------
+bool BenchIsSelected(const char * pcName)
+{
+	for (size_t b = 0; b < ROSABENCH_COUNT; ++b)
+	{
+		if (strcmp(g_sBench[b].pcName, pcName) == 0)
+		{
+			return g_sBench[b].bSelected;
+		}
+	}
+
+	return false;
+}
+
+//------------------------------------------------------------------
+// @Function:	 BenchSummaryJson()
+// @Purpose: RosaBenchӳժҪתΪJSON()
+// @Since: v1.00a
+// @Para: CRosaHistogram& Histogram(ӳͳ)
+// @Return: string strJson
+//------------------------------------------------------------------
+string BenchSummaryJson(CRosaHistogram & Histogram)
+{
+	S_HISTOGRAMSUMMARY sSummary;
+	Histogram.CRosaHistogramGetSummary(sSummary);
+
+	char chJson[512] = { 0 };
+	sprintf_s(chJson, sizeof(chJson), "{\"count\":%llu,\"min\":%llu,\"mean\":%llu,\"p50\":%llu,\"p90\":%llu,\"p99\":%llu,\"p999\":%llu,\"p9999\":%llu,\"max\":%llu}",
+		sSummary.ullCount, sSummary.ullMin, sSummary.ullMean, sSummary.ullP50, sSummary.ullP90, sSummary.ullP99, sSummary.ullP999, sSummary.ullP9999, sSummary.ullMax);
+
+	return chJson;
+}
+
+//------------------------------------------------------------------
+// @Function:	 BenchUnixPath()
+// @Purpose: RosaBenchʱĿ¼µUnix׽·(ID, ʵӰ)
+// @Since: v1.00a
+// @Para: const char* pcTag(;)
+// @Return: string strPath (SOB_UNIX_PATH_LENGTHʱΪ)
+//------------------------------------------------------------------
+string BenchUnixPath(const char * pcTag)
+{
+	char chTemp[MAX_PATH] = { 0 };
+	char chPath[MAX_PATH + 64] = { 0 };
+
+	if (GetTempPathA(sizeof(chTemp), chTemp) == 0)
+	{
+		return string();
+	}
+
+	sprintf_s(chPath, sizeof(chPath), "%sRosaBench.%lu.%s.sock", chTemp, GetCurrentProcessId(), pcTag);
+
+	return (strlen(chPath) < SOB_UNIX_PATH_LENGTH) ? string(chPath) : string();
+}
+
+//------------------------------------------------------------------
+// @Function:	 BenchOutput()
+// @Purpose: RosaBenchһ(ͬʱڱ׼)
+// @Since: v1.00a
+// @Para: const string& strJson()
+// @Return: None
+//------------------------------------------------------------------
+void BenchOutput(const string & strJson)
+{
+	fprintf(g_pOutput, "%s\n  %s", g_bFirstResult ? "" : ",", strJson.c_str());
+	fflush(g_pOutput);
+
+	if (g_pOutput != stdout)
+	{
+		fprintf(stderr, "%s\n", strJson.c_str());
+	}
+
+	g_bFirstResult = false;
+}
+
+//------------------------------------------------------------------
+// @Function:	 BenchContextAttach()
+// @Purpose: RosaBenchǼǶ(ӻصֻܴ32λû, ñλôָ)
+// @Since: v1.00a
+// @Para: void* pContext()
+// @Return: DWORD dwSlot (λ, ʱΪROSABENCH_CONTEXT_SLOTS)
+//------------------------------------------------------------------
+DWORD BenchContextAttach(void * pContext)
+{
+	for (DWORD i = 0; i < ROSABENCH_CONTEXT_SLOTS; ++i)
+	{
+		if (InterlockedCompareExchangePointer(&g_pContextSlot[i], pContext, NULL) == NULL)
+		{
+			return i;
+		}
+	}
+
+	return ROSABENCH_CONTEXT_SLOTS;
+}
+
+//------------------------------------------------------------------
+// @Function:	 BenchContextGet()
+// @Purpose: RosaBenchܻصûȡصǼǵĶ
+// @Since: v1.00a
+// @Para: DWORD dwUser(λ)
+// @Return: void* pContext (NULL:λЧע)
+//------------------------------------------------------------------
+void * BenchContextGet(DWORD dwUser)
+{
+	return (dwUser < ROSABENCH_CONTEXT_SLOTS) ? g_pContextSlot[dwUser] : NULL;
+}
+
+//------------------------------------------------------------------
+// @Function:	 BenchContextDetach()
+// @Purpose: RosaBenchעλ(߳˳)
+// @Since: v1.00a
+// @Para: DWORD dwSlot(λ)
+// @Return: None
+//------------------------------------------------------------------
+void BenchContextDetach(DWORD dwSlot)
+{
+	if (dwSlot < ROSABENCH_CONTEXT_SLOTS)
+	{
+		InterlockedExchangePointer(&g_pContextSlot[dwSlot], NULL);
+	}
+}
+
+//------------------------------------------------------------------
+// @Function:	 BenchStartConnThread()
+// @Purpose: RosaBenchΪ߳(̲߳ΪS_BENCHCONN, ߳ͷ; ߳˳ǰټ)
+// @Since: v1.00a
+// @Para: unsigned(__stdcall* pThread)(void*)(߳)
+// @Para: void* pContext(Զ)
+// @Para: SOCKET s(˽ܵ)
+// @Para: volatile LONG& lCount(̼߳, ǰ)
+// @Para: UINT uiStackSize(߳ջС, 0:Ĭ)
+// @Return: bool bRet (true:ɹ, false:ʧ, ѹر)
+//------------------------------------------------------------------
+bool BenchStartConnThread(unsigned(__stdcall* pThread)(void*), void* pContext, SOCKET s, volatile LONG& lCount, UINT uiStackSize)
+{
+	LPS_BENCHCONN pConn = new S_BENCHCONN;
+	pConn->pContext = pContext;
+	pConn->Socket = s;
+
+	InterlockedIncrement(&lCount);
+
+	HANDLE hThread = (HANDLE)_beginthreadex(NULL, uiStackSize, pThread, pConn, uiStackSize ? STACK_SIZE_PARAM_IS_A_RESERVATION : 0, NULL);
+	if (hThread == NULL)
+	{
+		InterlockedDecrement(&lCount);
+		closesocket(s);
+		delete pConn;
+		return false;
+	}
+
+	CloseHandle(hThread);
+
+	return true;
+}
+
+//CRosaBenchServer ػ(Թõļ߳, ܵӽԶĻص)
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchServer()
+// @Purpose: CRosaBenchServer캯
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchServer::CRosaBenchServer()
+{
+	m_pSocket = NULL;
+	m_hAcceptThread = NULL;
+	m_bExit = FALSE;
+	m_nError = 0;
+	m_nShards = 0;
+	m_dwSlot = ROSABENCH_CONTEXT_SLOTS;
+
+	m_pAccept = NULL;
+	m_pContext = NULL;
+}
+
+//------------------------------------------------------------------
+// @Function:	 ~CRosaBenchServer()
+// @Purpose: CRosaBenchServer
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+CRosaBenchServer::~CRosaBenchServer()
+{
+	CRosaBenchServerStop();
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchServerStart()
+// @Purpose: CRosaBenchServerػ˿ڲ߳
+// @Since: v1.00a
+// @Para: USHORT sPort(˿)
+// @Para: BENCH_ACCEPT_CALLBACK pAccept(ӻص)
+// @Para: void* pContext(Զ, ص)
+// @Para: USHORT nShards(Ƭ, 0:߳̽)
+// @Return: bool bRet (true:ɹ, false:ʧ, CRosaBenchServerGetErrorȡ)
+//------------------------------------------------------------------
+bool CRosaBenchServer::CRosaBenchServerStart(USHORT sPort, BENCH_ACCEPT_CALLBACK pAccept, void * pContext, USHORT nShards)
+{
+	CRosaBenchServerStop();
+
+	m_nError = 0;
+	m_pAccept = pAccept;
+	m_pContext = pContext;
+	m_nShards = nShards;
+
+	m_dwSlot = BenchContextAttach(this);
+	if (m_dwSlot == ROSABENCH_CONTEXT_SLOTS)
+	{
+		m_nError = WSAEMFILE;
+		return false;
+	}
+
+	m_pSocket = new CRosaSocket();
+	if (!m_pSocket->CRosaSocketBindOnPort(sPort) || !m_pSocket->CRosaSocketListen(SOMAXCONN))
+	{
+		m_nError = m_pSocket->m_nLastWSAError;
+		CRosaBenchServerStop();
+		return false;
+	}
+
+	m_pSocket->CRosaSocketSetConnectMaxCount(0xFFFF);
+
+	m_bExit = FALSE;
+	m_hAcceptThread = (HANDLE)_beginthreadex(NULL, 0, OnAcceptThread, this, 0, NULL);
+	if (m_hAcceptThread == NULL)
+	{
+		m_nError = WSAENOBUFS;
+		CRosaBenchServerStop();
+		return false;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchServerStop()
+// @Purpose: CRosaBenchServerֹ̲ͣ߳رռ׽(ѽܵɲԶر)
+// @Since: v1.00a
+// @Para: None
+// @Return: None
+//------------------------------------------------------------------
+void CRosaBenchServer::CRosaBenchServerStop()
+{
+	// ߳1ڷ
+	if (m_hAcceptThread)
+	{
+		m_bExit = TRUE;
+		WaitForSingleObject(m_hAcceptThread, INFINITE);
+		CloseHandle(m_hAcceptThread);
+		m_hAcceptThread = NULL;
+	}
+
+	if (m_pSocket)
+	{
+		delete m_pSocket;
+		m_pSocket = NULL;
+	}
+
+	BenchContextDetach(m_dwSlot);
+	m_dwSlot = ROSABENCH_CONTEXT_SLOTS;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchServerGetSocket()
+// @Purpose: CRosaBenchServerȡ׽(Զڽܵշ)
+// @Since: v1.00a
+// @Para: None
+// @Return: CRosaSocket* pSocket (NULL:δ)
+//------------------------------------------------------------------
+CRosaSocket * CRosaBenchServer::CRosaBenchServerGetSocket() const
+{
+	return m_pSocket;
+}
+
+//------------------------------------------------------------------
+// @Function:	 CRosaBenchServerGetError()
+// @Purpose: CRosaBenchServerȡʧܵĴ
+// @Since: v1.00a
+// @Para: None
+// @Return: int nError (WSA)
+//------------------------------------------------------------------
+int CRosaBenchServer::CRosaBenchServerGetError() const
+{
+	return m_nError;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAcceptThread()
+// @Purpose: CRosaBenchServer߳(˳־λ1ڷ)
+// @Since: v1.00a
+// @Para: void* pParam(CRosaBenchServer)
+// @Return: unsigned 0
+//------------------------------------------------------------------
+unsigned __stdcall CRosaBenchServer::OnAcceptThread(void * pParam)
+{
+	CRosaBenchServer* pServer = reinterpret_cast<CRosaBenchServer*>(pParam);
+
+	if (pServer->m_nShards > 0)
+	{
+		pServer->m_pSocket->CRosaSocketAcceptSharded(pServer->m_nShards, OnAcceptShard, pServer->m_dwSlot, &pServer->m_bExit, false, 1);
+	}
+	else
+	{
+		pServer->m_pSocket->CRosaSocketAccept(NULL, OnAccept, pServer->m_dwSlot, &pServer->m_bExit, 1);
+	}
+
+	return 0;
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAccept()
+// @Purpose: CRosaBenchServer(ûҵ, Զ)
+// @Since: v1.00a
+// @Para: SOCKET s(ͻ׽)
+// @Para: DWORD dwUser(Զеλ)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaBenchServer::OnAccept(SOCKADDR_IN * pRemoteAddr, SOCKET s, DWORD dwUser)
+{
+	OnAcceptShard(pRemoteAddr, s, 0, dwUser);
+}
+
+//------------------------------------------------------------------
+// @Function:	 OnAcceptShard()
+// @Purpose: CRosaBenchServer(Ƭ߳)
+// @Since: v1.00a
+// @Para: SOCKET s(ͻ׽)
+// @Para: USHORT nShard(Ƭ)
+// @Para: DWORD dwUser(Զеλ)
+// @Return: None
+//------------------------------------------------------------------
+void __stdcall CRosaBenchServer::OnAcceptShard(SOCKADDR_IN * pRemoteAddr, SOCKET s, USHORT nShard, DWORD dwUser)
+{
+	CRosaBenchServer* pServer = reinterpret_cast<CRosaBenchServer*>(BenchContextGet(dwUser));
+
+	if (pServer == NULL || pServer->m_pAccept == NULL)
+	{
+		closesocket(s);
+		return;
+	}
+
+	pServer->m_pAccept(pServer->m_pContext, s, nShard);
+}
+
+// RosaBench ÷
+static void Usage()
+{
+	fprintf(stderr, "Usage: RosaBench [options]\n  --bench <list>         ");
+
+	for (size_t b = 0; b < ROSABENCH_COUNT; ++b)
+	{
+		fprintf(stderr, "%s%s", (b > 0) ? "," : "", g_sBench[b].pcName);
+	}
+
+	fprintf(stderr, " (default: all)\n"
+		"  --seconds <n>          measuring time per run (default: %d)\n"
+		"  --max-memory <MB>      skip runs whose buffers exceed this (default: %d)\n"
+		"  --port <n>             loopback port (default: %d)\n"
+		"  --out <file>           write the JSON array to a file instead of stdout\n",
+		ROSABENCH_DEFAULT_SECONDS, ROSABENCH_DEFAULT_MAX_MEMORY, ROSABENCH_DEFAULT_PORT);
+
+	for (size_t b = 0; b < ROSABENCH_COUNT; ++b)
+	{
+		g_sBench[b].pfnUsage();
+	}
+}
+
+// RosaBench һѡ(ѡ, 򽻸)
+static int ParseOption(const char* pcArg, const char* pcValue, S_BENCHCOMMON& sCommon, const char*& pcOutput)
+{
+	if (strcmp(pcArg, "--bench") == 0)
+	{
+		bool bAny = false;
+
+		for (size_t b = 0; b < ROSABENCH_COUNT; ++b)
+		{
+			g_sBench[b].bSelected = BenchListHas(pcValue, g_sBench[b].pcName);
+			bAny = bAny || g_sBench[b].bSelected;
+		}
+
+		return bAny ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+	}
+	else if (strcmp(pcArg, "--seconds") == 0)
+	{
+		sCommon.uiSeconds = strtoul(pcValue, NULL, 10);
+		return (sCommon.uiSeconds > 0) ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+	}
+	else if (strcmp(pcArg, "--max-memory") == 0)
+	{
+		sCommon.uiMaxMemory = strtoul(pcValue, NULL, 10);
+		return (sCommon.uiMaxMemory > 0) ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+	}
+	else if (strcmp(pcArg, "--port") == 0)
+	{
+		sCommon.sPort = (USHORT)strtoul(pcValue, NULL, 10);
+		return (sCommon.sPort > 0) ? ROSABENCH_PARSE_OK : ROSABENCH_PARSE_INVALID;
+	}
+	else if (strcmp(pcArg, "--out") == 0)
+	{
+		pcOutput = pcValue;
+		return ROSABENCH_PARSE_OK;
+	}
+
+	for (size_t b = 0; b < ROSABENCH_COUNT; ++b)
+	{
+		int nRet = g_sBench[b].pfnParse(pcArg, pcValue);
+		if (nRet != ROSABENCH_PARSE_UNKNOWN)
+		{
+			return nRet;
+		}
+	}
+
+	return ROSABENCH_PARSE_UNKNOWN;
+}
+
+// RosaBench 
+int main(int argc, char* argv[])
+{
+	S_BENCHCOMMON sCommon = { ROSABENCH_DEFAULT_SECONDS, ROSABENCH_DEFAULT_MAX_MEMORY, ROSABENCH_DEFAULT_PORT };
+	const char* pcOutput = NULL;
+
+	// תĹ
+	if (argc == 3 && strcmp(argv[1], ROSABENCH_UNIX_WORKER_ARG) == 0)
+	{
+		CRosaSocket::CRosaSocketLibInit();
+		int nExit = CRosaBenchUnix::CRosaBenchUnixWorker(argv[2]);
+		CRosaSocket::CRosaSocketLibRelease();
+
+		return nExit;
+	}
+
+	// (ÿѡһֵ)
+	for (int i = 1; i < argc; i += 2)
+	{
+		if (i + 1 >= argc || ParseOption(argv[i], argv[i + 1], sCommon, pcOutput) != ROSABENCH_PARSE_OK)
+		{
+			Usage();
+			return 1;
+		}
+	}
+
+	if (pcOutput != NULL && fopen_s(&g_pOutput, pcOutput, "w") != 0)
+	{
+		fprintf(stderr, "RosaBench: cannot open %s\n", pcOutput);
+		return 1;
+	}
+
+	CRosaSocket::CRosaSocketLibInit();
+
+	fprintf(g_pOutput, "[");
+
+	for (size_t b = 0; b < ROSABENCH_COUNT; ++b)
+	{
+		if (g_sBench[b].bSelected)
+		{
+			g_sBench[b].pfnRun(sCommon);
+		}
+	}
+
+	fprintf(g_pOutput, "\n]\n");
+
+	if (g_pOutput != stdout)
+	{
+		fclose(g_pOutput);
+	}
+
+	CRosaSocket::CRosaSocketLibRelease();
+
+	return 0;
+}
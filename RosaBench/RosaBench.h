@@ -0,0 +1,123 @@
+/*
+*     COPYRIGHT NOTICE
+*     Copyright(c) 2017~2018, Team Shanghai Dream Equinox
+*     All rights reserved.
+*
+* @file		RosaBench.h
+* @brief	This File is RosaBench Header File.
+* @author	alopex
+* @version	v1.00a
+* @date		2026-10-19	v1.00a	alopex	Create This File.
+*/
+#pragma once
+
+#ifndef __ROSABENCH_H__
+#define __ROSABENCH_H__
+
+//Include Rosa Header File
+#include "../Rosa/CRosaSocket.h"
+#include "../Rosa/CRosaHistogram.h"
+
+//Include C/C++ Header File
+#include <string>
+#include <vector>
+
+//Include Rosa Library
+#pragma comment(lib, "Rosa.lib")
+
+using namespace std;
+
+//Macro Definition
+#define ROSABENCH_DEFAULT_PORT			23900			//Ĭϼ˿(UDPʹͬһ˿)
+#define ROSABENCH_DEFAULT_SECONDS		5				//Ĭÿʱ()
+#define ROSABENCH_DEFAULT_MAX_MEMORY	256				//Ĭÿ黺ڴ(MB, )
+#define ROSABENCH_THREAD_STACK			64*1024			//߳ջС(һʱƵַռ)
+#define ROSABENCH_CONTEXT_SLOTS			8				//ͬʱȴӵĲԶ
+
+#define ROSABENCH_PARSE_OK				1				//ѡ:ѽ
+#define ROSABENCH_PARSE_UNKNOWN			0				//ѡ:ǸòԵѡ
+#define ROSABENCH_PARSE_INVALID			-1				//ѡ:ֵЧ
+
+//Struct Definition
+typedef struct
+{
+	LONGLONG llWall;			// ʼʱܼ
+	ULONGLONG ullKernel;		// ʼʱĽںʱ(100)
+	ULONGLONG ullUser;			// ʼʱĽûʱ(100)
+}S_BENCHCPU, *LPS_BENCHCPU;
+
+typedef struct
+{
+	UINT uiSeconds;				// ÿʱ()
+	UINT uiMaxMemory;			// ÿ黺ڴ(MB)
+	USHORT sPort;				// ػ˿
+}S_BENCHCOMMON, *LPS_BENCHCOMMON;
+
+typedef struct
+{
+	void* pContext;				// Զ
+	SOCKET Socket;				// ˽ܵ
+}S_BENCHCONN, *LPS_BENCHCONN;
+
+typedef struct
+{
+	const char* pcName;																// --benchе
+	bool bSelected;																	// Ƿ
+	void(*pfnUsage)();																// òԵѡ˵
+	int(*pfnParse)(const char* pcArg, const char* pcValue);							// òԵѡ(ROSABENCH_PARSE_*)
+	void(*pfnRun)(const S_BENCHCOMMON& sCommon);									// иòԵȫ
+}S_BENCHENTRY, *LPS_BENCHENTRY;
+
+//Callback Definition
+typedef void(*BENCH_ACCEPT_CALLBACK)(void* pContext, SOCKET s, USHORT nShard);		//ػ˽ӻص(ڼ߳е, ɻصӹ)
+
+//Class Definition
+class CRosaBenchServer
+{
+public:
+	CRosaBenchServer();			// CRosaBenchServer 캯
+	~CRosaBenchServer();		// CRosaBenchServer 
+
+public:
+	bool CRosaBenchServerStart(USHORT sPort, BENCH_ACCEPT_CALLBACK pAccept, void* pContext, USHORT nShards = 0);	// CRosaBenchServer ػ˿ڲ߳(nShards>0ʱƬ)
+	void CRosaBenchServerStop();								// CRosaBenchServer ֹ̲ͣ߳رռ׽(1ڷ)
+
+	CRosaSocket* CRosaBenchServerGetSocket() const;				// CRosaBenchServer ȡ׽(ýܵշ)
+	int CRosaBenchServerGetError() const;						// CRosaBenchServer ȡʧܵĴ
+
+private:
+	static unsigned __stdcall OnAcceptThread(void* pParam);												// CRosaBenchServer ߳
+	static void __stdcall OnAccept(SOCKADDR_IN* pRemoteAddr, SOCKET s, DWORD dwUser);					// CRosaBenchServer 
+	static void __stdcall OnAcceptShard(SOCKADDR_IN* pRemoteAddr, SOCKET s, USHORT nShard, DWORD dwUser);	// CRosaBenchServer (Ƭ߳)
+
+private:
+	CRosaSocket* m_pSocket;						// CRosaBenchServer ׽
+	HANDLE m_hAcceptThread;						// CRosaBenchServer ߳
+	BOOL m_bExit;								// CRosaBenchServer ˳־
+	int m_nError;								// CRosaBenchServer ʧܵĴ
+	USHORT m_nShards;							// CRosaBenchServer Ƭ(0:߳̽)
+	DWORD m_dwSlot;								// CRosaBenchServer ڲԶеλ(ӻصûֻ32λ)
+
+	BENCH_ACCEPT_CALLBACK m_pAccept;			// CRosaBenchServer ӻص
+	void* m_pContext;							// CRosaBenchServer Զ
+
+};
+
+//Function Declaration
+void BenchCpuStart(S_BENCHCPU& sCpu);														// ¼ʼʱ估CPUʱ
+double BenchCpuStop(const S_BENCHCPU& sCpu, double& dSeconds);								// ؽCPUռ(ռȫİٷֱ)
+
+bool BenchParseList(const char* pcList, vector<UINT>& vecValue, bool bAllowZero = false);	// ŷֵָб(֧K/M׺)
+bool BenchListHas(const char* pcList, const char* pcName);									// ŷָбǷָ(ƥ)
+bool BenchIsSelected(const char* pcName);													// ָƵĲǷ(--bench)
+string BenchSummaryJson(CRosaHistogram& Histogram);										// ӳժҪתΪJSON()
+string BenchUnixPath(const char* pcTag);													// ʱĿ¼µUnix׽·(ʱؿ)
+
+DWORD BenchContextAttach(void* pContext);													// ǼǶ󲢷رλ(Ϊܻص32λû, ʱROSABENCH_CONTEXT_SLOTS)
+void* BenchContextGet(DWORD dwUser);														// ûȡصǼǵĶ(ЧʱNULL)
+void BenchContextDetach(DWORD dwSlot);														// עλ
+
+bool BenchStartConnThread(unsigned(__stdcall* pThread)(void*), void* pContext, SOCKET s, volatile LONG& lCount, UINT uiStackSize = 0);	// Ϊ߳(ΪS_BENCHCONN, ʧʱر)
+void BenchOutput(const string& strJson);													// һ(JSONеһ)
+
+#endif // !__ROSABENCH_H__